@@ -0,0 +1,516 @@
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include <fastgltf/core.hpp>
+#include <fastgltf/tools.hpp>
+
+#include "generators.hpp"
+#include "harness.hpp"
+
+namespace fgb = fastgltf::benchmarks;
+
+namespace {
+	std::string_view getComponentTypeName(fastgltf::ComponentType componentType) {
+		switch (componentType) {
+			case fastgltf::ComponentType::Byte: return "i8";
+			case fastgltf::ComponentType::UnsignedByte: return "u8";
+			case fastgltf::ComponentType::Short: return "i16";
+			case fastgltf::ComponentType::UnsignedShort: return "u16";
+			case fastgltf::ComponentType::Int: return "i32";
+			case fastgltf::ComponentType::UnsignedInt: return "u32";
+			case fastgltf::ComponentType::Float: return "f32";
+			case fastgltf::ComponentType::Double: return "f64";
+			default: return "invalid";
+		}
+	}
+
+	std::size_t getBufferByteSize(const fastgltf::Asset& asset) {
+		std::size_t size = 0;
+		for (const auto& buffer : asset.buffers) {
+			size += buffer.byteLength;
+		}
+		return size;
+	}
+
+	template <typename ElementType>
+	void benchmarkCopyFromAccessor(fgb::Runner& runner, const fastgltf::Asset& asset, std::string_view name) {
+		const auto& accessor = asset.accessors.front();
+		std::vector<ElementType> destination(accessor.count);
+		runner.measure(name, destination.size() * sizeof(ElementType), [&]() {
+			fastgltf::copyFromAccessor<ElementType>(asset, accessor, destination.data());
+			fgb::doNotOptimize(destination.data());
+		});
+	}
+
+	void benchmarkAccessorConversions(fgb::Runner& runner) {
+		const auto scale = runner.getOptions().scale;
+		const auto elementCount = 65536 * scale;
+
+		// Every source component type, converted into every common destination type.
+		for (auto componentType : { fastgltf::ComponentType::Byte, fastgltf::ComponentType::UnsignedByte,
+									fastgltf::ComponentType::Short, fastgltf::ComponentType::UnsignedShort,
+									fastgltf::ComponentType::UnsignedInt, fastgltf::ComponentType::Float }) {
+			fgb::SyntheticAssetConfig config;
+			config.nodeCount = 0;
+			config.accessorCount = 1;
+			config.elementsPerAccessor = elementCount;
+			config.bufferCount = 1;
+			config.componentType = componentType;
+			config.normalized = componentType != fastgltf::ComponentType::Float && componentType != fastgltf::ComponentType::UnsignedInt;
+			const auto asset = fgb::generateAsset(config);
+
+			const auto prefix = std::string("copyFromAccessor/vec3/") + std::string(getComponentTypeName(componentType)) + "->";
+			benchmarkCopyFromAccessor<fastgltf::math::fvec3>(runner, asset, prefix + "f32");
+			benchmarkCopyFromAccessor<fastgltf::math::dvec3>(runner, asset, prefix + "f64");
+			benchmarkCopyFromAccessor<fastgltf::math::u8vec3>(runner, asset, prefix + "u8");
+			benchmarkCopyFromAccessor<fastgltf::math::u16vec3>(runner, asset, prefix + "u16");
+			benchmarkCopyFromAccessor<fastgltf::math::u32vec3>(runner, asset, prefix + "u32");
+		}
+
+		// Index buffers, which are usually widened to 32-bit indices.
+		for (auto componentType : { fastgltf::ComponentType::UnsignedByte, fastgltf::ComponentType::UnsignedShort,
+									fastgltf::ComponentType::UnsignedInt }) {
+			fgb::SyntheticAssetConfig config;
+			config.nodeCount = 0;
+			config.accessorCount = 1;
+			config.elementsPerAccessor = elementCount * 3;
+			config.bufferCount = 1;
+			config.accessorType = fastgltf::AccessorType::Scalar;
+			config.componentType = componentType;
+			const auto asset = fgb::generateAsset(config);
+
+			benchmarkCopyFromAccessor<std::uint32_t>(runner, asset,
+				std::string("copyFromAccessor/indices/") + std::string(getComponentTypeName(componentType)) + "->u32");
+		}
+	}
+
+	void benchmarkSparseAccessors(fgb::Runner& runner) {
+		const auto elementCount = 65536 * runner.getOptions().scale;
+
+		for (std::size_t percentage : { 0, 1, 10, 50 }) {
+			fgb::SyntheticAssetConfig config;
+			config.nodeCount = 0;
+			config.meshCount = 0;
+			config.accessorCount = 1;
+			config.elementsPerAccessor = elementCount;
+			config.bufferCount = 1;
+			config.sparseCount = elementCount * percentage / 100;
+			const auto asset = fgb::generateAsset(config);
+			const auto& accessor = asset.accessors.front();
+
+			const auto suffix = percentage == 0 ? std::string("dense") : "sparse-" + std::to_string(percentage) + "%";
+			runner.measure("iterateAccessor/vec3/" + suffix, accessor.count * sizeof(fastgltf::math::fvec3), [&]() {
+				fastgltf::math::fvec3 sum;
+				fastgltf::iterateAccessor<fastgltf::math::fvec3>(asset, accessor, [&](fastgltf::math::fvec3 value) {
+					sum += value;
+				});
+				fgb::doNotOptimize(sum);
+			});
+
+			// The same sum in chunks, as every thread of a parallel loop would compute it, and through the iterators.
+			const auto view = fastgltf::viewAccessor<fastgltf::math::fvec3>(asset, accessor);
+			runner.measure("accessorView/forEachChunk/vec3/" + suffix, accessor.count * sizeof(fastgltf::math::fvec3), [&]() {
+				fastgltf::math::fvec3 sum;
+				for (std::size_t begin = 0; begin < view.size(); begin += 4096) {
+					view.forEachChunk(begin, std::min<std::size_t>(begin + 4096, view.size()), [&](fastgltf::math::fvec3 value) {
+						sum += value;
+					});
+				}
+				fgb::doNotOptimize(sum);
+			});
+			runner.measure("accessorView/iterator/vec3/" + suffix, accessor.count * sizeof(fastgltf::math::fvec3), [&]() {
+				fastgltf::math::fvec3 sum;
+				for (auto value : view) {
+					sum += value;
+				}
+				fgb::doNotOptimize(sum);
+			});
+
+			std::vector<fastgltf::math::fvec3> destination(accessor.count);
+			runner.measure("copyFromAccessor/vec3/" + suffix, destination.size() * sizeof(fastgltf::math::fvec3), [&]() {
+				fastgltf::copyFromAccessor<fastgltf::math::fvec3>(asset, accessor, destination.data());
+				fgb::doNotOptimize(destination.data());
+			});
+		}
+	}
+
+	void benchmarkInterleavedVertices(fgb::Runner& runner) {
+		fgb::SyntheticAssetConfig config;
+		config.nodeCount = 0;
+		config.meshCount = 0;
+		config.accessorCount = 3;
+		config.elementsPerAccessor = 65536 * runner.getOptions().scale;
+		config.bufferCount = 1;
+		const auto asset = fgb::generateAsset(config);
+
+		fastgltf::Primitive primitive = {};
+		fastgltf::VertexLayout layout;
+		layout.stride = 3 * sizeof(fastgltf::math::fvec3);
+		for (std::string_view name : { "POSITION", "NORMAL", "TEXCOORD_0" }) {
+			const auto index = primitive.attributes.size();
+			primitive.attributes.emplace_back(fastgltf::Attribute { FASTGLTF_STD_PMR_NS::string(name), index });
+			layout.attributes.push_back({ name, index * sizeof(fastgltf::math::fvec3),
+				fastgltf::AccessorType::Vec3, fastgltf::ComponentType::Float });
+		}
+
+		std::vector<std::byte> vertices(config.elementsPerAccessor * layout.stride);
+		runner.measure("vertices/per-attribute", vertices.size(), [&]() {
+			for (std::size_t i = 0; i < primitive.attributes.size(); ++i) {
+				fastgltf::copyFromAccessor<fastgltf::math::fvec3, 3 * sizeof(fastgltf::math::fvec3)>(asset, asset.accessors[i],
+					vertices.data() + i * sizeof(fastgltf::math::fvec3));
+			}
+			fgb::doNotOptimize(vertices.data());
+		});
+		runner.measure("vertices/interleaved", vertices.size(), [&]() {
+			fastgltf::copyInterleavedVertices(asset, primitive, layout, vertices.data());
+			fgb::doNotOptimize(vertices.data());
+		});
+		runner.measure("vertices/interleaved-write-combined", vertices.size(), [&]() {
+			fastgltf::copyInterleavedVertices(asset, primitive, layout, vertices.data(), fastgltf::VertexDestination::WriteCombined);
+			fgb::doNotOptimize(vertices.data());
+		});
+	}
+
+	void benchmarkBounds(fgb::Runner& runner) {
+		fgb::SyntheticAssetConfig config;
+		config.nodeCount = 0;
+		config.meshCount = 0;
+		config.accessorCount = 1;
+		config.elementsPerAccessor = 262144 * runner.getOptions().scale;
+		auto asset = fgb::generateAsset(config);
+		const auto bytes = config.elementsPerAccessor * sizeof(fastgltf::math::fvec3);
+
+		runner.measure("bounds/vec3-iterate", bytes, [&]() {
+			fastgltf::BoundingBox bounds;
+			fastgltf::iterateAccessor<fastgltf::math::fvec3>(asset, asset.accessors[0], [&](const fastgltf::math::fvec3& position) {
+				bounds.merge(position);
+			});
+			fgb::doNotOptimize(bounds);
+		});
+		runner.measure("bounds/vec3-packed", bytes, [&]() {
+			auto bounds = fastgltf::computePositionBounds(asset, asset.accessors[0]);
+			fgb::doNotOptimize(bounds);
+		});
+
+		// Reinterpret the same data as Vec3 elements padded to 16 bytes.
+		config.accessorType = fastgltf::AccessorType::Vec4;
+		auto stridedAsset = fgb::generateAsset(config);
+		stridedAsset.accessors[0].type = fastgltf::AccessorType::Vec3;
+		stridedAsset.bufferViews[*stridedAsset.accessors[0].bufferViewIndex].byteStride = sizeof(fastgltf::math::fvec4);
+		runner.measure("bounds/vec3-strided", bytes, [&]() {
+			auto bounds = fastgltf::computePositionBounds(stridedAsset, stridedAsset.accessors[0]);
+			fgb::doNotOptimize(bounds);
+		});
+	}
+
+	void benchmarkSceneBVH(fgb::Runner& runner) {
+		fgb::SyntheticAssetConfig config;
+		config.nodeCount = 20000 * runner.getOptions().scale;
+		config.childrenPerNode = 4;
+		config.meshCount = 16;
+		config.accessorCount = 16;
+		config.elementsPerAccessor = 64;
+		const auto asset = fgb::generateAsset(config);
+
+		fastgltf::SceneTransformCache cache(asset, 0);
+		const auto meshBounds = fastgltf::computeMeshBounds(asset);
+		const fastgltf::span<const fastgltf::BoundingBox> meshBoundsSpan(meshBounds.data(), meshBounds.size());
+		runner.measure("bvh/build", 0, [&]() {
+			fastgltf::SceneBVH bvh(asset, cache, meshBoundsSpan);
+			fgb::doNotOptimize(bvh.getNodes().data());
+		});
+
+		// A frustum-like volume which only contains a small part of the scene.
+		fastgltf::SceneBVH bvh(asset, cache, meshBoundsSpan);
+		const std::array<fastgltf::math::fvec4, 6> planes {{
+			{ 1.f, 0.f, 0.f, 10.f }, { -1.f, 0.f, 0.f, 10.f }, { 0.f, 1.f, 0.f, 10.f },
+			{ 0.f, -1.f, 0.f, 10.f }, { 0.f, 0.f, 1.f, 10.f }, { 0.f, 0.f, -1.f, 10.f },
+		}};
+		std::vector<std::size_t> visible;
+		visible.reserve(bvh.size());
+		runner.measure("bvh/cull", 0, [&]() {
+			visible.clear();
+			bvh.cull(fastgltf::span<const fastgltf::math::fvec4>(planes.data(), planes.size()), visible);
+			fgb::doNotOptimize(visible.data());
+		});
+		runner.measure("bvh/cull-brute-force", 0, [&]() {
+			visible.clear();
+			const auto worldBounds = bvh.getWorldBounds();
+			for (std::size_t i = 0; i < worldBounds.size(); ++i) {
+				bool inside = true;
+				for (const auto& plane : planes) {
+					float farthest = plane.w();
+					for (std::size_t j = 0; j < 3; ++j)
+						farthest += plane[j] * (plane[j] >= 0.f ? worldBounds[i].max[j] : worldBounds[i].min[j]);
+					inside &= farthest >= 0.f;
+				}
+				if (inside)
+					visible.emplace_back(bvh.getNodeIndices()[i]);
+			}
+			fgb::doNotOptimize(visible.data());
+		});
+		runner.measure("bvh/refit", 0, [&]() {
+			bvh.refit(cache);
+			fgb::doNotOptimize(bvh.getNodes().data());
+		});
+	}
+
+	void benchmarkSceneIteration(fgb::Runner& runner) {
+		const auto scale = runner.getOptions().scale;
+
+		// A wide and shallow hierarchy, and a single long chain of nodes.
+		for (auto [name, nodeCount, childrenPerNode] : { std::tuple { "wide", 10000 * scale, std::size_t(4) },
+														 std::tuple { "deep", 1000 * scale, std::size_t(1) } }) {
+			fgb::SyntheticAssetConfig config;
+			config.nodeCount = nodeCount;
+			config.childrenPerNode = childrenPerNode;
+			config.meshCount = 0;
+			config.accessorCount = 0;
+			const auto asset = fgb::generateAsset(config);
+
+			runner.measure(std::string("iterateSceneNodes/") + name, 0, [&]() {
+				fastgltf::math::fvec3 sum;
+				fastgltf::iterateSceneNodes(asset, 0, fastgltf::math::fmat4x4(), [&](const fastgltf::Node&, const fastgltf::math::fmat4x4& matrix) {
+					sum += fastgltf::math::fvec3(matrix.col(3).x(), matrix.col(3).y(), matrix.col(3).z());
+				});
+				fgb::doNotOptimize(sum);
+			});
+		}
+	}
+
+	void benchmarkBatchLoading(fgb::Runner& runner) {
+		// A directory of GLBs of different sizes, as an import service would see them.
+		const auto directory = std::filesystem::temp_directory_path() / "fastgltf_benchmarks";
+		std::error_code ec;
+		std::filesystem::create_directories(directory, ec);
+		std::vector<std::filesystem::path> paths;
+		std::size_t totalBytes = 0;
+		fastgltf::Exporter exporter;
+		for (std::size_t i = 0; i < 64 * runner.getOptions().scale; ++i) {
+			fgb::SyntheticAssetConfig config;
+			config.seed = static_cast<std::uint32_t>(i);
+			config.nodeCount = 100 + (i % 8) * 200;
+			config.meshCount = 16;
+			config.accessorCount = 16 + (i % 4) * 16;
+			config.elementsPerAccessor = 256;
+			auto glb = exporter.writeGltfBinary(fgb::generateAsset(config));
+			if (glb.error() != fastgltf::Error::None) {
+				std::cerr << "Failed to export the synthetic asset: " << fastgltf::getErrorMessage(glb.error()) << '\n';
+				return;
+			}
+
+			auto& path = paths.emplace_back(directory / ("asset" + std::to_string(i) + ".glb"));
+			std::ofstream file(path, std::ios::binary);
+			file.write(reinterpret_cast<const char*>(glb->output.data()), static_cast<std::streamsize>(glb->output.size()));
+			totalBytes += glb->output.size();
+		}
+
+		fastgltf::Parser parser;
+		runner.measure("batch/sequential", totalBytes, [&]() {
+			for (const auto& path : paths) {
+				auto data = fastgltf::GltfDataBuffer::FromPath(path);
+				auto result = parser.loadGltfBinary(data.get(), directory);
+				fgb::doNotOptimize(result.error());
+			}
+		});
+
+		fastgltf::BatchLoader loader;
+		runner.measure("batch/loader", totalBytes, [&]() {
+			loader.load(fastgltf::span<const std::filesystem::path>(paths.data(), paths.size()),
+				[](std::size_t, fastgltf::Expected<fastgltf::Asset>& asset, void*) {
+					fgb::doNotOptimize(asset.error());
+				});
+		});
+
+		for (const auto& path : paths) {
+			std::filesystem::remove(path, ec);
+		}
+		std::filesystem::remove(directory, ec);
+	}
+
+	void benchmarkExternalFileCache(fgb::Runner& runner) {
+		// Many small assets of a level kit which all reference the same large external buffer.
+		const auto directory = std::filesystem::temp_directory_path() / "fastgltf_benchmarks_cache";
+		std::error_code ec;
+		std::filesystem::create_directories(directory, ec);
+		const std::size_t bufferSize = 4 * 1024 * 1024;
+		{
+			std::ofstream file(directory / "shared.bin", std::ios::binary);
+			const std::vector<char> bytes(bufferSize, 1);
+			file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+		}
+		const auto json = R"({"asset":{"version":"2.0"},"buffers":[{"byteLength":)" + std::to_string(bufferSize) + R"(,"uri":"shared.bin"}]})";
+		auto jsonData = fastgltf::GltfDataBuffer::FromBytes(reinterpret_cast<const std::byte*>(json.data()), json.size());
+		const std::size_t assetCount = 16;
+
+		fastgltf::Parser parser;
+		runner.measure("external-files/private", 0, [&]() {
+			std::vector<fastgltf::Asset> assets;
+			for (std::size_t i = 0; i < assetCount; ++i) {
+				auto result = parser.loadGltfJson(jsonData.get(), directory, fastgltf::Options::LoadExternalBuffers);
+				assets.emplace_back(std::move(result.get()));
+			}
+			fgb::doNotOptimize(assets.data());
+		});
+
+		fastgltf::ExternalFileCache cache;
+		parser.setExternalFileCache(&cache);
+		runner.measure("external-files/cached", 0, [&]() {
+			std::vector<fastgltf::Asset> assets;
+			for (std::size_t i = 0; i < assetCount; ++i) {
+				auto result = parser.loadGltfJson(jsonData.get(), directory, fastgltf::Options::LoadExternalBuffers);
+				assets.emplace_back(std::move(result.get()));
+			}
+			fgb::doNotOptimize(assets.data());
+		});
+
+		std::filesystem::remove_all(directory, ec);
+	}
+
+	void benchmarkExportAndValidation(fgb::Runner& runner) {
+		const auto scale = runner.getOptions().scale;
+
+		fgb::SyntheticAssetConfig config;
+		config.nodeCount *= scale;
+		config.meshCount *= scale;
+		config.accessorCount *= scale;
+		const auto asset = fgb::generateAsset(config);
+		const auto bufferBytes = getBufferByteSize(asset);
+
+		if (auto error = fastgltf::validate(asset); error != fastgltf::Error::None) {
+			std::cerr << "The synthetic asset failed to validate: " << fastgltf::getErrorMessage(error) << '\n';
+			return;
+		}
+		runner.measure("validate/scene", 0, [&]() {
+			fgb::doNotOptimize(fastgltf::validate(asset));
+		});
+
+		// Revalidating after a single node was changed, as an editor would before every save.
+		fastgltf::AssetValidator validator;
+		(void)validator.revalidate(asset);
+		runner.measure("validate/scene-incremental", 0, [&]() {
+			validator.markDirty(fastgltf::Category::Nodes, 0);
+			fgb::doNotOptimize(validator.revalidate(asset));
+		});
+
+		fastgltf::Exporter exporter;
+		auto json = exporter.writeGltfJson(asset);
+		if (json.error() != fastgltf::Error::None) {
+			std::cerr << "Failed to export the synthetic asset: " << fastgltf::getErrorMessage(json.error()) << '\n';
+			return;
+		}
+		const auto jsonSize = json->output.size();
+
+		runner.measure("exporter/json", jsonSize, [&]() {
+			auto result = exporter.writeGltfJson(asset);
+			fgb::doNotOptimize(result->output.data());
+		});
+		runner.measure("exporter/json-pretty", jsonSize, [&]() {
+			auto result = exporter.writeGltfJson(asset, fastgltf::ExportOptions::PrettyPrintJson);
+			fgb::doNotOptimize(result->output.data());
+		});
+		runner.measure("exporter/json-data-uris", bufferBytes, [&]() {
+			auto result = exporter.writeGltfJson(asset, fastgltf::ExportOptions::WriteDataUris);
+			fgb::doNotOptimize(result->output.data());
+		});
+		runner.measure("exporter/glb", jsonSize + asset.buffers.front().byteLength, [&]() {
+			auto result = exporter.writeGltfBinary(asset);
+			fgb::doNotOptimize(result->output.data());
+		});
+#if FASTGLTF_ENABLE_MESHOPT_ENCODER
+		runner.measure("exporter/glb-meshopt", bufferBytes, [&]() {
+			auto result = exporter.writeGltfBinary(asset, fastgltf::ExportOptions::MeshoptCompression);
+			fgb::doNotOptimize(result->output.data());
+		});
+#endif
+
+		// Parsing the exported JSON again, and loading the equivalent asset cache.
+		auto jsonData = fastgltf::GltfDataBuffer::FromBytes(reinterpret_cast<const std::byte*>(json->output.data()), jsonSize);
+		fastgltf::Parser parser;
+		runner.measure("parser/json", jsonSize, [&]() {
+			auto result = parser.loadGltfJson(jsonData.get(), {}, fastgltf::Options::None);
+			fgb::doNotOptimize(result.error());
+		});
+
+		auto cache = exporter.writeAssetCache(asset, 0);
+		if (cache.error() == fastgltf::Error::None) {
+			auto cacheData = fastgltf::GltfDataBuffer::FromBytes(cache->data(), cache->size());
+			runner.measure("parser/asset-cache", cache->size(), [&]() {
+				auto result = parser.loadAssetCache(cacheData.get(), 0);
+				fgb::doNotOptimize(result.error());
+			});
+		}
+	}
+
+	template <typename T>
+	bool parseNumber(std::string_view string, T& value) {
+		auto [ptr, ec] = std::from_chars(string.data(), string.data() + string.size(), value);
+		return ec == std::errc() && ptr == string.data() + string.size();
+	}
+
+	void printUsage() {
+		std::cout << "Usage: fastgltf_benchmarks [options]\n"
+				  << "  --filter <text>          Only run benchmarks whose name contains the text\n"
+				  << "  --json <file>            Write the results as JSON into the file\n"
+				  << "  --samples <count>        Number of timed samples per benchmark (default 20)\n"
+				  << "  --min-sample-time <ms>   Minimum duration of every sample (default 5)\n"
+				  << "  --scale <factor>         Multiplies the size of the synthetic assets (default 1)\n"
+				  << "  --list                   Only list the names of the benchmarks\n";
+	}
+} // namespace
+
+int main(int argc, char* argv[]) {
+	fgb::RunnerOptions options;
+	std::string jsonPath;
+
+	for (int i = 1; i < argc; ++i) {
+		const std::string_view argument = argv[i];
+		const bool hasValue = i + 1 < argc;
+		std::size_t number = 0;
+		if (argument == "--filter" && hasValue) {
+			options.filter = argv[++i];
+		} else if (argument == "--json" && hasValue) {
+			jsonPath = argv[++i];
+		} else if (argument == "--samples" && hasValue && parseNumber(argv[++i], number) && number != 0) {
+			options.sampleCount = number;
+		} else if (argument == "--min-sample-time" && hasValue && parseNumber(argv[++i], number)) {
+			options.minSampleTime = std::chrono::milliseconds(number);
+		} else if (argument == "--scale" && hasValue && parseNumber(argv[++i], number) && number != 0) {
+			options.scale = number;
+		} else if (argument == "--list") {
+			options.listOnly = true;
+		} else {
+			printUsage();
+			return argument == "--help" ? 0 : 1;
+		}
+	}
+
+#if !defined(NDEBUG)
+	std::cerr << "Warning: The benchmarks were not built with optimisations enabled.\n";
+#endif
+
+	fgb::Runner runner(options);
+	benchmarkAccessorConversions(runner);
+	benchmarkSparseAccessors(runner);
+	benchmarkInterleavedVertices(runner);
+	benchmarkBounds(runner);
+	benchmarkSceneBVH(runner);
+	benchmarkSceneIteration(runner);
+	benchmarkExportAndValidation(runner);
+	benchmarkBatchLoading(runner);
+	benchmarkExternalFileCache(runner);
+
+	if (!jsonPath.empty() && !options.listOnly) {
+		std::ofstream file(jsonPath);
+		if (!file.is_open()) {
+			std::cerr << "Failed to open " << jsonPath << '\n';
+			return 1;
+		}
+		runner.writeJson(file);
+	}
+	return 0;
+}
@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <random>
+
+#include "generators.hpp"
+
+namespace fastgltf::benchmarks {
+	namespace {
+		template <typename T>
+		void fillComponents(std::mt19937& random, std::byte* destination, std::size_t componentCount) {
+			for (std::size_t i = 0; i < componentCount; ++i) {
+				T value;
+				if constexpr (std::is_floating_point_v<T>) {
+					value = std::uniform_real_distribution<T>(T(-1), T(1))(random);
+				} else {
+					value = static_cast<T>(std::uniform_int_distribution<std::int64_t>(
+						std::numeric_limits<T>::min(), std::numeric_limits<T>::max())(random));
+				}
+				std::memcpy(destination + i * sizeof(T), &value, sizeof(T));
+			}
+		}
+
+		void fillElements(std::mt19937& random, ComponentType componentType, std::byte* destination, std::size_t componentCount) {
+			switch (componentType) {
+				case ComponentType::Byte: fillComponents<std::int8_t>(random, destination, componentCount); break;
+				case ComponentType::UnsignedByte: fillComponents<std::uint8_t>(random, destination, componentCount); break;
+				case ComponentType::Short: fillComponents<std::int16_t>(random, destination, componentCount); break;
+				case ComponentType::UnsignedShort: fillComponents<std::uint16_t>(random, destination, componentCount); break;
+				case ComponentType::Int: fillComponents<std::int32_t>(random, destination, componentCount); break;
+				case ComponentType::UnsignedInt: fillComponents<std::uint32_t>(random, destination, componentCount); break;
+				case ComponentType::Float: fillComponents<float>(random, destination, componentCount); break;
+				case ComponentType::Double: fillComponents<double>(random, destination, componentCount); break;
+				default: break;
+			}
+		}
+
+		void computeFloatBounds(Accessor& accessor, const std::byte* data, std::size_t count) {
+			auto max = AccessorBoundsArray::ForType<double>(3);
+			auto min = AccessorBoundsArray::ForType<double>(3);
+			for (std::size_t j = 0; j < 3; ++j) {
+				max.set<double>(j, -std::numeric_limits<double>::infinity());
+				min.set<double>(j, std::numeric_limits<double>::infinity());
+			}
+			for (std::size_t i = 0; i < count; ++i) {
+				for (std::size_t j = 0; j < 3; ++j) {
+					float value;
+					std::memcpy(&value, data + (i * 3 + j) * sizeof(float), sizeof(float));
+					max.set<double>(j, std::max(max.get<double>(j), static_cast<double>(value)));
+					min.set<double>(j, std::min(min.get<double>(j), static_cast<double>(value)));
+				}
+			}
+			accessor.max = std::move(max);
+			accessor.min = std::move(min);
+		}
+	} // namespace
+
+	Asset generateAsset(const SyntheticAssetConfig& config) {
+		std::mt19937 random(config.seed);
+
+		Asset asset;
+		asset.assetInfo = AssetInfo { "2.0", {}, "fastgltf benchmarks" };
+
+		const auto bufferCount = std::max<std::size_t>(config.bufferCount, 1);
+		std::vector<std::vector<std::byte>> buffers(bufferCount);
+
+		// Appends a new buffer view to one of the buffers, keeping every view aligned to 4 bytes.
+		auto addBufferView = [&](std::size_t bufferIndex, std::size_t byteLength) -> std::byte* {
+			auto& buffer = buffers[bufferIndex];
+			const auto byteOffset = (buffer.size() + 3) & ~std::size_t(3);
+			buffer.resize(byteOffset + byteLength);
+
+			BufferView view = {};
+			view.bufferIndex = bufferIndex;
+			view.byteOffset = byteOffset;
+			view.byteLength = byteLength;
+			asset.bufferViews.emplace_back(std::move(view));
+			return buffer.data() + byteOffset;
+		};
+
+		const auto componentCount = getNumComponents(config.accessorType);
+		const auto elementSize = getElementByteSize(config.accessorType, config.componentType);
+		const auto elementCount = std::max<std::size_t>(config.elementsPerAccessor, 1);
+		const auto sparseCount = std::min(config.sparseCount, elementCount);
+		const bool hasPositions = config.accessorType == AccessorType::Vec3 && config.componentType == ComponentType::Float;
+
+		asset.accessors.reserve(config.accessorCount);
+		for (std::size_t i = 0; i < config.accessorCount; ++i) {
+			const auto bufferIndex = i % bufferCount;
+
+			Accessor accessor = {};
+			accessor.count = elementCount;
+			accessor.type = config.accessorType;
+			accessor.componentType = config.componentType;
+			accessor.normalized = config.normalized;
+
+			auto* data = addBufferView(bufferIndex, elementSize * elementCount);
+			accessor.bufferViewIndex = asset.bufferViews.size() - 1;
+			fillElements(random, config.componentType, data, elementCount * componentCount);
+			if (hasPositions) {
+				computeFloatBounds(accessor, data, elementCount);
+			}
+
+			if (sparseCount != 0) {
+				// Substitute one element out of every stride, which keeps the indices sorted and unique.
+				auto* indices = addBufferView(bufferIndex, sparseCount * sizeof(std::uint32_t));
+				const auto indicesView = asset.bufferViews.size() - 1;
+				const auto stride = elementCount / sparseCount;
+				for (std::size_t j = 0; j < sparseCount; ++j) {
+					const auto index = static_cast<std::uint32_t>(j * stride + std::uniform_int_distribution<std::size_t>(0, stride - 1)(random));
+					std::memcpy(indices + j * sizeof(std::uint32_t), &index, sizeof(index));
+				}
+
+				auto* values = addBufferView(bufferIndex, sparseCount * elementSize);
+				fillElements(random, config.componentType, values, sparseCount * componentCount);
+				accessor.sparse = SparseAccessor { sparseCount, indicesView, 0, asset.bufferViews.size() - 1, 0, ComponentType::UnsignedInt };
+				if (hasPositions) {
+					// The bounds only need to be valid, so the substituted values can be ignored here.
+					accessor.max->set<double>(0, std::max(accessor.max->get<double>(0), 1.0));
+					accessor.min->set<double>(0, std::min(accessor.min->get<double>(0), -1.0));
+				}
+			}
+
+			asset.accessors.emplace_back(std::move(accessor));
+		}
+
+		asset.buffers.reserve(bufferCount);
+		for (auto& bytes : buffers) {
+			Buffer buffer = {};
+			buffer.byteLength = std::max<std::size_t>(bytes.size(), 1);
+			bytes.resize(buffer.byteLength);
+			buffer.data = sources::Vector { std::move(bytes), MimeType::GltfBuffer };
+			asset.buffers.emplace_back(std::move(buffer));
+		}
+
+		const auto meshCount = hasPositions && config.accessorCount != 0 ? config.meshCount : 0;
+		asset.meshes.reserve(meshCount);
+		for (std::size_t i = 0; i < meshCount; ++i) {
+			Primitive primitive = {};
+			primitive.attributes.emplace_back(Attribute { "POSITION", i % config.accessorCount });
+
+			Mesh mesh = {};
+			mesh.primitives.emplace_back(std::move(primitive));
+			asset.meshes.emplace_back(std::move(mesh));
+		}
+
+		std::uniform_real_distribution<float> translation(-10.f, 10.f);
+		std::uniform_real_distribution<float> angle(-1.f, 1.f);
+		asset.nodes.reserve(config.nodeCount);
+		for (std::size_t i = 0; i < config.nodeCount; ++i) {
+			Node node = {};
+			TRS trs = {};
+			trs.translation = math::fvec3(translation(random), translation(random), translation(random));
+			trs.rotation = math::normalize(math::fquat(angle(random), angle(random), angle(random), 1.f));
+			node.transform = trs;
+
+			if (meshCount != 0) {
+				node.meshIndex = i % meshCount;
+			}
+			for (std::size_t child = 1; child <= config.childrenPerNode; ++child) {
+				const auto childIndex = i * config.childrenPerNode + child;
+				if (childIndex >= config.nodeCount)
+					break;
+				node.children.emplace_back(childIndex);
+			}
+			asset.nodes.emplace_back(std::move(node));
+		}
+
+		Scene scene = {};
+		if (config.nodeCount != 0) {
+			scene.nodeIndices.emplace_back(0);
+		}
+		asset.scenes.emplace_back(std::move(scene));
+		asset.defaultScene = 0;
+		return asset;
+	}
+} // namespace fastgltf::benchmarks
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+
+#include <fastgltf/types.hpp>
+
+namespace fastgltf::benchmarks {
+	/**
+	 * Describes a synthetic asset. Every count scales independently, and the same configuration
+	 * always generates exactly the same asset, so that results stay comparable between runs.
+	 */
+	struct SyntheticAssetConfig {
+		/** The nodes form a tree in which every node has up to childrenPerNode children. */
+		std::size_t nodeCount = 10000;
+		std::size_t childrenPerNode = 4;
+
+		/** Each mesh has a single primitive which uses one of the accessors as its POSITION attribute. */
+		std::size_t meshCount = 1000;
+
+		/** Every accessor has its own buffer view, and the views are distributed over all buffers. */
+		std::size_t accessorCount = 1000;
+		std::size_t elementsPerAccessor = 1024;
+		std::size_t bufferCount = 4;
+
+		AccessorType accessorType = AccessorType::Vec3;
+		ComponentType componentType = ComponentType::Float;
+		bool normalized = false;
+
+		/** The number of elements each accessor substitutes through a sparse accessor, or 0 for dense accessors. */
+		std::size_t sparseCount = 0;
+
+		std::uint32_t seed = 1;
+	};
+
+	/**
+	 * Generates an asset with the given configuration. All buffers are held in memory as sources::Vector.
+	 * Meshes are only generated for float Vec3 accessors, which get their bounds computed, so that the asset
+	 * passes fastgltf::validate.
+	 */
+	[[nodiscard]] Asset generateAsset(const SyntheticAssetConfig& config);
+} // namespace fastgltf::benchmarks
@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+
+#include "harness.hpp"
+
+namespace fastgltf::benchmarks {
+	namespace {
+		void writeJsonString(std::ostream& stream, std::string_view string) {
+			stream << '"';
+			for (const auto c : string) {
+				if (c == '"' || c == '\\') {
+					stream << '\\' << c;
+				} else if (static_cast<unsigned char>(c) < 0x20) {
+					stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec << std::setfill(' ');
+				} else {
+					stream << c;
+				}
+			}
+			stream << '"';
+		}
+
+		std::string_view getCompilerName() {
+#if defined(__clang__)
+			return "clang " __clang_version__;
+#elif defined(__GNUC__)
+			return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+			return "msvc";
+#else
+			return "unknown";
+#endif
+		}
+	} // namespace
+
+	bool Runner::isEnabled(std::string_view name) const {
+		if (!options.filter.empty() && name.find(options.filter) == std::string_view::npos)
+			return false;
+		if (options.listOnly) {
+			std::cout << name << '\n';
+			return false;
+		}
+		return true;
+	}
+
+	void Runner::addResult(std::string_view name, std::size_t iterations, std::vector<double>& samples, std::size_t bytesPerIteration) {
+		std::sort(samples.begin(), samples.end());
+
+		BenchmarkResult result = {};
+		result.name = name;
+		result.iterationsPerSample = iterations;
+		result.sampleCount = samples.size();
+		result.bytesPerIteration = bytesPerIteration;
+		if (!samples.empty()) {
+			const auto middle = samples.size() / 2;
+			result.median = samples.size() % 2 == 0 ? (samples[middle - 1] + samples[middle]) / 2 : samples[middle];
+			result.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+			result.min = samples.front();
+			result.max = samples.back();
+
+			double variance = 0.0;
+			for (const auto sample : samples) {
+				variance += (sample - result.mean) * (sample - result.mean);
+			}
+			result.standardDeviation = std::sqrt(variance / static_cast<double>(samples.size()));
+		}
+
+		std::cout << std::left << std::setw(56) << name << std::right << std::fixed << std::setprecision(1)
+			<< std::setw(14) << result.median << " ns" << std::setw(12) << result.standardDeviation << " ns";
+		if (bytesPerIteration != 0) {
+			std::cout << std::setw(12) << static_cast<double>(bytesPerIteration) / result.median * 1e3 << " MB/s";
+		}
+		std::cout << std::endl;
+
+		results.emplace_back(std::move(result));
+	}
+
+	void Runner::writeJson(std::ostream& stream) const {
+		stream << std::setprecision(17) << "{\n  \"context\": {\n";
+		stream << "    \"library\": \"fastgltf\",\n";
+		stream << "    \"version\": \"" << FASTGLTF_BENCHMARK_VERSION << "\",\n";
+		stream << "    \"compiler\": ";
+		writeJsonString(stream, getCompilerName());
+		stream << ",\n";
+#if defined(NDEBUG)
+		stream << "    \"optimized\": true,\n";
+#else
+		stream << "    \"optimized\": false,\n";
+#endif
+		stream << "    \"sampleCount\": " << options.sampleCount << ",\n";
+		stream << "    \"minSampleTimeNs\": " << options.minSampleTime.count() << ",\n";
+		stream << "    \"scale\": " << options.scale << "\n";
+		stream << "  },\n  \"benchmarks\": [";
+
+		for (std::size_t i = 0; i < results.size(); ++i) {
+			const auto& result = results[i];
+			stream << (i == 0 ? "\n" : ",\n") << "    {\n      \"name\": ";
+			writeJsonString(stream, result.name);
+			stream << ",\n      \"iterationsPerSample\": " << result.iterationsPerSample
+				   << ",\n      \"sampleCount\": " << result.sampleCount
+				   << ",\n      \"medianNs\": " << result.median
+				   << ",\n      \"meanNs\": " << result.mean
+				   << ",\n      \"minNs\": " << result.min
+				   << ",\n      \"maxNs\": " << result.max
+				   << ",\n      \"standardDeviationNs\": " << result.standardDeviation
+				   << ",\n      \"bytesPerIteration\": " << result.bytesPerIteration
+				   << "\n    }";
+		}
+		stream << "\n  ]\n}\n";
+	}
+} // namespace fastgltf::benchmarks
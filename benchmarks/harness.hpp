@@ -0,0 +1,111 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fastgltf::benchmarks {
+	/**
+	 * Keeps the compiler from optimising away a value which is only computed for a benchmark.
+	 */
+	template <typename T>
+	inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile const void* sink;
+		sink = static_cast<const void*>(&value);
+#endif
+	}
+
+	struct RunnerOptions {
+		/** Only benchmarks whose name contains this string are run. */
+		std::string filter;
+
+		/** The number of timed samples per benchmark, each of which runs the benchmark at least minSampleTime. */
+		std::size_t sampleCount = 20;
+		std::chrono::nanoseconds minSampleTime = std::chrono::milliseconds(5);
+
+		/** Multiplies the counts of all synthetic assets. */
+		std::size_t scale = 1;
+
+		/** Only lists the names of the benchmarks instead of running them. */
+		bool listOnly = false;
+	};
+
+	struct BenchmarkResult {
+		std::string name;
+		std::size_t iterationsPerSample;
+		std::size_t sampleCount;
+
+		/** Statistics over the time per iteration of all samples, in nanoseconds. */
+		double median;
+		double mean;
+		double min;
+		double max;
+		double standardDeviation;
+
+		/** The number of bytes each iteration processes, or 0 if the benchmark does not report any. */
+		std::size_t bytesPerIteration;
+	};
+
+	/**
+	 * Runs and times benchmarks. Every benchmark is first run once to warm up, then calibrated so that
+	 * each sample takes at least RunnerOptions::minSampleTime, and then timed for RunnerOptions::sampleCount samples.
+	 */
+	class Runner {
+		RunnerOptions options;
+		std::vector<BenchmarkResult> results;
+
+		[[nodiscard]] bool isEnabled(std::string_view name) const;
+		void addResult(std::string_view name, std::size_t iterations, std::vector<double>& samples, std::size_t bytesPerIteration);
+
+	public:
+		explicit Runner(RunnerOptions options) : options(std::move(options)) {}
+
+		[[nodiscard]] const RunnerOptions& getOptions() const noexcept {
+			return options;
+		}
+
+		[[nodiscard]] const std::vector<BenchmarkResult>& getResults() const noexcept {
+			return results;
+		}
+
+		template <typename Function>
+		void measure(std::string_view name, std::size_t bytesPerIteration, Function&& function) {
+			if (!isEnabled(name))
+				return;
+
+			using clock = std::chrono::steady_clock;
+			auto runIterations = [&](std::size_t iterations) {
+				const auto start = clock::now();
+				for (std::size_t i = 0; i < iterations; ++i) {
+					function();
+				}
+				return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start);
+			};
+
+			// Double the iterations until a single sample takes long enough to be measured reliably.
+			// The first run also serves as the warm-up.
+			std::size_t iterations = 1;
+			auto elapsed = runIterations(iterations);
+			while (elapsed < options.minSampleTime && iterations < (std::size_t(1) << 30)) {
+				iterations *= 2;
+				elapsed = runIterations(iterations);
+			}
+
+			std::vector<double> samples;
+			samples.reserve(options.sampleCount);
+			for (std::size_t i = 0; i < options.sampleCount; ++i) {
+				samples.emplace_back(static_cast<double>(runIterations(iterations).count()) / static_cast<double>(iterations));
+			}
+			addResult(name, iterations, samples, bytesPerIteration);
+		}
+
+		/** Writes all results as a JSON document, which also describes the build and the runner options. */
+		void writeJson(std::ostream& stream) const;
+	};
+} // namespace fastgltf::benchmarks
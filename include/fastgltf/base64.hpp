@@ -31,6 +31,7 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <string>
 #include <string_view>
 #endif
 
@@ -66,12 +67,21 @@ namespace fastgltf::base64 {
         return (encodedSize / 4) * 3 - padding;
     }
 
+    /**
+     * Calculates the size of the base64 encoded string, including the padding, for data of the given size.
+     */
+    FASTGLTF_EXPORT [[gnu::always_inline]] constexpr std::size_t getEncodedSize(std::size_t size) noexcept {
+        return ((size + 2) / 3) * 4;
+    }
+
 #if defined(FASTGLTF_IS_X86)
     void sse4_decode_inplace(std::string_view encoded, std::uint8_t* output, std::size_t padding);
     void avx2_decode_inplace(std::string_view encoded, std::uint8_t* output, std::size_t padding);
+    void avx512_decode_inplace(std::string_view encoded, std::uint8_t* output, std::size_t padding);
 
     [[nodiscard]] StaticVector<std::uint8_t> sse4_decode(std::string_view encoded);
     [[nodiscard]] StaticVector<std::uint8_t> avx2_decode(std::string_view encoded);
+    [[nodiscard]] StaticVector<std::uint8_t> avx512_decode(std::string_view encoded);
 #elif defined(FASTGLTF_IS_A64)
     void neon_decode_inplace(std::string_view encoded, std::uint8_t* output, std::size_t padding);
     [[nodiscard]] StaticVector<std::uint8_t> neon_decode(std::string_view encoded);
@@ -81,6 +91,27 @@ namespace fastgltf::base64 {
 
     [[nodiscard]] StaticVector<std::uint8_t> fallback_decode(std::string_view encoded);
     FASTGLTF_EXPORT [[nodiscard]] StaticVector<std::uint8_t> decode(std::string_view encoded);
+
+#if defined(FASTGLTF_IS_X86)
+    void sse4_encode_inplace(span<const std::byte> data, char* output);
+    void avx2_encode_inplace(span<const std::byte> data, char* output);
+
+    [[nodiscard]] std::string sse4_encode(span<const std::byte> data);
+    [[nodiscard]] std::string avx2_encode(span<const std::byte> data);
+#elif defined(FASTGLTF_IS_A64)
+    void neon_encode_inplace(span<const std::byte> data, char* output);
+    [[nodiscard]] std::string neon_encode(span<const std::byte> data);
+#endif
+    void fallback_encode_inplace(span<const std::byte> data, char* output);
+
+    /**
+     * Encodes the data into output, which has to hold at least getEncodedSize(data.size()) chars.
+     * The output is padded with '=', but is not null-terminated.
+     */
+    FASTGLTF_EXPORT void encode_inplace(span<const std::byte> data, char* output);
+
+    [[nodiscard]] std::string fallback_encode(span<const std::byte> data);
+    FASTGLTF_EXPORT [[nodiscard]] std::string encode(span<const std::byte> data);
 } // namespace fastgltf::base64
 
 #ifdef _MSC_VER
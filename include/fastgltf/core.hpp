@@ -28,13 +28,26 @@
 #define FASTGLTF_CORE_HPP
 
 #if !defined(FASTGLTF_USE_STD_MODULE) || !FASTGLTF_USE_STD_MODULE
+#include <array>
+#include <chrono>
 #include <fstream>
+#include <future>
 #include <memory>
+#include <optional>
 #include <tuple>
 #endif
 
 #include <fastgltf/types.hpp>
 
+#if FASTGLTF_CPP_20 && __has_include(<coroutine>)
+#define FASTGLTF_HAS_COROUTINES 1
+#if !defined(FASTGLTF_USE_STD_MODULE) || !FASTGLTF_USE_STD_MODULE
+#include <coroutine>
+#endif
+#else
+#define FASTGLTF_HAS_COROUTINES 0
+#endif
+
 #ifdef _MSC_VER
 #pragma warning(push)
 #pragma warning(disable : 5030) // attribute 'x' is not recognized
@@ -92,6 +105,9 @@ namespace fastgltf {
 		InvalidFileData = 12, ///< The file data is invalid, or the file type could not be determined.
 		FailedWritingFiles = 13, ///< The exporter failed to write some files (buffers/images) to disk.
 		FileBufferAllocationFailed = 14, ///< The constructor of GltfDataBuffer failed to allocate a sufficiently large buffer.
+		InvalidCompressedData = 15, ///< With Options::DecodeMeshoptCompression, a compressed buffer view could not be decoded.
+		LoadCancelled = 16, ///< The LoadProgressCallback cancelled the load.
+		InvalidAssetCache = 17, ///< The asset cache is corrupted, was written by another version, or was created from different data.
     };
 
 	FASTGLTF_EXPORT constexpr std::string_view getErrorName(Error error) {
@@ -111,6 +127,9 @@ namespace fastgltf {
             case Error::InvalidFileData: return "InvalidFileData";
             case Error::FailedWritingFiles: return "FailedWritingFiles";
 			case Error::FileBufferAllocationFailed: return "FileBufferAllocationFailed";
+			case Error::InvalidCompressedData: return "InvalidCompressedData";
+			case Error::LoadCancelled: return "LoadCancelled";
+			case Error::InvalidAssetCache: return "InvalidAssetCache";
 			default: FASTGLTF_UNREACHABLE
 		}
 	}
@@ -132,6 +151,9 @@ namespace fastgltf {
             case Error::InvalidFileData: return "The file data is invalid, or the file type could not be determined.";
             case Error::FailedWritingFiles: return "The exporter failed to write some files (buffers/images) to disk.";
 			case Error::FileBufferAllocationFailed: return "The constructor of GltfDataBuffer failed to allocate a sufficiently large buffer.";
+			case Error::InvalidCompressedData: return "A compressed buffer view could not be decoded.";
+			case Error::LoadCancelled: return "The load was cancelled by the progress callback.";
+			case Error::InvalidAssetCache: return "The asset cache is invalid, outdated, or was created from different data.";
 			default: FASTGLTF_UNREACHABLE
 		}
 	}
@@ -235,6 +257,17 @@ namespace fastgltf {
 		return static_cast<Extensions>(to_underlying(a) - b);
 	}
 
+	/**
+	 * The extensions the parser was compiled with, as configured through the FASTGLTF_COMPILED_EXTENSIONS CMake option.
+	 * All other extensions are ignored by the Parser, even when passed to its constructor, and the code parsing them is
+	 * removed from the library. If such an extension is required by a glTF, loading it fails with Error::MissingExtensions.
+	 */
+#ifdef FASTGLTF_COMPILED_EXTENSIONS
+	FASTGLTF_EXPORT inline constexpr Extensions compiledExtensions = FASTGLTF_COMPILED_EXTENSIONS;
+#else
+	FASTGLTF_EXPORT inline constexpr Extensions compiledExtensions = ~Extensions::None;
+#endif
+
     // clang-format off
     FASTGLTF_EXPORT enum class Options : std::uint64_t {
         None                            = 0,
@@ -284,11 +317,106 @@ namespace fastgltf {
         LoadExternalImages              = 1 << 7,
 
 		/**
-		 * Lets fastgltf generate indices for all mesh primitives without indices. This currently
-		 * does not de-duplicate the vertices. This is entirely for compatibility and simplifying the
-		 * loading process.
+		 * Lets fastgltf generate indices for all mesh primitives without indices. This does not
+		 * de-duplicate the vertices, unless Options::WeldMeshVertices is also specified. This is
+		 * entirely for compatibility and simplifying the loading process.
 		 */
 		GenerateMeshIndices             = 1 << 8,
+
+		/**
+		 * Avoids copying the BIN chunk of a GLB file. If the GltfDataGetter can share its memory through
+		 * GltfDataGetter::shareData, like GltfDataBuffer and MappedGltfFile, the first buffer will be a
+		 * sources::ByteView pointing directly into that memory. The Asset keeps a reference to the memory,
+		 * so the getter can be destroyed after loading. This takes precedence over the buffer allocation
+		 * callbacks, and silently falls back to the normal behaviour if the getter can't share its memory.
+		 */
+		ZeroCopyGLBBuffer               = 1 << 9,
+
+		/**
+		 * Never reads the BIN chunk of a GLB file. Instead, the first buffer will be a sources::URI with the
+		 * path of the GLB file relative to the given directory, as reported by GltfDataGetter::filePath, and
+		 * the sources::URI::fileByteOffset set to the start of the chunk data. Buffer::byteLength is the size
+		 * of the data. If the getter doesn't know its file path, the URI is empty, and the byte offset is
+		 * relative to the start of the data passed to the parser. Together with GltfFileStream or MappedGltfFile
+		 * only the headers and the JSON chunk are ever read, which is useful for streaming the binary data
+		 * directly to the GPU. This option takes precedence over Options::ZeroCopyGLBBuffer.
+		 */
+		DontLoadGLBBuffer               = 1 << 10,
+
+		/**
+		 * Loads all external buffers and images in parallel, after the JSON has been parsed, instead of
+		 * reading them one after another while parsing. This only has an effect together with
+		 * Options::LoadExternalBuffers or Options::LoadExternalImages. The reads are dispatched using the
+		 * callback set through Parser::setTaskExecutorCallback, or on a few internal threads otherwise.
+		 * Loading stops with the first error encountered.
+		 * @note The buffer allocation callbacks will be called from multiple threads concurrently.
+		 */
+		LoadExternalFilesInParallel     = 1 << 11,
+
+		/**
+		 * Parses the top-level arrays of the glTF, like accessors, meshes, or nodes, on multiple threads
+		 * once the JSON document has been read. The work is dispatched using the callback set through
+		 * Parser::setTaskExecutorCallback, or on a few internal threads otherwise. The extras callback is
+		 * still invoked on the calling thread, in the order of the categories within the document, and
+		 * the returned error is also the one of the first failing category in document order.
+		 * @note The buffer allocation and base64 decode callbacks will be called from multiple threads concurrently.
+		 */
+		ParseCategoriesInParallel       = 1 << 12,
+
+		/**
+		 * Uses simdjson's On-Demand API to convert the JSON into the Asset in a single forward pass,
+		 * instead of first building a DOM of the entire document. This lowers the peak memory usage
+		 * considerably for large documents, and is usually faster. The data-heavy accessors, buffer views,
+		 * and animations are converted directly, while every other top-level array is parsed on its own.
+		 * This option is ignored if an extras callback is set, and Options::ParseCategoriesInParallel
+		 * has no effect together with it. It is also ignored by Parser::loadGltfLazy.
+		 * @note The On-Demand API does not validate the parts of the document that are skipped, for example
+		 * categories that were not requested.
+		 */
+		UseOnDemandParser               = 1 << 13,
+
+		/**
+		 * Decodes all buffer views compressed with EXT_meshopt_compression after loading, which requires
+		 * fastgltf to be built with FASTGLTF_ENABLE_MESHOPT_DECODER and the extension to be enabled.
+		 * Only views whose uncompressed buffer is a sources::Fallback are decoded, and their compressed
+		 * buffer has to be loaded as a sources::Array, sources::Vector, or sources::ByteView. The decoded
+		 * data is written into a new allocation for every fallback buffer, which replaces the
+		 * sources::Fallback, so that DefaultBufferDataAdapter and iterateAccessor can read it like any
+		 * other buffer. If a buffer allocation callback is set, the memory is requested from it instead.
+		 * The views are decoded in parallel using the callback set through Parser::setTaskExecutorCallback,
+		 * or on a few internal threads otherwise.
+		 */
+		DecodeMeshoptCompression        = 1 << 14,
+
+		/**
+		 * Together with Options::GenerateMeshIndices, merges all vertices of a primitive whose
+		 * attributes and morph targets are bitwise identical. Every welded primitive gets a new buffer
+		 * with the compacted vertex streams, whose strides are padded to multiples of 4 bytes, new
+		 * accessors referencing them, and an index buffer.
+		 * Primitives whose attributes are sparse or whose buffers are not loaded as a sources::Array,
+		 * sources::Vector, or sources::ByteView fall back to the trivial indices. The primitives are
+		 * welded in parallel using the callback set through Parser::setTaskExecutorCallback, or on a
+		 * few internal threads otherwise.
+		 */
+		WeldMeshVertices                = 1 << 15,
+
+		/**
+		 * Splits large base64 data URIs into chunks, which are decoded in parallel into disjoint ranges
+		 * of the output. The chunks are dispatched using the callback set through Parser::setTaskExecutorCallback,
+		 * or on a few internal threads otherwise. Data URIs decoded by a custom base64 decode callback
+		 * are not affected by this option.
+		 */
+		DecodeDataUrisInParallel        = 1 << 16,
+
+		/**
+		 * Computes the min and max properties of every POSITION accessor of the mesh primitives and their
+		 * morph targets which is missing them, as the glTF spec requires them but some exporters leave
+		 * them out. The positions are scanned with SIMD kernels, taking sparse accessors into account.
+		 * Accessors whose buffers are not loaded as a sources::Array, sources::Vector, or sources::ByteView,
+		 * or whose component type is double, are skipped. The accessors are processed in parallel using
+		 * the callback set through Parser::setTaskExecutorCallback, or on a few internal threads otherwise.
+		 */
+		ComputeMissingBounds            = 1 << 17,
     };
 
     FASTGLTF_EXPORT enum class ExportOptions : std::uint64_t {
@@ -303,6 +431,35 @@ namespace fastgltf {
          * Pretty-prints the outputted JSON. This option is ignored for binary glTFs.
          */
         PrettyPrintJson                 = 1 << 2,
+
+        /**
+         * Writes all buffers and images which are stored in memory as base64 encoded data URIs into the JSON,
+         * instead of writing them into separate files. When exporting a GLB, the first buffer is still
+         * stored in the binary chunk.
+         */
+        WriteDataUris                   = 1 << 3,
+
+        /**
+         * Compresses the buffer views of vertex attributes, indices, and animation samplers with EXT_meshopt_compression,
+         * which requires fastgltf to be built with FASTGLTF_ENABLE_MESHOPT_ENCODER. The compressed data of all views,
+         * together with the views which are not compressed, like images, is written into a new first buffer, which is
+         * embedded when exporting a GLB. The views then decode into a second buffer, which is written as a fallback
+         * buffer without any data, for which the extension is added to extensionsRequired. Buffers which are not held in memory are written unchanged after those two.
+         * The views are encoded in parallel using the callback set through Exporter::setTaskExecutorCallback, or on a few
+         * internal threads otherwise. The new buffers are returned in ExportResult::buffers. This option is ignored
+         * for assets which already use EXT_meshopt_compression.
+         */
+        MeshoptCompression              = 1 << 4,
+
+        /**
+         * Together with ExportOptions::MeshoptCompression, quantizes data before compressing it where the accessor
+         * allows, which is lossy but compresses considerably better. Float normals and tangents are quantized to 8-bit
+         * octahedral vectors, which requires KHR_mesh_quantization, rotations of linear or step animation samplers to
+         * 16-bit quaternions, and float texture coordinates and other animation outputs are rounded to 16 bits of
+         * mantissa. Only accessors which are the only ones in their buffer view are quantized, and their bounds are
+         * removed.
+         */
+        MeshoptFilters                  = 1 << 5,
     };
     // clang-format on
 
@@ -540,6 +697,111 @@ namespace fastgltf {
 	FASTGLTF_EXPORT using ExtrasParseCallback = void(simdjson::dom::object* extras, std::size_t objectIndex, Category objectType, void* userPointer);
 	FASTGLTF_EXPORT using ExtrasWriteCallback = std::optional<std::string>(std::size_t objectIndex, Category objectType, void* userPointer);
 
+	/**
+	 * The phases of loading a glTF, in the order they are reported to the LoadProgressCallback.
+	 * The phases for work that has not been enabled through the Options are skipped.
+	 */
+	FASTGLTF_EXPORT enum class LoadPhase : std::uint8_t {
+		ReadDocument, ///< The JSON, and the chunks of a GLB, have been read from the data getter.
+		ParsedCategories, ///< All requested categories have been parsed.
+		LoadedExternalFiles, ///< The external files deferred with Options::LoadExternalFilesInParallel have been loaded.
+		DecodedCompressedData, ///< The buffer views have been decoded with Options::DecodeMeshoptCompression.
+		GeneratedMeshIndices, ///< The mesh indices have been generated with Options::GenerateMeshIndices.
+		ComputedMissingBounds, ///< The missing accessor bounds have been computed with Options::ComputeMissingBounds.
+		Finished, ///< The asset is complete.
+	};
+
+	FASTGLTF_EXPORT struct LoadProgress {
+		LoadPhase phase;
+
+		/** The number of bytes of the glTF or GLB which have been read from the data getter, and its total size. */
+		std::size_t bytesRead = 0;
+		std::size_t totalBytes = 0;
+
+		/** The categories which have been parsed so far. */
+		Category parsedCategories = Category::None;
+	};
+
+	/**
+	 * Callback invoked after each phase of a load. Returning false cancels the load, which then returns Error::LoadCancelled.
+	 * The callback is always invoked from the thread running the load.
+	 */
+	FASTGLTF_EXPORT using LoadProgressCallback = bool(const LoadProgress& progress, void* userPointer);
+
+#if FASTGLTF_ENABLE_LOAD_STATISTICS
+	/**
+	 * The parts of a load which are timed with FASTGLTF_ENABLE_LOAD_STATISTICS, and reported to the LoadScopeCallback.
+	 */
+	FASTGLTF_EXPORT enum class LoadScope : std::uint8_t {
+		Load, ///< The entire call to Parser::loadGltf, Parser::loadGltfJson, or Parser::loadGltfBinary.
+		ReadDocument, ///< Reading the JSON, and the chunks of a GLB, from the data getter.
+		ParseJson, ///< Parsing the JSON into a DOM with simdjson.
+		ParseCategory, ///< Parsing all objects of a single category.
+		DecodeDataUri, ///< Decoding a single base64 data URI.
+		LoadExternalFile, ///< Loading a single external buffer or image.
+		LoadExternalFiles, ///< Loading all files deferred with Options::LoadExternalFilesInParallel.
+		DecodeCompressedData, ///< Decoding the buffer views with Options::DecodeMeshoptCompression.
+		GenerateMeshIndices, ///< Welding vertices and generating indices with Options::GenerateMeshIndices.
+		ComputeMissingBounds, ///< Computing the missing accessor bounds with Options::ComputeMissingBounds.
+	};
+
+	/**
+	 * Callback invoked when a LoadScope begins and ends, which can be used to forward the scopes to a profiler
+	 * like Tracy or Perfetto. The category is only set for LoadScope::ParseCategory. Scopes are properly nested,
+	 * but with Options::ParseCategoriesInParallel the callback is also invoked from the worker threads.
+	 */
+	FASTGLTF_EXPORT using LoadScopeCallback = void(LoadScope scope, Category category, bool begin, void* userPointer);
+
+	FASTGLTF_EXPORT struct LoadScopeStatistics {
+		/** The time spent in this scope. With parallel work, this is the sum of the time spent on every thread. */
+		std::chrono::nanoseconds duration = {};
+
+		/** The number of bytes this scope read or produced, and the number of objects, URIs, or files it processed. */
+		std::size_t bytes = 0;
+		std::size_t count = 0;
+	};
+
+	/**
+	 * Statistics about the time spent in each part of the last load, which are only collected when fastgltf
+	 * has been compiled with FASTGLTF_ENABLE_LOAD_STATISTICS.
+	 */
+	FASTGLTF_EXPORT struct LoadStatistics {
+		/** The entire load, and the number of bytes of the glTF or GLB. */
+		LoadScopeStatistics load;
+		/** Reading the document, and the number of bytes read from the data getter. */
+		LoadScopeStatistics readDocument;
+		/** Parsing the JSON, and the size of the JSON in bytes. */
+		LoadScopeStatistics parseJson;
+		/** Decoding data URIs, and the number of decoded bytes. */
+		LoadScopeStatistics decodeDataUris;
+		/** Loading external buffers and images, including deferred files, and the number of bytes loaded into memory. */
+		LoadScopeStatistics loadExternalFiles;
+		/** Decoding compressed buffer views, and the number of decoded bytes. */
+		LoadScopeStatistics decodeCompressedData;
+		/** Generating mesh indices, and the number of primitives. */
+		LoadScopeStatistics generateMeshIndices;
+		/** Computing missing accessor bounds, and the number of bytes and accessors scanned. */
+		LoadScopeStatistics computeMissingBounds;
+
+		/** The time spent in each category, and the number of objects parsed, indexed by the bit of the category. */
+		std::array<LoadScopeStatistics, 13> categories = {};
+
+		/** The number of bytes allocated from the arenas for the asset. */
+		std::size_t arenaBytesAllocated = 0;
+
+		[[nodiscard]] LoadScopeStatistics& getCategory(Category category) noexcept {
+			std::size_t index = 0;
+			while (index < categories.size() - 1 && (to_underlying(category) >> index) != 1)
+				++index;
+			return categories[index];
+		}
+
+		[[nodiscard]] const LoadScopeStatistics& getCategory(Category category) const noexcept {
+			return const_cast<LoadStatistics*>(this)->getCategory(category);
+		}
+	};
+#endif
+
 	/**
 	 * This interface defines how the parser can read the bytes making up a glTF or GLB file.
 	 */
@@ -569,15 +831,37 @@ namespace fastgltf {
 
 		[[nodiscard]] virtual std::size_t bytesRead() = 0;
 		[[nodiscard]] virtual std::size_t totalSize() = 0;
+
+		/**
+		 * Returns a pointer to the start of the entire data, which is at least totalSize() bytes long,
+		 * if the implementation keeps all of it in addressable memory that can outlive the getter itself.
+		 * The returned shared_ptr owns that memory, meaning it stays valid for as long as any copy of the
+		 * pointer exists. Implementations that can't provide this should return nullptr, which is the default.
+		 * This is used by Options::ZeroCopyGLBBuffer.
+		 */
+		[[nodiscard]] virtual std::shared_ptr<const std::byte> shareData() {
+			return nullptr;
+		}
+
+		/**
+		 * Returns the path of the file the data is being read from, or an empty path if the data does
+		 * not originate from a file or the path is unknown. This is used by Options::DontLoadGLBBuffer.
+		 */
+		[[nodiscard]] virtual std::filesystem::path filePath() {
+			return {};
+		}
 	};
 
 	FASTGLTF_EXPORT class GltfDataBuffer : public GltfDataGetter {
 	protected:
-		std::unique_ptr<std::byte[]> buffer;
+		std::shared_ptr<std::byte[]> buffer;
 
 		std::size_t allocatedSize = 0;
 		std::size_t dataSize = 0;
 
+		// Only set when the data has been loaded from a file.
+		std::filesystem::path path;
+
 		std::size_t idx = 0;
 
 		Error error = Error::None;
@@ -634,6 +918,10 @@ namespace fastgltf {
 
 		[[nodiscard]] std::size_t totalSize() override;
 
+		[[nodiscard]] std::shared_ptr<const std::byte> shareData() override;
+
+		[[nodiscard]] std::filesystem::path filePath() override;
+
 		[[nodiscard]] explicit operator span<std::byte>() {
 			return span<std::byte>(buffer.get(), dataSize);
 		}
@@ -658,6 +946,12 @@ namespace fastgltf {
 #endif
 		std::uint64_t fileSize = 0;
 
+		// Once the mapping has been shared through shareData(), this owns the mapping and unmaps it
+		// when the last reference goes away, instead of the destructor of this class.
+		std::shared_ptr<const std::byte> sharedMapping;
+
+		std::filesystem::path path;
+
 		std::size_t idx = 0;
 
 		Error error = Error::None;
@@ -691,6 +985,10 @@ namespace fastgltf {
 
 		[[nodiscard]] std::size_t totalSize() override;
 
+		[[nodiscard]] std::shared_ptr<const std::byte> shareData() override;
+
+		[[nodiscard]] std::filesystem::path filePath() override;
+
 		[[nodiscard]] explicit operator span<std::byte>() {
 			return span<std::byte>(static_cast<std::byte*>(mappedFile), fileSize);
 		}
@@ -703,6 +1001,8 @@ namespace fastgltf {
 
 		std::size_t fileSize;
 
+		std::filesystem::path path;
+
 	public:
 		explicit GltfFileStream(const std::filesystem::path& path);
 		~GltfFileStream() noexcept override = default;
@@ -718,6 +1018,45 @@ namespace fastgltf {
 		[[nodiscard]] std::size_t bytesRead() override;
 
 		[[nodiscard]] std::size_t totalSize() override;
+
+		[[nodiscard]] std::filesystem::path filePath() override;
+	};
+
+	/**
+	 * The counterpart to GltfDataGetter for writing. The Exporter hands its output to a sink as a list
+	 * of byte ranges, which lets the sink write the JSON and the embedded buffer without first copying
+	 * them into a single contiguous allocation. Custom sinks can be used to stream the output elsewhere.
+	 */
+	FASTGLTF_EXPORT class GltfDataSink {
+	public:
+		virtual ~GltfDataSink() noexcept = default;
+
+		/**
+		 * Appends all of the given byte ranges in order. The ranges only need to stay valid until
+		 * this function returns. Returning false aborts the export.
+		 */
+		[[nodiscard]] virtual bool write(span<const span<const std::byte>> chunks) = 0;
+	};
+
+	/**
+	 * Writes to a file, truncating it if it already exists. On Linux and macOS all chunks are written using writev.
+	 */
+	FASTGLTF_EXPORT class GltfFileSink : public GltfDataSink {
+#if defined(__APPLE__) || defined(__linux__)
+		int fileDescriptor = -1;
+#else
+		std::ofstream fileStream;
+#endif
+
+	public:
+		explicit GltfFileSink(const std::filesystem::path& path);
+		GltfFileSink(const GltfFileSink& other) = delete;
+		GltfFileSink& operator=(const GltfFileSink& other) = delete;
+		~GltfFileSink() noexcept override;
+
+		[[nodiscard]] bool isOpen() const;
+
+		[[nodiscard]] bool write(span<const span<const std::byte>> chunks) override;
 	};
 
     #if defined(__ANDROID__)
@@ -767,6 +1106,19 @@ namespace fastgltf {
 	 */
 	FASTGLTF_EXPORT GltfType determineGltfFileType(GltfDataGetter& data);
 
+	/**
+	 * The version of the binary format written by Exporter::writeAssetCache. Caches written with another version
+	 * are rejected by Parser::loadAssetCache.
+	 */
+	FASTGLTF_EXPORT inline constexpr std::uint32_t assetCacheVersion = 1;
+
+	/**
+	 * Computes a 64-bit hash of the entire data, which can be used to check whether an asset cache was created
+	 * from the same glTF. Only the glTF or GLB itself is hashed, and not the external files it references.
+	 * The data is reset afterwards, so that it can be passed to the parser directly.
+	 */
+	FASTGLTF_EXPORT [[nodiscard]] std::uint64_t hashGltfData(GltfDataGetter& data);
+
 	/**
 	 * This function further validates all the input more strictly that is parsed from the glTF.
 	 * Realistically, this should not be necessary in Release applications, but could be helpful
@@ -774,6 +1126,122 @@ namespace fastgltf {
 	*/
 	FASTGLTF_EXPORT [[nodiscard]] Error validate(const Asset& asset);
 
+	/**
+	 * Validates only the objects of the given categories. The asset-level data, i.e., the extension lists and the
+	 * lights, is validated as part of Category::Asset. Large assets are split into tasks which are executed in parallel,
+	 * using the executor if one is passed, or on a few internal threads otherwise. If multiple objects are invalid,
+	 * the returned error is always that of the same object, independently of how the tasks were scheduled.
+	 */
+	FASTGLTF_EXPORT [[nodiscard]] Error validate(const Asset& asset, Category categories,
+			TaskExecutorCallback* executor = nullptr, void* userPointer = nullptr);
+
+	/**
+	 * Validates an asset repeatedly while it is being edited, for example before every save. The first call to
+	 * revalidate validates the entire asset. Afterwards, only objects marked dirty, objects added since the last
+	 * call, and categories that read data which was changed or removed are validated again. For example, changing a
+	 * single accessor revalidates that accessor, every mesh, and every animation, but none of the nodes.
+	 */
+	FASTGLTF_EXPORT class AssetValidator {
+	public:
+		static constexpr std::size_t categoryCount = 14;
+
+	private:
+		std::array<std::vector<std::size_t>, categoryCount> dirtyObjects;
+		std::array<std::size_t, categoryCount> validatedCounts = {};
+		Category dirtyCategories = Category::All;
+
+		TaskExecutorCallback* executorCallback = nullptr;
+		void* userPointer = nullptr;
+
+	public:
+		/** Executes the validation tasks using the callback, as with validate(const Asset&, Category, TaskExecutorCallback*, void*). */
+		void setTaskExecutorCallback(TaskExecutorCallback* executor, void* userPointer = nullptr) noexcept;
+
+		/**
+		 * Marks a single object as changed. The category must have exactly one bit set. Objects which were added
+		 * or removed don't need to be marked, as they are detected through the sizes of the asset's vectors.
+		 */
+		void markDirty(Category category, std::size_t objectIndex);
+
+		/** Marks all objects of the given categories as changed. */
+		void markDirty(Category categories) noexcept;
+
+		/**
+		 * Validates everything that changed since the last call. After an error, the next call validates the
+		 * entire asset again, as only the first invalid object is known.
+		 */
+		[[nodiscard]] Error revalidate(const Asset& asset);
+	};
+
+	/**
+	 * Statistics about the files held by an ExternalFileCache.
+	 */
+	FASTGLTF_EXPORT struct ExternalFileCacheStatistics {
+		/** The number of requests for files which were already cached. */
+		std::size_t hits = 0;
+		/** The number of requests for files which had to be read, as they were not cached yet or had changed on disk. */
+		std::size_t misses = 0;
+		/** The number of files currently held by the cache. */
+		std::size_t residentFiles = 0;
+		/** The total size of the files currently held by the cache. */
+		std::size_t residentBytes = 0;
+
+		[[nodiscard]] double hitRate() const noexcept {
+			const auto requests = hits + misses;
+			return requests == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(requests);
+		}
+	};
+
+	/**
+	 * A cache for external buffers and images, which can be shared by any number of parsers through
+	 * Parser::setExternalFileCache, so that every file referenced by many assets is only read once.
+	 * Files are identified by their canonical path, and are read again once their size or modification
+	 * time changed. Where possible, the files are memory mapped. The assets reference the cached files
+	 * through sources::ByteView, and keep them alive for as long as they exist, even after they have
+	 * been removed from the cache. Files should therefore be replaced instead of being overwritten,
+	 * as changes to a mapped file are visible to, and truncating it invalidates, every asset using it.
+	 *
+	 * @note All functions of this class are thread-safe.
+	 */
+	FASTGLTF_EXPORT class ExternalFileCache {
+		struct Storage;
+		std::unique_ptr<Storage> storage;
+
+	public:
+		/** The contents of a cached file, which stay valid for as long as the data pointer exists. */
+		struct File {
+			std::shared_ptr<const std::byte> data;
+			std::size_t size = 0;
+		};
+
+		ExternalFileCache();
+		ExternalFileCache(const ExternalFileCache& other) = delete;
+		ExternalFileCache(ExternalFileCache&& other) noexcept;
+		ExternalFileCache& operator=(const ExternalFileCache& other) = delete;
+		ExternalFileCache& operator=(ExternalFileCache&& other) noexcept;
+		~ExternalFileCache();
+
+		/**
+		 * Returns the contents of the file, and only reads it if it isn't cached yet or has changed.
+		 *
+		 * @return The file wrapped in an Expected type, which holds Error::MissingExternalBuffer if
+		 * the file doesn't exist, or Error::InvalidURI if it can't be read.
+		 */
+		[[nodiscard]] Expected<File> load(const std::filesystem::path& path);
+
+		[[nodiscard]] ExternalFileCacheStatistics getStatistics() const;
+
+		/**
+		 * Removes every file which isn't referenced by any asset anymore.
+		 *
+		 * @return the number of bytes which were released.
+		 */
+		std::size_t trim();
+
+		/** Removes all files. Files which are still referenced by assets are only released with the assets. */
+		void clear();
+	};
+
     /**
      * Some internals the parser passes on to each glTF instance.
      */
@@ -782,11 +1250,36 @@ namespace fastgltf {
         BufferUnmapCallback* unmapCallback = nullptr;
         Base64DecodeCallback* decodeCallback = nullptr;
 		ExtrasParseCallback* extrasCallback = nullptr;
+		TaskExecutorCallback* executorCallback = nullptr;
+		LoadProgressCallback* progressCallback = nullptr;
+#if FASTGLTF_ENABLE_LOAD_STATISTICS
+		LoadScopeCallback* scopeCallback = nullptr;
+#endif
+		ExternalFileCache* fileCache = nullptr;
 
         void* userPointer = nullptr;
         Extensions extensions = Extensions::None;
     };
 
+#if !FASTGLTF_DISABLE_CUSTOM_MEMORY_POOL
+	/**
+	 * Statistics about the memory arenas the parser used for the last loaded asset.
+	 */
+	FASTGLTF_EXPORT struct MemoryStatistics {
+		/** The number of bytes the parser allocated for the asset. */
+		std::size_t bytesAllocated = 0;
+
+		/** The number of chunks the arenas acquired to serve those allocations, and their total size in bytes. */
+		std::size_t chunksAllocated = 0;
+		std::size_t chunkBytesAllocated = 0;
+
+		/** How many of those chunks were recycled from previously released assets. */
+		std::size_t chunksRecycled = 0;
+	};
+#endif
+
+    FASTGLTF_EXPORT class LazyAsset;
+
     /**
      * A parser for one or more glTF files. It uses a SIMD based JSON parser to maximize efficiency
      * and performance at runtime.
@@ -794,17 +1287,51 @@ namespace fastgltf {
      * @note This class is not thread-safe.
      */
     class Parser {
+		friend class LazyAsset;
+
         // The simdjson parser object. We want to share it between runs, so it does not need to
         // reallocate over and over again. We're hiding it here to not leak the simdjson header.
         std::unique_ptr<simdjson::dom::parser> jsonParser;
 
+		// The state used with Options::UseOnDemandParser, which is only created when first needed.
+		struct OnDemandParser;
+		std::unique_ptr<OnDemandParser> onDemandParser;
+
 		ParserInternalConfig config = {};
 		DataSource glbBuffer;
+		std::shared_ptr<const std::byte> glbBufferOwner;
 #if !FASTGLTF_DISABLE_CUSTOM_MEMORY_POOL
 		std::shared_ptr<std::pmr::monotonic_buffer_resource> resourceAllocator;
+
+		// Owns the chunks of all arenas created by this parser, and keeps the released ones around
+		// for the next assets. It is shared with all assets, as they might outlive the parser.
+		struct ChunkPool;
+		class Arena;
+		std::shared_ptr<ChunkPool> chunkPool;
+		MemoryStatistics memoryStatistics;
 #endif
 		std::filesystem::path directory;
 		Options options = Options::None;
+		LoadProgress progress = {};
+#if FASTGLTF_ENABLE_LOAD_STATISTICS
+		LoadStatistics loadStatistics;
+#endif
+
+		// External files whose loading has been deferred with Options::LoadExternalFilesInParallel.
+		struct DeferredFileLoad {
+			Category category;
+			std::size_t index;
+			std::string uri; // Still percent-encoded, as loadFileFromUri decodes it.
+			DataSource source;
+			std::shared_ptr<const std::byte> owner;
+			Error error = Error::None;
+		};
+		std::vector<DeferredFileLoad> deferredFileLoads;
+
+		// With Options::ParseCategoriesInParallel, the extras of each category are collected and
+		// only passed to the callback once all workers have finished.
+		struct DeferredExtras;
+		std::vector<DeferredExtras>* deferredExtras = nullptr;
 
 		static auto getMimeTypeFromString(std::string_view mime) -> MimeType;
 		static void fillCategories(Category& inputCategories) noexcept;
@@ -813,13 +1340,28 @@ namespace fastgltf {
 		Error parseAttributes(simdjson::dom::object& object, T& attributes);
 
 		[[nodiscard]] auto decodeDataUri(URIView& uri) const noexcept -> Expected<DataSource>;
-		[[nodiscard]] auto loadFileFromUri(URIView& uri) const noexcept -> Expected<DataSource>;
+		void decodeBase64(std::string_view encodedData, std::uint8_t* output, std::size_t padding, std::size_t outputSize) const;
+		[[nodiscard]] auto loadFileFromUri(URIView& uri, std::shared_ptr<const std::byte>& owner) const noexcept -> Expected<DataSource>;
 #if defined(__ANDROID__)
 		[[nodiscard]] auto loadFileFromApk(const std::filesystem::path& filepath) const noexcept -> Expected<DataSource>;
 #endif
 
+		void invokeExtrasCallback(simdjson::dom::object& extras, std::size_t objectIndex, Category category);
+		void executeTasks(std::size_t taskCount, ParserTask* task, void* taskData) const;
+		static void runAsync(ParserTask* task, void* taskData);
+		[[nodiscard]] bool reportProgress(LoadPhase phase);
+		Error loadDeferredFiles(Asset& asset);
+		Error decodeCompressedBufferViews(Asset& asset) const;
+#if !FASTGLTF_DISABLE_CUSTOM_MEMORY_POOL
+		std::shared_ptr<std::pmr::monotonic_buffer_resource> createArena();
+		void collectMemoryStatistics(const Asset& asset);
+#endif
 		Error generateMeshIndices(Asset& asset) const;
+		Error weldMeshVertices(Asset& asset) const;
+		void computeMissingBounds(Asset& asset);
 
+		Error parseCategory(Error (Parser::*parseFunction)(simdjson::dom::array&, Asset&), Category category,
+							simdjson::dom::array& array, Asset& asset);
 		Error parseAccessors(simdjson::dom::array& array, Asset& asset);
 		Error parseAnimations(simdjson::dom::array& array, Asset& asset);
 		Error parseBuffers(simdjson::dom::array& array, Asset& asset);
@@ -837,7 +1379,15 @@ namespace fastgltf {
 		Error parseScenes(simdjson::dom::array& array, Asset& asset);
 		Error parseSkins(simdjson::dom::array& array, Asset& asset);
 		Error parseTextures(simdjson::dom::array& array, Asset& asset);
+		Error parseCategories(simdjson::dom::object& root, Category categories, Asset& asset, bool parseRootMembers);
+		Error finishCategories(Asset& asset, Category readCategories);
 		Expected<Asset> parse(simdjson::dom::object root, Category categories);
+		Expected<Asset> parseOnDemand(span<const std::byte> json, Category categories);
+
+		Error readJsonDocument(GltfDataGetter& data, std::filesystem::path directory, Options options, span<const std::byte>& json);
+		Error readBinaryDocument(GltfDataGetter& data, std::filesystem::path directory, Options options, span<const std::byte>& json);
+		Error parseJsonDocument(span<const std::byte> json, simdjson::dom::object& root);
+		Expected<Asset> parseDocument(span<const std::byte> json, Category categories);
 
     public:
         explicit Parser(Extensions extensionsToLoad = Extensions::None) noexcept;
@@ -871,6 +1421,84 @@ namespace fastgltf {
 		 */
 		[[nodiscard]] Expected<Asset> loadGltfBinary(GltfDataGetter& buffer, std::filesystem::path directory, Options options = Options::None, Category categories = Category::All);
 
+		/**
+		 * Loads a glTF or GLB file, but only parses the given categories right away. All other categories
+		 * are only parsed once they are requested through the returned LazyAsset.
+		 *
+		 * @note The LazyAsset copies the current configuration of this parser, including the callbacks and
+		 * user pointer, and uses it for all categories it parses later on.
+		 * @return A LazyAsset wrapped in an Expected type, which may contain an error if one occurred.
+		 */
+		[[nodiscard]] Expected<LazyAsset> loadGltfLazy(GltfDataGetter& buffer, std::filesystem::path directory, Options options = Options::None, Category categories = Category::None);
+
+		/**
+		 * Loads an asset from a cache written by Exporter::writeAssetCache, without parsing any JSON or decoding any URIs.
+		 * If the data can be shared through GltfDataGetter::shareData, like with MappedGltfFile, the buffers and images
+		 * stored in the cache are referenced through sources::ByteView instead of being copied.
+		 *
+		 * @param sourceHash the hash of the glTF the cache was created from, as returned by hashGltfData.
+		 * @return An Asset wrapped in an Expected type, which holds Error::InvalidAssetCache if the cache does not match
+		 * the hash, the cache version, or the configuration of fastgltf.
+		 */
+		[[nodiscard]] Expected<Asset> loadAssetCache(GltfDataGetter& buffer, std::uint64_t sourceHash);
+
+		/**
+		 * Loads a glTF or GLB file like Parser::loadGltf, but on a separate thread, so that the calling thread
+		 * is not blocked. The loads of all parsers share a pool of at most std::thread::hardware_concurrency threads,
+		 * which are joined when the program exits. The parser and the data getter must not be used or destroyed until
+		 * the future is ready. Use a separate parser for each asset that should be loaded concurrently.
+		 *
+		 * @return A future holding the Asset wrapped in an Expected type, which may contain an error if one occurred.
+		 */
+		[[nodiscard]] std::future<Expected<Asset>> loadGltfAsync(GltfDataGetter& buffer, std::filesystem::path directory, Options options = Options::None, Category categories = Category::All);
+
+#if FASTGLTF_HAS_COROUTINES
+		/**
+		 * Awaitable returned by Parser::loadGltfAwaitable. Awaiting it suspends the coroutine, loads the asset on the
+		 * same threads as Parser::loadGltfAsync, and resumes the coroutine on that thread once the load has finished.
+		 */
+		class LoadAwaitable {
+			friend class Parser;
+
+			Parser* parser;
+			GltfDataGetter* data;
+			std::filesystem::path directory;
+			Options options;
+			Category categories;
+			std::optional<Expected<Asset>> result;
+			std::coroutine_handle<> handle;
+
+			LoadAwaitable(Parser* parser, GltfDataGetter* data, std::filesystem::path directory, Options options, Category categories) noexcept
+				: parser(parser), data(data), directory(std::move(directory)), options(options), categories(categories) {}
+
+		public:
+			[[nodiscard]] bool await_ready() const noexcept {
+				return false;
+			}
+
+			void await_suspend(std::coroutine_handle<> coroutine) {
+				handle = coroutine;
+				runAsync([](std::size_t, void* taskData) {
+					auto* awaitable = static_cast<LoadAwaitable*>(taskData);
+					awaitable->result.emplace(awaitable->parser->loadGltf(*awaitable->data, std::move(awaitable->directory), awaitable->options, awaitable->categories));
+					awaitable->handle.resume();
+				}, this);
+			}
+
+			[[nodiscard]] Expected<Asset> await_resume() {
+				return std::move(*result);
+			}
+		};
+
+		/**
+		 * Returns an awaitable which loads a glTF or GLB file like Parser::loadGltf, for use with co_await.
+		 * The parser and the data getter must not be used or destroyed until the coroutine has been resumed.
+		 */
+		[[nodiscard]] LoadAwaitable loadGltfAwaitable(GltfDataGetter& buffer, std::filesystem::path directory, Options options = Options::None, Category categories = Category::All) noexcept {
+			return { this, &buffer, std::move(directory), options, categories };
+		}
+#endif
+
         /**
          * This function can be used to set callbacks so that you can control memory allocation for
          * large buffers and images that are loaded from a glTF file. For example, one could use
@@ -903,9 +1531,216 @@ namespace fastgltf {
 
 		void setExtrasParseCallback(ExtrasParseCallback* extrasCallback) noexcept;
 
+		/**
+		 * Allows the parser to hand independent pieces of work, like loading external files with
+		 * Options::LoadExternalFilesInParallel, to your own job system. If no callback is set,
+		 * the parser spawns its own threads where necessary.
+		 * Using Parser::setUserPointer you can also set a user pointer to access your own class or other data you may need.
+		 *
+		 * @param executorCallback function called with a number of tasks which need to be executed
+		 */
+		void setTaskExecutorCallback(TaskExecutorCallback* executorCallback) noexcept;
+
+		/**
+		 * Allows tracking the progress of every load, and cancelling it between two phases by returning false.
+		 * Using Parser::setUserPointer you can also set a user pointer to access your own class or other data you may need.
+		 *
+		 * @param progressCallback function called after each LoadPhase
+		 */
+		void setLoadProgressCallback(LoadProgressCallback* progressCallback) noexcept;
+
+		/**
+		 * Makes the parser load external buffers and images through the cache, which shares every file
+		 * with all other assets loaded through it, instead of reading a copy of each file for every asset.
+		 * The files are then referenced as sources::ByteView. This takes precedence over the buffer
+		 * allocation callbacks. Pass nullptr to stop using the cache. The cache has to outlive the loads,
+		 * but not the assets.
+		 */
+		void setExternalFileCache(ExternalFileCache* cache) noexcept;
+
+#if FASTGLTF_ENABLE_LOAD_STATISTICS
+		/**
+		 * Allows forwarding the LoadScopes of every load to a profiler.
+		 * Using Parser::setUserPointer you can also set a user pointer to access your own class or other data you may need.
+		 *
+		 * @param scopeCallback function called when a LoadScope begins and ends
+		 */
+		void setLoadScopeCallback(LoadScopeCallback* scopeCallback) noexcept;
+
+		/**
+		 * Returns how much time was spent in each part of the last load.
+		 */
+		[[nodiscard]] const LoadStatistics& getLoadStatistics() const noexcept {
+			return loadStatistics;
+		}
+#endif
+
         void setUserPointer(void* pointer) noexcept;
+
+#if !FASTGLTF_DISABLE_CUSTOM_MEMORY_POOL
+		/**
+		 * Sets the memory resource every asset arena allocates its chunks from, and the size of the first
+		 * chunk of each arena. By default, the arenas use std::pmr::get_default_resource() and start with
+		 * small chunks. This only applies to assets loaded after this call.
+		 *
+		 * @param upstream the resource to allocate chunks from, or nullptr to use the default resource.
+		 * It has to outlive every asset loaded with this parser.
+		 * @param initialChunkSize the size of the first chunk of each arena, or 0 to use the default size.
+		 */
+		void setMemoryResource(std::pmr::memory_resource* upstream, std::size_t initialChunkSize = 0) noexcept;
+
+		/**
+		 * Lets the parser keep the chunks of released assets, and hand them to the arenas of the
+		 * assets loaded later on, instead of returning them to the upstream resource. This avoids
+		 * most of the allocations when loading many similar assets one after another. The chunks
+		 * are only recycled once the previous Asset has been destroyed.
+		 *
+		 * @param maxRecycledBytes the maximum number of bytes to keep around, or 0 to disable recycling,
+		 * which is the default.
+		 */
+		void setMaxRecycledMemory(std::size_t maxRecycledBytes) noexcept;
+
+		/**
+		 * Returns how much memory was allocated while loading the last asset.
+		 */
+		[[nodiscard]] const MemoryStatistics& getMemoryStatistics() const noexcept {
+			return memoryStatistics;
+		}
+#endif
     };
 
+	/**
+	 * An asset whose categories are only parsed once they are first accessed, which can save a lot of
+	 * time and memory when only a few categories are ever needed. This keeps the parsed JSON document
+	 * alive for its entire lifetime, and therefore uses its own internal parser.
+	 * Use Parser::loadGltfLazy to create one.
+	 */
+	FASTGLTF_EXPORT class LazyAsset {
+		friend class Parser;
+
+		std::unique_ptr<Parser> parser;
+		std::unique_ptr<simdjson::dom::object> root;
+		Asset asset;
+		Category loadedCategories = Category::None;
+
+		template <typename T>
+		[[nodiscard]] Expected<span<T>> loadCategory(Category category, std::vector<T>& vector) {
+			if (auto error = load(category); error != Error::None) {
+				return error;
+			}
+			return span<T>(vector.data(), vector.size());
+		}
+
+	public:
+		explicit LazyAsset() noexcept;
+		LazyAsset(const LazyAsset& other) = delete;
+		LazyAsset& operator=(const LazyAsset& other) = delete;
+		LazyAsset(LazyAsset&& other) noexcept;
+		LazyAsset& operator=(LazyAsset&& other) noexcept;
+		~LazyAsset();
+
+		/**
+		 * Parses the given categories, including the categories they depend on, if they haven't been
+		 * parsed yet. If this returns an error, the categories in the asset are left in an unspecified state.
+		 */
+		[[nodiscard]] Error load(Category categories);
+
+		/** Returns true if all of the given categories have already been parsed. */
+		[[nodiscard]] bool isLoaded(Category categories) const noexcept {
+			return (loadedCategories & categories) == categories;
+		}
+
+		/** Returns the asset with all categories that have been parsed so far, without parsing anything. */
+		[[nodiscard]] Asset& get() noexcept {
+			return asset;
+		}
+
+		[[nodiscard]] Asset* operator->() noexcept {
+			return &asset;
+		}
+
+		[[nodiscard]] Expected<span<Accessor>> accessors() { return loadCategory(Category::Accessors, asset.accessors); }
+		[[nodiscard]] Expected<span<Animation>> animations() { return loadCategory(Category::Animations, asset.animations); }
+		[[nodiscard]] Expected<span<Buffer>> buffers() { return loadCategory(Category::Buffers, asset.buffers); }
+		[[nodiscard]] Expected<span<BufferView>> bufferViews() { return loadCategory(Category::BufferViews, asset.bufferViews); }
+		[[nodiscard]] Expected<span<Camera>> cameras() { return loadCategory(Category::Cameras, asset.cameras); }
+		[[nodiscard]] Expected<span<Image>> images() { return loadCategory(Category::Images, asset.images); }
+		[[nodiscard]] Expected<span<Material>> materials() { return loadCategory(Category::Materials, asset.materials); }
+		[[nodiscard]] Expected<span<Mesh>> meshes() { return loadCategory(Category::Meshes, asset.meshes); }
+		[[nodiscard]] Expected<span<Node>> nodes() { return loadCategory(Category::Nodes, asset.nodes); }
+		[[nodiscard]] Expected<span<Sampler>> samplers() { return loadCategory(Category::Samplers, asset.samplers); }
+		[[nodiscard]] Expected<span<Scene>> scenes() { return loadCategory(Category::Scenes, asset.scenes); }
+		[[nodiscard]] Expected<span<Skin>> skins() { return loadCategory(Category::Skins, asset.skins); }
+		[[nodiscard]] Expected<span<Texture>> textures() { return loadCategory(Category::Textures, asset.textures); }
+	};
+
+	/**
+	 * Called by BatchLoader once for every file, as soon as it has been loaded. The call happens on the
+	 * worker thread which loaded the file, so calls for different files may happen concurrently.
+	 * The asset may be moved out of the Expected.
+	 */
+	FASTGLTF_EXPORT using BatchLoadCallback = void(std::size_t fileIndex, Expected<Asset>& asset, void* userPointer);
+
+	/**
+	 * Called by BatchLoader once for the Parser of every worker thread, right after it has been created,
+	 * so that it can be configured with callbacks or a memory resource before loading any file.
+	 */
+	FASTGLTF_EXPORT using BatchParserCallback = void(Parser& parser, void* userPointer);
+
+	/**
+	 * Loads many glTF and GLB files using a pool of worker threads. Every worker keeps its own Parser,
+	 * including its simdjson buffers, and its own buffer for reading files, which are reused for every
+	 * file it loads, across calls to load. The files are sorted by size and dealt out to the workers,
+	 * which load their largest files first, and steal files from other workers once they run out.
+	 *
+	 * @note This class is not thread-safe.
+	 */
+	FASTGLTF_EXPORT class BatchLoader {
+		struct Worker;
+		std::vector<std::unique_ptr<Worker>> workers;
+		std::size_t threadCount;
+		Extensions extensions;
+		BatchParserCallback* parserCallback = nullptr;
+		void* userPointer = nullptr;
+
+	public:
+		/**
+		 * @param threadCount the number of worker threads, including the thread calling load, or 0 to use
+		 * std::thread::hardware_concurrency.
+		 */
+		explicit BatchLoader(Extensions extensionsToLoad = Extensions::None, std::size_t threadCount = 0);
+		BatchLoader(const BatchLoader& other) = delete;
+		BatchLoader(BatchLoader&& other) noexcept;
+		BatchLoader& operator=(const BatchLoader& other) = delete;
+		BatchLoader& operator=(BatchLoader&& other) noexcept;
+		~BatchLoader();
+
+		[[nodiscard]] std::size_t getThreadCount() const noexcept {
+			return threadCount;
+		}
+
+		/**
+		 * Sets the callback used to configure the parsers of all workers. It is only called for parsers
+		 * created after this call, so this should be called before the first call to load.
+		 */
+		void setParserCallback(BatchParserCallback* callback) noexcept;
+
+		/** Sets the user pointer passed to the BatchParserCallback and the BatchLoadCallback. */
+		void setUserPointer(void* pointer) noexcept;
+
+		/**
+		 * Loads every file like Parser::loadGltf, using the directory of each file for its external resources,
+		 * and passes the results to the callback. This blocks until all files have been loaded, with the
+		 * calling thread acting as one of the workers. Options which make the parser spawn its own threads,
+		 * like Options::LoadExternalFilesInParallel, should only be used with a task executor set through
+		 * the BatchParserCallback, to not oversubscribe the CPU.
+		 *
+		 * @return the number of files which failed to load.
+		 */
+		std::size_t load(span<const std::filesystem::path> paths, BatchLoadCallback* callback,
+				Options options = Options::None, Category categories = Category::All);
+	};
+
     /**
      * This converts a compacted JSON string into a more readable pretty format.
      */
@@ -922,6 +1757,12 @@ namespace fastgltf {
 
         std::vector<std::optional<std::filesystem::path>> bufferPaths;
         std::vector<std::optional<std::filesystem::path>> imagePaths;
+
+        /**
+         * The buffers which were written instead of the asset's buffers, with the same indices as bufferPaths.
+         * This is only filled with ExportOptions::MeshoptCompression, and empty if the buffers were written as they are.
+         */
+        std::vector<Buffer> buffers;
     };
 
     /**
@@ -942,10 +1783,18 @@ namespace fastgltf {
 
 		void* userPointer = nullptr;
 		ExtrasWriteCallback* extrasWriteCallback = nullptr;
+		TaskExecutorCallback* executorCallback = nullptr;
 
         std::vector<std::optional<std::filesystem::path>> bufferPaths;
         std::vector<std::optional<std::filesystem::path>> imagePaths;
 
+		// The buffers, views, and accessor changes written instead of the asset's with ExportOptions::MeshoptCompression.
+		struct MeshoptEncoding;
+		std::shared_ptr<MeshoptEncoding> meshoptEncoding;
+
+		void encodeMeshoptCompression(const Asset& asset);
+		[[nodiscard]] const std::vector<Buffer>& getExportedBuffers(const Asset& asset) const noexcept;
+
         void writeAccessors(const Asset& asset, std::string& json);
         void writeAnimations(const Asset& asset, std::string& json);
         void writeBuffers(const Asset& asset, std::string& json);
@@ -985,6 +1834,12 @@ namespace fastgltf {
 
 		void setUserPointer(void* pointer) noexcept;
 
+		/**
+		 * Sets the callback which executes the tasks of ExportOptions::MeshoptCompression, in the same way as
+		 * Parser::setTaskExecutorCallback. The user pointer set using Exporter::setUserPointer is passed to it.
+		 */
+		void setTaskExecutorCallback(TaskExecutorCallback* callback) noexcept;
+
         /**
          * Generates a glTF JSON string from the given asset.
          */
@@ -997,6 +1852,24 @@ namespace fastgltf {
          * it will be embedded into the binary. Note that the returned vector might therefore get quite large.
          */
         Expected<ExportResult<std::vector<std::byte>>> writeGltfBinary(const Asset& asset, ExportOptions options = ExportOptions::None);
+
+        /**
+         * Writes a glTF binary (GLB) to the given sink, and returns the number of bytes written as the output.
+         *
+         * The header, the JSON, and the embedded buffer are passed to the sink in a single call without being
+         * copied, so that only the JSON needs to be held in memory. The same rules as for writeGltfBinary apply
+         * to which buffer is embedded.
+         */
+        Expected<ExportResult<std::size_t>> writeGltfBinary(const Asset& asset, GltfDataSink& sink, ExportOptions options = ExportOptions::None);
+
+		/**
+		 * Serializes the given asset into the binary cache format, which can be loaded again with Parser::loadAssetCache.
+		 * The data of buffers and images held in memory is stored in the cache, while URIs are stored as they are.
+		 * The cache is only meant to be read on the same platform, with the same configuration of fastgltf.
+		 *
+		 * @param sourceHash the hash of the glTF the asset was loaded from, as returned by hashGltfData.
+		 */
+		Expected<std::vector<std::byte>> writeAssetCache(const Asset& asset, std::uint64_t sourceHash, ExportOptions options = ExportOptions::None);
     };
 
 	/**
@@ -1023,6 +1896,9 @@ namespace fastgltf {
          *
 		 * If the first buffer holds a sources::Vector, a sources::Array, a or sources::ByteView and the byte length is smaller than 2^32 (4.2GB),
          * it will be embedded into the binary.
+         *
+		 * The GLB is first written to a temporary file next to the target, which replaces the target only once
+		 * the export succeeded. If the export fails, an existing target file is left unchanged.
          *
 		 * \see Exporter::writeGltfBinary
 		 */
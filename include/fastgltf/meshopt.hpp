@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2022 - 2025 Sean Apeler
+ * This file is part of fastgltf <https://github.com/spnda/fastgltf>.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef FASTGLTF_MESHOPT_HPP
+#define FASTGLTF_MESHOPT_HPP
+
+#if !defined(FASTGLTF_USE_STD_MODULE) || !FASTGLTF_USE_STD_MODULE
+#include <cstddef>
+#include <cstdint>
+#endif
+
+#include <fastgltf/types.hpp>
+
+#if FASTGLTF_ENABLE_MESHOPT_DECODER
+/**
+ * Decoders for the bitstreams defined by EXT_meshopt_compression.
+ * See https://github.com/KhronosGroup/glTF/tree/main/extensions/2.0/Vendor/EXT_meshopt_compression/README.md
+ */
+namespace fastgltf::meshopt {
+    /**
+     * Decodes count elements of byteStride bytes each, which were encoded using the ATTRIBUTES mode.
+     * Returns false if the stride is invalid or the data is malformed or truncated.
+     */
+    FASTGLTF_EXPORT [[nodiscard]] bool decodeVertexBuffer(std::byte* destination, std::size_t count, std::size_t byteStride,
+            span<const std::byte> source) noexcept;
+
+    /**
+     * Decodes count indices of indexSize (2 or 4) bytes each, which were encoded using the TRIANGLES mode.
+     * Returns false if count is not a multiple of 3, or the data is malformed or truncated.
+     */
+    FASTGLTF_EXPORT [[nodiscard]] bool decodeIndexBuffer(std::byte* destination, std::size_t count, std::size_t indexSize,
+            span<const std::byte> source) noexcept;
+
+    /**
+     * Decodes count indices of indexSize (2 or 4) bytes each, which were encoded using the INDICES mode.
+     * Returns false if the data is malformed or truncated.
+     */
+    FASTGLTF_EXPORT [[nodiscard]] bool decodeIndexSequence(std::byte* destination, std::size_t count, std::size_t indexSize,
+            span<const std::byte> source) noexcept;
+
+    /**
+     * Applies the given filter in-place to count elements decoded by decodeVertexBuffer.
+     * Returns false if the stride is not supported by the filter.
+     */
+    FASTGLTF_EXPORT [[nodiscard]] bool decodeFilter(MeshoptCompressionFilter filter, std::byte* data, std::size_t count,
+            std::size_t byteStride) noexcept;
+
+    /**
+     * Decodes a compressed buffer view into destination, which needs to hold compression.count * compression.byteStride
+     * bytes. compressedBuffer is the data of the buffer compression.bufferIndex refers to.
+     */
+    FASTGLTF_EXPORT [[nodiscard]] bool decode(const CompressedBufferView& compression, span<const std::byte> compressedBuffer,
+            std::byte* destination) noexcept;
+} // namespace fastgltf::meshopt
+#endif
+
+#if FASTGLTF_ENABLE_MESHOPT_ENCODER
+/**
+ * Encoders producing the bitstreams defined by EXT_meshopt_compression, which can be read by the decoders above.
+ * The encoded sizes are bounded by the respective *Bound functions, which destination needs to be large enough for.
+ */
+namespace fastgltf::meshopt {
+    /** Returns the largest size encodeVertexBuffer can produce for count elements of byteStride bytes each. */
+    FASTGLTF_EXPORT [[nodiscard]] std::size_t encodeVertexBufferBound(std::size_t count, std::size_t byteStride) noexcept;
+
+    /**
+     * Encodes count elements of byteStride bytes each using the ATTRIBUTES mode, and returns the encoded size.
+     * Returns 0 if the stride is not a multiple of 4 or larger than 256 bytes.
+     */
+    FASTGLTF_EXPORT [[nodiscard]] std::size_t encodeVertexBuffer(std::byte* destination, const std::byte* source,
+            std::size_t count, std::size_t byteStride) noexcept;
+
+    /** Returns the largest size encodeIndexBuffer can produce for count indices. */
+    FASTGLTF_EXPORT [[nodiscard]] std::size_t encodeIndexBufferBound(std::size_t count) noexcept;
+
+    /**
+     * Encodes count indices of indexSize (2 or 4) bytes each, which form a triangle list, using the TRIANGLES mode,
+     * and returns the encoded size. The decoded triangles keep their order and winding, but the order of the
+     * vertices within a triangle may be rotated. Returns 0 if count is not a multiple of 3.
+     */
+    FASTGLTF_EXPORT [[nodiscard]] std::size_t encodeIndexBuffer(std::byte* destination, const std::byte* source,
+            std::size_t count, std::size_t indexSize) noexcept;
+
+    /** Returns the largest size encodeIndexSequence can produce for count indices. */
+    FASTGLTF_EXPORT [[nodiscard]] std::size_t encodeIndexSequenceBound(std::size_t count) noexcept;
+
+    /**
+     * Encodes count indices of indexSize (2 or 4) bytes each using the INDICES mode, and returns the encoded size.
+     * Returns 0 if two consecutive indices are 2^30 or more apart, which the bitstream cannot represent.
+     */
+    FASTGLTF_EXPORT [[nodiscard]] std::size_t encodeIndexSequence(std::byte* destination, const std::byte* source,
+            std::size_t count, std::size_t indexSize) noexcept;
+
+    /**
+     * Quantizes count elements of componentCount tightly packed floats from source into destination using the given
+     * filter, so that decodeFilter reconstructs them from elements of byteStride bytes each. bits is the precision
+     * of the quantized components.
+     * - Octahedral: unit vectors with 3 or 4 components, where the fourth is kept as is, into 4 or 8 bytes, with
+     *   up to 8 or 16 bits.
+     * - Quaternion: normalized quaternions with 4 components into 8 bytes, with 4 to 16 bits.
+     * - Exponential: any number of components into byteStride = componentCount * 4 bytes, with 1 to 24 bits of mantissa.
+     * Returns false if the combination of the arguments is not supported by the filter.
+     */
+    FASTGLTF_EXPORT [[nodiscard]] bool encodeFilter(MeshoptCompressionFilter filter, std::byte* destination, const std::byte* source,
+            std::size_t count, std::size_t componentCount, std::size_t byteStride, unsigned bits) noexcept;
+} // namespace fastgltf::meshopt
+#endif
+
+#endif
@@ -30,6 +30,7 @@
 #if !defined(FASTGLTF_USE_STD_MODULE) || !FASTGLTF_USE_STD_MODULE
 #include <cstring>
 #include <iterator>
+#include <vector>
 #endif
 
 #include <fastgltf/types.hpp>
@@ -400,7 +401,8 @@ bool findSparseIndex(const std::byte* indices, std::size_t indexCount, std::size
 		auto step = count / 2;
 		auto index = resultIndex + step;
 
-		if (deserializeComponent<ElementType>(indices, index) < static_cast<ElementType>(desiredIndex)) {
+		// Compared as std::size_t, since desiredIndex might not fit into the index type.
+		if (static_cast<std::size_t>(deserializeComponent<ElementType>(indices, index)) < desiredIndex) {
 			resultIndex = index + 1;
 			count -= step + 1;
 		} else {
@@ -408,7 +410,7 @@ bool findSparseIndex(const std::byte* indices, std::size_t indexCount, std::size
 		}
 	}
 
-	return resultIndex < indexCount && deserializeComponent<ElementType>(indices, resultIndex) == static_cast<ElementType>(desiredIndex);
+	return resultIndex < indexCount && static_cast<std::size_t>(deserializeComponent<ElementType>(indices, resultIndex)) == desiredIndex;
 }
 
 // Finds the index of the nearest sparse index to the desired index
@@ -436,6 +438,87 @@ inline bool findSparseIndex(ComponentType componentType, const std::byte* bytes,
 	return false;
 }
 
+#if defined(FASTGLTF_IS_X86)
+bool sse4_convert_components(const std::byte* src, std::size_t srcStride, ComponentType srcType, std::byte* dst,
+		std::size_t dstStride, ComponentType dstType, std::size_t componentCount, std::size_t count, bool normalized) noexcept;
+bool avx2_convert_components(const std::byte* src, std::size_t srcStride, ComponentType srcType, std::byte* dst,
+		std::size_t dstStride, ComponentType dstType, std::size_t componentCount, std::size_t count, bool normalized) noexcept;
+#elif defined(FASTGLTF_IS_A64)
+bool neon_convert_components(const std::byte* src, std::size_t srcStride, ComponentType srcType, std::byte* dst,
+		std::size_t dstStride, ComponentType dstType, std::size_t componentCount, std::size_t count, bool normalized) noexcept;
+#endif
+bool fallback_convert_components(const std::byte* src, std::size_t srcStride, ComponentType srcType, std::byte* dst,
+		std::size_t dstStride, ComponentType dstType, std::size_t componentCount, std::size_t count, bool normalized) noexcept;
+
+/**
+ * Converts count elements of componentCount components each from srcType to dstType, using the
+ * SIMD kernel that is best supported by the CPU at runtime. Either side may be strided, in which
+ * case only the components of each element are written. Returns false without writing anything
+ * if there is no kernel for this conversion, or if componentCount is larger than 4.
+ */
+FASTGLTF_EXPORT bool convertComponents(const std::byte* src, std::size_t srcStride, ComponentType srcType, std::byte* dst,
+		std::size_t dstStride, ComponentType dstType, std::size_t componentCount, std::size_t count, bool normalized) noexcept;
+
+/**
+ * Checks if the components of the element type are laid out like those of a tightly packed
+ * glTF element, so that we can write them using convertComponents.
+ */
+template <typename ElementType>
+constexpr bool hasPackedComponents() {
+	using Traits = ElementTraits<ElementType>;
+	return std::is_trivially_copyable_v<ElementType> && !Traits::needs_transpose && !isMatrix(Traits::type)
+		&& sizeof(ElementType) == sizeof(typename Traits::component_type) * getNumComponents(Traits::type);
+}
+
+/**
+ * Reads a single element whose source component type and normalization are known at compile time,
+ * so that no per-element dispatch remains once this is inlined into a loop.
+ */
+template <typename ElementType, typename SourceType, bool normalized>
+ElementType readAccessorElement(const std::byte* bytes) {
+	using Traits = ElementTraits<ElementType>;
+	if constexpr (hasPackedComponents<ElementType>() && std::is_same_v<typename Traits::component_type, SourceType>) {
+		// As with copyFromAccessor, elements which don't need any conversion are copied directly.
+		ElementType element;
+		std::memcpy(&element, bytes, sizeof(ElementType));
+		return element;
+	}
+	return convertAccessorElement<ElementType, SourceType>(bytes, normalized,
+		std::make_index_sequence<getNumComponents(ElementTraits<ElementType>::type)>{});
+}
+
+template <typename T>
+struct TypeTag {
+	using type = T;
+};
+
+/**
+ * Invokes func with a TypeTag of the C++ type matching the component type, and the normalization
+ * as a std::bool_constant. Does nothing for ComponentType::Invalid.
+ */
+template <typename Functor>
+void visitComponentType(ComponentType componentType, bool normalized, Functor&& func) {
+	auto visit = [&](auto tag) {
+		if (normalized) {
+			func(tag, std::true_type {});
+		} else {
+			func(tag, std::false_type {});
+		}
+	};
+	switch (componentType) {
+		case ComponentType::Byte: visit(TypeTag<std::int8_t> {}); break;
+		case ComponentType::UnsignedByte: visit(TypeTag<std::uint8_t> {}); break;
+		case ComponentType::Short: visit(TypeTag<std::int16_t> {}); break;
+		case ComponentType::UnsignedShort: visit(TypeTag<std::uint16_t> {}); break;
+		case ComponentType::Int: visit(TypeTag<std::int32_t> {}); break;
+		case ComponentType::UnsignedInt: visit(TypeTag<std::uint32_t> {}); break;
+		case ComponentType::Float: visit(TypeTag<float> {}); break;
+		case ComponentType::Double: visit(TypeTag<double> {}); break;
+		case ComponentType::Invalid:
+		default: break;
+	}
+}
+
 } // namespace internal
 
 FASTGLTF_EXPORT struct DefaultBufferDataAdapter {
@@ -665,121 +748,432 @@ ElementType getAccessorElement(const Asset& asset, const Accessor& accessor, siz
             accessor.componentType, &bytes[index * stride], accessor.normalized);
 }
 
-FASTGLTF_EXPORT template<typename ElementType, typename BufferDataAdapter = DefaultBufferDataAdapter>
+/**
+ * An accessor whose buffer data has been resolved once, together with a lookup table for the
+ * elements substituted by a sparse accessor. This makes random access O(1), while getAccessorElement
+ * has to resolve the buffers and perform a binary search over the sparse indices for every call.
+ * The table uses four bytes per element, and is only built for sparse accessors.
+ */
+FASTGLTF_EXPORT template <typename ElementType, typename BufferDataAdapter = DefaultBufferDataAdapter>
 #if FASTGLTF_HAS_CONCEPTS
 requires Element<ElementType>
 #endif
-IterableAccessor<ElementType, BufferDataAdapter> iterateAccessor(const Asset& asset, const Accessor& accessor, const BufferDataAdapter& adapter = {}) {
-	return IterableAccessor<ElementType, BufferDataAdapter>(asset, accessor, adapter);
-}
+class PreparedAccessor {
+	static constexpr auto noSparseValue = std::numeric_limits<std::uint32_t>::max();
 
-FASTGLTF_EXPORT template <typename ElementType, typename Functor, typename BufferDataAdapter = DefaultBufferDataAdapter>
-#if FASTGLTF_HAS_CONCEPTS
-requires Element<ElementType> && std::is_invocable_v<Functor, ElementType>
-#endif
-void iterateAccessor(const Asset& asset, const Accessor& accessor, Functor&& func,
-		const BufferDataAdapter& adapter = {}) {
-	using Traits = ElementTraits<ElementType>;
-	static_assert(Traits::type != AccessorType::Invalid, "Accessor traits must provide a valid accessor type");
-	static_assert(Traits::enum_component_type != ComponentType::Invalid, "Accessor traits must provide a valid component type");
-	static_assert(std::is_default_constructible_v<ElementType>, "Element type must be default constructible");
-	static_assert(std::is_constructible_v<ElementType>, "Element type must be constructible");
-	static_assert(std::is_move_assignable_v<ElementType>, "Element type must be move-assignable");
+	const Accessor* accessor;
 
-	assert(accessor.type == Traits::type && "The destination type needs to have the same AccessorType as the accessor.");
+	span<const std::byte> bufferBytes;
+	std::size_t stride = 0;
 
-	if (accessor.sparse && accessor.sparse->count > 0) {
-		auto indicesBytes = adapter(asset, accessor.sparse->indicesBufferView).subspan(accessor.sparse->indicesByteOffset);
-		auto indexStride = getElementByteSize(AccessorType::Scalar, accessor.sparse->indexComponentType);
+	span<const std::byte> valuesBytes;
+	std::size_t valueStride = 0;
 
-		auto valuesBytes = adapter(asset, accessor.sparse->valuesBufferView).subspan(accessor.sparse->valuesByteOffset);
-		// "The index of the bufferView with sparse values. The referenced buffer view MUST NOT
-		// have its target or byteStride properties defined."
-		auto valueStride = getElementByteSize(accessor.type, accessor.componentType);
+	// The index of the sparse value for every element, or noSparseValue if it is not substituted.
+	std::vector<std::uint32_t> sparseValueIndices;
 
-		span<const std::byte> srcBytes;
-		std::size_t srcStride = 0;
+public:
+	explicit PreparedAccessor(const Asset& asset, const Accessor& accessor, const BufferDataAdapter& adapter = {}) : accessor(&accessor) {
+		using Traits = ElementTraits<ElementType>;
+		static_assert(Traits::type != AccessorType::Invalid, "Accessor traits must provide a valid Accessor Type");
+		assert(accessor.type == Traits::type && "The destination type needs to have the same AccessorType as the accessor.");
 
 		// 5.1.1. accessor.bufferView
-		// The index of the buffer view. When undefined, the accessor MUST be initialized with zeros; sparse
-		// property or extensions MAY override zeros with actual values.
+		// When undefined, the accessor MUST be initialized with zeros; sparse property or extensions
+		// MAY override zeros with actual values.
 		if (accessor.bufferViewIndex) {
-			auto& view = asset.bufferViews[*accessor.bufferViewIndex];
-			srcBytes = adapter(asset, *accessor.bufferViewIndex).subspan(accessor.byteOffset);
-            srcStride = view.byteStride.value_or(getElementByteSize(accessor.type, accessor.componentType));
-        }
+			const auto& view = asset.bufferViews[*accessor.bufferViewIndex];
+			stride = view.byteStride.value_or(getElementByteSize(accessor.type, accessor.componentType));
+			bufferBytes = adapter(asset, *accessor.bufferViewIndex).subspan(accessor.byteOffset);
+		}
 
-		auto nextSparseIndex = internal::getAccessorElementAt<std::uint32_t>(
-				accessor.sparse->indexComponentType, indicesBytes.data());
-		std::size_t sparseIndexCount = 0;
+		if (!accessor.sparse || accessor.sparse->count == 0)
+			return;
 
-		for (std::size_t i = 0; i < accessor.count; ++i) {
-			if (i == nextSparseIndex) {
-				auto element = internal::getAccessorElementAt<ElementType>(accessor.componentType,
-						&valuesBytes[valueStride * sparseIndexCount],
-						accessor.normalized);
+		const auto& sparse = *accessor.sparse;
+		auto indicesBytes = adapter(asset, sparse.indicesBufferView).subspan(sparse.indicesByteOffset);
+		auto indexStride = getElementByteSize(AccessorType::Scalar, sparse.indexComponentType);
+
+		valuesBytes = adapter(asset, sparse.valuesBufferView).subspan(sparse.valuesByteOffset);
+		// "The index of the bufferView with sparse values. The referenced buffer view MUST NOT
+		// have its target or byteStride properties defined."
+		valueStride = getElementByteSize(accessor.type, accessor.componentType);
 
-				std::invoke(func, element);
+		sparseValueIndices.resize(accessor.count, noSparseValue);
+		for (std::size_t i = 0; i < sparse.count; ++i) {
+			auto index = internal::getAccessorElementAt<std::uint32_t>(sparse.indexComponentType, &indicesBytes[indexStride * i]);
+			if (index < accessor.count) {
+				sparseValueIndices[index] = static_cast<std::uint32_t>(i);
+			}
+		}
+	}
 
-				++sparseIndexCount;
+	[[nodiscard]] std::size_t size() const noexcept {
+		return accessor->count;
+	}
 
-				if (sparseIndexCount < accessor.sparse->count) {
-					nextSparseIndex = internal::getAccessorElementAt<std::uint32_t>(
-							accessor.sparse->indexComponentType, &indicesBytes[indexStride * sparseIndexCount]);
-				}
-			} else if (accessor.bufferViewIndex) {
-				auto element = internal::getAccessorElementAt<ElementType>(accessor.componentType,
-						&srcBytes[srcStride * i],
-						accessor.normalized);
+	[[nodiscard]] ElementType get(std::size_t index) const {
+		assert(index < accessor->count && "The element index is out of bounds.");
+		if (!sparseValueIndices.empty() && sparseValueIndices[index] != noSparseValue) {
+			return internal::getAccessorElementAt<ElementType>(accessor->componentType,
+					&valuesBytes[valueStride * sparseValueIndices[index]], accessor->normalized);
+		}
 
-				std::invoke(func, element);
+		if (bufferBytes.empty()) {
+			if constexpr (std::is_aggregate_v<ElementType>) {
+				return ElementType{};
 			} else {
-				std::invoke(func, ElementType {});
+				return ElementType();
 			}
 		}
 
-		return;
+		return internal::getAccessorElementAt<ElementType>(accessor->componentType,
+				&bufferBytes[index * stride], accessor->normalized);
 	}
 
-	// 5.1.1. accessor.bufferView
-	// The index of the buffer view. When undefined, the accessor MUST be initialized with zeros; sparse
-	// property or extensions MAY override zeros with actual values.
-	if (!accessor.bufferViewIndex) {
-		for (std::size_t i = 0; i < accessor.count; ++i) {
-			std::invoke(func, ElementType {});
+	[[nodiscard]] ElementType operator[](std::size_t index) const {
+		return get(index);
+	}
+};
+
+FASTGLTF_EXPORT template <typename ElementType, typename BufferDataAdapter = DefaultBufferDataAdapter>
+#if FASTGLTF_HAS_CONCEPTS
+requires Element<ElementType>
+#endif
+PreparedAccessor<ElementType, BufferDataAdapter> prepareAccessor(const Asset& asset, const Accessor& accessor, const BufferDataAdapter& adapter = {}) {
+	return PreparedAccessor<ElementType, BufferDataAdapter>(asset, accessor, adapter);
+}
+
+/**
+ * A typed view of an accessor, which resolves the buffer data, stride, source component type, and
+ * normalization once, instead of dispatching on the component type for every element. forEachChunk
+ * reads a contiguous range of elements with a loop specialized for the source component type, and
+ * reads the elements between two sparse substitutions without checking for substitutions. The view
+ * is never modified, so that disjoint ranges can be processed on multiple threads at once, either by
+ * calling forEachChunk from every thread or through the random access iterators, for example with
+ * std::for_each(std::execution::par, ...). Random access into a sparse accessor performs a binary
+ * search over the sparse indices, for which PreparedAccessor is faster. The iterators reference the
+ * view, which therefore needs to outlive them.
+ */
+FASTGLTF_EXPORT template <typename ElementType, typename BufferDataAdapter = DefaultBufferDataAdapter>
+#if FASTGLTF_HAS_CONCEPTS
+requires Element<ElementType>
+#endif
+class AccessorView {
+	using ElementReader = ElementType (*)(const std::byte*);
+	using IndexReader = std::uint32_t (*)(const std::byte*);
+
+	std::size_t elementCount = 0;
+	ComponentType componentType = ComponentType::Invalid;
+	bool normalized = false;
+	ElementReader readElement = nullptr;
+
+	span<const std::byte> bufferBytes;
+	std::size_t stride = 0;
+
+	// Data needed for sparse accessors
+	span<const std::byte> indicesBytes;
+	std::size_t indexStride = 0;
+	IndexReader readIndex = nullptr;
+	span<const std::byte> valuesBytes;
+	std::size_t valueStride = 0;
+	std::size_t sparseCount = 0;
+
+	static ElementType readZero(const std::byte*) {
+		if constexpr (std::is_aggregate_v<ElementType>) {
+			return ElementType {};
+		} else {
+			return ElementType();
 		}
-	} else {
-		auto& view = asset.bufferViews[*accessor.bufferViewIndex];
-        auto stride = view.byteStride.value_or(getElementByteSize(accessor.type, accessor.componentType));
+	}
 
-		auto bytes = adapter(asset, *accessor.bufferViewIndex).subspan(accessor.byteOffset);
+	[[nodiscard]] std::size_t getSparseIndex(std::size_t sparseValue) const noexcept {
+		return readIndex(&indicesBytes[indexStride * sparseValue]);
+	}
 
-		for (std::size_t i = 0; i < accessor.count; ++i) {
-			auto element = internal::getAccessorElementAt<ElementType>(
-				accessor.componentType, &bytes[i * stride], accessor.normalized);
+	// Returns the first sparse value whose index is not smaller than the given index.
+	[[nodiscard]] std::size_t findSparseValue(std::size_t index) const noexcept {
+		std::size_t first = 0;
+		std::size_t count = sparseCount;
+		while (count > 0) {
+			auto step = count / 2;
+			if (getSparseIndex(first + step) < index) {
+				first += step + 1;
+				count -= step + 1;
+			} else {
+				count = step;
+			}
+		}
+		return first;
+	}
+
+	template <typename Functor>
+	static void invokeElement(Functor& func, ElementType& element, std::size_t index) {
+		if constexpr (std::is_invocable_v<Functor&, ElementType&, std::size_t>) {
+			std::invoke(func, element, index);
+		} else {
 			std::invoke(func, element);
 		}
 	}
-}
 
-FASTGLTF_EXPORT template <typename ElementType, typename Functor, typename BufferDataAdapter = DefaultBufferDataAdapter>
+	template <typename SourceType, bool isNormalized, typename Functor>
+	void forEachDense(std::size_t begin, std::size_t end, Functor& func) const {
+		const auto* bytes = bufferBytes.data() + begin * stride;
+		for (auto i = begin; i < end; ++i, bytes += stride) {
+			auto element = internal::readAccessorElement<ElementType, SourceType, isNormalized>(bytes);
+			invokeElement(func, element, i);
+		}
+	}
+
+	template <typename Functor>
+	void forEachDense(std::size_t begin, std::size_t end, Functor& func) const {
+		if (begin == end)
+			return;
+
+		if (bufferBytes.empty()) {
+			for (auto i = begin; i < end; ++i) {
+				auto element = readZero(nullptr);
+				invokeElement(func, element, i);
+			}
+			return;
+		}
+
+		internal::visitComponentType(componentType, normalized, [&](auto tag, auto normalizedTag) {
+			forEachDense<typename decltype(tag)::type, decltype(normalizedTag)::value>(begin, end, func);
+		});
+	}
+
+public:
+	class iterator {
+		const AccessorView* view = nullptr;
+		std::size_t idx = 0;
+
+	public:
+		// The elements are converted when dereferencing, and are therefore returned by value.
+		using value_type = ElementType;
+		using reference = ElementType;
+		using pointer = void;
+		using difference_type = std::ptrdiff_t;
+		using iterator_category = std::random_access_iterator_tag;
+#if FASTGLTF_CPP_20
+		using iterator_concept = std::random_access_iterator_tag;
+#endif
+
+		iterator() = default;
+		iterator(const AccessorView* view, std::size_t idx) noexcept : view(view), idx(idx) {}
+
+		[[nodiscard]] std::size_t index() const noexcept {
+			return idx;
+		}
+
+		[[nodiscard]] reference operator*() const {
+			return view->get(idx);
+		}
+
+		[[nodiscard]] reference operator[](difference_type n) const {
+			return view->get(idx + n);
+		}
+
+		iterator& operator++() noexcept {
+			++idx;
+			return *this;
+		}
+
+		iterator operator++(int) noexcept {
+			auto x = *this;
+			++idx;
+			return x;
+		}
+
+		iterator& operator--() noexcept {
+			--idx;
+			return *this;
+		}
+
+		iterator operator--(int) noexcept {
+			auto x = *this;
+			--idx;
+			return x;
+		}
+
+		iterator& operator+=(difference_type n) noexcept {
+			idx += n;
+			return *this;
+		}
+
+		iterator& operator-=(difference_type n) noexcept {
+			idx -= n;
+			return *this;
+		}
+
+		[[nodiscard]] iterator operator+(difference_type n) const noexcept {
+			return iterator(view, idx + n);
+		}
+
+		[[nodiscard]] friend iterator operator+(difference_type n, const iterator& it) noexcept {
+			return it + n;
+		}
+
+		[[nodiscard]] iterator operator-(difference_type n) const noexcept {
+			return iterator(view, idx - n);
+		}
+
+		[[nodiscard]] difference_type operator-(const iterator& other) const noexcept {
+			return static_cast<difference_type>(idx - other.idx);
+		}
+
+		[[nodiscard]] bool operator==(const iterator& other) const noexcept {
+			return view == other.view && idx == other.idx;
+		}
+
+		[[nodiscard]] bool operator!=(const iterator& other) const noexcept {
+			return !(*this == other);
+		}
+
+		[[nodiscard]] bool operator<(const iterator& other) const noexcept {
+			return idx < other.idx;
+		}
+
+		[[nodiscard]] bool operator>(const iterator& other) const noexcept {
+			return idx > other.idx;
+		}
+
+		[[nodiscard]] bool operator<=(const iterator& other) const noexcept {
+			return idx <= other.idx;
+		}
+
+		[[nodiscard]] bool operator>=(const iterator& other) const noexcept {
+			return idx >= other.idx;
+		}
+	};
+
+	explicit AccessorView(const Asset& asset, const Accessor& accessor, const BufferDataAdapter& adapter = {})
+			: elementCount(accessor.count), componentType(accessor.componentType), normalized(accessor.normalized) {
+		using Traits = ElementTraits<ElementType>;
+		static_assert(Traits::type != AccessorType::Invalid, "Accessor traits must provide a valid Accessor Type");
+		assert(accessor.type == Traits::type && "The destination type needs to have the same AccessorType as the accessor.");
+
+		internal::visitComponentType(componentType, normalized, [&](auto tag, auto normalizedTag) {
+			readElement = &internal::readAccessorElement<ElementType, typename decltype(tag)::type, decltype(normalizedTag)::value>;
+		});
+		if (readElement == nullptr) {
+			// Elements with an invalid component type are read as zeros, like accessors without a buffer view.
+			readElement = &readZero;
+			return;
+		}
+
+		// 5.1.1. accessor.bufferView
+		// When undefined, the accessor MUST be initialized with zeros; sparse property or extensions
+		// MAY override zeros with actual values.
+		if (accessor.bufferViewIndex) {
+			const auto& view = asset.bufferViews[*accessor.bufferViewIndex];
+			stride = view.byteStride.value_or(getElementByteSize(accessor.type, accessor.componentType));
+			bufferBytes = adapter(asset, *accessor.bufferViewIndex).subspan(accessor.byteOffset);
+		}
+
+		if (!accessor.sparse || accessor.sparse->count == 0)
+			return;
+
+		const auto& sparse = *accessor.sparse;
+		internal::visitComponentType(sparse.indexComponentType, false, [&](auto tag, auto) {
+			readIndex = &internal::readAccessorElement<std::uint32_t, typename decltype(tag)::type, false>;
+		});
+		if (readIndex == nullptr)
+			return;
+
+		indicesBytes = adapter(asset, sparse.indicesBufferView).subspan(sparse.indicesByteOffset);
+		indexStride = getElementByteSize(AccessorType::Scalar, sparse.indexComponentType);
+
+		valuesBytes = adapter(asset, sparse.valuesBufferView).subspan(sparse.valuesByteOffset);
+		// "The index of the bufferView with sparse values. The referenced buffer view MUST NOT
+		// have its target or byteStride properties defined."
+		valueStride = getElementByteSize(accessor.type, accessor.componentType);
+		sparseCount = sparse.count;
+	}
+
+	[[nodiscard]] std::size_t size() const noexcept {
+		return elementCount;
+	}
+
+	[[nodiscard]] ElementType get(std::size_t index) const {
+		assert(index < elementCount && "The element index is out of bounds.");
+		if (sparseCount != 0) {
+			auto sparseValue = findSparseValue(index);
+			if (sparseValue < sparseCount && getSparseIndex(sparseValue) == index) {
+				return readElement(&valuesBytes[valueStride * sparseValue]);
+			}
+		}
+
+		if (bufferBytes.empty()) {
+			return readZero(nullptr);
+		}
+		return readElement(&bufferBytes[index * stride]);
+	}
+
+	[[nodiscard]] ElementType operator[](std::size_t index) const {
+		return get(index);
+	}
+
+	/**
+	 * Invokes func for every element in the range [begin, end), in order. func is called either with
+	 * the element, or with the element and its index, if it accepts two arguments.
+	 */
+	template <typename Functor>
+	void forEachChunk(std::size_t begin, std::size_t end, Functor&& func) const {
+		assert(begin <= end && end <= elementCount && "The chunk is out of bounds.");
+		auto sparseValue = sparseCount != 0 ? findSparseValue(begin) : 0;
+		for (auto i = begin; i < end;) {
+			// Skips duplicated sparse indices, of which only the first value is used.
+			while (sparseValue < sparseCount && getSparseIndex(sparseValue) < i)
+				++sparseValue;
+
+			const auto next = sparseValue < sparseCount ? fastgltf::min(getSparseIndex(sparseValue), end) : end;
+			forEachDense(i, next, func);
+			if (next == end)
+				break;
+
+			auto element = readElement(&valuesBytes[valueStride * sparseValue]);
+			invokeElement(func, element, next);
+			i = next + 1;
+			++sparseValue;
+		}
+	}
+
+	[[nodiscard]] iterator begin() const noexcept {
+		return iterator(this, 0);
+	}
+
+	[[nodiscard]] iterator end() const noexcept {
+		return iterator(this, elementCount);
+	}
+};
+
 #if FASTGLTF_HAS_CONCEPTS
-requires Element<ElementType> && std::is_invocable_v<Functor, ElementType, std::size_t>
+static_assert(std::random_access_iterator<AccessorView<math::fvec4>::iterator>, "AccessorView::iterator needs to satisfy random_access_iterator");
+static_assert(std::ranges::random_access_range<AccessorView<math::fvec4>>, "AccessorView needs to satisfy random_access_range");
 #endif
-void iterateAccessorWithIndex(const Asset& asset, const Accessor& accessor, Functor&& func,
-                     const BufferDataAdapter& adapter = {}) {
-	std::size_t idx = 0;
-	iterateAccessor<ElementType>(asset, accessor, [&](auto&& elementType) {
-		std::invoke(func, std::forward<ElementType>(elementType), idx++);
-	}, adapter);
+
+FASTGLTF_EXPORT template <typename ElementType, typename BufferDataAdapter = DefaultBufferDataAdapter>
+#if FASTGLTF_HAS_CONCEPTS
+requires Element<ElementType>
+#endif
+AccessorView<ElementType, BufferDataAdapter> viewAccessor(const Asset& asset, const Accessor& accessor, const BufferDataAdapter& adapter = {}) {
+	return AccessorView<ElementType, BufferDataAdapter>(asset, accessor, adapter);
 }
 
-FASTGLTF_EXPORT template <typename ElementType, std::size_t TargetStride = sizeof(ElementType),
-    typename BufferDataAdapter = DefaultBufferDataAdapter>
+FASTGLTF_EXPORT template<typename ElementType, typename BufferDataAdapter = DefaultBufferDataAdapter>
 #if FASTGLTF_HAS_CONCEPTS
 requires Element<ElementType>
 #endif
-void copyFromAccessor(const Asset& asset, const Accessor& accessor, void* dest,
+IterableAccessor<ElementType, BufferDataAdapter> iterateAccessor(const Asset& asset, const Accessor& accessor, const BufferDataAdapter& adapter = {}) {
+	return IterableAccessor<ElementType, BufferDataAdapter>(asset, accessor, adapter);
+}
+
+FASTGLTF_EXPORT template <typename ElementType, typename Functor, typename BufferDataAdapter = DefaultBufferDataAdapter>
+#if FASTGLTF_HAS_CONCEPTS
+requires Element<ElementType> && std::is_invocable_v<Functor, ElementType>
+#endif
+void iterateAccessor(const Asset& asset, const Accessor& accessor, Functor&& func,
 		const BufferDataAdapter& adapter = {}) {
 	using Traits = ElementTraits<ElementType>;
 	static_assert(Traits::type != AccessorType::Invalid, "Accessor traits must provide a valid accessor type");
@@ -788,16 +1182,30 @@ void copyFromAccessor(const Asset& asset, const Accessor& accessor, void* dest,
 	static_assert(std::is_constructible_v<ElementType>, "Element type must be constructible");
 	static_assert(std::is_move_assignable_v<ElementType>, "Element type must be move-assignable");
 
-	assert(accessor.type == Traits::type && "The destination type needs to have the same AccessorType as the accessor.");
+	// The view dispatches on the component type once, and skips over the sparse substitutions in bulk.
+	AccessorView<ElementType, BufferDataAdapter> view(asset, accessor, adapter);
+	view.forEachChunk(0, view.size(), [&](ElementType& element) {
+		std::invoke(func, element);
+	});
+}
 
-	auto* dstBytes = static_cast<std::byte*>(dest);
+FASTGLTF_EXPORT template <typename ElementType, typename Functor, typename BufferDataAdapter = DefaultBufferDataAdapter>
+#if FASTGLTF_HAS_CONCEPTS
+requires Element<ElementType> && std::is_invocable_v<Functor, ElementType, std::size_t>
+#endif
+void iterateAccessorWithIndex(const Asset& asset, const Accessor& accessor, Functor&& func,
+                     const BufferDataAdapter& adapter = {}) {
+	AccessorView<ElementType, BufferDataAdapter> view(asset, accessor, adapter);
+	view.forEachChunk(0, view.size(), [&](ElementType& element, std::size_t idx) {
+		std::invoke(func, std::forward<ElementType>(element), idx);
+	});
+}
 
-	if (accessor.sparse && accessor.sparse->count > 0) {
-		return iterateAccessorWithIndex<ElementType>(asset, accessor, [&](auto&& value, std::size_t index) {
-			auto* pDest = reinterpret_cast<ElementType*>(dstBytes + TargetStride * index);
-			*pDest = std::forward<ElementType>(value);
-		}, adapter);
-	}
+namespace internal {
+template <typename ElementType, std::size_t TargetStride, typename BufferDataAdapter>
+void copyDenseFromAccessor(const Asset& asset, const Accessor& accessor, void* dest, const BufferDataAdapter& adapter) {
+	using Traits = ElementTraits<ElementType>;
+	auto* dstBytes = static_cast<std::byte*>(dest);
 
 	auto elemSize = getElementByteSize(accessor.type, accessor.componentType);
 
@@ -805,12 +1213,13 @@ void copyFromAccessor(const Asset& asset, const Accessor& accessor, void* dest,
 	// The index of the buffer view. When undefined, the accessor MUST be initialized with zeros; sparse
 	// property or extensions MAY override zeros with actual values.
 	if (!accessor.bufferViewIndex) {
+		// The destination elements are not necessarily as large as the source elements.
 		if constexpr (std::is_trivially_copyable_v<ElementType>) {
-			if (TargetStride == elemSize) {
-				std::memset(dest, 0, elemSize * accessor.count);
+			if (TargetStride == sizeof(ElementType)) {
+				std::memset(dest, 0, sizeof(ElementType) * accessor.count);
 			} else {
 				for (std::size_t i = 0; i < accessor.count; ++i) {
-					std::memset(dstBytes + i * TargetStride, 0, elemSize);
+					std::memset(dstBytes + i * TargetStride, 0, sizeof(ElementType));
 				}
 			}
 		} else {
@@ -843,35 +1252,68 @@ void copyFromAccessor(const Asset& asset, const Accessor& accessor, void* dest,
 			}
 		}
 	} else {
+		if constexpr (internal::hasPackedComponents<ElementType>()) {
+			if (internal::convertComponents(srcBytes.data(), srcStride, accessor.componentType, dstBytes, TargetStride,
+					Traits::enum_component_type, getNumComponents(accessor.type), accessor.count, accessor.normalized)) {
+				return;
+			}
+		}
+
 		for (std::size_t i = 0; i < accessor.count; ++i) {
 			auto* pDest = reinterpret_cast<ElementType*>(dstBytes + TargetStride * i);
 			*pDest = internal::getAccessorElementAt<ElementType>(
-                    accessor.componentType, &srcBytes[srcStride * i]);
+                    accessor.componentType, &srcBytes[srcStride * i], accessor.normalized);
 		}
 	}
 }
 
 /**
- * This function allows copying each component into a linear list, instead of copying per-element,
- * while still performing the correct conversions for the destination type.
- * It is advised to *not* use this function unless necessary, like for example when implementing
- * a generic animation interface.
+ * Overwrites the elements which are substituted by the sparse accessor, after the dense base has
+ * already been written to dest.
  */
-FASTGLTF_EXPORT template <typename ComponentType, typename BufferDataAdapter = DefaultBufferDataAdapter>
-void copyComponentsFromAccessor(const Asset& asset, const Accessor& accessor, void* dest, const BufferDataAdapter& adapter = {}) {
-	constexpr auto DestType = ComponentTypeConverter<ComponentType>::type;
-
-	assert((!bool(accessor.sparse) || accessor.sparse->count == 0) && "copyComponentsFromAccessor currently does not support sparse accessors.");
-
+template <typename ElementType, std::size_t TargetStride, typename BufferDataAdapter>
+void scatterSparseElements(const Asset& asset, const Accessor& accessor, void* dest, const BufferDataAdapter& adapter) {
+	using Traits = ElementTraits<ElementType>;
 	auto* dstBytes = static_cast<std::byte*>(dest);
 
-	auto elemSize = getElementByteSize(accessor.type, accessor.componentType);
-	auto componentCount = getNumComponents(accessor.type);
+	const auto& sparse = *accessor.sparse;
+	auto indicesBytes = adapter(asset, sparse.indicesBufferView).subspan(sparse.indicesByteOffset);
+	auto indexStride = getElementByteSize(AccessorType::Scalar, sparse.indexComponentType);
 
-	auto& view = asset.bufferViews[*accessor.bufferViewIndex];
-	auto srcStride = view.byteStride.value_or(elemSize);
+	auto valuesBytes = adapter(asset, sparse.valuesBufferView).subspan(sparse.valuesByteOffset);
+	// "The index of the bufferView with sparse values. The referenced buffer view MUST NOT
+	// have its target or byteStride properties defined."
+	auto valueStride = getElementByteSize(accessor.type, accessor.componentType);
 
-	auto srcBytes = adapter(asset, *accessor.bufferViewIndex).subspan(accessor.byteOffset);
+	const bool canCopy = std::is_trivially_copyable_v<ElementType> && !accessor.normalized
+		&& accessor.componentType == Traits::enum_component_type && !isMatrix(accessor.type);
+	for (std::size_t i = 0; i < sparse.count; ++i) {
+		auto index = getAccessorElementAt<std::uint32_t>(sparse.indexComponentType, &indicesBytes[indexStride * i]);
+		if (index >= accessor.count)
+			continue;
+
+		if (canCopy) {
+			std::memcpy(dstBytes + TargetStride * index, &valuesBytes[valueStride * i], valueStride);
+		} else {
+			auto* pDest = reinterpret_cast<ElementType*>(dstBytes + TargetStride * index);
+			*pDest = getAccessorElementAt<ElementType>(accessor.componentType, &valuesBytes[valueStride * i], accessor.normalized);
+		}
+	}
+}
+
+template <typename ComponentType, typename BufferDataAdapter>
+void copyDenseComponentsFromAccessor(const Asset& asset, const Accessor& accessor, void* dest, const BufferDataAdapter& adapter) {
+	constexpr auto DestType = ComponentTypeConverter<ComponentType>::type;
+
+	auto* dstBytes = static_cast<std::byte*>(dest);
+
+	auto elemSize = getElementByteSize(accessor.type, accessor.componentType);
+	auto componentCount = getNumComponents(accessor.type);
+
+	auto& view = asset.bufferViews[*accessor.bufferViewIndex];
+	auto srcStride = view.byteStride.value_or(elemSize);
+
+	auto srcBytes = adapter(asset, *accessor.bufferViewIndex).subspan(accessor.byteOffset);
 
 	if (accessor.componentType == DestType && !accessor.normalized && !isMatrix(accessor.type)) {
 		if (srcStride == elemSize) {
@@ -882,15 +1324,515 @@ void copyComponentsFromAccessor(const Asset& asset, const Accessor& accessor, vo
 			}
 		}
 	} else {
+		// The destination is tightly packed, which is not the same as elemSize when converting.
+		const auto dstStride = componentCount * sizeof(ComponentType);
+		if (!isMatrix(accessor.type) && internal::convertComponents(srcBytes.data(), srcStride, accessor.componentType,
+				dstBytes, dstStride, DestType, componentCount, accessor.count, accessor.normalized)) {
+			return;
+		}
+
 		for (std::size_t i = 0; i < accessor.count; ++i) {
 			for (std::size_t j = 0; j < componentCount; ++j) {
-				auto* pDest = reinterpret_cast<ComponentType*>(dstBytes + elemSize * i) + j;
+				auto* pDest = reinterpret_cast<ComponentType*>(dstBytes + dstStride * i) + j;
 				*pDest = internal::getAccessorComponentAt<ComponentType>(
 					accessor.componentType, accessor.type, &srcBytes[i * srcStride], j, accessor.normalized);
 			}
 		}
 	}
 }
+} // namespace internal
+
+FASTGLTF_EXPORT template <typename ElementType, std::size_t TargetStride = sizeof(ElementType),
+    typename BufferDataAdapter = DefaultBufferDataAdapter>
+#if FASTGLTF_HAS_CONCEPTS
+requires Element<ElementType>
+#endif
+void copyFromAccessor(const Asset& asset, const Accessor& accessor, void* dest,
+		const BufferDataAdapter& adapter = {}) {
+	using Traits = ElementTraits<ElementType>;
+	static_assert(Traits::type != AccessorType::Invalid, "Accessor traits must provide a valid accessor type");
+	static_assert(Traits::enum_component_type != ComponentType::Invalid, "Accessor traits must provide a valid component type");
+	static_assert(std::is_default_constructible_v<ElementType>, "Element type must be default constructible");
+	static_assert(std::is_constructible_v<ElementType>, "Element type must be constructible");
+	static_assert(std::is_move_assignable_v<ElementType>, "Element type must be move-assignable");
+
+	assert(accessor.type == Traits::type && "The destination type needs to have the same AccessorType as the accessor.");
+
+	internal::copyDenseFromAccessor<ElementType, TargetStride>(asset, accessor, dest, adapter);
+
+	// Sparse accessors are materialized by copying the dense base in bulk, and then only
+	// overwriting the substituted elements.
+	if (accessor.sparse && accessor.sparse->count > 0) {
+		internal::scatterSparseElements<ElementType, TargetStride>(asset, accessor, dest, adapter);
+	}
+}
+
+/**
+ * This function allows copying each component into a linear list, instead of copying per-element,
+ * while still performing the correct conversions for the destination type.
+ * It is advised to *not* use this function unless necessary, like for example when implementing
+ * a generic animation interface.
+ */
+FASTGLTF_EXPORT template <typename ComponentType, typename BufferDataAdapter = DefaultBufferDataAdapter>
+void copyComponentsFromAccessor(const Asset& asset, const Accessor& accessor, void* dest, const BufferDataAdapter& adapter = {}) {
+	auto* dstBytes = static_cast<std::byte*>(dest);
+
+	auto elemSize = getElementByteSize(accessor.type, accessor.componentType);
+	auto componentCount = getNumComponents(accessor.type);
+
+	// The destination is tightly packed, which is not the same as elemSize when converting.
+	const auto dstStride = componentCount * sizeof(ComponentType);
+
+	if (!accessor.bufferViewIndex) {
+		// 5.1.1. accessor.bufferView
+		// When undefined, the accessor MUST be initialized with zeros.
+		std::memset(dest, 0, dstStride * accessor.count);
+	} else {
+		internal::copyDenseComponentsFromAccessor<ComponentType>(asset, accessor, dest, adapter);
+	}
+
+	if (!accessor.sparse || accessor.sparse->count == 0)
+		return;
+
+	// Overwrite the components of the elements which are substituted by the sparse accessor.
+	const auto& sparse = *accessor.sparse;
+	auto indicesBytes = adapter(asset, sparse.indicesBufferView).subspan(sparse.indicesByteOffset);
+	auto indexStride = getElementByteSize(AccessorType::Scalar, sparse.indexComponentType);
+
+	auto valuesBytes = adapter(asset, sparse.valuesBufferView).subspan(sparse.valuesByteOffset);
+	auto valueStride = elemSize;
+
+	for (std::size_t i = 0; i < sparse.count; ++i) {
+		auto index = internal::getAccessorElementAt<std::uint32_t>(sparse.indexComponentType, &indicesBytes[indexStride * i]);
+		if (index >= accessor.count)
+			continue;
+
+		for (std::size_t j = 0; j < componentCount; ++j) {
+			auto* pDest = reinterpret_cast<ComponentType*>(dstBytes + dstStride * index) + j;
+			*pDest = internal::getAccessorComponentAt<ComponentType>(
+				accessor.componentType, accessor.type, &valuesBytes[valueStride * i], j, accessor.normalized);
+		}
+	}
+}
+
+/**
+ * Describes where a single vertex attribute is written to within an interleaved vertex. The
+ * accessor type has to match the accessor of the attribute, while the component type may differ,
+ * in which case the components are converted just like copyFromAccessor does.
+ */
+FASTGLTF_EXPORT struct VertexAttributeLayout {
+	std::string_view name;
+	std::size_t offset;
+	AccessorType type;
+	ComponentType componentType;
+};
+
+/** The size and attributes of an interleaved vertex, as used by copyInterleavedVertices. */
+FASTGLTF_EXPORT struct VertexLayout {
+	std::size_t stride = 0;
+	std::vector<VertexAttributeLayout> attributes;
+};
+
+/** The kind of memory copyInterleavedVertices writes into. */
+FASTGLTF_EXPORT enum class VertexDestination : std::uint8_t {
+	/** Regular memory, which is written to directly. */
+	Cached,
+	/**
+	 * Write-combined memory, like a mapped GPU buffer, which should never be read from and only be
+	 * written to sequentially. Every block of vertices is assembled in a small staging buffer first,
+	 * which is then copied over as a whole.
+	 */
+	WriteCombined,
+};
+
+namespace internal {
+template <typename DestType>
+void convertComponentsGeneric(const std::byte* src, std::size_t srcStride, ComponentType srcType, AccessorType type,
+		std::byte* dst, std::size_t dstStride, std::size_t count, bool normalized) {
+	const auto componentCount = getNumComponents(type);
+	for (std::size_t i = 0; i < count; ++i) {
+		for (std::size_t j = 0; j < componentCount; ++j) {
+			auto value = getAccessorComponentAt<DestType>(srcType, type, src + i * srcStride, j, normalized);
+			std::memcpy(dst + i * dstStride + j * sizeof(DestType), &value, sizeof(DestType));
+		}
+	}
+}
+
+/**
+ * Converts count elements between any two component types, using a plain copy if the types
+ * match, and the SIMD kernels where possible.
+ */
+inline void convertElements(const std::byte* src, std::size_t srcStride, ComponentType srcType, AccessorType type,
+		std::byte* dst, std::size_t dstStride, ComponentType dstType, std::size_t count, bool normalized) {
+	if (srcType == dstType) {
+		const auto elemSize = getElementByteSize(type, srcType);
+		for (std::size_t i = 0; i < count; ++i) {
+			std::memcpy(dst + i * dstStride, src + i * srcStride, elemSize);
+		}
+		return;
+	}
+
+	if (convertComponents(src, srcStride, srcType, dst, dstStride, dstType, getNumComponents(type), count, normalized))
+		return;
+
+	switch (dstType) {
+		case ComponentType::Byte:
+			return convertComponentsGeneric<std::int8_t>(src, srcStride, srcType, type, dst, dstStride, count, normalized);
+		case ComponentType::UnsignedByte:
+			return convertComponentsGeneric<std::uint8_t>(src, srcStride, srcType, type, dst, dstStride, count, normalized);
+		case ComponentType::Short:
+			return convertComponentsGeneric<std::int16_t>(src, srcStride, srcType, type, dst, dstStride, count, normalized);
+		case ComponentType::UnsignedShort:
+			return convertComponentsGeneric<std::uint16_t>(src, srcStride, srcType, type, dst, dstStride, count, normalized);
+		case ComponentType::Int:
+			return convertComponentsGeneric<std::int32_t>(src, srcStride, srcType, type, dst, dstStride, count, normalized);
+		case ComponentType::UnsignedInt:
+			return convertComponentsGeneric<std::uint32_t>(src, srcStride, srcType, type, dst, dstStride, count, normalized);
+		case ComponentType::Float:
+			return convertComponentsGeneric<float>(src, srcStride, srcType, type, dst, dstStride, count, normalized);
+		case ComponentType::Double:
+			return convertComponentsGeneric<double>(src, srcStride, srcType, type, dst, dstStride, count, normalized);
+		case ComponentType::Invalid:
+			break;
+	}
+}
+
+/** An attribute of an interleaved vertex, with the data of its accessor already resolved. */
+struct InterleavedAttribute {
+	const Accessor* accessor;
+	std::size_t offset;
+	ComponentType componentType;
+	std::size_t elementSize;
+
+	span<const std::byte> bytes;
+	std::size_t stride;
+
+	span<const std::byte> indicesBytes;
+	span<const std::byte> valuesBytes;
+	std::size_t indexStride;
+	std::size_t nextSparseValue;
+};
+} // namespace internal
+
+/**
+ * Returns the number of vertices of a primitive, which is the element count shared by the
+ * accessors of all of its attributes.
+ */
+FASTGLTF_EXPORT inline std::size_t getVertexCount(const Asset& asset, const Primitive& primitive) {
+	if (primitive.attributes.empty())
+		return 0;
+	return asset.accessors[primitive.attributes.begin()->accessorIndex].count;
+}
+
+/**
+ * Writes the attributes of a primitive into a buffer of interleaved vertices, which needs to be
+ * large enough for getVertexCount(asset, primitive) * layout.stride bytes. Instead of one strided
+ * pass over the destination for every attribute, the vertices are processed in blocks which fit
+ * into the cache, and all attributes of a block are written before moving on to the next one.
+ * Attributes which the primitive doesn't have are filled with zeros. Bytes between the attributes
+ * are left untouched, unless the destination is write-combined, in which case they are zeroed.
+ * Returns the number of vertices written.
+ */
+FASTGLTF_EXPORT template <typename BufferDataAdapter = DefaultBufferDataAdapter>
+std::size_t copyInterleavedVertices(const Asset& asset, const Primitive& primitive, const VertexLayout& layout, void* dest,
+		VertexDestination destination = VertexDestination::Cached, const BufferDataAdapter& adapter = {}) {
+	auto* dstBytes = static_cast<std::byte*>(dest);
+	const auto vertexCount = getVertexCount(asset, primitive);
+	if (vertexCount == 0)
+		return 0;
+
+	// Resolve the data of every accessor only once.
+	std::vector<internal::InterleavedAttribute> attributes;
+	attributes.reserve(layout.attributes.size());
+	for (const auto& attributeLayout : layout.attributes) {
+		assert(!isMatrix(attributeLayout.type) && "Vertex attributes cannot be matrices.");
+		assert(attributeLayout.offset + getElementByteSize(attributeLayout.type, attributeLayout.componentType) <= layout.stride
+			&& "The vertex attribute does not fit into the vertex stride.");
+
+		auto& attribute = attributes.emplace_back();
+		attribute.offset = attributeLayout.offset;
+		attribute.componentType = attributeLayout.componentType;
+		attribute.elementSize = getElementByteSize(attributeLayout.type, attributeLayout.componentType);
+
+		const auto* it = primitive.findAttribute(attributeLayout.name);
+		if (it == primitive.attributes.cend())
+			continue;
+
+		const auto& accessor = asset.accessors[it->accessorIndex];
+		assert(accessor.type == attributeLayout.type && "The vertex attribute needs to have the same AccessorType as the accessor.");
+		assert(accessor.count == vertexCount && "All attributes of a primitive need to have the same number of elements.");
+		attribute.accessor = &accessor;
+
+		// 5.1.1. accessor.bufferView
+		// When undefined, the accessor MUST be initialized with zeros; sparse property or extensions
+		// MAY override zeros with actual values.
+		if (accessor.bufferViewIndex) {
+			const auto& view = asset.bufferViews[*accessor.bufferViewIndex];
+			attribute.stride = view.byteStride.value_or(getElementByteSize(accessor.type, accessor.componentType));
+			attribute.bytes = adapter(asset, *accessor.bufferViewIndex).subspan(accessor.byteOffset);
+		}
+
+		if (accessor.sparse && accessor.sparse->count > 0) {
+			const auto& sparse = *accessor.sparse;
+			attribute.indicesBytes = adapter(asset, sparse.indicesBufferView).subspan(sparse.indicesByteOffset);
+			attribute.indexStride = getElementByteSize(AccessorType::Scalar, sparse.indexComponentType);
+			attribute.valuesBytes = adapter(asset, sparse.valuesBufferView).subspan(sparse.valuesByteOffset);
+		}
+	}
+
+	// Roughly a quarter of a typical L2 cache, so that every block stays resident while all of its attributes are written.
+	constexpr std::size_t blockByteSize = 64 * 1024;
+	const auto blockSize = fastgltf::max<std::size_t>(blockByteSize / fastgltf::max<std::size_t>(layout.stride, 1), 1);
+
+	std::vector<std::byte> staging;
+	if (destination == VertexDestination::WriteCombined) {
+		staging.resize(fastgltf::min(blockSize, vertexCount) * layout.stride);
+	}
+
+	for (std::size_t first = 0; first < vertexCount; first += blockSize) {
+		const auto count = fastgltf::min(blockSize, vertexCount - first);
+		auto* block = staging.empty() ? dstBytes + first * layout.stride : staging.data();
+
+		for (auto& attribute : attributes) {
+			auto* out = block + attribute.offset;
+			if (attribute.bytes.empty()) {
+				for (std::size_t i = 0; i < count; ++i) {
+					std::memset(out + i * layout.stride, 0, attribute.elementSize);
+				}
+			} else {
+				const auto& accessor = *attribute.accessor;
+				internal::convertElements(attribute.bytes.data() + first * attribute.stride, attribute.stride, accessor.componentType,
+					accessor.type, out, layout.stride, attribute.componentType, count, accessor.normalized);
+			}
+
+			if (attribute.indicesBytes.empty())
+				continue;
+
+			// The sparse indices are strictly increasing, which lets every block continue where the last one stopped.
+			const auto& accessor = *attribute.accessor;
+			const auto& sparse = *accessor.sparse;
+			const auto valueStride = getElementByteSize(accessor.type, accessor.componentType);
+			for (; attribute.nextSparseValue < sparse.count; ++attribute.nextSparseValue) {
+				const auto i = attribute.nextSparseValue;
+				auto index = internal::getAccessorElementAt<std::uint32_t>(sparse.indexComponentType,
+					&attribute.indicesBytes[attribute.indexStride * i]);
+				if (index >= first + count)
+					break;
+				if (index < first)
+					continue;
+
+				internal::convertElements(&attribute.valuesBytes[valueStride * i], valueStride, accessor.componentType, accessor.type,
+					out + (index - first) * layout.stride, layout.stride, attribute.componentType, 1, accessor.normalized);
+			}
+		}
+
+		if (!staging.empty()) {
+			std::memcpy(dstBytes + first * layout.stride, staging.data(), count * layout.stride);
+		}
+	}
+
+	return vertexCount;
+}
+
+/**
+ * An axis-aligned bounding box. A default constructed box is empty, with min being larger than
+ * max, so that merging anything into it results in the bounds of just that.
+ */
+FASTGLTF_EXPORT struct BoundingBox {
+	math::fvec3 min = math::fvec3(std::numeric_limits<float>::infinity());
+	math::fvec3 max = math::fvec3(-std::numeric_limits<float>::infinity());
+
+	[[nodiscard]] bool empty() const noexcept {
+		return min.x() > max.x() || min.y() > max.y() || min.z() > max.z();
+	}
+
+	void merge(const math::fvec3& point) noexcept {
+		for (std::size_t i = 0; i < 3; ++i) {
+			min[i] = fastgltf::min(min[i], point[i]);
+			max[i] = fastgltf::max(max[i], point[i]);
+		}
+	}
+
+	void merge(const BoundingBox& other) noexcept {
+		for (std::size_t i = 0; i < 3; ++i) {
+			min[i] = fastgltf::min(min[i], other.min[i]);
+			max[i] = fastgltf::max(max[i], other.max[i]);
+		}
+	}
+};
+
+/** Returns the bounding box enclosing the given box after it has been transformed by the matrix. */
+FASTGLTF_EXPORT BoundingBox transformBounds(const BoundingBox& bounds, const math::fmat4x4& matrix) noexcept;
+
+namespace internal {
+/**
+ * Merges count elements with three components into min and max. Float components are processed
+ * directly with the SIMD kernel supported by the CPU, while any other component type is converted
+ * to floats in small batches first, applying the normalization if requested.
+ */
+FASTGLTF_EXPORT void mergeVec3Bounds(const std::byte* src, std::size_t stride, ComponentType componentType, bool normalized,
+		std::size_t count, math::fvec3& min, math::fvec3& max) noexcept;
+
+/** Converts an integer accessor bound into the value it represents when the accessor is normalized. */
+constexpr float normalizeBound(std::int64_t value, ComponentType componentType) {
+	switch (componentType) {
+		case ComponentType::Byte:
+			return fastgltf::max(static_cast<float>(value) / 127.f, -1.f);
+		case ComponentType::UnsignedByte:
+			return static_cast<float>(value) / 255.f;
+		case ComponentType::Short:
+			return fastgltf::max(static_cast<float>(value) / 32767.f, -1.f);
+		case ComponentType::UnsignedShort:
+			return static_cast<float>(value) / 65535.f;
+		default:
+			return static_cast<float>(value);
+	}
+}
+
+/** Reads the min and max properties of a Vec3 accessor, if both are present. */
+inline bool getStoredBounds(const Accessor& accessor, BoundingBox& bounds) {
+	if (!accessor.min || !accessor.max || accessor.min->size() != 3 || accessor.max->size() != 3)
+		return false;
+
+	for (std::size_t i = 0; i < 3; ++i) {
+		if (accessor.min->isType<double>()) {
+			bounds.min[i] = static_cast<float>(accessor.min->get<double>(i));
+		} else {
+			bounds.min[i] = accessor.normalized ? normalizeBound(accessor.min->get<std::int64_t>(i), accessor.componentType)
+				: static_cast<float>(accessor.min->get<std::int64_t>(i));
+		}
+		if (accessor.max->isType<double>()) {
+			bounds.max[i] = static_cast<float>(accessor.max->get<double>(i));
+		} else {
+			bounds.max[i] = accessor.normalized ? normalizeBound(accessor.max->get<std::int64_t>(i), accessor.componentType)
+				: static_cast<float>(accessor.max->get<std::int64_t>(i));
+		}
+	}
+	return true;
+}
+
+template <typename BufferDataAdapter>
+BoundingBox computeVec3Bounds(const Asset& asset, const Accessor& accessor, bool normalized, const BufferDataAdapter& adapter) {
+	assert(accessor.type == AccessorType::Vec3 && "Bounds can only be computed for Vec3 accessors.");
+	BoundingBox bounds;
+
+	// 5.1.1. accessor.bufferView
+	// When undefined, the accessor MUST be initialized with zeros; sparse property or extensions
+	// MAY override zeros with actual values.
+	span<const std::byte> bytes;
+	std::size_t stride = 0;
+	if (accessor.bufferViewIndex) {
+		const auto& view = asset.bufferViews[*accessor.bufferViewIndex];
+		stride = view.byteStride.value_or(getElementByteSize(accessor.type, accessor.componentType));
+		bytes = adapter(asset, *accessor.bufferViewIndex).subspan(accessor.byteOffset);
+	}
+
+	auto mergeDense = [&](std::size_t first, std::size_t last) {
+		if (first >= last)
+			return;
+		if (bytes.empty()) {
+			bounds.merge(math::fvec3(0.f));
+		} else {
+			mergeVec3Bounds(bytes.data() + first * stride, stride, accessor.componentType, normalized, last - first, bounds.min, bounds.max);
+		}
+	};
+
+	if (!accessor.sparse || accessor.sparse->count == 0) {
+		mergeDense(0, accessor.count);
+		return bounds;
+	}
+
+	// The substituted elements must not contribute to the bounds, so only the ranges between the
+	// strictly increasing sparse indices are scanned.
+	const auto& sparse = *accessor.sparse;
+	auto indicesBytes = adapter(asset, sparse.indicesBufferView).subspan(sparse.indicesByteOffset);
+	auto indexStride = getElementByteSize(AccessorType::Scalar, sparse.indexComponentType);
+	auto valuesBytes = adapter(asset, sparse.valuesBufferView).subspan(sparse.valuesByteOffset);
+	auto valueStride = getElementByteSize(accessor.type, accessor.componentType);
+
+	std::size_t next = 0;
+	for (std::size_t i = 0; i < sparse.count; ++i) {
+		auto index = getAccessorElementAt<std::uint32_t>(sparse.indexComponentType, &indicesBytes[indexStride * i]);
+		if (index >= accessor.count)
+			continue;
+
+		mergeDense(next, index);
+		mergeVec3Bounds(&valuesBytes[valueStride * i], valueStride, accessor.componentType, normalized, 1, bounds.min, bounds.max);
+		next = fastgltf::max<std::size_t>(next, index + 1);
+	}
+	mergeDense(next, accessor.count);
+	return bounds;
+}
+} // namespace internal
+
+/**
+ * Computes the bounds of a POSITION accessor by scanning all of its elements, using SIMD kernels.
+ * The accessor's min and max properties are ignored. Normalized positions are converted just like
+ * copyFromAccessor would, and elements substituted by a sparse accessor are replaced by their
+ * sparse values. Returns an empty box for an accessor without elements.
+ */
+FASTGLTF_EXPORT template <typename BufferDataAdapter = DefaultBufferDataAdapter>
+BoundingBox computePositionBounds(const Asset& asset, const Accessor& accessor, const BufferDataAdapter& adapter = {}) {
+	return internal::computeVec3Bounds(asset, accessor, accessor.normalized, adapter);
+}
+
+/**
+ * Computes the local bounds of every mesh in the asset from the POSITION attributes of its
+ * primitives. The min and max properties of the accessors are used if present, and the positions
+ * are only scanned with computePositionBounds otherwise. The primitives are processed using the
+ * executor if one is given, or on the calling thread otherwise. Meshes without positions have an
+ * empty box. Morph targets and skinning are not taken into account.
+ */
+FASTGLTF_EXPORT template <typename BufferDataAdapter = DefaultBufferDataAdapter>
+std::vector<BoundingBox> computeMeshBounds(const Asset& asset, TaskExecutorCallback* executor = nullptr, void* userPointer = nullptr,
+		const BufferDataAdapter& adapter = {}) {
+	struct PrimitiveBounds {
+		std::size_t meshIndex;
+		const Accessor* accessor;
+		BoundingBox bounds;
+	};
+
+	std::vector<BoundingBox> meshBounds(asset.meshes.size());
+	std::vector<PrimitiveBounds> primitives;
+	for (std::size_t i = 0; i < asset.meshes.size(); ++i) {
+		for (const auto& primitive : asset.meshes[i].primitives) {
+			const auto* position = primitive.findAttribute("POSITION");
+			if (position == primitive.attributes.cend())
+				continue;
+
+			const auto& accessor = asset.accessors[position->accessorIndex];
+			if (BoundingBox bounds; internal::getStoredBounds(accessor, bounds)) {
+				meshBounds[i].merge(bounds);
+			} else {
+				primitives.push_back({ i, &accessor, {} });
+			}
+		}
+	}
+
+	struct TaskData {
+		const Asset* asset;
+		const BufferDataAdapter* adapter;
+		PrimitiveBounds* primitives;
+	} taskData { &asset, &adapter, primitives.data() };
+
+	auto task = [](std::size_t taskIndex, void* data) {
+		auto& task = *static_cast<TaskData*>(data);
+		auto& primitive = task.primitives[taskIndex];
+		primitive.bounds = computePositionBounds(*task.asset, *primitive.accessor, *task.adapter);
+	};
+	if (executor != nullptr && primitives.size() > 1) {
+		executor(primitives.size(), task, &taskData, userPointer);
+	} else {
+		for (std::size_t i = 0; i < primitives.size(); ++i) {
+			task(i, &taskData);
+		}
+	}
+
+	for (const auto& primitive : primitives) {
+		meshBounds[primitive.meshIndex].merge(primitive.bounds);
+	}
+	return meshBounds;
+}
 
 /**
  * Computes the transform matrix for a given node, and multiplies the given base with that matrix.
@@ -935,6 +1877,347 @@ void iterateSceneNodes(AssetType&& asset, std::size_t sceneIndex, math::fmat4x4
 	}
 }
 
+/**
+ * Caches the world space transforms of every node within a scene. The node hierarchy is flattened
+ * once into arrays in depth-first order, so that every parent comes before its children and every
+ * subtree is one contiguous range. After changing local transforms, update() only recomputes the
+ * world matrices of the subtrees that were touched, using the SIMD kernels supported by the CPU.
+ */
+FASTGLTF_EXPORT class SceneTransformCache {
+	static constexpr auto noEntry = std::numeric_limits<std::uint32_t>::max();
+
+	// Per-entry data, in depth-first order.
+	std::vector<std::size_t> nodeIndices;
+	std::vector<std::uint32_t> parents;
+	std::vector<std::uint32_t> subtreeEnds;
+	std::vector<std::uint8_t> usesTRS;
+	std::vector<math::fvec3> translations;
+	std::vector<math::fquat> rotations;
+	std::vector<math::fvec3> scales;
+	std::vector<math::fmat4x4> localMatrices;
+	std::vector<math::fmat4x4> worldMatrices;
+
+	// The entry for every node in the asset, or noEntry if it is not part of this scene.
+	std::vector<std::uint32_t> entries;
+	std::vector<std::uint32_t> dirtyEntries;
+	math::fmat4x4 rootMatrix;
+
+	void markDirty(std::size_t nodeIndex);
+
+public:
+	explicit SceneTransformCache(const Asset& asset, std::size_t sceneIndex, const math::fmat4x4& initial = math::fmat4x4());
+
+	/** Returns the number of nodes in this scene. */
+	[[nodiscard]] std::size_t size() const noexcept {
+		return nodeIndices.size();
+	}
+
+	/** Checks if the node with the given index is part of this scene. */
+	[[nodiscard]] bool contains(std::size_t nodeIndex) const noexcept {
+		return nodeIndex < entries.size() && entries[nodeIndex] != noEntry;
+	}
+
+	/**
+	 * Replaces the local transform of a node. The world matrices of the node and its descendants
+	 * are only recomputed by the next call to update().
+	 */
+	void setLocalTransform(std::size_t nodeIndex, const TRS& trs);
+	void setLocalTransform(std::size_t nodeIndex, const math::fmat4x4& matrix);
+
+	/** Replaces the matrix all root nodes of the scene are multiplied with. */
+	void setRootTransform(const math::fmat4x4& matrix);
+
+	/** Recomputes the world matrices of every subtree which had a local transform changed since the last update. */
+	void update();
+
+	/** Returns the world matrix of the given node, as of the last update. */
+	[[nodiscard]] const math::fmat4x4& getWorldMatrix(std::size_t nodeIndex) const noexcept {
+		assert(contains(nodeIndex) && "The node is not part of this scene.");
+		return worldMatrices[entries[nodeIndex]];
+	}
+
+	/** Returns the indices of all nodes of the scene, in the order their world matrices are stored in. */
+	[[nodiscard]] span<const std::size_t> getNodeIndices() const noexcept {
+		return span<const std::size_t>(nodeIndices.data(), nodeIndices.size());
+	}
+
+	/** Returns the world matrices of all nodes, in the same order as getNodeIndices. */
+	[[nodiscard]] span<const math::fmat4x4> getWorldMatrices() const noexcept {
+		return span<const math::fmat4x4>(worldMatrices.data(), worldMatrices.size());
+	}
+};
+
+/**
+ * Samples the channels of an animation. The keyframes of every sampler are decoded into contiguous
+ * float arrays once, and every channel remembers the keyframe it was last sampled at, so that an
+ * animation which is played forwards usually doesn't need to search for its keyframes at all.
+ */
+FASTGLTF_EXPORT class AnimationEvaluator {
+	struct SamplerData {
+		std::size_t inputOffset;
+		std::size_t outputOffset;
+		std::uint32_t keyframeCount;
+		std::uint32_t componentCount;
+		AnimationInterpolation interpolation;
+	};
+
+	struct ChannelData {
+		std::uint32_t samplerIndex;
+		std::uint32_t cursor;
+		std::size_t nodeIndex;
+		AnimationPath path;
+	};
+
+	std::vector<float> inputs;
+	std::vector<float> outputs;
+	std::vector<SamplerData> samplers;
+	std::vector<ChannelData> channels;
+	std::vector<std::size_t> animatedNodes;
+	float startTime = 0.f;
+	float endTime = 0.f;
+
+	// Linearly interpolated rotations are collected while evaluating, and then slerped all at once.
+	std::vector<float> rotationStarts;
+	std::vector<float> rotationEnds;
+	std::vector<float> rotationFactors;
+	std::vector<float> rotationResults;
+	std::vector<std::size_t> rotationTargets;
+
+	void initializeChannels(const Animation& animation);
+	[[nodiscard]] float findKeyframe(ChannelData& channel, float time, std::uint32_t& keyframe) const noexcept;
+	void sampleKeyframes(const ChannelData& channel, std::uint32_t keyframe, float factor, float* output) const noexcept;
+
+public:
+	/**
+	 * Decodes the keyframes of all samplers of the animation. Channels which don't target a node,
+	 * or whose sampler accessors don't match the channel path, are ignored.
+	 */
+	template <typename BufferDataAdapter = DefaultBufferDataAdapter>
+	explicit AnimationEvaluator(const Asset& asset, const Animation& animation, const BufferDataAdapter& adapter = {}) {
+		samplers.reserve(animation.samplers.size());
+		for (const auto& sampler : animation.samplers) {
+			SamplerData data { inputs.size(), outputs.size(), 0, 0, sampler.interpolation };
+			const auto& input = asset.accessors[sampler.inputAccessor];
+			const auto& output = asset.accessors[sampler.outputAccessor];
+
+			// Cubic spline samplers store an in-tangent, the value, and an out-tangent per keyframe.
+			const std::size_t elementsPerKeyframe = sampler.interpolation == AnimationInterpolation::CubicSpline ? 3 : 1;
+			const auto outputComponents = output.count * getNumComponents(output.type);
+			if (input.type == AccessorType::Scalar && input.count > 0 && !isMatrix(output.type)
+					&& outputComponents > 0 && outputComponents % (input.count * elementsPerKeyframe) == 0) {
+				data.keyframeCount = static_cast<std::uint32_t>(input.count);
+				data.componentCount = static_cast<std::uint32_t>(outputComponents / (input.count * elementsPerKeyframe));
+
+				inputs.resize(inputs.size() + input.count);
+				copyComponentsFromAccessor<float>(asset, input, inputs.data() + data.inputOffset, adapter);
+				outputs.resize(outputs.size() + outputComponents);
+				copyComponentsFromAccessor<float>(asset, output, outputs.data() + data.outputOffset, adapter);
+			}
+			samplers.emplace_back(data);
+		}
+
+		initializeChannels(animation);
+	}
+
+	/** Returns the time of the first keyframe of any sampler. */
+	[[nodiscard]] float getStartTime() const noexcept {
+		return startTime;
+	}
+
+	/** Returns the time of the last keyframe of any sampler. */
+	[[nodiscard]] float getEndTime() const noexcept {
+		return endTime;
+	}
+
+	/** Returns the sorted indices of all nodes whose translation, rotation, or scale is animated. */
+	[[nodiscard]] span<const std::size_t> getAnimatedNodes() const noexcept {
+		return span<const std::size_t>(animatedNodes.data(), animatedNodes.size());
+	}
+
+	/** Returns the number of channels which are sampled. This can be less than the channels of the animation. */
+	[[nodiscard]] std::size_t getChannelCount() const noexcept {
+		return channels.size();
+	}
+
+	[[nodiscard]] std::size_t getChannelNode(std::size_t channelIndex) const noexcept {
+		return channels[channelIndex].nodeIndex;
+	}
+
+	[[nodiscard]] AnimationPath getChannelPath(std::size_t channelIndex) const noexcept {
+		return channels[channelIndex].path;
+	}
+
+	/**
+	 * Returns the number of floats written by sampleChannel, which is 3 or 4 for transforms, and
+	 * the number of morph targets for weights.
+	 */
+	[[nodiscard]] std::size_t getChannelComponentCount(std::size_t channelIndex) const noexcept {
+		return samplers[channels[channelIndex].samplerIndex].componentCount;
+	}
+
+	/**
+	 * Samples a single channel at the given time, which is clamped to the keyframes of its sampler.
+	 */
+	void sampleChannel(std::size_t channelIndex, float time, float* output);
+
+	/**
+	 * Samples every translation, rotation, and scale channel at the given time, and writes the result
+	 * into the TRS of the targeted node. The span is indexed by node index, and the components which
+	 * are not animated are left untouched. Weight channels need to be sampled with sampleChannel.
+	 */
+	void evaluate(float time, span<TRS> transforms);
+
+	/**
+	 * Same as above, but also passes the local transforms of all animated nodes to the cache.
+	 * SceneTransformCache::update still needs to be called afterwards.
+	 */
+	void evaluate(float time, span<TRS> transforms, SceneTransformCache& cache);
+};
+
+/**
+ * Computes the joint matrices of every skin in an asset. The inverse bind matrices of all skins
+ * are loaded into one contiguous array once, so that the palettes of all skins can be filled from
+ * the world matrices of a SceneTransformCache in a single pass.
+ */
+FASTGLTF_EXPORT class SkinPalette {
+	std::vector<std::size_t> jointNodes;
+	std::vector<math::fmat4x4> inverseBindMatrices;
+	// The index of the first joint of every skin, with one additional entry for the total count.
+	std::vector<std::size_t> skinOffsets;
+	std::vector<const math::fmat4x4*> jointWorldMatrices;
+
+	void gatherWorldMatrices(const SceneTransformCache& cache);
+
+public:
+	/**
+	 * Loads the inverse bind matrices of all skins. Skins without inverse bind matrices, or whose
+	 * accessor has too few matrices, use identity matrices instead.
+	 */
+	template <typename BufferDataAdapter = DefaultBufferDataAdapter>
+	explicit SkinPalette(const Asset& asset, const BufferDataAdapter& adapter = {}) {
+		skinOffsets.reserve(asset.skins.size() + 1);
+		for (const auto& skin : asset.skins) {
+			const auto offset = jointNodes.size();
+			skinOffsets.emplace_back(offset);
+			jointNodes.insert(jointNodes.end(), skin.joints.begin(), skin.joints.end());
+
+			// Matrices default construct to the identity.
+			inverseBindMatrices.resize(jointNodes.size());
+			if (!skin.inverseBindMatrices)
+				continue;
+
+			const auto& accessor = asset.accessors[*skin.inverseBindMatrices];
+			if (accessor.type != AccessorType::Mat4 || accessor.count < skin.joints.size())
+				continue;
+
+			inverseBindMatrices.resize(offset + accessor.count);
+			copyFromAccessor<math::fmat4x4>(asset, accessor, inverseBindMatrices.data() + offset, adapter);
+			inverseBindMatrices.resize(jointNodes.size());
+		}
+		skinOffsets.emplace_back(jointNodes.size());
+	}
+
+	/** Returns the number of joints of all skins combined, which is the size the palettes need to have. */
+	[[nodiscard]] std::size_t size() const noexcept {
+		return jointNodes.size();
+	}
+
+	/** Returns the index of the first joint matrix of the given skin within the palette. */
+	[[nodiscard]] std::size_t getSkinOffset(std::size_t skinIndex) const noexcept {
+		return skinOffsets[skinIndex];
+	}
+
+	[[nodiscard]] std::size_t getJointCount(std::size_t skinIndex) const noexcept {
+		return skinOffsets[skinIndex + 1] - skinOffsets[skinIndex];
+	}
+
+	[[nodiscard]] span<const math::fmat4x4> getInverseBindMatrices() const noexcept {
+		return span<const math::fmat4x4>(inverseBindMatrices.data(), inverseBindMatrices.size());
+	}
+
+	/**
+	 * Writes the world matrix of every joint multiplied by its inverse bind matrix. Joints which
+	 * are not part of the cached scene use the identity as their world matrix.
+	 */
+	void computeJointMatrices(const SceneTransformCache& cache, span<math::fmat4x4> palette);
+
+	/**
+	 * Same as above, but only writes the upper three rows of every joint matrix. The columns of each
+	 * fmat<4, 3> are the rows of the joint matrix, which is the layout of a row-major 3x4 matrix on the GPU.
+	 */
+	void computeJointMatrices(const SceneTransformCache& cache, span<math::fmat<4, 3>> palette);
+};
+
+/**
+ * A bounding volume hierarchy over the world space bounds of every node with a mesh in a scene,
+ * for culling large scenes. The hierarchy is stored as a flat array of 32-byte nodes in depth-first
+ * order, where the two children of an inner node are always stored next to each other, and the
+ * meshes referenced by each leaf are one contiguous range. It is built using the surface area
+ * heuristic, and can be refitted cheaply after transforms changed, without changing its topology.
+ */
+FASTGLTF_EXPORT class SceneBVH {
+public:
+	struct Node {
+		math::fvec3 min;
+		/** The index of the first child for inner nodes, or of the first item for leaves. */
+		std::uint32_t first;
+		math::fvec3 max;
+		/** The number of items of a leaf, or 0 for inner nodes. */
+		std::uint32_t count;
+	};
+
+private:
+	std::vector<Node> nodes;
+
+	// Per-item data, in the order the leaves reference them.
+	std::vector<std::size_t> nodeIndices;
+	std::vector<BoundingBox> localBounds;
+	std::vector<BoundingBox> worldBounds;
+
+	void refitNodes();
+
+public:
+	/**
+	 * Builds the hierarchy over every node in the cached scene which has a mesh whose bounds are
+	 * not empty. The mesh bounds are indexed by the mesh index, as returned by computeMeshBounds.
+	 */
+	explicit SceneBVH(const Asset& asset, const SceneTransformCache& cache, span<const BoundingBox> meshBounds);
+
+	/** Returns the number of nodes with a mesh which are part of the hierarchy. */
+	[[nodiscard]] std::size_t size() const noexcept {
+		return nodeIndices.size();
+	}
+
+	[[nodiscard]] span<const Node> getNodes() const noexcept {
+		return span<const Node>(nodes.data(), nodes.size());
+	}
+
+	/** Returns the indices of the glTF nodes in the order the leaves reference them. */
+	[[nodiscard]] span<const std::size_t> getNodeIndices() const noexcept {
+		return span<const std::size_t>(nodeIndices.data(), nodeIndices.size());
+	}
+
+	/** Returns the world space bounds of the glTF nodes, in the same order as getNodeIndices. */
+	[[nodiscard]] span<const BoundingBox> getWorldBounds() const noexcept {
+		return span<const BoundingBox>(worldBounds.data(), worldBounds.size());
+	}
+
+	/**
+	 * Recomputes the world bounds from the world matrices of the cache, which has to be the one
+	 * the hierarchy was built with, and refits the hierarchy to them. The quality of the hierarchy
+	 * degrades if nodes move far from where they were when it was built.
+	 */
+	void refit(const SceneTransformCache& cache);
+
+	/**
+	 * Appends the indices of all glTF nodes whose bounds intersect the volume enclosed by the
+	 * planes to visibleNodes. Every plane is given as (normal, distance), and points p with
+	 * dot(normal, p) + distance >= 0 are considered to be inside. Subtrees which are completely
+	 * inside all planes are appended without testing them any further.
+	 */
+	void cull(span<const math::fvec4> planes, std::vector<std::size_t>& visibleNodes) const;
+};
+
 } // namespace fastgltf
 
 #endif
@@ -671,7 +671,8 @@ namespace fastgltf {
             copy(other.begin(), other.size(), begin());
         }
 
-        SmallVector(SmallVector&& other) noexcept : _data(reinterpret_cast<T*>(storage.data())) {
+		// The allocator has to move along with the data, as the memory has to be freed with it.
+        SmallVector(SmallVector&& other) noexcept : allocator(std::move(other.allocator)), _data(reinterpret_cast<T*>(storage.data())) {
             if (other.isUsingStack()) {
                 if (!other.empty()) {
                     resize(other.size());
@@ -1462,6 +1463,13 @@ namespace fastgltf {
 
 		static void decodePercents(std::string& x) noexcept;
 
+		/**
+		 * Creates a URI which only consists of the given local file path. Unlike the constructors,
+		 * this neither decodes percents nor parses the string, so characters like '%', '#', '?' or
+		 * a drive letter's colon stay part of the path.
+		 */
+		[[nodiscard]] static URI fromLocalPath(std::string path) noexcept;
+
 		[[nodiscard]] auto string() const noexcept -> std::string_view;
 		[[nodiscard]] auto c_str() const noexcept -> const char*;
 
@@ -2437,8 +2445,15 @@ namespace fastgltf {
 		// This has to be first in this struct so that it gets destroyed last, leaving all allocations
 		// alive until the end.
 		std::shared_ptr<std::pmr::monotonic_buffer_resource> memoryResource;
+		// Memory resources of the workers used with Options::ParseCategoriesInParallel.
+		std::vector<std::shared_ptr<std::pmr::monotonic_buffer_resource>> workerMemoryResources;
 #endif
 
+		// Keeps the memory sources::ByteView buffers point into alive, when loaded with Options::ZeroCopyGLBBuffer.
+		std::shared_ptr<const std::byte> dataOwner;
+		// Keeps the files shared through an ExternalFileCache alive, which sources::ByteView buffers and images point into.
+		std::vector<std::shared_ptr<const std::byte>> externalFileOwners;
+
 	public:
         /**
          * This will only ever have no value if #Options::DontRequireValidAssetMember was specified.
@@ -2473,7 +2488,10 @@ namespace fastgltf {
         Asset(Asset&& other) noexcept :
 #if !FASTGLTF_DISABLE_CUSTOM_MEMORY_POOL
 				memoryResource(std::move(other.memoryResource)),
+				workerMemoryResources(std::move(other.workerMemoryResources)),
 #endif
+				dataOwner(std::move(other.dataOwner)),
+				externalFileOwners(std::move(other.externalFileOwners)),
 				assetInfo(std::move(other.assetInfo)),
 				extensionsUsed(std::move(other.extensionsUsed)),
 				extensionsRequired(std::move(other.extensionsRequired)),
@@ -2517,14 +2535,27 @@ namespace fastgltf {
 			textures = std::move(other.textures);
 			materialVariants = std::move(other.materialVariants);
 			availableCategories = other.availableCategories;
+			dataOwner = std::move(other.dataOwner);
+			externalFileOwners = std::move(other.externalFileOwners);
 #if !FASTGLTF_DISABLE_CUSTOM_MEMORY_POOL
 			// This needs to be last to not destroy the old memoryResource for the current data.
 			memoryResource = std::move(other.memoryResource);
+			workerMemoryResources = std::move(other.workerMemoryResources);
 #endif
 			return *this;
 		}
     };
 #pragma endregion
+
+	/**
+	 * A task that the parser or the tools want to have executed, which should be invoked with every index in the range [0, taskCount).
+	 */
+	FASTGLTF_EXPORT using ParserTask = void(std::size_t taskIndex, void* taskData);
+	/**
+	 * Callback for handing work to a user-provided job system. The callback has to invoke task(i, taskData) exactly once for
+	 * every i in [0, taskCount), from any thread and in any order, and may only return once all invocations have finished.
+	 */
+	FASTGLTF_EXPORT using TaskExecutorCallback = void(std::size_t taskCount, ParserTask* task, void* taskData, void* userPointer);
 } // namespace fastgltf
 
 #ifdef _MSC_VER
@@ -31,6 +31,7 @@
 #include <array>
 #include <cmath>
 #include <functional>
+#include <string>
 
 #include "simdjson.h"
 
@@ -46,6 +47,9 @@
 #include <smmintrin.h>
 #include <avxintrin.h>
 #include <avx2intrin.h>
+#include <avx512fintrin.h>
+#include <avx512bwintrin.h>
+#include <avx512vbmiintrin.h>
 #else
 #include <intrin.h>
 #endif
@@ -61,6 +65,19 @@
 
 namespace fg = fastgltf;
 
+// clang-format off
+// ASCII value -> base64 value LUT
+static constexpr std::array<std::uint8_t, 128> base64lut = {
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,62,0,0,0,63,
+    52, 53, 54, 55, 56, 57, 58, 59, 60, 61,
+    0,0,0,0,0,0,0,
+    0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,
+    0,0,0,0,0,0,
+    26,27,28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,
+    0,0,0,0,0,
+};
+// clang-format on
+
 namespace fastgltf::base64 {
     using DecodeFunctionInplace = std::function<void(std::string_view, std::uint8_t*, std::size_t)>;
     using DecodeFunction = std::function<fg::StaticVector<std::uint8_t>(std::string_view)>;
@@ -75,7 +92,11 @@ namespace fastgltf::base64 {
             // they load multiple at once.
             const auto& impls = simdjson::get_available_implementations();
 #if defined(FASTGLTF_IS_X86)
-            if (const auto* avx2 = impls["haswell"]; avx2 != nullptr && avx2->supported_by_runtime_system()) {
+            // simdjson's icelake implementation requires AVX-512 BW and VBMI2, and every CPU with VBMI2 also supports VBMI.
+            if (const auto* avx512 = impls["icelake"]; avx512 != nullptr && avx512->supported_by_runtime_system()) {
+                func = avx512_decode;
+                inplace = avx512_decode_inplace;
+            } else if (const auto* avx2 = impls["haswell"]; avx2 != nullptr && avx2->supported_by_runtime_system()) {
                 func = avx2_decode;
                 inplace = avx2_decode_inplace;
             } else if (const auto* sse4 = impls["westmere"]; sse4 != nullptr && sse4->supported_by_runtime_system()) {
@@ -104,9 +125,101 @@ namespace fastgltf::base64 {
             return &getter;
         }
     };
+
+    using EncodeFunctionInplace = std::function<void(span<const std::byte>, char*)>;
+    using EncodeFunction = std::function<std::string(span<const std::byte>)>;
+
+    struct EncodeFunctionGetter {
+        EncodeFunction func;
+        EncodeFunctionInplace inplace;
+
+        explicit EncodeFunctionGetter() {
+            const auto& impls = simdjson::get_available_implementations();
+#if defined(FASTGLTF_IS_X86)
+            if (const auto* avx2 = impls["haswell"]; avx2 != nullptr && avx2->supported_by_runtime_system()) {
+                func = avx2_encode;
+                inplace = avx2_encode_inplace;
+            } else if (const auto* sse4 = impls["westmere"]; sse4 != nullptr && sse4->supported_by_runtime_system()) {
+                func = sse4_encode;
+                inplace = sse4_encode_inplace;
+            }
+#elif defined(FASTGLTF_IS_A64)
+            if (const auto* neon = impls["arm64"]; neon && neon->supported_by_runtime_system()) {
+                func = neon_encode;
+                inplace = neon_encode_inplace;
+            }
+#else
+            if (false) {}
+#endif
+            else {
+                func = fallback_encode;
+                inplace = fallback_encode_inplace;
+            }
+        }
+
+        static EncodeFunctionGetter* get() {
+            static EncodeFunctionGetter getter;
+            return &getter;
+        }
+    };
 } // namespace fastgltf::base64
 
 #if defined(FASTGLTF_IS_X86)
+// The AVX-512 decoding function is based on http://0x80.pl/notesen/2016-04-03-avx512-base64.html,
+// and uses VBMI to translate 64 chars at once using the 128-entry LUT.
+[[gnu::target("avx512f,avx512bw,avx512vbmi")]] void fg::base64::avx512_decode_inplace(std::string_view encoded, std::uint8_t* output, std::size_t padding) {
+    constexpr auto dataSetSize = 64;
+    constexpr auto dataOutputSize = 48;
+
+    const auto encodedSize = encoded.size();
+    if (encodedSize <= dataSetSize) {
+        fallback_decode_inplace(encoded, output, padding);
+        return;
+    }
+
+    // vpermi2b uses the lower 7 bits of every char to select from the two registers.
+    const auto lutLow = _mm512_loadu_si512(base64lut.data());
+    const auto lutHigh = _mm512_loadu_si512(base64lut.data() + 64);
+
+    // Every 32-bit lane holds the 3 decoded bytes in reverse order, which are compacted into 48 bytes.
+    static constexpr std::array<std::uint8_t, 64> packData = {{
+        2,  1,  0,  6,  5,  4, 10,  9,  8, 14, 13, 12,
+        18, 17, 16, 22, 21, 20, 26, 25, 24, 30, 29, 28,
+        34, 33, 32, 38, 37, 36, 42, 41, 40, 46, 45, 44,
+        50, 49, 48, 54, 53, 52, 58, 57, 56, 62, 61, 60,
+    }};
+    const auto pack = _mm512_loadu_si512(packData.data());
+    constexpr auto outputMask = (__mmask64(1) << dataOutputSize) - 1;
+
+    // The last chunk, which possibly contains padding, is always left for the fallback decoder.
+    std::size_t pos = 0;
+    auto* out = output;
+    while ((pos + dataSetSize) < encodedSize) {
+        const auto in = _mm512_loadu_si512(&encoded[pos]);
+        const auto values = _mm512_permutex2var_epi8(lutLow, in, lutHigh);
+        const auto merged = _mm512_madd_epi16(_mm512_maddubs_epi16(values, _mm512_set1_epi32(0x01400140)), _mm512_set1_epi32(0x00011000));
+        // The zero-masking form avoids the undefined pass-through operand of _mm512_permutexvar_epi8, which GCC warns about.
+        const auto packed = _mm512_maskz_permutexvar_epi8(outputMask, pack, merged);
+        _mm512_mask_storeu_epi8(out, outputMask, packed);
+
+        out += dataOutputSize;
+        pos += dataSetSize;
+    }
+
+    // Decode the last chunk traditionally
+    fallback_decode_inplace(encoded.substr(pos, encodedSize - pos), out, padding);
+}
+
+[[gnu::target("avx512f,avx512bw,avx512vbmi")]] fg::StaticVector<std::uint8_t> fg::base64::avx512_decode(std::string_view encoded) {
+    const auto encodedSize = encoded.size();
+    const auto padding = getPadding(encoded);
+
+    fg::StaticVector<std::uint8_t> ret(getOutputSize(encodedSize, padding));
+    avx512_decode_inplace(encoded, ret.data(), padding);
+
+    return ret;
+}
+
 // The AVX and SSE decoding functions are based on http://0x80.pl/notesen/2016-01-17-sse-base64-decoding.html.
 // It covers various methods of en-/decoding base64 using SSE and AVX and also shows their
 // performance metrics.
@@ -268,6 +381,115 @@ namespace fastgltf::base64 {
 
     return ret;
 }
+
+// The AVX and SSE encoding functions are based on http://0x80.pl/notesen/2016-01-12-sse-base64-encoding.html.
+// Every 32-bit lane contains 3 input bytes, arranged as [b1, b0, b2, b1], from which the four
+// 6-bit indices are extracted using two multiplications.
+[[gnu::target("avx2")]] FASTGLTF_FORCEINLINE auto avx2_unpack_indices(const __m256i input) {
+    const auto shuffled = _mm256_shuffle_epi8(input, _mm256_setr_epi8(
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+
+    const auto t0 = _mm256_and_si256(shuffled, _mm256_set1_epi32(0x0fc0fc00));
+    const auto t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+    const auto t2 = _mm256_and_si256(shuffled, _mm256_set1_epi32(0x003f03f0));
+    const auto t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+    return _mm256_or_si256(t1, t3);
+}
+
+[[gnu::target("avx2")]] FASTGLTF_FORCEINLINE auto avx2_lookup_ascii(const __m256i indices) {
+    // Maps the indices 0..63 to a range inside of the LUT, which holds the offset to the ASCII char.
+    const auto shiftLUT = _mm256_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+    auto result = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    const auto less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+    result = _mm256_or_si256(result, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+    return _mm256_add_epi8(_mm256_shuffle_epi8(shiftLUT, result), indices);
+}
+
+[[gnu::target("avx2")]] void fg::base64::avx2_encode_inplace(span<const std::byte> data, char* output) {
+    constexpr auto dataSetSize = 24;
+    constexpr auto dataOutputSize = 32;
+
+    // Each iteration loads 16 bytes at offset 0 and 12, of which only 12 bytes each are used.
+    // This means we need 4 bytes past the 24 bytes to be readable, which the fallback encoder then covers.
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(data.data());
+    std::size_t pos = 0;
+    auto* out = output;
+    while (pos + dataSetSize + 4 <= data.size()) {
+        const auto lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&bytes[pos]));
+        const auto hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&bytes[pos + dataSetSize / 2]));
+        const auto in = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+
+        const auto encoded = avx2_lookup_ascii(avx2_unpack_indices(in));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), encoded);
+
+        out += dataOutputSize;
+        pos += dataSetSize;
+    }
+
+    // Encode the last chunk traditionally
+    fallback_encode_inplace(data.subspan(pos), out);
+}
+
+[[gnu::target("avx2")]] std::string fg::base64::avx2_encode(span<const std::byte> data) {
+    std::string ret(getEncodedSize(data.size()), '\0');
+    avx2_encode_inplace(data, ret.data());
+    return ret;
+}
+
+[[gnu::target("sse4.1")]] FASTGLTF_FORCEINLINE auto sse4_unpack_indices(const __m128i input) {
+    const auto shuffled = _mm_shuffle_epi8(input, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+
+    const auto t0 = _mm_and_si128(shuffled, _mm_set1_epi32(0x0fc0fc00));
+    const auto t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    const auto t2 = _mm_and_si128(shuffled, _mm_set1_epi32(0x003f03f0));
+    const auto t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(t1, t3);
+}
+
+[[gnu::target("sse4.1")]] FASTGLTF_FORCEINLINE auto sse4_lookup_ascii(const __m128i indices) {
+    const auto shiftLUT = _mm_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+    auto result = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    const auto less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    result = _mm_or_si128(result, _mm_and_si128(less, _mm_set1_epi8(13)));
+    return _mm_add_epi8(_mm_shuffle_epi8(shiftLUT, result), indices);
+}
+
+[[gnu::target("sse4.1")]] void fg::base64::sse4_encode_inplace(span<const std::byte> data, char* output) {
+    constexpr auto dataSetSize = 12;
+    constexpr auto dataOutputSize = 16;
+
+    // Each iteration loads 16 bytes, of which only 12 bytes are used.
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(data.data());
+    std::size_t pos = 0;
+    auto* out = output;
+    while (pos + dataSetSize + 4 <= data.size()) {
+        const auto in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&bytes[pos]));
+        const auto encoded = sse4_lookup_ascii(sse4_unpack_indices(in));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), encoded);
+
+        out += dataOutputSize;
+        pos += dataSetSize;
+    }
+
+    // Encode the last chunk traditionally
+    fallback_encode_inplace(data.subspan(pos), out);
+}
+
+[[gnu::target("sse4.1")]] std::string fg::base64::sse4_encode(span<const std::byte> data) {
+    std::string ret(getEncodedSize(data.size()), '\0');
+    sse4_encode_inplace(data, ret.data());
+    return ret;
+}
 #elif defined(FASTGLTF_IS_A64)
 FASTGLTF_FORCEINLINE int8x16_t neon_lookup_pshufb_bitmask(const uint8x16_t input) {
     // clang-format off
@@ -360,21 +582,61 @@ fg::StaticVector<std::uint8_t> fg::base64::neon_decode(std::string_view encoded)
 
     return ret;
 }
-#endif
 
 // clang-format off
-// ASCII value -> base64 value LUT
-static constexpr std::array<std::uint8_t, 128> base64lut = {
-    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,62,0,0,0,63,
-    52, 53, 54, 55, 56, 57, 58, 59, 60, 61,
-    0,0,0,0,0,0,0,
-    0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,
-    0,0,0,0,0,0,
-    26,27,28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51,
-    0,0,0,0,0,
+static constexpr std::array<std::uint8_t, 64> neonEncodeLUT = {
+    'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
+    'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f',
+    'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v',
+    'w', 'x', 'y', 'z', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/',
 };
 // clang-format on
 
+void fg::base64::neon_encode_inplace(span<const std::byte> data, char* output) {
+    constexpr auto dataSetSize = 48;
+    constexpr auto dataOutputSize = 64;
+
+    const uint8x16x4_t lut = {{
+        vld1q_u8(&neonEncodeLUT[0]), vld1q_u8(&neonEncodeLUT[16]),
+        vld1q_u8(&neonEncodeLUT[32]), vld1q_u8(&neonEncodeLUT[48]),
+    }};
+
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(data.data());
+    std::size_t pos = 0;
+    auto* out = reinterpret_cast<std::uint8_t*>(output);
+    while (pos + dataSetSize <= data.size()) {
+        // De-interleave the input, so that each register contains one of the three bytes of every group.
+        const auto in = vld3q_u8(&bytes[pos]);
+        const auto mask = vdupq_n_u8(0x3F);
+
+        uint8x16x4_t indices;
+        indices.val[0] = vshrq_n_u8(in.val[0], 2);
+        indices.val[1] = vandq_u8(vorrq_u8(vshrq_n_u8(in.val[1], 4), vshlq_n_u8(in.val[0], 4)), mask);
+        indices.val[2] = vandq_u8(vorrq_u8(vshrq_n_u8(in.val[2], 6), vshlq_n_u8(in.val[1], 2)), mask);
+        indices.val[3] = vandq_u8(in.val[2], mask);
+
+        uint8x16x4_t encoded;
+        encoded.val[0] = vqtbl4q_u8(lut, indices.val[0]);
+        encoded.val[1] = vqtbl4q_u8(lut, indices.val[1]);
+        encoded.val[2] = vqtbl4q_u8(lut, indices.val[2]);
+        encoded.val[3] = vqtbl4q_u8(lut, indices.val[3]);
+        vst4q_u8(out, encoded);
+
+        out += dataOutputSize;
+        pos += dataSetSize;
+    }
+
+    // Encode the last chunk traditionally
+    fallback_encode_inplace(data.subspan(pos), reinterpret_cast<char*>(out));
+}
+
+std::string fg::base64::neon_encode(span<const std::byte> data) {
+    std::string ret(getEncodedSize(data.size()), '\0');
+    neon_encode_inplace(data, ret.data());
+    return ret;
+}
+#endif
+
 namespace fastgltf::base64 {
     template <typename Output>
 	FASTGLTF_FORCEINLINE void decode_block(std::array<std::uint8_t, 4>& sixBitChars, Output output) {
@@ -436,6 +698,51 @@ fg::StaticVector<std::uint8_t> fg::base64::decode(std::string_view encoded) {
     return DecodeFunctionGetter::get()->func(encoded);
 }
 
+// base64 value -> ASCII value LUT
+static constexpr std::string_view base64chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+void fg::base64::fallback_encode_inplace(span<const std::byte> data, char* output) {
+	const auto* bytes = reinterpret_cast<const std::uint8_t*>(data.data());
+	const auto size = data.size();
+
+	std::size_t pos = 0;
+	for (; pos + 3 <= size; pos += 3) {
+		const auto block = (std::uint32_t(bytes[pos]) << 16U) | (std::uint32_t(bytes[pos + 1]) << 8U) | bytes[pos + 2];
+		output[0] = base64chars[(block >> 18U) & 0x3FU];
+		output[1] = base64chars[(block >> 12U) & 0x3FU];
+		output[2] = base64chars[(block >> 6U) & 0x3FU];
+		output[3] = base64chars[block & 0x3FU];
+		output += 4;
+	}
+
+	// Encode the last one or two bytes and pad the output
+	const auto remaining = size - pos;
+	if (remaining == 0)
+		return;
+
+	auto block = std::uint32_t(bytes[pos]) << 16U;
+	if (remaining == 2)
+		block |= std::uint32_t(bytes[pos + 1]) << 8U;
+	output[0] = base64chars[(block >> 18U) & 0x3FU];
+	output[1] = base64chars[(block >> 12U) & 0x3FU];
+	output[2] = remaining == 2 ? base64chars[(block >> 6U) & 0x3FU] : '=';
+	output[3] = '=';
+}
+
+std::string fg::base64::fallback_encode(span<const std::byte> data) {
+	std::string ret(getEncodedSize(data.size()), '\0');
+	fallback_encode_inplace(data, ret.data());
+	return ret;
+}
+
+void fg::base64::encode_inplace(span<const std::byte> data, char* output) {
+	return EncodeFunctionGetter::get()->inplace(data, output);
+}
+
+std::string fg::base64::encode(span<const std::byte> data) {
+	return EncodeFunctionGetter::get()->func(data);
+}
+
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
@@ -28,9 +28,16 @@
 #error "fastgltf requires C++17"
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
 #include <functional>
 #include <mutex>
+#include <system_error>
+#include <thread>
 #include <utility>
 
 #ifdef _MSC_VER
@@ -49,6 +56,8 @@ static_assert(std::string_view { SIMDJSON_TARGET_VERSION } == SIMDJSON_VERSION,
 
 #include <fastgltf/core.hpp>
 #include <fastgltf/base64.hpp>
+#include <fastgltf/meshopt.hpp>
+#include <fastgltf/tools.hpp>
 
 #if defined(FASTGLTF_IS_X86)
 #include <nmmintrin.h> // SSE4.2 for the CRC-32C instructions
@@ -237,6 +246,28 @@ namespace fastgltf {
 #endif
     }
 
+	/**
+	 * Checks if an extension is enabled. For extensions which were not compiled in, this is false at compile time,
+	 * which lets the compiler remove the code parsing them.
+	 */
+	[[nodiscard, gnu::always_inline]] constexpr bool isExtensionEnabled(Extensions enabledExtensions, Extensions extension) noexcept {
+		return hasBit(compiledExtensions, extension) && hasBit(enabledExtensions, extension);
+	}
+
+	// The extensions handled by parseMaterialExtensions, parsePrimitiveExtensions, and parseTextureExtensions.
+	// When none of them were compiled in, the extension objects are skipped without looking at their keys.
+	static constexpr auto materialExtensions = Extensions::KHR_materials_anisotropy | Extensions::KHR_materials_clearcoat
+		| Extensions::KHR_materials_dispersion | Extensions::KHR_materials_emissive_strength | Extensions::KHR_materials_ior
+		| Extensions::KHR_materials_iridescence | Extensions::KHR_materials_sheen | Extensions::KHR_materials_specular
+		| Extensions::KHR_materials_transmission | Extensions::KHR_materials_diffuse_transmission | Extensions::KHR_materials_unlit
+		| Extensions::KHR_materials_volume | Extensions::MSFT_packing_normalRoughnessMetallic | Extensions::MSFT_packing_occlusionRoughnessMetallic
+#if FASTGLTF_ENABLE_DEPRECATED_EXT
+		| Extensions::KHR_materials_pbrSpecularGlossiness
+#endif
+		;
+	static constexpr auto primitiveExtensions = Extensions::KHR_materials_variants | Extensions::KHR_draco_mesh_compression;
+	static constexpr auto textureExtensions = Extensions::KHR_texture_basisu | Extensions::MSFT_texture_dds | Extensions::EXT_texture_webp;
+
 	[[nodiscard, gnu::always_inline]] inline bool getImageIndexForExtension(const simdjson::dom::element& element, Optional<std::size_t>& imageIndexOut) {
 		using namespace simdjson;
 
@@ -254,25 +285,29 @@ namespace fastgltf {
 	}
 
 	[[nodiscard, gnu::always_inline]] inline bool parseTextureExtensions(Texture& texture, simdjson::dom::object& extensions, Extensions extensionFlags) {
+		if constexpr ((compiledExtensions & textureExtensions) == Extensions::None) {
+			return true;
+		}
+
 		for (auto extension : extensions) {
 			auto hashedKey = crcStringFunction(extension.key);
 			switch (hashedKey) {
 				case force_consteval<crc32c(extensions::KHR_texture_basisu)>: {
-					if (!hasBit(extensionFlags, Extensions::KHR_texture_basisu))
+					if (!isExtensionEnabled(extensionFlags, Extensions::KHR_texture_basisu))
 						break;
 					if (!getImageIndexForExtension(extension.value, texture.basisuImageIndex))
 						return false;
 					break;
 				}
 				case force_consteval<crc32c(extensions::MSFT_texture_dds)>: {
-					if (!hasBit(extensionFlags, Extensions::MSFT_texture_dds))
+					if (!isExtensionEnabled(extensionFlags, Extensions::MSFT_texture_dds))
 						break;
 					if (!getImageIndexForExtension(extension.value, texture.ddsImageIndex))
 						return false;
 					break;
 				}
 				case force_consteval<crc32c(extensions::EXT_texture_webp)>: {
-					if (!hasBit(extensionFlags, Extensions::EXT_texture_webp))
+					if (!isExtensionEnabled(extensionFlags, Extensions::EXT_texture_webp))
 						break;
 					if (!getImageIndexForExtension(extension.value, texture.webpImageIndex))
 						return false;
@@ -347,7 +382,7 @@ namespace fastgltf {
 		dom::object extensionsObject;
 		if (child["extensions"].get_object().get(extensionsObject) == SUCCESS) FASTGLTF_LIKELY {
 			dom::object textureTransform;
-			if (hasBit(extensions, Extensions::KHR_texture_transform) && extensionsObject[extensions::KHR_texture_transform].get_object().get(textureTransform) == SUCCESS) FASTGLTF_LIKELY {
+			if (isExtensionEnabled(extensions, Extensions::KHR_texture_transform) && extensionsObject[extensions::KHR_texture_transform].get_object().get(textureTransform) == SUCCESS) FASTGLTF_LIKELY {
 				auto transform = std::make_unique<TextureTransform>();
 				transform->rotation = 0.0F;
 
@@ -612,6 +647,14 @@ fg::URI& fg::URI::operator=(URI&& other) noexcept {
 	return *this;
 }
 
+fg::URI fg::URI::fromLocalPath(std::string path) noexcept {
+	URI result;
+	result.uri = std::move(path);
+	result.view.view = result.uri;
+	result.view._path = result.uri;
+	return result;
+}
+
 fg::URI::operator fg::URIView() const noexcept {
 	return view;
 }
@@ -686,11 +729,7 @@ fg::Expected<fg::DataSource> fg::Parser::decodeDataUri(URIView& uri) const noexc
         auto size = base64::getOutputSize(encodedData.size(), padding);
         auto info = config.mapCallback(size, config.userPointer);
         if (info.mappedMemory != nullptr) {
-            if (config.decodeCallback != nullptr) {
-                config.decodeCallback(encodedData, reinterpret_cast<std::uint8_t*>(info.mappedMemory), padding, size, config.userPointer);
-            } else {
-                base64::decode_inplace(encodedData, reinterpret_cast<std::uint8_t*>(info.mappedMemory), padding);
-            }
+            decodeBase64(encodedData, reinterpret_cast<std::uint8_t*>(info.mappedMemory), padding, size);
 
             if (config.unmapCallback != nullptr) {
                 config.unmapCallback(&info, config.userPointer);
@@ -706,11 +745,7 @@ fg::Expected<fg::DataSource> fg::Parser::decodeDataUri(URIView& uri) const noexc
 	// Decode the base64 data into a traditional vector
 	auto padding = base64::getPadding(encodedData);
 	fg::StaticVector<std::byte> uriData(base64::getOutputSize(encodedData.size(), padding));
-	if (config.decodeCallback != nullptr) {
-		config.decodeCallback(encodedData, reinterpret_cast<std::uint8_t*>(uriData.data()), padding, uriData.size(), config.userPointer);
-	} else {
-		base64::decode_inplace(encodedData, reinterpret_cast<std::uint8_t*>(uriData.data()), padding);
-	}
+	decodeBase64(encodedData, reinterpret_cast<std::uint8_t*>(uriData.data()), padding, uriData.size());
 
 	sources::Array source {
 		std::move(uriData),
@@ -719,6 +754,49 @@ fg::Expected<fg::DataSource> fg::Parser::decodeDataUri(URIView& uri) const noexc
 	return { std::move(source) };
 }
 
+void fg::Parser::decodeBase64(std::string_view encodedData, std::uint8_t* output, std::size_t padding, std::size_t outputSize) const {
+	if (config.decodeCallback != nullptr) {
+		config.decodeCallback(encodedData, output, padding, outputSize, config.userPointer);
+		return;
+	}
+
+	// The chunk size is a multiple of 4, so that every chunk decodes into its own range of the output.
+	static constexpr std::size_t chunkSize = 1024 * 1024;
+	if (!hasBit(options, Options::DecodeDataUrisInParallel) || encodedData.size() <= 2 * chunkSize) {
+		base64::decode_inplace(encodedData, output, padding);
+		return;
+	}
+
+	struct DecodeContext {
+		std::string_view encodedData;
+		std::uint8_t* output;
+		std::size_t padding;
+	} context { encodedData, output, padding };
+
+	auto* decodeChunk = +[](std::size_t taskIndex, void* taskData) {
+		auto* ctx = static_cast<DecodeContext*>(taskData);
+		const auto offset = taskIndex * chunkSize;
+		const auto chunk = ctx->encodedData.substr(offset, chunkSize);
+
+		// Only the last chunk can contain any padding.
+		const auto padding = offset + chunk.size() == ctx->encodedData.size() ? ctx->padding : 0;
+		base64::decode_inplace(chunk, ctx->output + base64::getOutputSize(offset, 0), padding);
+	};
+
+	const auto taskCount = (encodedData.size() + chunkSize - 1) / chunkSize;
+#ifdef __cpp_exceptions
+	// This is called from decodeDataUri, which is noexcept, so nothing the executor throws may escape.
+	// Decoding a chunk twice writes the same bytes, so simply decode all of it on this thread instead.
+	try {
+		executeTasks(taskCount, decodeChunk, &context);
+	} catch (...) {
+		base64::decode_inplace(encodedData, output, padding);
+	}
+#else
+	executeTasks(taskCount, decodeChunk, &context);
+#endif
+}
+
 void fg::Parser::fillCategories(Category& inputCategories) noexcept {
     if (inputCategories == Category::All)
         return;
@@ -778,12 +856,89 @@ fg::MimeType fg::Parser::getMimeTypeFromString(std::string_view mime) {
     }
 }
 
+namespace fastgltf {
+	/**
+	 * Assigning to a std::pmr container never propagates the allocator of the new value, so the
+	 * target would keep allocating from the default resource instead of the asset's arena. This
+	 * therefore constructs the target in place from the new value, which does keep its allocator.
+	 */
+	template <typename T>
+	void assignWithResource(T& target, T&& value) noexcept {
+		static_assert(std::is_nothrow_move_constructible_v<T>);
+		std::destroy_at(std::addressof(target));
+		::new (static_cast<void*>(std::addressof(target))) T(std::move(value));
+	}
+} // namespace fastgltf
+
+#if FASTGLTF_ENABLE_LOAD_STATISTICS
+namespace fastgltf {
+	/**
+	 * Adds the time until the end of the current scope to the statistics, and reports the
+	 * beginning and end of the scope to the LoadScopeCallback.
+	 */
+	class LoadScopeTimer {
+		const ParserInternalConfig& config;
+		LoadScopeStatistics& statistics;
+		LoadScope scope;
+		Category category;
+		std::chrono::steady_clock::time_point start;
+
+	public:
+		explicit LoadScopeTimer(const ParserInternalConfig& config, LoadScopeStatistics& statistics, LoadScope scope,
+								Category category = Category::None) noexcept
+				: config(config), statistics(statistics), scope(scope), category(category) {
+			if (config.scopeCallback != nullptr)
+				config.scopeCallback(scope, category, true, config.userPointer);
+			start = std::chrono::steady_clock::now();
+		}
+
+		~LoadScopeTimer() noexcept {
+			statistics.duration += std::chrono::steady_clock::now() - start;
+			if (config.scopeCallback != nullptr)
+				config.scopeCallback(scope, category, false, config.userPointer);
+		}
+	};
+
+	void addLoadScopeStatistics(LoadScopeStatistics& target, const LoadScopeStatistics& source) noexcept {
+		target.duration += source.duration;
+		target.bytes += source.bytes;
+		target.count += source.count;
+	}
+
+	/** The number of bytes of a loaded buffer or image which are held in memory. */
+	std::size_t getLoadedByteCount(const DataSource& source) noexcept {
+		return std::visit(visitor {
+			[](const auto&) -> std::size_t {
+				return 0;
+			},
+			[](const sources::Array& array) -> std::size_t {
+				return array.bytes.size_bytes();
+			},
+			[](const sources::Vector& vector) -> std::size_t {
+				return vector.bytes.size();
+			},
+			[](const sources::ByteView& view) -> std::size_t {
+				return view.bytes.size_bytes();
+			},
+		}, source);
+	}
+} // namespace fastgltf
+
+#define FASTGLTF_LOAD_SCOPE_NAME(line) loadScopeTimer##line
+#define FASTGLTF_LOAD_SCOPE_IMPL(line, ...) LoadScopeTimer FASTGLTF_LOAD_SCOPE_NAME(line)(config, __VA_ARGS__)
+#define FASTGLTF_LOAD_SCOPE_EXPAND(line, ...) FASTGLTF_LOAD_SCOPE_IMPL(line, __VA_ARGS__)
+/** Times the rest of the current scope. This compiles to nothing without FASTGLTF_ENABLE_LOAD_STATISTICS. */
+#define FASTGLTF_LOAD_SCOPE(...) FASTGLTF_LOAD_SCOPE_EXPAND(__LINE__, __VA_ARGS__)
+#else
+#define FASTGLTF_LOAD_SCOPE(...)
+#endif
+
 template <typename T> fg::Error fg::Parser::parseAttributes(simdjson::dom::object& object, T& attributes) {
 	using namespace simdjson;
 
 	// We iterate through the JSON object and write each key/pair value into the
 	// attribute map. The keys are only validated in the validate() method.
-	attributes = FASTGLTF_CONSTRUCT_PMR_RESOURCE(std::remove_reference_t<decltype(attributes)>, resourceAllocator.get(), 0);
+	assignWithResource(attributes, FASTGLTF_CONSTRUCT_PMR_RESOURCE(std::remove_reference_t<decltype(attributes)>, resourceAllocator.get(), 0));
 	attributes.reserve(object.size());
 	for (const auto field : object) {
 		const auto key = field.key;
@@ -806,6 +961,269 @@ template <typename T> fg::Error fg::Parser::parseAttributes(simdjson::dom::objec
 template fg::Error fg::Parser::parseAttributes(simdjson::dom::object&, FASTGLTF_STD_PMR_NS::vector<Attribute>&);
 template fg::Error fg::Parser::parseAttributes(simdjson::dom::object&, decltype(fastgltf::Primitive::attributes)&);
 
+namespace fastgltf {
+	/**
+	 * Invokes the task for every index in [0, taskCount), either through the user-provided executor or,
+	 * without one, on a few threads which all take tasks until none are left.
+	 */
+	void runTasks(std::size_t taskCount, ParserTask* task, void* taskData, TaskExecutorCallback* executor, void* userPointer) {
+		if (taskCount == 0)
+			return;
+
+		if (executor != nullptr) {
+			executor(taskCount, task, taskData, userPointer);
+			return;
+		}
+
+		std::atomic<std::size_t> nextTask = 0;
+		auto worker = [&]() {
+			for (auto i = nextTask.fetch_add(1, std::memory_order_relaxed); i < taskCount; i = nextTask.fetch_add(1, std::memory_order_relaxed)) {
+				task(i, taskData);
+			}
+		};
+
+		// Querying the number of threads reads from the file system on some platforms, so it is only done once.
+		static const auto hardwareThreads = max<std::size_t>(1, std::thread::hardware_concurrency());
+		const auto threadCount = min<std::size_t>(taskCount, hardwareThreads);
+		std::vector<std::thread> threads;
+		threads.reserve(threadCount - 1);
+		for (std::size_t i = 1; i < threadCount; ++i) {
+#ifdef __cpp_exceptions
+			try {
+				threads.emplace_back(worker);
+			} catch (const std::system_error&) {
+				// No more threads could be started. The ones that are running take the remaining tasks.
+				break;
+			}
+#else
+			threads.emplace_back(worker);
+#endif
+		}
+		worker();
+		for (auto& thread : threads) {
+			thread.join();
+		}
+	}
+} // namespace fastgltf
+
+void fg::Parser::executeTasks(std::size_t taskCount, ParserTask* task, void* taskData) const {
+	runTasks(taskCount, task, taskData, config.executorCallback, config.userPointer);
+}
+
+struct fg::Parser::DeferredExtras {
+	simdjson::dom::object object;
+	std::size_t objectIndex;
+	Category category;
+};
+
+void fg::Parser::invokeExtrasCallback(simdjson::dom::object& extras, std::size_t objectIndex, Category category) {
+	if (deferredExtras != nullptr) {
+		deferredExtras->push_back({ extras, objectIndex, category });
+		return;
+	}
+	config.extrasCallback(&extras, objectIndex, category, config.userPointer);
+}
+
+bool fg::Parser::reportProgress(LoadPhase phase) {
+	if (config.progressCallback == nullptr)
+		return true;
+	progress.phase = phase;
+	return config.progressCallback(progress, config.userPointer);
+}
+
+fg::Error fg::Parser::loadDeferredFiles(Asset& asset) {
+	if (deferredFileLoads.empty())
+		return Error::None;
+
+	struct LoadContext {
+		Parser* parser;
+		std::atomic_bool failed;
+	} context { this, false };
+
+	executeTasks(deferredFileLoads.size(), [](std::size_t taskIndex, void* taskData) {
+		auto* ctx = static_cast<LoadContext*>(taskData);
+		if (ctx->failed.load(std::memory_order_relaxed)) {
+			// Another file already failed to load, so there's no need to load the rest.
+			return;
+		}
+
+		auto& load = ctx->parser->deferredFileLoads[taskIndex];
+		URIView view(load.uri);
+		auto [error, source] = ctx->parser->loadFileFromUri(view, load.owner);
+		if (error != Error::None) {
+			load.error = error;
+			ctx->failed.store(true, std::memory_order_relaxed);
+			return;
+		}
+		load.source = std::move(source);
+	}, &context);
+
+	// Always return the error of the first file in order, so that the result stays deterministic.
+	for (auto& load : deferredFileLoads) {
+		if (load.error != Error::None) {
+			deferredFileLoads.clear();
+			return load.error;
+		}
+	}
+
+	for (auto& load : deferredFileLoads) {
+#if FASTGLTF_ENABLE_LOAD_STATISTICS
+		loadStatistics.loadExternalFiles.bytes += getLoadedByteCount(load.source);
+		++loadStatistics.loadExternalFiles.count;
+#endif
+		auto& data = load.category == Category::Buffers ? asset.buffers[load.index].data : asset.images[load.index].data;
+		if (!std::holds_alternative<sources::URI>(data))
+			continue;
+		if (load.owner != nullptr) {
+			asset.externalFileOwners.emplace_back(std::move(load.owner));
+		}
+
+		// Carry over the mime type which was parsed from the JSON into the placeholder.
+		const auto mimeType = std::get<sources::URI>(data).mimeType;
+		std::visit([&](auto& arg) {
+			using T = std::decay_t<decltype(arg)>;
+			if constexpr (is_any_of_v<T, sources::CustomBuffer, sources::Array, sources::ByteView>) {
+				arg.mimeType = mimeType;
+			}
+		}, load.source);
+		data = std::move(load.source);
+	}
+	deferredFileLoads.clear();
+	return Error::None;
+}
+
+fg::Error fg::Parser::decodeCompressedBufferViews(Asset& asset) const {
+#if FASTGLTF_ENABLE_MESHOPT_DECODER
+	struct DecodeTask {
+		const CompressedBufferView* compression;
+		span<const std::byte> compressedData;
+		std::size_t bufferIndex;
+		std::size_t byteOffset;
+		std::byte* destination;
+		bool failed;
+	};
+	std::vector<DecodeTask> tasks;
+
+	// Every view needs to decode into a fallback buffer, and source its data from a loaded buffer.
+	std::vector<bool> decodedBuffers(asset.buffers.size(), false);
+	for (auto& view : asset.bufferViews) {
+		if (!view.meshoptCompression)
+			continue;
+
+		const auto& compression = *view.meshoptCompression;
+		if (view.bufferIndex >= asset.buffers.size() || compression.bufferIndex >= asset.buffers.size())
+			return Error::InvalidGltf;
+
+		const auto& buffer = asset.buffers[view.bufferIndex];
+		if (!std::holds_alternative<sources::Fallback>(buffer.data))
+			continue;
+
+		// The count is divided instead of multiplied with the stride, since both come straight from the JSON.
+		if (view.byteOffset > buffer.byteLength || view.byteLength > buffer.byteLength - view.byteOffset
+				|| compression.byteStride == 0 || compression.count > view.byteLength / compression.byteStride)
+			return Error::InvalidGltf;
+
+		const auto compressedData = std::visit(visitor {
+			[](const auto&) -> span<const std::byte> {
+				return {};
+			},
+			[&](const sources::Array& array) -> span<const std::byte> {
+				return span(array.bytes.data(), array.bytes.size_bytes());
+			},
+			[&](const sources::Vector& vec) -> span<const std::byte> {
+				return span(vec.bytes.data(), vec.bytes.size());
+			},
+			[&](const sources::ByteView& bv) -> span<const std::byte> {
+				return bv.bytes;
+			},
+		}, asset.buffers[compression.bufferIndex].data);
+		if (compressedData.data() == nullptr)
+			return Error::MissingExternalBuffer;
+
+		tasks.push_back({ &compression, compressedData, view.bufferIndex, view.byteOffset, nullptr, false });
+		decodedBuffers[view.bufferIndex] = true;
+	}
+
+	if (tasks.empty())
+		return Error::None;
+
+	// The views are decoded in parallel, so no two of them may write to the same bytes of a fallback buffer.
+	std::vector<const DecodeTask*> sortedTasks(tasks.size());
+	for (std::size_t i = 0; i < tasks.size(); ++i)
+		sortedTasks[i] = &tasks[i];
+	std::sort(sortedTasks.begin(), sortedTasks.end(), [](const DecodeTask* a, const DecodeTask* b) {
+		return a->bufferIndex != b->bufferIndex ? a->bufferIndex < b->bufferIndex : a->byteOffset < b->byteOffset;
+	});
+	for (std::size_t i = 1; i < sortedTasks.size(); ++i) {
+		const auto& previous = *sortedTasks[i - 1];
+		if (previous.bufferIndex == sortedTasks[i]->bufferIndex
+				&& previous.byteOffset + previous.compression->count * previous.compression->byteStride > sortedTasks[i]->byteOffset)
+			return Error::InvalidGltf;
+	}
+
+	// Allocate the storage for every fallback buffer once, and then decode directly into it.
+	std::vector<StaticVector<std::byte>> allocations;
+	allocations.reserve(asset.buffers.size());
+	std::vector<BufferInfo> mappings(asset.buffers.size());
+	std::vector<std::byte*> destinations(asset.buffers.size(), nullptr);
+	for (std::size_t i = 0; i < asset.buffers.size(); ++i) {
+		allocations.emplace_back(0);
+		if (!decodedBuffers[i])
+			continue;
+
+		const auto byteLength = asset.buffers[i].byteLength;
+		if (config.mapCallback != nullptr) {
+			mappings[i] = config.mapCallback(byteLength, config.userPointer);
+			destinations[i] = static_cast<std::byte*>(mappings[i].mappedMemory);
+		}
+		if (destinations[i] == nullptr) {
+			allocations[i] = StaticVector<std::byte>(byteLength);
+			destinations[i] = allocations[i].data();
+		}
+
+		// Parts of the buffer which are not covered by any view should not contain garbage.
+		std::memset(destinations[i], 0, byteLength);
+	}
+
+	for (auto& task : tasks) {
+		task.destination = destinations[task.bufferIndex] + task.byteOffset;
+	}
+
+	executeTasks(tasks.size(), [](std::size_t index, void* taskData) {
+		auto& task = (*static_cast<std::vector<DecodeTask>*>(taskData))[index];
+		task.failed = !meshopt::decode(*task.compression, task.compressedData, task.destination);
+	}, &tasks);
+
+	for (std::size_t i = 0; i < asset.buffers.size(); ++i) {
+		if (!decodedBuffers[i])
+			continue;
+
+		auto& buffer = asset.buffers[i];
+		if (mappings[i].mappedMemory != nullptr) {
+			if (config.unmapCallback != nullptr) {
+				config.unmapCallback(&mappings[i], config.userPointer);
+			}
+
+			sources::CustomBuffer source = {};
+			source.id = mappings[i].customId;
+			source.mimeType = MimeType::GltfBuffer;
+			buffer.data = source;
+		} else {
+			buffer.data = sources::Array { std::move(allocations[i]), MimeType::GltfBuffer };
+		}
+	}
+
+	for (const auto& task : tasks) {
+		if (task.failed)
+			return Error::InvalidCompressedData;
+	}
+	return Error::None;
+#else
+	(void)asset;
+	return Error::None;
+#endif
+}
+
 namespace fastgltf {
 	template<typename T>
 	void writeIndices(PrimitiveType type, span<T> indices, std::size_t primitiveCount) {
@@ -859,6 +1277,311 @@ namespace fastgltf {
 	}
 }
 
+namespace fastgltf {
+	/** A single attribute stream of a primitive which is getting welded. */
+	struct WeldStream {
+		std::size_t* accessorIndex;
+		span<const std::byte> bytes;
+		std::size_t stride;
+		std::size_t elementSize;
+		std::size_t outputOffset;
+		std::size_t outputStride;
+	};
+
+	struct WeldedPrimitive {
+		Primitive* primitive;
+		std::size_t vertexCount;
+		std::vector<WeldStream> streams;
+
+		std::size_t uniqueVertexCount = 0;
+		StaticVector<std::byte> vertices { 0 };
+		StaticVector<std::byte> indices { 0 };
+		ComponentType indexComponentType = ComponentType::Invalid;
+	};
+
+	[[nodiscard]] span<const std::byte> getBufferViewData(const Asset& asset, std::size_t bufferViewIndex) {
+		if (bufferViewIndex >= asset.bufferViews.size())
+			return {};
+		const auto& view = asset.bufferViews[bufferViewIndex];
+		if (view.bufferIndex >= asset.buffers.size())
+			return {};
+
+		const auto& buffer = asset.buffers[view.bufferIndex];
+		const auto data = std::visit(visitor {
+			[](const auto&) -> span<const std::byte> {
+				return {};
+			},
+			[&](const sources::Array& array) -> span<const std::byte> {
+				return span(array.bytes.data(), array.bytes.size_bytes());
+			},
+			[&](const sources::Vector& vec) -> span<const std::byte> {
+				return span(vec.bytes.data(), vec.bytes.size());
+			},
+			[&](const sources::ByteView& bv) -> span<const std::byte> {
+				return bv.bytes;
+			},
+		}, buffer.data);
+
+		if (view.byteOffset > data.size() || view.byteLength > data.size() - view.byteOffset)
+			return {};
+		return data.subspan(view.byteOffset, view.byteLength);
+	}
+
+	/**
+	 * Checks that count elements of elementSize bytes, which start at byteOffset and are stride bytes apart, fit into
+	 * byteLength bytes. The counts come straight from the JSON, so the end is never computed by multiplying them.
+	 */
+	[[nodiscard]] constexpr bool elementsFit(std::size_t byteLength, std::size_t byteOffset, std::size_t count, std::size_t stride, std::size_t elementSize) noexcept {
+		if (byteOffset > byteLength)
+			return false;
+		if (count == 0)
+			return true;
+		if (elementSize > byteLength - byteOffset)
+			return false;
+		return stride == 0 || count - 1 <= (byteLength - byteOffset - elementSize) / stride;
+	}
+
+	/**
+	 * Collects the attribute and morph target streams of a primitive. Returns false if any of them
+	 * can't be read directly, for example because they are sparse, or because the buffer was not loaded.
+	 */
+	bool collectWeldStreams(Asset& asset, Primitive& primitive, std::size_t vertexCount, std::vector<WeldStream>& streams) {
+		auto addStream = [&](Attribute& attribute) {
+			if (attribute.accessorIndex >= asset.accessors.size())
+				return false;
+			const auto& accessor = asset.accessors[attribute.accessorIndex];
+			if (accessor.count != vertexCount || !accessor.bufferViewIndex || (accessor.sparse && accessor.sparse->count > 0))
+				return false;
+
+			auto bytes = getBufferViewData(asset, *accessor.bufferViewIndex);
+			const auto elementSize = getElementByteSize(accessor.type, accessor.componentType);
+			const auto stride = asset.bufferViews[*accessor.bufferViewIndex].byteStride.value_or(elementSize);
+			if (bytes.empty() || elementSize == 0 || !elementsFit(bytes.size(), accessor.byteOffset, vertexCount, stride, elementSize))
+				return false;
+
+			streams.push_back({ &attribute.accessorIndex, bytes.subspan(accessor.byteOffset), stride, elementSize, 0, 0 });
+			return true;
+		};
+
+		for (auto& attribute : primitive.attributes) {
+			if (!addStream(attribute))
+				return false;
+		}
+		for (auto& target : primitive.targets) {
+			for (auto& attribute : target) {
+				if (!addStream(attribute))
+					return false;
+			}
+		}
+		return true;
+	}
+
+	[[nodiscard]] std::optional<AccessorBoundsArray> copyBounds(const std::optional<AccessorBoundsArray>& bounds) {
+		if (!bounds.has_value())
+			return std::nullopt;
+
+		AccessorBoundsArray copy(bounds->size(), bounds->type());
+		if (bounds->isType<std::int64_t>()) {
+			std::copy_n(bounds->data<std::int64_t>(), bounds->size(), copy.data<std::int64_t>());
+		} else {
+			std::copy_n(bounds->data<double>(), bounds->size(), copy.data<double>());
+		}
+		return copy;
+	}
+
+	[[nodiscard]] std::uint64_t hashVertex(const std::byte* bytes, std::size_t size) noexcept {
+		// A simple multiplicative hash over 8-byte words, which is plenty for the open-addressing table below.
+		constexpr std::uint64_t multiplier = 0x9E3779B97F4A7C15ULL;
+		std::uint64_t hash = size;
+		for (; size >= sizeof(std::uint64_t); size -= sizeof(std::uint64_t), bytes += sizeof(std::uint64_t)) {
+			std::uint64_t word;
+			std::memcpy(&word, bytes, sizeof word);
+			hash = (hash ^ word) * multiplier;
+			hash ^= hash >> 32;
+		}
+		if (size > 0) {
+			std::uint64_t word = 0;
+			std::memcpy(&word, bytes, size);
+			hash = (hash ^ word) * multiplier;
+			hash ^= hash >> 32;
+		}
+		return hash;
+	}
+
+	/**
+	 * De-duplicates the vertices of a primitive by comparing the bytes of all of its attribute streams.
+	 * The vertex data is only emitted if at least a single vertex was merged.
+	 */
+	void weldPrimitive(WeldedPrimitive& weld) {
+		const auto vertexCount = weld.vertexCount;
+		std::size_t vertexSize = 0;
+		for (auto& stream : weld.streams)
+			vertexSize += stream.elementSize;
+
+		// Gather every vertex into a contiguous key, so that hashing and comparing them is cheap.
+		StaticVector<std::byte> keys(vertexCount * vertexSize);
+		for (std::size_t i = 0; i < vertexCount; ++i) {
+			auto* key = keys.data() + i * vertexSize;
+			for (auto& stream : weld.streams) {
+				std::memcpy(key, &stream.bytes[i * stream.stride], stream.elementSize);
+				key += stream.elementSize;
+			}
+		}
+
+		std::size_t tableSize = 1;
+		while (tableSize < vertexCount * 2)
+			tableSize <<= 1;
+		constexpr auto emptySlot = std::numeric_limits<std::uint32_t>::max();
+		std::vector<std::uint32_t> table(tableSize, emptySlot);
+
+		// For every vertex the index into the welded vertices, and for every welded vertex the first original vertex.
+		std::vector<std::uint32_t> remap(vertexCount);
+		std::vector<std::uint32_t> uniqueVertices;
+		for (std::size_t i = 0; i < vertexCount; ++i) {
+			const auto* key = keys.data() + i * vertexSize;
+			auto slot = static_cast<std::size_t>(hashVertex(key, vertexSize)) & (tableSize - 1);
+			while (true) {
+				const auto existing = table[slot];
+				if (existing == emptySlot) {
+					table[slot] = static_cast<std::uint32_t>(i);
+					remap[i] = static_cast<std::uint32_t>(uniqueVertices.size());
+					uniqueVertices.emplace_back(static_cast<std::uint32_t>(i));
+					break;
+				}
+				if (std::memcmp(keys.data() + existing * vertexSize, key, vertexSize) == 0) {
+					remap[i] = remap[existing];
+					break;
+				}
+				slot = (slot + 1) & (tableSize - 1);
+			}
+		}
+
+		weld.uniqueVertexCount = uniqueVertices.size();
+		if (weld.uniqueVertexCount == vertexCount)
+			return;
+
+		// Vertex attributes have to start at multiples of 4 bytes, so every element is padded to a stride that is a
+		// multiple of 4. This is needed for types like u8vec3 or i16vec3, whose elements are only 3 or 6 bytes large.
+		std::size_t totalSize = 0;
+		for (auto& stream : weld.streams) {
+			stream.outputOffset = totalSize;
+			stream.outputStride = alignUp(stream.elementSize, 4);
+			totalSize += weld.uniqueVertexCount * stream.outputStride;
+		}
+		weld.vertices = StaticVector<std::byte>(totalSize, std::byte(0));
+
+		std::size_t keyOffset = 0;
+		for (auto& stream : weld.streams) {
+			auto* output = weld.vertices.data() + stream.outputOffset;
+			for (std::size_t i = 0; i < weld.uniqueVertexCount; ++i) {
+				std::memcpy(output + i * stream.outputStride, keys.data() + uniqueVertices[i] * vertexSize + keyOffset, stream.elementSize);
+			}
+			keyOffset += stream.elementSize;
+		}
+
+		auto writeRemap = [&](auto type) {
+			using T = decltype(type);
+			weld.indices = StaticVector<std::byte>(vertexCount * sizeof(T));
+			for (std::size_t i = 0; i < vertexCount; ++i) {
+				const auto index = static_cast<T>(remap[i]);
+				std::memcpy(weld.indices.data() + i * sizeof(T), &index, sizeof(T));
+			}
+		};
+		if (weld.uniqueVertexCount < 255) {
+			writeRemap(std::uint8_t {});
+			weld.indexComponentType = ComponentType::UnsignedByte;
+		} else if (weld.uniqueVertexCount < 65535) {
+			writeRemap(std::uint16_t {});
+			weld.indexComponentType = ComponentType::UnsignedShort;
+		} else {
+			writeRemap(std::uint32_t {});
+			weld.indexComponentType = ComponentType::UnsignedInt;
+		}
+	}
+} // namespace fastgltf
+
+fg::Error fg::Parser::weldMeshVertices(Asset& asset) const {
+	std::vector<WeldedPrimitive> welds;
+	for (auto& mesh : asset.meshes) {
+		for (auto& primitive : mesh.primitives) {
+			if (primitive.indicesAccessor.has_value())
+				continue;
+
+			auto* positionAttribute = primitive.findAttribute("POSITION");
+			if (positionAttribute == primitive.attributes.end() || positionAttribute->accessorIndex >= asset.accessors.size()) {
+				return Error::InvalidGltf;
+			}
+
+			WeldedPrimitive weld { &primitive, asset.accessors[positionAttribute->accessorIndex].count, {} };
+			if (weld.vertexCount == 0 || weld.vertexCount >= std::numeric_limits<std::uint32_t>::max())
+				continue;
+			if (!collectWeldStreams(asset, primitive, weld.vertexCount, weld.streams))
+				continue;
+			welds.emplace_back(std::move(weld));
+		}
+	}
+
+	executeTasks(welds.size(), [](std::size_t taskIndex, void* taskData) {
+		weldPrimitive((*static_cast<std::vector<WeldedPrimitive>*>(taskData))[taskIndex]);
+	}, &welds);
+
+	// Appending the new buffers, views, and accessors has to happen on this thread, in a deterministic order.
+	for (auto& weld : welds) {
+		if (weld.indexComponentType == ComponentType::Invalid)
+			continue;
+
+		const auto vertexBufferIndex = asset.buffers.size();
+		auto& vertexBuffer = asset.buffers.emplace_back();
+		vertexBuffer.byteLength = weld.vertices.size_bytes();
+		vertexBuffer.data = sources::Array { std::move(weld.vertices), MimeType::GltfBuffer };
+
+		for (auto& stream : weld.streams) {
+			const auto bufferViewIndex = asset.bufferViews.size();
+			auto& bufferView = asset.bufferViews.emplace_back();
+			bufferView.bufferIndex = vertexBufferIndex;
+			bufferView.byteOffset = stream.outputOffset;
+			bufferView.byteLength = weld.uniqueVertexCount * stream.outputStride;
+			bufferView.byteStride = stream.outputStride;
+
+			// The bounds of the original accessor stay the same, since there are no new values.
+			const auto& original = asset.accessors[*stream.accessorIndex];
+			Accessor accessor = {};
+			accessor.byteOffset = 0;
+			accessor.count = weld.uniqueVertexCount;
+			accessor.type = original.type;
+			accessor.componentType = original.componentType;
+			accessor.normalized = original.normalized;
+			accessor.max = copyBounds(original.max);
+			accessor.min = copyBounds(original.min);
+			accessor.bufferViewIndex = bufferViewIndex;
+			accessor.name = original.name;
+			*stream.accessorIndex = asset.accessors.size();
+			asset.accessors.emplace_back(std::move(accessor));
+		}
+
+		const auto indexBufferIndex = asset.buffers.size();
+		auto& indexBuffer = asset.buffers.emplace_back();
+		indexBuffer.byteLength = weld.indices.size_bytes();
+		indexBuffer.data = sources::Array { std::move(weld.indices), MimeType::GltfBuffer };
+
+		const auto bufferViewIndex = asset.bufferViews.size();
+		auto& bufferView = asset.bufferViews.emplace_back();
+		bufferView.bufferIndex = indexBufferIndex;
+		bufferView.byteOffset = 0;
+		bufferView.byteLength = indexBuffer.byteLength;
+
+		weld.primitive->indicesAccessor = asset.accessors.size();
+		auto& accessor = asset.accessors.emplace_back();
+		accessor.byteOffset = 0;
+		accessor.count = weld.vertexCount;
+		accessor.type = AccessorType::Scalar;
+		accessor.componentType = weld.indexComponentType;
+		accessor.normalized = false;
+		accessor.bufferViewIndex = bufferViewIndex;
+	}
+	return Error::None;
+}
+
 fg::Error fg::Parser::generateMeshIndices(fastgltf::Asset& asset) const {
 	for (auto& mesh : asset.meshes) {
 		for (auto& primitive : mesh.primitives) {
@@ -926,32 +1649,169 @@ fg::Error fg::Parser::generateMeshIndices(fastgltf::Asset& asset) const {
 	return Error::None;
 }
 
-fg::Error fg::validate(const fastgltf::Asset& asset) {
-	auto isExtensionUsed = [&used = asset.extensionsUsed](std::string_view extension) {
-		for (const auto& extensionUsed : used) {
-			if (extension == extensionUsed) {
-				return true;
-			}
+namespace fastgltf {
+	/** Lets the accessor tools read the buffers which have been loaded into memory. */
+	struct LoadedBufferDataAdapter {
+		span<const std::byte> operator()(const Asset& asset, std::size_t bufferViewIndex) const {
+			return getBufferViewData(asset, bufferViewIndex);
 		}
-		return false;
 	};
 
-	// From the spec: extensionsRequired is a subset of extensionsUsed. All values in extensionsRequired MUST also exist in extensionsUsed.
-	if (asset.extensionsRequired.size() > asset.extensionsUsed.size()) {
-		return Error::InvalidGltf;
-	}
-	for (const auto& required : asset.extensionsRequired) {
-		bool found = false;
-		for (const auto& used : asset.extensionsUsed) {
-			if (required == used)
-				found = true;
-		}
-		if (!found)
-			return Error::InvalidGltf;
-	}
+	/** Checks that every element of the accessor, including its sparse indices and values, lies within loaded buffers. */
+	[[nodiscard]] bool canReadAccessor(const Asset& asset, const Accessor& accessor) {
+		auto fits = [&](std::size_t bufferViewIndex, std::size_t byteOffset, std::size_t count, std::size_t stride, std::size_t elementSize) {
+			auto bytes = getBufferViewData(asset, bufferViewIndex);
+			return !bytes.empty() && elementSize != 0 && elementsFit(bytes.size(), byteOffset, count, stride, elementSize);
+		};
 
-	for (const auto& accessor : asset.accessors) {
-		if (accessor.type == AccessorType::Invalid)
+		const auto elementSize = getElementByteSize(accessor.type, accessor.componentType);
+		if (accessor.bufferViewIndex) {
+			if (*accessor.bufferViewIndex >= asset.bufferViews.size())
+				return false;
+			const auto stride = asset.bufferViews[*accessor.bufferViewIndex].byteStride.value_or(elementSize);
+			if (!fits(*accessor.bufferViewIndex, accessor.byteOffset, accessor.count, stride, elementSize))
+				return false;
+		}
+
+		if (accessor.sparse && accessor.sparse->count > 0) {
+			const auto& sparse = *accessor.sparse;
+			const auto indexSize = getElementByteSize(AccessorType::Scalar, sparse.indexComponentType);
+			if (!fits(sparse.indicesBufferView, sparse.indicesByteOffset, sparse.count, indexSize, indexSize)
+					|| !fits(sparse.valuesBufferView, sparse.valuesByteOffset, sparse.count, elementSize, elementSize))
+				return false;
+		}
+		return true;
+	}
+
+	/** Computes the bounds of a POSITION accessor, which are always in terms of the values stored in the buffer. */
+	void computeAccessorBounds(const Asset& asset, Accessor& accessor) {
+		const auto bounds = internal::computeVec3Bounds(asset, accessor, false, LoadedBufferDataAdapter {});
+		if (bounds.empty())
+			return;
+
+		const bool isFloat = accessor.componentType == ComponentType::Float;
+		const auto type = isFloat ? AccessorBoundsArray::BoundsType::float64 : AccessorBoundsArray::BoundsType::int64;
+		AccessorBoundsArray min(3, type), max(3, type);
+		for (std::size_t i = 0; i < 3; ++i) {
+			if (isFloat) {
+				min.set<double>(i, bounds.min[i]);
+				max.set<double>(i, bounds.max[i]);
+			} else {
+				// Integers of up to 16 bits, which are the only ones allowed for positions, are exact as floats.
+				min.set<std::int64_t>(i, static_cast<std::int64_t>(bounds.min[i]));
+				max.set<std::int64_t>(i, static_cast<std::int64_t>(bounds.max[i]));
+			}
+		}
+		accessor.min = std::move(min);
+		accessor.max = std::move(max);
+	}
+} // namespace fastgltf
+
+void fg::Parser::computeMissingBounds(Asset& asset) {
+	std::vector<std::size_t> accessorIndices;
+	auto addAttribute = [&](const Attribute& attribute) {
+		if (attribute.name != "POSITION" || attribute.accessorIndex >= asset.accessors.size())
+			return;
+
+		const auto& accessor = asset.accessors[attribute.accessorIndex];
+		if ((accessor.min && accessor.max) || accessor.type != AccessorType::Vec3 || accessor.count == 0
+				|| accessor.componentType == ComponentType::Double || accessor.componentType == ComponentType::Invalid)
+			return;
+		if (canReadAccessor(asset, accessor))
+			accessorIndices.emplace_back(attribute.accessorIndex);
+	};
+
+	for (const auto& mesh : asset.meshes) {
+		for (const auto& primitive : mesh.primitives) {
+			for (const auto& attribute : primitive.attributes)
+				addAttribute(attribute);
+			for (const auto& target : primitive.targets) {
+				for (const auto& attribute : target)
+					addAttribute(attribute);
+			}
+		}
+	}
+
+	// Accessors may be shared between primitives, and each of them must only be written by one task.
+	std::sort(accessorIndices.begin(), accessorIndices.end());
+	accessorIndices.erase(std::unique(accessorIndices.begin(), accessorIndices.end()), accessorIndices.end());
+
+	struct TaskData {
+		Asset* asset;
+		const std::size_t* accessorIndices;
+	} taskData { &asset, accessorIndices.data() };
+	executeTasks(accessorIndices.size(), [](std::size_t taskIndex, void* data) {
+		auto& task = *static_cast<TaskData*>(data);
+		computeAccessorBounds(*task.asset, task.asset->accessors[task.accessorIndices[taskIndex]]);
+	}, &taskData);
+
+#if FASTGLTF_ENABLE_LOAD_STATISTICS
+	for (auto index : accessorIndices) {
+		const auto& accessor = asset.accessors[index];
+		loadStatistics.computeMissingBounds.bytes += accessor.count * getElementByteSize(accessor.type, accessor.componentType);
+	}
+	loadStatistics.computeMissingBounds.count += accessorIndices.size();
+#endif
+}
+
+namespace fastgltf {
+	/** The extensions of extensionsUsed that fastgltf knows, so that the checks below don't need to compare strings. */
+	[[nodiscard]] Extensions getUsedExtensions(const Asset& asset) {
+		auto used = Extensions::None;
+		for (const auto& extension : asset.extensionsUsed) {
+			for (const auto& [extensionString, extensionEnum] : extensionStrings) {
+				if (extension == extensionString) {
+					used |= extensionEnum;
+					break;
+				}
+			}
+		}
+		return used;
+	}
+
+	// The asset itself is validated as a single object, which includes the extension lists and all lights.
+	[[nodiscard]] Error validateAssetObject(const Asset& asset, Extensions, std::size_t) {
+		// From the spec: extensionsRequired is a subset of extensionsUsed. All values in extensionsRequired MUST also exist in extensionsUsed.
+		if (asset.extensionsRequired.size() > asset.extensionsUsed.size()) {
+			return Error::InvalidGltf;
+		}
+		for (const auto& required : asset.extensionsRequired) {
+			bool found = false;
+			for (const auto& used : asset.extensionsUsed) {
+				if (required == used)
+					found = true;
+			}
+			if (!found)
+				return Error::InvalidGltf;
+		}
+
+		for (const auto& light : asset.lights) {
+			if (light.type == LightType::Directional && light.range.has_value())
+				return Error::InvalidGltf;
+			if (light.range.has_value() && light.range.value() <= 0)
+				return Error::InvalidGltf;
+
+			if (light.type != LightType::Spot) {
+				if (light.innerConeAngle.has_value() || light.outerConeAngle.has_value()) {
+					return Error::InvalidGltf;
+				}
+			} else {
+				if (!light.innerConeAngle.has_value() || !light.outerConeAngle.has_value())
+					return Error::InvalidGltf;
+				if (light.innerConeAngle.value() < 0)
+					return Error::InvalidGltf;
+				if (light.innerConeAngle.value() > light.outerConeAngle.value())
+					return Error::InvalidGltf;
+				if (light.outerConeAngle.value() > math::pi / 2)
+					return Error::InvalidGltf;
+			}
+		}
+		return Error::None;
+	}
+
+	[[nodiscard]] Error validateAccessor(const Asset& asset, Extensions, std::size_t index) {
+		const auto& accessor = asset.accessors[index];
+		if (accessor.type == AccessorType::Invalid)
 			return Error::InvalidGltf;
 		if (accessor.componentType == ComponentType::Invalid)
 			return Error::InvalidGltf;
@@ -998,6 +1858,9 @@ fg::Error fg::validate(const fastgltf::Asset& asset) {
 		}
 
 		if (accessor.sparse) {
+			if (accessor.sparse->indicesBufferView >= asset.bufferViews.size() || accessor.sparse->valuesBufferView >= asset.bufferViews.size())
+				return Error::InvalidGltf;
+
 			const auto& indicesView = asset.bufferViews[accessor.sparse->indicesBufferView];
 			if (indicesView.byteStride || indicesView.target)
 				return Error::InvalidGltf;
@@ -1006,9 +1869,11 @@ fg::Error fg::validate(const fastgltf::Asset& asset) {
 			if (valueView.byteStride || valueView.target)
 				return Error::InvalidGltf;
 		}
+		return Error::None;
 	}
 
-	for (const auto& animation : asset.animations) {
+	[[nodiscard]] Error validateAnimation(const Asset& asset, Extensions, std::size_t index) {
+		const auto& animation = asset.animations[index];
 		if (animation.channels.empty())
 			return Error::InvalidGltf;
 		for (const auto& channel1 : animation.channels) {
@@ -1023,7 +1888,11 @@ fg::Error fg::validate(const fastgltf::Asset& asset) {
 		if (animation.samplers.empty())
 			return Error::InvalidGltf;
 		for (const auto& channel : animation.channels) {
+			if (channel.samplerIndex >= animation.samplers.size())
+				return Error::InvalidGltf;
 			const auto& sampler = animation.samplers[channel.samplerIndex];
+			if (sampler.inputAccessor >= asset.accessors.size() || sampler.outputAccessor >= asset.accessors.size())
+				return Error::InvalidGltf;
 
 			const auto& inputAccessor = asset.accessors[sampler.inputAccessor];
 			// The accessor MUST be of scalar type with floating-point components
@@ -1031,6 +1900,8 @@ fg::Error fg::validate(const fastgltf::Asset& asset) {
 				return Error::InvalidGltf;
 			if (inputAccessor.componentType != ComponentType::Float && inputAccessor.componentType != ComponentType::Double)
 				return Error::InvalidGltf;
+			if (inputAccessor.bufferViewIndex && *inputAccessor.bufferViewIndex >= asset.bufferViews.size())
+				return Error::InvalidGltf;
 			if (inputAccessor.bufferViewIndex && asset.bufferViews[*inputAccessor.bufferViewIndex].meshoptCompression)
 				continue;
 
@@ -1041,6 +1912,8 @@ fg::Error fg::validate(const fastgltf::Asset& asset) {
 				continue; // TODO: For weights, the input count needs to be multiplied by the morph target count.
 
 			const auto& outputAccessor = asset.accessors[sampler.outputAccessor];
+			if (outputAccessor.bufferViewIndex && *outputAccessor.bufferViewIndex >= asset.bufferViews.size())
+				return Error::InvalidGltf;
 			if (outputAccessor.bufferViewIndex && asset.bufferViews[*outputAccessor.bufferViewIndex].meshoptCompression)
 				continue;
 
@@ -1058,14 +1931,17 @@ fg::Error fg::validate(const fastgltf::Asset& asset) {
 					break;
 			}
 		}
+		return Error::None;
 	}
 
-	for (const auto& buffer : asset.buffers) {
-		if (buffer.byteLength < 1)
+	[[nodiscard]] Error validateBuffer(const Asset& asset, Extensions, std::size_t index) {
+		if (asset.buffers[index].byteLength < 1)
 			return Error::InvalidGltf;
+		return Error::None;
 	}
 
-	for (const auto& bufferView : asset.bufferViews) {
+	[[nodiscard]] Error validateBufferView(const Asset& asset, Extensions usedExtensions, std::size_t index) {
+		const auto& bufferView = asset.bufferViews[index];
 		if (bufferView.byteLength < 1)
 			return Error::InvalidGltf;
 		if (bufferView.byteStride.has_value() && (*bufferView.byteStride < 4U || *bufferView.byteStride > 252U || *bufferView.byteStride % 4 != 0))
@@ -1073,7 +1949,7 @@ fg::Error fg::validate(const fastgltf::Asset& asset) {
 		if (bufferView.bufferIndex >= asset.buffers.size())
 			return Error::InvalidGltf;
 
-		if (bufferView.meshoptCompression != nullptr && !isExtensionUsed(extensions::EXT_meshopt_compression))
+		if (bufferView.meshoptCompression != nullptr && !hasBit(usedExtensions, Extensions::EXT_meshopt_compression))
 			return Error::InvalidGltf;
 
 		if (bufferView.meshoptCompression) {
@@ -1093,9 +1969,11 @@ fg::Error fg::validate(const fastgltf::Asset& asset) {
 					break;
 			}
 		}
+		return Error::None;
 	}
 
-	for (const auto& camera : asset.cameras) {
+	[[nodiscard]] Error validateCamera(const Asset& asset, Extensions, std::size_t index) {
+		const auto& camera = asset.cameras[index];
 		if (const auto* pOrthographic = std::get_if<Camera::Orthographic>(&camera.camera)) {
 			if (pOrthographic->zfar == 0)
 				return Error::InvalidGltf;
@@ -1109,39 +1987,20 @@ fg::Error fg::validate(const fastgltf::Asset& asset) {
 			if (pPerspective->znear == 0.0F)
 				return Error::InvalidGltf;
 		}
+		return Error::None;
 	}
 
-	for (const auto& image : asset.images) {
-		if (const auto* view = std::get_if<sources::BufferView>(&image.data); view != nullptr) {
+	[[nodiscard]] Error validateImage(const Asset& asset, Extensions, std::size_t index) {
+		if (const auto* view = std::get_if<sources::BufferView>(&asset.images[index].data); view != nullptr) {
 			if (view->bufferViewIndex >= asset.bufferViews.size()) {
 				return Error::InvalidGltf;
 			}
 		}
+		return Error::None;
 	}
 
-	for (const auto& light : asset.lights) {
-		if (light.type == LightType::Directional && light.range.has_value())
-			return Error::InvalidGltf;
-		if (light.range.has_value() && light.range.value() <= 0)
-			return Error::InvalidGltf;
-
-		if (light.type != LightType::Spot) {
-			if (light.innerConeAngle.has_value() || light.outerConeAngle.has_value()) {
-				return Error::InvalidGltf;
-			}
-		} else {
-			if (!light.innerConeAngle.has_value() || !light.outerConeAngle.has_value())
-				return Error::InvalidGltf;
-			if (light.innerConeAngle.value() < 0)
-				return Error::InvalidGltf;
-			if (light.innerConeAngle.value() > light.outerConeAngle.value())
-				return Error::InvalidGltf;
-			if (light.outerConeAngle.value() > math::pi / 2)
-				return Error::InvalidGltf;
-		}
-	}
-
-	for (const auto& material : asset.materials) {
+	[[nodiscard]] Error validateMaterial(const Asset& asset, Extensions usedExtensions, std::size_t index) {
+		const auto& material = asset.materials[index];
 		auto isInvalidTexture = [&textures = asset.textures](std::optional<std::size_t> textureIndex) {
 			return textureIndex.has_value() && textureIndex.value() >= textures.size();
 		};
@@ -1159,43 +2018,145 @@ fg::Error fg::validate(const fastgltf::Asset& asset) {
 			return Error::InvalidGltf;
 
 		// Validate that for every additional material field from an extension the correct extension is marked as used by the asset.
-		if (material.anisotropy && !isExtensionUsed(extensions::KHR_materials_anisotropy))
+		auto isExtensionUsed = [usedExtensions](Extensions extension) {
+			return hasBit(usedExtensions, extension);
+		};
+		if (material.anisotropy && !isExtensionUsed(Extensions::KHR_materials_anisotropy))
 			return Error::InvalidGltf;
-		if (material.clearcoat && !isExtensionUsed(extensions::KHR_materials_clearcoat))
+		if (material.clearcoat && !isExtensionUsed(Extensions::KHR_materials_clearcoat))
 			return Error::InvalidGltf;
-		if (material.iridescence && !isExtensionUsed(extensions::KHR_materials_iridescence))
+		if (material.iridescence && !isExtensionUsed(Extensions::KHR_materials_iridescence))
 			return Error::InvalidGltf;
-		if (material.sheen && !isExtensionUsed(extensions::KHR_materials_sheen))
+		if (material.sheen && !isExtensionUsed(Extensions::KHR_materials_sheen))
 			return Error::InvalidGltf;
-		if (material.specular && !isExtensionUsed(extensions::KHR_materials_specular))
+		if (material.specular && !isExtensionUsed(Extensions::KHR_materials_specular))
 			return Error::InvalidGltf;
 #if FASTGLTF_ENABLE_DEPRECATED_EXT
-		if (material.specularGlossiness && !isExtensionUsed(extensions::KHR_materials_pbrSpecularGlossiness))
+		if (material.specularGlossiness && !isExtensionUsed(Extensions::KHR_materials_pbrSpecularGlossiness))
 			return Error::InvalidGltf;
 #endif
-		if (material.transmission && !isExtensionUsed(extensions::KHR_materials_transmission))
+		if (material.transmission && !isExtensionUsed(Extensions::KHR_materials_transmission))
 			return Error::InvalidGltf;
-		if (material.diffuseTransmission && !isExtensionUsed(extensions::KHR_materials_diffuse_transmission))
+		if (material.diffuseTransmission && !isExtensionUsed(Extensions::KHR_materials_diffuse_transmission))
 			return Error::InvalidGltf;
-		if (material.volume && !isExtensionUsed(extensions::KHR_materials_volume))
+		if (material.volume && !isExtensionUsed(Extensions::KHR_materials_volume))
 			return Error::InvalidGltf;
-		if (material.emissiveStrength != 1.0f && !isExtensionUsed(extensions::KHR_materials_emissive_strength))
+		if (material.emissiveStrength != 1.0f && !isExtensionUsed(Extensions::KHR_materials_emissive_strength))
 			return Error::InvalidGltf;
-		if (material.ior != 1.5f && !isExtensionUsed(extensions::KHR_materials_ior))
+		if (material.ior != 1.5f && !isExtensionUsed(Extensions::KHR_materials_ior))
 			return Error::InvalidGltf;
-		if (material.packedNormalMetallicRoughnessTexture && !isExtensionUsed(extensions::MSFT_packing_normalRoughnessMetallic))
+		if (material.packedNormalMetallicRoughnessTexture && !isExtensionUsed(Extensions::MSFT_packing_normalRoughnessMetallic))
 			return Error::InvalidGltf;
-		if (material.packedOcclusionRoughnessMetallicTextures && !isExtensionUsed(extensions::MSFT_packing_occlusionRoughnessMetallic))
+		if (material.packedOcclusionRoughnessMetallicTextures && !isExtensionUsed(Extensions::MSFT_packing_occlusionRoughnessMetallic))
 			return Error::InvalidGltf;
+		return Error::None;
 	}
 
-	for (const auto& mesh : asset.meshes) {
-		for (const auto& primitive : mesh.primitives) {
+	[[nodiscard]] Error validatePrimitiveAttribute(std::string_view name, const Accessor& accessor, bool meshQuantization) {
+		// The spec provides a list of attributes that it accepts and mentions that all
+		// custom attributes have to start with an underscore. We'll enforce this.
+		if (!startsWith(name, "_")) {
+			if (name != "POSITION" && name != "NORMAL" && name != "TANGENT" &&
+			    !startsWith(name, "TEXCOORD_") && !startsWith(name, "COLOR_") &&
+			    !startsWith(name, "JOINTS_") && !startsWith(name, "WEIGHTS_")) {
+				return Error::InvalidGltf;
+			}
+		}
+
+		// https://registry.khronos.org/glTF/specs/2.0/glTF-2.0.html#meshes-overview
+		if (name == "POSITION") {
+			// Animation input and vertex position attribute accessors MUST have accessor.min and accessor.max defined.
+			if (!accessor.max.has_value() || !accessor.min.has_value())
+				return Error::InvalidGltf;
+			if (accessor.type != AccessorType::Vec3)
+				return Error::InvalidGltf;
+			if (!meshQuantization) {
+				if (accessor.componentType != ComponentType::Float)
+					return Error::InvalidGltf;
+			} else {
+				if (accessor.componentType == ComponentType::Double || accessor.componentType == ComponentType::UnsignedInt)
+					return Error::InvalidGltf;
+			}
+		} else if (name == "NORMAL") {
+			if (accessor.type != AccessorType::Vec3)
+				return Error::InvalidGltf;
+			if (!meshQuantization) {
+				if (accessor.componentType != ComponentType::Float)
+					return Error::InvalidGltf;
+			} else {
+				if (accessor.componentType != ComponentType::Float &&
+				    accessor.componentType != ComponentType::Short &&
+				    accessor.componentType != ComponentType::Byte)
+					return Error::InvalidGltf;
+			}
+		} else if (name == "TANGENT") {
+			if (accessor.type != AccessorType::Vec4)
+				return Error::InvalidGltf;
+			if (!meshQuantization) {
+				if (accessor.componentType != ComponentType::Float)
+					return Error::InvalidGltf;
+			} else {
+				if (accessor.componentType != ComponentType::Float &&
+				    accessor.componentType != ComponentType::Short &&
+				    accessor.componentType != ComponentType::Byte)
+					return Error::InvalidGltf;
+			}
+		} else if (startsWith(name, "TEXCOORD_")) {
+			if (accessor.type != AccessorType::Vec2)
+				return Error::InvalidGltf;
+			if (!meshQuantization) {
+				if (accessor.componentType != ComponentType::Float &&
+				    accessor.componentType != ComponentType::UnsignedByte &&
+				    accessor.componentType != ComponentType::UnsignedShort) {
+					return Error::InvalidGltf;
+				}
+			} else {
+				if (accessor.componentType == ComponentType::Double ||
+				    accessor.componentType == ComponentType::UnsignedInt) {
+					return Error::InvalidGltf;
+				}
+			}
+		} else if (startsWith(name, "COLOR_")) {
+			if (accessor.type != AccessorType::Vec3 && accessor.type != AccessorType::Vec4)
+				return Error::InvalidGltf;
+			if (accessor.componentType != ComponentType::Float &&
+			    accessor.componentType != ComponentType::UnsignedByte &&
+			    accessor.componentType != ComponentType::UnsignedShort) {
+				return Error::InvalidGltf;
+			}
+		} else if (startsWith(name, "JOINTS_")) {
+			if (accessor.type != AccessorType::Vec4)
+				return Error::InvalidGltf;
+			if (accessor.componentType != ComponentType::UnsignedByte &&
+			    accessor.componentType != ComponentType::UnsignedShort) {
+				return Error::InvalidGltf;
+			}
+		} else if (startsWith(name, "WEIGHTS_")) {
+			if (accessor.type != AccessorType::Vec4)
+				return Error::InvalidGltf;
+			if (accessor.componentType != ComponentType::Float &&
+			    accessor.componentType != ComponentType::UnsignedByte &&
+			    accessor.componentType != ComponentType::UnsignedShort) {
+				return Error::InvalidGltf;
+			}
+		} else if (startsWith(name, "_")) {
+			// Application-specific attribute semantics MUST start with an underscore, e.g., _TEMPERATURE.
+			// Application-specific attribute semantics MUST NOT use unsigned int component type.
+			if (accessor.componentType == ComponentType::UnsignedInt) {
+				return Error::InvalidGltf;
+			}
+		}
+		return Error::None;
+	}
+
+	[[nodiscard]] Error validateMesh(const Asset& asset, Extensions usedExtensions, std::size_t index) {
+		const bool meshQuantization = hasBit(usedExtensions, Extensions::KHR_mesh_quantization);
+		for (const auto& primitive : asset.meshes[index].primitives) {
 			if (primitive.materialIndex.has_value() && *primitive.materialIndex >= asset.materials.size())
 				return Error::InvalidGltf;
 
 			if (!primitive.mappings.empty()) {
-				if (!isExtensionUsed(fastgltf::extensions::KHR_materials_variants))
+				if (!hasBit(usedExtensions, Extensions::KHR_materials_variants))
 					return Error::InvalidGltf;
 				if (primitive.mappings.size() != asset.materialVariants.size())
 					return Error::InvalidGltf;
@@ -1212,6 +2173,8 @@ fg::Error fg::validate(const fastgltf::Asset& asset) {
 					return Error::InvalidGltf;
 				const auto& accessor = asset.accessors[*primitive.indicesAccessor];
 				if (accessor.bufferViewIndex.has_value()) {
+					if (*accessor.bufferViewIndex >= asset.bufferViews.size())
+						return Error::InvalidGltf;
 					const auto& bufferView = asset.bufferViews[*accessor.bufferViewIndex];
 					// The byteStride property must not be set on anything but vertex attributes.
 					if (bufferView.byteStride.has_value())
@@ -1219,109 +2182,18 @@ fg::Error fg::validate(const fastgltf::Asset& asset) {
 				}
 			}
 
-			for (const auto& [name, index] : primitive.attributes) {
-				if (asset.accessors.size() <= index)
+			for (const auto& [name, accessorIndex] : primitive.attributes) {
+				if (asset.accessors.size() <= accessorIndex)
 					return Error::InvalidGltf;
-
-				// The spec provides a list of attributes that it accepts and mentions that all
-				// custom attributes have to start with an underscore. We'll enforce this.
-				if (!startsWith(name, "_")) {
-					if (name != "POSITION" && name != "NORMAL" && name != "TANGENT" &&
-					    !startsWith(name, "TEXCOORD_") && !startsWith(name, "COLOR_") &&
-					    !startsWith(name, "JOINTS_") && !startsWith(name, "WEIGHTS_")) {
-						return Error::InvalidGltf;
-					}
-				}
-
-				// https://registry.khronos.org/glTF/specs/2.0/glTF-2.0.html#meshes-overview
-				const auto& accessor = asset.accessors[index];
-				if (name == "POSITION") {
-					// Animation input and vertex position attribute accessors MUST have accessor.min and accessor.max defined.
-					if (!accessor.max.has_value() || !accessor.min.has_value())
-						return Error::InvalidGltf;
-					if (accessor.type != AccessorType::Vec3)
-						return Error::InvalidGltf;
-					if (!isExtensionUsed(extensions::KHR_mesh_quantization)) {
-						if (accessor.componentType != ComponentType::Float)
-							return Error::InvalidGltf;
-					} else {
-						if (accessor.componentType == ComponentType::Double || accessor.componentType == ComponentType::UnsignedInt)
-							return Error::InvalidGltf;
-					}
-				} else if (name == "NORMAL") {
-					if (accessor.type != AccessorType::Vec3)
-						return Error::InvalidGltf;
-					if (!isExtensionUsed(extensions::KHR_mesh_quantization)) {
-						if (accessor.componentType != ComponentType::Float)
-							return Error::InvalidGltf;
-					} else {
-						if (accessor.componentType != ComponentType::Float &&
-						    accessor.componentType != ComponentType::Short &&
-						    accessor.componentType != ComponentType::Byte)
-							return Error::InvalidGltf;
-					}
-				} else if (name == "TANGENT") {
-					if (accessor.type != AccessorType::Vec4)
-						return Error::InvalidGltf;
-					if (!isExtensionUsed(extensions::KHR_mesh_quantization)) {
-						if (accessor.componentType != ComponentType::Float)
-							return Error::InvalidGltf;
-					} else {
-						if (accessor.componentType != ComponentType::Float &&
-						    accessor.componentType != ComponentType::Short &&
-						    accessor.componentType != ComponentType::Byte)
-							return Error::InvalidGltf;
-					}
-				} else if (startsWith(name, "TEXCOORD_")) {
-					if (accessor.type != AccessorType::Vec2)
-						return Error::InvalidGltf;
-					if (!isExtensionUsed(extensions::KHR_mesh_quantization)) {
-						if (accessor.componentType != ComponentType::Float &&
-						    accessor.componentType != ComponentType::UnsignedByte &&
-						    accessor.componentType != ComponentType::UnsignedShort) {
-							return Error::InvalidGltf;
-						}
-					} else {
-						if (accessor.componentType == ComponentType::Double ||
-						    accessor.componentType == ComponentType::UnsignedInt) {
-							return Error::InvalidGltf;
-						}
-					}
-				} else if (startsWith(name, "COLOR_")) {
-					if (accessor.type != AccessorType::Vec3 && accessor.type != AccessorType::Vec4)
-						return Error::InvalidGltf;
-					if (accessor.componentType != ComponentType::Float &&
-					    accessor.componentType != ComponentType::UnsignedByte &&
-					    accessor.componentType != ComponentType::UnsignedShort) {
-						return Error::InvalidGltf;
-					}
-				} else if (startsWith(name, "JOINTS_")) {
-					if (accessor.type != AccessorType::Vec4)
-						return Error::InvalidGltf;
-					if (accessor.componentType != ComponentType::UnsignedByte &&
-					    accessor.componentType != ComponentType::UnsignedShort) {
-						return Error::InvalidGltf;
-					}
-				} else if (startsWith(name, "WEIGHTS_")) {
-					if (accessor.type != AccessorType::Vec4)
-						return Error::InvalidGltf;
-					if (accessor.componentType != ComponentType::Float &&
-					    accessor.componentType != ComponentType::UnsignedByte &&
-					    accessor.componentType != ComponentType::UnsignedShort) {
-						return Error::InvalidGltf;
-					}
-				} else if (startsWith(name, "_")) {
-					// Application-specific attribute semantics MUST start with an underscore, e.g., _TEMPERATURE.
-					// Application-specific attribute semantics MUST NOT use unsigned int component type.
-					if (accessor.componentType == ComponentType::UnsignedInt) {
-						return Error::InvalidGltf;
-					}
-				}
+				if (auto error = validatePrimitiveAttribute(name, asset.accessors[accessorIndex], meshQuantization); error != Error::None)
+					return error;
 			}
 		}
+		return Error::None;
 	}
 
-	for (const auto& node : asset.nodes) {
+	[[nodiscard]] Error validateNode(const Asset& asset, Extensions, std::size_t index) {
+		const auto& node = asset.nodes[index];
 		if (node.cameraIndex.has_value() && asset.cameras.size() <= node.cameraIndex.value())
 			return Error::InvalidGltf;
 		if (node.skinIndex.has_value() && asset.skins.size() <= node.skinIndex.value())
@@ -1354,35 +2226,42 @@ fg::Error fg::validate(const fastgltf::Asset& asset) {
 					return Error::InvalidGltf;
 			}
 		}
+		return Error::None;
 	}
 
-	for (const auto& sampler : asset.samplers) {
+	[[nodiscard]] Error validateSampler(const Asset& asset, Extensions, std::size_t index) {
+		const auto& sampler = asset.samplers[index];
 		if (sampler.magFilter.has_value() && (sampler.magFilter != Filter::Nearest && sampler.magFilter != Filter::Linear)) {
 			return Error::InvalidGltf;
 		}
+		return Error::None;
 	}
 
-	for (const auto& scene : asset.scenes) {
-		for (const auto& node : scene.nodeIndices) {
+	[[nodiscard]] Error validateScene(const Asset& asset, Extensions, std::size_t index) {
+		for (const auto& node : asset.scenes[index].nodeIndices) {
 			if (node >= asset.nodes.size())
 				return Error::InvalidGltf;
 		}
+		return Error::None;
 	}
 
-	for (const auto& skin : asset.skins) {
+	[[nodiscard]] Error validateSkin(const Asset& asset, Extensions, std::size_t index) {
+		const auto& skin = asset.skins[index];
 		if (skin.joints.empty())
 			return Error::InvalidGltf;
 		if (skin.skeleton.has_value() && skin.skeleton.value() >= asset.nodes.size())
 			return Error::InvalidGltf;
 		if (skin.inverseBindMatrices.has_value() && skin.inverseBindMatrices.value() >= asset.accessors.size())
 			return Error::InvalidGltf;
+		return Error::None;
 	}
 
-	for (const auto& texture : asset.textures) {
+	[[nodiscard]] Error validateTexture(const Asset& asset, Extensions usedExtensions, std::size_t index) {
+		const auto& texture = asset.textures[index];
 		if (texture.samplerIndex.has_value() && texture.samplerIndex.value() >= asset.samplers.size())
 			return Error::InvalidGltf;
 		// imageIndex needs to be defined, unless one of the texture extensions were enabled and define another image index.
-		if (isExtensionUsed(extensions::KHR_texture_basisu) || isExtensionUsed(extensions::MSFT_texture_dds) || isExtensionUsed(extensions::EXT_texture_webp)) {
+		if ((usedExtensions & (Extensions::KHR_texture_basisu | Extensions::MSFT_texture_dds | Extensions::EXT_texture_webp)) != Extensions::None) {
 			if (!texture.imageIndex.has_value() && (!texture.basisuImageIndex.has_value() && !texture.ddsImageIndex.has_value() && !texture.webpImageIndex.has_value())) {
 				return Error::InvalidGltf;
 			}
@@ -1397,89 +2276,395 @@ fg::Error fg::validate(const fastgltf::Asset& asset) {
 			return Error::InvalidGltf;
 		if (texture.webpImageIndex.has_value() && texture.webpImageIndex.value() >= asset.images.size())
 			return Error::InvalidGltf;
+		return Error::None;
 	}
 
-	return Error::None;
-}
-
-fg::Expected<fg::Asset> fg::Parser::parse(simdjson::dom::object root, Category categories) {
-	using namespace simdjson;
-	fillCategories(categories);
-
-	Asset asset {};
+	// The order in which the categories are validated, and in which their errors are reported.
+	static constexpr std::array<Category, AssetValidator::categoryCount> validationOrder = {
+		Category::Asset, Category::Accessors, Category::Animations, Category::Buffers, Category::BufferViews,
+		Category::Cameras, Category::Images, Category::Materials, Category::Meshes, Category::Nodes,
+		Category::Samplers, Category::Scenes, Category::Skins, Category::Textures,
+	};
 
-#if !FASTGLTF_DISABLE_CUSTOM_MEMORY_POOL
-	// Create a new chunk memory resource for each asset we parse.
-	asset.memoryResource = resourceAllocator = std::make_shared<std::pmr::monotonic_buffer_resource>();
-#endif
+	[[nodiscard]] std::size_t getCategoryIndex(Category category) noexcept {
+		std::size_t index = 0;
+		while (index < AssetValidator::categoryCount - 1 && (to_underlying(category) >> index) != 1)
+			++index;
+		return index;
+	}
 
-	if (!hasBit(options, Options::DontRequireValidAssetMember)) {
-		dom::object assetInfo;
-		AssetInfo info = {};
-		auto error = root["asset"].get_object().get(assetInfo);
-		if (error == NO_SUCH_FIELD) {
-			return Error::InvalidOrMissingAssetField;
-		}
-		if (error != SUCCESS) FASTGLTF_UNLIKELY {
-			return Error::InvalidJson;
+	[[nodiscard]] std::size_t getObjectCount(const Asset& asset, Category category) noexcept {
+		switch (category) {
+			case Category::Buffers: return asset.buffers.size();
+			case Category::BufferViews: return asset.bufferViews.size();
+			case Category::Accessors: return asset.accessors.size();
+			case Category::Images: return asset.images.size();
+			case Category::Samplers: return asset.samplers.size();
+			case Category::Textures: return asset.textures.size();
+			case Category::Animations: return asset.animations.size();
+			case Category::Cameras: return asset.cameras.size();
+			case Category::Materials: return asset.materials.size();
+			case Category::Meshes: return asset.meshes.size();
+			case Category::Skins: return asset.skins.size();
+			case Category::Nodes: return asset.nodes.size();
+			case Category::Scenes: return asset.scenes.size();
+			case Category::Asset: return 1;
+			default: return 0;
 		}
+	}
 
-		std::string_view version;
-		if (assetInfo["version"].get_string().get(version) != SUCCESS) FASTGLTF_UNLIKELY {
-			return Error::InvalidOrMissingAssetField;
+	/**
+	 * The categories whose objects are read when validating an object of the given category. Any change to
+	 * those requires the entire category to be validated again.
+	 */
+	[[nodiscard]] Category getValidationContentDependencies(Category category) noexcept {
+		switch (category) {
+			case Category::Accessors: return Category::BufferViews;
+			case Category::Animations: return Category::Accessors | Category::BufferViews;
+			case Category::BufferViews: return Category::Asset;
+			case Category::Materials: return Category::Asset;
+			case Category::Meshes: return Category::Accessors | Category::BufferViews | Category::Asset;
+			case Category::Nodes: return Category::Meshes;
+			case Category::Textures: return Category::Asset;
+			default: return Category::None;
 		}
+	}
 
-		const auto major = static_cast<std::uint32_t>(version.substr(0, 1)[0] - '0');
-		// std::uint32_t minor = version.substr(2, 3)[0] - '0';
-		if (major != 2) {
-			return Error::UnsupportedVersion;
+	/**
+	 * The categories which objects of the given category only reference by index. Only removing objects
+	 * from those requires the entire category to be validated again.
+	 */
+	[[nodiscard]] Category getValidationCountDependencies(Category category) noexcept {
+		switch (category) {
+			case Category::Accessors: return Category::BufferViews;
+			case Category::BufferViews: return Category::Buffers;
+			case Category::Images: return Category::BufferViews;
+			case Category::Materials: return Category::Textures;
+			case Category::Meshes: return Category::Materials;
+			case Category::Nodes: return Category::Cameras | Category::Skins;
+			case Category::Scenes: return Category::Nodes;
+			case Category::Skins: return Category::Nodes | Category::Accessors;
+			case Category::Textures: return Category::Samplers | Category::Images;
+			default: return Category::None;
 		}
-		info.gltfVersion = std::string { version };
+	}
 
-		std::string_view copyright;
-		if (assetInfo["copyright"].get_string().get(copyright) == SUCCESS) FASTGLTF_LIKELY {
-			info.copyright = std::string { copyright };
+	template <Error (*validateObject)(const Asset&, Extensions, std::size_t)>
+	[[nodiscard]] Error validateObjectRange(const Asset& asset, Extensions usedExtensions, std::size_t first, std::size_t last) {
+		for (auto i = first; i < last; ++i) {
+			if (auto error = validateObject(asset, usedExtensions, i); error != Error::None)
+				return error;
 		}
+		return Error::None;
+	}
 
-		std::string_view generator;
-		if (assetInfo["generator"].get_string().get(generator) == SUCCESS) FASTGLTF_LIKELY {
-			info.generator = std::string { generator };
+	[[nodiscard]] Error validateObjects(const Asset& asset, Extensions usedExtensions, Category category, std::size_t first, std::size_t last) {
+		switch (category) {
+			case Category::Buffers: return validateObjectRange<validateBuffer>(asset, usedExtensions, first, last);
+			case Category::BufferViews: return validateObjectRange<validateBufferView>(asset, usedExtensions, first, last);
+			case Category::Accessors: return validateObjectRange<validateAccessor>(asset, usedExtensions, first, last);
+			case Category::Images: return validateObjectRange<validateImage>(asset, usedExtensions, first, last);
+			case Category::Samplers: return validateObjectRange<validateSampler>(asset, usedExtensions, first, last);
+			case Category::Textures: return validateObjectRange<validateTexture>(asset, usedExtensions, first, last);
+			case Category::Animations: return validateObjectRange<validateAnimation>(asset, usedExtensions, first, last);
+			case Category::Cameras: return validateObjectRange<validateCamera>(asset, usedExtensions, first, last);
+			case Category::Materials: return validateObjectRange<validateMaterial>(asset, usedExtensions, first, last);
+			case Category::Meshes: return validateObjectRange<validateMesh>(asset, usedExtensions, first, last);
+			case Category::Skins: return validateObjectRange<validateSkin>(asset, usedExtensions, first, last);
+			case Category::Nodes: return validateObjectRange<validateNode>(asset, usedExtensions, first, last);
+			case Category::Scenes: return validateObjectRange<validateScene>(asset, usedExtensions, first, last);
+			case Category::Asset: return validateObjectRange<validateAssetObject>(asset, usedExtensions, first, last);
+			default: return Error::None;
 		}
-
-		asset.assetInfo = std::move(info);
 	}
 
-	if (dom::array extensionsRequired; root["extensionsRequired"].get_array().get(extensionsRequired) == SUCCESS) FASTGLTF_LIKELY {
-		for (auto extension : extensionsRequired) {
-			std::string_view string;
-			if (extension.get_string().get(string) != SUCCESS) FASTGLTF_UNLIKELY {
-				return Error::InvalidGltf;
-			}
+	struct ValidationRange {
+		Category category;
+		std::size_t first;
+		std::size_t last;
+	};
 
-			bool known = false;
-			for (const auto& [extensionString, extensionEnum] : extensionStrings) {
-				if (extensionString == string) {
-					known = true;
-					if (!hasBit(config.extensions, extensionEnum)) {
-						// The extension is required, but not enabled by the user.
-						return Error::MissingExtensions;
-					}
-					break;
+	struct ValidationTasks {
+		const Asset& asset;
+		Extensions usedExtensions;
+		std::vector<ValidationRange> ranges;
+		// The index of the first range of every task, with one additional entry for the total count.
+		std::vector<std::size_t> taskOffsets;
+		std::vector<Error> errors;
+		std::atomic<std::size_t> firstFailedTask;
+	};
+
+	// Roughly the number of objects validated by a single task, so that small assets don't pay for any threads.
+	static constexpr std::size_t validationObjectsPerTask = 4096;
+
+	/**
+	 * Validates all ranges, in parallel if there are enough objects. If multiple objects are invalid, the error of
+	 * the object which comes first in the ranges is returned, independently of how the tasks were scheduled.
+	 */
+	[[nodiscard]] Error validateRanges(const Asset& asset, const std::vector<ValidationRange>& ranges, TaskExecutorCallback* executor, void* userPointer) {
+		ValidationTasks tasks { asset, getUsedExtensions(asset), {}, {}, {}, {} };
+
+		// Split large ranges, and group small ones, so that every task validates about the same number of objects.
+		std::size_t taskObjects = 0;
+		tasks.taskOffsets.emplace_back(0);
+		for (const auto& range : ranges) {
+			for (auto first = range.first; first < range.last;) {
+				const auto last = min(range.last, first + (validationObjectsPerTask - taskObjects));
+				tasks.ranges.push_back({ range.category, first, last });
+				taskObjects += last - first;
+				first = last;
+				if (taskObjects >= validationObjectsPerTask) {
+					tasks.taskOffsets.emplace_back(tasks.ranges.size());
+					taskObjects = 0;
 				}
 			}
-			if (!known) {
-				return Error::UnknownRequiredExtension;
-			}
-
-			FASTGLTF_STD_PMR_NS::string FASTGLTF_CONSTRUCT_PMR_RESOURCE(requiredExtension, resourceAllocator.get(), string);
-			asset.extensionsRequired.emplace_back(std::move(requiredExtension));
 		}
-	}
+		if (tasks.taskOffsets.back() != tasks.ranges.size())
+			tasks.taskOffsets.emplace_back(tasks.ranges.size());
 
-	Category readCategories = Category::None;
-	for (const auto object : root) {
-		auto hashedKey = crcStringFunction(object.key);
+		const auto taskCount = tasks.taskOffsets.size() - 1;
+		if (taskCount == 0)
+			return Error::None;
+		if (taskCount == 1) {
+			for (const auto& range : tasks.ranges) {
+				if (auto error = validateObjects(asset, tasks.usedExtensions, range.category, range.first, range.last); error != Error::None)
+					return error;
+			}
+			return Error::None;
+		}
+
+		tasks.errors.resize(taskCount, Error::None);
+		tasks.firstFailedTask = taskCount;
+		runTasks(taskCount, [](std::size_t taskIndex, void* taskData) {
+			auto& tasks = *static_cast<ValidationTasks*>(taskData);
+			// Tasks after one that has already failed can't change the result anymore.
+			if (taskIndex > tasks.firstFailedTask.load(std::memory_order_relaxed))
+				return;
+
+			for (auto i = tasks.taskOffsets[taskIndex]; i < tasks.taskOffsets[taskIndex + 1]; ++i) {
+				const auto& range = tasks.ranges[i];
+				auto error = validateObjects(tasks.asset, tasks.usedExtensions, range.category, range.first, range.last);
+				if (error == Error::None)
+					continue;
+
+				tasks.errors[taskIndex] = error;
+				auto failed = tasks.firstFailedTask.load(std::memory_order_relaxed);
+				while (taskIndex < failed && !tasks.firstFailedTask.compare_exchange_weak(failed, taskIndex, std::memory_order_relaxed)) {}
+				return;
+			}
+		}, &tasks, executor, userPointer);
+
+		const auto failedTask = tasks.firstFailedTask.load(std::memory_order_relaxed);
+		return failedTask < taskCount ? tasks.errors[failedTask] : Error::None;
+	}
+} // namespace fastgltf
+
+fg::Error fg::validate(const Asset& asset, Category categories, TaskExecutorCallback* executor, void* userPointer) {
+	std::vector<ValidationRange> ranges;
+	for (const auto category : validationOrder) {
+		if (hasBit(categories, category))
+			ranges.push_back({ category, 0, getObjectCount(asset, category) });
+	}
+	return validateRanges(asset, ranges, executor, userPointer);
+}
+
+fg::Error fg::validate(const fastgltf::Asset& asset) {
+	return validate(asset, Category::All);
+}
+
+void fg::AssetValidator::setTaskExecutorCallback(TaskExecutorCallback* executor, void* pUserPointer) noexcept {
+	executorCallback = executor;
+	userPointer = pUserPointer;
+}
+
+void fg::AssetValidator::markDirty(Category category, std::size_t objectIndex) {
+	if (category == Category::Asset) {
+		dirtyCategories |= Category::Asset;
+		return;
+	}
+	dirtyObjects[getCategoryIndex(category)].emplace_back(objectIndex);
+}
+
+void fg::AssetValidator::markDirty(Category categories) noexcept {
+	dirtyCategories |= categories & Category::All;
+}
+
+fg::Error fg::AssetValidator::revalidate(const Asset& asset) {
+	std::array<std::size_t, categoryCount> counts = {};
+	auto changedCategories = dirtyCategories;
+	auto shrunkCategories = Category::None;
+	for (const auto category : validationOrder) {
+		const auto index = getCategoryIndex(category);
+		counts[index] = getObjectCount(asset, category);
+		if (!dirtyObjects[index].empty())
+			changedCategories |= category;
+		if (counts[index] < validatedCounts[index])
+			shrunkCategories |= category;
+	}
+	// Removing objects also changes the content of a category, as far as the objects reading it are concerned.
+	changedCategories |= shrunkCategories;
+
+	// Objects only read other objects which have been validated themselves, which is why a category never
+	// needs to be validated again only because a category it depends on had to be validated again.
+	auto fullCategories = dirtyCategories;
+	for (const auto category : validationOrder) {
+		if ((getValidationContentDependencies(category) & changedCategories) != Category::None
+				|| (getValidationCountDependencies(category) & shrunkCategories) != Category::None)
+			fullCategories |= category;
+	}
+
+	std::vector<ValidationRange> ranges;
+	for (const auto category : validationOrder) {
+		const auto index = getCategoryIndex(category);
+		if (hasBit(fullCategories, category)) {
+			ranges.push_back({ category, 0, counts[index] });
+			continue;
+		}
+
+		// The dirty objects which still exist, merged into contiguous ranges, and all objects which were added.
+		auto& dirty = dirtyObjects[index];
+		std::sort(dirty.begin(), dirty.end());
+		const auto validatedCount = min(validatedCounts[index], counts[index]);
+		for (auto it = dirty.begin(); it != dirty.end() && *it < validatedCount; ++it) {
+			if (!ranges.empty() && ranges.back().category == category && ranges.back().last >= *it) {
+				ranges.back().last = max(ranges.back().last, *it + 1);
+			} else {
+				ranges.push_back({ category, *it, *it + 1 });
+			}
+		}
+		if (validatedCount < counts[index])
+			ranges.push_back({ category, validatedCount, counts[index] });
+	}
+
+	for (auto& dirty : dirtyObjects)
+		dirty.clear();
+
+	auto error = validateRanges(asset, ranges, executorCallback, userPointer);
+	if (error != Error::None) {
+		// Only the first invalid object is known, so the next call validates everything again.
+		dirtyCategories = Category::All;
+		return error;
+	}
+
+	validatedCounts = counts;
+	dirtyCategories = Category::None;
+	return Error::None;
+}
+
+namespace fastgltf {
+	[[nodiscard]] Error checkRequiredExtension(std::string_view extension, Extensions enabledExtensions) noexcept {
+		for (const auto& [extensionString, extensionEnum] : extensionStrings) {
+			if (extensionString == extension) {
+				if (!hasBit(enabledExtensions, extensionEnum)) {
+					// The extension is required, but not enabled by the user.
+					return Error::MissingExtensions;
+				}
+				return Error::None;
+			}
+		}
+		return Error::UnknownRequiredExtension;
+	}
+} // namespace fastgltf
+
+fg::Expected<fg::Asset> fg::Parser::parse(simdjson::dom::object root, Category categories) {
+	using namespace simdjson;
+	fillCategories(categories);
+
+	Asset asset {};
+
+#if !FASTGLTF_DISABLE_CUSTOM_MEMORY_POOL
+	// Create a new arena for each asset we parse. Its chunks come from the parser's chunk pool.
+	asset.memoryResource = resourceAllocator = createArena();
+#endif
+	asset.dataOwner = std::move(glbBufferOwner);
+	deferredFileLoads.clear();
+
+	if (!hasBit(options, Options::DontRequireValidAssetMember)) {
+		dom::object assetInfo;
+		AssetInfo info = {};
+		auto error = root["asset"].get_object().get(assetInfo);
+		if (error == NO_SUCH_FIELD) {
+			return Error::InvalidOrMissingAssetField;
+		}
+		if (error != SUCCESS) FASTGLTF_UNLIKELY {
+			return Error::InvalidJson;
+		}
+
+		std::string_view version;
+		if (assetInfo["version"].get_string().get(version) != SUCCESS) FASTGLTF_UNLIKELY {
+			return Error::InvalidOrMissingAssetField;
+		}
+
+		const auto major = static_cast<std::uint32_t>(version.substr(0, 1)[0] - '0');
+		// std::uint32_t minor = version.substr(2, 3)[0] - '0';
+		if (major != 2) {
+			return Error::UnsupportedVersion;
+		}
+		info.gltfVersion = std::string { version };
+
+		std::string_view copyright;
+		if (assetInfo["copyright"].get_string().get(copyright) == SUCCESS) FASTGLTF_LIKELY {
+			info.copyright = std::string { copyright };
+		}
+
+		std::string_view generator;
+		if (assetInfo["generator"].get_string().get(generator) == SUCCESS) FASTGLTF_LIKELY {
+			info.generator = std::string { generator };
+		}
+
+		asset.assetInfo = std::move(info);
+	}
+
+	if (dom::array extensionsRequired; root["extensionsRequired"].get_array().get(extensionsRequired) == SUCCESS) FASTGLTF_LIKELY {
+		for (auto extension : extensionsRequired) {
+			std::string_view string;
+			if (extension.get_string().get(string) != SUCCESS) FASTGLTF_UNLIKELY {
+				return Error::InvalidGltf;
+			}
+
+			if (auto error = checkRequiredExtension(string, config.extensions); error != Error::None) {
+				return error;
+			}
+
+			FASTGLTF_STD_PMR_NS::string FASTGLTF_CONSTRUCT_PMR_RESOURCE(requiredExtension, resourceAllocator.get(), string);
+			asset.extensionsRequired.emplace_back(std::move(requiredExtension));
+		}
+	}
+
+	if (auto error = parseCategories(root, categories, asset, true); error != Error::None) {
+		return error;
+	}
+
+#if !FASTGLTF_DISABLE_CUSTOM_MEMORY_POOL
+	collectMemoryStatistics(asset);
+#endif
+
+	return std::move(asset);
+}
+
+fg::Error fg::Parser::parseCategories(simdjson::dom::object& root, Category categories, Asset& asset, bool parseRootMembers) {
+	using namespace simdjson;
+
+	// With Options::ParseCategoriesInParallel, the top-level arrays are only collected while walking
+	// the root object, and are parsed by separate worker parsers afterwards.
+	struct CategoryTask {
+		Error (Parser::*parseFunction)(dom::array&, Asset&);
+		Category category;
+		dom::array array;
+		std::unique_ptr<Parser> worker;
+		std::vector<DeferredExtras> extras;
+		Error error = Error::None;
+	};
+	std::vector<CategoryTask> categoryTasks;
+	const bool parseInParallel = hasBit(options, Options::ParseCategoriesInParallel);
+
+	Category readCategories = Category::None;
+	for (const auto object : root) {
+		auto hashedKey = crcStringFunction(object.key);
 		if (hashedKey == force_consteval<crc32c("scene")>) {
+			if (!parseRootMembers)
+				continue;
+
 			std::uint64_t defaultScene;
 			if (object.value.get_uint64().get(defaultScene) != SUCCESS) FASTGLTF_UNLIKELY {
 				return Error::InvalidGltf;
@@ -1489,6 +2674,9 @@ fg::Expected<fg::Asset> fg::Parser::parse(simdjson::dom::object root, Category c
 		}
 
 		if (hashedKey == force_consteval<crc32c("extensions")>) {
+			if (!parseRootMembers)
+				continue;
+
 			dom::object extensionsObject;
 			if (object.value.get_object().get(extensionsObject) != SUCCESS) FASTGLTF_UNLIKELY {
 				return Error::InvalidGltf;
@@ -1509,8 +2697,12 @@ fg::Expected<fg::Asset> fg::Parser::parse(simdjson::dom::object root, Category c
 		}
 
 #define KEY_SWITCH_CASE(name, id) case force_consteval<crc32c(FASTGLTF_QUOTE(id))>:       \
-                if (hasBit(categories, Category::name))   \
-                    error = parse##name(array, asset);                     \
+                if (hasBit(categories, Category::name)) { \
+                    if (parseInParallel)                  \
+                        categoryTasks.push_back({ &Parser::parse##name, Category::name, array }); \
+                    else                                  \
+                        error = parseCategory(&Parser::parse##name, Category::name, array, asset); \
+                }                                         \
                 readCategories |= Category::name;         \
                 break;
 
@@ -1530,6 +2722,9 @@ fg::Expected<fg::Asset> fg::Parser::parse(simdjson::dom::object root, Category c
 			KEY_SWITCH_CASE(Skins, skins)
 			KEY_SWITCH_CASE(Textures, textures)
 			case force_consteval<crc32c("extensionsUsed")>: {
+				if (!parseRootMembers)
+					break;
+
 				for (auto usedValue : array) {
 					std::string_view usedString;
 					if (auto eError = usedValue.get_string().get(usedString); eError == SUCCESS) FASTGLTF_LIKELY {
@@ -1555,16 +2750,139 @@ fg::Expected<fg::Asset> fg::Parser::parse(simdjson::dom::object root, Category c
 #undef KEY_SWITCH_CASE
 	}
 
-	asset.availableCategories = readCategories;
+	if (!categoryTasks.empty()) {
+		// Every worker gets its own memory resource, since the monotonic_buffer_resource is not thread-safe.
+		// The extras objects are collected by each worker and only passed to the callback afterward.
+		for (auto& task : categoryTasks) {
+			task.worker = std::make_unique<Parser>(config.extensions);
+			auto& worker = *task.worker;
+			worker.config = config;
+			worker.options = options;
+			worker.directory = directory;
+#if !FASTGLTF_DISABLE_CUSTOM_MEMORY_POOL
+			worker.resourceAllocator = createArena();
+			asset.workerMemoryResources.emplace_back(worker.resourceAllocator);
+#endif
+			if (config.extrasCallback != nullptr) {
+				worker.deferredExtras = &task.extras;
+			}
+			if (task.parseFunction == &Parser::parseBuffers) {
+				worker.glbBuffer = std::move(glbBuffer);
+			}
+		}
+
+		// Each category only writes to its own vector within the asset, so the workers can share it.
+		auto context = std::make_pair(&categoryTasks, &asset);
+		executeTasks(categoryTasks.size(), [](std::size_t taskIndex, void* taskData) {
+			auto& [tasks, sharedAsset] = *static_cast<std::pair<std::vector<CategoryTask>*, Asset*>*>(taskData);
+			auto& task = (*tasks)[taskIndex];
+			task.error = task.worker->parseCategory(task.parseFunction, task.category, task.array, *sharedAsset);
+		}, &context);
+
+		// Go through the results in document order, so that both the order of the extras callbacks and
+		// the returned error are the same as when parsing sequentially.
+		for (auto& task : categoryTasks) {
+			for (auto& extras : task.extras) {
+				config.extrasCallback(&extras.object, extras.objectIndex, extras.category, config.userPointer);
+			}
+			if (task.error != Error::None) {
+				return task.error;
+			}
+#if FASTGLTF_ENABLE_LOAD_STATISTICS
+			const auto& workerStatistics = task.worker->loadStatistics;
+			for (std::size_t i = 0; i < loadStatistics.categories.size(); ++i) {
+				addLoadScopeStatistics(loadStatistics.categories[i], workerStatistics.categories[i]);
+			}
+			addLoadScopeStatistics(loadStatistics.decodeDataUris, workerStatistics.decodeDataUris);
+			addLoadScopeStatistics(loadStatistics.loadExternalFiles, workerStatistics.loadExternalFiles);
+#endif
+			deferredFileLoads.insert(deferredFileLoads.end(),
+									 std::make_move_iterator(task.worker->deferredFileLoads.begin()),
+									 std::make_move_iterator(task.worker->deferredFileLoads.end()));
+		}
+	}
+
+	return finishCategories(asset, readCategories);
+}
+
+fg::Error fg::Parser::parseCategory(Error (Parser::*parseFunction)(simdjson::dom::array&, Asset&), Category category,
+									simdjson::dom::array& array, Asset& asset) {
+	FASTGLTF_LOAD_SCOPE(loadStatistics.getCategory(category), LoadScope::ParseCategory, category);
+#if FASTGLTF_ENABLE_LOAD_STATISTICS
+	loadStatistics.getCategory(category).count += array.size();
+#endif
+	return (this->*parseFunction)(array, asset);
+}
+
+fg::Error fg::Parser::finishCategories(Asset& asset, Category readCategories) {
+	asset.availableCategories |= readCategories;
+
+	progress.parsedCategories = asset.availableCategories;
+	if (!reportProgress(LoadPhase::ParsedCategories)) {
+		return Error::LoadCancelled;
+	}
+
+	if (!deferredFileLoads.empty()) {
+		FASTGLTF_LOAD_SCOPE(loadStatistics.loadExternalFiles, LoadScope::LoadExternalFiles);
+		if (auto error = loadDeferredFiles(asset); error != Error::None) {
+			return error;
+		}
+		if (!reportProgress(LoadPhase::LoadedExternalFiles)) {
+			return Error::LoadCancelled;
+		}
+	}
+
+	if (hasBit(options, Options::DecodeMeshoptCompression)
+			&& hasBit(asset.availableCategories, Category::Buffers | Category::BufferViews)) {
+		FASTGLTF_LOAD_SCOPE(loadStatistics.decodeCompressedData, LoadScope::DecodeCompressedData);
+		if (auto error = decodeCompressedBufferViews(asset); error != Error::None) {
+			return error;
+		}
+#if FASTGLTF_ENABLE_LOAD_STATISTICS
+		for (const auto& view : asset.bufferViews) {
+			if (view.meshoptCompression) {
+				loadStatistics.decodeCompressedData.bytes += view.byteLength;
+				++loadStatistics.decodeCompressedData.count;
+			}
+		}
+#endif
+		if (!reportProgress(LoadPhase::DecodedCompressedData)) {
+			return Error::LoadCancelled;
+		}
+	}
 
 	if (hasBit(options, Options::GenerateMeshIndices)) {
+		FASTGLTF_LOAD_SCOPE(loadStatistics.generateMeshIndices, LoadScope::GenerateMeshIndices);
+#if FASTGLTF_ENABLE_LOAD_STATISTICS
+		for (const auto& mesh : asset.meshes) {
+			loadStatistics.generateMeshIndices.count += mesh.primitives.size();
+		}
+#endif
+		// Welding only handles the primitives it can read, and the rest gets the trivial indices.
+		if (hasBit(options, Options::WeldMeshVertices)) {
+			if (auto error = weldMeshVertices(asset); error != Error::None) {
+				return error;
+			}
+		}
 		if (auto error = generateMeshIndices(asset); error != Error::None) {
 			return error;
 		}
+		if (!reportProgress(LoadPhase::GeneratedMeshIndices)) {
+			return Error::LoadCancelled;
+		}
+	}
+
+	if (hasBit(options, Options::ComputeMissingBounds)
+			&& hasBit(asset.availableCategories, Category::Buffers | Category::BufferViews | Category::Accessors | Category::Meshes)) {
+		FASTGLTF_LOAD_SCOPE(loadStatistics.computeMissingBounds, LoadScope::ComputeMissingBounds);
+		computeMissingBounds(asset);
+		if (!reportProgress(LoadPhase::ComputedMissingBounds)) {
+			return Error::LoadCancelled;
+		}
 	}
 
 	// Resize primitive mappings to match the global variant count
-	if (hasBit(config.extensions, Extensions::KHR_materials_variants) && !asset.materialVariants.empty()) {
+	if (isExtensionEnabled(config.extensions, Extensions::KHR_materials_variants) && !asset.materialVariants.empty()) {
 		const auto variantCount = asset.materialVariants.size();
 		for (auto& mesh : asset.meshes) {
 			for (auto& primitive : mesh.primitives) {
@@ -1575,7 +2893,10 @@ fg::Expected<fg::Asset> fg::Parser::parse(simdjson::dom::object root, Category c
 		}
 	}
 
-	return std::move(asset);
+	if (!reportProgress(LoadPhase::Finished)) {
+		return Error::LoadCancelled;
+	}
+	return Error::None;
 }
 
 fg::Error fg::Parser::parseAccessors(simdjson::dom::array& accessors, Asset& asset) {
@@ -1595,7 +2916,7 @@ fg::Error fg::Parser::parseAccessors(simdjson::dom::array& accessors, Asset& ass
             return Error::InvalidGltf;
         }
 		accessor.componentType = getComponentType(static_cast<std::underlying_type_t<ComponentType>>(componentType));
-        if (accessor.componentType == ComponentType::Double && (!hasBit(options, Options::AllowDouble) || !hasBit(config.extensions, Extensions::KHR_accessor_float64))) {
+        if (accessor.componentType == ComponentType::Double && (!hasBit(options, Options::AllowDouble) || !isExtensionEnabled(config.extensions, Extensions::KHR_accessor_float64))) {
             return Error::InvalidGltf;
         }
 
@@ -1773,7 +3094,7 @@ fg::Error fg::Parser::parseAccessors(simdjson::dom::array& accessors, Asset& ass
 		if (config.extrasCallback != nullptr) {
 			dom::object extrasObject;
 			if (auto extrasError = accessorObject["extras"].get_object().get(extrasObject); extrasError == SUCCESS) {
-				config.extrasCallback(&extrasObject, asset.accessors.size(), Category::Accessors, config.userPointer);
+				invokeExtrasCallback(extrasObject, asset.accessors.size(), Category::Accessors);
 			} else if (extrasError != NO_SUCH_FIELD) {
 				return Error::InvalidGltf;
 			}
@@ -1781,7 +3102,7 @@ fg::Error fg::Parser::parseAccessors(simdjson::dom::array& accessors, Asset& ass
 
 		std::string_view name;
         if (accessorObject["name"].get_string().get(name) == SUCCESS) {
-	        accessor.name = FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(accessor.name), resourceAllocator.get(), name);
+	        assignWithResource(accessor.name, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(accessor.name), resourceAllocator.get(), name));
         }
 
 	    asset.accessors.emplace_back(std::move(accessor));
@@ -1807,7 +3128,7 @@ fg::Error fg::Parser::parseAnimations(simdjson::dom::array& animations, Asset& a
             return Error::InvalidGltf;
         }
 
-	    animation.channels = FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(animation.channels), resourceAllocator.get(), 0);
+	    assignWithResource(animation.channels, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(animation.channels), resourceAllocator.get(), 0));
         animation.channels.reserve(channels.size());
         for (auto channelValue : channels) {
             dom::object channelObject;
@@ -1861,7 +3182,7 @@ fg::Error fg::Parser::parseAnimations(simdjson::dom::array& animations, Asset& a
             return Error::InvalidGltf;
         }
 
-	    animation.samplers = FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(animation.samplers), resourceAllocator.get(), 0);
+	    assignWithResource(animation.samplers, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(animation.samplers), resourceAllocator.get(), 0));
         animation.samplers.reserve(samplers.size());
         for (auto samplerValue : samplers) {
             dom::object samplerObject;
@@ -1903,7 +3224,7 @@ fg::Error fg::Parser::parseAnimations(simdjson::dom::array& animations, Asset& a
 		if (config.extrasCallback != nullptr) {
 			dom::object extrasObject;
 			if (auto extrasError = animationObject["extras"].get_object().get(extrasObject); extrasError == SUCCESS) {
-				config.extrasCallback(&extrasObject, asset.animations.size(), Category::Animations, config.userPointer);
+				invokeExtrasCallback(extrasObject, asset.animations.size(), Category::Animations);
 			} else if (extrasError != NO_SUCH_FIELD) {
 				return Error::InvalidGltf;
 			}
@@ -1912,7 +3233,7 @@ fg::Error fg::Parser::parseAnimations(simdjson::dom::array& animations, Asset& a
 
 		std::string_view name;
         if (animationObject["name"].get_string().get(name) == SUCCESS) {
-	        animation.name = FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(animation.name), resourceAllocator.get(), name);
+	        assignWithResource(animation.name, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(animation.name), resourceAllocator.get(), name));
         }
 
 	    asset.animations.emplace_back(std::move(animation));
@@ -1964,19 +3285,39 @@ fg::Error fg::Parser::parseBuffers(simdjson::dom::array& buffers, Asset& asset)
             }
 
             if (uriView.isDataUri()) {
+                FASTGLTF_LOAD_SCOPE(loadStatistics.decodeDataUris, LoadScope::DecodeDataUri);
                 auto [error, source] = decodeDataUri(uriView);
                 if (error != Error::None) {
                     return error;
                 }
+#if FASTGLTF_ENABLE_LOAD_STATISTICS
+                loadStatistics.decodeDataUris.bytes += getLoadedByteCount(source);
+                ++loadStatistics.decodeDataUris.count;
+#endif
 
                 buffer.data = std::move(source);
             } else if (uriView.isLocalPath() && hasBit(options, Options::LoadExternalBuffers)) {
-	            auto [error, source] = loadFileFromUri(uriView);
-                if (error != Error::None) {
-                    return error;
-                }
+				if (hasBit(options, Options::LoadExternalFilesInParallel)) {
+					// The file is loaded once the JSON has been parsed. Until then, the URI acts as a placeholder.
+					deferredFileLoads.push_back({ Category::Buffers, asset.buffers.size(), std::string(uriString) });
+					buffer.data = sources::URI { 0, URI(uriView) };
+				} else {
+					FASTGLTF_LOAD_SCOPE(loadStatistics.loadExternalFiles, LoadScope::LoadExternalFile);
+					std::shared_ptr<const std::byte> owner;
+					auto [error, source] = loadFileFromUri(uriView, owner);
+					if (error != Error::None) {
+						return error;
+					}
+					if (owner != nullptr) {
+						asset.externalFileOwners.emplace_back(std::move(owner));
+					}
+#if FASTGLTF_ENABLE_LOAD_STATISTICS
+					loadStatistics.loadExternalFiles.bytes += getLoadedByteCount(source);
+					++loadStatistics.loadExternalFiles.count;
+#endif
 
-                buffer.data = std::move(source);
+					buffer.data = std::move(source);
+				}
             } else {
                 sources::URI filePath;
                 filePath.fileByteOffset = 0;
@@ -2000,7 +3341,7 @@ fg::Error fg::Parser::parseBuffers(simdjson::dom::array& buffers, Asset& asset)
 		if (config.extrasCallback != nullptr) {
 			dom::object extrasObject;
 			if (auto extrasError = bufferObject["extras"].get_object().get(extrasObject); extrasError == SUCCESS) {
-				config.extrasCallback(&extrasObject, asset.buffers.size(), Category::Buffers, config.userPointer);
+				invokeExtrasCallback(extrasObject, asset.buffers.size(), Category::Buffers);
 			} else if (extrasError != NO_SUCH_FIELD) {
 				return Error::InvalidGltf;
 			}
@@ -2008,7 +3349,7 @@ fg::Error fg::Parser::parseBuffers(simdjson::dom::array& buffers, Asset& asset)
 
 		std::string_view name;
         if (bufferObject["name"].get_string().get(name) == SUCCESS) {
-	        buffer.name = FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(buffer.name), resourceAllocator.get(), name);
+	        assignWithResource(buffer.name, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(buffer.name), resourceAllocator.get(), name));
         }
 
         ++bufferIndex;
@@ -2018,6 +3359,18 @@ fg::Error fg::Parser::parseBuffers(simdjson::dom::array& buffers, Asset& asset)
 	return Error::None;
 }
 
+namespace fastgltf {
+	/**
+	 * Checks the byteStride of EXT_meshopt_compression, which the decoders rely on: attributes use a multiple of 4
+	 * of at most 256 bytes, and indices use either 16-bit or 32-bit integers.
+	 */
+	[[nodiscard]] bool hasValidMeshoptStride(const CompressedBufferView& compression) noexcept {
+		if (compression.mode == MeshoptCompressionMode::Attributes)
+			return compression.byteStride != 0 && compression.byteStride % 4 == 0 && compression.byteStride <= 256;
+		return compression.byteStride == 2 || compression.byteStride == 4;
+	}
+} // namespace fastgltf
+
 fg::Error fg::Parser::parseBufferViews(simdjson::dom::array& bufferViews, Asset& asset) {
     using namespace simdjson;
 
@@ -2060,7 +3413,7 @@ fg::Error fg::Parser::parseBufferViews(simdjson::dom::array& bufferViews, Asset&
 
         std::string_view string;
         if (auto error = bufferViewObject["name"].get_string().get(string); error == SUCCESS) {
-	        view.name = FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(view.name), resourceAllocator.get(), string);
+	        assignWithResource(view.name, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(view.name), resourceAllocator.get(), string));
         } else if (error != NO_SUCH_FIELD) FASTGLTF_UNLIKELY {
             return Error::InvalidJson;
         }
@@ -2068,7 +3421,7 @@ fg::Error fg::Parser::parseBufferViews(simdjson::dom::array& bufferViews, Asset&
         dom::object extensionObject;
         if (bufferViewObject["extensions"].get_object().get(extensionObject) == SUCCESS) FASTGLTF_LIKELY {
             dom::object meshoptCompression;
-            if (hasBit(config.extensions, Extensions::EXT_meshopt_compression) && extensionObject[extensions::EXT_meshopt_compression].get_object().get(meshoptCompression) == SUCCESS) FASTGLTF_LIKELY {
+            if (isExtensionEnabled(config.extensions, Extensions::EXT_meshopt_compression) && extensionObject[extensions::EXT_meshopt_compression].get_object().get(meshoptCompression) == SUCCESS) FASTGLTF_LIKELY {
                 auto compression = std::make_unique<CompressedBufferView>();
 
                 if (auto error = meshoptCompression["buffer"].get_uint64().get(number); error != SUCCESS) FASTGLTF_UNLIKELY {
@@ -2148,6 +3501,9 @@ fg::Error fg::Parser::parseBufferViews(simdjson::dom::array& bufferViews, Asset&
                     return Error::InvalidJson;
                 }
 
+                if (!hasValidMeshoptStride(*compression)) FASTGLTF_UNLIKELY {
+                    return Error::InvalidGltf;
+                }
                 view.meshoptCompression = std::move(compression);
             }
         }
@@ -2155,7 +3511,7 @@ fg::Error fg::Parser::parseBufferViews(simdjson::dom::array& bufferViews, Asset&
 		if (config.extrasCallback != nullptr) {
 			dom::object extrasObject;
 			if (auto extrasError = bufferViewObject["extras"].get_object().get(extrasObject); extrasError == SUCCESS) {
-				config.extrasCallback(&extrasObject, asset.bufferViews.size(), Category::BufferViews, config.userPointer);
+				invokeExtrasCallback(extrasObject, asset.bufferViews.size(), Category::BufferViews);
 			} else if (extrasError != NO_SUCH_FIELD) {
 				return Error::InvalidGltf;
 			}
@@ -2180,7 +3536,7 @@ fg::Error fg::Parser::parseCameras(simdjson::dom::array& cameras, Asset& asset)
 
         std::string_view name;
         if (cameraObject["name"].get_string().get(name) == SUCCESS) {
-	        camera.name = FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(camera.name), resourceAllocator.get(), name);
+	        assignWithResource(camera.name, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(camera.name), resourceAllocator.get(), name));
         }
 
         std::string_view type;
@@ -2261,7 +3617,7 @@ fg::Error fg::Parser::parseCameras(simdjson::dom::array& cameras, Asset& asset)
 		if (config.extrasCallback != nullptr) {
 			dom::object extrasObject;
 			if (auto extrasError = cameraObject["extras"].get_object().get(extrasObject); extrasError == SUCCESS) {
-				config.extrasCallback(&extrasObject, asset.cameras.size(), Category::Cameras, config.userPointer);
+				invokeExtrasCallback(extrasObject, asset.cameras.size(), Category::Cameras);
 			} else if (extrasError != NO_SUCH_FIELD) {
 				return Error::InvalidGltf;
 			}
@@ -2288,7 +3644,7 @@ fg::Error fg::Parser::parseExtensions(simdjson::dom::object& extensionsObject, A
         auto hash = crcStringFunction(extensionValue.key);
         switch (hash) {
             case force_consteval<crc32c(extensions::KHR_lights_punctual)>: {
-                if (!hasBit(config.extensions, Extensions::KHR_lights_punctual))
+                if (!isExtensionEnabled(config.extensions, Extensions::KHR_lights_punctual))
                     break;
 
                 dom::array lightsArray;
@@ -2301,7 +3657,7 @@ fg::Error fg::Parser::parseExtensions(simdjson::dom::object& extensionsObject, A
                 break;
             }
 			case force_consteval<crc32c(extensions::KHR_materials_variants)>: {
-				if (!hasBit(config.extensions, Extensions::KHR_materials_variants))
+				if (!isExtensionEnabled(config.extensions, Extensions::KHR_materials_variants))
 					break;
 
 				dom::array variantsArray;
@@ -2354,19 +3710,39 @@ fg::Error fg::Parser::parseImages(simdjson::dom::array& images, Asset& asset) {
             }
 
             if (uriView.isDataUri()) {
+                FASTGLTF_LOAD_SCOPE(loadStatistics.decodeDataUris, LoadScope::DecodeDataUri);
                 auto [error, source] = decodeDataUri(uriView);
                 if (error != Error::None) {
                     return error;
                 }
+#if FASTGLTF_ENABLE_LOAD_STATISTICS
+                loadStatistics.decodeDataUris.bytes += getLoadedByteCount(source);
+                ++loadStatistics.decodeDataUris.count;
+#endif
 
                 image.data = std::move(source);
             } else if (uriView.isLocalPath() && hasBit(options, Options::LoadExternalImages)) {
-	            auto [error, source] = loadFileFromUri(uriView);
-                if (error != Error::None) {
-                    return error;
-                }
+				if (hasBit(options, Options::LoadExternalFilesInParallel)) {
+					// The file is loaded once the JSON has been parsed. Until then, the URI acts as a placeholder.
+					deferredFileLoads.push_back({ Category::Images, asset.images.size(), std::string(uriString) });
+					image.data = sources::URI { 0, URI(uriView) };
+				} else {
+					FASTGLTF_LOAD_SCOPE(loadStatistics.loadExternalFiles, LoadScope::LoadExternalFile);
+					std::shared_ptr<const std::byte> owner;
+					auto [error, source] = loadFileFromUri(uriView, owner);
+					if (error != Error::None) {
+						return error;
+					}
+					if (owner != nullptr) {
+						asset.externalFileOwners.emplace_back(std::move(owner));
+					}
+#if FASTGLTF_ENABLE_LOAD_STATISTICS
+					loadStatistics.loadExternalFiles.bytes += getLoadedByteCount(source);
+					++loadStatistics.loadExternalFiles.count;
+#endif
 
-                image.data = std::move(source);
+					image.data = std::move(source);
+				}
             } else {
                 sources::URI filePath;
                 filePath.fileByteOffset = 0;
@@ -2380,7 +3756,7 @@ fg::Error fg::Parser::parseImages(simdjson::dom::array& images, Asset& asset) {
                     using T = std::decay_t<decltype(arg)>;
 
                     // This is kinda cursed
-                    if constexpr (is_any_of_v<T, sources::CustomBuffer, sources::BufferView, sources::URI, sources::Array, sources::Vector>) {
+                    if constexpr (is_any_of_v<T, sources::CustomBuffer, sources::BufferView, sources::URI, sources::Array, sources::Vector, sources::ByteView>) {
                         arg.mimeType = getMimeTypeFromString(mimeType);
                     }
                 }, image.data);
@@ -2408,7 +3784,7 @@ fg::Error fg::Parser::parseImages(simdjson::dom::array& images, Asset& asset) {
 		if (config.extrasCallback != nullptr) {
 			dom::object extrasObject;
 			if (auto extrasError = imageObject["extras"].get_object().get(extrasObject); extrasError == SUCCESS) {
-				config.extrasCallback(&extrasObject, asset.images.size(), Category::Images, config.userPointer);
+				invokeExtrasCallback(extrasObject, asset.images.size(), Category::Images);
 			} else if (extrasError != NO_SUCH_FIELD) {
 				return Error::InvalidGltf;
 			}
@@ -2417,7 +3793,7 @@ fg::Error fg::Parser::parseImages(simdjson::dom::array& images, Asset& asset) {
 		// name is optional.
         std::string_view name;
         if (imageObject["name"].get_string().get(name) == SUCCESS) {
-	        image.name = FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(image.name), resourceAllocator.get(), name);
+	        assignWithResource(image.name, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(image.name), resourceAllocator.get(), name));
         }
 
         asset.images.emplace_back(std::move(image));
@@ -2518,7 +3894,7 @@ fg::Error fg::Parser::parseLights(simdjson::dom::array& lights, Asset& asset) {
 
 		std::string_view name;
         if (lightObject["name"].get_string().get(name) == SUCCESS) {
-	        light.name = FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(light.name), resourceAllocator.get(), name);
+	        assignWithResource(light.name, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(light.name), resourceAllocator.get(), name));
         }
 
         asset.lights.emplace_back(std::move(light));
@@ -2530,12 +3906,16 @@ fg::Error fg::Parser::parseLights(simdjson::dom::array& lights, Asset& asset) {
 fg::Error fg::Parser::parseMaterialExtensions(simdjson::dom::object &object, fastgltf::Material &material) {
 	using namespace simdjson;
 
+	if constexpr ((compiledExtensions & materialExtensions) == Extensions::None) {
+		return Error::None;
+	}
+
 	for (auto extensionField : object) {
 		auto hashedKey = crcStringFunction(extensionField.key);
 
 		switch (hashedKey) {
 			case force_consteval<crc32c(extensions::KHR_materials_anisotropy)>: {
-				if (!hasBit(config.extensions, Extensions::KHR_materials_anisotropy))
+				if (!isExtensionEnabled(config.extensions, Extensions::KHR_materials_anisotropy))
 					break;
 
 				dom::object anisotropyObject;
@@ -2574,7 +3954,7 @@ fg::Error fg::Parser::parseMaterialExtensions(simdjson::dom::object &object, fas
 				break;
 			}
 			case force_consteval<crc32c(extensions::KHR_materials_clearcoat)>: {
-				if (!hasBit(config.extensions, Extensions::KHR_materials_clearcoat))
+				if (!isExtensionEnabled(config.extensions, Extensions::KHR_materials_clearcoat))
 					break;
 
 				dom::object clearcoatObject;
@@ -2631,7 +4011,7 @@ fg::Error fg::Parser::parseMaterialExtensions(simdjson::dom::object &object, fas
 				break;
 			}
 			case force_consteval<crc32c(extensions::KHR_materials_dispersion)>: {
-				if (!hasBit(config.extensions, Extensions::KHR_materials_dispersion))
+				if (!isExtensionEnabled(config.extensions, Extensions::KHR_materials_dispersion))
 					break;
 
 				dom::object dispersionObject;
@@ -2650,7 +4030,7 @@ fg::Error fg::Parser::parseMaterialExtensions(simdjson::dom::object &object, fas
 				break;
 			}
 			case force_consteval<crc32c(extensions::KHR_materials_emissive_strength)>: {
-				if (!hasBit(config.extensions, Extensions::KHR_materials_emissive_strength))
+				if (!isExtensionEnabled(config.extensions, Extensions::KHR_materials_emissive_strength))
 					break;
 
 				dom::object emissiveObject;
@@ -2669,7 +4049,7 @@ fg::Error fg::Parser::parseMaterialExtensions(simdjson::dom::object &object, fas
 				break;
 			}
 			case force_consteval<crc32c(extensions::KHR_materials_ior)>: {
-				if (!hasBit(config.extensions, Extensions::KHR_materials_ior))
+				if (!isExtensionEnabled(config.extensions, Extensions::KHR_materials_ior))
 					break;
 
 				dom::object iorObject;
@@ -2688,7 +4068,7 @@ fg::Error fg::Parser::parseMaterialExtensions(simdjson::dom::object &object, fas
 				break;
 			}
 			case force_consteval<crc32c(extensions::KHR_materials_iridescence)>: {
-				if (!hasBit(config.extensions, Extensions::KHR_materials_iridescence))
+				if (!isExtensionEnabled(config.extensions, Extensions::KHR_materials_iridescence))
 					break;
 
 				dom::object iridescenceObject;
@@ -2752,7 +4132,7 @@ fg::Error fg::Parser::parseMaterialExtensions(simdjson::dom::object &object, fas
 				break;
 			}
 			case force_consteval<crc32c(extensions::KHR_materials_sheen)>: {
-				if (!hasBit(config.extensions, Extensions::KHR_materials_sheen))
+				if (!isExtensionEnabled(config.extensions, Extensions::KHR_materials_sheen))
 					break;
 
 				dom::object sheenObject;
@@ -2809,7 +4189,7 @@ fg::Error fg::Parser::parseMaterialExtensions(simdjson::dom::object &object, fas
 				break;
 			}
 			case force_consteval<crc32c(extensions::KHR_materials_specular)>: {
-				if (!hasBit(config.extensions, Extensions::KHR_materials_specular))
+				if (!isExtensionEnabled(config.extensions, Extensions::KHR_materials_specular))
 					break;
 
 				dom::object specularObject;
@@ -2866,7 +4246,7 @@ fg::Error fg::Parser::parseMaterialExtensions(simdjson::dom::object &object, fas
 				break;
 			}
 			case force_consteval<crc32c(extensions::KHR_materials_transmission)>: {
-				if (!hasBit(config.extensions, Extensions::KHR_materials_transmission))
+				if (!isExtensionEnabled(config.extensions, Extensions::KHR_materials_transmission))
 					break;
 
 				dom::object transmissionObject;
@@ -2897,7 +4277,7 @@ fg::Error fg::Parser::parseMaterialExtensions(simdjson::dom::object &object, fas
 				break;
 			}
 			case force_consteval<crc32c(extensions::KHR_materials_diffuse_transmission)>: {
-				if (!hasBit(config.extensions, Extensions::KHR_materials_diffuse_transmission))
+				if (!isExtensionEnabled(config.extensions, Extensions::KHR_materials_diffuse_transmission))
 					break;
 
 				dom::object diffuseTransmissionObject;
@@ -2954,7 +4334,7 @@ fg::Error fg::Parser::parseMaterialExtensions(simdjson::dom::object &object, fas
 				break;
 			}			
 			case force_consteval<crc32c(extensions::KHR_materials_unlit)>: {
-				if (!hasBit(config.extensions, Extensions::KHR_materials_unlit))
+				if (!isExtensionEnabled(config.extensions, Extensions::KHR_materials_unlit))
 					break;
 
 				dom::object unlitObject;
@@ -2967,7 +4347,7 @@ fg::Error fg::Parser::parseMaterialExtensions(simdjson::dom::object &object, fas
 				break;
 			}
 			case force_consteval<crc32c(extensions::KHR_materials_volume)>: {
-				if (!hasBit(config.extensions, Extensions::KHR_materials_volume))
+				if (!isExtensionEnabled(config.extensions, Extensions::KHR_materials_volume))
 					break;
 
 				dom::object volumeObject;
@@ -3020,7 +4400,7 @@ fg::Error fg::Parser::parseMaterialExtensions(simdjson::dom::object &object, fas
 				break;
 			}
 			case force_consteval<crc32c(extensions::MSFT_packing_normalRoughnessMetallic)>: {
-				if (!hasBit(config.extensions, Extensions::MSFT_packing_normalRoughnessMetallic))
+				if (!isExtensionEnabled(config.extensions, Extensions::MSFT_packing_normalRoughnessMetallic))
 					break;
 
 				dom::object normalRoughnessMetallic;
@@ -3036,7 +4416,7 @@ fg::Error fg::Parser::parseMaterialExtensions(simdjson::dom::object &object, fas
 				break;
 			}
 			case force_consteval<crc32c(extensions::MSFT_packing_occlusionRoughnessMetallic)>: {
-				if (!hasBit(config.extensions, Extensions::MSFT_packing_occlusionRoughnessMetallic))
+				if (!isExtensionEnabled(config.extensions, Extensions::MSFT_packing_occlusionRoughnessMetallic))
 					break;
 
 				dom::object occlusionRoughnessMetallic;
@@ -3068,7 +4448,7 @@ fg::Error fg::Parser::parseMaterialExtensions(simdjson::dom::object &object, fas
 			}
 #if FASTGLTF_ENABLE_DEPRECATED_EXT
 			case force_consteval<crc32c(extensions::KHR_materials_pbrSpecularGlossiness)>: {
-				if (!hasBit(config.extensions, Extensions::KHR_materials_pbrSpecularGlossiness))
+				if (!isExtensionEnabled(config.extensions, Extensions::KHR_materials_pbrSpecularGlossiness))
 					break;
 
 				dom::object specularGlossinessObject;
@@ -3274,7 +4654,7 @@ fg::Error fg::Parser::parseMaterials(simdjson::dom::array& materials, Asset& ass
 
         std::string_view name;
         if (materialObject["name"].get_string().get(name) == SUCCESS) {
-	        material.name = FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(material.name), resourceAllocator.get(), name);
+	        assignWithResource(material.name, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(material.name), resourceAllocator.get(), name));
         }
 
         dom::object extensionsObject;
@@ -3287,7 +4667,7 @@ fg::Error fg::Parser::parseMaterials(simdjson::dom::array& materials, Asset& ass
 		if (config.extrasCallback != nullptr) {
 			dom::object extrasObject;
 			if (auto extrasError = materialObject["extras"].get_object().get(extrasObject); extrasError == SUCCESS) {
-				config.extrasCallback(&extrasObject, asset.materials.size(), Category::Materials, config.userPointer);
+				invokeExtrasCallback(extrasObject, asset.materials.size(), Category::Materials);
 			} else if (extrasError != NO_SUCH_FIELD) {
 				return Error::InvalidGltf;
 			}
@@ -3302,12 +4682,16 @@ fg::Error fg::Parser::parseMaterials(simdjson::dom::array& materials, Asset& ass
 fastgltf::Error fg::Parser::parsePrimitiveExtensions(simdjson::dom::object& object, Primitive& primitive) {
 	using namespace simdjson;
 
+	if constexpr ((compiledExtensions & primitiveExtensions) == Extensions::None) {
+		return Error::None;
+	}
+
 	for (auto extension : object) {
 		auto keyHash = crcStringFunction(extension.key);
 
 		switch (keyHash) {
 			case force_consteval<crc32c(extensions::KHR_materials_variants)>: {
-				if (!hasBit(config.extensions, Extensions::KHR_materials_variants))
+				if (!isExtensionEnabled(config.extensions, Extensions::KHR_materials_variants))
 					break;
 
 				dom::object variantObject;
@@ -3349,7 +4733,7 @@ fastgltf::Error fg::Parser::parsePrimitiveExtensions(simdjson::dom::object& obje
 				break;
 			}
 			case force_consteval<crc32c(extensions::KHR_draco_mesh_compression)>: {
-				if (!hasBit(config.extensions, Extensions::KHR_draco_mesh_compression))
+				if (!isExtensionEnabled(config.extensions, Extensions::KHR_draco_mesh_compression))
 					break;
 
 				dom::object dracoObject;
@@ -3400,7 +4784,7 @@ fg::Error fg::Parser::parseMeshes(simdjson::dom::array& meshes, Asset& asset) {
 			return meshError == Error::MissingField ? Error::InvalidGltf : meshError;
 		}
 
-		mesh.primitives = FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(mesh.primitives), resourceAllocator.get(), 0);
+		assignWithResource(mesh.primitives, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(mesh.primitives), resourceAllocator.get(), 0));
 		mesh.primitives.reserve(array.size());
 		for (auto primitiveValue : array) {
 			// Required fields: "attributes"
@@ -3420,7 +4804,7 @@ fg::Error fg::Parser::parseMeshes(simdjson::dom::array& meshes, Asset& asset) {
 
 			dom::array targets;
 			if (primitiveObject["targets"].get_array().get(targets) == SUCCESS) FASTGLTF_LIKELY {
-				primitive.targets = FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(primitive.targets), resourceAllocator.get(), 0);
+				assignWithResource(primitive.targets, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(primitive.targets), resourceAllocator.get(), 0));
 				primitive.targets.reserve(targets.size());
 				for (auto targetValue : targets) {
 					if (targetValue.get_object().get(attributesObject) != SUCCESS) FASTGLTF_UNLIKELY {
@@ -3452,7 +4836,7 @@ fg::Error fg::Parser::parseMeshes(simdjson::dom::array& meshes, Asset& asset) {
 				return Error::InvalidGltf;
 			}
 
-			if (hasBit(config.extensions, Extensions::KHR_materials_variants) || hasBit(config.extensions, Extensions::KHR_draco_mesh_compression)) {
+			if (isExtensionEnabled(config.extensions, Extensions::KHR_materials_variants) || isExtensionEnabled(config.extensions, Extensions::KHR_draco_mesh_compression)) {
 				dom::object extensionsObject;
 				if (auto error = primitiveObject["extensions"].get_object().get(extensionsObject); error == SUCCESS) {
 					if (auto extensionError = parsePrimitiveExtensions(extensionsObject, primitive); extensionError != Error::None)
@@ -3466,7 +4850,7 @@ fg::Error fg::Parser::parseMeshes(simdjson::dom::array& meshes, Asset& asset) {
 		}
 
         if (meshError = getJsonArray(meshObject, "weights", &array); meshError == Error::None) FASTGLTF_LIKELY {
-	        mesh.weights = FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(mesh.weights), resourceAllocator.get(), 0);
+	        assignWithResource(mesh.weights, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(mesh.weights), resourceAllocator.get(), 0));
             mesh.weights.reserve(array.size());
             for (auto weightValue : array) {
                 double val;
@@ -3482,7 +4866,7 @@ fg::Error fg::Parser::parseMeshes(simdjson::dom::array& meshes, Asset& asset) {
 		if (config.extrasCallback != nullptr) {
 			dom::object extrasObject;
 			if (auto extrasError = meshObject["extras"].get_object().get(extrasObject); extrasError == SUCCESS) {
-				config.extrasCallback(&extrasObject, asset.meshes.size(), Category::Meshes, config.userPointer);
+				invokeExtrasCallback(extrasObject, asset.meshes.size(), Category::Meshes);
 			} else if (extrasError != NO_SUCH_FIELD) {
 				return Error::InvalidGltf;
 			}
@@ -3490,7 +4874,7 @@ fg::Error fg::Parser::parseMeshes(simdjson::dom::array& meshes, Asset& asset) {
 
 		std::string_view name;
         if (meshObject["name"].get_string().get(name) == SUCCESS) {
-	        mesh.name = FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(mesh.name), resourceAllocator.get(), name);
+	        assignWithResource(mesh.name, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(mesh.name), resourceAllocator.get(), name));
         }
 
         asset.meshes.emplace_back(std::move(mesh));
@@ -3530,7 +4914,7 @@ fg::Error fg::Parser::parseNodes(simdjson::dom::array& nodes, Asset& asset) {
         dom::array array;
         auto childError = getJsonArray(nodeObject, "children", &array);
         if (childError == Error::None) FASTGLTF_LIKELY {
-	        node.children = FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(node.children), resourceAllocator.get(), 0);
+	        assignWithResource(node.children, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(node.children), resourceAllocator.get(), 0));
 			node.children.reserve(array.size());
             for (auto childValue : array) {
                 if (childValue.get_uint64().get(index) != SUCCESS) FASTGLTF_UNLIKELY {
@@ -3546,7 +4930,7 @@ fg::Error fg::Parser::parseNodes(simdjson::dom::array& nodes, Asset& asset) {
         auto weightsError = getJsonArray(nodeObject, "weights", &array);
         if (weightsError != Error::MissingField) {
             if (weightsError != Error::None) {
-	            node.weights = FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(node.weights), resourceAllocator.get(), 0);
+	            assignWithResource(node.weights, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(node.weights), resourceAllocator.get(), 0));
                 node.weights.reserve(array.size());
                 for (auto weightValue : array) {
                     double val;
@@ -3634,7 +5018,7 @@ fg::Error fg::Parser::parseNodes(simdjson::dom::array& nodes, Asset& asset) {
 
         dom::object extensionsObject;
         if (nodeObject["extensions"].get_object().get(extensionsObject) == SUCCESS) FASTGLTF_LIKELY {
-			if (hasBit(config.extensions, Extensions::KHR_lights_punctual)) {
+			if (isExtensionEnabled(config.extensions, Extensions::KHR_lights_punctual)) {
 				dom::object lightsObject;
 				if (extensionsObject[extensions::KHR_lights_punctual].get_object().get(lightsObject) == SUCCESS) FASTGLTF_LIKELY {
 					std::uint64_t light;
@@ -3648,7 +5032,7 @@ fg::Error fg::Parser::parseNodes(simdjson::dom::array& nodes, Asset& asset) {
 				}
 			}
 
-			if (hasBit(config.extensions, Extensions::EXT_mesh_gpu_instancing)) {
+			if (isExtensionEnabled(config.extensions, Extensions::EXT_mesh_gpu_instancing)) {
 				dom::object gpuInstancingObject;
 				if (auto instancingError = extensionsObject[extensions::EXT_mesh_gpu_instancing].get_object().get(gpuInstancingObject); instancingError == SUCCESS) FASTGLTF_LIKELY {
 					dom::object attributesObject;
@@ -3669,7 +5053,7 @@ fg::Error fg::Parser::parseNodes(simdjson::dom::array& nodes, Asset& asset) {
 		if (config.extrasCallback != nullptr) {
 			dom::object extrasObject;
 			if (auto extrasError = nodeObject["extras"].get_object().get(extrasObject); extrasError == SUCCESS) {
-				config.extrasCallback(&extrasObject, asset.nodes.size(), Category::Nodes, config.userPointer);
+				invokeExtrasCallback(extrasObject, asset.nodes.size(), Category::Nodes);
 			} else if (extrasError != NO_SUCH_FIELD) {
 				return Error::InvalidGltf;
 			}
@@ -3677,7 +5061,7 @@ fg::Error fg::Parser::parseNodes(simdjson::dom::array& nodes, Asset& asset) {
 
         std::string_view name;
         if (nodeObject["name"].get_string().get(name) == SUCCESS) {
-	        node.name = FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(node.name), resourceAllocator.get(), name);
+	        assignWithResource(node.name, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(node.name), resourceAllocator.get(), name));
         }
 
         asset.nodes.emplace_back(std::move(node));
@@ -3723,7 +5107,7 @@ fg::Error fg::Parser::parseSamplers(simdjson::dom::array& samplers, Asset& asset
 		if (config.extrasCallback != nullptr) {
 			dom::object extrasObject;
 			if (auto extrasError = samplerObject["extras"].get_object().get(extrasObject); extrasError == SUCCESS) {
-				config.extrasCallback(&extrasObject, asset.samplers.size(), Category::Samplers, config.userPointer);
+				invokeExtrasCallback(extrasObject, asset.samplers.size(), Category::Samplers);
 			} else if (extrasError != NO_SUCH_FIELD) {
 				return Error::InvalidGltf;
 			}
@@ -3731,7 +5115,7 @@ fg::Error fg::Parser::parseSamplers(simdjson::dom::array& samplers, Asset& asset
 
 		std::string_view name;
 		if (samplerObject["name"].get_string().get(name) == SUCCESS) {
-			sampler.name = FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(sampler.name), resourceAllocator.get(), name);
+			assignWithResource(sampler.name, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(sampler.name), resourceAllocator.get(), name));
 		}
 
 		asset.samplers.emplace_back(std::move(sampler));
@@ -3754,13 +5138,13 @@ fg::Error fg::Parser::parseScenes(simdjson::dom::array& scenes, Asset& asset) {
 
         std::string_view name;
         if (sceneObject["name"].get_string().get(name) == SUCCESS) {
-	        scene.name = FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(scene.name), resourceAllocator.get(), name);
+	        assignWithResource(scene.name, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(scene.name), resourceAllocator.get(), name));
         }
 
 		if (config.extrasCallback != nullptr) {
 			dom::object extrasObject;
 			if (auto extrasError = sceneObject["extras"].get_object().get(extrasObject); extrasError == SUCCESS) {
-				config.extrasCallback(&extrasObject, asset.scenes.size(), Category::Scenes, config.userPointer);
+				invokeExtrasCallback(extrasObject, asset.scenes.size(), Category::Scenes);
 			} else if (extrasError != NO_SUCH_FIELD) {
 				return Error::InvalidGltf;
 			}
@@ -3770,7 +5154,7 @@ fg::Error fg::Parser::parseScenes(simdjson::dom::array& scenes, Asset& asset) {
         dom::array nodes;
         auto nodeError = getJsonArray(sceneObject, "nodes", &nodes);
         if (nodeError == Error::None) FASTGLTF_LIKELY {
-	        scene.nodeIndices = FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(scene.nodeIndices), resourceAllocator.get(), 0);
+	        assignWithResource(scene.nodeIndices, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(scene.nodeIndices), resourceAllocator.get(), 0));
 			scene.nodeIndices.reserve(nodes.size());
             for (auto nodeValue : nodes) {
                 std::uint64_t index;
@@ -3817,7 +5201,7 @@ fg::Error fg::Parser::parseSkins(simdjson::dom::array& skins, Asset& asset) {
         if (skinObject["joints"].get_array().get(jointsArray) != SUCCESS) FASTGLTF_UNLIKELY {
             return Error::InvalidGltf;
         }
-		skin.joints = FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(skin.joints), resourceAllocator.get(), 0);
+		assignWithResource(skin.joints, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(skin.joints), resourceAllocator.get(), 0));
         skin.joints.reserve(jointsArray.size());
         for (auto jointValue : jointsArray) {
             if (jointValue.get_uint64().get(index) != SUCCESS) FASTGLTF_UNLIKELY {
@@ -3829,7 +5213,7 @@ fg::Error fg::Parser::parseSkins(simdjson::dom::array& skins, Asset& asset) {
 		if (config.extrasCallback != nullptr) {
 			dom::object extrasObject;
 			if (auto extrasError = skinObject["extras"].get_object().get(extrasObject); extrasError == SUCCESS) {
-				config.extrasCallback(&extrasObject, asset.skins.size(), Category::Skins, config.userPointer);
+				invokeExtrasCallback(extrasObject, asset.skins.size(), Category::Skins);
 			} else if (extrasError != NO_SUCH_FIELD) {
 				return Error::InvalidGltf;
 			}
@@ -3837,7 +5221,7 @@ fg::Error fg::Parser::parseSkins(simdjson::dom::array& skins, Asset& asset) {
 
 		std::string_view name;
         if (skinObject["name"].get_string().get(name) == SUCCESS) {
-	        skin.name = FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(skin.name), resourceAllocator.get(), name);
+	        assignWithResource(skin.name, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(skin.name), resourceAllocator.get(), name));
         }
         asset.skins.emplace_back(std::move(skin));
     }
@@ -3884,7 +5268,7 @@ fg::Error fg::Parser::parseTextures(simdjson::dom::array& textures, Asset& asset
 		if (config.extrasCallback != nullptr) {
 			dom::object extrasObject;
 			if (auto extrasError = textureObject["extras"].get_object().get(extrasObject); extrasError == SUCCESS) {
-				config.extrasCallback(&extrasObject, asset.textures.size(), Category::Textures, config.userPointer);
+				invokeExtrasCallback(extrasObject, asset.textures.size(), Category::Textures);
 			} else if (extrasError != NO_SUCH_FIELD) {
 				return Error::InvalidGltf;
 			}
@@ -3892,7 +5276,7 @@ fg::Error fg::Parser::parseTextures(simdjson::dom::array& textures, Asset& asset
 
 		std::string_view name;
         if (textureObject["name"].get_string().get(name) == SUCCESS) {
-			texture.name = FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(texture.name), resourceAllocator.get(), name);
+			assignWithResource(texture.name, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(texture.name), resourceAllocator.get(), name));
         }
 
         asset.textures.emplace_back(std::move(texture));
@@ -3903,1905 +5287,5583 @@ fg::Error fg::Parser::parseTextures(simdjson::dom::array& textures, Asset& asset
 
 #pragma endregion
 
-#pragma region Parser
-fastgltf::GltfType fg::determineGltfFileType(GltfDataGetter& data) {
-	// We'll try and read a BinaryGltfHeader from the buffer to see if the magic is correct.
-	auto header = readBinaryHeader(data);
-	data.reset();
-	if (header.magic == binaryGltfHeaderMagic) {
-		return GltfType::GLB;
-	}
+#pragma region On-Demand parsing
+struct fg::Parser::OnDemandParser {
+	simdjson::ondemand::parser jsonParser;
 
-	// First, check if any of the first four characters is a '{'.
-	std::array<std::uint8_t, 4> begin = {};
-	data.read(begin.data(), begin.size());
-	data.reset();
-	for (const auto& i : begin) {
-		if ((char)i == ' ')
-			continue;
-		if ((char)i == '{')
-			return GltfType::glTF;
-	}
+	// One past the padding of the document that is currently being iterated. Every slice of the
+	// document can therefore be passed to the DOM parser directly, without copying it first.
+	const std::uint8_t* documentEnd = nullptr;
 
-	return GltfType::Invalid;
-}
+	Error parseSlice(Parser& parser, simdjson::ondemand::value& value, simdjson::dom::element& element);
+	Error parseAssetInfo(simdjson::ondemand::object& assetObject, AssetInfo& info);
+	Error parseAccessors(Parser& parser, simdjson::ondemand::array& accessors, Asset& asset);
+	Error parseSparseAccessor(simdjson::ondemand::object& sparseObject, SparseAccessor& sparse);
+	Error parseAnimations(Parser& parser, simdjson::ondemand::array& animations, Asset& asset);
+	Error parseBufferViews(Parser& parser, simdjson::ondemand::array& bufferViews, Asset& asset);
+	Error parseMeshoptCompression(simdjson::ondemand::object& compressionObject, CompressedBufferView& compression);
+};
 
-fg::Parser::Parser(Extensions extensionsToLoad) noexcept {
-    std::call_once(crcInitialisation, initialiseCrc);
-    jsonParser = std::make_unique<simdjson::dom::parser>();
-    config.extensions = extensionsToLoad;
-}
+fg::Error fg::Parser::OnDemandParser::parseSlice(Parser& parser, simdjson::ondemand::value& value, simdjson::dom::element& element) {
+	using namespace simdjson;
 
-fg::Parser::Parser(Parser&& other) noexcept : jsonParser(std::move(other.jsonParser)), config(other.config) {}
+	std::string_view json;
+	if (value.raw_json().get(json) != SUCCESS) FASTGLTF_UNLIKELY {
+		return Error::InvalidJson;
+	}
 
-fg::Parser& fg::Parser::operator=(Parser&& other) noexcept {
-    jsonParser = std::move(other.jsonParser);
-    config = other.config;
-    return *this;
+	// The DOM parser only reads the padding after the slice, which is just the rest of the document.
+	const auto* data = reinterpret_cast<const std::uint8_t*>(json.data());
+	padded_string_view view(data, json.size(), static_cast<std::size_t>(documentEnd - data));
+	if (parser.jsonParser->parse(view).get(element) != SUCCESS) FASTGLTF_UNLIKELY {
+		return Error::InvalidJson;
+	}
+	return Error::None;
 }
 
-fg::Parser::~Parser() = default;
-
-fg::Expected<fg::Asset> fg::Parser::loadGltf(GltfDataGetter& data, fs::path _directory, Options _options, Category categories) {
-    auto type = fastgltf::determineGltfFileType(data);
+fg::Error fg::Parser::OnDemandParser::parseAssetInfo(simdjson::ondemand::object& assetObject, AssetInfo& info) {
+	using namespace simdjson;
 
-    if (type == fastgltf::GltfType::glTF) {
-        return loadGltfJson(data, std::move(_directory), _options, categories);
-    }
+	bool hasVersion = false;
+	for (auto field : assetObject) {
+		std::string_view key;
+		ondemand::value value;
+		if (field.escaped_key().get(key) != SUCCESS || field.value().get(value) != SUCCESS) FASTGLTF_UNLIKELY {
+			return Error::InvalidJson;
+		}
 
-    if (type == fastgltf::GltfType::GLB) {
-        return loadGltfBinary(data, std::move(_directory), _options, categories);
-    }
+		std::string_view string;
+		switch (crcStringFunction(key)) {
+			case force_consteval<crc32c("version")>: {
+				if (value.get_string().get(string) != SUCCESS || string.empty()) FASTGLTF_UNLIKELY {
+					return Error::InvalidOrMissingAssetField;
+				}
+				if (string[0] != '2') {
+					return Error::UnsupportedVersion;
+				}
+				info.gltfVersion = std::string { string };
+				hasVersion = true;
+				break;
+			}
+			case force_consteval<crc32c("copyright")>: {
+				if (value.get_string().get(string) == SUCCESS) FASTGLTF_LIKELY {
+					info.copyright = std::string { string };
+				}
+				break;
+			}
+			case force_consteval<crc32c("generator")>: {
+				if (value.get_string().get(string) == SUCCESS) FASTGLTF_LIKELY {
+					info.generator = std::string { string };
+				}
+				break;
+			}
+			default:
+				break;
+		}
+	}
 
-    return Error::InvalidFileData;
+	if (!hasVersion) FASTGLTF_UNLIKELY {
+		return Error::InvalidOrMissingAssetField;
+	}
+	return Error::None;
 }
 
-fg::Expected<fg::Asset> fg::Parser::loadGltfJson(GltfDataGetter& data, fs::path _directory, Options _options, Category categories) {
-    using namespace simdjson;
+fg::Error fg::Parser::OnDemandParser::parseAccessors(Parser& parser, simdjson::ondemand::array& accessors, Asset& asset) {
+	using namespace simdjson;
 
-	options = _options;
-	directory = std::move(_directory);
+	for (auto accessorValue : accessors) {
+		// Required fields: "componentType", "count"
+		ondemand::object accessorObject;
+		if (accessorValue.get_object().get(accessorObject) != SUCCESS) FASTGLTF_UNLIKELY {
+			return Error::InvalidGltf;
+		}
 
-#if !defined(__ANDROID__)
-    // If we never have to load the files ourselves, we're fine with the directory being invalid/blank.
-    if (std::error_code ec; hasBit(_options, Options::LoadExternalBuffers) && (!fs::is_directory(directory, ec) || ec)) {
-        return Error::InvalidPath;
-    }
-#endif
+		Accessor accessor = {};
+		bool hasComponentType = false, hasType = false, hasCount = false;
+
+		// The min and max arrays can only be converted once the type and component type are known,
+		// which might only come after them. No accessor type has more than 16 components.
+		struct Bounds {
+			std::array<ondemand::number, 16> values;
+			std::size_t count = 0;
+			bool present = false;
+		} bounds[2];
+		auto readBounds = [](ondemand::value& value, Bounds& out) -> Error {
+			ondemand::array elements;
+			if (value.get_array().get(elements) != SUCCESS) {
+				// The DOM parser also ignores bounds that are not arrays.
+				return Error::None;
+			}
+			out.present = true;
+			for (auto element : elements) {
+				if (out.count == out.values.size()) FASTGLTF_UNLIKELY {
+					return Error::InvalidGltf;
+				}
+				if (element.get_number().get(out.values[out.count++]) != SUCCESS) FASTGLTF_UNLIKELY {
+					return Error::InvalidGltf;
+				}
+			}
+			return Error::None;
+		};
 
-	data.reset();
-	auto jsonSpan = data.read(data.totalSize(), SIMDJSON_PADDING);
-	padded_string_view view(reinterpret_cast<const std::uint8_t*>(jsonSpan.data()),
-									  data.totalSize(),
-									  data.totalSize() + SIMDJSON_PADDING);
-	dom::object root;
-    if (auto error = jsonParser->parse(view).get(root); error != SUCCESS) FASTGLTF_UNLIKELY {
-	    return Error::InvalidJson;
-    }
+		for (auto field : accessorObject) {
+			std::string_view key;
+			ondemand::value value;
+			if (field.escaped_key().get(key) != SUCCESS || field.value().get(value) != SUCCESS) FASTGLTF_UNLIKELY {
+				return Error::InvalidJson;
+			}
 
-	return parse(root, categories);
-}
+			std::uint64_t number;
+			Error error = Error::None;
+			switch (crcStringFunction(key)) {
+				case force_consteval<crc32c("componentType")>: {
+					if (value.get_uint64().get(number) != SUCCESS) FASTGLTF_UNLIKELY {
+						return Error::InvalidGltf;
+					}
+					accessor.componentType = getComponentType(static_cast<std::underlying_type_t<ComponentType>>(number));
+					hasComponentType = true;
+					break;
+				}
+				case force_consteval<crc32c("type")>: {
+					std::string_view accessorType;
+					if (value.get_string().get(accessorType) != SUCCESS) FASTGLTF_UNLIKELY {
+						return Error::InvalidGltf;
+					}
+					accessor.type = getAccessorType(accessorType);
+					hasType = true;
+					break;
+				}
+				case force_consteval<crc32c("count")>: {
+					if (value.get_uint64().get(number) != SUCCESS) FASTGLTF_UNLIKELY {
+						return Error::InvalidGltf;
+					}
+					accessor.count = static_cast<std::size_t>(number);
+					hasCount = true;
+					break;
+				}
+				case force_consteval<crc32c("bufferView")>: {
+					if (value.get_uint64().get(number) == SUCCESS) FASTGLTF_LIKELY {
+						accessor.bufferViewIndex = static_cast<std::size_t>(number);
+					}
+					break;
+				}
+				case force_consteval<crc32c("byteOffset")>: {
+					if (value.get_uint64().get(number) != SUCCESS) FASTGLTF_UNLIKELY {
+						return Error::InvalidGltf;
+					}
+					accessor.byteOffset = static_cast<std::size_t>(number);
+					break;
+				}
+				case force_consteval<crc32c("max")>: {
+					error = readBounds(value, bounds[0]);
+					break;
+				}
+				case force_consteval<crc32c("min")>: {
+					error = readBounds(value, bounds[1]);
+					break;
+				}
+				case force_consteval<crc32c("normalized")>: {
+					if (value.get_bool().get(accessor.normalized) != SUCCESS) FASTGLTF_UNLIKELY {
+						return Error::InvalidGltf;
+					}
+					break;
+				}
+				case force_consteval<crc32c("sparse")>: {
+					ondemand::object sparseObject;
+					if (value.get_object().get(sparseObject) == SUCCESS) FASTGLTF_LIKELY {
+						SparseAccessor sparse = {};
+						error = parseSparseAccessor(sparseObject, sparse);
+						accessor.sparse = sparse;
+					}
+					break;
+				}
+				case force_consteval<crc32c("name")>: {
+					std::string_view name;
+					if (value.get_string().get(name) == SUCCESS) {
+						assignWithResource(accessor.name, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(accessor.name), parser.resourceAllocator.get(), name));
+					}
+					break;
+				}
+				default:
+					break;
+			}
 
-fg::Expected<fg::Asset> fg::Parser::loadGltfBinary(GltfDataGetter& data, fs::path _directory, Options _options, Category categories) {
-    using namespace simdjson;
+			if (error != Error::None)
+				return error;
+		}
 
-	options = _options;
-	directory = std::move(_directory);
+		if (!hasComponentType || !hasType || !hasCount) FASTGLTF_UNLIKELY {
+			return Error::InvalidGltf;
+		}
+		if (accessor.componentType == ComponentType::Double && (!hasBit(parser.options, Options::AllowDouble) || !isExtensionEnabled(parser.config.extensions, Extensions::KHR_accessor_float64))) {
+			return Error::InvalidGltf;
+		}
 
-    // If we never have to load the files ourselves, we're fine with the directory being invalid/blank.
-    if (std::error_code ec; hasBit(options, Options::LoadExternalBuffers) && (!fs::is_directory(directory, ec) || ec)) {
-	    return Error::InvalidPath;
-    }
+		// Type of min and max should always be the same.
+		const auto num = getNumComponents(accessor.type);
+		const auto boundsType = accessor.componentType == ComponentType::Float || accessor.componentType == ComponentType::Double
+				? AccessorBoundsArray::BoundsType::float64 : AccessorBoundsArray::BoundsType::int64;
+		for (std::size_t i = 0; i < 2; ++i) {
+			if (!bounds[i].present)
+				continue;
+			if (bounds[i].count != num) FASTGLTF_UNLIKELY {
+				return Error::InvalidGltf;
+			}
 
-	data.reset();
+			auto& array = (i == 0 ? accessor.max : accessor.min).emplace(num, boundsType);
+			for (std::size_t idx = 0; idx < num; ++idx) {
+				auto& element = bounds[i].values[idx];
+				switch (element.get_number_type()) {
+					case ondemand::number_type::floating_point_number: {
+						if (array.isType<double>()) {
+							array.set(idx, element.get_double());
+						} else {
+							array.set(idx, static_cast<std::int64_t>(element.get_double()));
+						}
+						break;
+					}
+					case ondemand::number_type::signed_integer: {
+						if (array.isType<double>()) {
+							array.set(idx, static_cast<double>(element.get_int64()));
+						} else {
+							array.set(idx, element.get_int64());
+						}
+						break;
+					}
+					case ondemand::number_type::unsigned_integer: {
+						// See the DOM parser: larger values than 32-bits are not allowed by the glTF spec anyway.
+						if (array.isType<double>()) {
+							array.set(idx, static_cast<double>(element.get_uint64()));
+						} else {
+							array.set(idx, static_cast<std::int64_t>(element.get_uint64()));
+						}
+						break;
+					}
+					default: return Error::InvalidGltf;
+				}
+			}
+		}
 
-    auto header = readBinaryHeader(data);
-    if (header.magic != binaryGltfHeaderMagic) {
-	    return Error::InvalidGLB;
-    }
-	if (header.version != 2) {
-		return Error::UnsupportedVersion;
+		// This property MUST NOT be set to true for accessors with FLOAT or UNSIGNED_INT component type.
+		if (accessor.normalized && (accessor.componentType == ComponentType::UnsignedInt || accessor.componentType == ComponentType::Float)) {
+			return Error::InvalidGltf;
+		}
+
+		asset.accessors.emplace_back(std::move(accessor));
 	}
-    if (header.length > data.totalSize()) {
-	    return Error::InvalidGLB;
-    }
 
-    // The glTF 2 spec specifies that in GLB files the order of chunks is predefined. Specifically,
-    //  1. JSON chunk
-    //  2. BIN chunk (optional)
-    auto jsonChunk = readBinaryChunk(data);
-    if (jsonChunk.chunkType != binaryGltfJsonChunkMagic) {
-	    return Error::InvalidGLB;
-    }
+	return Error::None;
+}
 
-    // Create a string view of the JSON chunk in the GLB data buffer. The documentation of parse()
-    // says the padding can be initialised to anything, apparently. Therefore, this should work.
-	auto jsonSpan = data.read(jsonChunk.chunkLength, SIMDJSON_PADDING);
-    simdjson::padded_string_view jsonChunkView(reinterpret_cast<const std::uint8_t*>(jsonSpan.data()),
-                                               jsonChunk.chunkLength,
-                                               jsonChunk.chunkLength + SIMDJSON_PADDING);
+fg::Error fg::Parser::OnDemandParser::parseSparseAccessor(simdjson::ondemand::object& sparseObject, SparseAccessor& sparse) {
+	using namespace simdjson;
 
-	simdjson::dom::object root;
-    if (jsonParser->parse(jsonChunkView).get(root) != SUCCESS) FASTGLTF_UNLIKELY {
-	    return Error::InvalidJson;
-    }
+	bool hasCount = false, hasIndices = false, hasValues = false;
+	for (auto field : sparseObject) {
+		std::string_view key;
+		ondemand::value value;
+		if (field.escaped_key().get(key) != SUCCESS || field.value().get(value) != SUCCESS) FASTGLTF_UNLIKELY {
+			return Error::InvalidJson;
+		}
 
-    // Is there enough room for another chunk header?
-    if (header.length > (data.bytesRead() + sizeof(BinaryGltfChunk))) {
-        auto binaryChunk = readBinaryChunk(data);
+		std::uint64_t number;
+		const auto hashedKey = crcStringFunction(key);
+		if (hashedKey == force_consteval<crc32c("count")>) {
+			if (value.get_uint64().get(number) != SUCCESS) FASTGLTF_UNLIKELY {
+				return Error::InvalidGltf;
+			}
+			sparse.count = static_cast<std::size_t>(number);
+			hasCount = true;
+			continue;
+		}
 
-        if (binaryChunk.chunkType != binaryGltfDataChunkMagic) {
-	        return Error::InvalidGLB;
-        }
+		const bool isIndices = hashedKey == force_consteval<crc32c("indices")>;
+		if (!isIndices && hashedKey != force_consteval<crc32c("values")>)
+			continue;
 
-		// TODO: Somehow allow skipping the binary part in the future?
-		if (binaryChunk.chunkLength != 0) {
-			if (config.mapCallback != nullptr) {
-				auto info = config.mapCallback(binaryChunk.chunkLength, config.userPointer);
-				if (info.mappedMemory != nullptr) {
-					data.read(info.mappedMemory, binaryChunk.chunkLength);
-					if (config.unmapCallback != nullptr) {
-						config.unmapCallback(&info, config.userPointer);
+		// Accessor Sparse Indices and Values
+		ondemand::object child;
+		if (value.get_object().get(child) != SUCCESS) FASTGLTF_UNLIKELY {
+			return Error::InvalidGltf;
+		}
+
+		bool hasBufferView = false, hasComponentType = !isIndices;
+		for (auto childField : child) {
+			std::string_view childKey;
+			ondemand::value childValue;
+			if (childField.escaped_key().get(childKey) != SUCCESS || childField.value().get(childValue) != SUCCESS) FASTGLTF_UNLIKELY {
+				return Error::InvalidJson;
+			}
+
+			switch (crcStringFunction(childKey)) {
+				case force_consteval<crc32c("bufferView")>: {
+					if (childValue.get_uint64().get(number) != SUCCESS) FASTGLTF_UNLIKELY {
+						return Error::InvalidGltf;
 					}
-					glbBuffer = sources::CustomBuffer{info.customId, MimeType::None};
+					(isIndices ? sparse.indicesBufferView : sparse.valuesBufferView) = static_cast<std::size_t>(number);
+					hasBufferView = true;
+					break;
 				}
-			} else {
-				StaticVector<std::byte> binaryData(binaryChunk.chunkLength);
-				data.read(binaryData.data(), binaryChunk.chunkLength);
-
-				sources::Array vectorData = {
-					std::move(binaryData),
-					MimeType::GltfBuffer,
-				};
-				glbBuffer = std::move(vectorData);
+				case force_consteval<crc32c("byteOffset")>: {
+					if (childValue.get_uint64().get(number) != SUCCESS) FASTGLTF_UNLIKELY {
+						return Error::InvalidGltf;
+					}
+					(isIndices ? sparse.indicesByteOffset : sparse.valuesByteOffset) = static_cast<std::size_t>(number);
+					break;
+				}
+				case force_consteval<crc32c("componentType")>: {
+					if (!isIndices)
+						break;
+					if (childValue.get_uint64().get(number) != SUCCESS) FASTGLTF_UNLIKELY {
+						return Error::InvalidGltf;
+					}
+					sparse.indexComponentType = getComponentType(static_cast<std::underlying_type_t<ComponentType>>(number));
+					hasComponentType = true;
+					break;
+				}
+				default:
+					break;
 			}
 		}
-    }
 
-	return parse(root, categories);
-}
+		if (!hasBufferView || !hasComponentType) FASTGLTF_UNLIKELY {
+			return Error::InvalidGltf;
+		}
+		(isIndices ? hasIndices : hasValues) = true;
+	}
 
-void fg::Parser::setBufferAllocationCallback(BufferMapCallback* mapCallback, BufferUnmapCallback* unmapCallback) noexcept {
-	if (mapCallback == nullptr)
-		unmapCallback = nullptr;
-	config.mapCallback = mapCallback;
-	config.unmapCallback = unmapCallback;
+	if (!hasCount || !hasIndices || !hasValues) FASTGLTF_UNLIKELY {
+		return Error::InvalidGltf;
+	}
+	return Error::None;
 }
 
-void fg::Parser::setBase64DecodeCallback(Base64DecodeCallback* decodeCallback) noexcept {
-    config.decodeCallback = decodeCallback;
-}
+fg::Error fg::Parser::OnDemandParser::parseAnimations(Parser& parser, simdjson::ondemand::array& animations, Asset& asset) {
+	using namespace simdjson;
 
-void fg::Parser::setExtrasParseCallback(ExtrasParseCallback *extrasCallback) noexcept {
-	config.extrasCallback = extrasCallback;
-}
+	for (auto animationValue : animations) {
+		ondemand::object animationObject;
+		if (animationValue.get_object().get(animationObject) != SUCCESS) FASTGLTF_UNLIKELY {
+			return Error::InvalidGltf;
+		}
 
-void fg::Parser::setUserPointer(void* pointer) noexcept {
-    config.userPointer = pointer;
-}
-#pragma endregion
+		Animation animation = {};
+		assignWithResource(animation.channels, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(animation.channels), parser.resourceAllocator.get(), 0));
+		assignWithResource(animation.samplers, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(animation.samplers), parser.resourceAllocator.get(), 0));
+		bool hasChannels = false, hasSamplers = false;
 
-#pragma region Exporter
-void fg::prettyPrintJson(std::string& json) {
-    std::size_t i = 0;
-    std::size_t depth = 0;
-    auto insertNewline = [&i, &depth, &json]() {
-        json.insert(i, 1, '\n');
-        json.insert(i + 1, depth, '\t');
-        i += 1 + depth;
-    };
+		for (auto field : animationObject) {
+			std::string_view key;
+			ondemand::value value;
+			if (field.escaped_key().get(key) != SUCCESS || field.value().get(value) != SUCCESS) FASTGLTF_UNLIKELY {
+				return Error::InvalidJson;
+			}
 
-    while (i < json.size()) {
-        if (json[i] == '"') {
-            // Skip to the end of the string
-            do {
-                ++i;
-                if (json[i] == '"' && json[i - 1] != '\\') {
-                    break;
-                }
-            } while (true);
-            ++i; // Skip over the last "
-        }
+			switch (crcStringFunction(key)) {
+				case force_consteval<crc32c("channels")>: {
+					ondemand::array channels;
+					std::size_t channelCount;
+					if (value.get_array().get(channels) != SUCCESS || channels.count_elements().get(channelCount) != SUCCESS) FASTGLTF_UNLIKELY {
+						return Error::InvalidGltf;
+					}
 
-        switch (json[i]) {
-            case '{': case '[':
-                ++depth;
-                ++i; // Insert \n after the character
-                insertNewline();
-                break;
-            case '}': case ']':
-                --depth;
-                insertNewline();
-                ++i; // Insert \n before the character
-                break;
-            case ',':
-                ++i;  // Insert \n after the character
-                insertNewline();
-                break;
-            default:
-                ++i;
-                break;
-        }
-    }
-}
+					// The vectors live in the monotonic memory resource, so reserving avoids wasting memory.
+					animation.channels.reserve(channelCount);
+					for (auto channelValue : channels) {
+						ondemand::object channelObject;
+						if (channelValue.get_object().get(channelObject) != SUCCESS) FASTGLTF_UNLIKELY {
+							return Error::InvalidGltf;
+						}
 
-namespace fastgltf {
-	static void escapeString(std::string& string) {
-		std::size_t i = 0;
-		do {
-			switch (string[i]) {
-				case '\"': {
-					const std::string_view s = "\\\"";
-					string.replace(i, 1, s);
-					i += s.size();
+						AnimationChannel channel = {};
+						bool hasSampler = false, hasPath = false;
+						for (auto channelField : channelObject) {
+							std::string_view channelKey;
+							ondemand::value channelMember;
+							if (channelField.escaped_key().get(channelKey) != SUCCESS || channelField.value().get(channelMember) != SUCCESS) FASTGLTF_UNLIKELY {
+								return Error::InvalidJson;
+							}
+
+							const auto hashedKey = crcStringFunction(channelKey);
+							if (hashedKey == force_consteval<crc32c("sampler")>) {
+								std::uint64_t sampler;
+								if (channelMember.get_uint64().get(sampler) != SUCCESS) FASTGLTF_UNLIKELY {
+									return Error::InvalidGltf;
+								}
+								channel.samplerIndex = static_cast<std::size_t>(sampler);
+								hasSampler = true;
+							} else if (hashedKey == force_consteval<crc32c("target")>) {
+								ondemand::object targetObject;
+								if (channelMember.get_object().get(targetObject) != SUCCESS) FASTGLTF_UNLIKELY {
+									return Error::InvalidGltf;
+								}
+
+								for (auto targetField : targetObject) {
+									std::string_view targetKey;
+									ondemand::value targetMember;
+									if (targetField.escaped_key().get(targetKey) != SUCCESS || targetField.value().get(targetMember) != SUCCESS) FASTGLTF_UNLIKELY {
+										return Error::InvalidJson;
+									}
+
+									const auto hashedTargetKey = crcStringFunction(targetKey);
+									if (hashedTargetKey == force_consteval<crc32c("node")>) {
+										// The node index is allowed to be absent, see the DOM parser.
+										std::uint64_t node;
+										if (targetMember.get_uint64().get(node) != SUCCESS) FASTGLTF_UNLIKELY {
+											return Error::InvalidGltf;
+										}
+										channel.nodeIndex = static_cast<std::size_t>(node);
+									} else if (hashedTargetKey == force_consteval<crc32c("path")>) {
+										std::string_view path;
+										if (targetMember.get_string().get(path) != SUCCESS) FASTGLTF_UNLIKELY {
+											return Error::InvalidGltf;
+										}
+
+										if (path == "translation") {
+											channel.path = AnimationPath::Translation;
+										} else if (path == "rotation") {
+											channel.path = AnimationPath::Rotation;
+										} else if (path == "scale") {
+											channel.path = AnimationPath::Scale;
+										} else if (path == "weights") {
+											channel.path = AnimationPath::Weights;
+										}
+										hasPath = true;
+									}
+								}
+							}
+						}
+
+						if (!hasSampler || !hasPath) FASTGLTF_UNLIKELY {
+							return Error::InvalidGltf;
+						}
+						animation.channels.emplace_back(channel);
+					}
+					hasChannels = true;
 					break;
 				}
-				case '\\': {
-					const std::string_view s = "\\\\";
-					string.replace(i, 1, s);
-					i += s.size();
-					break;
-				}
-			}
-			++i;
-		} while (i < string.size());
-	}
-
-	/**
-	 * Normalizes the path using lexically_normal, calls generic_string to always use forward slashes,
-	 * and escapes any necessary characters.
-	 */
-	static std::string normalizeAndFormatPath(fs::path& path) {
-		auto string = path.lexically_normal().generic_string();
-		escapeString(string);
-		return string;
-	}
+				case force_consteval<crc32c("samplers")>: {
+					ondemand::array samplers;
+					std::size_t samplerCount;
+					if (value.get_array().get(samplers) != SUCCESS || samplers.count_elements().get(samplerCount) != SUCCESS) FASTGLTF_UNLIKELY {
+						return Error::InvalidGltf;
+					}
 
-	// replacement for std::to_string that uses simdjson's grisu2 implementation, which is
-	// (1) bidirectionally lossless (std::to_string is not)
-	// (2) quite a lot faster than std::to_chars and std::to_string.
-	std::string to_string_fp(const num& value) {
-		char buffer[30] = {};
+					animation.samplers.reserve(samplerCount);
+					for (auto samplerValue : samplers) {
+						ondemand::object samplerObject;
+						if (samplerValue.get_object().get(samplerObject) != SUCCESS) FASTGLTF_UNLIKELY {
+							return Error::InvalidGltf;
+						}
 
-		// TODO: Include a own copy of grisu2 instead of accessing functions from simdjson's internal namespace?
-		auto* end = simdjson::internal::to_chars(std::begin(buffer), std::end(buffer), value);
-		return {std::begin(buffer), end};
-	}
+						AnimationSampler sampler = {};
+						sampler.interpolation = AnimationInterpolation::Linear;
+						bool hasInput = false, hasOutput = false;
+						for (auto samplerField : samplerObject) {
+							std::string_view samplerKey;
+							ondemand::value samplerMember;
+							if (samplerField.escaped_key().get(samplerKey) != SUCCESS || samplerField.value().get(samplerMember) != SUCCESS) FASTGLTF_UNLIKELY {
+								return Error::InvalidJson;
+							}
 
-	void writeTextureInfo(std::string& json, const TextureInfo* info, const TextureInfoType type = TextureInfoType::Standard) {
-		json += '{';
-		json += "\"index\":" + std::to_string(info->textureIndex);
-		if (info->texCoordIndex != 0) {
-			json += ",\"texCoord\":" + std::to_string(info->texCoordIndex);
-		}
-		if (type == TextureInfoType::NormalTexture) {
-			json += ",\"scale\":" + to_string_fp(reinterpret_cast<const NormalTextureInfo*>(info)->scale);
-		} else if (type == TextureInfoType::OcclusionTexture) {
-			json += ",\"strength\":" + to_string_fp(reinterpret_cast<const OcclusionTextureInfo*>(info)->strength);
-		}
+							std::uint64_t index;
+							switch (crcStringFunction(samplerKey)) {
+								case force_consteval<crc32c("input")>: {
+									if (samplerMember.get_uint64().get(index) != SUCCESS) FASTGLTF_UNLIKELY {
+										return Error::InvalidGltf;
+									}
+									sampler.inputAccessor = static_cast<std::size_t>(index);
+									hasInput = true;
+									break;
+								}
+								case force_consteval<crc32c("output")>: {
+									if (samplerMember.get_uint64().get(index) != SUCCESS) FASTGLTF_UNLIKELY {
+										return Error::InvalidGltf;
+									}
+									sampler.outputAccessor = static_cast<std::size_t>(index);
+									hasOutput = true;
+									break;
+								}
+								case force_consteval<crc32c("interpolation")>: {
+									std::string_view interpolation;
+									if (samplerMember.get_string().get(interpolation) != SUCCESS) FASTGLTF_UNLIKELY {
+										break;
+									}
+
+									if (interpolation == "LINEAR") {
+										sampler.interpolation = AnimationInterpolation::Linear;
+									} else if (interpolation == "STEP") {
+										sampler.interpolation = AnimationInterpolation::Step;
+									} else if (interpolation == "CUBICSPLINE") {
+										sampler.interpolation = AnimationInterpolation::CubicSpline;
+									} else {
+										return Error::InvalidGltf;
+									}
+									break;
+								}
+								default:
+									break;
+							}
+						}
 
-		if (info->transform != nullptr) {
-			json += R"(,"extensions":{"KHR_texture_transform":{)";
-			const auto& transform = *info->transform;
-			if (transform.uvOffset[0] != 0.0 || transform.uvOffset[1] != 0.0) {
-				json += "\"offset\":[" + to_string_fp(transform.uvOffset[0]) + ',' + to_string_fp(transform.uvOffset[1]) + ']';
-			}
-			if (transform.rotation != 0.0) {
-				if (json.back() != '{') json += ',';
-				json += "\"rotation\":" + to_string_fp(transform.rotation);
-			}
-			if (transform.uvScale[0] != 1.0 || transform.uvScale[1] != 1.0) {
-				if (json.back() != '{') json += ',';
-				json += "\"scale\":[" + to_string_fp(transform.uvScale[0]) + ',' + to_string_fp(transform.uvScale[1]) + ']';
-			}
-			if (transform.texCoordIndex.has_value()) {
-				if (json.back() != '{') json += ',';
-				json += "\"texCoord\":" + std::to_string(transform.texCoordIndex.value());
+						if (!hasInput || !hasOutput) FASTGLTF_UNLIKELY {
+							return Error::InvalidGltf;
+						}
+						animation.samplers.emplace_back(sampler);
+					}
+					hasSamplers = true;
+					break;
+				}
+				case force_consteval<crc32c("name")>: {
+					std::string_view name;
+					if (value.get_string().get(name) == SUCCESS) {
+						assignWithResource(animation.name, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(animation.name), parser.resourceAllocator.get(), name));
+					}
+					break;
+				}
+				default:
+					break;
 			}
-			json += "}}";
 		}
 
-		json += '}';
+		if (!hasChannels || !hasSamplers) FASTGLTF_UNLIKELY {
+			return Error::InvalidGltf;
+		}
+		asset.animations.emplace_back(std::move(animation));
 	}
-} // namespace fastgltf
-
-std::string fg::escapeString(std::string_view string) {
-    std::string ret(string);
-	escapeString(ret);
-    return ret;
-}
-
-void fg::Exporter::setBufferPath(fs::path folder) {
-    if (!folder.is_relative()) {
-        return;
-    }
-    bufferFolder = std::move(folder);
-}
 
-void fg::Exporter::setImagePath(fs::path folder) {
-    if (!folder.is_relative()) {
-        return;
-    }
-    imageFolder = std::move(folder);
-}
-
-void fg::Exporter::setExtrasWriteCallback(ExtrasWriteCallback* callback) noexcept {
-	extrasWriteCallback = callback;
-}
-
-void fg::Exporter::setUserPointer(void* pointer) noexcept {
-	userPointer = pointer;
+	return Error::None;
 }
 
-void fg::Exporter::writeAccessors(const Asset& asset, std::string& json) {
-	if (asset.accessors.empty())
-		return;
-	if (json.back() == ']' || json.back() == '}')
-		json += ',';
-
-	json += R"("accessors":[)";
-	for (auto it = asset.accessors.begin(); it != asset.accessors.end(); ++it) {
-		json += '{';
+fg::Error fg::Parser::OnDemandParser::parseBufferViews(Parser& parser, simdjson::ondemand::array& bufferViews, Asset& asset) {
+	using namespace simdjson;
 
-		if (it->byteOffset != 0) {
-			json += "\"byteOffset\":" + std::to_string(it->byteOffset) + ',';
+	for (auto bufferViewValue : bufferViews) {
+		ondemand::object bufferViewObject;
+		if (bufferViewValue.get_object().get(bufferViewObject) != SUCCESS) FASTGLTF_UNLIKELY {
+			return Error::InvalidGltf;
 		}
 
-		json += "\"count\":" + std::to_string(it->count) + ',';
-		json += R"("type":")" + std::string(getAccessorTypeName(it->type)) + "\",";
-		json += "\"componentType\":" + std::to_string(getGLComponentType(it->componentType));
+		BufferView view;
+		bool hasBuffer = false, hasByteLength = false;
+		for (auto field : bufferViewObject) {
+			std::string_view key;
+			ondemand::value value;
+			if (field.escaped_key().get(key) != SUCCESS || field.value().get(value) != SUCCESS) FASTGLTF_UNLIKELY {
+				return Error::InvalidJson;
+			}
 
-		if (it->normalized) {
-			json += ",\"normalized\":true";
-		}
+			std::uint64_t number;
+			switch (crcStringFunction(key)) {
+				case force_consteval<crc32c("buffer")>: {
+					if (value.get_uint64().get(number) != SUCCESS) FASTGLTF_UNLIKELY {
+						return Error::InvalidJson;
+					}
+					view.bufferIndex = static_cast<std::size_t>(number);
+					hasBuffer = true;
+					break;
+				}
+				case force_consteval<crc32c("byteOffset")>: {
+					if (value.get_uint64().get(number) != SUCCESS) FASTGLTF_UNLIKELY {
+						return Error::InvalidJson;
+					}
+					view.byteOffset = static_cast<std::size_t>(number);
+					break;
+				}
+				case force_consteval<crc32c("byteLength")>: {
+					if (value.get_uint64().get(number) != SUCCESS) FASTGLTF_UNLIKELY {
+						return Error::InvalidJson;
+					}
+					view.byteLength = static_cast<std::size_t>(number);
+					hasByteLength = true;
+					break;
+				}
+				case force_consteval<crc32c("byteStride")>: {
+					if (value.get_uint64().get(number) != SUCCESS) FASTGLTF_UNLIKELY {
+						return Error::InvalidJson;
+					}
+					view.byteStride = static_cast<std::size_t>(number);
+					break;
+				}
+				case force_consteval<crc32c("target")>: {
+					if (value.get_uint64().get(number) != SUCCESS) FASTGLTF_UNLIKELY {
+						return Error::InvalidJson;
+					}
+					view.target = static_cast<BufferTarget>(number);
+					break;
+				}
+				case force_consteval<crc32c("name")>: {
+					std::string_view name;
+					if (value.get_string().get(name) != SUCCESS) FASTGLTF_UNLIKELY {
+						return Error::InvalidJson;
+					}
+					assignWithResource(view.name, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(view.name), parser.resourceAllocator.get(), name));
+					break;
+				}
+				case force_consteval<crc32c("extensions")>: {
+					ondemand::object extensionsObject;
+					if (!isExtensionEnabled(parser.config.extensions, Extensions::EXT_meshopt_compression) || value.get_object().get(extensionsObject) != SUCCESS)
+						break;
 
-		if (it->bufferViewIndex.has_value()) {
-			json += ",\"bufferView\":" + std::to_string(it->bufferViewIndex.value());
-		}
+					for (auto extension : extensionsObject) {
+						std::string_view extensionKey;
+						ondemand::value extensionValue;
+						if (extension.escaped_key().get(extensionKey) != SUCCESS || extension.value().get(extensionValue) != SUCCESS) FASTGLTF_UNLIKELY {
+							return Error::InvalidJson;
+						}
 
-		auto writeMinMax = [&](const std::optional<AccessorBoundsArray>& ref, const std::string_view name) {
-			if (!ref.has_value())
-				return; // This is valid, since min/max are only required on specific accessors.
-			json += ",\"" + std::string(name) + "\":[";
+						ondemand::object compressionObject;
+						if (extensionKey != extensions::EXT_meshopt_compression || extensionValue.get_object().get(compressionObject) != SUCCESS)
+							continue;
 
-			for (std::size_t i = 0; i < ref->size(); ++i) {
-				if (ref->isType<double>()) {
-					json += to_string_fp(static_cast<num>(ref->get<double>(i)));
-				} else if (ref->isType<std::int64_t>()) {
-					json += std::to_string(ref->get<std::int64_t>(i));
+						auto compression = std::make_unique<CompressedBufferView>();
+						if (auto error = parseMeshoptCompression(compressionObject, *compression); error != Error::None) {
+							return error;
+						}
+						view.meshoptCompression = std::move(compression);
+					}
+					break;
 				}
-				if (i + 1 < ref->size())
-					json += ',';
-			}
-			json += ']';
-		};
-		writeMinMax(it->max, "max");
-		writeMinMax(it->min, "min");
-
-		if (extrasWriteCallback != nullptr) {
-			auto extras = extrasWriteCallback(uabs(std::distance(asset.accessors.begin(), it)), fastgltf::Category::Accessors, userPointer);
-			if (extras.has_value()) {
-				json += std::string(",\"extras\":") + *extras;
+				default:
+					break;
 			}
 		}
 
-		if (!it->name.empty())
-			json += R"(,"name":")" + fg::escapeString(it->name) + '"';
-
-		json += '}';
-		if (uabs(std::distance(asset.accessors.begin(), it)) + 1 <asset.accessors.size())
-			json += ',';
+		if (!hasBuffer || !hasByteLength) FASTGLTF_UNLIKELY {
+			return Error::InvalidGltf;
+		}
+		asset.bufferViews.emplace_back(std::move(view));
 	}
-	json += ']';
+
+	return Error::None;
 }
 
-void fg::Exporter::writeAnimations(const Asset& asset, std::string& json)
-{
-	if (asset.animations.empty())
-		return;
-	if (json.back() == ']' || json.back() == '}')
-		json += ',';
+fg::Error fg::Parser::OnDemandParser::parseMeshoptCompression(simdjson::ondemand::object& compressionObject, CompressedBufferView& compression) {
+	using namespace simdjson;
 
-	json += R"("animations":[)";
-	for (auto it = asset.animations.begin(); it != asset.animations.end(); ++it) {
-		json += '{';
+	enum RequiredField : std::uint8_t {
+		Buffer = 1 << 0, ByteLength = 1 << 1, ByteStride = 1 << 2, Count = 1 << 3, Mode = 1 << 4,
+		All = Buffer | ByteLength | ByteStride | Count | Mode,
+	};
+	std::uint8_t fields = 0;
+
+	compression.byteOffset = 0;
+	compression.filter = MeshoptCompressionFilter::None;
+	for (auto field : compressionObject) {
+		std::string_view key;
+		ondemand::value value;
+		if (field.escaped_key().get(key) != SUCCESS || field.value().get(value) != SUCCESS) FASTGLTF_UNLIKELY {
+			return Error::InvalidJson;
+		}
 
-		json += R"("channels":[)";
-		for (auto ci = it->channels.begin(); ci != it->channels.end(); ++ci) {
-			json += "{";
-			json += R"("sampler":)" + std::to_string(ci->samplerIndex) + ",";
-			json += R"("target":{)";
-			if (ci->nodeIndex.has_value()) {
-				json += R"("node":)" + std::to_string(ci->nodeIndex.value()) + ",";
+		std::uint64_t number;
+		std::string_view string;
+		switch (crcStringFunction(key)) {
+			case force_consteval<crc32c("buffer")>: {
+				if (value.get_uint64().get(number) != SUCCESS) FASTGLTF_UNLIKELY {
+					return Error::InvalidJson;
+				}
+				compression.bufferIndex = static_cast<std::size_t>(number);
+				fields |= Buffer;
+				break;
 			}
-			json += R"("path":")";
-			switch (ci->path) {
-			case fg::AnimationPath::Translation:
-				json += "translation";
+			case force_consteval<crc32c("byteOffset")>: {
+				if (value.get_uint64().get(number) != SUCCESS) FASTGLTF_UNLIKELY {
+					return Error::InvalidJson;
+				}
+				compression.byteOffset = static_cast<std::size_t>(number);
 				break;
-			case fg::AnimationPath::Rotation:
-				json += "rotation";
+			}
+			case force_consteval<crc32c("byteLength")>: {
+				if (value.get_uint64().get(number) != SUCCESS) FASTGLTF_UNLIKELY {
+					return Error::InvalidJson;
+				}
+				compression.byteLength = static_cast<std::size_t>(number);
+				fields |= ByteLength;
 				break;
-			case fg::AnimationPath::Scale:
-				json += "scale";
+			}
+			case force_consteval<crc32c("byteStride")>: {
+				if (value.get_uint64().get(number) != SUCCESS) FASTGLTF_UNLIKELY {
+					return Error::InvalidJson;
+				}
+				compression.byteStride = static_cast<std::size_t>(number);
+				fields |= ByteStride;
 				break;
-			case fg::AnimationPath::Weights:
-				json += "weights";
+			}
+			case force_consteval<crc32c("count")>: {
+				if (value.get_uint64().get(number) != SUCCESS) FASTGLTF_UNLIKELY {
+					return Error::InvalidJson;
+				}
+				compression.count = number;
+				fields |= Count;
 				break;
 			}
-			json += "\"}}";
-
-			if (uabs(std::distance(it->channels.begin(), ci)) + 1 < it->channels.size())
-				json += ',';
-		}
-		json += "],";
-
-		json += R"("samplers":[)";
-		for (auto si = it->samplers.begin(); si != it->samplers.end(); ++si) {
-			json += '{';
-			json += R"("input":)" + std::to_string(si->inputAccessor) + ',';
-
-			if (si->interpolation != fg::AnimationInterpolation::Linear) {
-				json += R"("interpolation":")";
-				if (si->interpolation == fg::AnimationInterpolation::Step) {
-					json += "STEP\",";
-				} else {
-					json += "CUBICSPLINE\",";
+			case force_consteval<crc32c("mode")>: {
+				if (value.get_string().get(string) != SUCCESS) FASTGLTF_UNLIKELY {
+					return Error::InvalidJson;
 				}
+				switch (crcStringFunction(string)) {
+					case force_consteval<crc32c("ATTRIBUTES")>: compression.mode = MeshoptCompressionMode::Attributes; break;
+					case force_consteval<crc32c("TRIANGLES")>: compression.mode = MeshoptCompressionMode::Triangles; break;
+					case force_consteval<crc32c("INDICES")>: compression.mode = MeshoptCompressionMode::Indices; break;
+					default: return Error::InvalidGltf;
+				}
+				fields |= Mode;
+				break;
 			}
-
-			json += R"("output":)" + std::to_string(si->outputAccessor);
-			json += '}';
-
-			if (uabs(std::distance(it->samplers.begin(), si)) + 1 < it->samplers.size())
-				json += ',';
-		}
-		json += ']';
-
-		if (extrasWriteCallback != nullptr) {
-			auto extras = extrasWriteCallback(uabs(std::distance(asset.animations.begin(), it)), fastgltf::Category::Animations, userPointer);
-			if (extras.has_value()) {
-				json += std::string(",\"extras\":") + *extras;
+			case force_consteval<crc32c("filter")>: {
+				if (value.get_string().get(string) != SUCCESS) FASTGLTF_UNLIKELY {
+					return Error::InvalidJson;
+				}
+				switch (crcStringFunction(string)) {
+					case force_consteval<crc32c("NONE")>: compression.filter = MeshoptCompressionFilter::None; break;
+					case force_consteval<crc32c("OCTAHEDRAL")>: compression.filter = MeshoptCompressionFilter::Octahedral; break;
+					case force_consteval<crc32c("QUATERNION")>: compression.filter = MeshoptCompressionFilter::Quaternion; break;
+					case force_consteval<crc32c("EXPONENTIAL")>: compression.filter = MeshoptCompressionFilter::Exponential; break;
+					default: return Error::InvalidGltf;
+				}
+				break;
 			}
+			default:
+				break;
 		}
+	}
 
-		if (!it->name.empty())
-			json += R"(,"name":")" + fg::escapeString(it->name) + '"';
-
-		json += '}';
-		if (uabs(std::distance(asset.animations.begin(), it)) + 1 < asset.animations.size())
-			json += ',';
+	if (fields != All || !hasValidMeshoptStride(compression)) FASTGLTF_UNLIKELY {
+		return Error::InvalidGltf;
 	}
-	json += ']';
+	return Error::None;
 }
 
-void fg::Exporter::writeBuffers(const Asset& asset, std::string& json) {
-	if (asset.buffers.empty())
-		return;
-	if (json.back() == ']' || json.back() == '}')
-		json += ',';
+fg::Expected<fg::Asset> fg::Parser::parseOnDemand(span<const std::byte> json, Category categories) {
+	using namespace simdjson;
+	fillCategories(categories);
 
-	json += "\"buffers\":[";
-	for (auto it = asset.buffers.begin(); it != asset.buffers.end(); ++it) {
-		json += '{';
+	if (onDemandParser == nullptr) {
+		onDemandParser = std::make_unique<OnDemandParser>();
+	}
+	auto& onDemand = *onDemandParser;
 
-        auto bufferIdx = uabs(std::distance(asset.buffers.begin(), it));
-		std::visit(visitor {
-			[&](auto&) {
-				// Covers BufferView and CustomBuffer.
-				errorCode = Error::InvalidGltf;
-			},
-			[&]([[maybe_unused]] const sources::Array& vector) {
-                if (bufferIdx == 0 && exportingBinary) {
-                    bufferPaths.emplace_back(std::nullopt);
-                    return;
-                }
-                auto path = getBufferFilePath(asset, bufferIdx);
-                json += std::string(R"("uri":")") + fg::normalizeAndFormatPath(path) + '"' + ',';
-                bufferPaths.emplace_back(path);
-			},
-			[&]([[maybe_unused]] const sources::Vector& vector) {
-				if (bufferIdx == 0 && exportingBinary) {
-					bufferPaths.emplace_back(std::nullopt);
-					return;
-				}
-				auto path = getBufferFilePath(asset, bufferIdx);
-				json += std::string(R"("uri":")") + fg::normalizeAndFormatPath(path) + '"' + ',';
-				bufferPaths.emplace_back(path);
-			},
-			[&]([[maybe_unused]] const sources::ByteView& view) {
-				if (bufferIdx == 0 && exportingBinary) {
-					bufferPaths.emplace_back(std::nullopt);
-					return;
-				}
-                auto path = getBufferFilePath(asset, bufferIdx);
-                json += std::string(R"("uri":")") + fg::normalizeAndFormatPath(path) + '"' + ',';
-                bufferPaths.emplace_back(path);
-			},
-			[&](const sources::URI& uri) {
-				json += std::string(R"("uri":")") + fg::escapeString(uri.uri.string()) + '"' + ',';
-                bufferPaths.emplace_back(std::nullopt);
-			},
-			[&]([[maybe_unused]] const sources::Fallback& fallback) {
-				json += R"("extensions":{"EXT_meshopt_compression":{"fallback":true}},)";
-				bufferPaths.emplace_back(std::nullopt);
-			},
-		}, it->data);
+	Asset asset {};
 
-		json += "\"byteLength\":" + std::to_string(it->byteLength);
+#if !FASTGLTF_DISABLE_CUSTOM_MEMORY_POOL
+	// Create a new arena for each asset we parse. Its chunks come from the parser's chunk pool.
+	asset.memoryResource = resourceAllocator = createArena();
+#endif
+	asset.dataOwner = std::move(glbBufferOwner);
+	deferredFileLoads.clear();
 
-		if (extrasWriteCallback != nullptr) {
-			auto extras = extrasWriteCallback(uabs(std::distance(asset.buffers.begin(), it)), fastgltf::Category::Buffers, userPointer);
-			if (extras.has_value()) {
-				json += std::string(",\"extras\":") + *extras;
-			}
-		}
+	const auto* data = reinterpret_cast<const std::uint8_t*>(json.data());
+	padded_string_view view(data, json.size(), json.size() + SIMDJSON_PADDING);
+	onDemand.documentEnd = data + json.size() + SIMDJSON_PADDING;
 
-		if (!it->name.empty())
-			json += R"(,"name":")" + fg::escapeString(it->name) + '"';
-		json += '}';
-		if (uabs(std::distance(asset.buffers.begin(), it)) + 1 <asset.buffers.size())
-			json += ',';
+	ondemand::document document;
+	ondemand::object root;
+	if (onDemand.jsonParser.iterate(view).get(document) != SUCCESS || document.get_object().get(root) != SUCCESS) FASTGLTF_UNLIKELY {
+		return Error::InvalidJson;
 	}
-	json += "]";
-}
 
-void fg::Exporter::writeBufferViews(const Asset& asset, std::string& json) {
-	if (asset.bufferViews.empty())
-		return;
-	if (json.back() == ']' || json.back() == '}')
-		json += ',';
+	// Everything is handled in the order it appears within the document. Therefore, unlike the DOM
+	// parser, the asset member and the required extensions are only checked once they are reached.
+	const bool requireAssetInfo = !hasBit(options, Options::DontRequireValidAssetMember);
+	bool hasAssetInfo = false;
+	Category readCategories = Category::None;
+	for (auto field : root) {
+		std::string_view key;
+		ondemand::value value;
+		if (field.escaped_key().get(key) != SUCCESS || field.value().get(value) != SUCCESS) FASTGLTF_UNLIKELY {
+			return Error::InvalidJson;
+		}
 
-	json += "\"bufferViews\":[";
-	for (auto it = asset.bufferViews.begin(); it != asset.bufferViews.end(); ++it) {
-		json += '{';
+		auto hashedKey = crcStringFunction(key);
+		if (hashedKey == force_consteval<crc32c("asset")>) {
+			if (!requireAssetInfo)
+				continue;
 
-		json += "\"buffer\":" + std::to_string(it->bufferIndex) + ',';
-		json += "\"byteLength\":" + std::to_string(it->byteLength);
+			ondemand::object assetObject;
+			if (value.get_object().get(assetObject) != SUCCESS) FASTGLTF_UNLIKELY {
+				return Error::InvalidJson;
+			}
 
-		if (it->byteOffset != 0) {
-			json += ",\"byteOffset\":" + std::to_string(it->byteOffset);
+			AssetInfo info = {};
+			if (auto error = onDemand.parseAssetInfo(assetObject, info); error != Error::None) {
+				return error;
+			}
+			asset.assetInfo = std::move(info);
+			hasAssetInfo = true;
+			continue;
 		}
 
-		if (it->byteStride.has_value()) {
-			json += ",\"byteStride\":" + std::to_string(it->byteStride.value());
+		if (hashedKey == force_consteval<crc32c("scene")>) {
+			std::uint64_t defaultScene;
+			if (value.get_uint64().get(defaultScene) != SUCCESS) FASTGLTF_UNLIKELY {
+				return Error::InvalidGltf;
+			}
+			asset.defaultScene = static_cast<std::size_t>(defaultScene);
+			continue;
 		}
 
-		if (it->target.has_value()) {
-			json += ",\"target\":" + std::to_string(to_underlying(it->target.value()));
+		if (hashedKey == force_consteval<crc32c("extensions")>) {
+			dom::element element;
+			dom::object extensionsObject;
+			if (auto error = onDemand.parseSlice(*this, value, element); error != Error::None) {
+				return error;
+			}
+			if (element.get_object().get(extensionsObject) != SUCCESS) FASTGLTF_UNLIKELY {
+				return Error::InvalidGltf;
+			}
+
+			if (auto error = parseExtensions(extensionsObject, asset); error != Error::None)
+				return error;
+			continue;
 		}
 
-        if (it->meshoptCompression != nullptr) {
-            json += R"(,"extensions":{"EXT_meshopt_compression":{)";
-            const auto& meshopt = *it->meshoptCompression;
-            json += "\"buffer\":" + std::to_string(meshopt.bufferIndex);
-            if (meshopt.byteOffset != 0) {
-                json += ",\"byteOffset\":" + std::to_string(meshopt.byteOffset);
-            }
-            json += ",\"byteLength\":" + std::to_string(meshopt.byteLength);
-            json += ",\"byteStride\":" + std::to_string(meshopt.byteStride);
-            json += ",\"count\":" + std::to_string(meshopt.count);
+		if (hashedKey == force_consteval<crc32c("extras")>) {
+			continue;
+		}
 
-            json += ",\"mode\":";
-            if (meshopt.mode == MeshoptCompressionMode::Attributes) {
-                json += "\"ATTRIBUTES\"";
-            } else if (meshopt.mode == MeshoptCompressionMode::Triangles) {
-                json += "\"TRIANGLES\"";
-            } else if (meshopt.mode == MeshoptCompressionMode::Indices) {
-                json += "\"INDICES\"";
+		ondemand::json_type type;
+		if (value.type().get(type) != SUCCESS || type != ondemand::json_type::array) FASTGLTF_UNLIKELY {
+			return Error::InvalidGltf;
+		}
+
+// The categories holding most of the data are converted straight from the On-Demand values.
+#define ONDEMAND_KEY_SWITCH_CASE(name, id) case force_consteval<crc32c(FASTGLTF_QUOTE(id))>: { \
+                if (hasBit(categories, Category::name)) {                                     \
+                    ondemand::array array;                                                     \
+                    if (value.get_array().get(array) != SUCCESS) FASTGLTF_UNLIKELY {           \
+                        return Error::InvalidJson;                                             \
+                    }                                                                          \
+                    error = onDemand.parse##name(*this, array, asset);                         \
+                }                                                                              \
+                readCategories |= Category::name;                                              \
+                break;                                                                         \
             }
-            if (meshopt.filter != MeshoptCompressionFilter::None) {
-                json += ",\"filter\":";
-                if (meshopt.filter == MeshoptCompressionFilter::Exponential) {
-                    json += "\"EXPONENTIAL\"";
-                } else if (meshopt.filter == MeshoptCompressionFilter::Quaternion) {
-                    json += "\"QUATERNION\"";
-                } else if (meshopt.filter == MeshoptCompressionFilter::Octahedral) {
-                    json += "\"OCTAHEDRAL\"";
-                }
+
+// Every other category is small in comparison, and is therefore parsed into a DOM on its own.
+#define KEY_SWITCH_CASE(name, id) case force_consteval<crc32c(FASTGLTF_QUOTE(id))>: {          \
+                if (hasBit(categories, Category::name)) {                                     \
+                    dom::element element;                                                      \
+                    dom::array array;                                                          \
+                    error = onDemand.parseSlice(*this, value, element);                        \
+                    if (error == Error::None) {                                                \
+                        if (element.get_array().get(array) != SUCCESS) FASTGLTF_UNLIKELY {     \
+                            return Error::InvalidGltf;                                         \
+                        }                                                                      \
+                        error = parse##name(array, asset);                                     \
+                    }                                                                          \
+                }                                                                              \
+                readCategories |= Category::name;                                              \
+                break;                                                                         \
             }
-            json += "}}";
-        }
 
-		if (extrasWriteCallback != nullptr) {
-			auto extras = extrasWriteCallback(uabs(std::distance(asset.bufferViews.begin(), it)), fastgltf::Category::BufferViews, userPointer);
-			if (extras.has_value()) {
-				json += std::string(",\"extras\":") + *extras;
+		Error error = Error::None;
+		switch (hashedKey) {
+			ONDEMAND_KEY_SWITCH_CASE(Accessors, accessors)
+			ONDEMAND_KEY_SWITCH_CASE(Animations, animations)
+			KEY_SWITCH_CASE(Buffers, buffers)
+			ONDEMAND_KEY_SWITCH_CASE(BufferViews, bufferViews)
+			KEY_SWITCH_CASE(Cameras, cameras)
+			KEY_SWITCH_CASE(Images, images)
+			KEY_SWITCH_CASE(Materials, materials)
+			KEY_SWITCH_CASE(Meshes, meshes)
+			KEY_SWITCH_CASE(Nodes, nodes)
+			KEY_SWITCH_CASE(Samplers, samplers)
+			KEY_SWITCH_CASE(Scenes, scenes)
+			KEY_SWITCH_CASE(Skins, skins)
+			KEY_SWITCH_CASE(Textures, textures)
+			case force_consteval<crc32c("extensionsUsed")>:
+			case force_consteval<crc32c("extensionsRequired")>: {
+				const bool required = hashedKey == force_consteval<crc32c("extensionsRequired")>;
+				ondemand::array array;
+				if (value.get_array().get(array) != SUCCESS) FASTGLTF_UNLIKELY {
+					return Error::InvalidJson;
+				}
+
+				for (auto extensionValue : array) {
+					std::string_view extension;
+					if (extensionValue.get_string().get(extension) != SUCCESS) FASTGLTF_UNLIKELY {
+						return Error::InvalidGltf;
+					}
+					if (required) {
+						if (error = checkRequiredExtension(extension, config.extensions); error != Error::None) {
+							return error;
+						}
+					}
+
+					FASTGLTF_STD_PMR_NS::string FASTGLTF_CONSTRUCT_PMR_RESOURCE(string, resourceAllocator.get(), extension);
+					(required ? asset.extensionsRequired : asset.extensionsUsed).emplace_back(std::move(string));
+				}
+				break;
 			}
+			default:
+				break;
 		}
 
-		if (!it->name.empty())
-			json += R"(,"name":")" + fg::escapeString(it->name) + '"';
+		if (error != Error::None)
+			return error;
 
-		json += '}';
-		if (uabs(std::distance(asset.bufferViews.begin(), it)) + 1 <asset.bufferViews.size())
-			json += ',';
+#undef KEY_SWITCH_CASE
+#undef ONDEMAND_KEY_SWITCH_CASE
 	}
-	json += ']';
+
+	if (requireAssetInfo && !hasAssetInfo) {
+		return Error::InvalidOrMissingAssetField;
+	}
+	if (!document.at_end()) FASTGLTF_UNLIKELY {
+		return Error::InvalidJson;
+	}
+
+	if (auto error = finishCategories(asset, readCategories); error != Error::None) {
+		return error;
+	}
+
+#if !FASTGLTF_DISABLE_CUSTOM_MEMORY_POOL
+	collectMemoryStatistics(asset);
+#endif
+
+	return std::move(asset);
 }
+#pragma endregion
 
-void fg::Exporter::writeCameras(const Asset& asset, std::string& json) {
-	if (asset.cameras.empty())
-		return;
-	if (json.back() == ']' || json.back() == '}')
-		json += ',';
+#pragma region Parser
+fastgltf::GltfType fg::determineGltfFileType(GltfDataGetter& data) {
+	// We'll try and read a BinaryGltfHeader from the buffer to see if the magic is correct.
+	auto header = readBinaryHeader(data);
+	data.reset();
+	if (header.magic == binaryGltfHeaderMagic) {
+		return GltfType::GLB;
+	}
 
-	json += "\"cameras\":[";
-	for (auto it = asset.cameras.begin(); it != asset.cameras.end(); ++it) {
-		json += '{';
+	// First, check if any of the first four characters is a '{'.
+	std::array<std::uint8_t, 4> begin = {};
+	data.read(begin.data(), begin.size());
+	data.reset();
+	for (const auto& i : begin) {
+		if ((char)i == ' ')
+			continue;
+		if ((char)i == '{')
+			return GltfType::glTF;
+	}
 
-		std::visit(visitor {
-			[](auto&) {},
-			[&](const Camera::Perspective& perspective) {
-				json += "\"perspective\":{";
+	return GltfType::Invalid;
+}
 
-				if (perspective.aspectRatio.has_value()) {
-					json += "\"aspectRatio\":" + to_string_fp(perspective.aspectRatio.value()) + ',';
-				}
+#if !FASTGLTF_DISABLE_CUSTOM_MEMORY_POOL
+struct fg::Parser::ChunkPool {
+	struct Chunk {
+		void* pointer;
+		std::size_t bytes;
+		std::size_t alignment;
+	};
 
-				json += "\"yfov\":" + to_string_fp(perspective.yfov) + ',';
+	std::mutex mutex;
+	std::pmr::memory_resource* upstream;
+	std::size_t initialChunkSize;
+	std::size_t maxRecycledBytes;
+	std::size_t recycledBytes = 0;
+	std::vector<Chunk> chunks;
 
-				if (perspective.zfar.has_value()) {
-					json += "\"zfar\":" + to_string_fp(perspective.zfar.value()) + ',';
-				}
+	ChunkPool(std::pmr::memory_resource* upstream, std::size_t initialChunkSize, std::size_t maxRecycledBytes)
+			: upstream(upstream != nullptr ? upstream : std::pmr::get_default_resource()),
+			initialChunkSize(initialChunkSize), maxRecycledBytes(maxRecycledBytes) {}
 
-				json += "\"znear\":" + to_string_fp(perspective.znear);
+	~ChunkPool() {
+		for (auto& chunk : chunks) {
+			upstream->deallocate(chunk.pointer, chunk.bytes, chunk.alignment);
+		}
+	}
 
-				json += R"(},"type":"perspective")";
-			},
-			[&](const Camera::Orthographic& orthographic) {
-				json += "\"orthographic\":{";
-				json += "\"xmag\":" + to_string_fp(orthographic.xmag) + ',';
-				json += "\"ymag\":" + to_string_fp(orthographic.ymag) + ',';
-				json += "\"zfar\":" + to_string_fp(orthographic.zfar) + ',';
-				json += "\"znear\":" + to_string_fp(orthographic.znear);
-				json += R"(},"type":"orthographic")";
+	void* allocate(std::size_t bytes, std::size_t alignment, bool& recycled) {
+		{
+			std::lock_guard lock(mutex);
+			// The arenas grow their chunks geometrically, so assets of a similar size request the same
+			// chunk sizes over and over again. We therefore only ever hand out exact matches.
+			for (auto it = chunks.begin(); it != chunks.end(); ++it) {
+				if (it->bytes == bytes && it->alignment == alignment) {
+					auto* pointer = it->pointer;
+					recycledBytes -= bytes;
+					*it = chunks.back();
+					chunks.pop_back();
+					recycled = true;
+					return pointer;
+				}
 			}
-		}, it->camera);
+		}
+		recycled = false;
+		return upstream->allocate(bytes, alignment);
+	}
 
-		if (extrasWriteCallback != nullptr) {
-			auto extras = extrasWriteCallback(uabs(std::distance(asset.cameras.begin(), it)), fastgltf::Category::Cameras, userPointer);
-			if (extras.has_value()) {
-				json += std::string(",\"extras\":") + *extras;
+	void deallocate(void* pointer, std::size_t bytes, std::size_t alignment) {
+		{
+			std::lock_guard lock(mutex);
+			if (recycledBytes + bytes <= maxRecycledBytes) {
+				chunks.push_back({ pointer, bytes, alignment });
+				recycledBytes += bytes;
+				return;
 			}
 		}
+		upstream->deallocate(pointer, bytes, alignment);
+	}
+};
 
-		if (!it->name.empty())
-			json += R"(,"name":")" + fg::escapeString(it->name) + '"';
+namespace fastgltf {
+	// The upstream resource of each arena, which counts the chunks the arena acquires.
+	template <typename Pool>
+	class ChunkCounter : public std::pmr::memory_resource {
+		std::shared_ptr<Pool> pool;
 
-		json += '}';
-		if (uabs(std::distance(asset.cameras.begin(), it)) + 1 <asset.cameras.size())
-			json += ',';
-	}
-	json += ']';
-}
+	public:
+		std::size_t chunksAllocated = 0;
+		std::size_t chunkBytesAllocated = 0;
+		std::size_t chunksRecycled = 0;
 
-void fg::Exporter::writeImages(const Asset& asset, std::string& json) {
-	if (asset.images.empty())
-		return;
-	if (json.back() == ']' || json.back() == '}')
-		json += ',';
+		explicit ChunkCounter(std::shared_ptr<Pool> pool) : pool(std::move(pool)) {}
 
-	json += "\"images\":[";
-	for (auto it = asset.images.begin(); it != asset.images.end(); ++it) {
-		json += '{';
+	private:
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+			bool recycled;
+			auto* pointer = pool->allocate(bytes, alignment, recycled);
+			++chunksAllocated;
+			chunkBytesAllocated += bytes;
+			chunksRecycled += recycled ? 1 : 0;
+			return pointer;
+		}
 
-        auto imageIdx = uabs(std::distance(asset.images.begin(), it));
-		std::visit(visitor {
-			[&](auto&) {
-				errorCode = Error::InvalidGltf;
-			},
-            [&](const sources::BufferView& bufferView) {
-                json += std::string(R"("bufferView":)") + std::to_string(bufferView.bufferViewIndex) + ',';
-				json += std::string(R"("mimeType":")") + std::string(getMimeTypeString(bufferView.mimeType)) + '"';
-                imagePaths.emplace_back(std::nullopt);
-            },
-            [&](const sources::Array& vector) {
-                auto path = getImageFilePath(asset, imageIdx, vector.mimeType);
-                json += std::string(R"("uri":")") + fg::normalizeAndFormatPath(path) + '"';
-				if (vector.mimeType != MimeType::None) {
-					json += std::string(R"(,"mimeType":")") + std::string(getMimeTypeString(vector.mimeType)) + '"';
-				}
-                imagePaths.emplace_back(path);
-            },
-			[&](const sources::Vector& vector) {
-				auto path = getImageFilePath(asset, imageIdx, vector.mimeType);
-				json += std::string(R"("uri":")") + fg::normalizeAndFormatPath(path) + '"';
-				if (vector.mimeType != MimeType::None) {
-					json += std::string(R"(,"mimeType":")") + std::string(getMimeTypeString(vector.mimeType)) + '"';
-				}
-				imagePaths.emplace_back(path);
-			},
-			[&](const sources::URI& uri) {
-				json += std::string(R"("uri":")") + fg::escapeString(uri.uri.string()) + '"';
-                imagePaths.emplace_back(std::nullopt);
-			},
-		}, it->data);
-		if (errorCode != Error::None)
-			return;
+		void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override {
+			pool->deallocate(pointer, bytes, alignment);
+		}
 
-		if (extrasWriteCallback != nullptr) {
-			auto extras = extrasWriteCallback(uabs(std::distance(asset.images.begin(), it)), fastgltf::Category::Images, userPointer);
-			if (extras.has_value()) {
-				json += std::string(",\"extras\":") + *extras;
-			}
+		[[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+			return this == &other;
 		}
+	};
 
-		if (!it->name.empty())
-			json += R"(,"name":")" + fg::escapeString(it->name) + '"';
-		json += '}';
-		if (uabs(std::distance(asset.images.begin(), it)) + 1 <asset.images.size())
-			json += ',';
+	// The counter has to live in a base class of the arena so that it is constructed before, and
+	// destroyed after, the monotonic_buffer_resource using it.
+	template <typename Pool>
+	struct ChunkCounterHolder {
+		ChunkCounter<Pool> chunkCounter;
+	};
+} // namespace fastgltf
+
+class fg::Parser::Arena : public ChunkCounterHolder<ChunkPool>, public std::pmr::monotonic_buffer_resource {
+	// The size of the first chunk when none was specified, which is what most standard libraries use.
+	static constexpr std::size_t defaultInitialChunkSize = 128 * sizeof(void*);
+
+public:
+	std::size_t bytesAllocated = 0;
+
+	explicit Arena(const std::shared_ptr<ChunkPool>& chunkPool)
+			: ChunkCounterHolder<ChunkPool> { ChunkCounter<ChunkPool>(chunkPool) },
+			std::pmr::monotonic_buffer_resource(chunkPool->initialChunkSize != 0 ? chunkPool->initialChunkSize : defaultInitialChunkSize,
+												&chunkCounter) {}
+
+private:
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+		bytesAllocated += bytes;
+		return std::pmr::monotonic_buffer_resource::do_allocate(bytes, alignment);
 	}
-	json += ']';
+};
+
+std::shared_ptr<std::pmr::monotonic_buffer_resource> fg::Parser::createArena() {
+	if (chunkPool == nullptr) {
+		chunkPool = std::make_shared<ChunkPool>(nullptr, 0, 0);
+	}
+	return std::make_shared<Arena>(chunkPool);
 }
 
-void fg::Exporter::writeLights(const Asset& asset, std::string& json) {
-	if (asset.lights.empty())
-		return;
-	if (json.back() == ']' || json.back() == '}')
-		json += ',';
+void fg::Parser::collectMemoryStatistics(const Asset& asset) {
+	memoryStatistics = {};
+	auto collect = [this](const std::shared_ptr<std::pmr::monotonic_buffer_resource>& resource) {
+		if (resource == nullptr)
+			return;
+		const auto& arena = static_cast<const Arena&>(*resource);
+		memoryStatistics.bytesAllocated += arena.bytesAllocated;
+		memoryStatistics.chunksAllocated += arena.chunkCounter.chunksAllocated;
+		memoryStatistics.chunkBytesAllocated += arena.chunkCounter.chunkBytesAllocated;
+		memoryStatistics.chunksRecycled += arena.chunkCounter.chunksRecycled;
+	};
+	collect(asset.memoryResource);
+	for (const auto& resource : asset.workerMemoryResources) {
+		collect(resource);
+	}
+#if FASTGLTF_ENABLE_LOAD_STATISTICS
+	loadStatistics.arenaBytesAllocated = memoryStatistics.bytesAllocated;
+#endif
+}
+#endif
 
-	json += R"("KHR_lights_punctual":{"lights":[)";
-	for (auto it = asset.lights.begin(); it != asset.lights.end(); ++it) {
-		json += '{';
+fg::Parser::Parser(Extensions extensionsToLoad) noexcept {
+    std::call_once(crcInitialisation, initialiseCrc);
+    jsonParser = std::make_unique<simdjson::dom::parser>();
+    config.extensions = extensionsToLoad & compiledExtensions;
+}
 
-		// [1.0f, 1.0f, 1.0f] is the default.
-		if (it->color[0] != 1.0f && it->color[1] != 1.0f && it->color[2] != 1.0f) {
-			json += R"("color":[)";
-			json += to_string_fp(it->color[0]) + ',' + to_string_fp(it->color[1]) + ',' + to_string_fp(it->color[2]);
-			json += "],";
-		}
+fg::Parser::Parser(Parser&& other) noexcept : jsonParser(std::move(other.jsonParser)), onDemandParser(std::move(other.onDemandParser)), config(other.config) {
+#if !FASTGLTF_DISABLE_CUSTOM_MEMORY_POOL
+	chunkPool = std::move(other.chunkPool);
+#endif
+}
 
-		if (it->intensity != 1.0f) {
-			json += R"("intensity":)" + to_string_fp(it->intensity) + ',';
-		}
+fg::Parser& fg::Parser::operator=(Parser&& other) noexcept {
+    jsonParser = std::move(other.jsonParser);
+    onDemandParser = std::move(other.onDemandParser);
+#if !FASTGLTF_DISABLE_CUSTOM_MEMORY_POOL
+	chunkPool = std::move(other.chunkPool);
+#endif
+    config = other.config;
+    return *this;
+}
 
-		switch (it->type) {
-			case LightType::Directional: {
-				json += R"("type":"directional")";
-				break;
+fg::Parser::~Parser() = default;
+
+fg::Expected<fg::Asset> fg::Parser::loadGltf(GltfDataGetter& data, fs::path _directory, Options _options, Category categories) {
+    auto type = fastgltf::determineGltfFileType(data);
+
+    if (type == fastgltf::GltfType::glTF) {
+        return loadGltfJson(data, std::move(_directory), _options, categories);
+    }
+
+    if (type == fastgltf::GltfType::GLB) {
+        return loadGltfBinary(data, std::move(_directory), _options, categories);
+    }
+
+    return Error::InvalidFileData;
+}
+
+namespace fastgltf {
+	/**
+	 * Runs the asynchronous loads on at most as many threads as there are hardware threads. A thread is only started
+	 * when a load can't be picked up by an idle one, and all threads finish the pending loads and are joined on exit.
+	 */
+	class AsyncLoadPool {
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::deque<std::pair<ParserTask*, void*>> pendingTasks;
+		std::vector<std::thread> threads;
+		std::size_t idleThreads = 0;
+		bool stopping = false;
+
+		void work() {
+			std::unique_lock lock(mutex);
+			while (true) {
+				++idleThreads;
+				condition.wait(lock, [this]() { return stopping || !pendingTasks.empty(); });
+				--idleThreads;
+				if (pendingTasks.empty())
+					return;
+
+				auto [task, taskData] = pendingTasks.front();
+				pendingTasks.pop_front();
+				lock.unlock();
+				task(0, taskData);
+				lock.lock();
 			}
-			case LightType::Spot: {
-				json += R"("type":"spot")";
-				break;
+		}
+
+	public:
+		~AsyncLoadPool() {
+			{
+				std::lock_guard lock(mutex);
+				stopping = true;
 			}
-			case LightType::Point: {
-				json += R"("type":"point")";
-				break;
+			condition.notify_all();
+			for (auto& thread : threads) {
+				thread.join();
 			}
 		}
 
-		if (it->range.has_value()) {
-			json += R"(,"range":)" + to_string_fp(it->range.value());
+		void submit(ParserTask* task, void* taskData) {
+			static const auto hardwareThreads = max<std::size_t>(1, std::thread::hardware_concurrency());
+			{
+				std::lock_guard lock(mutex);
+				pendingTasks.emplace_back(task, taskData);
+				if (idleThreads < pendingTasks.size() && threads.size() < hardwareThreads)
+					threads.emplace_back(&AsyncLoadPool::work, this);
+			}
+			condition.notify_one();
 		}
+	};
+} // namespace fastgltf
 
-		if (it->type == LightType::Spot) {
-			if (it->innerConeAngle.has_value())
-				json += R"("innerConeAngle":)" + to_string_fp(it->innerConeAngle.value()) + ',';
-
-			if (it->outerConeAngle.has_value())
-				json += R"("outerConeAngle":)" + to_string_fp(it->outerConeAngle.value()) + ',';
-		}
+void fg::Parser::runAsync(ParserTask* task, void* taskData) {
+	static AsyncLoadPool pool;
+	pool.submit(task, taskData);
+}
 
-		if (!it->name.empty())
-			json += R"(,"name":")" + fg::escapeString(it->name) + '"';
-		json += '}';
-		if (uabs(std::distance(asset.lights.begin(), it)) + 1 <asset.lights.size())
-			json += ',';
-	}
-	json += "]}";
+std::future<fg::Expected<fg::Asset>> fg::Parser::loadGltfAsync(GltfDataGetter& data, fs::path _directory, Options _options, Category categories) {
+	using LoadTask = std::packaged_task<Expected<Asset>()>;
+	auto load = std::make_unique<LoadTask>([this, &data, _directory = std::move(_directory), _options, categories]() mutable {
+		return loadGltf(data, std::move(_directory), _options, categories);
+	});
+	auto future = load->get_future();
+	runAsync([](std::size_t, void* taskData) {
+		std::unique_ptr<LoadTask> load(static_cast<LoadTask*>(taskData));
+		(*load)();
+	}, load.release());
+	return future;
 }
 
-void fg::Exporter::writeMaterials(const Asset& asset, std::string& json) {
-	if (asset.materials.empty())
-		return;
-	if (json.back() == ']' || json.back() == '}')
-		json += ',';
+namespace fastgltf {
+	/** Reads entire files into a buffer which is kept and reused for every file read by the same worker. */
+	class BatchFileReader : public GltfDataGetter {
+		std::vector<std::byte> buffer;
+		std::size_t dataSize = 0;
+		std::size_t idx = 0;
+		fs::path path;
+
+	public:
+		Error open(const fs::path& filePath) {
+			std::error_code ec;
+			const auto fileSize = static_cast<std::size_t>(fs::file_size(filePath, ec));
+			if (ec) {
+				return Error::InvalidPath;
+			}
 
-	json += "\"materials\":[";
-	for (auto it = asset.materials.begin(); it != asset.materials.end(); ++it) {
-		json += '{';
+			std::ifstream file(filePath, std::ios::binary);
+			if (!file.is_open() || file.bad()) {
+				return Error::InvalidPath;
+			}
 
-		json += "\"pbrMetallicRoughness\":{";
-		if (it->pbrData.baseColorFactor != math::nvec4(1)) {
-			json += R"("baseColorFactor":[)";
-			json += to_string_fp(it->pbrData.baseColorFactor[0]) + ',' + to_string_fp(it->pbrData.baseColorFactor[1]) + ',' +
-				to_string_fp(it->pbrData.baseColorFactor[2]) + ',' + to_string_fp(it->pbrData.baseColorFactor[3]);
-			json += "]";
-		}
+			// Only the padding needs to be cleared, the data itself is overwritten right away.
+			buffer.resize(fileSize + simdjson::SIMDJSON_PADDING);
+			std::memset(buffer.data() + fileSize, 0, simdjson::SIMDJSON_PADDING);
+			file.read(reinterpret_cast<std::ifstream::char_type*>(buffer.data()), static_cast<std::streamsize>(fileSize));
+			if (static_cast<std::size_t>(file.gcount()) != fileSize) {
+				return Error::InvalidPath;
+			}
 
-		if (it->pbrData.baseColorTexture.has_value()) {
-			if (json.back() != '{') json += ',';
-			json += "\"baseColorTexture\":";
-			writeTextureInfo(json, &it->pbrData.baseColorTexture.value());
+			dataSize = fileSize;
+			idx = 0;
+			path = filePath;
+			return Error::None;
 		}
 
-		if (it->pbrData.metallicFactor != 1.0f) {
-			if (json.back() != '{') json += ',';
-			json += "\"metallicFactor\":" + to_string_fp(it->pbrData.metallicFactor);
+		void read(void* ptr, std::size_t count) override {
+			std::memcpy(ptr, buffer.data() + idx, count);
+			idx += count;
 		}
 
-		if (it->pbrData.roughnessFactor != 1.0f) {
-			if (json.back() != '{') json += ',';
-			json += "\"roughnessFactor\":" + to_string_fp(it->pbrData.roughnessFactor);
+		[[nodiscard]] span<std::byte> read(std::size_t count, [[maybe_unused]] std::size_t padding) override {
+			span<std::byte> sub(buffer.data() + idx, count);
+			idx += count;
+			return sub;
 		}
 
-		if (it->pbrData.metallicRoughnessTexture.has_value()) {
-			if (json.back() != '{') json += ',';
-			json += "\"metallicRoughnessTexture\":";
-			writeTextureInfo(json, &it->pbrData.metallicRoughnessTexture.value());
+		void reset() override {
+			idx = 0;
 		}
 
-		json += '}';
-
-		if (it->normalTexture.has_value()) {
-			if (json.back() != ',') json += ',';
-			json += "\"normalTexture\":";
-			writeTextureInfo(json, &it->normalTexture.value(), TextureInfoType::NormalTexture);
+		[[nodiscard]] std::size_t bytesRead() override {
+			return idx;
 		}
 
-		if (it->occlusionTexture.has_value()) {
-			if (json.back() != ',') json += ',';
-			json += "\"occlusionTexture\":";
-			writeTextureInfo(json, &it->occlusionTexture.value(), TextureInfoType::OcclusionTexture);
+		[[nodiscard]] std::size_t totalSize() override {
+			return dataSize;
 		}
 
-		if (it->emissiveTexture.has_value()) {
-			if (json.back() != ',') json += ',';
-			json += "\"emissiveTexture\":";
-			writeTextureInfo(json, &it->emissiveTexture.value());
+		[[nodiscard]] fs::path filePath() override {
+			return path;
 		}
+	};
+} // namespace fastgltf
 
-		if (it->emissiveFactor != math::nvec3(0)) {
-			if (json.back() != ',') json += ',';
-			json += R"("emissiveFactor":[)";
-			json += to_string_fp(it->emissiveFactor[0]) + ',' + to_string_fp(it->emissiveFactor[1]) + ',' + to_string_fp(it->emissiveFactor[2]);
-			json += "],";
-		}
+struct fg::BatchLoader::Worker {
+	Parser parser;
+	BatchFileReader reader;
 
-		if (it->alphaMode != AlphaMode::Opaque) {
-			if (json.back() != ',') json += ',';
-			json += R"("alphaMode":)";
-			if (it->alphaMode == AlphaMode::Blend) {
-				json += "\"BLEND\"";
-			} else if (it->alphaMode == AlphaMode::Mask) {
-				json += "\"MASK\"";
-			}
-		}
+	// The indices of the files dealt out to this worker, sorted from the largest to the smallest.
+	std::mutex mutex;
+	std::deque<std::size_t> files;
 
-		if (it->alphaMode == AlphaMode::Mask && it->alphaCutoff != 0.5f) {
-			if (json.back() != ',') json += ',';
-			json += R"("alphaCutoff":)" + to_string_fp(it->alphaCutoff);
-		}
+	explicit Worker(Extensions extensions) : parser(extensions) {}
+};
 
-		if (it->doubleSided) {
-			if (json.back() != ',') json += ',';
-			json += R"("doubleSided":true)";
-		}
+fg::BatchLoader::BatchLoader(Extensions extensionsToLoad, std::size_t _threadCount) : extensions(extensionsToLoad) {
+	threadCount = _threadCount != 0 ? _threadCount : max<std::size_t>(std::thread::hardware_concurrency(), 1);
+}
 
-		if (json.back() != ',') json += ',';
-		json += R"("extensions":{)";
+fg::BatchLoader::BatchLoader(BatchLoader&& other) noexcept = default;
+fg::BatchLoader& fg::BatchLoader::operator=(BatchLoader&& other) noexcept = default;
+fg::BatchLoader::~BatchLoader() = default;
 
-		if (it->anisotropy) {
-			json += R"("KHR_materials_anisotropy":{)";
-			if (it->anisotropy->anisotropyStrength != 0.0f) {
-				json += R"("anisotropyStrength":)" + to_string_fp(it->anisotropy->anisotropyStrength);
-			}
-			if (it->anisotropy->anisotropyRotation != 0.0f) {
-				if (json.back() != '{') json += ',';
-				json += R"("anisotropyRotation":)" + to_string_fp(it->anisotropy->anisotropyRotation);
-			}
-			if (it->anisotropy->anisotropyTexture.has_value()) {
-				if (json.back() != '{') json += ',';
-				json += "\"anisotropyTexture\":";
-				writeTextureInfo(json, &it->anisotropy->anisotropyTexture.value());
-			}
-			json += '}';
-		}
+void fg::BatchLoader::setParserCallback(BatchParserCallback* callback) noexcept {
+	parserCallback = callback;
+}
 
-		if (it->clearcoat) {
-			if (json.back() == '}') json += ',';
-			json += R"("KHR_materials_clearcoat":{)";
-			if (it->clearcoat->clearcoatFactor != 0.0f) {
-				json += R"("clearcoatFactor":)" + to_string_fp(it->clearcoat->clearcoatFactor);
-			}
-			if (it->clearcoat->clearcoatTexture.has_value()) {
-				if (json.back() != '{') json += ',';
-				json += "\"clearcoatTexture\":";
-				writeTextureInfo(json, &it->clearcoat->clearcoatTexture.value());
-			}
-			if (it->clearcoat->clearcoatRoughnessFactor != 0.0f) {
-				if (json.back() != '{') json += ',';
-				json += R"("clearcoatRoughnessFactor":)" + to_string_fp(it->clearcoat->clearcoatRoughnessFactor);
-			}
-			if (it->clearcoat->clearcoatRoughnessTexture.has_value()) {
-				if (json.back() != '{') json += ',';
-				json += "\"clearcoatRoughnessTexture\":";
-				writeTextureInfo(json, &it->clearcoat->clearcoatRoughnessTexture.value());
-			}
-			if (it->clearcoat->clearcoatNormalTexture.has_value()) {
-				if (json.back() != '{') json += ',';
-				json += "\"clearcoatNormalTexture\":";
-				writeTextureInfo(json, &it->clearcoat->clearcoatNormalTexture.value(), TextureInfoType::NormalTexture);
-			}
-			json += '}';
-		}
+void fg::BatchLoader::setUserPointer(void* pointer) noexcept {
+	userPointer = pointer;
+}
 
-		if (it->dispersion != 0.0f) {
-			if (json.back() == '}') json += ',';
-			json += R"("KHR_materials_dispersion":{"dispersion":)" + to_string_fp(it->dispersion) + '}';
-		}
+std::size_t fg::BatchLoader::load(span<const fs::path> paths, BatchLoadCallback* callback, Options options, Category categories) {
+	assert(callback != nullptr && "The BatchLoadCallback cannot be nullptr.");
+	if (paths.empty())
+		return 0;
 
-		if (it->emissiveStrength != 1.0f) {
-			if (json.back() == '}') json += ',';
-			json += R"("KHR_materials_emissive_strength":{"emissiveStrength":)" + to_string_fp(it->emissiveStrength) + '}';
+	const auto workerCount = min(threadCount, paths.size());
+	while (workers.size() < workerCount) {
+		auto& worker = workers.emplace_back(std::make_unique<Worker>(extensions));
+		if (parserCallback != nullptr) {
+			parserCallback(worker->parser, userPointer);
 		}
+	}
 
-		if (it->ior != 1.5f) {
-			if (json.back() == '}') json += ',';
-			json += R"("KHR_materials_ior":{"ior":)" + to_string_fp(it->ior) + '}';
-		}
+	// Deal the files out from the largest to the smallest, so that every worker starts with one of
+	// the largest files and the small ones fill the gaps at the end. Files whose size can't be
+	// determined come last, and fail quickly once they are opened.
+	std::vector<std::pair<std::uintmax_t, std::size_t>> sizes(paths.size());
+	for (std::size_t i = 0; i < paths.size(); ++i) {
+		std::error_code ec;
+		const auto size = fs::file_size(paths[i], ec);
+		sizes[i] = { ec ? 0 : size, i };
+	}
+	std::stable_sort(sizes.begin(), sizes.end(), [](const auto& a, const auto& b) {
+		return a.first > b.first;
+	});
+	for (std::size_t i = 0; i < sizes.size(); ++i) {
+		workers[i % workerCount]->files.push_back(sizes[i].second);
+	}
 
-		if (it->iridescence) {
-			if (json.back() == '}') json += ',';
-			json += R"("KHR_materials_iridescence":{)";
-			if (it->iridescence->iridescenceFactor != 0.0f) {
-				json += R"("iridescenceFactor":)" + to_string_fp(it->iridescence->iridescenceFactor);
-			}
-			if (it->iridescence->iridescenceTexture.has_value()) {
-				if (json.back() != '{') json += ',';
-				json += "\"iridescenceTexture\":";
-				writeTextureInfo(json, &it->iridescence->iridescenceTexture.value());
-			}
-			if (it->iridescence->iridescenceIor != 1.3f) {
-				if (json.back() != '{') json += ',';
-				json += R"("iridescenceIor":)" + to_string_fp(it->iridescence->iridescenceIor);
-			}
-			if (it->iridescence->iridescenceThicknessMinimum != 100.0f) {
-				if (json.back() != '{') json += ',';
-				json += R"("iridescenceThicknessMinimum":)" + to_string_fp(it->iridescence->iridescenceThicknessMinimum);
-			}
-			if (it->iridescence->iridescenceThicknessMaximum != 400.0f) {
-				if (json.back() != '{') json += ',';
-				json += R"("iridescenceThicknessMaximum":)" + to_string_fp(it->iridescence->iridescenceThicknessMaximum);
+	// Workers take the largest file of their own queue first, and otherwise steal the largest file of
+	// another worker, as that is the one that would otherwise delay the end of the batch the most.
+	// No files are added while loading, so the batch is done once all queues have been found empty.
+	auto takeFile = [&](std::size_t workerIndex) -> std::optional<std::size_t> {
+		for (std::size_t i = 0; i < workerCount; ++i) {
+			auto& worker = *workers[(workerIndex + i) % workerCount];
+			std::lock_guard lock(worker.mutex);
+			if (!worker.files.empty()) {
+				const auto file = worker.files.front();
+				worker.files.pop_front();
+				return file;
 			}
-			if (it->iridescence->iridescenceThicknessTexture.has_value()) {
-				if (json.back() != '{') json += ',';
-				json += "\"iridescenceThicknessTexture\":";
-				writeTextureInfo(json, &it->iridescence->iridescenceThicknessTexture.value());
-			}
-			json += '}';
 		}
+		return std::nullopt;
+	};
 
-		if (it->sheen) {
-			if (json.back() == '}') json += ',';
-			json += R"("KHR_materials_sheen":{)";
-			if (it->sheen->sheenColorFactor != math::nvec3(0)) {
-				json += R"("sheenColorFactor":[)" +
-					to_string_fp(it->sheen->sheenColorFactor[0]) + ',' +
-					to_string_fp(it->sheen->sheenColorFactor[1]) + ',' +
-					to_string_fp(it->sheen->sheenColorFactor[2]) + ']';
-			}
-			if (it->sheen->sheenColorTexture.has_value()) {
-				if (json.back() != '{') json += ',';
-				json += "\"sheenColorTexture\":";
-				writeTextureInfo(json, &it->sheen->sheenColorTexture.value());
-			}
-			if (it->sheen->sheenRoughnessFactor != 0.0f) {
-				if (json.back() != '{') json += ',';
-				json += R"("sheenRoughnessFactor":)" + to_string_fp(it->sheen->sheenRoughnessFactor);
+	std::atomic<std::size_t> failedCount = 0;
+	auto work = [&](std::size_t workerIndex) {
+		auto& worker = *workers[workerIndex];
+		while (auto file = takeFile(workerIndex)) {
+			const auto& path = paths[*file];
+			auto asset = [&]() -> Expected<Asset> {
+				if (auto error = worker.reader.open(path); error != Error::None) {
+					return error;
+				}
+				return worker.parser.loadGltf(worker.reader, path.parent_path(), options, categories);
+			}();
+
+			if (asset.error() != Error::None) {
+				failedCount.fetch_add(1, std::memory_order_relaxed);
 			}
-			if (it->sheen->sheenRoughnessTexture.has_value()) {
+			callback(*file, asset, userPointer);
+		}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(workerCount - 1);
+	for (std::size_t i = 1; i < workerCount; ++i) {
+		threads.emplace_back(work, i);
+	}
+	work(0);
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	return failedCount.load(std::memory_order_relaxed);
+}
+
+fg::Error fg::Parser::readJsonDocument(GltfDataGetter& data, fs::path _directory, Options _options, span<const std::byte>& json) {
+    using namespace simdjson;
+
+	options = _options;
+	directory = std::move(_directory);
+
+#if !defined(__ANDROID__)
+    // If we never have to load the files ourselves, we're fine with the directory being invalid/blank.
+    if (std::error_code ec; hasBit(_options, Options::LoadExternalBuffers) && (!fs::is_directory(directory, ec) || ec)) {
+        return Error::InvalidPath;
+    }
+#endif
+
+	{
+		FASTGLTF_LOAD_SCOPE(loadStatistics.readDocument, LoadScope::ReadDocument);
+		data.reset();
+		auto jsonSpan = data.read(data.totalSize(), SIMDJSON_PADDING);
+		json = span<const std::byte>(jsonSpan.data(), data.totalSize());
+	}
+#if FASTGLTF_ENABLE_LOAD_STATISTICS
+	loadStatistics.readDocument.bytes = data.bytesRead();
+#endif
+
+	progress = { LoadPhase::ReadDocument, data.bytesRead(), data.totalSize(), Category::None };
+	if (!reportProgress(LoadPhase::ReadDocument)) {
+		return Error::LoadCancelled;
+	}
+	return Error::None;
+}
+
+fg::Error fg::Parser::parseJsonDocument(span<const std::byte> json, simdjson::dom::object& root) {
+	using namespace simdjson;
+
+	// The data getters always read SIMDJSON_PADDING bytes past the end of the JSON, which may be
+	// initialised to anything.
+	padded_string_view view(reinterpret_cast<const std::uint8_t*>(json.data()),
+							json.size(),
+							json.size() + SIMDJSON_PADDING);
+	FASTGLTF_LOAD_SCOPE(loadStatistics.parseJson, LoadScope::ParseJson);
+#if FASTGLTF_ENABLE_LOAD_STATISTICS
+	loadStatistics.parseJson.bytes = json.size();
+#endif
+	if (auto error = jsonParser->parse(view).get(root); error != SUCCESS) FASTGLTF_UNLIKELY {
+		return Error::InvalidJson;
+	}
+
+	return Error::None;
+}
+
+fg::Expected<fg::Asset> fg::Parser::parseDocument(span<const std::byte> json, Category categories) {
+	// The extras callback takes a DOM object, so we can only use the On-Demand API without one.
+	if (hasBit(options, Options::UseOnDemandParser) && config.extrasCallback == nullptr) {
+		return parseOnDemand(json, categories);
+	}
+
+	simdjson::dom::object root;
+	if (auto error = parseJsonDocument(json, root); error != Error::None) {
+		return error;
+	}
+	return parse(root, categories);
+}
+
+fg::Expected<fg::Asset> fg::Parser::loadGltfJson(GltfDataGetter& data, fs::path _directory, Options _options, Category categories) {
+#if FASTGLTF_ENABLE_LOAD_STATISTICS
+	loadStatistics = {};
+	loadStatistics.load.bytes = data.totalSize();
+#endif
+	FASTGLTF_LOAD_SCOPE(loadStatistics.load, LoadScope::Load);
+	span<const std::byte> json;
+	if (auto error = readJsonDocument(data, std::move(_directory), _options, json); error != Error::None) {
+		return error;
+	}
+	return parseDocument(json, categories);
+}
+
+fg::Error fg::Parser::readBinaryDocument(GltfDataGetter& data, fs::path _directory, Options _options, span<const std::byte>& json) {
+    using namespace simdjson;
+
+	options = _options;
+	directory = std::move(_directory);
+
+    // If we never have to load the files ourselves, we're fine with the directory being invalid/blank.
+    if (std::error_code ec; hasBit(options, Options::LoadExternalBuffers) && (!fs::is_directory(directory, ec) || ec)) {
+	    return Error::InvalidPath;
+    }
+
+	FASTGLTF_LOAD_SCOPE(loadStatistics.readDocument, LoadScope::ReadDocument);
+	data.reset();
+
+    auto header = readBinaryHeader(data);
+    if (header.magic != binaryGltfHeaderMagic) {
+	    return Error::InvalidGLB;
+    }
+	if (header.version != 2) {
+		return Error::UnsupportedVersion;
+	}
+    if (header.length > data.totalSize()) {
+	    return Error::InvalidGLB;
+    }
+
+    // The glTF 2 spec specifies that in GLB files the order of chunks is predefined. Specifically,
+    //  1. JSON chunk
+    //  2. BIN chunk (optional)
+    auto jsonChunk = readBinaryChunk(data);
+    if (jsonChunk.chunkType != binaryGltfJsonChunkMagic) {
+	    return Error::InvalidGLB;
+    }
+
+    // Create a view of the JSON chunk in the GLB data buffer. The documentation of parse()
+    // says the padding can be initialised to anything, apparently. Therefore, this should work.
+	auto jsonSpan = data.read(jsonChunk.chunkLength, SIMDJSON_PADDING);
+	json = span<const std::byte>(jsonSpan.data(), jsonChunk.chunkLength);
+
+    // Is there enough room for another chunk header?
+    if (header.length > (data.bytesRead() + sizeof(BinaryGltfChunk))) {
+        auto binaryChunk = readBinaryChunk(data);
+
+        if (binaryChunk.chunkType != binaryGltfDataChunkMagic) {
+	        return Error::InvalidGLB;
+        }
+
+		if (data.bytesRead() + binaryChunk.chunkLength > data.totalSize()) {
+			return Error::InvalidGLB;
+		}
+
+		if (binaryChunk.chunkLength != 0 && hasBit(options, Options::DontLoadGLBBuffer)) {
+			// Leave the data on disk and only point to where it starts within the GLB file.
+			auto path = data.filePath();
+			if (!path.empty()) {
+				auto relative = path.lexically_relative(directory);
+				path = relative.empty() ? path.lexically_normal() : std::move(relative);
+			}
+			glbBuffer = sources::URI {
+				data.bytesRead(),
+				URI::fromLocalPath(path.generic_string()),
+				MimeType::GltfBuffer,
+			};
+		} else if (binaryChunk.chunkLength != 0) {
+			std::shared_ptr<const std::byte> sharedData;
+			if (hasBit(options, Options::ZeroCopyGLBBuffer)) {
+				sharedData = data.shareData();
+			}
+
+			if (sharedData != nullptr) {
+				// The getter keeps the entire file in memory, so we can just reference the chunk directly
+				// and let the asset keep the memory alive.
+				glbBuffer = sources::ByteView {
+					span<const std::byte>(sharedData.get() + data.bytesRead(), binaryChunk.chunkLength),
+					MimeType::GltfBuffer,
+				};
+				glbBufferOwner = std::move(sharedData);
+			} else if (config.mapCallback != nullptr) {
+				auto info = config.mapCallback(binaryChunk.chunkLength, config.userPointer);
+				if (info.mappedMemory != nullptr) {
+					data.read(info.mappedMemory, binaryChunk.chunkLength);
+					if (config.unmapCallback != nullptr) {
+						config.unmapCallback(&info, config.userPointer);
+					}
+					glbBuffer = sources::CustomBuffer{info.customId, MimeType::None};
+				}
+			} else {
+				StaticVector<std::byte> binaryData(binaryChunk.chunkLength);
+				data.read(binaryData.data(), binaryChunk.chunkLength);
+
+				sources::Array vectorData = {
+					std::move(binaryData),
+					MimeType::GltfBuffer,
+				};
+				glbBuffer = std::move(vectorData);
+			}
+		}
+    }
+#if FASTGLTF_ENABLE_LOAD_STATISTICS
+	loadStatistics.readDocument.bytes = data.bytesRead();
+#endif
+
+	progress = { LoadPhase::ReadDocument, data.bytesRead(), data.totalSize(), Category::None };
+	if (!reportProgress(LoadPhase::ReadDocument)) {
+		return Error::LoadCancelled;
+	}
+	return Error::None;
+}
+
+fg::Expected<fg::Asset> fg::Parser::loadGltfBinary(GltfDataGetter& data, fs::path _directory, Options _options, Category categories) {
+#if FASTGLTF_ENABLE_LOAD_STATISTICS
+	loadStatistics = {};
+	loadStatistics.load.bytes = data.totalSize();
+#endif
+	FASTGLTF_LOAD_SCOPE(loadStatistics.load, LoadScope::Load);
+	span<const std::byte> json;
+	if (auto error = readBinaryDocument(data, std::move(_directory), _options, json); error != Error::None) {
+		return error;
+	}
+	return parseDocument(json, categories);
+}
+
+fg::Expected<fg::LazyAsset> fg::Parser::loadGltfLazy(GltfDataGetter& data, fs::path _directory, Options _options, Category categories) {
+	// The JSON document lives inside of the simdjson parser, so the lazy asset needs its own parser
+	// to keep the document alive.
+	LazyAsset lazy;
+	lazy.parser = std::make_unique<Parser>(config.extensions);
+	lazy.parser->config = config;
+#if !FASTGLTF_DISABLE_CUSTOM_MEMORY_POOL
+	if (chunkPool == nullptr) {
+		chunkPool = std::make_shared<ChunkPool>(nullptr, 0, 0);
+	}
+	lazy.parser->chunkPool = chunkPool;
+#endif
+	lazy.root = std::make_unique<simdjson::dom::object>();
+
+	auto& parser = *lazy.parser;
+	span<const std::byte> json;
+	Error error;
+	switch (determineGltfFileType(data)) {
+		case GltfType::glTF:
+			error = parser.readJsonDocument(data, std::move(_directory), _options, json);
+			break;
+		case GltfType::GLB:
+			error = parser.readBinaryDocument(data, std::move(_directory), _options, json);
+			break;
+		default:
+			error = Error::InvalidFileData;
+			break;
+	}
+	if (error != Error::None) {
+		return error;
+	}
+	if (error = parser.parseJsonDocument(json, *lazy.root); error != Error::None) {
+		return error;
+	}
+
+	fillCategories(categories);
+	auto asset = parser.parse(*lazy.root, categories);
+	if (asset.error() != Error::None) {
+		return asset.error();
+	}
+	lazy.asset = std::move(asset.get());
+	lazy.loadedCategories = categories;
+	return std::move(lazy);
+}
+
+void fg::Parser::setBufferAllocationCallback(BufferMapCallback* mapCallback, BufferUnmapCallback* unmapCallback) noexcept {
+	if (mapCallback == nullptr)
+		unmapCallback = nullptr;
+	config.mapCallback = mapCallback;
+	config.unmapCallback = unmapCallback;
+}
+
+void fg::Parser::setBase64DecodeCallback(Base64DecodeCallback* decodeCallback) noexcept {
+    config.decodeCallback = decodeCallback;
+}
+
+void fg::Parser::setExtrasParseCallback(ExtrasParseCallback *extrasCallback) noexcept {
+	config.extrasCallback = extrasCallback;
+}
+
+void fg::Parser::setTaskExecutorCallback(TaskExecutorCallback* executorCallback) noexcept {
+	config.executorCallback = executorCallback;
+}
+
+void fg::Parser::setLoadProgressCallback(LoadProgressCallback* progressCallback) noexcept {
+	config.progressCallback = progressCallback;
+}
+
+void fg::Parser::setExternalFileCache(ExternalFileCache* cache) noexcept {
+	config.fileCache = cache;
+}
+
+#if FASTGLTF_ENABLE_LOAD_STATISTICS
+void fg::Parser::setLoadScopeCallback(LoadScopeCallback* scopeCallback) noexcept {
+	config.scopeCallback = scopeCallback;
+}
+#endif
+
+void fg::Parser::setUserPointer(void* pointer) noexcept {
+    config.userPointer = pointer;
+}
+
+#if !FASTGLTF_DISABLE_CUSTOM_MEMORY_POOL
+void fg::Parser::setMemoryResource(std::pmr::memory_resource* upstream, std::size_t initialChunkSize) noexcept {
+	// Assets loaded before keep the old pool alive for as long as they need it.
+	const auto maxRecycledBytes = chunkPool != nullptr ? chunkPool->maxRecycledBytes : 0;
+	chunkPool = std::make_shared<ChunkPool>(upstream, initialChunkSize, maxRecycledBytes);
+}
+
+void fg::Parser::setMaxRecycledMemory(std::size_t maxRecycledBytes) noexcept {
+	if (chunkPool == nullptr) {
+		chunkPool = std::make_shared<ChunkPool>(nullptr, 0, maxRecycledBytes);
+		return;
+	}
+	std::lock_guard lock(chunkPool->mutex);
+	chunkPool->maxRecycledBytes = maxRecycledBytes;
+}
+#endif
+#pragma endregion
+
+#pragma region LazyAsset
+fg::LazyAsset::LazyAsset() noexcept = default;
+fg::LazyAsset::LazyAsset(LazyAsset&& other) noexcept = default;
+fg::LazyAsset& fg::LazyAsset::operator=(LazyAsset&& other) noexcept = default;
+fg::LazyAsset::~LazyAsset() = default;
+
+fg::Error fg::LazyAsset::load(Category categories) {
+	Parser::fillCategories(categories);
+	const auto missingCategories = categories & ~loadedCategories;
+	if (missingCategories == Category::None)
+		return Error::None;
+
+	if (parser == nullptr || root == nullptr) FASTGLTF_UNLIKELY {
+		return Error::InvalidGltf;
+	}
+
+	if (auto error = parser->parseCategories(*root, missingCategories, asset, false); error != Error::None) {
+		return error;
+	}
+	loadedCategories |= categories;
+	return Error::None;
+}
+#pragma endregion
+
+#pragma region Exporter
+void fg::prettyPrintJson(std::string& json) {
+	// The output is built in a new string, since inserting into the JSON itself would move
+	// all following characters every time, which makes pretty-printing large documents quadratic.
+	std::string output;
+	output.reserve(json.size() + json.size() / 2);
+
+	std::size_t depth = 0;
+	auto appendNewline = [&depth, &output]() {
+		output.push_back('\n');
+		output.append(depth, '\t');
+	};
+
+	for (std::size_t i = 0; i < json.size(); ++i) {
+		if (json[i] == '"') {
+			// Copy the entire string, skipping over escaped characters
+			const auto start = i;
+			for (++i; i < json.size() && json[i] != '"'; ++i) {
+				if (json[i] == '\\')
+					++i;
+			}
+			output.append(json, start, i - start + 1);
+			continue;
+		}
+
+		switch (json[i]) {
+			case '{': case '[':
+				++depth;
+				output.push_back(json[i]);
+				appendNewline();
+				break;
+			case '}': case ']':
+				--depth;
+				appendNewline();
+				output.push_back(json[i]);
+				break;
+			case ',':
+				output.push_back(json[i]);
+				appendNewline();
+				break;
+			default:
+				output.push_back(json[i]);
+				break;
+		}
+	}
+	json = std::move(output);
+}
+
+namespace fastgltf {
+	static void escapeString(std::string& string) {
+		std::size_t i = 0;
+		do {
+			switch (string[i]) {
+				case '\"': {
+					const std::string_view s = "\\\"";
+					string.replace(i, 1, s);
+					i += s.size() - 1;
+					break;
+				}
+				case '\\': {
+					const std::string_view s = "\\\\";
+					string.replace(i, 1, s);
+					i += s.size() - 1;
+					break;
+				}
+			}
+			++i;
+		} while (i < string.size());
+	}
+
+	/**
+	 * Normalizes the path using lexically_normal, calls generic_string to always use forward slashes,
+	 * and escapes any necessary characters.
+	 */
+	static std::string normalizeAndFormatPath(fs::path& path) {
+		auto string = path.lexically_normal().generic_string();
+		escapeString(string);
+		return string;
+	}
+
+	// replacement for std::to_string that uses simdjson's grisu2 implementation, which is
+	// (1) bidirectionally lossless (std::to_string is not)
+	// (2) quite a lot faster than std::to_chars and std::to_string.
+	// The digits are appended directly to the JSON string, to avoid creating a temporary string.
+	void appendNumber(std::string& json, const num& value) {
+		char buffer[30] = {};
+
+		// TODO: Include a own copy of grisu2 instead of accessing functions from simdjson's internal namespace?
+		auto* end = simdjson::internal::to_chars(std::begin(buffer), std::end(buffer), value);
+		json.append(std::begin(buffer), end);
+	}
+
+	template <typename T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+	void appendNumber(std::string& json, const T value) {
+		char buffer[24];
+		auto* end = std::to_chars(std::begin(buffer), std::end(buffer), value).ptr;
+		json.append(std::begin(buffer), end);
+	}
+
+	/** Appends the string to the JSON while escaping it, the same way escapeString does */
+	void appendEscapedString(std::string& json, std::string_view string) {
+		std::size_t pos = 0;
+		while (true) {
+			const auto next = string.find_first_of("\"\\", pos);
+			if (next == std::string_view::npos) {
+				json.append(string.data() + pos, string.size() - pos);
+				return;
+			}
+			json.append(string.data() + pos, next - pos);
+			json += '\\';
+			json += string[next];
+			pos = next + 1;
+		}
+	}
+
+	/** Appends a uri member containing the data as a base64 encoded data URI, without creating a temporary string */
+	void appendDataUri(std::string& json, std::string_view mimeType, span<const std::byte> data) {
+		json += R"("uri":"data:)";
+		json += mimeType;
+		json += ";base64,";
+		const auto offset = json.size();
+		json.resize(offset + base64::getEncodedSize(data.size()));
+		base64::encode_inplace(data, json.data() + offset);
+		json += '"';
+	}
+
+	void writeTextureInfo(std::string& json, const TextureInfo* info, const TextureInfoType type = TextureInfoType::Standard) {
+		json += '{';
+		json += "\"index\":";
+		appendNumber(json, info->textureIndex);
+		if (info->texCoordIndex != 0) {
+			json += ",\"texCoord\":";
+			appendNumber(json, info->texCoordIndex);
+		}
+		if (type == TextureInfoType::NormalTexture) {
+			json += ",\"scale\":";
+			appendNumber(json, reinterpret_cast<const NormalTextureInfo*>(info)->scale);
+		} else if (type == TextureInfoType::OcclusionTexture) {
+			json += ",\"strength\":";
+			appendNumber(json, reinterpret_cast<const OcclusionTextureInfo*>(info)->strength);
+		}
+
+		if (info->transform != nullptr) {
+			json += R"(,"extensions":{"KHR_texture_transform":{)";
+			const auto& transform = *info->transform;
+			if (transform.uvOffset[0] != 0.0 || transform.uvOffset[1] != 0.0) {
+				json += "\"offset\":[";
+				appendNumber(json, transform.uvOffset[0]);
+				json += ',';
+				appendNumber(json, transform.uvOffset[1]);
+				json += ']';
+			}
+			if (transform.rotation != 0.0) {
+				if (json.back() != '{') json += ',';
+				json += "\"rotation\":";
+				appendNumber(json, transform.rotation);
+			}
+			if (transform.uvScale[0] != 1.0 || transform.uvScale[1] != 1.0) {
+				if (json.back() != '{') json += ',';
+				json += "\"scale\":[";
+				appendNumber(json, transform.uvScale[0]);
+				json += ',';
+				appendNumber(json, transform.uvScale[1]);
+				json += ']';
+			}
+			if (transform.texCoordIndex.has_value()) {
+				if (json.back() != '{') json += ',';
+				json += "\"texCoord\":";
+				appendNumber(json, transform.texCoordIndex.value());
+			}
+			json += "}}";
+		}
+
+		json += '}';
+	}
+} // namespace fastgltf
+
+std::string fg::escapeString(std::string_view string) {
+    std::string ret(string);
+	escapeString(ret);
+    return ret;
+}
+
+void fg::Exporter::setBufferPath(fs::path folder) {
+    if (!folder.is_relative()) {
+        return;
+    }
+    bufferFolder = std::move(folder);
+}
+
+void fg::Exporter::setImagePath(fs::path folder) {
+    if (!folder.is_relative()) {
+        return;
+    }
+    imageFolder = std::move(folder);
+}
+
+void fg::Exporter::setExtrasWriteCallback(ExtrasWriteCallback* callback) noexcept {
+	extrasWriteCallback = callback;
+}
+
+void fg::Exporter::setUserPointer(void* pointer) noexcept {
+	userPointer = pointer;
+}
+
+void fg::Exporter::setTaskExecutorCallback(TaskExecutorCallback* callback) noexcept {
+	executorCallback = callback;
+}
+
+struct fg::Exporter::MeshoptEncoding {
+	std::vector<Buffer> buffers;
+	std::vector<BufferView> bufferViews;
+
+	/** The component type of every accessor quantized by a filter, which is then normalized and loses its bounds. */
+	std::vector<Optional<ComponentType>> filteredComponentTypes;
+
+	std::vector<std::string> extensionsUsed;
+	std::vector<std::string> extensionsRequired;
+};
+
+const std::vector<fg::Buffer>& fg::Exporter::getExportedBuffers(const Asset& asset) const noexcept {
+	return meshoptEncoding != nullptr ? meshoptEncoding->buffers : asset.buffers;
+}
+
+#if FASTGLTF_ENABLE_MESHOPT_ENCODER
+namespace fastgltf {
+	/** How the accessors use the data of a buffer view, which decides how it can be compressed. */
+	enum class ExportViewUsage : std::uint8_t {
+		Unused,
+		Attributes,
+		Indices,
+		Other,
+	};
+
+	constexpr unsigned meshoptOctahedralBits = 8;
+	constexpr unsigned meshoptQuaternionBits = 16;
+	constexpr unsigned meshoptExponentialBits = 16;
+
+	struct MeshoptEncodeTask {
+		std::size_t viewIndex;
+		span<const std::byte> source;
+		MeshoptCompressionMode mode;
+		MeshoptCompressionFilter filter;
+		std::size_t count;
+		std::size_t byteStride;
+		std::size_t componentCount;
+
+		std::vector<std::byte> encoded;
+	};
+
+	void encodeMeshoptView(MeshoptEncodeTask& task) {
+		// Filters quantize the elements into a new stride, and views which don't end on a whole element
+		// are padded, as the bitstream always contains count * byteStride bytes.
+		std::vector<std::byte> staging;
+		auto source = task.source;
+		if (task.filter != MeshoptCompressionFilter::None) {
+			const auto bits = task.filter == MeshoptCompressionFilter::Octahedral ? meshoptOctahedralBits
+					: task.filter == MeshoptCompressionFilter::Quaternion ? meshoptQuaternionBits : meshoptExponentialBits;
+			staging.resize(task.count * task.byteStride);
+			if (!meshopt::encodeFilter(task.filter, staging.data(), source.data(), task.count, task.componentCount, task.byteStride, bits))
+				return;
+			source = span<const std::byte>(staging.data(), staging.size());
+		} else if (source.size() < task.count * task.byteStride) {
+			staging.resize(task.count * task.byteStride);
+			std::memcpy(staging.data(), source.data(), source.size());
+			source = span<const std::byte>(staging.data(), staging.size());
+		}
+
+		std::size_t size = 0;
+		switch (task.mode) {
+			case MeshoptCompressionMode::Attributes:
+				task.encoded.resize(meshopt::encodeVertexBufferBound(task.count, task.byteStride));
+				size = meshopt::encodeVertexBuffer(task.encoded.data(), source.data(), task.count, task.byteStride);
+				break;
+			case MeshoptCompressionMode::Triangles:
+				task.encoded.resize(meshopt::encodeIndexBufferBound(task.count));
+				size = meshopt::encodeIndexBuffer(task.encoded.data(), source.data(), task.count, task.byteStride);
+				break;
+			case MeshoptCompressionMode::Indices:
+				task.encoded.resize(meshopt::encodeIndexSequenceBound(task.count));
+				size = meshopt::encodeIndexSequence(task.encoded.data(), source.data(), task.count, task.byteStride);
+				break;
+		}
+
+		// Views which would not get smaller are left uncompressed, unless they were already filtered.
+		if (size == 0 || (task.filter == MeshoptCompressionFilter::None && size >= task.source.size())) {
+			task.encoded.clear();
+			return;
+		}
+		task.encoded.resize(size);
+	}
+} // namespace fastgltf
+#endif
+
+void fg::Exporter::encodeMeshoptCompression(const Asset& asset) {
+#if FASTGLTF_ENABLE_MESHOPT_ENCODER
+	// The views of assets which already use the extension would need to be decoded first.
+	for (const auto& view : asset.bufferViews) {
+		if (view.meshoptCompression != nullptr)
+			return;
+	}
+	for (const auto& buffer : asset.buffers) {
+		if (std::holds_alternative<sources::Fallback>(buffer.data))
+			return;
+	}
+
+	std::vector<span<const std::byte>> bufferData(asset.buffers.size());
+	for (std::size_t i = 0; i < asset.buffers.size(); ++i) {
+		bufferData[i] = std::visit(visitor {
+			[](const auto&) -> span<const std::byte> {
+				return {};
+			},
+			[&](const sources::Array& array) -> span<const std::byte> {
+				return span(array.bytes.data(), array.bytes.size_bytes());
+			},
+			[&](const sources::Vector& vec) -> span<const std::byte> {
+				return span(vec.bytes.data(), vec.bytes.size());
+			},
+			[&](const sources::ByteView& bv) -> span<const std::byte> {
+				return bv.bytes;
+			},
+		}, asset.buffers[i].data);
+	}
+
+	// Classify every view by the accessors using it. Views which are not referenced by any accessor,
+	// or are used by images or sparse accessors, are never compressed.
+	const auto viewCount = asset.bufferViews.size();
+	std::vector<ExportViewUsage> viewUsages(viewCount, ExportViewUsage::Unused);
+	std::vector<std::size_t> viewAccessorCounts(viewCount, 0);
+	std::vector<std::size_t> viewElementSizes(viewCount, 0);
+	std::vector<bool> viewTriangleLists(viewCount, true);
+	auto markView = [&](std::size_t viewIndex, ExportViewUsage usage) {
+		if (viewIndex >= viewCount)
+			return;
+		auto& current = viewUsages[viewIndex];
+		current = current == ExportViewUsage::Unused || current == usage ? usage : ExportViewUsage::Other;
+	};
+
+	// Every use of an accessor proposes a filter, and an accessor is only filtered if all of them agree.
+	const bool useFilters = hasBit(options, ExportOptions::MeshoptFilters);
+	std::vector<Optional<MeshoptCompressionFilter>> accessorFilters(asset.accessors.size());
+	std::vector<bool> indexAccessors(asset.accessors.size(), false);
+	std::vector<bool> triangleAccessors(asset.accessors.size(), true);
+	auto useAccessor = [&](std::size_t accessorIndex, MeshoptCompressionFilter filter) {
+		if (accessorIndex >= accessorFilters.size())
+			return;
+		auto& current = accessorFilters[accessorIndex];
+		current = !current.has_value() || *current == filter ? filter : MeshoptCompressionFilter::None;
+	};
+	auto isFloat = [&](std::size_t accessorIndex, AccessorType type) {
+		return accessorIndex < asset.accessors.size() && asset.accessors[accessorIndex].type == type
+			&& asset.accessors[accessorIndex].componentType == ComponentType::Float;
+	};
+
+	for (const auto& mesh : asset.meshes) {
+		for (const auto& primitive : mesh.primitives) {
+			for (const auto& attribute : primitive.attributes) {
+				const auto index = attribute.accessorIndex;
+				const std::string_view name = attribute.name;
+				if ((name == "NORMAL" && isFloat(index, AccessorType::Vec3)) || (name == "TANGENT" && isFloat(index, AccessorType::Vec4))) {
+					useAccessor(index, MeshoptCompressionFilter::Octahedral);
+				} else if (name.substr(0, 9) == "TEXCOORD_" && isFloat(index, AccessorType::Vec2)) {
+					useAccessor(index, MeshoptCompressionFilter::Exponential);
+				} else {
+					useAccessor(index, MeshoptCompressionFilter::None);
+				}
+			}
+			for (const auto& target : primitive.targets) {
+				for (const auto& attribute : target) {
+					useAccessor(attribute.accessorIndex, MeshoptCompressionFilter::None);
+				}
+			}
+			if (primitive.indicesAccessor.has_value() && *primitive.indicesAccessor < asset.accessors.size()) {
+				useAccessor(*primitive.indicesAccessor, MeshoptCompressionFilter::None);
+				indexAccessors[*primitive.indicesAccessor] = true;
+				if (primitive.type != PrimitiveType::Triangles)
+					triangleAccessors[*primitive.indicesAccessor] = false;
+			}
+		}
+	}
+	for (const auto& node : asset.nodes) {
+		for (const auto& attribute : node.instancingAttributes) {
+			useAccessor(attribute.accessorIndex, MeshoptCompressionFilter::None);
+		}
+	}
+	for (const auto& skin : asset.skins) {
+		if (skin.inverseBindMatrices.has_value())
+			useAccessor(*skin.inverseBindMatrices, MeshoptCompressionFilter::None);
+	}
+	for (const auto& animation : asset.animations) {
+		// Samplers which are not used by any channel keep their data as it is.
+		std::vector<bool> usedSamplers(animation.samplers.size(), false);
+		for (const auto& channel : animation.channels) {
+			if (channel.samplerIndex >= animation.samplers.size())
+				continue;
+			usedSamplers[channel.samplerIndex] = true;
+			const auto& sampler = animation.samplers[channel.samplerIndex];
+			const auto index = sampler.outputAccessor;
+
+			// The tangents of cubic spline samplers are not unit quaternions.
+			if (channel.path == AnimationPath::Rotation && sampler.interpolation != AnimationInterpolation::CubicSpline
+					&& isFloat(index, AccessorType::Vec4)) {
+				useAccessor(index, MeshoptCompressionFilter::Quaternion);
+			} else if (isFloat(index, AccessorType::Vec4) || isFloat(index, AccessorType::Vec3) || isFloat(index, AccessorType::Scalar)) {
+				useAccessor(index, MeshoptCompressionFilter::Exponential);
+			} else {
+				useAccessor(index, MeshoptCompressionFilter::None);
+			}
+		}
+		for (std::size_t i = 0; i < animation.samplers.size(); ++i) {
+			useAccessor(animation.samplers[i].inputAccessor, MeshoptCompressionFilter::None);
+			if (!usedSamplers[i])
+				useAccessor(animation.samplers[i].outputAccessor, MeshoptCompressionFilter::None);
+		}
+	}
+
+	for (std::size_t i = 0; i < asset.accessors.size(); ++i) {
+		const auto& accessor = asset.accessors[i];
+		if (accessor.sparse.has_value()) {
+			markView(accessor.sparse->indicesBufferView, ExportViewUsage::Other);
+			markView(accessor.sparse->valuesBufferView, ExportViewUsage::Other);
+		}
+		if (!accessor.bufferViewIndex.has_value() || *accessor.bufferViewIndex >= viewCount)
+			continue;
+
+		const auto viewIndex = *accessor.bufferViewIndex;
+		const auto elementSize = getElementByteSize(accessor.type, accessor.componentType);
+		++viewAccessorCounts[viewIndex];
+		auto& viewElementSize = viewElementSizes[viewIndex];
+		viewElementSize = viewElementSize == 0 || viewElementSize == elementSize ? elementSize : std::numeric_limits<std::size_t>::max();
+		if (indexAccessors[i]) {
+			markView(viewIndex, ExportViewUsage::Indices);
+
+			// Triangles may be rotated by the codec, which is only fine if every accessor reads whole triangles.
+			const auto indexSize = getComponentByteSize(accessor.componentType);
+			const bool triangles = triangleAccessors[i] && accessor.count % 3 == 0 && accessor.byteOffset % (3 * indexSize) == 0;
+			viewTriangleLists[viewIndex] = viewTriangleLists[viewIndex] && triangles;
+		} else {
+			markView(viewIndex, ExportViewUsage::Attributes);
+		}
+	}
+	for (const auto& image : asset.images) {
+		if (const auto* view = std::get_if<sources::BufferView>(&image.data); view != nullptr)
+			markView(view->bufferViewIndex, ExportViewUsage::Other);
+	}
+
+	auto encoding = std::make_shared<MeshoptEncoding>();
+	encoding->filteredComponentTypes.resize(asset.accessors.size());
+
+	std::vector<MeshoptEncodeTask> tasks;
+	std::vector<std::size_t> viewTasks(viewCount, std::numeric_limits<std::size_t>::max());
+	for (std::size_t i = 0; i < viewCount; ++i) {
+		const auto& view = asset.bufferViews[i];
+		if (view.bufferIndex >= bufferData.size() || bufferData[view.bufferIndex].data() == nullptr)
+			continue;
+		const auto& data = bufferData[view.bufferIndex];
+		if (view.byteOffset > data.size() || view.byteLength > data.size() - view.byteOffset || view.byteLength == 0)
+			continue;
+
+		MeshoptEncodeTask task = {};
+		task.viewIndex = i;
+		task.source = data.subspan(view.byteOffset, view.byteLength);
+		task.filter = MeshoptCompressionFilter::None;
+		if (viewUsages[i] == ExportViewUsage::Indices) {
+			// Views with indices of different sizes are left uncompressed.
+			const auto indexSize = viewElementSizes[i];
+			if ((indexSize != sizeof(std::uint16_t) && indexSize != sizeof(std::uint32_t)) || view.byteStride.has_value()
+					|| view.byteLength % indexSize != 0)
+				continue;
+			task.count = view.byteLength / indexSize;
+			task.byteStride = indexSize;
+			task.mode = viewTriangleLists[i] && task.count % 3 == 0 ? MeshoptCompressionMode::Triangles : MeshoptCompressionMode::Indices;
+		} else if (viewUsages[i] == ExportViewUsage::Attributes) {
+			// Views without a stride can hold accessors with differently sized elements, which are
+			// then compressed as a stream of 4-byte elements.
+			task.mode = MeshoptCompressionMode::Attributes;
+			const auto elementSize = viewElementSizes[i];
+			task.byteStride = view.byteStride.value_or(elementSize % 4 == 0 && elementSize <= 256 ? elementSize : 4);
+			if (task.byteStride == 0 || task.byteStride % 4 != 0 || task.byteStride > 256)
+				continue;
+			task.count = (view.byteLength + task.byteStride - 1) / task.byteStride;
+		} else {
+			continue;
+		}
+
+		viewTasks[i] = tasks.size();
+		tasks.emplace_back(std::move(task));
+	}
+
+	if (useFilters) {
+		for (std::size_t i = 0; i < asset.accessors.size(); ++i) {
+			const auto& accessor = asset.accessors[i];
+			const auto filter = accessorFilters[i].value_or(MeshoptCompressionFilter::None);
+			if (filter == MeshoptCompressionFilter::None || accessor.sparse.has_value() || !accessor.bufferViewIndex.has_value())
+				continue;
+
+			// The accessor needs to be the only one reading its view, and read all of its elements.
+			const auto viewIndex = *accessor.bufferViewIndex;
+			const auto elementSize = getElementByteSize(accessor.type, accessor.componentType);
+			if (viewIndex >= viewCount || viewTasks[viewIndex] >= tasks.size() || viewAccessorCounts[viewIndex] != 1
+					|| accessor.byteOffset != 0 || tasks[viewTasks[viewIndex]].byteStride != elementSize
+					|| !elementsFit(asset.bufferViews[viewIndex].byteLength, 0, accessor.count, elementSize, elementSize))
+				continue;
+
+			auto& task = tasks[viewTasks[viewIndex]];
+			task.filter = filter;
+			task.count = accessor.count;
+			task.componentCount = getNumComponents(accessor.type);
+			if (filter == MeshoptCompressionFilter::Octahedral) {
+				task.byteStride = 4;
+				encoding->filteredComponentTypes[i] = ComponentType::Byte;
+			} else if (filter == MeshoptCompressionFilter::Quaternion) {
+				task.byteStride = 8;
+				encoding->filteredComponentTypes[i] = ComponentType::Short;
+			}
+		}
+	}
+
+	runTasks(tasks.size(), [](std::size_t index, void* taskData) {
+		encodeMeshoptView((*static_cast<std::vector<MeshoptEncodeTask>*>(taskData))[index]);
+	}, &tasks, executorCallback, userPointer);
+
+	// Write all compressed streams and the uncompressed views held in memory into the first buffer, and let the
+	// compressed views decode into the second one. Filtered accessors whose view failed to encode keep their data.
+	std::vector<std::byte> packed;
+	auto append = [&](span<const std::byte> bytes) {
+		const auto offset = alignUp(packed.size(), 4);
+		packed.resize(offset + bytes.size());
+		std::memcpy(packed.data() + offset, bytes.data(), bytes.size());
+		return offset;
+	};
+
+	encoding->buffers.resize(2);
+	std::vector<std::size_t> bufferIndices(asset.buffers.size(), 0);
+	for (std::size_t i = 0; i < asset.buffers.size(); ++i) {
+		if (bufferData[i].data() != nullptr) {
+			if (encoding->buffers.front().name.empty())
+				encoding->buffers.front().name = asset.buffers[i].name;
+			continue;
+		}
+		bufferIndices[i] = encoding->buffers.size();
+		encoding->buffers.emplace_back(asset.buffers[i]);
+	}
+
+	bool anyCompressed = false;
+	std::size_t fallbackLength = 0;
+	encoding->bufferViews.reserve(viewCount);
+	for (std::size_t i = 0; i < viewCount; ++i) {
+		const auto& view = asset.bufferViews[i];
+		auto& output = encoding->bufferViews.emplace_back();
+		output.byteStride = view.byteStride;
+		output.target = view.target;
+		output.name = view.name;
+
+		auto* task = viewTasks[i] < tasks.size() ? &tasks[viewTasks[i]] : nullptr;
+		if (task != nullptr && task->encoded.empty() && task->filter != MeshoptCompressionFilter::None) {
+			for (std::size_t j = 0; j < asset.accessors.size(); ++j) {
+				if (asset.accessors[j].bufferViewIndex == i)
+					encoding->filteredComponentTypes[j].reset();
+			}
+		}
+
+		if (task != nullptr && !task->encoded.empty()) {
+			anyCompressed = true;
+			fallbackLength = alignUp(fallbackLength, 4);
+			output.bufferIndex = 1;
+			output.byteOffset = fallbackLength;
+			output.byteLength = task->count * task->byteStride;
+			fallbackLength += output.byteLength;
+
+			// Octahedral normals are padded to four bytes, which needs to be declared as the stride.
+			if (task->filter != MeshoptCompressionFilter::None) {
+				const std::size_t componentSize = task->filter == MeshoptCompressionFilter::Octahedral ? 1
+					: task->filter == MeshoptCompressionFilter::Quaternion ? 2 : 4;
+				if (view.byteStride.has_value() || task->componentCount * componentSize != task->byteStride)
+					output.byteStride = task->byteStride;
+			}
+
+			const auto offset = append(span<const std::byte>(task->encoded.data(), task->encoded.size()));
+			output.meshoptCompression = std::make_unique<CompressedBufferView>(CompressedBufferView {
+				0, offset, task->encoded.size(), task->count, task->mode, task->filter, task->byteStride,
+			});
+		} else if (view.bufferIndex < bufferData.size() && bufferData[view.bufferIndex].data() != nullptr
+				&& view.byteOffset <= bufferData[view.bufferIndex].size()
+				&& view.byteLength <= bufferData[view.bufferIndex].size() - view.byteOffset) {
+			output.bufferIndex = 0;
+			output.byteOffset = append(bufferData[view.bufferIndex].subspan(view.byteOffset, view.byteLength));
+			output.byteLength = view.byteLength;
+		} else {
+			output.bufferIndex = view.bufferIndex < bufferIndices.size() ? bufferIndices[view.bufferIndex] : view.bufferIndex;
+			output.byteOffset = view.byteOffset;
+			output.byteLength = view.byteLength;
+		}
+	}
+
+	if (!anyCompressed)
+		return;
+
+	auto& packedBuffer = encoding->buffers[0];
+	packedBuffer.byteLength = packed.size();
+	packedBuffer.data = sources::Vector { std::move(packed), MimeType::GltfBuffer };
+	auto& fallbackBuffer = encoding->buffers[1];
+	fallbackBuffer.byteLength = fallbackLength;
+	fallbackBuffer.data = sources::Fallback {};
+
+	auto addExtension = [](std::vector<std::string>& list, std::string_view name) {
+		if (std::find(list.begin(), list.end(), name) == list.end())
+			list.emplace_back(name);
+	};
+	encoding->extensionsUsed.assign(asset.extensionsUsed.begin(), asset.extensionsUsed.end());
+	encoding->extensionsRequired.assign(asset.extensionsRequired.begin(), asset.extensionsRequired.end());
+	// The fallback buffer has no URI, which the spec only allows when the extension is required.
+	addExtension(encoding->extensionsUsed, extensions::EXT_meshopt_compression);
+	addExtension(encoding->extensionsRequired, extensions::EXT_meshopt_compression);
+	for (const auto& componentType : encoding->filteredComponentTypes) {
+		if (componentType.has_value() && *componentType == ComponentType::Byte) {
+			// Normalized normals and tangents are only allowed with KHR_mesh_quantization.
+			addExtension(encoding->extensionsUsed, extensions::KHR_mesh_quantization);
+			addExtension(encoding->extensionsRequired, extensions::KHR_mesh_quantization);
+			break;
+		}
+	}
+
+	meshoptEncoding = std::move(encoding);
+#else
+	(void)asset;
+#endif
+}
+
+void fg::Exporter::writeAccessors(const Asset& asset, std::string& json) {
+	if (asset.accessors.empty())
+		return;
+	if (json.back() == ']' || json.back() == '}')
+		json += ',';
+
+	json += R"("accessors":[)";
+	for (auto it = asset.accessors.begin(); it != asset.accessors.end(); ++it) {
+		json += '{';
+
+		// Accessors quantized by a meshopt filter are normalized, and their bounds no longer apply.
+		Optional<ComponentType> filteredComponentType;
+		if (meshoptEncoding != nullptr) {
+			filteredComponentType = meshoptEncoding->filteredComponentTypes[uabs(std::distance(asset.accessors.begin(), it))];
+		}
+
+		if (it->byteOffset != 0) {
+			json += "\"byteOffset\":";
+			appendNumber(json, it->byteOffset);
+			json += ',';
+		}
+
+		json += "\"count\":";
+		appendNumber(json, it->count);
+		json += ',';
+		json += R"("type":")";
+		json += getAccessorTypeName(it->type);
+		json += "\",";
+		json += "\"componentType\":";
+		appendNumber(json, getGLComponentType(filteredComponentType.value_or(it->componentType)));
+
+		if (it->normalized || filteredComponentType.has_value()) {
+			json += ",\"normalized\":true";
+		}
+
+		if (it->bufferViewIndex.has_value()) {
+			json += ",\"bufferView\":";
+			appendNumber(json, it->bufferViewIndex.value());
+		}
+
+		auto writeMinMax = [&](const std::optional<AccessorBoundsArray>& ref, const std::string_view name) {
+			if (!ref.has_value())
+				return; // This is valid, since min/max are only required on specific accessors.
+			json += ",\"";
+			json += name;
+			json += "\":[";
+
+			for (std::size_t i = 0; i < ref->size(); ++i) {
+				if (ref->isType<double>()) {
+					appendNumber(json, static_cast<num>(ref->get<double>(i)));
+				} else if (ref->isType<std::int64_t>()) {
+					appendNumber(json, ref->get<std::int64_t>(i));
+				}
+				if (i + 1 < ref->size())
+					json += ',';
+			}
+			json += ']';
+		};
+		if (!filteredComponentType.has_value()) {
+			writeMinMax(it->max, "max");
+			writeMinMax(it->min, "min");
+		}
+
+		if (extrasWriteCallback != nullptr) {
+			auto extras = extrasWriteCallback(uabs(std::distance(asset.accessors.begin(), it)), fastgltf::Category::Accessors, userPointer);
+			if (extras.has_value()) {
+				json += ",\"extras\":";
+				json += *extras;
+			}
+		}
+
+		if (!it->name.empty()) {
+			json += R"(,"name":")";
+			appendEscapedString(json, it->name);
+			json += '"';
+		}
+
+		json += '}';
+		if (uabs(std::distance(asset.accessors.begin(), it)) + 1 <asset.accessors.size())
+			json += ',';
+	}
+	json += ']';
+}
+
+void fg::Exporter::writeAnimations(const Asset& asset, std::string& json)
+{
+	if (asset.animations.empty())
+		return;
+	if (json.back() == ']' || json.back() == '}')
+		json += ',';
+
+	json += R"("animations":[)";
+	for (auto it = asset.animations.begin(); it != asset.animations.end(); ++it) {
+		json += '{';
+
+		json += R"("channels":[)";
+		for (auto ci = it->channels.begin(); ci != it->channels.end(); ++ci) {
+			json += "{";
+			json += R"("sampler":)";
+			appendNumber(json, ci->samplerIndex);
+			json += ",";
+			json += R"("target":{)";
+			if (ci->nodeIndex.has_value()) {
+				json += R"("node":)";
+				appendNumber(json, ci->nodeIndex.value());
+				json += ",";
+			}
+			json += R"("path":")";
+			switch (ci->path) {
+			case fg::AnimationPath::Translation:
+				json += "translation";
+				break;
+			case fg::AnimationPath::Rotation:
+				json += "rotation";
+				break;
+			case fg::AnimationPath::Scale:
+				json += "scale";
+				break;
+			case fg::AnimationPath::Weights:
+				json += "weights";
+				break;
+			}
+			json += "\"}}";
+
+			if (uabs(std::distance(it->channels.begin(), ci)) + 1 < it->channels.size())
+				json += ',';
+		}
+		json += "],";
+
+		json += R"("samplers":[)";
+		for (auto si = it->samplers.begin(); si != it->samplers.end(); ++si) {
+			json += '{';
+			json += R"("input":)";
+			appendNumber(json, si->inputAccessor);
+			json += ',';
+
+			if (si->interpolation != fg::AnimationInterpolation::Linear) {
+				json += R"("interpolation":")";
+				if (si->interpolation == fg::AnimationInterpolation::Step) {
+					json += "STEP\",";
+				} else {
+					json += "CUBICSPLINE\",";
+				}
+			}
+
+			json += R"("output":)";
+			appendNumber(json, si->outputAccessor);
+			json += '}';
+
+			if (uabs(std::distance(it->samplers.begin(), si)) + 1 < it->samplers.size())
+				json += ',';
+		}
+		json += ']';
+
+		if (extrasWriteCallback != nullptr) {
+			auto extras = extrasWriteCallback(uabs(std::distance(asset.animations.begin(), it)), fastgltf::Category::Animations, userPointer);
+			if (extras.has_value()) {
+				json += ",\"extras\":";
+				json += *extras;
+			}
+		}
+
+		if (!it->name.empty()) {
+			json += R"(,"name":")";
+			appendEscapedString(json, it->name);
+			json += '"';
+		}
+
+		json += '}';
+		if (uabs(std::distance(asset.animations.begin(), it)) + 1 < asset.animations.size())
+			json += ',';
+	}
+	json += ']';
+}
+
+void fg::Exporter::writeBuffers(const Asset& asset, std::string& json) {
+	const auto& buffers = getExportedBuffers(asset);
+	if (buffers.empty())
+		return;
+	if (json.back() == ']' || json.back() == '}')
+		json += ',';
+
+	json += "\"buffers\":[";
+	for (auto it = buffers.begin(); it != buffers.end(); ++it) {
+		json += '{';
+
+        auto bufferIdx = uabs(std::distance(buffers.begin(), it));
+		std::visit(visitor {
+			[&](auto&) {
+				// Covers BufferView and CustomBuffer.
+				errorCode = Error::InvalidGltf;
+			},
+			[&](const sources::Array& vector) {
+                if (bufferIdx == 0 && exportingBinary) {
+                    bufferPaths.emplace_back(std::nullopt);
+                    return;
+                }
+                if (hasBit(options, ExportOptions::WriteDataUris)) {
+                    appendDataUri(json, mimeTypeOctetStream, span<const std::byte>(vector.bytes.data(), vector.bytes.size()));
+                    json += ',';
+                    bufferPaths.emplace_back(std::nullopt);
+                    return;
+                }
+                auto path = getBufferFilePath(asset, bufferIdx);
+                json += R"("uri":")";
+                json += fg::normalizeAndFormatPath(path);
+                json += '"';
+                json += ',';
+                bufferPaths.emplace_back(path);
+			},
+			[&](const sources::Vector& vector) {
+				if (bufferIdx == 0 && exportingBinary) {
+					bufferPaths.emplace_back(std::nullopt);
+					return;
+				}
+				if (hasBit(options, ExportOptions::WriteDataUris)) {
+					appendDataUri(json, mimeTypeOctetStream, span<const std::byte>(vector.bytes.data(), vector.bytes.size()));
+					json += ',';
+					bufferPaths.emplace_back(std::nullopt);
+					return;
+				}
+				auto path = getBufferFilePath(asset, bufferIdx);
+				json += R"("uri":")";
+				json += fg::normalizeAndFormatPath(path);
+				json += '"';
+				json += ',';
+				bufferPaths.emplace_back(path);
+			},
+			[&](const sources::ByteView& view) {
+				if (bufferIdx == 0 && exportingBinary) {
+					bufferPaths.emplace_back(std::nullopt);
+					return;
+				}
+				if (hasBit(options, ExportOptions::WriteDataUris)) {
+					appendDataUri(json, mimeTypeOctetStream, view.bytes);
+					json += ',';
+					bufferPaths.emplace_back(std::nullopt);
+					return;
+				}
+                auto path = getBufferFilePath(asset, bufferIdx);
+                json += R"("uri":")";
+                json += fg::normalizeAndFormatPath(path);
+                json += '"';
+                json += ',';
+                bufferPaths.emplace_back(path);
+			},
+			[&](const sources::URI& uri) {
+				json += R"("uri":")";
+				appendEscapedString(json, uri.uri.string());
+				json += '"';
+				json += ',';
+                bufferPaths.emplace_back(std::nullopt);
+			},
+			[&]([[maybe_unused]] const sources::Fallback& fallback) {
+				json += R"("extensions":{"EXT_meshopt_compression":{"fallback":true}},)";
+				bufferPaths.emplace_back(std::nullopt);
+			},
+		}, it->data);
+
+		json += "\"byteLength\":";
+		appendNumber(json, it->byteLength);
+
+		if (extrasWriteCallback != nullptr) {
+			auto extras = extrasWriteCallback(bufferIdx, fastgltf::Category::Buffers, userPointer);
+			if (extras.has_value()) {
+				json += ",\"extras\":";
+				json += *extras;
+			}
+		}
+
+		if (!it->name.empty()) {
+			json += R"(,"name":")";
+			appendEscapedString(json, it->name);
+			json += '"';
+		}
+		json += '}';
+		if (bufferIdx + 1 < buffers.size())
+			json += ',';
+	}
+	json += "]";
+}
+
+void fg::Exporter::writeBufferViews(const Asset& asset, std::string& json) {
+	const auto& bufferViews = meshoptEncoding != nullptr ? meshoptEncoding->bufferViews : asset.bufferViews;
+	if (bufferViews.empty())
+		return;
+	if (json.back() == ']' || json.back() == '}')
+		json += ',';
+
+	json += "\"bufferViews\":[";
+	for (auto it = bufferViews.begin(); it != bufferViews.end(); ++it) {
+		json += '{';
+
+		json += "\"buffer\":";
+		appendNumber(json, it->bufferIndex);
+		json += ',';
+		json += "\"byteLength\":";
+		appendNumber(json, it->byteLength);
+
+		if (it->byteOffset != 0) {
+			json += ",\"byteOffset\":";
+			appendNumber(json, it->byteOffset);
+		}
+
+		if (it->byteStride.has_value()) {
+			json += ",\"byteStride\":";
+			appendNumber(json, it->byteStride.value());
+		}
+
+		if (it->target.has_value()) {
+			json += ",\"target\":";
+			appendNumber(json, to_underlying(it->target.value()));
+		}
+
+        if (it->meshoptCompression != nullptr) {
+            json += R"(,"extensions":{"EXT_meshopt_compression":{)";
+            const auto& meshopt = *it->meshoptCompression;
+            json += "\"buffer\":";
+            appendNumber(json, meshopt.bufferIndex);
+            if (meshopt.byteOffset != 0) {
+                json += ",\"byteOffset\":";
+                appendNumber(json, meshopt.byteOffset);
+            }
+            json += ",\"byteLength\":";
+            appendNumber(json, meshopt.byteLength);
+            json += ",\"byteStride\":";
+            appendNumber(json, meshopt.byteStride);
+            json += ",\"count\":";
+            appendNumber(json, meshopt.count);
+
+            json += ",\"mode\":";
+            if (meshopt.mode == MeshoptCompressionMode::Attributes) {
+                json += "\"ATTRIBUTES\"";
+            } else if (meshopt.mode == MeshoptCompressionMode::Triangles) {
+                json += "\"TRIANGLES\"";
+            } else if (meshopt.mode == MeshoptCompressionMode::Indices) {
+                json += "\"INDICES\"";
+            }
+            if (meshopt.filter != MeshoptCompressionFilter::None) {
+                json += ",\"filter\":";
+                if (meshopt.filter == MeshoptCompressionFilter::Exponential) {
+                    json += "\"EXPONENTIAL\"";
+                } else if (meshopt.filter == MeshoptCompressionFilter::Quaternion) {
+                    json += "\"QUATERNION\"";
+                } else if (meshopt.filter == MeshoptCompressionFilter::Octahedral) {
+                    json += "\"OCTAHEDRAL\"";
+                }
+            }
+            json += "}}";
+        }
+
+		if (extrasWriteCallback != nullptr) {
+			auto extras = extrasWriteCallback(uabs(std::distance(bufferViews.begin(), it)), fastgltf::Category::BufferViews, userPointer);
+			if (extras.has_value()) {
+				json += ",\"extras\":";
+				json += *extras;
+			}
+		}
+
+		if (!it->name.empty()) {
+			json += R"(,"name":")";
+			appendEscapedString(json, it->name);
+			json += '"';
+		}
+
+		json += '}';
+		if (uabs(std::distance(bufferViews.begin(), it)) + 1 < bufferViews.size())
+			json += ',';
+	}
+	json += ']';
+}
+
+void fg::Exporter::writeCameras(const Asset& asset, std::string& json) {
+	if (asset.cameras.empty())
+		return;
+	if (json.back() == ']' || json.back() == '}')
+		json += ',';
+
+	json += "\"cameras\":[";
+	for (auto it = asset.cameras.begin(); it != asset.cameras.end(); ++it) {
+		json += '{';
+
+		std::visit(visitor {
+			[](auto&) {},
+			[&](const Camera::Perspective& perspective) {
+				json += "\"perspective\":{";
+
+				if (perspective.aspectRatio.has_value()) {
+					json += "\"aspectRatio\":";
+					appendNumber(json, perspective.aspectRatio.value());
+					json += ',';
+				}
+
+				json += "\"yfov\":";
+				appendNumber(json, perspective.yfov);
+				json += ',';
+
+				if (perspective.zfar.has_value()) {
+					json += "\"zfar\":";
+					appendNumber(json, perspective.zfar.value());
+					json += ',';
+				}
+
+				json += "\"znear\":";
+				appendNumber(json, perspective.znear);
+
+				json += R"(},"type":"perspective")";
+			},
+			[&](const Camera::Orthographic& orthographic) {
+				json += "\"orthographic\":{";
+				json += "\"xmag\":";
+				appendNumber(json, orthographic.xmag);
+				json += ',';
+				json += "\"ymag\":";
+				appendNumber(json, orthographic.ymag);
+				json += ',';
+				json += "\"zfar\":";
+				appendNumber(json, orthographic.zfar);
+				json += ',';
+				json += "\"znear\":";
+				appendNumber(json, orthographic.znear);
+				json += R"(},"type":"orthographic")";
+			}
+		}, it->camera);
+
+		if (extrasWriteCallback != nullptr) {
+			auto extras = extrasWriteCallback(uabs(std::distance(asset.cameras.begin(), it)), fastgltf::Category::Cameras, userPointer);
+			if (extras.has_value()) {
+				json += ",\"extras\":";
+				json += *extras;
+			}
+		}
+
+		if (!it->name.empty()) {
+			json += R"(,"name":")";
+			appendEscapedString(json, it->name);
+			json += '"';
+		}
+
+		json += '}';
+		if (uabs(std::distance(asset.cameras.begin(), it)) + 1 <asset.cameras.size())
+			json += ',';
+	}
+	json += ']';
+}
+
+void fg::Exporter::writeImages(const Asset& asset, std::string& json) {
+	if (asset.images.empty())
+		return;
+	if (json.back() == ']' || json.back() == '}')
+		json += ',';
+
+	json += "\"images\":[";
+	for (auto it = asset.images.begin(); it != asset.images.end(); ++it) {
+		json += '{';
+
+        auto imageIdx = uabs(std::distance(asset.images.begin(), it));
+		std::visit(visitor {
+			[&](auto&) {
+				errorCode = Error::InvalidGltf;
+			},
+            [&](const sources::BufferView& bufferView) {
+                json += R"("bufferView":)";
+                appendNumber(json, bufferView.bufferViewIndex);
+                json += ',';
+				json += R"("mimeType":")";
+				json += getMimeTypeString(bufferView.mimeType);
+				json += '"';
+                imagePaths.emplace_back(std::nullopt);
+            },
+            [&](const sources::Array& vector) {
+                if (hasBit(options, ExportOptions::WriteDataUris)) {
+                    appendDataUri(json, vector.mimeType != MimeType::None ? getMimeTypeString(vector.mimeType) : mimeTypeOctetStream,
+                        span<const std::byte>(vector.bytes.data(), vector.bytes.size()));
+                    imagePaths.emplace_back(std::nullopt);
+                } else {
+                    auto path = getImageFilePath(asset, imageIdx, vector.mimeType);
+                    json += R"("uri":")";
+                    json += fg::normalizeAndFormatPath(path);
+                    json += '"';
+                    imagePaths.emplace_back(path);
+                }
+				if (vector.mimeType != MimeType::None) {
+					json += R"(,"mimeType":")";
+					json += getMimeTypeString(vector.mimeType);
+					json += '"';
+				}
+            },
+			[&](const sources::Vector& vector) {
+				if (hasBit(options, ExportOptions::WriteDataUris)) {
+					appendDataUri(json, vector.mimeType != MimeType::None ? getMimeTypeString(vector.mimeType) : mimeTypeOctetStream,
+						span<const std::byte>(vector.bytes.data(), vector.bytes.size()));
+					imagePaths.emplace_back(std::nullopt);
+				} else {
+					auto path = getImageFilePath(asset, imageIdx, vector.mimeType);
+					json += R"("uri":")";
+					json += fg::normalizeAndFormatPath(path);
+					json += '"';
+					imagePaths.emplace_back(path);
+				}
+				if (vector.mimeType != MimeType::None) {
+					json += R"(,"mimeType":")";
+					json += getMimeTypeString(vector.mimeType);
+					json += '"';
+				}
+			},
+			[&](const sources::URI& uri) {
+				json += R"("uri":")";
+				appendEscapedString(json, uri.uri.string());
+				json += '"';
+                imagePaths.emplace_back(std::nullopt);
+			},
+		}, it->data);
+		if (errorCode != Error::None)
+			return;
+
+		if (extrasWriteCallback != nullptr) {
+			auto extras = extrasWriteCallback(uabs(std::distance(asset.images.begin(), it)), fastgltf::Category::Images, userPointer);
+			if (extras.has_value()) {
+				json += ",\"extras\":";
+				json += *extras;
+			}
+		}
+
+		if (!it->name.empty()) {
+			json += R"(,"name":")";
+			appendEscapedString(json, it->name);
+			json += '"';
+		}
+		json += '}';
+		if (uabs(std::distance(asset.images.begin(), it)) + 1 <asset.images.size())
+			json += ',';
+	}
+	json += ']';
+}
+
+void fg::Exporter::writeLights(const Asset& asset, std::string& json) {
+	if (asset.lights.empty())
+		return;
+	if (json.back() == ']' || json.back() == '}')
+		json += ',';
+
+	json += R"("KHR_lights_punctual":{"lights":[)";
+	for (auto it = asset.lights.begin(); it != asset.lights.end(); ++it) {
+		json += '{';
+
+		// [1.0f, 1.0f, 1.0f] is the default.
+		if (it->color[0] != 1.0f && it->color[1] != 1.0f && it->color[2] != 1.0f) {
+			json += R"("color":[)";
+			appendNumber(json, it->color[0]);
+			json += ',';
+			appendNumber(json, it->color[1]);
+			json += ',';
+			appendNumber(json, it->color[2]);
+			json += "],";
+		}
+
+		if (it->intensity != 1.0f) {
+			json += R"("intensity":)";
+			appendNumber(json, it->intensity);
+			json += ',';
+		}
+
+		switch (it->type) {
+			case LightType::Directional: {
+				json += R"("type":"directional")";
+				break;
+			}
+			case LightType::Spot: {
+				json += R"("type":"spot")";
+				break;
+			}
+			case LightType::Point: {
+				json += R"("type":"point")";
+				break;
+			}
+		}
+
+		if (it->range.has_value()) {
+			json += R"(,"range":)";
+			appendNumber(json, it->range.value());
+		}
+
+		if (it->type == LightType::Spot) {
+			if (it->innerConeAngle.has_value()) {
+				json += R"("innerConeAngle":)";
+				appendNumber(json, it->innerConeAngle.value());
+				json += ',';
+			}
+
+			if (it->outerConeAngle.has_value()) {
+				json += R"("outerConeAngle":)";
+				appendNumber(json, it->outerConeAngle.value());
+				json += ',';
+			}
+		}
+
+		if (!it->name.empty()) {
+			json += R"(,"name":")";
+			appendEscapedString(json, it->name);
+			json += '"';
+		}
+		json += '}';
+		if (uabs(std::distance(asset.lights.begin(), it)) + 1 <asset.lights.size())
+			json += ',';
+	}
+	json += "]}";
+}
+
+void fg::Exporter::writeMaterials(const Asset& asset, std::string& json) {
+	if (asset.materials.empty())
+		return;
+	if (json.back() == ']' || json.back() == '}')
+		json += ',';
+
+	json += "\"materials\":[";
+	for (auto it = asset.materials.begin(); it != asset.materials.end(); ++it) {
+		json += '{';
+
+		json += "\"pbrMetallicRoughness\":{";
+		if (it->pbrData.baseColorFactor != math::nvec4(1)) {
+			json += R"("baseColorFactor":[)";
+			appendNumber(json, it->pbrData.baseColorFactor[0]);
+			json += ',';
+			appendNumber(json, it->pbrData.baseColorFactor[1]);
+			json += ',';
+			appendNumber(json, it->pbrData.baseColorFactor[2]);
+			json += ',';
+			appendNumber(json, it->pbrData.baseColorFactor[3]);
+			json += "]";
+		}
+
+		if (it->pbrData.baseColorTexture.has_value()) {
+			if (json.back() != '{') json += ',';
+			json += "\"baseColorTexture\":";
+			writeTextureInfo(json, &it->pbrData.baseColorTexture.value());
+		}
+
+		if (it->pbrData.metallicFactor != 1.0f) {
+			if (json.back() != '{') json += ',';
+			json += "\"metallicFactor\":";
+			appendNumber(json, it->pbrData.metallicFactor);
+		}
+
+		if (it->pbrData.roughnessFactor != 1.0f) {
+			if (json.back() != '{') json += ',';
+			json += "\"roughnessFactor\":";
+			appendNumber(json, it->pbrData.roughnessFactor);
+		}
+
+		if (it->pbrData.metallicRoughnessTexture.has_value()) {
+			if (json.back() != '{') json += ',';
+			json += "\"metallicRoughnessTexture\":";
+			writeTextureInfo(json, &it->pbrData.metallicRoughnessTexture.value());
+		}
+
+		json += '}';
+
+		if (it->normalTexture.has_value()) {
+			if (json.back() != ',') json += ',';
+			json += "\"normalTexture\":";
+			writeTextureInfo(json, &it->normalTexture.value(), TextureInfoType::NormalTexture);
+		}
+
+		if (it->occlusionTexture.has_value()) {
+			if (json.back() != ',') json += ',';
+			json += "\"occlusionTexture\":";
+			writeTextureInfo(json, &it->occlusionTexture.value(), TextureInfoType::OcclusionTexture);
+		}
+
+		if (it->emissiveTexture.has_value()) {
+			if (json.back() != ',') json += ',';
+			json += "\"emissiveTexture\":";
+			writeTextureInfo(json, &it->emissiveTexture.value());
+		}
+
+		if (it->emissiveFactor != math::nvec3(0)) {
+			if (json.back() != ',') json += ',';
+			json += R"("emissiveFactor":[)";
+			appendNumber(json, it->emissiveFactor[0]);
+			json += ',';
+			appendNumber(json, it->emissiveFactor[1]);
+			json += ',';
+			appendNumber(json, it->emissiveFactor[2]);
+			json += "],";
+		}
+
+		if (it->alphaMode != AlphaMode::Opaque) {
+			if (json.back() != ',') json += ',';
+			json += R"("alphaMode":)";
+			if (it->alphaMode == AlphaMode::Blend) {
+				json += "\"BLEND\"";
+			} else if (it->alphaMode == AlphaMode::Mask) {
+				json += "\"MASK\"";
+			}
+		}
+
+		if (it->alphaMode == AlphaMode::Mask && it->alphaCutoff != 0.5f) {
+			if (json.back() != ',') json += ',';
+			json += R"("alphaCutoff":)";
+			appendNumber(json, it->alphaCutoff);
+		}
+
+		if (it->doubleSided) {
+			if (json.back() != ',') json += ',';
+			json += R"("doubleSided":true)";
+		}
+
+		if (json.back() != ',') json += ',';
+		json += R"("extensions":{)";
+
+		if (it->anisotropy) {
+			json += R"("KHR_materials_anisotropy":{)";
+			if (it->anisotropy->anisotropyStrength != 0.0f) {
+				json += R"("anisotropyStrength":)";
+				appendNumber(json, it->anisotropy->anisotropyStrength);
+			}
+			if (it->anisotropy->anisotropyRotation != 0.0f) {
+				if (json.back() != '{') json += ',';
+				json += R"("anisotropyRotation":)";
+				appendNumber(json, it->anisotropy->anisotropyRotation);
+			}
+			if (it->anisotropy->anisotropyTexture.has_value()) {
+				if (json.back() != '{') json += ',';
+				json += "\"anisotropyTexture\":";
+				writeTextureInfo(json, &it->anisotropy->anisotropyTexture.value());
+			}
+			json += '}';
+		}
+
+		if (it->clearcoat) {
+			if (json.back() == '}') json += ',';
+			json += R"("KHR_materials_clearcoat":{)";
+			if (it->clearcoat->clearcoatFactor != 0.0f) {
+				json += R"("clearcoatFactor":)";
+				appendNumber(json, it->clearcoat->clearcoatFactor);
+			}
+			if (it->clearcoat->clearcoatTexture.has_value()) {
+				if (json.back() != '{') json += ',';
+				json += "\"clearcoatTexture\":";
+				writeTextureInfo(json, &it->clearcoat->clearcoatTexture.value());
+			}
+			if (it->clearcoat->clearcoatRoughnessFactor != 0.0f) {
+				if (json.back() != '{') json += ',';
+				json += R"("clearcoatRoughnessFactor":)";
+				appendNumber(json, it->clearcoat->clearcoatRoughnessFactor);
+			}
+			if (it->clearcoat->clearcoatRoughnessTexture.has_value()) {
+				if (json.back() != '{') json += ',';
+				json += "\"clearcoatRoughnessTexture\":";
+				writeTextureInfo(json, &it->clearcoat->clearcoatRoughnessTexture.value());
+			}
+			if (it->clearcoat->clearcoatNormalTexture.has_value()) {
+				if (json.back() != '{') json += ',';
+				json += "\"clearcoatNormalTexture\":";
+				writeTextureInfo(json, &it->clearcoat->clearcoatNormalTexture.value(), TextureInfoType::NormalTexture);
+			}
+			json += '}';
+		}
+
+		if (it->dispersion != 0.0f) {
+			if (json.back() == '}') json += ',';
+			json += R"("KHR_materials_dispersion":{"dispersion":)";
+			appendNumber(json, it->dispersion);
+			json += '}';
+		}
+
+		if (it->emissiveStrength != 1.0f) {
+			if (json.back() == '}') json += ',';
+			json += R"("KHR_materials_emissive_strength":{"emissiveStrength":)";
+			appendNumber(json, it->emissiveStrength);
+			json += '}';
+		}
+
+		if (it->ior != 1.5f) {
+			if (json.back() == '}') json += ',';
+			json += R"("KHR_materials_ior":{"ior":)";
+			appendNumber(json, it->ior);
+			json += '}';
+		}
+
+		if (it->iridescence) {
+			if (json.back() == '}') json += ',';
+			json += R"("KHR_materials_iridescence":{)";
+			if (it->iridescence->iridescenceFactor != 0.0f) {
+				json += R"("iridescenceFactor":)";
+				appendNumber(json, it->iridescence->iridescenceFactor);
+			}
+			if (it->iridescence->iridescenceTexture.has_value()) {
+				if (json.back() != '{') json += ',';
+				json += "\"iridescenceTexture\":";
+				writeTextureInfo(json, &it->iridescence->iridescenceTexture.value());
+			}
+			if (it->iridescence->iridescenceIor != 1.3f) {
+				if (json.back() != '{') json += ',';
+				json += R"("iridescenceIor":)";
+				appendNumber(json, it->iridescence->iridescenceIor);
+			}
+			if (it->iridescence->iridescenceThicknessMinimum != 100.0f) {
+				if (json.back() != '{') json += ',';
+				json += R"("iridescenceThicknessMinimum":)";
+				appendNumber(json, it->iridescence->iridescenceThicknessMinimum);
+			}
+			if (it->iridescence->iridescenceThicknessMaximum != 400.0f) {
+				if (json.back() != '{') json += ',';
+				json += R"("iridescenceThicknessMaximum":)";
+				appendNumber(json, it->iridescence->iridescenceThicknessMaximum);
+			}
+			if (it->iridescence->iridescenceThicknessTexture.has_value()) {
+				if (json.back() != '{') json += ',';
+				json += "\"iridescenceThicknessTexture\":";
+				writeTextureInfo(json, &it->iridescence->iridescenceThicknessTexture.value());
+			}
+			json += '}';
+		}
+
+		if (it->sheen) {
+			if (json.back() == '}') json += ',';
+			json += R"("KHR_materials_sheen":{)";
+			if (it->sheen->sheenColorFactor != math::nvec3(0)) {
+				json += R"("sheenColorFactor":[)";
+				appendNumber(json, it->sheen->sheenColorFactor[0]);
+				json += ',';
+				appendNumber(json, it->sheen->sheenColorFactor[1]);
+				json += ',';
+				appendNumber(json, it->sheen->sheenColorFactor[2]);
+				json += ']';
+			}
+			if (it->sheen->sheenColorTexture.has_value()) {
+				if (json.back() != '{') json += ',';
+				json += "\"sheenColorTexture\":";
+				writeTextureInfo(json, &it->sheen->sheenColorTexture.value());
+			}
+			if (it->sheen->sheenRoughnessFactor != 0.0f) {
+				if (json.back() != '{') json += ',';
+				json += R"("sheenRoughnessFactor":)";
+				appendNumber(json, it->sheen->sheenRoughnessFactor);
+			}
+			if (it->sheen->sheenRoughnessTexture.has_value()) {
+				if (json.back() != '{') json += ',';
+				json += "\"sheenRoughnessTexture\":";
+				writeTextureInfo(json, &it->sheen->sheenRoughnessTexture.value());
+			}
+			json += '}';
+		}
+
+		if (it->specular) {
+			if (json.back() == '}') json += ',';
+			json += R"("KHR_materials_specular":{)";
+			if (it->specular->specularFactor != 1.0f) {
+				json += R"("specularFactor":)";
+				appendNumber(json, it->specular->specularFactor);
+			}
+			if (it->specular->specularTexture.has_value()) {
+				if (json.back() != '{') json += ',';
+				json += "\"specularTexture\":";
+				writeTextureInfo(json, &it->specular->specularTexture.value());
+			}
+			if (it->specular->specularColorFactor != math::nvec3(1)) {
+				if (json.back() != '{') json += ',';
+				json += R"("specularColorFactor":[)";
+				appendNumber(json, it->specular->specularColorFactor[0]);
+				json += ',';
+				appendNumber(json, it->specular->specularColorFactor[1]);
+				json += ',';
+				appendNumber(json, it->specular->specularColorFactor[2]);
+				json += ']';
+			}
+			if (it->specular->specularColorTexture.has_value()) {
+				if (json.back() != '{') json += ',';
+				json += "\"specularColorTexture\":";
+				writeTextureInfo(json, &it->specular->specularColorTexture.value());
+			}
+			json += '}';
+		}
+
+		if (it->transmission) {
+			if (json.back() == '}') json += ',';
+			json += R"("KHR_materials_transmission":{)";
+			if (it->transmission->transmissionFactor != 0.0f) {
+				json += R"("transmissionFactor":)";
+				appendNumber(json, it->transmission->transmissionFactor);
+			}
+			if (it->transmission->transmissionTexture.has_value()) {
+				if (json.back() != '{') json += ',';
+				json += "\"transmissionTexture\":";
+				writeTextureInfo(json, &it->transmission->transmissionTexture.value());
+			}
+			json += '}';
+		}
+
+		if (it->unlit) {
+			if (json.back() == '}') json += ',';
+			json += R"("KHR_materials_unlit":{})";
+		}
+
+		if (it->volume) {
+			if (json.back() == '}') json += ',';
+			json += R"("KHR_materials_volume":{)";
+			if (it->volume->thicknessFactor != 0.0f) {
+				json += R"("thicknessFactor":)";
+				appendNumber(json, it->volume->thicknessFactor);
+			}
+			if (it->volume->thicknessTexture.has_value()) {
+				if (json.back() != '{') json += ',';
+				json += "\"thicknessTexture\":";
+				writeTextureInfo(json, &it->volume->thicknessTexture.value());
+			}
+			if (it->volume->attenuationDistance != std::numeric_limits<num>::infinity()) {
+				if (json.back() != '{') json += ',';
+				json += R"("attenuationDistance":)";
+				appendNumber(json, it->volume->attenuationDistance);
+			}
+			if (it->volume->attenuationColor != math::nvec3(1)) {
+				if (json.back() != '{') json += ',';
+				json += R"("attenuationColor":[)";
+				appendNumber(json, it->volume->attenuationColor[0]);
+				json += ',';
+				appendNumber(json, it->volume->attenuationColor[1]);
+				json += ',';
+				appendNumber(json, it->volume->attenuationColor[2]);
+				json += ']';
+			}
+			json += '}';
+		}
+
+		if (it->packedNormalMetallicRoughnessTexture.has_value()) {
+			if (json.back() == '}') json += ',';
+			json += R"("MSFT_packing_normalRoughnessMetallic":{"normalRoughnessMetallicTexture":)";
+			writeTextureInfo(json, &it->packedNormalMetallicRoughnessTexture.value());
+			json += '}';
+		}
+
+		if (it->packedOcclusionRoughnessMetallicTextures) {
+			if (json.back() == '}') json += ',';
+			json += R"("MSFT_packing_normalRoughnessMetallic":{)";
+			if (it->packedOcclusionRoughnessMetallicTextures->occlusionRoughnessMetallicTexture.has_value()) {
+				json += R"("occlusionRoughnessMetallicTexture":)";
+				writeTextureInfo(json, &it->packedOcclusionRoughnessMetallicTextures->occlusionRoughnessMetallicTexture.value());
+			}
+			if (it->packedOcclusionRoughnessMetallicTextures->roughnessMetallicOcclusionTexture.has_value()) {
+				json += R"("roughnessMetallicOcclusionTexture":)";
+				writeTextureInfo(json, &it->packedOcclusionRoughnessMetallicTextures->roughnessMetallicOcclusionTexture.value());
+			}
+			if (it->packedOcclusionRoughnessMetallicTextures->normalTexture.has_value()) {
+				json += R"("normalTexture":)";
+				writeTextureInfo(json, &it->packedOcclusionRoughnessMetallicTextures->normalTexture.value());
+			}
+			json += '}';
+		}
+
+		json += '}';
+
+		if (extrasWriteCallback != nullptr) {
+			auto extras = extrasWriteCallback(uabs(std::distance(asset.materials.begin(), it)), fastgltf::Category::Materials, userPointer);
+			if (extras.has_value()) {
+				if (json.back() != '{')
+					json += ',';
+				json += "\"extras\":";
+				json += *extras;
+			}
+		}
+
+		if (!it->name.empty()) {
+			if (json.back() != ',') json += ',';
+			json += R"("name":")";
+			appendEscapedString(json, it->name);
+			json += '"';
+		}
+		json += '}';
+		if (uabs(std::distance(asset.materials.begin(), it)) + 1 <asset.materials.size())
+			json += ',';
+	}
+	json += ']';
+}
+
+void fg::Exporter::writeMeshes(const Asset& asset, std::string& json) {
+	if (asset.meshes.empty())
+		return;
+	if (json.back() == ']' || json.back() == '}')
+		json += ',';
+
+	json += "\"meshes\":[";
+	for (auto it = asset.meshes.begin(); it != asset.meshes.end(); ++it) {
+		json += '{';
+
+        if (!it->primitives.empty()) {
+            json += R"("primitives":[)";
+            auto itp = it->primitives.begin();
+            while (itp != it->primitives.end()) {
+                json += '{';
+
+                {
+                    json += R"("attributes":{)";
+                    for (auto ita = itp->attributes.begin(); ita != itp->attributes.end(); ++ita) {
+                        json += '"';
+                        json += ita->name;
+                        json += "\":";
+                        appendNumber(json, ita->accessorIndex);
+                        if (uabs(std::distance(itp->attributes.begin(), ita)) + 1 <itp->attributes.size())
+                            json += ',';
+                    }
+                    json += '}';
+                }
+
+                if (itp->indicesAccessor.has_value()) {
+                    json += R"(,"indices":)";
+                    appendNumber(json, itp->indicesAccessor.value());
+                }
+
+                if (itp->materialIndex.has_value()) {
+                    json += R"(,"material":)";
+                    appendNumber(json, itp->materialIndex.value());
+                }
+
+                if (itp->type != PrimitiveType::Triangles) {
+                    json += R"(,"mode":)";
+                    appendNumber(json, to_underlying(itp->type));
+                }
+
+				if (!itp->mappings.empty()) {
+					json += R"(,"extensions":{"KHR_materials_variants":{"mappings":[)";
+					// TODO: We should optimise to avoid writing multiple objects for the same material index
+					for (std::size_t i = 0; i < asset.materialVariants.size(); ++i) {
+						if (!itp->mappings[i].has_value())
+							continue;
+						if (json.back() == '}')
+							json += ',';
+						json += "{\"material\":";
+						appendNumber(json, itp->mappings[i].value());
+						json += ",\"variants\":[";
+						appendNumber(json, i);
+						json += "]}";
+					}
+					json += "]}}";
+				}
+
+                json += '}';
+                ++itp;
+                if (uabs(std::distance(it->primitives.begin(), itp)) < it->primitives.size())
+                    json += ',';
+            }
+            json += ']';
+        }
+
+		if (!it->weights.empty()) {
+			if (json.back() != '{')
+				json += ',';
+			json += R"("weights":[)";
+			auto itw = it->weights.begin();
+			while (itw != it->weights.end()) {
+				appendNumber(json, *itw);
+				++itw;
+				if (uabs(std::distance(it->weights.begin(), itw)) < it->weights.size())
+					json += ',';
+			}
+			json += ']';
+		}
+
+		if (extrasWriteCallback != nullptr) {
+			auto extras = extrasWriteCallback(uabs(std::distance(asset.meshes.begin(), it)), fastgltf::Category::Meshes, userPointer);
+			if (extras.has_value()) {
+				if (json.back() != '{')
+					json += ',';
+				json += "\"extras\":";
+				json += *extras;
+			}
+		}
+
+		if (!it->name.empty()) {
+            if (json.back() != '{')
+                json += ',';
+            json += R"("name":")";
+            appendEscapedString(json, it->name);
+            json += '"';
+        }
+		json += '}';
+		if (uabs(std::distance(asset.meshes.begin(), it)) + 1 <asset.meshes.size())
+			json += ',';
+	}
+	json += ']';
+}
+
+void fg::Exporter::writeNodes(const Asset& asset, std::string& json) {
+	if (asset.nodes.empty())
+		return;
+	if (json.back() == ']' || json.back() == '}')
+		json += ',';
+
+	json += "\"nodes\":[";
+	for (auto it = asset.nodes.begin(); it != asset.nodes.end(); ++it) {
+		json += '{';
+
+		if (it->meshIndex.has_value()) {
+			json += R"("mesh":)";
+			appendNumber(json, it->meshIndex.value());
+		}
+		if (it->cameraIndex.has_value()) {
+			if (json.back() != '{')
+				json += ',';
+			json += R"("camera":)";
+			appendNumber(json, it->cameraIndex.value());
+		}
+		if (it->skinIndex.has_value()) {
+			if (json.back() != '{')
+				json += ',';
+			json += R"("skin":)";
+			appendNumber(json, it->skinIndex.value());
+		}
+
+		if (!it->children.empty()) {
+			if (json.back() != '{')
+				json += ',';
+			json += R"("children":[)";
+			auto itc = it->children.begin();
+			while (itc != it->children.end()) {
+				appendNumber(json, *itc);
+				++itc;
+				if (uabs(std::distance(it->children.begin(), itc)) < it->children.size())
+					json += ',';
+			}
+			json += ']';
+		}
+
+		if (!it->weights.empty()) {
+			if (json.back() != '{')
+				json += ',';
+			json += R"("weights":[)";
+			auto itw = it->weights.begin();
+			while (itw != it->weights.end()) {
+				appendNumber(json, *itw);
+				++itw;
+				if (uabs(std::distance(it->weights.begin(), itw)) < it->weights.size())
+					json += ',';
+			}
+			json += ']';
+		}
+
+		visit_exhaustive(visitor {
+			[&](const TRS& trs) {
+				if (trs.rotation != math::fquat(0.f, 0.f, 0.f, 1.f)) {
+					if (json.back() != '{')
+						json += ',';
+					json += R"("rotation":[)";
+					appendNumber(json, trs.rotation[0]);
+					json += ',';
+					appendNumber(json, trs.rotation[1]);
+					json += ',';
+					appendNumber(json, trs.rotation[2]);
+					json += ',';
+					appendNumber(json, trs.rotation[3]);
+					json += "]";
+				}
+
+				if (trs.scale != math::fvec3(1.f)) {
+					if (json.back() != '{')
+						json += ',';
+					json += R"("scale":[)";
+					appendNumber(json, trs.scale[0]);
+					json += ',';
+					appendNumber(json, trs.scale[1]);
+					json += ',';
+					appendNumber(json, trs.scale[2]);
+					json += "]";
+				}
+
+				if (trs.translation != math::fvec3(0.f)) {
+					if (json.back() != '{')
+						json += ',';
+					json += R"("translation":[)";
+					appendNumber(json, trs.translation[0]);
+					json += ',';
+					appendNumber(json, trs.translation[1]);
+					json += ',';
+					appendNumber(json, trs.translation[2]);
+					json += "]";
+				}
+			},
+			[&](const math::fmat4x4& matrix) {
+				if (json.back() != '{')
+					json += ',';
+				json += R"("matrix":[)";
+				for (std::size_t i = 0; i < matrix.columns(); ++i) {
+					for (std::size_t j = 0; j < matrix.rows(); ++j) {
+						appendNumber(json, matrix.col(i)[j]);
+						if (i * matrix.columns() + j + 1 < matrix.columns() * matrix.rows()) {
+							json += ',';
+						}
+					}
+				}
+				json += ']';
+			},
+		}, it->transform);
+
+	if (!it->instancingAttributes.empty() || it->lightIndex.has_value()) {
+			if (json.back() != '{') json += ',';
+			json += R"("extensions":{)";
+			if (!it->instancingAttributes.empty()) {
+				json += R"("EXT_mesh_gpu_instancing":{"attributes":{)";
+				for (auto ait = it->instancingAttributes.begin(); ait != it->instancingAttributes.end(); ++ait) {
+					json += '"';
+					json += ait->name;
+					json += "\":";
+					appendNumber(json, ait->accessorIndex);
+					if (uabs(std::distance(it->instancingAttributes.begin(), ait)) + 1 <
+						it->instancingAttributes.size())
+						json += ',';
+				}
+				json += "}}";
+			}
+			if (it->lightIndex.has_value()) {
 				if (json.back() != '{') json += ',';
-				json += "\"sheenRoughnessTexture\":";
-				writeTextureInfo(json, &it->sheen->sheenRoughnessTexture.value());
+				json += R"("KHR_lights_punctual":{"light":)";
+				appendNumber(json, it->lightIndex.value());
+				json += "}";
+			}
+			json += "}";
+		}
+
+		if (extrasWriteCallback != nullptr) {
+			auto extras = extrasWriteCallback(uabs(std::distance(asset.nodes.begin(), it)), fastgltf::Category::Nodes, userPointer);
+			if (extras.has_value()) {
+				if (json.back() != '{')
+					json += ',';
+				json += "\"extras\":";
+				json += *extras;
+			}
+		}
+
+		if (!it->name.empty()) {
+			if (json.back() != '{')
+				json += ',';
+			json += R"("name":")";
+			appendEscapedString(json, it->name);
+			json += '"';
+		}
+		json += '}';
+		if (uabs(std::distance(asset.nodes.begin(), it)) + 1 <asset.nodes.size())
+			json += ',';
+	}
+	json += ']';
+}
+
+void fg::Exporter::writeSamplers(const Asset& asset, std::string& json) {
+	if (asset.samplers.empty())
+		return;
+	if (json.back() == ']' || json.back() == '}')
+		json += ',';
+
+	json += "\"samplers\":[";
+	for (auto it = asset.samplers.begin(); it != asset.samplers.end(); ++it) {
+		json += '{';
+
+		if (it->magFilter.has_value()) {
+			json += R"("magFilter":)";
+			appendNumber(json, to_underlying(it->magFilter.value()));
+		}
+		if (it->minFilter.has_value()) {
+			if (json.back() != '{') json += ',';
+			json += R"("minFilter":)";
+			appendNumber(json, to_underlying(it->minFilter.value()));
+		}
+		if (it->wrapS != Wrap::Repeat) {
+			if (json.back() != '{') json += ',';
+			json += R"("wrapS":)";
+			appendNumber(json, to_underlying(it->wrapS));
+		}
+		if (it->wrapT != Wrap::Repeat) {
+			if (json.back() != '{') json += ',';
+			json += R"("wrapT":)";
+			appendNumber(json, to_underlying(it->wrapT));
+		}
+
+		if (extrasWriteCallback != nullptr) {
+			auto extras = extrasWriteCallback(uabs(std::distance(asset.samplers.begin(), it)), fastgltf::Category::Samplers, userPointer);
+			if (extras.has_value()) {
+				if (json.back() != '{')
+					json += ',';
+				json += "\"extras\":";
+				json += *extras;
 			}
-			json += '}';
 		}
 
-		if (it->specular) {
-			if (json.back() == '}') json += ',';
-			json += R"("KHR_materials_specular":{)";
-			if (it->specular->specularFactor != 1.0f) {
-				json += R"("specularFactor":)" + to_string_fp(it->specular->specularFactor);
+		if (!it->name.empty()) {
+			if (json.back() != '{') json += ',';
+			json += R"("name":")";
+			appendEscapedString(json, it->name);
+			json += '"';
+		}
+		json += '}';
+		if (uabs(std::distance(asset.samplers.begin(), it)) + 1 <asset.samplers.size())
+			json += ',';
+	}
+	json += ']';
+}
+
+void fg::Exporter::writeScenes(const Asset& asset, std::string& json) {
+	if (asset.scenes.empty())
+		return;
+	if (json.back() == ']' || json.back() == '}')
+		json += ',';
+
+	if (asset.defaultScene.has_value()) {
+		json += "\"scene\":";
+		appendNumber(json, asset.defaultScene.value());
+		json += ',';
+	}
+
+	json += "\"scenes\":[";
+	for (auto it = asset.scenes.begin(); it != asset.scenes.end(); ++it) {
+		json += '{';
+
+		json += R"("nodes":[)";
+		auto itn = it->nodeIndices.begin();
+		while (itn != it->nodeIndices.end()) {
+			appendNumber(json, *itn);
+			++itn;
+			if (uabs(std::distance(it->nodeIndices.begin(), itn)) < it->nodeIndices.size())
+				json += ',';
+		}
+		json += ']';
+
+		if (extrasWriteCallback != nullptr) {
+			auto extras = extrasWriteCallback(uabs(std::distance(asset.scenes.begin(), it)), fastgltf::Category::Scenes, userPointer);
+			if (extras.has_value()) {
+				if (json.back() != '{')
+					json += ',';
+				json += "\"extras\":";
+				json += *extras;
 			}
-			if (it->specular->specularTexture.has_value()) {
-				if (json.back() != '{') json += ',';
-				json += "\"specularTexture\":";
-				writeTextureInfo(json, &it->specular->specularTexture.value());
+		}
+
+		if (!it->name.empty()) {
+			json += R"(,"name":")";
+			appendEscapedString(json, it->name);
+			json += '"';
+		}
+		json += '}';
+		if (uabs(std::distance(asset.scenes.begin(), it)) + 1 <asset.scenes.size())
+			json += ',';
+	}
+	json += ']';
+}
+
+void fg::Exporter::writeSkins(const Asset& asset, std::string& json) {
+	if (asset.skins.empty())
+		return;
+	if (json.back() == ']' || json.back() == '}')
+		json += ',';
+
+	json += "\"skins\":[";
+	for (auto it = asset.skins.begin(); it != asset.skins.end(); ++it) {
+		json += '{';
+
+		if (it->inverseBindMatrices.has_value()) {
+			json += R"("inverseBindMatrices":)";
+			appendNumber(json, it->inverseBindMatrices.value());
+			json += ',';
+		}
+
+		if (it->skeleton.has_value()) {
+			json += R"("skeleton":)";
+			appendNumber(json, it->skeleton.value());
+			json += ',';
+		}
+
+		json += R"("joints":[)";
+		auto itj = it->joints.begin();
+		while (itj != it->joints.end()) {
+			appendNumber(json, *itj);
+			++itj;
+			if (uabs(std::distance(it->joints.begin(), itj)) < it->joints.size())
+				json += ',';
+		}
+		json += ']';
+
+		if (extrasWriteCallback != nullptr) {
+			auto extras = extrasWriteCallback(uabs(std::distance(asset.skins.begin(), it)), fastgltf::Category::Skins, userPointer);
+			if (extras.has_value()) {
+				if (json.back() != '{')
+					json += ',';
+				json += "\"extras\":";
+				json += *extras;
 			}
-			if (it->specular->specularColorFactor != math::nvec3(1)) {
-				if (json.back() != '{') json += ',';
-				json += R"("specularColorFactor":[)" +
-						to_string_fp(it->specular->specularColorFactor[0]) + ',' +
-						to_string_fp(it->specular->specularColorFactor[1]) + ',' +
-						to_string_fp(it->specular->specularColorFactor[2]) + ']';
+		}
+
+		if (!it->name.empty()) {
+			json += R"(,"name":")";
+			appendEscapedString(json, it->name);
+			json += '"';
+		}
+		json += '}';
+		if (uabs(std::distance(asset.skins.begin(), it)) + 1 <asset.skins.size())
+			json += ',';
+	}
+	json += ']';
+}
+
+void fg::Exporter::writeTextures(const Asset& asset, std::string& json) {
+	if (asset.textures.empty())
+		return;
+	if (json.back() == ']' || json.back() == '}')
+		json += ',';
+
+	json += "\"textures\":[";
+	for (auto it = asset.textures.begin(); it != asset.textures.end(); ++it) {
+		json += '{';
+
+		if (it->samplerIndex.has_value()) {
+			json += R"("sampler":)";
+			appendNumber(json, it->samplerIndex.value());
+		}
+
+		if (it->imageIndex.has_value()) {
+			if (json.back() != '{') json += ',';
+			json += R"("source":)";
+			appendNumber(json, it->imageIndex.value());
+		}
+
+		if (it->basisuImageIndex.has_value() || it->ddsImageIndex.has_value() || it->webpImageIndex.has_value()) {
+			if (json.back() != '{') json += ',';
+			json += R"("extensions":{)";
+			if (it->basisuImageIndex.has_value()) {
+				json += R"("KHR_texture_basisu":{"source":)";
+				appendNumber(json, it->basisuImageIndex.value());
+				json += '}';
 			}
-			if (it->specular->specularColorTexture.has_value()) {
-				if (json.back() != '{') json += ',';
-				json += "\"specularColorTexture\":";
-				writeTextureInfo(json, &it->specular->specularColorTexture.value());
+			if (it->ddsImageIndex.has_value()) {
+				if (json.back() == '}') json += ',';
+				json += R"("MSFT_texture_dds":{"source":)";
+				appendNumber(json, it->ddsImageIndex.value());
+				json += '}';
 			}
-			json += '}';
+			if (it->webpImageIndex.has_value()) {
+				if (json.back() == '}') json += ',';
+				json += R"("EXT_texture_webp":{"source":)";
+				appendNumber(json, it->webpImageIndex.value());
+				json += '}';
+			}
+			json += "}";
+		}
+
+		if (extrasWriteCallback != nullptr) {
+			auto extras = extrasWriteCallback(uabs(std::distance(asset.textures.begin(), it)), fastgltf::Category::Textures, userPointer);
+			if (extras.has_value()) {
+				if (json.back() != '{')
+					json += ',';
+				json += "\"extras\":";
+				json += *extras;
+			}
+		}
+
+		if (!it->name.empty()) {
+			json += R"(,"name":")";
+			appendEscapedString(json, it->name);
+			json += '"';
+		}
+		json += '}';
+		if (uabs(std::distance(asset.textures.begin(), it)) + 1 <asset.textures.size())
+			json += ',';
+	}
+	json += ']';
+}
+
+void fg::Exporter::writeExtensions(const fastgltf::Asset& asset, std::string& json) {
+	if (json.back() == ']' || json.back() == '}')
+		json += ',';
+    json += "\"extensions\":{";
+
+    writeLights(asset, json);
+
+	if (!asset.materialVariants.empty()) {
+		if (json.back() != '{')
+			json += ',';
+		json += R"("KHR_materials_variants":{"variants":[)";
+		for (const auto& variant : asset.materialVariants) {
+			if (json.back() == '}')
+				json += ',';
+			json += R"({"name":")";
+			json += variant;
+			json += "\"}";
 		}
+		json += "]}";
+	}
+
+    json += '}';
+}
+
+fs::path fg::Exporter::getBufferFilePath(const Asset& asset, std::size_t index) {
+    const auto& bufferName = getExportedBuffers(asset)[index].name;
+    if (bufferName.empty()) {
+        return bufferFolder / ("buffer" + std::to_string(index) + ".bin");
+    }
+	return bufferFolder / (bufferName + ".bin");
+}
+
+fs::path fg::Exporter::getImageFilePath(const Asset& asset, std::size_t index, MimeType mimeType) {
+    std::string_view extension;
+    switch (mimeType) {
+        case MimeType::JPEG:
+            extension = ".jpeg";
+            break;
+        case MimeType::PNG:
+            extension = ".png";
+            break;
+		case MimeType::KTX2:
+			extension = ".ktx2";
+			break;
+		case MimeType::DDS:
+			extension = ".dds";
+			break;
+		default:
+		case MimeType::None:
+		case MimeType::GltfBuffer:
+		case MimeType::OctetStream:
+			extension = ".bin";
+			break;
+    }
+
+    const auto& imageName = asset.images[index].name;
+	if (imageName.empty()) {
+		return imageFolder / ("image" + std::to_string(index) + std::string(extension));
+	}
+	return imageFolder / (std::string(imageName) + std::string(extension));
+}
+
+namespace fastgltf {
+	/**
+	 * Roughly estimates the size of the minified JSON, so that the output string only needs to
+	 * be reallocated a few times, if at all.
+	 */
+	std::size_t estimateJsonSize(const Asset& asset) {
+		std::size_t size = 256;
+		size += asset.accessors.size() * 128;
+		size += asset.bufferViews.size() * 72;
+		size += asset.buffers.size() * 64;
+		size += asset.images.size() * 64;
+		size += asset.textures.size() * 32;
+		size += asset.samplers.size() * 64;
+		size += asset.materials.size() * 256;
+		size += asset.cameras.size() * 96;
+		size += asset.lights.size() * 96;
+		for (const auto& mesh : asset.meshes) {
+			size += 32 + mesh.primitives.size() * 160;
+		}
+		for (const auto& node : asset.nodes) {
+			size += 64 + node.children.size() * 6;
+		}
+		for (const auto& animation : asset.animations) {
+			size += 32 + animation.channels.size() * 64 + animation.samplers.size() * 48;
+		}
+		for (const auto& skin : asset.skins) {
+			size += 64 + skin.joints.size() * 6;
+		}
+		for (const auto& scene : asset.scenes) {
+			size += 16 + scene.nodeIndices.size() * 6;
+		}
+		return size;
+	}
+} // namespace fastgltf
+
+std::string fg::Exporter::writeJson(const fastgltf::Asset &asset) {
+    // Fairly rudimentary approach of just composing the JSON string using a std::string.
+    std::string outputString;
+    outputString.reserve(estimateJsonSize(asset));
+
+    outputString += "{";
+
+    // Write asset info
+    outputString += "\"asset\":{";
+    if (asset.assetInfo.has_value()) {
+        if (!asset.assetInfo->copyright.empty()) {
+            outputString += R"("copyright":")";
+            appendEscapedString(outputString, asset.assetInfo->copyright);
+            outputString += "\",";
+        }
+        if (!asset.assetInfo->generator.empty()) {
+            outputString += R"("generator":")";
+            appendEscapedString(outputString, asset.assetInfo->generator);
+            outputString += "\",";
+        }
+        outputString += R"("version":")";
+        outputString += asset.assetInfo->gltfVersion;
+        outputString += '"';
+    } else {
+        outputString += R"("generator":"fastgltf",)";
+        outputString += R"("version":"2.0")";
+    }
+    outputString += '}';
 
-		if (it->transmission) {
-			if (json.back() == '}') json += ',';
-			json += R"("KHR_materials_transmission":{)";
-			if (it->transmission->transmissionFactor != 0.0f) {
-				json += R"("transmissionFactor":)" + to_string_fp(it->transmission->transmissionFactor);
-			}
-			if (it->transmission->transmissionTexture.has_value()) {
-				if (json.back() != '{') json += ',';
-				json += "\"transmissionTexture\":";
-				writeTextureInfo(json, &it->transmission->transmissionTexture.value());
-			}
-			json += '}';
+	// Write extension usage info
+	auto writeExtensionList = [&](std::string_view name, const auto& list) {
+		if (list.empty())
+			return;
+		if (outputString.back() != '{') outputString += ',';
+		outputString += '\"';
+		outputString += name;
+		outputString += "\":[";
+		for (auto it = list.begin(); it != list.end(); ++it) {
+			outputString += '\"';
+			outputString += *it;
+			outputString += '\"';
+			if (uabs(std::distance(list.begin(), it)) + 1 < list.size())
+				outputString += ',';
 		}
+		outputString += ']';
+	};
+	if (meshoptEncoding != nullptr) {
+		writeExtensionList("extensionsUsed", meshoptEncoding->extensionsUsed);
+		writeExtensionList("extensionsRequired", meshoptEncoding->extensionsRequired);
+	} else {
+		writeExtensionList("extensionsUsed", asset.extensionsUsed);
+		writeExtensionList("extensionsRequired", asset.extensionsRequired);
+	}
 
-		if (it->unlit) {
-			if (json.back() == '}') json += ',';
-			json += R"("KHR_materials_unlit":{})";
+    writeAccessors(asset, outputString);
+    writeAnimations(asset, outputString);
+    writeBuffers(asset, outputString);
+    writeBufferViews(asset, outputString);
+    writeCameras(asset, outputString);
+    writeImages(asset, outputString);
+    writeMaterials(asset, outputString);
+    writeMeshes(asset, outputString);
+    writeNodes(asset, outputString);
+    writeSamplers(asset, outputString);
+    writeScenes(asset, outputString);
+    writeSkins(asset, outputString);
+    writeTextures(asset, outputString);
+    writeExtensions(asset, outputString);
+
+    outputString += "}";
+
+    if (hasBit(options, ExportOptions::PrettyPrintJson)) {
+        prettyPrintJson(outputString);
+    }
+
+    return outputString;
+}
+
+fg::Expected<fg::ExportResult<std::string>> fg::Exporter::writeGltfJson(const Asset& asset, ExportOptions _options) {
+    bufferPaths.clear();
+    imagePaths.clear();
+    options = _options;
+	exportingBinary = false;
+
+    if (hasBit(options, ExportOptions::ValidateAsset)) {
+        if (const auto validation = validate(asset); validation != Error::None) {
+            return validation;
+        }
+    }
+
+	meshoptEncoding.reset();
+	if (hasBit(options, ExportOptions::MeshoptCompression)) {
+		encodeMeshoptCompression(asset);
+	}
+
+    // Fairly rudimentary approach of just composing the JSON string using a std::string.
+    std::string outputString = writeJson(asset);
+    if (errorCode != Error::None) {
+		meshoptEncoding.reset();
+		return errorCode;
+    }
+
+    ExportResult<std::string> result;
+    result.output = std::move(outputString);
+    result.bufferPaths = std::move(bufferPaths);
+    result.imagePaths = std::move(imagePaths);
+	if (meshoptEncoding != nullptr) {
+		result.buffers = std::move(meshoptEncoding->buffers);
+		meshoptEncoding.reset();
+	}
+    return std::move(result);
+}
+
+namespace fastgltf {
+	/** Collects the output of writeGltfBinary into a vector, which is sized up front using the chunk sizes. */
+	class VectorDataSink : public GltfDataSink {
+	public:
+		std::vector<std::byte> bytes;
+
+		bool write(span<const span<const std::byte>> chunks) override {
+			std::size_t size = bytes.size();
+			for (const auto& chunk : chunks)
+				size += chunk.size();
+			bytes.reserve(size);
+
+			for (const auto& chunk : chunks)
+				bytes.insert(bytes.end(), chunk.begin(), chunk.end());
+			return true;
 		}
+	};
+} // namespace fastgltf
 
-		if (it->volume) {
-			if (json.back() == '}') json += ',';
-			json += R"("KHR_materials_volume":{)";
-			if (it->volume->thicknessFactor != 0.0f) {
-				json += R"("thicknessFactor":)" + to_string_fp(it->volume->thicknessFactor);
-			}
-			if (it->volume->thicknessTexture.has_value()) {
-				if (json.back() != '{') json += ',';
-				json += "\"thicknessTexture\":";
-				writeTextureInfo(json, &it->volume->thicknessTexture.value());
-			}
-			if (it->volume->attenuationDistance != std::numeric_limits<num>::infinity()) {
-				if (json.back() != '{') json += ',';
-				json += R"("attenuationDistance":)" + to_string_fp(it->volume->attenuationDistance);
-			}
-			if (it->volume->attenuationColor != math::nvec3(1)) {
-				if (json.back() != '{') json += ',';
-				json += R"("attenuationColor":[)" +
-						to_string_fp(it->volume->attenuationColor[0]) + ',' +
-						to_string_fp(it->volume->attenuationColor[1]) + ',' +
-						to_string_fp(it->volume->attenuationColor[2]) + ']';
+fg::Expected<fg::ExportResult<std::vector<std::byte>>> fg::Exporter::writeGltfBinary(const Asset& asset, ExportOptions _options) {
+	VectorDataSink sink;
+	auto expected = writeGltfBinary(asset, sink, _options);
+	if (!expected) {
+		return expected.error();
+	}
+
+	ExportResult<std::vector<std::byte>> result;
+	result.output = std::move(sink.bytes);
+	result.bufferPaths = std::move(expected.get().bufferPaths);
+	result.imagePaths = std::move(expected.get().imagePaths);
+	result.buffers = std::move(expected.get().buffers);
+	return std::move(result);
+}
+
+fg::Expected<fg::ExportResult<std::size_t>> fg::Exporter::writeGltfBinary(const Asset& asset, GltfDataSink& sink, ExportOptions _options) {
+    bufferPaths.clear();
+    imagePaths.clear();
+    options = _options;
+	exportingBinary = true;
+
+    options &= (~ExportOptions::PrettyPrintJson);
+
+	meshoptEncoding.reset();
+	if (hasBit(options, ExportOptions::MeshoptCompression)) {
+		encodeMeshoptCompression(asset);
+	}
+
+	const auto& buffers = getExportedBuffers(asset);
+
+    ExportResult<std::size_t> result;
+    auto json = writeJson(asset);
+    if (errorCode != Error::None) {
+		meshoptEncoding.reset();
+		return errorCode;
+    }
+
+    result.bufferPaths = std::move(bufferPaths);
+    result.imagePaths = std::move(imagePaths);
+
+	// TODO: Add ExportOption enumeration for disabling this?
+    const bool withEmbeddedBuffer = !buffers.empty()
+			// We only support writing Vectors and ByteViews as embedded buffers
+			&& (std::holds_alternative<sources::Array>(buffers.front().data) || std::holds_alternative<sources::ByteView>(buffers.front().data) || std::holds_alternative<sources::Vector>(buffers.front().data))
+			&& buffers.front().byteLength < std::numeric_limits<decltype(BinaryGltfChunk::chunkLength)>::max();
+
+    std::size_t binarySize = 0;
+    binarySize += sizeof(BinaryGltfHeader); // glTF header
+    binarySize += sizeof(BinaryGltfChunk) + alignUp(json.size(), 4); // JSON chunk
+    if (withEmbeddedBuffer) {
+        binarySize += sizeof(BinaryGltfChunk) + alignUp(buffers.front().byteLength, 4); // BIN chunk
+    }
+
+	// A GLB is limited to 2^32 bytes since the length field in the file header is a 32-bit integer.
+	if (binarySize >= static_cast<std::size_t>(std::numeric_limits<decltype(BinaryGltfHeader::length)>::max())) {
+		meshoptEncoding.reset();
+		return Error::InvalidGLB;
+	}
+
+	// The chunks are padded to 4 bytes with spaces for JSON, and with zeros for binary data.
+	static constexpr std::array<std::byte, 3> spaces = { std::byte(0x20), std::byte(0x20), std::byte(0x20) };
+	static constexpr std::array<std::byte, 3> zeros = {};
+
+	std::array<span<const std::byte>, 7> chunks;
+	std::size_t chunkCount = 0;
+
+	// Write glTF header
+	BinaryGltfHeader header {};
+	header.magic = binaryGltfHeaderMagic;
+	header.version = 2;
+	header.length = static_cast<std::uint32_t>(binarySize);
+	const auto headerBytes = writeBinaryHeader(header);
+	chunks[chunkCount++] = span<const std::byte>(headerBytes.data(), headerBytes.size());
+
+	// Write JSON chunk
+	BinaryGltfChunk jsonChunk {};
+	jsonChunk.chunkType = binaryGltfJsonChunkMagic;
+	jsonChunk.chunkLength = static_cast<std::uint32_t>(alignUp(json.size(), 4));
+	const auto jsonChunkBytes = writeBinaryChunk(jsonChunk);
+	chunks[chunkCount++] = span<const std::byte>(jsonChunkBytes.data(), jsonChunkBytes.size());
+	chunks[chunkCount++] = span<const std::byte>(reinterpret_cast<const std::byte*>(json.data()), json.size());
+	chunks[chunkCount++] = span<const std::byte>(spaces.data(), alignUp(json.size(), 4) - json.size());
+
+	std::array<std::byte, sizeof(BinaryGltfChunk)> dataChunkBytes {};
+    if (withEmbeddedBuffer) {
+        const auto& buffer = buffers.front();
+
+        // Write BIN chunk
+        BinaryGltfChunk dataChunk {};
+        dataChunk.chunkType = binaryGltfDataChunkMagic;
+        dataChunk.chunkLength = static_cast<std::uint32_t>(alignUp(buffer.byteLength, 4));
+		dataChunkBytes = writeBinaryChunk(dataChunk);
+		chunks[chunkCount++] = span<const std::byte>(dataChunkBytes.data(), dataChunkBytes.size());
+
+		// The buffer is passed to the sink directly, instead of being copied.
+		chunks[chunkCount++] = std::visit(visitor {
+			[](const auto&) {
+				return span<const std::byte>();
+			},
+			[&](const sources::Array& vector) {
+				return span<const std::byte>(vector.bytes.data(), buffer.byteLength);
+			},
+			[&](const sources::Vector& vector) {
+				return span<const std::byte>(vector.bytes.data(), buffer.byteLength);
+			},
+			[&](const sources::ByteView& byteView) {
+				return span<const std::byte>(byteView.bytes.data(), buffer.byteLength);
+			},
+		}, buffer.data);
+		chunks[chunkCount++] = span<const std::byte>(zeros.data(), alignUp(buffer.byteLength, 4) - buffer.byteLength);
+    }
+
+	const bool written = sink.write(span<const span<const std::byte>>(chunks.data(), chunkCount));
+	if (meshoptEncoding != nullptr) {
+		result.buffers = std::move(meshoptEncoding->buffers);
+		meshoptEncoding.reset();
+	}
+	if (!written) {
+		return Error::FailedWritingFiles;
+	}
+
+	result.output = binarySize;
+    return std::move(result);
+}
+
+namespace fastgltf {
+	bool writeFile(const DataSource& dataSource, const fs::path& baseFolder, const fs::path& filePath) {
+		// Get the final normalized path. TODO: Perhaps move these filesystem checks to the parent function?
+		auto finalPath = (baseFolder / filePath).lexically_normal();
+		if (std::error_code ec; !fs::exists(finalPath.parent_path(), ec) || ec) {
+			// If the parent folder of the destination file does not exist, we'll create it.
+			fs::create_directory(finalPath.parent_path(), ec);
+			if (ec) {
+				return false;
 			}
-			json += '}';
 		}
 
-		if (it->packedNormalMetallicRoughnessTexture.has_value()) {
-			if (json.back() == '}') json += ',';
-			json += R"("MSFT_packing_normalRoughnessMetallic":{"normalRoughnessMetallicTexture":)";
-			writeTextureInfo(json, &it->packedNormalMetallicRoughnessTexture.value());
-			json += '}';
-		}
+		return std::visit(visitor {
+			[](auto&) {
+				return false;
+			},
+			[&](const sources::Array& vector) {
+				std::ofstream file(finalPath, std::ios::out | std::ios::binary);
+				if (!file.is_open())
+					return false;
+				file.write(reinterpret_cast<const char *>(vector.bytes.data()),
+						   static_cast<std::streamsize>(vector.bytes.size()));
+				file.close();
+				return file.good();
+			},
+			[&](const sources::Vector& vector) {
+				std::ofstream file(finalPath, std::ios::out | std::ios::binary);
+				if (!file.is_open())
+					return false;
+				file.write(reinterpret_cast<const char *>(vector.bytes.data()),
+						   static_cast<std::streamsize>(vector.bytes.size()));
+				file.close();
+				return file.good();
+			},
+			[&](const sources::ByteView& view) {
+				std::ofstream file(finalPath, std::ios::out | std::ios::binary);
+				if (!file.is_open())
+					return false;
+				file.write(reinterpret_cast<const char *>(view.bytes.data()),
+						   static_cast<std::streamsize>(view.bytes.size()));
+				file.close();
+				return file.good();
+			},
+		}, dataSource);
+	}
 
-		if (it->packedOcclusionRoughnessMetallicTextures) {
-			if (json.back() == '}') json += ',';
-			json += R"("MSFT_packing_normalRoughnessMetallic":{)";
-			if (it->packedOcclusionRoughnessMetallicTextures->occlusionRoughnessMetallicTexture.has_value()) {
-				json += R"("occlusionRoughnessMetallicTexture":)";
-				writeTextureInfo(json, &it->packedOcclusionRoughnessMetallicTextures->occlusionRoughnessMetallicTexture.value());
-			}
-			if (it->packedOcclusionRoughnessMetallicTextures->roughnessMetallicOcclusionTexture.has_value()) {
-				json += R"("roughnessMetallicOcclusionTexture":)";
-				writeTextureInfo(json, &it->packedOcclusionRoughnessMetallicTextures->roughnessMetallicOcclusionTexture.value());
-			}
-			if (it->packedOcclusionRoughnessMetallicTextures->normalTexture.has_value()) {
-				json += R"("normalTexture":)";
-				writeTextureInfo(json, &it->packedOcclusionRoughnessMetallicTextures->normalTexture.value());
+	template<typename T>
+	bool writeFiles(const Asset& asset, ExportResult<T> &result, fs::path baseFolder) {
+		const auto& buffers = result.buffers.empty() ? asset.buffers : result.buffers;
+		for (std::size_t i = 0; i < buffers.size(); ++i) {
+			auto& path = result.bufferPaths[i];
+			if (path.has_value()) {
+				if (!writeFile(buffers[i].data, baseFolder, path.value()))
+					return false;
 			}
-			json += '}';
 		}
 
-		json += '}';
-
-		if (extrasWriteCallback != nullptr) {
-			auto extras = extrasWriteCallback(uabs(std::distance(asset.materials.begin(), it)), fastgltf::Category::Materials, userPointer);
-			if (extras.has_value()) {
-				if (json.back() != '{')
-					json += ',';
-				json += std::string("\"extras\":") + *extras;
+		for (std::size_t i = 0; i < asset.images.size(); ++i) {
+			auto& path = result.imagePaths[i];
+			if (path.has_value()) {
+				if (!writeFile(asset.images[i].data, baseFolder, path.value()))
+					return false;
 			}
 		}
+		return true;
+	}
+} // namespace fastgltf
 
-		if (!it->name.empty()) {
-			if (json.back() != ',') json += ',';
-			json += R"("name":")" + fg::escapeString(it->name) + '"';
+fg::Error fg::FileExporter::writeGltfJson(const Asset& asset, fs::path target, ExportOptions _options) {
+	if (std::error_code ec; !fs::exists(target.parent_path(), ec) || ec) {
+		fs::create_directory(target.parent_path(), ec);
+		if (ec) {
+			return Error::InvalidPath;
 		}
-		json += '}';
-		if (uabs(std::distance(asset.materials.begin(), it)) + 1 <asset.materials.size())
-			json += ',';
 	}
-	json += ']';
-}
 
-void fg::Exporter::writeMeshes(const Asset& asset, std::string& json) {
-	if (asset.meshes.empty())
-		return;
-	if (json.back() == ']' || json.back() == '}')
-		json += ',';
+	auto expected = Exporter::writeGltfJson(asset, _options);
 
-	json += "\"meshes\":[";
-	for (auto it = asset.meshes.begin(); it != asset.meshes.end(); ++it) {
-		json += '{';
+    if (!expected) {
+        return expected.error();
+    }
+    auto& result = expected.get();
 
-        if (!it->primitives.empty()) {
-            json += R"("primitives":[)";
-            auto itp = it->primitives.begin();
-            while (itp != it->primitives.end()) {
-                json += '{';
+    std::ofstream file(target, std::ios::out);
+    if (!file.is_open()) {
+        return fg::Error::InvalidPath;
+    }
 
-                {
-                    json += R"("attributes":{)";
-                    for (auto ita = itp->attributes.begin(); ita != itp->attributes.end(); ++ita) {
-                        json += '"' + std::string(ita->name) + "\":" + std::to_string(ita->accessorIndex);
-                        if (uabs(std::distance(itp->attributes.begin(), ita)) + 1 <itp->attributes.size())
-                            json += ',';
-                    }
-                    json += '}';
-                }
+    file << result.output;
+    file.close();
 
-                if (itp->indicesAccessor.has_value()) {
-                    json += R"(,"indices":)" + std::to_string(itp->indicesAccessor.value());
-                }
+	if (!writeFiles(asset, result, target.parent_path())) {
+		return Error::FailedWritingFiles;
+	}
+    return Error::None;
+}
 
-                if (itp->materialIndex.has_value()) {
-                    json += R"(,"material":)" + std::to_string(itp->materialIndex.value());
-                }
+fg::Error fg::FileExporter::writeGltfBinary(const Asset& asset, fs::path target, ExportOptions _options) {
+	if (std::error_code ec; !fs::exists(target.parent_path(), ec) || ec) {
+		fs::create_directory(target.parent_path(), ec);
+		if (ec) {
+			return Error::InvalidPath;
+		}
+	}
 
-                if (itp->type != PrimitiveType::Triangles) {
-                    json += R"(,"mode":)" + std::to_string(to_underlying(itp->type));
-                }
+	// Stream the GLB directly into a file, so that the embedded buffer is never copied. The file is written next to
+	// the target and only replaces it once the export succeeded, so that a failed export keeps the previous file.
+	auto temporaryPath = target;
+	temporaryPath += ".tmp";
+	auto file = std::make_unique<GltfFileSink>(temporaryPath);
+	if (!file->isOpen()) {
+		return fg::Error::InvalidPath;
+	}
 
-				if (!itp->mappings.empty()) {
-					json += R"(,"extensions":{"KHR_materials_variants":{"mappings":[)";
-					// TODO: We should optimise to avoid writing multiple objects for the same material index
-					for (std::size_t i = 0; i < asset.materialVariants.size(); ++i) {
-						if (!itp->mappings[i].has_value())
-							continue;
-						if (json.back() == '}')
-							json += ',';
-						json += "{\"material\":" + std::to_string(itp->mappings[i].value()) + ",\"variants\":[" + std::to_string(i) + "]}";
-					}
-					json += "]}}";
-				}
+    auto expected = Exporter::writeGltfBinary(asset, *file, _options);
+	file.reset();
 
-                json += '}';
-                ++itp;
-                if (uabs(std::distance(it->primitives.begin(), itp)) < it->primitives.size())
-                    json += ',';
-            }
-            json += ']';
-        }
+	std::error_code ec;
+    if (!expected) {
+		fs::remove(temporaryPath, ec);
+        return expected.error();
+    }
+	fs::rename(temporaryPath, target, ec);
+	if (ec) {
+		fs::remove(temporaryPath, ec);
+		return Error::InvalidPath;
+	}
+    auto& result = expected.get();
 
-		if (!it->weights.empty()) {
-			if (json.back() != '{')
-				json += ',';
-			json += R"("weights":[)";
-			auto itw = it->weights.begin();
-			while (itw != it->weights.end()) {
-				json += to_string_fp(*itw);
-				++itw;
-				if (uabs(std::distance(it->weights.begin(), itw)) < it->weights.size())
-					json += ',';
-			}
-			json += ']';
-		}
+	if (!writeFiles(asset, result, target.parent_path())) {
+		return Error::FailedWritingFiles;
+	}
+    return Error::None;
+}
+#pragma endregion
 
-		if (extrasWriteCallback != nullptr) {
-			auto extras = extrasWriteCallback(uabs(std::distance(asset.meshes.begin(), it)), fastgltf::Category::Meshes, userPointer);
-			if (extras.has_value()) {
-				if (json.back() != '{')
-					json += ',';
-				json += std::string("\"extras\":") + *extras;
-			}
-		}
+#pragma region AssetCache
+namespace fastgltf {
+	// The primes used by XXH64, which the hash used by hashGltfData follows.
+	constexpr std::uint64_t hashPrime1 = 0x9E3779B185EBCA87ULL;
+	constexpr std::uint64_t hashPrime2 = 0xC2B2AE3D27D4EB4FULL;
+	constexpr std::uint64_t hashPrime3 = 0x165667B19E3779F9ULL;
+	constexpr std::uint64_t hashPrime4 = 0x85EBCA77C2B2AE63ULL;
+	constexpr std::uint64_t hashPrime5 = 0x27D4EB2F165667C5ULL;
+
+	[[nodiscard]] constexpr std::uint64_t rotateLeft(std::uint64_t value, unsigned shift) noexcept {
+		return (value << shift) | (value >> (64 - shift));
+	}
 
-		if (!it->name.empty()) {
-            if (json.back() != '{')
-                json += ',';
-            json += R"("name":")" + fg::escapeString(it->name) + '"';
-        }
-		json += '}';
-		if (uabs(std::distance(asset.meshes.begin(), it)) + 1 <asset.meshes.size())
-			json += ',';
+	[[nodiscard]] constexpr std::uint64_t hashRound(std::uint64_t accumulator, std::uint64_t input) noexcept {
+		accumulator += input * hashPrime2;
+		return rotateLeft(accumulator, 31) * hashPrime1;
 	}
-	json += ']';
-}
 
-void fg::Exporter::writeNodes(const Asset& asset, std::string& json) {
-	if (asset.nodes.empty())
-		return;
-	if (json.back() == ']' || json.back() == '}')
-		json += ',';
+	[[nodiscard]] constexpr std::uint64_t hashMergeRound(std::uint64_t accumulator, std::uint64_t value) noexcept {
+		accumulator ^= hashRound(0, value);
+		return accumulator * hashPrime1 + hashPrime4;
+	}
 
-	json += "\"nodes\":[";
-	for (auto it = asset.nodes.begin(); it != asset.nodes.end(); ++it) {
-		json += '{';
+	template <typename T>
+	[[nodiscard]] T readUnaligned(const std::byte* bytes) noexcept {
+		T value;
+		std::memcpy(&value, bytes, sizeof(T));
+		return value;
+	}
 
-		if (it->meshIndex.has_value()) {
-			json += R"("mesh":)" + std::to_string(it->meshIndex.value());
-		}
-		if (it->cameraIndex.has_value()) {
-			if (json.back() != '{')
-				json += ',';
-			json += R"("camera":)" + std::to_string(it->cameraIndex.value());
-		}
-		if (it->skinIndex.has_value()) {
-			if (json.back() != '{')
-				json += ',';
-			json += R"("skin":)" + std::to_string(it->skinIndex.value());
-		}
+	[[nodiscard]] std::uint64_t hashBytes(const std::byte* bytes, std::size_t length, std::uint64_t seed) noexcept {
+		const auto* end = bytes + length;
 
-		if (!it->children.empty()) {
-			if (json.back() != '{')
-				json += ',';
-			json += R"("children":[)";
-			auto itc = it->children.begin();
-			while (itc != it->children.end()) {
-				json += std::to_string(*itc);
-				++itc;
-				if (uabs(std::distance(it->children.begin(), itc)) < it->children.size())
-					json += ',';
+		std::uint64_t hash;
+		if (length >= 32) {
+			std::array<std::uint64_t, 4> lanes = { seed + hashPrime1 + hashPrime2, seed + hashPrime2, seed, seed - hashPrime1 };
+			for (; bytes + 32 <= end; bytes += 32) {
+				for (std::size_t i = 0; i < lanes.size(); ++i) {
+					lanes[i] = hashRound(lanes[i], readUnaligned<std::uint64_t>(bytes + i * sizeof(std::uint64_t)));
+				}
 			}
-			json += ']';
+			hash = rotateLeft(lanes[0], 1) + rotateLeft(lanes[1], 7) + rotateLeft(lanes[2], 12) + rotateLeft(lanes[3], 18);
+			for (const auto lane : lanes) {
+				hash = hashMergeRound(hash, lane);
+			}
+		} else {
+			hash = seed + hashPrime5;
 		}
 
-		if (!it->weights.empty()) {
-			if (json.back() != '{')
-				json += ',';
-			json += R"("weights":[)";
-			auto itw = it->weights.begin();
-			while (itw != it->weights.end()) {
-				json += to_string_fp(*itw);
-				++itw;
-				if (uabs(std::distance(it->weights.begin(), itw)) < it->weights.size())
-					json += ',';
-			}
-			json += ']';
+		hash += static_cast<std::uint64_t>(length);
+		for (; bytes + 8 <= end; bytes += 8) {
+			hash ^= hashRound(0, readUnaligned<std::uint64_t>(bytes));
+			hash = rotateLeft(hash, 27) * hashPrime1 + hashPrime4;
+		}
+		if (bytes + 4 <= end) {
+			hash ^= static_cast<std::uint64_t>(readUnaligned<std::uint32_t>(bytes)) * hashPrime1;
+			hash = rotateLeft(hash, 23) * hashPrime2 + hashPrime3;
+			bytes += 4;
+		}
+		for (; bytes < end; ++bytes) {
+			hash ^= static_cast<std::uint64_t>(*bytes) * hashPrime5;
+			hash = rotateLeft(hash, 11) * hashPrime1;
 		}
 
-		visit_exhaustive(visitor {
-			[&](const TRS& trs) {
-				if (trs.rotation != math::fquat(0.f, 0.f, 0.f, 1.f)) {
-					if (json.back() != '{')
-						json += ',';
-					json += R"("rotation":[)";
-					json += to_string_fp(trs.rotation[0]) + ',' + to_string_fp(trs.rotation[1]) + ',' + to_string_fp(trs.rotation[2]) + ',' + to_string_fp(trs.rotation[3]);
-					json += "]";
-				}
+		hash ^= hash >> 33;
+		hash *= hashPrime2;
+		hash ^= hash >> 29;
+		hash *= hashPrime3;
+		hash ^= hash >> 32;
+		return hash;
+	}
 
-				if (trs.scale != math::fvec3(1.f)) {
-					if (json.back() != '{')
-						json += ',';
-					json += R"("scale":[)";
-					json += to_string_fp(trs.scale[0]) + ',' + to_string_fp(trs.scale[1]) + ',' + to_string_fp(trs.scale[2]);
-					json += "]";
-				}
+	// "FGAC" in little endian. As everything is stored in the native byte order, a cache written on a
+	// machine with a different byte order will not match the magic.
+	constexpr std::uint32_t assetCacheMagic = 0x43414746;
+
+	struct AssetCacheHeader {
+		std::uint32_t magic;
+		std::uint32_t version;
+		std::uint32_t configuration;
+		std::uint32_t reserved;
+		std::uint64_t sourceHash;
+		std::uint64_t structureSize;
+		std::uint64_t dataOffset;
+		std::uint64_t dataSize;
+	};
+	static_assert(sizeof(AssetCacheHeader) == 48 && std::is_trivially_copyable_v<AssetCacheHeader>);
 
-				if (trs.translation != math::fvec3(0.f)) {
-					if (json.back() != '{')
-						json += ',';
-					json += R"("translation":[)";
-					json += to_string_fp(trs.translation[0]) + ',' + to_string_fp(trs.translation[1]) + ',' + to_string_fp(trs.translation[2]);
-					json += "]";
-				}
-			},
-			[&](const math::fmat4x4& matrix) {
-				if (json.back() != '{')
-					json += ',';
-				json += R"("matrix":[)";
-				for (std::size_t i = 0; i < matrix.columns(); ++i) {
-					for (std::size_t j = 0; j < matrix.rows(); ++j) {
-						json += to_string_fp(matrix.col(i)[j]);
-						if (i * matrix.columns() + j + 1 < matrix.columns() * matrix.rows()) {
-							json += ',';
-						}
-					}
-				}
-				json += ']';
-			},
-		}, it->transform);
+	// All buffer and image data is aligned to this within the cache, and the data section itself too.
+	constexpr std::size_t assetCacheDataAlignment = 16;
 
-	if (!it->instancingAttributes.empty() || it->lightIndex.has_value()) {
-			if (json.back() != '{') json += ',';
-			json += R"("extensions":{)";
-			if (!it->instancingAttributes.empty()) {
-				json += R"("EXT_mesh_gpu_instancing":{"attributes":{)";
-				for (auto ait = it->instancingAttributes.begin(); ait != it->instancingAttributes.end(); ++ait) {
-					json += '"' + std::string(ait->name) + "\":" + std::to_string(ait->accessorIndex);
-					if (uabs(std::distance(it->instancingAttributes.begin(), ait)) + 1 <
-						it->instancingAttributes.size())
-						json += ',';
-				}
-				json += "}}";
-			}
-			if (it->lightIndex.has_value()) {
-				if (json.back() != '{') json += ',';
-				json += R"("KHR_lights_punctual":{"light":)" + std::to_string(it->lightIndex.value()) + "}";
-			}
-			json += "}";
+	/**
+	 * Describes the properties of this build which affect the layout of the cache, as all values
+	 * are written with their native sizes.
+	 */
+	[[nodiscard]] constexpr std::uint32_t getAssetCacheConfiguration() noexcept {
+		std::uint32_t configuration = static_cast<std::uint32_t>(sizeof(std::size_t));
+		configuration |= static_cast<std::uint32_t>(sizeof(num)) << 8;
+#if FASTGLTF_ENABLE_DEPRECATED_EXT
+		configuration |= 1U << 16;
+#endif
+		return configuration;
+	}
+
+	// The type of each DataSource in the cache, which is independent of the order of the variant.
+	enum class CachedDataSource : std::uint8_t {
+		None = 0,
+		BufferView = 1,
+		URI = 2,
+		Bytes = 3,
+		CustomBuffer = 4,
+		Fallback = 5,
+	};
+
+	/**
+	 * Serializes the asset into a flat stream of values, and collects the buffer and image data
+	 * separately, which is stored in the data section and only referenced by offset.
+	 */
+	class AssetCacheWriter {
+	public:
+		std::vector<std::byte> structure;
+		std::vector<std::pair<std::size_t, span<const std::byte>>> blobs;
+		std::size_t dataSize = 0;
+
+		template <typename T>
+		void writeValue(const T& value) {
+			static_assert(std::is_trivially_copyable_v<T>);
+			const auto* bytes = reinterpret_cast<const std::byte*>(&value);
+			structure.insert(structure.end(), bytes, bytes + sizeof(T));
 		}
 
-		if (extrasWriteCallback != nullptr) {
-			auto extras = extrasWriteCallback(uabs(std::distance(asset.nodes.begin(), it)), fastgltf::Category::Nodes, userPointer);
-			if (extras.has_value()) {
-				if (json.back() != '{')
-					json += ',';
-				json += std::string("\"extras\":") + *extras;
-			}
+		void writeCount(std::size_t count) {
+			writeValue(static_cast<std::uint64_t>(count));
 		}
 
-		if (!it->name.empty()) {
-			if (json.back() != '{')
-				json += ',';
-			json += R"("name":")" + fg::escapeString(it->name) + '"';
+		void writeString(std::string_view string) {
+			writeCount(string.size());
+			const auto* bytes = reinterpret_cast<const std::byte*>(string.data());
+			structure.insert(structure.end(), bytes, bytes + string.size());
 		}
-		json += '}';
-		if (uabs(std::distance(asset.nodes.begin(), it)) + 1 <asset.nodes.size())
-			json += ',';
-	}
-	json += ']';
-}
 
-void fg::Exporter::writeSamplers(const Asset& asset, std::string& json) {
-	if (asset.samplers.empty())
-		return;
-	if (json.back() == ']' || json.back() == '}')
-		json += ',';
+		void writeBytes(span<const std::byte> bytes) {
+			dataSize = alignUp(dataSize, static_cast<std::int64_t>(assetCacheDataAlignment));
+			writeCount(dataSize);
+			writeCount(bytes.size());
+			blobs.emplace_back(dataSize, bytes);
+			dataSize += bytes.size();
+		}
+
+		template <typename T>
+		void write(const T& value) {
+			writeValue(value);
+		}
 
-	json += "\"samplers\":[";
-	for (auto it = asset.samplers.begin(); it != asset.samplers.end(); ++it) {
-		json += '{';
+		void write(std::size_t value) {
+			writeCount(value);
+		}
 
-		if (it->magFilter.has_value()) {
-			json += R"("magFilter":)" + std::to_string(to_underlying(it->magFilter.value()));
+		template <typename T>
+		void write(const std::optional<T>& optional) {
+			writeValue(optional.has_value());
+			if (optional.has_value())
+				write(*optional);
 		}
-		if (it->minFilter.has_value()) {
-			if (json.back() != '{') json += ',';
-			json += R"("minFilter":)" + std::to_string(to_underlying(it->minFilter.value()));
+
+		template <typename T>
+		void write(const OptionalWithFlagValue<T>& optional) {
+			writeValue(optional.has_value());
+			if (optional.has_value())
+				write(*optional);
 		}
-		if (it->wrapS != Wrap::Repeat) {
-			if (json.back() != '{') json += ',';
-			json += R"("wrapS":)" + std::to_string(to_underlying(it->wrapS));
+
+		template <typename T>
+		void write(const std::unique_ptr<T>& pointer) {
+			writeValue(pointer != nullptr);
+			if (pointer != nullptr)
+				write(*pointer);
 		}
-		if (it->wrapT != Wrap::Repeat) {
-			if (json.back() != '{') json += ',';
-			json += R"("wrapT":)" + std::to_string(to_underlying(it->wrapT));
+
+		template <typename Vector>
+		void writeVector(const Vector& vector) {
+			writeCount(vector.size());
+			for (const auto& element : vector)
+				write(element);
 		}
 
-		if (extrasWriteCallback != nullptr) {
-			auto extras = extrasWriteCallback(uabs(std::distance(asset.samplers.begin(), it)), fastgltf::Category::Samplers, userPointer);
-			if (extras.has_value()) {
-				if (json.back() != '{')
-					json += ',';
-				json += std::string("\"extras\":") + *extras;
+		void write(const Attribute& attribute) {
+			writeString(attribute.name);
+			writeCount(attribute.accessorIndex);
+		}
+
+		void write(const AccessorBoundsArray& bounds) {
+			writeValue(static_cast<std::uint8_t>(bounds.type()));
+			writeCount(bounds.size());
+			for (std::size_t i = 0; i < bounds.size(); ++i) {
+				if (bounds.isType<std::int64_t>()) {
+					writeValue(bounds.get<std::int64_t>(i));
+				} else {
+					writeValue(bounds.get<double>(i));
+				}
 			}
 		}
 
-		if (!it->name.empty()) {
-			if (json.back() != '{') json += ',';
-			json += R"("name":")" + fg::escapeString(it->name) + '"';
+		void write(const SparseAccessor& sparse) {
+			writeCount(sparse.count);
+			writeCount(sparse.indicesBufferView);
+			writeCount(sparse.indicesByteOffset);
+			writeCount(sparse.valuesBufferView);
+			writeCount(sparse.valuesByteOffset);
+			writeValue(sparse.indexComponentType);
 		}
-		json += '}';
-		if (uabs(std::distance(asset.samplers.begin(), it)) + 1 <asset.samplers.size())
-			json += ',';
-	}
-	json += ']';
-}
 
-void fg::Exporter::writeScenes(const Asset& asset, std::string& json) {
-	if (asset.scenes.empty())
-		return;
-	if (json.back() == ']' || json.back() == '}')
-		json += ',';
+		void write(const CompressedBufferView& compression) {
+			writeCount(compression.bufferIndex);
+			writeCount(compression.byteOffset);
+			writeCount(compression.byteLength);
+			writeCount(compression.count);
+			writeValue(compression.mode);
+			writeValue(compression.filter);
+			writeCount(compression.byteStride);
+		}
 
-	if (asset.defaultScene.has_value()) {
-		json += "\"scene\":" + std::to_string(asset.defaultScene.value()) + ',';
-	}
+		void write(const TextureTransform& transform) {
+			writeValue(transform.rotation);
+			writeValue(transform.uvOffset);
+			writeValue(transform.uvScale);
+			write(transform.texCoordIndex);
+		}
 
-	json += "\"scenes\":[";
-	for (auto it = asset.scenes.begin(); it != asset.scenes.end(); ++it) {
-		json += '{';
+		void write(const TextureInfo& info) {
+			writeCount(info.textureIndex);
+			writeCount(info.texCoordIndex);
+			write(info.transform);
+		}
 
-		json += R"("nodes":[)";
-		auto itn = it->nodeIndices.begin();
-		while (itn != it->nodeIndices.end()) {
-			json += std::to_string(*itn);
-			++itn;
-			if (uabs(std::distance(it->nodeIndices.begin(), itn)) < it->nodeIndices.size())
-				json += ',';
+		void write(const NormalTextureInfo& info) {
+			write(static_cast<const TextureInfo&>(info));
+			writeValue(info.scale);
 		}
-		json += ']';
 
-		if (extrasWriteCallback != nullptr) {
-			auto extras = extrasWriteCallback(uabs(std::distance(asset.scenes.begin(), it)), fastgltf::Category::Scenes, userPointer);
-			if (extras.has_value()) {
-				if (json.back() != '{')
-					json += ',';
-				json += std::string("\"extras\":") + *extras;
-			}
+		void write(const OcclusionTextureInfo& info) {
+			write(static_cast<const TextureInfo&>(info));
+			writeValue(info.strength);
 		}
 
-		if (!it->name.empty())
-			json += R"(,"name":")" + fg::escapeString(it->name) + '"';
-		json += '}';
-		if (uabs(std::distance(asset.scenes.begin(), it)) + 1 <asset.scenes.size())
-			json += ',';
-	}
-	json += ']';
-}
+		void write(const MaterialAnisotropy& anisotropy) {
+			writeValue(anisotropy.anisotropyStrength);
+			writeValue(anisotropy.anisotropyRotation);
+			write(anisotropy.anisotropyTexture);
+		}
 
-void fg::Exporter::writeSkins(const Asset& asset, std::string& json) {
-	if (asset.skins.empty())
-		return;
-	if (json.back() == ']' || json.back() == '}')
-		json += ',';
+		void write(const MaterialClearcoat& clearcoat) {
+			writeValue(clearcoat.clearcoatFactor);
+			write(clearcoat.clearcoatTexture);
+			writeValue(clearcoat.clearcoatRoughnessFactor);
+			write(clearcoat.clearcoatRoughnessTexture);
+			write(clearcoat.clearcoatNormalTexture);
+		}
 
-	json += "\"skins\":[";
-	for (auto it = asset.skins.begin(); it != asset.skins.end(); ++it) {
-		json += '{';
+		void write(const MaterialIridescence& iridescence) {
+			writeValue(iridescence.iridescenceFactor);
+			write(iridescence.iridescenceTexture);
+			writeValue(iridescence.iridescenceIor);
+			writeValue(iridescence.iridescenceThicknessMinimum);
+			writeValue(iridescence.iridescenceThicknessMaximum);
+			write(iridescence.iridescenceThicknessTexture);
+		}
 
-		if (it->inverseBindMatrices.has_value())
-			json += R"("inverseBindMatrices":)" + std::to_string(it->inverseBindMatrices.value()) + ',';
+		void write(const MaterialSheen& sheen) {
+			writeValue(sheen.sheenColorFactor);
+			write(sheen.sheenColorTexture);
+			writeValue(sheen.sheenRoughnessFactor);
+			write(sheen.sheenRoughnessTexture);
+		}
 
-		if (it->skeleton.has_value())
-			json += R"("skeleton":)" + std::to_string(it->skeleton.value()) + ',';
+		void write(const MaterialSpecular& specular) {
+			writeValue(specular.specularFactor);
+			write(specular.specularTexture);
+			writeValue(specular.specularColorFactor);
+			write(specular.specularColorTexture);
+		}
 
-		json += R"("joints":[)";
-		auto itj = it->joints.begin();
-		while (itj != it->joints.end()) {
-			json += std::to_string(*itj);
-			++itj;
-			if (uabs(std::distance(it->joints.begin(), itj)) < it->joints.size())
-				json += ',';
+#if FASTGLTF_ENABLE_DEPRECATED_EXT
+		void write(const MaterialSpecularGlossiness& specularGlossiness) {
+			writeValue(specularGlossiness.diffuseFactor);
+			write(specularGlossiness.diffuseTexture);
+			writeValue(specularGlossiness.specularFactor);
+			writeValue(specularGlossiness.glossinessFactor);
+			write(specularGlossiness.specularGlossinessTexture);
 		}
-		json += ']';
+#endif
 
-		if (extrasWriteCallback != nullptr) {
-			auto extras = extrasWriteCallback(uabs(std::distance(asset.skins.begin(), it)), fastgltf::Category::Skins, userPointer);
-			if (extras.has_value()) {
-				if (json.back() != '{')
-					json += ',';
-				json += std::string("\"extras\":") + *extras;
-			}
+		void write(const MaterialTransmission& transmission) {
+			writeValue(transmission.transmissionFactor);
+			write(transmission.transmissionTexture);
+		}
+
+		void write(const MaterialDiffuseTransmission& diffuseTransmission) {
+			writeValue(diffuseTransmission.diffuseTransmissionFactor);
+			writeValue(diffuseTransmission.diffuseTransmissionColorFactor);
+			write(diffuseTransmission.diffuseTransmissionTexture);
+			write(diffuseTransmission.diffuseTransmissionColorTexture);
+		}
+
+		void write(const MaterialVolume& volume) {
+			writeValue(volume.thicknessFactor);
+			write(volume.thicknessTexture);
+			writeValue(volume.attenuationDistance);
+			writeValue(volume.attenuationColor);
+		}
+
+		void write(const MaterialPackedTextures& packedTextures) {
+			write(packedTextures.occlusionRoughnessMetallicTexture);
+			write(packedTextures.roughnessMetallicOcclusionTexture);
+			write(packedTextures.normalTexture);
+		}
+
+		void write(const DracoCompressedPrimitive& draco) {
+			writeCount(draco.bufferView);
+			writeVector(draco.attributes);
+		}
+
+		void write(const DataSource& source) {
+			std::visit(visitor {
+				[&](const std::monostate&) {
+					writeValue(CachedDataSource::None);
+				},
+				[&](const sources::BufferView& view) {
+					writeValue(CachedDataSource::BufferView);
+					writeCount(view.bufferViewIndex);
+					writeValue(view.mimeType);
+				},
+				[&](const sources::URI& uri) {
+					writeValue(CachedDataSource::URI);
+					writeCount(uri.fileByteOffset);
+					writeString(uri.uri.string());
+					writeValue(uri.mimeType);
+				},
+				[&](const sources::Array& array) {
+					writeValue(CachedDataSource::Bytes);
+					writeBytes(span<const std::byte>(array.bytes.data(), array.bytes.size()));
+					writeValue(array.mimeType);
+				},
+				[&](const sources::Vector& vector) {
+					writeValue(CachedDataSource::Bytes);
+					writeBytes(span<const std::byte>(vector.bytes.data(), vector.bytes.size()));
+					writeValue(vector.mimeType);
+				},
+				[&](const sources::ByteView& byteView) {
+					writeValue(CachedDataSource::Bytes);
+					writeBytes(byteView.bytes);
+					writeValue(byteView.mimeType);
+				},
+				[&](const sources::CustomBuffer& customBuffer) {
+					writeValue(CachedDataSource::CustomBuffer);
+					writeValue(customBuffer.id);
+					writeValue(customBuffer.mimeType);
+				},
+				[&](const sources::Fallback&) {
+					writeValue(CachedDataSource::Fallback);
+				},
+			}, source);
+		}
+
+		void write(const Accessor& accessor) {
+			writeCount(accessor.byteOffset);
+			writeCount(accessor.count);
+			writeValue(accessor.type);
+			writeValue(accessor.componentType);
+			writeValue(accessor.normalized);
+			write(accessor.max);
+			write(accessor.min);
+			write(accessor.bufferViewIndex);
+			write(accessor.sparse);
+			writeString(accessor.name);
+		}
+
+		void write(const AnimationChannel& channel) {
+			writeCount(channel.samplerIndex);
+			write(channel.nodeIndex);
+			writeValue(channel.path);
+		}
+
+		void write(const AnimationSampler& sampler) {
+			writeCount(sampler.inputAccessor);
+			writeCount(sampler.outputAccessor);
+			writeValue(sampler.interpolation);
+		}
+
+		void write(const Animation& animation) {
+			writeVector(animation.channels);
+			writeVector(animation.samplers);
+			writeString(animation.name);
+		}
+
+		void write(const Buffer& buffer) {
+			writeCount(buffer.byteLength);
+			write(buffer.data);
+			writeString(buffer.name);
+		}
+
+		void write(const BufferView& bufferView) {
+			writeCount(bufferView.bufferIndex);
+			writeCount(bufferView.byteOffset);
+			writeCount(bufferView.byteLength);
+			write(bufferView.byteStride);
+			write(bufferView.target);
+			write(bufferView.meshoptCompression);
+			writeString(bufferView.name);
+		}
+
+		void write(const Camera& camera) {
+			writeValue(static_cast<std::uint8_t>(camera.camera.index()));
+			std::visit(visitor {
+				[&](const Camera::Perspective& perspective) {
+					write(perspective.aspectRatio);
+					writeValue(perspective.yfov);
+					write(perspective.zfar);
+					writeValue(perspective.znear);
+				},
+				[&](const Camera::Orthographic& orthographic) {
+					writeValue(orthographic.xmag);
+					writeValue(orthographic.ymag);
+					writeValue(orthographic.zfar);
+					writeValue(orthographic.znear);
+				},
+			}, camera.camera);
+			writeString(camera.name);
+		}
+
+		void write(const Image& image) {
+			write(image.data);
+			writeString(image.name);
+		}
+
+		void write(const Light& light) {
+			writeValue(light.type);
+			writeValue(light.color);
+			writeValue(light.intensity);
+			write(light.range);
+			write(light.innerConeAngle);
+			write(light.outerConeAngle);
+			writeString(light.name);
+		}
+
+		void write(const Material& material) {
+			writeValue(material.pbrData.baseColorFactor);
+			writeValue(material.pbrData.metallicFactor);
+			writeValue(material.pbrData.roughnessFactor);
+			write(material.pbrData.baseColorTexture);
+			write(material.pbrData.metallicRoughnessTexture);
+			write(material.normalTexture);
+			write(material.occlusionTexture);
+			write(material.emissiveTexture);
+			writeValue(material.emissiveFactor);
+			writeValue(material.alphaMode);
+			writeValue(material.doubleSided);
+			writeValue(material.unlit);
+			writeValue(material.alphaCutoff);
+			writeValue(material.emissiveStrength);
+			writeValue(material.ior);
+			writeValue(material.dispersion);
+			write(material.anisotropy);
+			write(material.clearcoat);
+			write(material.iridescence);
+			write(material.sheen);
+			write(material.specular);
+#if FASTGLTF_ENABLE_DEPRECATED_EXT
+			write(material.specularGlossiness);
+#endif
+			write(material.transmission);
+			write(material.diffuseTransmission);
+			write(material.volume);
+			write(material.packedNormalMetallicRoughnessTexture);
+			write(material.packedOcclusionRoughnessMetallicTextures);
+			writeString(material.name);
+		}
+
+		void write(const Primitive& primitive) {
+			writeVector(primitive.attributes);
+			writeValue(primitive.type);
+			writeCount(primitive.targets.size());
+			for (const auto& target : primitive.targets)
+				writeVector(target);
+			write(primitive.indicesAccessor);
+			write(primitive.materialIndex);
+			writeVector(primitive.mappings);
+			write(primitive.dracoCompression);
+		}
+
+		void write(const Mesh& mesh) {
+			writeVector(mesh.primitives);
+			writeVector(mesh.weights);
+			writeString(mesh.name);
+		}
+
+		void write(const Node& node) {
+			write(node.meshIndex);
+			write(node.skinIndex);
+			write(node.cameraIndex);
+			write(node.lightIndex);
+			writeVector(node.children);
+			writeVector(node.weights);
+			writeValue(static_cast<std::uint8_t>(node.transform.index()));
+			std::visit(visitor {
+				[&](const TRS& trs) {
+					writeValue(trs.translation);
+					writeValue(trs.rotation);
+					writeValue(trs.scale);
+				},
+				[&](const math::fmat4x4& matrix) {
+					writeValue(matrix);
+				},
+			}, node.transform);
+			writeVector(node.instancingAttributes);
+			writeString(node.name);
+		}
+
+		void write(const Sampler& sampler) {
+			write(sampler.magFilter);
+			write(sampler.minFilter);
+			writeValue(sampler.wrapS);
+			writeValue(sampler.wrapT);
+			writeString(sampler.name);
+		}
+
+		void write(const Scene& scene) {
+			writeVector(scene.nodeIndices);
+			writeString(scene.name);
+		}
+
+		void write(const Skin& skin) {
+			write(skin.inverseBindMatrices);
+			write(skin.skeleton);
+			writeVector(skin.joints);
+			writeString(skin.name);
+		}
+
+		void write(const Texture& texture) {
+			write(texture.samplerIndex);
+			write(texture.imageIndex);
+			write(texture.basisuImageIndex);
+			write(texture.ddsImageIndex);
+			write(texture.webpImageIndex);
+			writeString(texture.name);
+		}
+
+		void write(const Asset& asset) {
+			writeValue(asset.assetInfo.has_value());
+			if (asset.assetInfo.has_value()) {
+				writeString(asset.assetInfo->gltfVersion);
+				writeString(asset.assetInfo->copyright);
+				writeString(asset.assetInfo->generator);
+			}
+			writeCount(asset.extensionsUsed.size());
+			for (const auto& extension : asset.extensionsUsed)
+				writeString(extension);
+			writeCount(asset.extensionsRequired.size());
+			for (const auto& extension : asset.extensionsRequired)
+				writeString(extension);
+			write(asset.defaultScene);
+
+			writeVector(asset.accessors);
+			writeVector(asset.animations);
+			writeVector(asset.buffers);
+			writeVector(asset.bufferViews);
+			writeVector(asset.cameras);
+			writeVector(asset.images);
+			writeVector(asset.lights);
+			writeVector(asset.materials);
+			writeVector(asset.meshes);
+			writeVector(asset.nodes);
+			writeVector(asset.samplers);
+			writeVector(asset.scenes);
+			writeVector(asset.skins);
+			writeVector(asset.textures);
+
+			writeCount(asset.materialVariants.size());
+			for (const auto& variant : asset.materialVariants)
+				writeString(variant);
+			writeValue(asset.availableCategories);
 		}
+	};
 
-		if (!it->name.empty())
-			json += R"(,"name":")" + fg::escapeString(it->name) + '"';
-		json += '}';
-		if (uabs(std::distance(asset.skins.begin(), it)) + 1 <asset.skins.size())
-			json += ',';
-	}
-	json += ']';
-}
+	/**
+	 * The counterpart of AssetCacheWriter. Every read is bounds checked, and once the structure has been
+	 * exhausted or contains an invalid value, all further reads return zeros and failed is set.
+	 */
+	class AssetCacheReader {
+		const std::byte* cursor;
+		const std::byte* end;
 
-void fg::Exporter::writeTextures(const Asset& asset, std::string& json) {
-	if (asset.textures.empty())
-		return;
-	if (json.back() == ']' || json.back() == '}')
-		json += ',';
+		span<const std::byte> data;
+		// If set, the data section is shared with the asset, instead of being copied.
+		bool shareData;
 
-	json += "\"textures\":[";
-	for (auto it = asset.textures.begin(); it != asset.textures.end(); ++it) {
-		json += '{';
+	public:
+#if !FASTGLTF_DISABLE_CUSTOM_MEMORY_POOL
+		std::pmr::memory_resource* resource;
+#endif
+		bool failed = false;
 
-		if (it->samplerIndex.has_value())
-			json += R"("sampler":)" + std::to_string(it->samplerIndex.value());
+		explicit AssetCacheReader(span<const std::byte> structure, span<const std::byte> data, bool shareData)
+				: cursor(structure.data()), end(structure.data() + structure.size()), data(data), shareData(shareData) {}
 
-		if (it->imageIndex.has_value()) {
-			if (json.back() != '{') json += ',';
-			json += R"("source":)" + std::to_string(it->imageIndex.value());
+		[[nodiscard]] bool atEnd() const noexcept {
+			return cursor == end;
 		}
 
-		if (it->basisuImageIndex.has_value() || it->ddsImageIndex.has_value() || it->webpImageIndex.has_value()) {
-			if (json.back() != '{') json += ',';
-			json += R"("extensions":{)";
-			if (it->basisuImageIndex.has_value()) {
-				json += R"("KHR_texture_basisu":{"source":)" + std::to_string(it->basisuImageIndex.value()) + '}';
-			}
-			if (it->ddsImageIndex.has_value()) {
-				if (json.back() == '}') json += ',';
-				json += R"("MSFT_texture_dds":{"source":)" + std::to_string(it->ddsImageIndex.value()) + '}';
-			}
-			if (it->webpImageIndex.has_value()) {
-				if (json.back() == '}') json += ',';
-				json += R"("EXT_texture_webp":{"source":)" + std::to_string(it->webpImageIndex.value()) + '}';
+		template <typename T>
+		void readValue(T& value) {
+			static_assert(std::is_trivially_copyable_v<T>);
+			if (static_cast<std::size_t>(end - cursor) < sizeof(T)) FASTGLTF_UNLIKELY {
+				failed = true;
+				cursor = end;
+				value = T {};
+				return;
 			}
-			json += "}";
+			std::memcpy(&value, cursor, sizeof(T));
+			cursor += sizeof(T);
 		}
 
-		if (extrasWriteCallback != nullptr) {
-			auto extras = extrasWriteCallback(uabs(std::distance(asset.textures.begin(), it)), fastgltf::Category::Textures, userPointer);
-			if (extras.has_value()) {
-				if (json.back() != '{')
-					json += ',';
-				json += std::string("\"extras\":") + *extras;
-			}
+		template <typename T>
+		[[nodiscard]] T readValue() {
+			T value;
+			readValue(value);
+			return value;
 		}
 
-		if (!it->name.empty())
-			json += R"(,"name":")" + fg::escapeString(it->name) + '"';
-		json += '}';
-		if (uabs(std::distance(asset.textures.begin(), it)) + 1 <asset.textures.size())
-			json += ',';
-	}
-	json += ']';
-}
-
-void fg::Exporter::writeExtensions(const fastgltf::Asset& asset, std::string& json) {
-	if (json.back() == ']' || json.back() == '}')
-		json += ',';
-    json += "\"extensions\":{";
-
-    writeLights(asset, json);
-
-	if (!asset.materialVariants.empty()) {
-		if (json.back() != '{')
-			json += ',';
-		json += R"("KHR_materials_variants":{"variants":[)";
-		for (const auto& variant : asset.materialVariants) {
-			if (json.back() == '}')
-				json += ',';
-			json += R"({"name":")" + variant + "\"}";
+		void readValue(bool& value) {
+			std::uint8_t byte;
+			readValue(byte);
+			if (byte > 1) FASTGLTF_UNLIKELY {
+				failed = true;
+			}
+			value = byte != 0;
 		}
-		json += "]}";
-	}
 
-    json += '}';
-}
+		void readCount(std::size_t& count) {
+			const auto value = readValue<std::uint64_t>();
+			if (value > std::numeric_limits<std::size_t>::max()) FASTGLTF_UNLIKELY {
+				failed = true;
+				count = 0;
+				return;
+			}
+			count = static_cast<std::size_t>(value);
+		}
 
-fs::path fg::Exporter::getBufferFilePath(const Asset& asset, std::size_t index) {
-    const auto& bufferName = asset.buffers[index].name;
-    if (bufferName.empty()) {
-        return bufferFolder / ("buffer" + std::to_string(index) + ".bin");
-    }
-	return bufferFolder / (bufferName + ".bin");
-}
+		/** Reads the number of elements of an array, which can never be more than the remaining bytes. */
+		[[nodiscard]] std::size_t readElementCount() {
+			std::size_t count;
+			readCount(count);
+			if (count > static_cast<std::size_t>(end - cursor)) FASTGLTF_UNLIKELY {
+				failed = true;
+				cursor = end;
+				return 0;
+			}
+			return count;
+		}
 
-fs::path fg::Exporter::getImageFilePath(const Asset& asset, std::size_t index, MimeType mimeType) {
-    std::string_view extension;
-    switch (mimeType) {
-        case MimeType::JPEG:
-            extension = ".jpeg";
-            break;
-        case MimeType::PNG:
-            extension = ".png";
-            break;
-		case MimeType::KTX2:
-			extension = ".ktx2";
-			break;
-		case MimeType::DDS:
-			extension = ".dds";
-			break;
-		default:
-		case MimeType::None:
-		case MimeType::GltfBuffer:
-		case MimeType::OctetStream:
-			extension = ".bin";
-			break;
-    }
+		[[nodiscard]] std::string_view readStringView() {
+			const auto length = readElementCount();
+			std::string_view string(reinterpret_cast<const char*>(cursor), length);
+			cursor += length;
+			return string;
+		}
 
-    const auto& imageName = asset.images[index].name;
-	if (imageName.empty()) {
-		return imageFolder / ("image" + std::to_string(index) + std::string(extension));
-	}
-	return imageFolder / (std::string(imageName) + std::string(extension));
-}
+		template <typename String>
+		void readString(String& string) {
+			const auto view = readStringView();
+			if constexpr (std::is_same_v<String, std::string>) {
+				string.assign(view);
+			} else {
+				assignWithResource(string, FASTGLTF_CONSTRUCT_PMR_RESOURCE(String, resource, view));
+			}
+		}
 
-std::string fg::Exporter::writeJson(const fastgltf::Asset &asset) {
-    // Fairly rudimentary approach of just composing the JSON string using a std::string.
-    std::string outputString;
+		[[nodiscard]] DataSource readBytes(MimeType mimeType, std::size_t offset, std::size_t size) {
+			if (offset > data.size() || size > data.size() - offset) FASTGLTF_UNLIKELY {
+				failed = true;
+				return std::monostate {};
+			}
+			if (shareData) {
+				return sources::ByteView { data.subspan(offset, size), mimeType };
+			}
+			StaticVector<std::byte> bytes(size);
+			if (size != 0) {
+				std::memcpy(bytes.data(), data.data() + offset, size);
+			}
+			return sources::Array { std::move(bytes), mimeType };
+		}
 
-    outputString += "{";
+		template <typename T>
+		void read(T& value) {
+			readValue(value);
+		}
 
-    // Write asset info
-    outputString += "\"asset\":{";
-    if (asset.assetInfo.has_value()) {
-        if (!asset.assetInfo->copyright.empty())
-            outputString += R"("copyright":")" + fg::escapeString(asset.assetInfo->copyright) + "\",";
-        if (!asset.assetInfo->generator.empty())
-            outputString += R"("generator":")" + fg::escapeString(asset.assetInfo->generator) + "\",";
-        outputString += R"("version":")" + asset.assetInfo->gltfVersion + '"';
-    } else {
-        outputString += R"("generator":"fastgltf",)";
-        outputString += R"("version":"2.0")";
-    }
-    outputString += '}';
+		void read(std::size_t& value) {
+			readCount(value);
+		}
 
-	// Write extension usage info
-	if (!asset.extensionsUsed.empty()) {
-		if (outputString.back() != '{') outputString += ',';
-		outputString += "\"extensionsUsed\":[";
-		for (auto it = asset.extensionsUsed.begin(); it != asset.extensionsUsed.end(); ++it) {
-			outputString += '\"' + *it + '\"';
-			if (uabs(std::distance(asset.extensionsUsed.begin(), it)) + 1 <asset.extensionsUsed.size())
-				outputString += ',';
+		template <typename T>
+		void read(std::optional<T>& optional) {
+			if (readValue<bool>()) {
+				read(optional.emplace());
+			} else {
+				optional.reset();
+			}
 		}
-		outputString += ']';
-	}
-	if (!asset.extensionsRequired.empty()) {
-		if (outputString.back() != '{') outputString += ',';
-		outputString += "\"extensionsRequired\":[";
-		for (auto it = asset.extensionsRequired.begin(); it != asset.extensionsRequired.end(); ++it) {
-			outputString += '\"' + *it + '\"';
-			if (uabs(std::distance(asset.extensionsRequired.begin(), it)) + 1 <asset.extensionsRequired.size())
-				outputString += ',';
+
+		template <typename T>
+		void read(OptionalWithFlagValue<T>& optional) {
+			if (readValue<bool>()) {
+				T value {};
+				read(value);
+				optional = value;
+			} else {
+				optional.reset();
+			}
 		}
-		outputString += ']';
-	}
 
-    writeAccessors(asset, outputString);
-    writeAnimations(asset, outputString);
-    writeBuffers(asset, outputString);
-    writeBufferViews(asset, outputString);
-    writeCameras(asset, outputString);
-    writeImages(asset, outputString);
-    writeMaterials(asset, outputString);
-    writeMeshes(asset, outputString);
-    writeNodes(asset, outputString);
-    writeSamplers(asset, outputString);
-    writeScenes(asset, outputString);
-    writeSkins(asset, outputString);
-    writeTextures(asset, outputString);
-    writeExtensions(asset, outputString);
+		template <typename T>
+		void read(std::unique_ptr<T>& pointer) {
+			if (readValue<bool>()) {
+				pointer = std::make_unique<T>();
+				read(*pointer);
+			} else {
+				pointer.reset();
+			}
+		}
 
-    outputString += "}";
+		/** Reads the elements of a std::vector, which does not use the asset's memory resource. */
+		template <typename T>
+		void readVector(std::vector<T>& vector) {
+			vector.resize(readElementCount());
+			for (auto& element : vector)
+				read(element);
+		}
 
-    if (hasBit(options, ExportOptions::PrettyPrintJson)) {
-        prettyPrintJson(outputString);
-    }
+		/** Reads the elements of a vector which allocates from the asset's memory resource. */
+		template <typename Vector>
+		void readResourceVector(Vector& vector) {
+			const auto count = readElementCount();
+			assignWithResource(vector, FASTGLTF_CONSTRUCT_PMR_RESOURCE(Vector, resource, 0));
+			vector.reserve(count);
+			for (std::size_t i = 0; i < count; ++i)
+				read(vector.emplace_back());
+		}
 
-    return outputString;
-}
+		void read(Attribute& attribute) {
+			readString(attribute.name);
+			readCount(attribute.accessorIndex);
+		}
 
-fg::Expected<fg::ExportResult<std::string>> fg::Exporter::writeGltfJson(const Asset& asset, ExportOptions _options) {
-    bufferPaths.clear();
-    imagePaths.clear();
-    options = _options;
-	exportingBinary = false;
+		void read(std::optional<AccessorBoundsArray>& optional) {
+			// AccessorBoundsArray is not default constructible, so it can't go through read(std::optional<T>&).
+			if (!readValue<bool>()) {
+				optional.reset();
+				return;
+			}
+			const auto type = static_cast<AccessorBoundsArray::BoundsType>(readValue<std::uint8_t>());
+			if (type != AccessorBoundsArray::BoundsType::int64 && type != AccessorBoundsArray::BoundsType::float64) FASTGLTF_UNLIKELY {
+				failed = true;
+				return;
+			}
+			const auto count = readElementCount();
+			auto& bounds = optional.emplace(count, type);
+			for (std::size_t i = 0; i < count; ++i) {
+				if (type == AccessorBoundsArray::BoundsType::int64) {
+					bounds.set<std::int64_t>(i, readValue<std::int64_t>());
+				} else {
+					bounds.set<double>(i, readValue<double>());
+				}
+			}
+		}
 
-    if (hasBit(options, ExportOptions::ValidateAsset)) {
-        if (const auto validation = validate(asset); validation != Error::None) {
-            return validation;
-        }
-    }
+		void read(SparseAccessor& sparse) {
+			readCount(sparse.count);
+			readCount(sparse.indicesBufferView);
+			readCount(sparse.indicesByteOffset);
+			readCount(sparse.valuesBufferView);
+			readCount(sparse.valuesByteOffset);
+			readValue(sparse.indexComponentType);
+		}
 
-    // Fairly rudimentary approach of just composing the JSON string using a std::string.
-    std::string outputString = writeJson(asset);
-    if (errorCode != Error::None) {
-		return errorCode;
-    }
+		void read(CompressedBufferView& compression) {
+			readCount(compression.bufferIndex);
+			readCount(compression.byteOffset);
+			readCount(compression.byteLength);
+			readCount(compression.count);
+			readValue(compression.mode);
+			readValue(compression.filter);
+			readCount(compression.byteStride);
+		}
 
-    ExportResult<std::string> result;
-    result.output = std::move(outputString);
-    result.bufferPaths = std::move(bufferPaths);
-    result.imagePaths = std::move(imagePaths);
-    return std::move(result);
-}
+		void read(TextureTransform& transform) {
+			readValue(transform.rotation);
+			readValue(transform.uvOffset);
+			readValue(transform.uvScale);
+			read(transform.texCoordIndex);
+		}
 
-fg::Expected<fg::ExportResult<std::vector<std::byte>>> fg::Exporter::writeGltfBinary(const Asset& asset, ExportOptions _options) {
-    bufferPaths.clear();
-    imagePaths.clear();
-    options = _options;
-	exportingBinary = true;
+		void read(TextureInfo& info) {
+			readCount(info.textureIndex);
+			readCount(info.texCoordIndex);
+			read(info.transform);
+		}
 
-    options &= (~ExportOptions::PrettyPrintJson);
+		void read(NormalTextureInfo& info) {
+			read(static_cast<TextureInfo&>(info));
+			readValue(info.scale);
+		}
 
-    ExportResult<std::vector<std::byte>> result;
-    auto json = writeJson(asset);
-    if (errorCode != Error::None) {
-		return errorCode;
-    }
+		void read(OcclusionTextureInfo& info) {
+			read(static_cast<TextureInfo&>(info));
+			readValue(info.strength);
+		}
 
-    result.bufferPaths = std::move(bufferPaths);
-    result.imagePaths = std::move(imagePaths);
+		void read(MaterialAnisotropy& anisotropy) {
+			readValue(anisotropy.anisotropyStrength);
+			readValue(anisotropy.anisotropyRotation);
+			read(anisotropy.anisotropyTexture);
+		}
 
-	// TODO: Add ExportOption enumeration for disabling this?
-    const bool withEmbeddedBuffer = !asset.buffers.empty()
-			// We only support writing Vectors and ByteViews as embedded buffers
-			&& (std::holds_alternative<sources::Array>(asset.buffers.front().data) || std::holds_alternative<sources::ByteView>(asset.buffers.front().data) || std::holds_alternative<sources::Vector>(asset.buffers.front().data))
-			&& asset.buffers.front().byteLength < std::numeric_limits<decltype(BinaryGltfChunk::chunkLength)>::max();
+		void read(MaterialClearcoat& clearcoat) {
+			readValue(clearcoat.clearcoatFactor);
+			read(clearcoat.clearcoatTexture);
+			readValue(clearcoat.clearcoatRoughnessFactor);
+			read(clearcoat.clearcoatRoughnessTexture);
+			read(clearcoat.clearcoatNormalTexture);
+		}
 
-    std::size_t binarySize = 0;
-    binarySize += sizeof(BinaryGltfHeader); // glTF header
-    binarySize += sizeof(BinaryGltfChunk) + alignUp(json.size(), 4); // JSON chunk
-    if (withEmbeddedBuffer) {
-        binarySize += sizeof(BinaryGltfChunk) + alignUp(asset.buffers.front().byteLength, 4); // BIN chunk
-    }
+		void read(MaterialIridescence& iridescence) {
+			readValue(iridescence.iridescenceFactor);
+			read(iridescence.iridescenceTexture);
+			readValue(iridescence.iridescenceIor);
+			readValue(iridescence.iridescenceThicknessMinimum);
+			readValue(iridescence.iridescenceThicknessMaximum);
+			read(iridescence.iridescenceThicknessTexture);
+		}
 
-	// A GLB is limited to 2^32 bytes since the length field in the file header is a 32-bit integer.
-	if (binarySize >= static_cast<std::size_t>(std::numeric_limits<decltype(BinaryGltfHeader::length)>::max())) {
-		return Error::InvalidGLB;
-	}
+		void read(MaterialSheen& sheen) {
+			readValue(sheen.sheenColorFactor);
+			read(sheen.sheenColorTexture);
+			readValue(sheen.sheenRoughnessFactor);
+			read(sheen.sheenRoughnessTexture);
+		}
 
-    result.output.resize(binarySize);
-    auto write = [output = result.output.data()](const void* data, std::size_t size) mutable {
-        std::memcpy(output, data, size);
-        output += size;
-    };
+		void read(MaterialSpecular& specular) {
+			readValue(specular.specularFactor);
+			read(specular.specularTexture);
+			readValue(specular.specularColorFactor);
+			read(specular.specularColorTexture);
+		}
 
-	// Write glTF header
-	BinaryGltfHeader header {};
-	header.magic = binaryGltfHeaderMagic;
-	header.version = 2;
-	header.length = static_cast<std::uint32_t>(binarySize);
-	auto headerBytes = writeBinaryHeader(header);
-	write(headerBytes.data(), headerBytes.size());
+#if FASTGLTF_ENABLE_DEPRECATED_EXT
+		void read(MaterialSpecularGlossiness& specularGlossiness) {
+			readValue(specularGlossiness.diffuseFactor);
+			read(specularGlossiness.diffuseTexture);
+			readValue(specularGlossiness.specularFactor);
+			readValue(specularGlossiness.glossinessFactor);
+			read(specularGlossiness.specularGlossinessTexture);
+		}
+#endif
 
-	// Write JSON chunk
-	BinaryGltfChunk jsonChunk {};
-	jsonChunk.chunkType = binaryGltfJsonChunkMagic;
-	jsonChunk.chunkLength = static_cast<std::uint32_t>(alignUp(json.size(), 4));
-	auto chunkBytes = writeBinaryChunk(jsonChunk);
-	write(chunkBytes.data(), chunkBytes.size());
+		void read(MaterialTransmission& transmission) {
+			readValue(transmission.transmissionFactor);
+			read(transmission.transmissionTexture);
+		}
 
-    write(json.data(), json.size());
+		void read(MaterialDiffuseTransmission& diffuseTransmission) {
+			readValue(diffuseTransmission.diffuseTransmissionFactor);
+			readValue(diffuseTransmission.diffuseTransmissionColorFactor);
+			read(diffuseTransmission.diffuseTransmissionTexture);
+			read(diffuseTransmission.diffuseTransmissionColorTexture);
+		}
 
-    // 4 bytes padding with space character (0x20)
-    for (std::size_t i = json.size(); i % 4 != 0; ++i) {
-        static constexpr std::uint8_t space = 0x20U;
-        write(&space, sizeof space);
-    }
+		void read(MaterialVolume& volume) {
+			readValue(volume.thicknessFactor);
+			read(volume.thicknessTexture);
+			readValue(volume.attenuationDistance);
+			readValue(volume.attenuationColor);
+		}
 
-    if (withEmbeddedBuffer) {
-        const auto& buffer = asset.buffers.front();
+		void read(MaterialPackedTextures& packedTextures) {
+			read(packedTextures.occlusionRoughnessMetallicTexture);
+			read(packedTextures.roughnessMetallicOcclusionTexture);
+			read(packedTextures.normalTexture);
+		}
 
-        // Write BIN chunk
-        BinaryGltfChunk dataChunk {};
-        dataChunk.chunkType = binaryGltfDataChunkMagic;
-        dataChunk.chunkLength = static_cast<std::uint32_t>(alignUp(buffer.byteLength, 4));
-		chunkBytes = writeBinaryChunk(dataChunk);
-		write(chunkBytes.data(), chunkBytes.size());
+		void read(DracoCompressedPrimitive& draco) {
+			readCount(draco.bufferView);
+			readResourceVector(draco.attributes);
+		}
 
-		std::visit(visitor {
-			[](auto&) {},
-			[&](const sources::Array& vector) {
-				write(vector.bytes.data(), buffer.byteLength);
-			},
-			[&](const sources::Vector& vector) {
-				write(vector.bytes.data(), buffer.byteLength);
-			},
-			[&](const sources::ByteView& byteView) {
-				write(byteView.bytes.data(), buffer.byteLength);
-			},
-		}, buffer.data);
+		void read(DataSource& source) {
+			switch (readValue<CachedDataSource>()) {
+				case CachedDataSource::None: {
+					source = std::monostate {};
+					break;
+				}
+				case CachedDataSource::BufferView: {
+					sources::BufferView view = {};
+					readCount(view.bufferViewIndex);
+					readValue(view.mimeType);
+					source = view;
+					break;
+				}
+				case CachedDataSource::URI: {
+					std::size_t fileByteOffset;
+					readCount(fileByteOffset);
+					URI uri(readStringView());
+					source = sources::URI { fileByteOffset, std::move(uri), readValue<MimeType>() };
+					break;
+				}
+				case CachedDataSource::Bytes: {
+					std::size_t offset, size;
+					readCount(offset);
+					readCount(size);
+					source = readBytes(readValue<MimeType>(), offset, size);
+					break;
+				}
+				case CachedDataSource::CustomBuffer: {
+					sources::CustomBuffer customBuffer = {};
+					readValue(customBuffer.id);
+					readValue(customBuffer.mimeType);
+					source = customBuffer;
+					break;
+				}
+				case CachedDataSource::Fallback: {
+					source = sources::Fallback {};
+					break;
+				}
+				default: {
+					failed = true;
+					break;
+				}
+			}
+		}
 
-        // 4 bytes padding with zeros
-        for (std::size_t i = buffer.byteLength; i % 4 != 0; ++i) {
-            static constexpr std::uint8_t zero = 0x0U;
-            write(&zero, sizeof zero);
-        }
-    }
+		void read(Accessor& accessor) {
+			readCount(accessor.byteOffset);
+			readCount(accessor.count);
+			readValue(accessor.type);
+			readValue(accessor.componentType);
+			readValue(accessor.normalized);
+			read(accessor.max);
+			read(accessor.min);
+			read(accessor.bufferViewIndex);
+			read(accessor.sparse);
+			readString(accessor.name);
+		}
 
-    return std::move(result);
-}
+		void read(AnimationChannel& channel) {
+			readCount(channel.samplerIndex);
+			read(channel.nodeIndex);
+			readValue(channel.path);
+		}
 
-namespace fastgltf {
-	bool writeFile(const DataSource& dataSource, const fs::path& baseFolder, const fs::path& filePath) {
-		// Get the final normalized path. TODO: Perhaps move these filesystem checks to the parent function?
-		auto finalPath = (baseFolder / filePath).lexically_normal();
-		if (std::error_code ec; !fs::exists(finalPath.parent_path(), ec) || ec) {
-			// If the parent folder of the destination file does not exist, we'll create it.
-			fs::create_directory(finalPath.parent_path(), ec);
-			if (ec) {
-				return false;
-			}
+		void read(AnimationSampler& sampler) {
+			readCount(sampler.inputAccessor);
+			readCount(sampler.outputAccessor);
+			readValue(sampler.interpolation);
 		}
 
-		return std::visit(visitor {
-			[](auto&) {
-				return false;
-			},
-			[&](const sources::Array& vector) {
-				std::ofstream file(finalPath, std::ios::out | std::ios::binary);
-				if (!file.is_open())
-					return false;
-				file.write(reinterpret_cast<const char *>(vector.bytes.data()),
-						   static_cast<std::streamsize>(vector.bytes.size()));
-				file.close();
-				return file.good();
-			},
-			[&](const sources::Vector& vector) {
-				std::ofstream file(finalPath, std::ios::out | std::ios::binary);
-				if (!file.is_open())
-					return false;
-				file.write(reinterpret_cast<const char *>(vector.bytes.data()),
-						   static_cast<std::streamsize>(vector.bytes.size()));
-				file.close();
-				return file.good();
-			},
-			[&](const sources::ByteView& view) {
-				std::ofstream file(finalPath, std::ios::out | std::ios::binary);
-				if (!file.is_open())
-					return false;
-				file.write(reinterpret_cast<const char *>(view.bytes.data()),
-						   static_cast<std::streamsize>(view.bytes.size()));
-				file.close();
-				return file.good();
-			},
-		}, dataSource);
-	}
+		void read(Animation& animation) {
+			readResourceVector(animation.channels);
+			readResourceVector(animation.samplers);
+			readString(animation.name);
+		}
 
-	template<typename T>
-	bool writeFiles(const Asset& asset, ExportResult<T> &result, fs::path baseFolder) {
-		for (std::size_t i = 0; i < asset.buffers.size(); ++i) {
-			auto& path = result.bufferPaths[i];
-			if (path.has_value()) {
-				if (!writeFile(asset.buffers[i].data, baseFolder, path.value()))
-					return false;
-			}
+		void read(Buffer& buffer) {
+			readCount(buffer.byteLength);
+			read(buffer.data);
+			readString(buffer.name);
 		}
 
-		for (std::size_t i = 0; i < asset.images.size(); ++i) {
-			auto& path = result.imagePaths[i];
-			if (path.has_value()) {
-				if (!writeFile(asset.images[i].data, baseFolder, path.value()))
-					return false;
+		void read(BufferView& bufferView) {
+			readCount(bufferView.bufferIndex);
+			readCount(bufferView.byteOffset);
+			readCount(bufferView.byteLength);
+			read(bufferView.byteStride);
+			read(bufferView.target);
+			read(bufferView.meshoptCompression);
+			readString(bufferView.name);
+		}
+
+		void read(Camera& camera) {
+			switch (readValue<std::uint8_t>()) {
+				case 0: {
+					Camera::Perspective perspective = {};
+					read(perspective.aspectRatio);
+					readValue(perspective.yfov);
+					read(perspective.zfar);
+					readValue(perspective.znear);
+					camera.camera = perspective;
+					break;
+				}
+				case 1: {
+					Camera::Orthographic orthographic = {};
+					readValue(orthographic.xmag);
+					readValue(orthographic.ymag);
+					readValue(orthographic.zfar);
+					readValue(orthographic.znear);
+					camera.camera = orthographic;
+					break;
+				}
+				default: {
+					failed = true;
+					break;
+				}
+			}
+			readString(camera.name);
+		}
+
+		void read(Image& image) {
+			read(image.data);
+			readString(image.name);
+		}
+
+		void read(Light& light) {
+			readValue(light.type);
+			readValue(light.color);
+			readValue(light.intensity);
+			read(light.range);
+			read(light.innerConeAngle);
+			read(light.outerConeAngle);
+			readString(light.name);
+		}
+
+		void read(Material& material) {
+			readValue(material.pbrData.baseColorFactor);
+			readValue(material.pbrData.metallicFactor);
+			readValue(material.pbrData.roughnessFactor);
+			read(material.pbrData.baseColorTexture);
+			read(material.pbrData.metallicRoughnessTexture);
+			read(material.normalTexture);
+			read(material.occlusionTexture);
+			read(material.emissiveTexture);
+			readValue(material.emissiveFactor);
+			readValue(material.alphaMode);
+			readValue(material.doubleSided);
+			readValue(material.unlit);
+			readValue(material.alphaCutoff);
+			readValue(material.emissiveStrength);
+			readValue(material.ior);
+			readValue(material.dispersion);
+			read(material.anisotropy);
+			read(material.clearcoat);
+			read(material.iridescence);
+			read(material.sheen);
+			read(material.specular);
+#if FASTGLTF_ENABLE_DEPRECATED_EXT
+			read(material.specularGlossiness);
+#endif
+			read(material.transmission);
+			read(material.diffuseTransmission);
+			read(material.volume);
+			read(material.packedNormalMetallicRoughnessTexture);
+			read(material.packedOcclusionRoughnessMetallicTextures);
+			readString(material.name);
+		}
+
+		void read(Primitive& primitive) {
+			readResourceVector(primitive.attributes);
+			readValue(primitive.type);
+			const auto targetCount = readElementCount();
+			assignWithResource(primitive.targets, FASTGLTF_CONSTRUCT_PMR_RESOURCE(decltype(primitive.targets), resource, 0));
+			primitive.targets.reserve(targetCount);
+			for (std::size_t i = 0; i < targetCount; ++i)
+				readResourceVector(primitive.targets.emplace_back());
+			read(primitive.indicesAccessor);
+			read(primitive.materialIndex);
+			readVector(primitive.mappings);
+			read(primitive.dracoCompression);
+		}
+
+		void read(Mesh& mesh) {
+			readResourceVector(mesh.primitives);
+			readResourceVector(mesh.weights);
+			readString(mesh.name);
+		}
+
+		void read(Node& node) {
+			read(node.meshIndex);
+			read(node.skinIndex);
+			read(node.cameraIndex);
+			read(node.lightIndex);
+			readResourceVector(node.children);
+			readResourceVector(node.weights);
+			switch (readValue<std::uint8_t>()) {
+				case 0: {
+					TRS trs;
+					readValue(trs.translation);
+					readValue(trs.rotation);
+					readValue(trs.scale);
+					node.transform = trs;
+					break;
+				}
+				case 1: {
+					node.transform = readValue<math::fmat4x4>();
+					break;
+				}
+				default: {
+					failed = true;
+					break;
+				}
 			}
+			readResourceVector(node.instancingAttributes);
+			readString(node.name);
+		}
+
+		void read(Sampler& sampler) {
+			read(sampler.magFilter);
+			read(sampler.minFilter);
+			readValue(sampler.wrapS);
+			readValue(sampler.wrapT);
+			readString(sampler.name);
+		}
+
+		void read(Scene& scene) {
+			readResourceVector(scene.nodeIndices);
+			readString(scene.name);
+		}
+
+		void read(Skin& skin) {
+			read(skin.inverseBindMatrices);
+			read(skin.skeleton);
+			readResourceVector(skin.joints);
+			readString(skin.name);
+		}
+
+		void read(Texture& texture) {
+			read(texture.samplerIndex);
+			read(texture.imageIndex);
+			read(texture.basisuImageIndex);
+			read(texture.ddsImageIndex);
+			read(texture.webpImageIndex);
+			readString(texture.name);
+		}
+
+		void read(Asset& asset) {
+			if (readValue<bool>()) {
+				AssetInfo info = {};
+				readString(info.gltfVersion);
+				readString(info.copyright);
+				readString(info.generator);
+				asset.assetInfo = std::move(info);
+			}
+			const auto extensionsUsedCount = readElementCount();
+			asset.extensionsUsed.reserve(extensionsUsedCount);
+			for (std::size_t i = 0; i < extensionsUsedCount; ++i)
+				readString(asset.extensionsUsed.emplace_back());
+			const auto extensionsRequiredCount = readElementCount();
+			asset.extensionsRequired.reserve(extensionsRequiredCount);
+			for (std::size_t i = 0; i < extensionsRequiredCount; ++i)
+				readString(asset.extensionsRequired.emplace_back());
+			read(asset.defaultScene);
+
+			readVector(asset.accessors);
+			readVector(asset.animations);
+			readVector(asset.buffers);
+			readVector(asset.bufferViews);
+			readVector(asset.cameras);
+			readVector(asset.images);
+			readVector(asset.lights);
+			readVector(asset.materials);
+			readVector(asset.meshes);
+			readVector(asset.nodes);
+			readVector(asset.samplers);
+			readVector(asset.scenes);
+			readVector(asset.skins);
+			readVector(asset.textures);
+
+			const auto variantCount = readElementCount();
+			asset.materialVariants.reserve(variantCount);
+			for (std::size_t i = 0; i < variantCount; ++i)
+				readString(asset.materialVariants.emplace_back());
+			readValue(asset.availableCategories);
 		}
-		return true;
-	}
+	};
 } // namespace fastgltf
 
-fg::Error fg::FileExporter::writeGltfJson(const Asset& asset, fs::path target, ExportOptions _options) {
-	if (std::error_code ec; !fs::exists(target.parent_path(), ec) || ec) {
-		fs::create_directory(target.parent_path(), ec);
-		if (ec) {
-			return Error::InvalidPath;
+std::uint64_t fg::hashGltfData(GltfDataGetter& data) {
+	// The data is hashed in fixed blocks, each seeded with the hash of the previous block, so that
+	// the result does not depend on whether the getter can share its memory or has to be read.
+	static constexpr std::size_t blockSize = 1024 * 1024;
+
+	data.reset();
+	const auto totalSize = data.totalSize();
+	auto hash = static_cast<std::uint64_t>(totalSize);
+	if (auto sharedData = data.shareData(); sharedData != nullptr) {
+		for (std::size_t offset = 0; offset < totalSize; offset += blockSize) {
+			hash = hashBytes(sharedData.get() + offset, std::min(blockSize, totalSize - offset), hash);
+		}
+	} else {
+		for (std::size_t offset = 0; offset < totalSize; offset += blockSize) {
+			const auto size = std::min(blockSize, totalSize - offset);
+			auto block = data.read(size, 0);
+			hash = hashBytes(block.data(), size, hash);
 		}
 	}
+	data.reset();
+	return hash;
+}
 
-	auto expected = Exporter::writeGltfJson(asset, _options);
+fg::Expected<fg::Asset> fg::Parser::loadAssetCache(GltfDataGetter& data, std::uint64_t sourceHash) {
+	data.reset();
+	const auto totalSize = data.totalSize();
+	if (totalSize < sizeof(AssetCacheHeader)) {
+		return Error::InvalidAssetCache;
+	}
 
-    if (!expected) {
-        return expected.error();
-    }
-    auto& result = expected.get();
+	// Either reference the whole cache in place, or read it once and copy the buffers and images out of it.
+	auto sharedData = data.shareData();
+	const std::byte* bytes;
+	if (sharedData != nullptr) {
+		bytes = sharedData.get();
+	} else {
+		bytes = data.read(totalSize, 0).data();
+	}
 
-    std::ofstream file(target, std::ios::out);
-    if (!file.is_open()) {
-        return fg::Error::InvalidPath;
-    }
+	AssetCacheHeader header;
+	std::memcpy(&header, bytes, sizeof(header));
+	if (header.magic != assetCacheMagic || header.version != assetCacheVersion
+			|| header.configuration != getAssetCacheConfiguration() || header.sourceHash != sourceHash) {
+		return Error::InvalidAssetCache;
+	}
+	if (header.structureSize > totalSize - sizeof(AssetCacheHeader)
+			|| header.dataOffset < sizeof(AssetCacheHeader) + header.structureSize
+			|| header.dataOffset > totalSize || header.dataSize > totalSize - header.dataOffset) {
+		return Error::InvalidAssetCache;
+	}
 
-    file << result.output;
-    file.close();
+	AssetCacheReader reader(
+			span<const std::byte>(bytes + sizeof(AssetCacheHeader), static_cast<std::size_t>(header.structureSize)),
+			span<const std::byte>(bytes + header.dataOffset, static_cast<std::size_t>(header.dataSize)),
+			sharedData != nullptr);
 
-	if (!writeFiles(asset, result, target.parent_path())) {
-		return Error::FailedWritingFiles;
+	Asset asset {};
+#if !FASTGLTF_DISABLE_CUSTOM_MEMORY_POOL
+	asset.memoryResource = resourceAllocator = createArena();
+	reader.resource = resourceAllocator.get();
+#endif
+	reader.read(asset);
+	if (reader.failed || !reader.atEnd()) {
+		return Error::InvalidAssetCache;
 	}
-    return Error::None;
-}
 
-fg::Error fg::FileExporter::writeGltfBinary(const Asset& asset, fs::path target, ExportOptions _options) {
-	if (std::error_code ec; !fs::exists(target.parent_path(), ec) || ec) {
-		fs::create_directory(target.parent_path(), ec);
-		if (ec) {
-			return Error::InvalidPath;
-		}
+	if (sharedData != nullptr && header.dataSize != 0) {
+		asset.dataOwner = std::move(sharedData);
 	}
+	data.reset();
 
-    auto expected = Exporter::writeGltfBinary(asset, _options);
-
-    if (!expected) {
-        return expected.error();
-    }
-    auto& result = expected.get();
+#if !FASTGLTF_DISABLE_CUSTOM_MEMORY_POOL
+	collectMemoryStatistics(asset);
+#endif
 
-    std::ofstream file(target, std::ios::out | std::ios::binary);
-    if (!file.is_open()) {
-        return fg::Error::InvalidPath;
-    }
+	return std::move(asset);
+}
 
-    file.write(reinterpret_cast<const char*>(result.output.data()),
-               static_cast<std::streamsize>(result.output.size()));
+fg::Expected<std::vector<std::byte>> fg::Exporter::writeAssetCache(const Asset& asset, std::uint64_t sourceHash, ExportOptions _options) {
+	if (hasBit(_options, ExportOptions::ValidateAsset)) {
+		if (const auto validation = validate(asset); validation != Error::None) {
+			return validation;
+		}
+	}
 
-	if (!writeFiles(asset, result, target.parent_path())) {
-		return Error::FailedWritingFiles;
+	AssetCacheWriter writer;
+	writer.write(asset);
+
+	AssetCacheHeader header = {};
+	header.magic = assetCacheMagic;
+	header.version = assetCacheVersion;
+	header.configuration = getAssetCacheConfiguration();
+	header.sourceHash = sourceHash;
+	header.structureSize = writer.structure.size();
+	header.dataOffset = alignUp(sizeof(AssetCacheHeader) + writer.structure.size(), static_cast<std::int64_t>(assetCacheDataAlignment));
+	header.dataSize = writer.dataSize;
+
+	std::vector<std::byte> output(static_cast<std::size_t>(header.dataOffset + header.dataSize));
+	std::memcpy(output.data(), &header, sizeof(header));
+	std::memcpy(output.data() + sizeof(header), writer.structure.data(), writer.structure.size());
+	for (const auto& [offset, bytes] : writer.blobs) {
+		if (!bytes.empty()) {
+			std::memcpy(output.data() + header.dataOffset + offset, bytes.data(), bytes.size());
+		}
 	}
-    return Error::None;
+	return std::move(output);
 }
 #pragma endregion
 
@@ -58,6 +58,7 @@ extern "C++" {
 #include <fastgltf/core.hpp>
 #include <fastgltf/base64.hpp>
 #include <fastgltf/tools.hpp>
+#include <fastgltf/meshopt.hpp>
 
 #if defined(__clang__)
 #pragma clang diagnostic pop
@@ -24,6 +24,9 @@
  * OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include <mutex>
+#include <unordered_map>
+
 #include <simdjson.h>
 
 #include <fastgltf/core.hpp>
@@ -34,6 +37,9 @@
 #include <sys/file.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
+#include <cerrno>
+#include <climits>
 #elif defined(_WIN32)
 #include <windows.h>
 #endif
@@ -49,6 +55,7 @@ fg::GltfDataBuffer::GltfDataBuffer(const fs::path& path) noexcept {
 		error = Error::InvalidPath;
 		return;
 	}
+	this->path = path;
 
 	// Open the file and determine the size.
 	std::ifstream file(path, std::ios::binary);
@@ -118,7 +125,16 @@ std::size_t fg::GltfDataBuffer::totalSize() {
 	return dataSize;
 }
 
-fg::GltfFileStream::GltfFileStream(const fs::path& path) : fileStream(path, std::ios::binary) {
+std::shared_ptr<const std::byte> fg::GltfDataBuffer::shareData() {
+	// Use the aliasing constructor to share ownership of the buffer.
+	return { buffer, buffer.get() };
+}
+
+fs::path fg::GltfDataBuffer::filePath() {
+	return path;
+}
+
+fg::GltfFileStream::GltfFileStream(const fs::path& path) : fileStream(path, std::ios::binary), path(path) {
 	fileSize = fs::file_size(path);
 }
 
@@ -155,6 +171,10 @@ std::size_t fg::GltfFileStream::totalSize() {
 	return fileSize;
 }
 
+fs::path fg::GltfFileStream::filePath() {
+	return path;
+}
+
 #if defined(FASTGLTF_HAS_MEMORY_MAPPED_FILE)
 #if defined(_WIN32)
 fg::MappedGltfFile::MappedGltfFile(const fs::path& path) noexcept {
@@ -191,6 +211,7 @@ fg::MappedGltfFile::MappedGltfFile(const fs::path& path) noexcept {
 		return;
 	}
 	mappedFile = map;
+	this->path = path;
 #else
 fg::MappedGltfFile::MappedGltfFile(const fs::path& path) noexcept : mappedFile(MAP_FAILED) {
 	// Open the file
@@ -217,6 +238,7 @@ fg::MappedGltfFile::MappedGltfFile(const fs::path& path) noexcept : mappedFile(M
 					  0);
 	if (mappedFile != MAP_FAILED) {
 		fileSize = static_cast<std::uint64_t>(statInfo.st_size);
+		this->path = path;
 
 		// Hint about map access
 		madvise(mappedFile, fileSize, MADV_SEQUENTIAL);
@@ -239,39 +261,49 @@ fg::MappedGltfFile::MappedGltfFile(fastgltf::MappedGltfFile &&other) noexcept {
 	mappedFile = std::exchange(other.mappedFile, MAP_FAILED);
 #endif
 	fileSize = other.fileSize;
+	sharedMapping = std::move(other.sharedMapping);
+	path = std::move(other.path);
 	idx = other.idx;
 	error = other.error;
 }
 
 fg::MappedGltfFile& fg::MappedGltfFile::operator=(fastgltf::MappedGltfFile &&other) noexcept {
+	// If the mapping has been shared, the last shared reference will unmap it instead.
+	const bool ownsMapping = sharedMapping == nullptr;
 #if defined(_WIN32)
-	if (mappedFile != nullptr) {
+	if (ownsMapping && mappedFile != nullptr) {
 		UnmapViewOfFile(mappedFile);
 	}
 	mappedFile = std::exchange(other.mappedFile, nullptr);
 
-	if (fileMapping != nullptr) {
+	if (ownsMapping && fileMapping != nullptr) {
 		CloseHandle(fileMapping);
 	}
 	fileMapping = std::exchange(other.fileMapping, nullptr);
 
-	if (fileHandle != nullptr) {
+	if (ownsMapping && fileHandle != nullptr) {
 		CloseHandle(fileHandle);
 	}
 	fileHandle = std::exchange(other.fileHandle, nullptr);
 #else
-	if (mappedFile != MAP_FAILED) {
+	if (ownsMapping && mappedFile != MAP_FAILED) {
 		munmap(mappedFile, fileSize);
 	}
 	mappedFile = std::exchange(other.mappedFile, MAP_FAILED);
 #endif
 	fileSize = other.fileSize;
+	sharedMapping = std::move(other.sharedMapping);
+	path = std::move(other.path);
 	idx = other.idx;
 	error = other.error;
 	return *this;
 }
 
 fg::MappedGltfFile::~MappedGltfFile() noexcept {
+	if (sharedMapping != nullptr) {
+		// The mapping will be released once the last shared reference is destroyed.
+		return;
+	}
 #if defined(_WIN32)
 	if (mappedFile != nullptr) {
 		UnmapViewOfFile(mappedFile);
@@ -311,6 +343,39 @@ std::size_t fg::MappedGltfFile::bytesRead() {
 std::size_t fg::MappedGltfFile::totalSize() {
 	return fileSize;
 }
+
+std::shared_ptr<const std::byte> fg::MappedGltfFile::shareData() {
+#if defined(_WIN32)
+	if (mappedFile == nullptr)
+		return nullptr;
+#else
+	if (mappedFile == MAP_FAILED || mappedFile == nullptr)
+		return nullptr;
+#endif
+
+	if (sharedMapping == nullptr) {
+		// Transfer ownership of the mapping to the shared pointer, which unmaps the file once all
+		// references, including the ones held by assets, have been destroyed.
+#if defined(_WIN32)
+		sharedMapping = std::shared_ptr<const std::byte>(static_cast<const std::byte*>(mappedFile),
+				[mapping = fileMapping, handle = fileHandle](const std::byte* ptr) {
+			UnmapViewOfFile(ptr);
+			CloseHandle(mapping);
+			CloseHandle(handle);
+		});
+#else
+		sharedMapping = std::shared_ptr<const std::byte>(static_cast<const std::byte*>(mappedFile),
+				[size = fileSize](const std::byte* ptr) {
+			munmap(const_cast<std::byte*>(ptr), size);
+		});
+#endif
+	}
+	return sharedMapping;
+}
+
+fs::path fg::MappedGltfFile::filePath() {
+	return path;
+}
 #endif // FASTGLTF_HAS_MEMORY_MAPPED_FILE
 
 #pragma region AndroidGltfDataBuffer
@@ -368,6 +433,199 @@ fg::AndroidGltfDataBuffer::AndroidGltfDataBuffer(const fs::path& path, std::uint
 #pragma endregion
 #pragma endregion
 
+#pragma region glTF file writing
+#if defined(__APPLE__) || defined(__linux__)
+fg::GltfFileSink::GltfFileSink(const fs::path& path) {
+	fileDescriptor = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+}
+
+fg::GltfFileSink::~GltfFileSink() noexcept {
+	if (fileDescriptor >= 0) {
+		close(fileDescriptor);
+	}
+}
+
+bool fg::GltfFileSink::isOpen() const {
+	return fileDescriptor >= 0;
+}
+
+bool fg::GltfFileSink::write(span<const span<const std::byte>> chunks) {
+	if (fileDescriptor < 0)
+		return false;
+
+	// writev may write less than requested, for example because Linux limits each call to
+	// roughly 2GB, so we advance through the vectors until everything has been written.
+	std::vector<iovec> vectors;
+	vectors.reserve(chunks.size());
+	for (const auto& chunk : chunks) {
+		if (!chunk.empty())
+			vectors.push_back({ const_cast<std::byte*>(chunk.data()), chunk.size() });
+	}
+
+	std::size_t first = 0;
+	while (first < vectors.size()) {
+		const auto count = static_cast<int>(fastgltf::min(vectors.size() - first, static_cast<std::size_t>(IOV_MAX)));
+		const auto written = writev(fileDescriptor, &vectors[first], count);
+		if (written < 0) {
+			if (errno == EINTR)
+				continue;
+			return false;
+		}
+
+		auto remaining = static_cast<std::size_t>(written);
+		while (first < vectors.size() && remaining >= vectors[first].iov_len) {
+			remaining -= vectors[first].iov_len;
+			++first;
+		}
+		if (remaining > 0) {
+			vectors[first].iov_base = static_cast<std::byte*>(vectors[first].iov_base) + remaining;
+			vectors[first].iov_len -= remaining;
+		}
+	}
+	return true;
+}
+#else
+fg::GltfFileSink::GltfFileSink(const fs::path& path) : fileStream(path, std::ios::out | std::ios::binary | std::ios::trunc) {}
+
+fg::GltfFileSink::~GltfFileSink() noexcept = default;
+
+bool fg::GltfFileSink::isOpen() const {
+	return fileStream.is_open();
+}
+
+bool fg::GltfFileSink::write(span<const span<const std::byte>> chunks) {
+	for (const auto& chunk : chunks) {
+		fileStream.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+	}
+	return fileStream.good();
+}
+#endif
+#pragma endregion
+
+#pragma region External file cache
+struct fg::ExternalFileCache::Storage {
+	struct Entry {
+		File file;
+		fs::file_time_type lastWriteTime;
+	};
+
+	mutable std::mutex mutex;
+	std::unordered_map<fs::path::string_type, Entry> entries;
+	std::size_t hits = 0;
+	std::size_t misses = 0;
+	std::size_t residentBytes = 0;
+};
+
+namespace fastgltf {
+	/** Reads an entire file into memory which can be shared between assets, by mapping it if possible. */
+	Expected<ExternalFileCache::File> readSharedFile(const fs::path& path, std::size_t size) {
+#if defined(FASTGLTF_HAS_MEMORY_MAPPED_FILE)
+		// Empty files can't be mapped.
+		if (size != 0) {
+			if (auto mapped = MappedGltfFile::FromPath(path); mapped.error() == Error::None) {
+				if (auto data = mapped->shareData(); data != nullptr) {
+					return ExternalFileCache::File { std::move(data), size };
+				}
+			}
+		}
+#endif
+
+		std::ifstream file(path, std::ios::binary);
+		if (!file.is_open()) {
+			return Error::InvalidURI;
+		}
+
+		std::shared_ptr<std::byte[]> bytes(new(std::nothrow) std::byte[max<std::size_t>(size, 1)]);
+		if (bytes == nullptr) {
+			return Error::FileBufferAllocationFailed;
+		}
+		file.read(reinterpret_cast<char*>(bytes.get()), static_cast<std::streamsize>(size));
+		if (static_cast<std::size_t>(file.gcount()) != size) {
+			return Error::InvalidURI;
+		}
+
+		// Use the aliasing constructor to share ownership of the buffer.
+		return ExternalFileCache::File { std::shared_ptr<const std::byte>(bytes, bytes.get()), size };
+	}
+} // namespace fastgltf
+
+fg::ExternalFileCache::ExternalFileCache() : storage(std::make_unique<Storage>()) {}
+fg::ExternalFileCache::ExternalFileCache(ExternalFileCache&& other) noexcept = default;
+fg::ExternalFileCache& fg::ExternalFileCache::operator=(ExternalFileCache&& other) noexcept = default;
+fg::ExternalFileCache::~ExternalFileCache() = default;
+
+fg::Expected<fg::ExternalFileCache::File> fg::ExternalFileCache::load(const fs::path& path) {
+	std::error_code error;
+	auto canonicalPath = fs::canonical(path, error);
+	if (error) {
+		return Error::MissingExternalBuffer;
+	}
+
+	const auto size = static_cast<std::size_t>(fs::file_size(canonicalPath, error));
+	if (error) {
+		return Error::InvalidURI;
+	}
+	const auto lastWriteTime = fs::last_write_time(canonicalPath, error);
+	if (error) {
+		return Error::InvalidURI;
+	}
+
+	{
+		std::lock_guard lock(storage->mutex);
+		if (auto it = storage->entries.find(canonicalPath.native()); it != storage->entries.end()) {
+			if (it->second.file.size == size && it->second.lastWriteTime == lastWriteTime) {
+				++storage->hits;
+				return File(it->second.file);
+			}
+		}
+		++storage->misses;
+	}
+
+	// The file is read without holding the lock, so that other files can be loaded at the same time.
+	// If multiple threads miss the same file, the last one to finish replaces the others' entries,
+	// and the assets which got the other copies simply keep them alive on their own.
+	auto file = readSharedFile(canonicalPath, size);
+	if (file.error() != Error::None) {
+		return file.error();
+	}
+
+	std::lock_guard lock(storage->mutex);
+	auto& entry = storage->entries[canonicalPath.native()];
+	storage->residentBytes = storage->residentBytes - entry.file.size + size;
+	entry.file = File(file.get());
+	entry.lastWriteTime = lastWriteTime;
+	return file;
+}
+
+fg::ExternalFileCacheStatistics fg::ExternalFileCache::getStatistics() const {
+	std::lock_guard lock(storage->mutex);
+	return { storage->hits, storage->misses, storage->entries.size(), storage->residentBytes };
+}
+
+std::size_t fg::ExternalFileCache::trim() {
+	std::lock_guard lock(storage->mutex);
+	std::size_t releasedBytes = 0;
+	for (auto it = storage->entries.begin(); it != storage->entries.end();) {
+		// The cache holds the only reference once no asset uses the file anymore. As new references
+		// are only handed out while holding the lock, this can't change while iterating.
+		if (it->second.file.data.use_count() == 1) {
+			releasedBytes += it->second.file.size;
+			it = storage->entries.erase(it);
+		} else {
+			++it;
+		}
+	}
+	storage->residentBytes -= releasedBytes;
+	return releasedBytes;
+}
+
+void fg::ExternalFileCache::clear() {
+	std::lock_guard lock(storage->mutex);
+	storage->entries.clear();
+	storage->residentBytes = 0;
+}
+#pragma endregion
+
 #pragma region Parser I/O
 #if defined(__ANDROID__)
 fg::Expected<fg::DataSource> fg::Parser::loadFileFromApk(const fs::path& path) const noexcept {
@@ -404,7 +662,7 @@ fg::Expected<fg::DataSource> fg::Parser::loadFileFromApk(const fs::path& path) c
 }
 #endif
 
-fg::Expected<fg::DataSource> fg::Parser::loadFileFromUri(URIView& uri) const noexcept {
+fg::Expected<fg::DataSource> fg::Parser::loadFileFromUri(URIView& uri, std::shared_ptr<const std::byte>& owner) const noexcept {
 	URI decodedUri(uri.path()); // Re-allocate so we can decode potential characters.
 	// JSON strings are always in UTF-8, so we can safely always use u8path here.
 	// Since u8path is deprecated with C++20 and newer, u8path is deprecated.
@@ -433,6 +691,15 @@ fg::Expected<fg::DataSource> fg::Parser::loadFileFromUri(URIView& uri) const noe
 	}
 #endif
 
+	if (config.fileCache != nullptr) {
+		auto file = config.fileCache->load(path);
+		if (file.error() != Error::None) {
+			return file.error();
+		}
+		owner = std::move(file->data);
+		return { sources::ByteView { span<const std::byte>(owner.get(), file->size), MimeType::None } };
+	}
+
 	// If we were instructed to load external buffers and the files don't exist, we'll return an error.
 	std::error_code error;
 	if (!fs::exists(path, error) || error) {
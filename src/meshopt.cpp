@@ -0,0 +1,970 @@
+/*
+ * Copyright (C) 2022 - 2025 Sean Apeler
+ * This file is part of fastgltf <https://github.com/spnda/fastgltf>.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#if !defined(__cplusplus) || (!defined(_MSVC_LANG) && __cplusplus < 201703L) || (defined(_MSVC_LANG) && _MSVC_LANG < 201703L)
+#error "fastgltf requires C++17"
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include <fastgltf/meshopt.hpp>
+
+#if FASTGLTF_ENABLE_MESHOPT_DECODER || FASTGLTF_ENABLE_MESHOPT_ENCODER
+
+namespace fg = fastgltf;
+
+namespace fastgltf::meshopt {
+	// The bitstreams are documented in the "Compressed data format" section of the extension specification.
+	constexpr std::uint8_t vertexHeader = 0xA0;
+	constexpr std::uint8_t indexHeader = 0xE0;
+	constexpr std::uint8_t sequenceHeader = 0xD0;
+
+	constexpr std::size_t byteGroupSize = 16;
+	// The largest amount of bytes a single byte group can occupy, including its header bits.
+	constexpr std::size_t byteGroupDecodeLimit = 24;
+	constexpr std::size_t vertexBlockSizeBytes = 8192;
+	constexpr std::size_t vertexBlockMaxSize = 256;
+	constexpr std::size_t tailMaxSize = 32;
+
+	template <typename T>
+	void writeLE(std::byte* destination, T value) noexcept {
+		static_assert(std::is_integral_v<T>);
+		using U = std::make_unsigned_t<T>;
+		for (std::size_t i = 0; i < sizeof(T); ++i) {
+			destination[i] = static_cast<std::byte>(static_cast<U>(value) >> (i * 8));
+		}
+	}
+
+	template <typename T>
+	T readLE(const std::byte* source) noexcept {
+		static_assert(std::is_integral_v<T>);
+		using U = std::make_unsigned_t<T>;
+		U value = 0;
+		for (std::size_t i = 0; i < sizeof(T); ++i) {
+			value |= static_cast<U>(static_cast<U>(source[i]) << (i * 8));
+		}
+		return static_cast<T>(value);
+	}
+} // namespace fastgltf::meshopt
+
+#if FASTGLTF_ENABLE_MESHOPT_DECODER
+namespace fastgltf::meshopt {
+	[[nodiscard]] constexpr std::uint8_t unzigzag8(std::uint8_t v) noexcept {
+		return static_cast<std::uint8_t>(-(v & 1) ^ (v >> 1));
+	}
+
+	/** Decodes a group of 16 bytes, each using 1 << bitsLog2 bits, returning the pointer past the data it consumed. */
+	const std::uint8_t* decodeBytesGroup(const std::uint8_t* data, std::uint8_t* buffer, unsigned bitsLog2) noexcept {
+		switch (bitsLog2) {
+			case 0:
+				std::memset(buffer, 0, byteGroupSize);
+				return data;
+			case 1:
+			case 2: {
+				// The values are packed starting at the most significant bits. A value with all bits set
+				// means that the actual value is stored as a full byte after the packed values.
+				const unsigned bits = 1U << bitsLog2;
+				const unsigned sentinel = (1U << bits) - 1;
+				const unsigned valuesPerByte = 8 / bits;
+				const auto* extra = data + byteGroupSize / valuesPerByte;
+				for (std::size_t i = 0; i < byteGroupSize; ++i) {
+					const unsigned shift = 8 - bits * (1 + static_cast<unsigned>(i % valuesPerByte));
+					const unsigned value = (data[i / valuesPerByte] >> shift) & sentinel;
+					buffer[i] = value == sentinel ? *extra++ : static_cast<std::uint8_t>(value);
+				}
+				return extra;
+			}
+			default:
+				std::memcpy(buffer, data, byteGroupSize);
+				return data + byteGroupSize;
+		}
+	}
+
+	const std::uint8_t* decodeBytes(const std::uint8_t* data, const std::uint8_t* dataEnd, std::uint8_t* buffer, std::size_t size) noexcept {
+		// Every group of 16 bytes uses two header bits for its bit width.
+		const auto headerSize = (size / byteGroupSize + 3) / 4;
+		if (static_cast<std::size_t>(dataEnd - data) < headerSize)
+			return nullptr;
+
+		const auto* header = data;
+		data += headerSize;
+		for (std::size_t i = 0; i < size; i += byteGroupSize) {
+			if (static_cast<std::size_t>(dataEnd - data) < byteGroupDecodeLimit)
+				return nullptr;
+
+			const auto headerOffset = i / byteGroupSize;
+			const auto bitsLog2 = (header[headerOffset / 4] >> ((headerOffset % 4) * 2)) & 3;
+			data = decodeBytesGroup(data, buffer + i, bitsLog2);
+		}
+		return data;
+	}
+
+	unsigned decodeVByte(const std::uint8_t*& data) noexcept {
+		const auto lead = *data++;
+		if (lead < 128)
+			return lead;
+
+		// Values are stored in up to five 7-bit groups, with the top bit marking a continuation.
+		unsigned result = lead & 127;
+		unsigned shift = 7;
+		for (std::size_t i = 0; i < 4; ++i) {
+			const auto group = *data++;
+			result |= static_cast<unsigned>(group & 127) << shift;
+			shift += 7;
+			if (group < 128)
+				break;
+		}
+		return result;
+	}
+
+	unsigned decodeIndex(const std::uint8_t*& data, unsigned last) noexcept {
+		const auto v = decodeVByte(data);
+		const auto delta = (v >> 1) ^ (0U - (v & 1));
+		return last + delta;
+	}
+
+	void writeIndex(std::byte* destination, std::size_t index, std::size_t indexSize, unsigned value) noexcept {
+		if (indexSize == sizeof(std::uint16_t)) {
+			writeLE(destination + index * sizeof(std::uint16_t), static_cast<std::uint16_t>(value));
+		} else {
+			writeLE(destination + index * sizeof(std::uint32_t), static_cast<std::uint32_t>(value));
+		}
+	}
+
+	template <typename T>
+	void decodeOctahedralFilter(std::byte* data, std::size_t count) noexcept {
+		const auto max = static_cast<float>((1 << (sizeof(T) * 8 - 1)) - 1);
+		for (std::size_t i = 0; i < count; ++i) {
+			auto* element = data + i * 4 * sizeof(T);
+
+			// Reconstruct z, which assumes that the encoded z component holds 1.0 at the same bit count.
+			auto x = static_cast<float>(readLE<T>(element));
+			auto y = static_cast<float>(readLE<T>(element + sizeof(T)));
+			const auto z = static_cast<float>(readLE<T>(element + 2 * sizeof(T))) - std::fabs(x) - std::fabs(y);
+
+			// Fix up the octahedral coordinates for z < 0.
+			const auto t = z >= 0.0f ? 0.0f : z;
+			x += x >= 0.0f ? t : -t;
+			y += y >= 0.0f ? t : -t;
+
+			const auto scale = max / std::sqrt(x * x + y * y + z * z);
+			writeLE(element, static_cast<T>(static_cast<int>(x * scale + (x >= 0.0f ? 0.5f : -0.5f))));
+			writeLE(element + sizeof(T), static_cast<T>(static_cast<int>(y * scale + (y >= 0.0f ? 0.5f : -0.5f))));
+			writeLE(element + 2 * sizeof(T), static_cast<T>(static_cast<int>(z * scale + (z >= 0.0f ? 0.5f : -0.5f))));
+		}
+	}
+
+	void decodeQuaternionFilter(std::byte* data, std::size_t count) noexcept {
+		const auto scale = 1.0f / std::sqrt(2.0f);
+		for (std::size_t i = 0; i < count; ++i) {
+			auto* element = data + i * 4 * sizeof(std::int16_t);
+
+			// The lowest two bits of the last component hold the index of the largest component,
+			// which we reconstruct. The remaining bits store the scale of the other components.
+			const auto last = readLE<std::int16_t>(element + 3 * sizeof(std::int16_t));
+			const auto componentScale = scale / static_cast<float>(last | 3);
+
+			const auto x = static_cast<float>(readLE<std::int16_t>(element)) * componentScale;
+			const auto y = static_cast<float>(readLE<std::int16_t>(element + sizeof(std::int16_t))) * componentScale;
+			const auto z = static_cast<float>(readLE<std::int16_t>(element + 2 * sizeof(std::int16_t))) * componentScale;
+
+			// We clamp to 0 to avoid NaNs due to precision errors.
+			const auto ww = 1.0f - x * x - y * y - z * z;
+			const auto w = std::sqrt(ww >= 0.0f ? ww : 0.0f);
+
+			const auto largest = static_cast<unsigned>(last & 3);
+			auto write = [&](unsigned component, float value, float rounding) {
+				writeLE(element + ((largest + component) & 3) * sizeof(std::int16_t),
+						static_cast<std::int16_t>(static_cast<int>(value * 32767.0f + rounding)));
+			};
+			write(1, x, x >= 0.0f ? 0.5f : -0.5f);
+			write(2, y, y >= 0.0f ? 0.5f : -0.5f);
+			write(3, z, z >= 0.0f ? 0.5f : -0.5f);
+			write(0, w, 0.5f);
+		}
+	}
+
+	void decodeExponentialFilter(std::byte* data, std::size_t count) noexcept {
+		for (std::size_t i = 0; i < count; ++i) {
+			auto* element = data + i * sizeof(std::uint32_t);
+			const auto value = readLE<std::uint32_t>(element);
+
+			// The top 8 bits are a signed exponent, and the remaining 24 bits a signed mantissa.
+			const auto mantissa = static_cast<std::int32_t>(value << 8) >> 8;
+			const auto exponent = static_cast<std::int32_t>(value) >> 24;
+
+			// This is equivalent to std::ldexp(float(mantissa), exponent).
+			const auto power = bit_cast<float>(static_cast<std::uint32_t>(exponent + 127) << 23);
+			writeLE(element, bit_cast<std::uint32_t>(power * static_cast<float>(mantissa)));
+		}
+	}
+} // namespace fastgltf::meshopt
+
+bool fg::meshopt::decodeVertexBuffer(std::byte* destination, std::size_t count, std::size_t byteStride,
+		span<const std::byte> source) noexcept {
+	if (byteStride == 0 || byteStride > vertexBlockMaxSize || byteStride % 4 != 0)
+		return false;
+
+	const auto* data = reinterpret_cast<const std::uint8_t*>(source.data());
+	const auto* dataEnd = data + source.size();
+	if (source.size() < 1 || (data[0] & 0xF0) != vertexHeader || (data[0] & 0x0F) != 0)
+		return false;
+	++data;
+
+	// The tail holds the first element, which is used as the initial prediction, and is padded to
+	// make sure that the byte groups can always read their maximum size.
+	const auto tailSize = max(byteStride, tailMaxSize);
+	if (static_cast<std::size_t>(dataEnd - data) < tailSize)
+		return false;
+
+	std::array<std::uint8_t, vertexBlockMaxSize> lastVertex {};
+	std::memcpy(lastVertex.data(), dataEnd - byteStride, byteStride);
+
+	auto* output = reinterpret_cast<std::uint8_t*>(destination);
+	const auto blockSize = min((vertexBlockSizeBytes / byteStride) & ~(byteGroupSize - 1), vertexBlockMaxSize);
+	std::array<std::uint8_t, vertexBlockMaxSize> buffer {};
+	for (std::size_t offset = 0; offset < count; offset += blockSize) {
+		const auto blockCount = min(blockSize, count - offset);
+		const auto alignedCount = (blockCount + byteGroupSize - 1) & ~(byteGroupSize - 1);
+
+		// Each byte of the elements is stored as its own stream of deltas.
+		for (std::size_t k = 0; k < byteStride; ++k) {
+			data = decodeBytes(data, dataEnd, buffer.data(), alignedCount);
+			if (data == nullptr)
+				return false;
+
+			auto previous = lastVertex[k];
+			for (std::size_t i = 0; i < blockCount; ++i) {
+				const auto value = static_cast<std::uint8_t>(unzigzag8(buffer[i]) + previous);
+				output[(offset + i) * byteStride + k] = value;
+				previous = value;
+			}
+		}
+
+		std::memcpy(lastVertex.data(), output + (offset + blockCount - 1) * byteStride, byteStride);
+	}
+
+	return static_cast<std::size_t>(dataEnd - data) == tailSize;
+}
+
+bool fg::meshopt::decodeIndexBuffer(std::byte* destination, std::size_t count, std::size_t indexSize,
+		span<const std::byte> source) noexcept {
+	if (count % 3 != 0 || (indexSize != sizeof(std::uint16_t) && indexSize != sizeof(std::uint32_t)))
+		return false;
+
+	// The data consists of the header, one code byte per triangle, the variable-length data, and a 16-byte table.
+	if (source.size() < 1 + count / 3 + 16)
+		return false;
+
+	const auto* buffer = reinterpret_cast<const std::uint8_t*>(source.data());
+	if ((buffer[0] & 0xF0) != indexHeader)
+		return false;
+	const auto version = buffer[0] & 0x0F;
+	if (version > 1)
+		return false;
+
+	std::array<std::array<unsigned, 2>, 16> edgeFifo {};
+	std::array<unsigned, 16> vertexFifo {};
+	for (auto& edge : edgeFifo)
+		edge = { ~0U, ~0U };
+	vertexFifo.fill(~0U);
+	std::size_t edgeFifoOffset = 0;
+	std::size_t vertexFifoOffset = 0;
+
+	auto pushEdge = [&](unsigned a, unsigned b) {
+		edgeFifo[edgeFifoOffset] = { a, b };
+		edgeFifoOffset = (edgeFifoOffset + 1) & 15;
+	};
+	auto pushVertex = [&](unsigned v, bool condition = true) {
+		vertexFifo[vertexFifoOffset] = v;
+		vertexFifoOffset = (vertexFifoOffset + (condition ? 1 : 0)) & 15;
+	};
+
+	unsigned next = 0;
+	unsigned last = 0;
+	const unsigned fecMax = version >= 1 ? 13 : 15;
+
+	const auto* code = buffer + 1;
+	const auto* data = code + count / 3;
+	const auto* dataSafeEnd = buffer + source.size() - 16;
+	const auto* codeauxTable = dataSafeEnd;
+
+	for (std::size_t i = 0; i < count; i += 3) {
+		// Each triangle reads at most 16 bytes of data.
+		if (data > dataSafeEnd)
+			return false;
+
+		const auto codetri = *code++;
+		if (codetri < 0xF0) {
+			// The triangle shares an edge with one of the recent triangles.
+			const auto& edge = edgeFifo[(edgeFifoOffset - 1 - (codetri >> 4)) & 15];
+			const auto a = edge[0];
+			const auto b = edge[1];
+
+			const unsigned fec = codetri & 15;
+			if (fec < fecMax) {
+				const auto c = fec == 0 ? next : vertexFifo[(vertexFifoOffset - 1 - fec) & 15];
+				next += fec == 0 ? 1 : 0;
+
+				writeIndex(destination, i + 0, indexSize, a);
+				writeIndex(destination, i + 1, indexSize, b);
+				writeIndex(destination, i + 2, indexSize, c);
+				pushVertex(c, fec == 0);
+				pushEdge(c, b);
+				pushEdge(a, c);
+			} else {
+				// 13 and 14 encode -1 and +1 from the last free index, and 15 an explicit delta.
+				const auto c = last = fec != 15 ? last + (fec - (fec ^ 3)) : decodeIndex(data, last);
+
+				writeIndex(destination, i + 0, indexSize, a);
+				writeIndex(destination, i + 1, indexSize, b);
+				writeIndex(destination, i + 2, indexSize, c);
+				pushVertex(c);
+				pushEdge(c, b);
+				pushEdge(a, c);
+			}
+		} else {
+			unsigned a, b, c;
+			unsigned feb, fec;
+			if (codetri < 0xFE) {
+				// The first vertex is always the next one, and the others are looked up through the table.
+				const auto codeaux = codeauxTable[codetri & 15];
+				feb = codeaux >> 4;
+				fec = codeaux & 15;
+
+				a = next++;
+				b = feb == 0 ? next++ : vertexFifo[(vertexFifoOffset - feb) & 15];
+				c = fec == 0 ? next++ : vertexFifo[(vertexFifoOffset - fec) & 15];
+			} else {
+				const auto codeaux = *data++;
+				const unsigned fea = codetri == 0xFE ? 0 : 15;
+				feb = codeaux >> 4;
+				fec = codeaux & 15;
+
+				// A zero codeaux in this form resets the next index.
+				if (codeaux == 0)
+					next = 0;
+
+				a = fea == 0 ? next++ : 0;
+				b = feb == 0 ? next++ : vertexFifo[(vertexFifoOffset - feb) & 15];
+				c = fec == 0 ? next++ : vertexFifo[(vertexFifoOffset - fec) & 15];
+
+				if (fea == 15)
+					last = a = decodeIndex(data, last);
+				if (feb == 15)
+					last = b = decodeIndex(data, last);
+				if (fec == 15)
+					last = c = decodeIndex(data, last);
+			}
+
+			writeIndex(destination, i + 0, indexSize, a);
+			writeIndex(destination, i + 1, indexSize, b);
+			writeIndex(destination, i + 2, indexSize, c);
+			pushVertex(a);
+			pushVertex(b, feb == 0 || feb == 15);
+			pushVertex(c, fec == 0 || fec == 15);
+			pushEdge(b, a);
+			pushEdge(c, b);
+			pushEdge(a, c);
+		}
+	}
+
+	// All data has to be consumed exactly up to the codeaux table.
+	return data == dataSafeEnd;
+}
+
+bool fg::meshopt::decodeIndexSequence(std::byte* destination, std::size_t count, std::size_t indexSize,
+		span<const std::byte> source) noexcept {
+	if (indexSize != sizeof(std::uint16_t) && indexSize != sizeof(std::uint32_t))
+		return false;
+
+	// The shortest valid encoding is the header, a byte per index, and a 4-byte tail.
+	if (source.size() < 1 + count + 4)
+		return false;
+
+	const auto* buffer = reinterpret_cast<const std::uint8_t*>(source.data());
+	// Both versions 0 and 1 use the same encoding, and the extension requires version 1.
+	if ((buffer[0] & 0xF0) != sequenceHeader || (buffer[0] & 0x0F) > 1)
+		return false;
+
+	const auto* data = buffer + 1;
+	const auto* dataSafeEnd = buffer + source.size() - 4;
+
+	// Every index is a delta to one of two baselines, selected by the lowest bit.
+	std::array<unsigned, 2> last {};
+	for (std::size_t i = 0; i < count; ++i) {
+		if (data >= dataSafeEnd)
+			return false;
+
+		auto v = decodeVByte(data);
+		const auto current = v & 1;
+		v >>= 1;
+
+		const auto delta = (v >> 1) ^ (0U - (v & 1));
+		const auto index = last[current] + delta;
+		last[current] = index;
+		writeIndex(destination, i, indexSize, index);
+	}
+
+	return data == dataSafeEnd;
+}
+
+bool fg::meshopt::decodeFilter(MeshoptCompressionFilter filter, std::byte* data, std::size_t count, std::size_t byteStride) noexcept {
+	switch (filter) {
+		case MeshoptCompressionFilter::None:
+			return true;
+		case MeshoptCompressionFilter::Octahedral: {
+			if (byteStride == 4) {
+				decodeOctahedralFilter<std::int8_t>(data, count);
+			} else if (byteStride == 8) {
+				decodeOctahedralFilter<std::int16_t>(data, count);
+			} else {
+				return false;
+			}
+			return true;
+		}
+		case MeshoptCompressionFilter::Quaternion: {
+			if (byteStride != 8)
+				return false;
+			decodeQuaternionFilter(data, count);
+			return true;
+		}
+		case MeshoptCompressionFilter::Exponential: {
+			if (byteStride % 4 != 0)
+				return false;
+			decodeExponentialFilter(data, count * (byteStride / 4));
+			return true;
+		}
+	}
+	return false;
+}
+
+bool fg::meshopt::decode(const CompressedBufferView& compression, span<const std::byte> compressedBuffer,
+		std::byte* destination) noexcept {
+	if (compression.byteOffset > compressedBuffer.size() || compression.byteLength > compressedBuffer.size() - compression.byteOffset)
+		return false;
+
+	const auto source = compressedBuffer.subspan(compression.byteOffset, compression.byteLength);
+	switch (compression.mode) {
+		case MeshoptCompressionMode::Attributes: {
+			if (!decodeVertexBuffer(destination, compression.count, compression.byteStride, source))
+				return false;
+			return decodeFilter(compression.filter, destination, compression.count, compression.byteStride);
+		}
+		case MeshoptCompressionMode::Triangles: {
+			if (compression.filter != MeshoptCompressionFilter::None)
+				return false;
+			return decodeIndexBuffer(destination, compression.count, compression.byteStride, source);
+		}
+		case MeshoptCompressionMode::Indices: {
+			if (compression.filter != MeshoptCompressionFilter::None)
+				return false;
+			return decodeIndexSequence(destination, compression.count, compression.byteStride, source);
+		}
+	}
+	return false;
+}
+
+#endif // FASTGLTF_ENABLE_MESHOPT_DECODER
+
+#if FASTGLTF_ENABLE_MESHOPT_ENCODER
+namespace fastgltf::meshopt {
+	[[nodiscard]] constexpr std::uint8_t zigzag8(std::uint8_t v) noexcept {
+		return static_cast<std::uint8_t>((static_cast<std::int8_t>(v) >> 7) ^ (v << 1));
+	}
+
+	/** Returns the size of a group of 16 bytes with 1 << bitsLog2 bits each, or 0 bits if bitsLog2 is 0. */
+	std::size_t measureBytesGroup(const std::uint8_t* buffer, unsigned bitsLog2) noexcept {
+		switch (bitsLog2) {
+			case 0:
+				for (std::size_t i = 0; i < byteGroupSize; ++i) {
+					if (buffer[i] != 0)
+						return std::numeric_limits<std::size_t>::max();
+				}
+				return 0;
+			case 1:
+			case 2: {
+				// Every value which doesn't fit into the bits is stored as an additional full byte.
+				const unsigned bits = 1U << bitsLog2;
+				const unsigned sentinel = (1U << bits) - 1;
+				std::size_t size = byteGroupSize * bits / 8;
+				for (std::size_t i = 0; i < byteGroupSize; ++i) {
+					size += buffer[i] >= sentinel ? 1 : 0;
+				}
+				return size;
+			}
+			default:
+				return byteGroupSize;
+		}
+	}
+
+	/** Encodes a group of 16 bytes, each using 1 << bitsLog2 bits, returning the pointer past the data it wrote. */
+	std::uint8_t* encodeBytesGroup(std::uint8_t* data, const std::uint8_t* buffer, unsigned bitsLog2) noexcept {
+		switch (bitsLog2) {
+			case 0:
+				return data;
+			case 1:
+			case 2: {
+				// The values are packed starting at the most significant bits, as decodeBytesGroup expects.
+				const unsigned bits = 1U << bitsLog2;
+				const unsigned sentinel = (1U << bits) - 1;
+				const unsigned valuesPerByte = 8 / bits;
+				for (std::size_t i = 0; i < byteGroupSize; i += valuesPerByte) {
+					unsigned packed = 0;
+					for (std::size_t k = 0; k < valuesPerByte; ++k) {
+						packed = (packed << bits) | min<unsigned>(buffer[i + k], sentinel);
+					}
+					*data++ = static_cast<std::uint8_t>(packed);
+				}
+				for (std::size_t i = 0; i < byteGroupSize; ++i) {
+					if (buffer[i] >= sentinel)
+						*data++ = buffer[i];
+				}
+				return data;
+			}
+			default:
+				std::memcpy(data, buffer, byteGroupSize);
+				return data + byteGroupSize;
+		}
+	}
+
+	std::uint8_t* encodeBytes(std::uint8_t* data, const std::uint8_t* buffer, std::size_t size) noexcept {
+		const auto headerSize = (size / byteGroupSize + 3) / 4;
+		auto* header = data;
+		std::memset(header, 0, headerSize);
+		data += headerSize;
+
+		for (std::size_t i = 0; i < size; i += byteGroupSize) {
+			// Pick the smallest bit width for every group, preferring the smaller widths for equal sizes.
+			unsigned bestBitsLog2 = 3;
+			auto bestSize = byteGroupSize;
+			for (unsigned bitsLog2 = 0; bitsLog2 < 3; ++bitsLog2) {
+				const auto groupSize = measureBytesGroup(buffer + i, bitsLog2);
+				if (groupSize < bestSize) {
+					bestBitsLog2 = bitsLog2;
+					bestSize = groupSize;
+				}
+			}
+
+			const auto headerOffset = i / byteGroupSize;
+			header[headerOffset / 4] |= static_cast<std::uint8_t>(bestBitsLog2 << ((headerOffset % 4) * 2));
+			data = encodeBytesGroup(data, buffer + i, bestBitsLog2);
+		}
+		return data;
+	}
+
+	void encodeVByte(std::uint8_t*& data, unsigned value) noexcept {
+		do {
+			*data++ = static_cast<std::uint8_t>((value & 127) | (value > 127 ? 128 : 0));
+			value >>= 7;
+		} while (value != 0);
+	}
+
+	[[nodiscard]] constexpr unsigned zigzag(unsigned delta) noexcept {
+		return (delta << 1) ^ (0U - (delta >> 31));
+	}
+
+	unsigned readIndex(const std::byte* source, std::size_t index, std::size_t indexSize) noexcept {
+		if (indexSize == sizeof(std::uint16_t))
+			return readLE<std::uint16_t>(source + index * sizeof(std::uint16_t));
+		return readLE<std::uint32_t>(source + index * sizeof(std::uint32_t));
+	}
+
+	// The table of the most common combinations of FIFO indices for the second and third vertex of a triangle
+	// which does not share an edge with a recent triangle. It is stored at the end of every index buffer.
+	constexpr std::array<std::uint8_t, 16> codeauxTable = {
+		0x00, 0x76, 0x87, 0x56, 0x67, 0x78, 0xA9, 0x86, 0x65, 0x89, 0x68, 0x98, 0x01, 0x69, 0x00, 0x00,
+	};
+
+	[[nodiscard]] int quantizeSnorm(float value, unsigned bits) noexcept {
+		const auto scale = static_cast<float>((1 << (bits - 1)) - 1);
+		value = value >= -1.0f ? (value <= 1.0f ? value : 1.0f) : -1.0f;
+		return static_cast<int>(value * scale + (value >= 0.0f ? 0.5f : -0.5f));
+	}
+
+	[[nodiscard]] float readFloat(const std::byte* source) noexcept {
+		return bit_cast<float>(readLE<std::uint32_t>(source));
+	}
+
+	template <typename T>
+	void encodeOctahedralFilter(std::byte* destination, const std::byte* source, std::size_t count, std::size_t componentCount, unsigned bits) noexcept {
+		for (std::size_t i = 0; i < count; ++i) {
+			const auto* element = source + i * componentCount * sizeof(float);
+			auto x = readFloat(element);
+			auto y = readFloat(element + sizeof(float));
+			const auto z = readFloat(element + 2 * sizeof(float));
+			const auto w = componentCount == 4 ? readFloat(element + 3 * sizeof(float)) : 0.0f;
+
+			// Project the vector onto the octahedron, and fold the lower half over for z < 0.
+			const auto length = std::fabs(x) + std::fabs(y) + std::fabs(z);
+			const auto scale = length == 0.0f ? 0.0f : 1.0f / length;
+			x *= scale;
+			y *= scale;
+			const auto u = z >= 0.0f ? x : (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+			const auto v = z >= 0.0f ? y : (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+
+			// The third component stores 1.0 at the same bit count, from which the decoder derives the precision.
+			auto* output = destination + i * 4 * sizeof(T);
+			writeLE(output, static_cast<T>(quantizeSnorm(u, bits)));
+			writeLE(output + sizeof(T), static_cast<T>(quantizeSnorm(v, bits)));
+			writeLE(output + 2 * sizeof(T), static_cast<T>(quantizeSnorm(1.0f, bits)));
+			writeLE(output + 3 * sizeof(T), static_cast<T>(quantizeSnorm(w, sizeof(T) * 8)));
+		}
+	}
+
+	void encodeQuaternionFilter(std::byte* destination, const std::byte* source, std::size_t count, unsigned bits) noexcept {
+		const auto scale = std::sqrt(2.0f);
+		for (std::size_t i = 0; i < count; ++i) {
+			const auto* element = source + i * 4 * sizeof(float);
+			const std::array<float, 4> q = {
+				readFloat(element), readFloat(element + sizeof(float)),
+				readFloat(element + 2 * sizeof(float)), readFloat(element + 3 * sizeof(float)),
+			};
+
+			// The largest component is dropped and reconstructed by the decoder. As q and -q are the same
+			// rotation, the sign is chosen so that the largest component is positive.
+			unsigned largest = 0;
+			for (unsigned c = 1; c < 4; ++c) {
+				if (std::fabs(q[c]) > std::fabs(q[largest]))
+					largest = c;
+			}
+			const auto sign = q[largest] < 0.0f ? -1.0f : 1.0f;
+
+			auto* output = destination + i * 4 * sizeof(std::int16_t);
+			for (unsigned c = 0; c < 3; ++c) {
+				writeLE(output + c * sizeof(std::int16_t),
+						static_cast<std::int16_t>(quantizeSnorm(q[(largest + 1 + c) & 3] * scale * sign, bits)));
+			}
+			writeLE(output + 3 * sizeof(std::int16_t),
+					static_cast<std::int16_t>((quantizeSnorm(1.0f, bits) & ~3) | static_cast<int>(largest)));
+		}
+	}
+
+	void encodeExponentialFilter(std::byte* destination, const std::byte* source, std::size_t count, unsigned bits) noexcept {
+		constexpr auto mantissaLimit = static_cast<float>((1 << 23) - 1);
+		for (std::size_t i = 0; i < count; ++i) {
+			const auto value = readFloat(source + i * sizeof(float));
+
+			// Choose the exponent so that the mantissa uses the requested bits. It is clamped so that the
+			// decoder can build the power of two as a normal float, which flushes tiny values to zero.
+			const auto valueBits = bit_cast<std::uint32_t>(value);
+			auto exponent = (valueBits & 0x7FFFFFFFU) == 0 ? 0 : static_cast<int>((valueBits >> 23) & 0xFF) - 127 + 1;
+			exponent -= static_cast<int>(bits) - 1;
+			exponent = exponent < -100 ? -100 : (exponent > 100 ? 100 : exponent);
+
+			const auto power = bit_cast<float>(static_cast<std::uint32_t>(127 - exponent) << 23);
+			auto mantissa = value * power;
+			mantissa = mantissa >= -mantissaLimit ? (mantissa <= mantissaLimit ? mantissa : mantissaLimit) : -mantissaLimit;
+			const auto rounded = static_cast<std::int32_t>(mantissa + (mantissa >= 0.0f ? 0.5f : -0.5f));
+
+			writeLE(destination + i * sizeof(std::uint32_t),
+					(static_cast<std::uint32_t>(exponent) << 24) | (static_cast<std::uint32_t>(rounded) & 0xFFFFFFU));
+		}
+	}
+} // namespace fastgltf::meshopt
+
+std::size_t fg::meshopt::encodeVertexBufferBound(std::size_t count, std::size_t byteStride) noexcept {
+	if (byteStride == 0 || byteStride > vertexBlockMaxSize || byteStride % 4 != 0)
+		return 0;
+
+	// Every block stores a header and at most one full byte per element for each byte of the stride.
+	const auto blockSize = min((vertexBlockSizeBytes / byteStride) & ~(byteGroupSize - 1), vertexBlockMaxSize);
+	const auto blockHeaderSize = (blockSize / byteGroupSize + 3) / 4;
+	const auto blockCount = (count + blockSize - 1) / blockSize;
+	return 1 + blockCount * byteStride * (blockHeaderSize + blockSize) + max(byteStride, tailMaxSize);
+}
+
+std::size_t fg::meshopt::encodeVertexBuffer(std::byte* destination, const std::byte* source, std::size_t count,
+		std::size_t byteStride) noexcept {
+	if (byteStride == 0 || byteStride > vertexBlockMaxSize || byteStride % 4 != 0)
+		return 0;
+
+	auto* data = reinterpret_cast<std::uint8_t*>(destination);
+	const auto* input = reinterpret_cast<const std::uint8_t*>(source);
+	*data++ = vertexHeader;
+
+	// The first element is the initial prediction, and is stored in the tail for the decoder.
+	std::array<std::uint8_t, vertexBlockMaxSize> firstVertex {};
+	if (count != 0)
+		std::memcpy(firstVertex.data(), input, byteStride);
+	auto lastVertex = firstVertex;
+
+	const auto blockSize = min((vertexBlockSizeBytes / byteStride) & ~(byteGroupSize - 1), vertexBlockMaxSize);
+	std::array<std::uint8_t, vertexBlockMaxSize> buffer {};
+	for (std::size_t offset = 0; offset < count; offset += blockSize) {
+		const auto blockCount = min(blockSize, count - offset);
+		const auto alignedCount = (blockCount + byteGroupSize - 1) & ~(byteGroupSize - 1);
+
+		// Each byte of the elements is stored as its own stream of deltas, padded with zeros to whole groups.
+		for (std::size_t k = 0; k < byteStride; ++k) {
+			auto previous = lastVertex[k];
+			for (std::size_t i = 0; i < blockCount; ++i) {
+				const auto value = input[(offset + i) * byteStride + k];
+				buffer[i] = zigzag8(static_cast<std::uint8_t>(value - previous));
+				previous = value;
+			}
+			std::memset(buffer.data() + blockCount, 0, alignedCount - blockCount);
+			data = encodeBytes(data, buffer.data(), alignedCount);
+		}
+
+		std::memcpy(lastVertex.data(), input + (offset + blockCount - 1) * byteStride, byteStride);
+	}
+
+	const auto tailSize = max(byteStride, tailMaxSize);
+	std::memset(data, 0, tailSize - byteStride);
+	data += tailSize - byteStride;
+	std::memcpy(data, firstVertex.data(), byteStride);
+	data += byteStride;
+	return static_cast<std::size_t>(data - reinterpret_cast<std::uint8_t*>(destination));
+}
+
+std::size_t fg::meshopt::encodeIndexBufferBound(std::size_t count) noexcept {
+	// Every triangle needs a code byte, and at most a codeaux byte and three indices of five bytes each.
+	return 1 + count / 3 + (count / 3) * 16 + codeauxTable.size();
+}
+
+std::size_t fg::meshopt::encodeIndexBuffer(std::byte* destination, const std::byte* source, std::size_t count,
+		std::size_t indexSize) noexcept {
+	if (count % 3 != 0 || (indexSize != sizeof(std::uint16_t) && indexSize != sizeof(std::uint32_t)))
+		return 0;
+
+	auto* buffer = reinterpret_cast<std::uint8_t*>(destination);
+	buffer[0] = indexHeader | 1;
+
+	// The FIFOs have to be kept exactly like the decoder keeps them.
+	std::array<std::array<unsigned, 2>, 16> edgeFifo {};
+	std::array<unsigned, 16> vertexFifo {};
+	for (auto& edge : edgeFifo)
+		edge = { ~0U, ~0U };
+	vertexFifo.fill(~0U);
+	std::size_t edgeFifoOffset = 0;
+	std::size_t vertexFifoOffset = 0;
+
+	auto pushEdge = [&](unsigned a, unsigned b) {
+		edgeFifo[edgeFifoOffset] = { a, b };
+		edgeFifoOffset = (edgeFifoOffset + 1) & 15;
+	};
+	auto pushVertex = [&](unsigned v, bool condition = true) {
+		vertexFifo[vertexFifoOffset] = v;
+		vertexFifoOffset = (vertexFifoOffset + (condition ? 1 : 0)) & 15;
+	};
+	// Returns the age of the edge shared with the triangle, shifted left by two and combined with the
+	// rotation which makes the edge the first one of the triangle, or -1.
+	auto findEdge = [&](const std::array<unsigned, 3>& triangle) -> int {
+		for (unsigned i = 0; i < 16; ++i) {
+			const auto& edge = edgeFifo[(edgeFifoOffset - 1 - i) & 15];
+			for (unsigned rotation = 0; rotation < 3; ++rotation) {
+				if (edge[0] == triangle[rotation] && edge[1] == triangle[(rotation + 1) % 3])
+					return static_cast<int>((i << 2) | rotation);
+			}
+		}
+		return -1;
+	};
+	auto findVertex = [&](unsigned v) -> int {
+		for (unsigned i = 0; i < 16; ++i) {
+			if (vertexFifo[(vertexFifoOffset - 1 - i) & 15] == v)
+				return static_cast<int>(i);
+		}
+		return -1;
+	};
+
+	unsigned next = 0;
+	unsigned last = 0;
+	constexpr unsigned fecMax = 13;
+
+	auto* code = buffer + 1;
+	auto* data = code + count / 3;
+	auto encodeIndex = [&](unsigned index) {
+		encodeVByte(data, zigzag(index - last));
+		last = index;
+	};
+
+	for (std::size_t i = 0; i < count; i += 3) {
+		const std::array<unsigned, 3> triangle = {
+			readIndex(source, i, indexSize), readIndex(source, i + 1, indexSize), readIndex(source, i + 2, indexSize),
+		};
+
+		if (const auto edge = findEdge(triangle); edge >= 0 && (edge >> 2) < 15) {
+			// The triangle shares an edge with one of the recent triangles, and is rotated to start with it.
+			const auto rotation = static_cast<std::size_t>(edge & 3);
+			const auto a = triangle[rotation];
+			const auto b = triangle[(rotation + 1) % 3];
+			const auto c = triangle[(rotation + 2) % 3];
+
+			const auto fc = findVertex(c);
+			unsigned fec;
+			if (fc >= 1 && static_cast<unsigned>(fc) < fecMax) {
+				fec = static_cast<unsigned>(fc);
+			} else if (c == next) {
+				fec = 0;
+				++next;
+			} else if (c == last - 1) {
+				fec = 13;
+			} else if (c == last + 1) {
+				fec = 14;
+			} else {
+				fec = 15;
+			}
+
+			*code++ = static_cast<std::uint8_t>(((edge >> 2) << 4) | static_cast<int>(fec));
+			if (fec == 15) {
+				encodeIndex(c);
+			} else if (fec >= fecMax) {
+				last = c;
+			}
+
+			pushVertex(c, fec == 0 || fec >= fecMax);
+			pushEdge(c, b);
+			pushEdge(a, c);
+		} else {
+			// Rotate the triangle so that the next new vertex comes first, which it then encodes implicitly.
+			const std::size_t rotation = triangle[1] == next ? 1 : (triangle[2] == next ? 2 : 0);
+			const auto a = triangle[rotation];
+			const auto b = triangle[(rotation + 1) % 3];
+			const auto c = triangle[(rotation + 2) % 3];
+
+			const auto fb = findVertex(b);
+			const auto fc = findVertex(c);
+			auto lookup = [&](int fifoIndex, unsigned v) -> unsigned {
+				if (fifoIndex >= 0 && fifoIndex < 14)
+					return static_cast<unsigned>(fifoIndex) + 1;
+				if (v == next) {
+					++next;
+					return 0;
+				}
+				return 15;
+			};
+			const unsigned fea = a == next ? (++next, 0) : 15;
+			const auto feb = lookup(fb, b);
+			const auto fec = lookup(fc, c);
+
+			const auto codeaux = static_cast<std::uint8_t>((feb << 4) | fec);
+			const auto* entry = std::find(codeauxTable.begin(), codeauxTable.begin() + 14, codeaux);
+			if (fea == 0 && entry != codeauxTable.begin() + 14) {
+				*code++ = static_cast<std::uint8_t>(0xF0 | (entry - codeauxTable.begin()));
+			} else {
+				// A zero codeaux resets the decoder, which can't happen here as the rotation moves the next
+				// vertex to the front.
+				*code++ = static_cast<std::uint8_t>(fea == 0 ? 0xFE : 0xFF);
+				*data++ = codeaux;
+			}
+
+			if (fea == 15)
+				encodeIndex(a);
+			if (feb == 15)
+				encodeIndex(b);
+			if (fec == 15)
+				encodeIndex(c);
+
+			pushVertex(a);
+			pushVertex(b, feb == 0 || feb == 15);
+			pushVertex(c, fec == 0 || fec == 15);
+			pushEdge(b, a);
+			pushEdge(c, b);
+			pushEdge(a, c);
+		}
+	}
+
+	std::memcpy(data, codeauxTable.data(), codeauxTable.size());
+	data += codeauxTable.size();
+	return static_cast<std::size_t>(data - buffer);
+}
+
+std::size_t fg::meshopt::encodeIndexSequenceBound(std::size_t count) noexcept {
+	// Every index takes at most five bytes, followed by a 4-byte tail.
+	return 1 + count * 5 + 4;
+}
+
+std::size_t fg::meshopt::encodeIndexSequence(std::byte* destination, const std::byte* source, std::size_t count,
+		std::size_t indexSize) noexcept {
+	if (indexSize != sizeof(std::uint16_t) && indexSize != sizeof(std::uint32_t))
+		return 0;
+
+	auto* buffer = reinterpret_cast<std::uint8_t*>(destination);
+	buffer[0] = sequenceHeader | 1;
+	auto* data = buffer + 1;
+
+	// Switch to the other baseline whenever the delta to the current one gets large, which keeps the
+	// deltas small for sequences interleaving two ranges, like the indices of strips.
+	std::array<unsigned, 2> last {};
+	unsigned current = 0;
+	for (std::size_t i = 0; i < count; ++i) {
+		const auto index = readIndex(source, i, indexSize);
+		const auto distance = static_cast<std::int32_t>(index - last[current]);
+		current ^= (distance < 0 ? 0U - static_cast<unsigned>(distance) : static_cast<unsigned>(distance)) >= 30 ? 1 : 0;
+
+		// The lowest bit selects the baseline, which leaves 31 bits for the zigzag-encoded delta.
+		const auto v = zigzag(index - last[current]);
+		if ((v >> 31) != 0)
+			return 0;
+		encodeVByte(data, (v << 1) | current);
+		last[current] = index;
+	}
+
+	std::memset(data, 0, 4);
+	data += 4;
+	return static_cast<std::size_t>(data - buffer);
+}
+
+bool fg::meshopt::encodeFilter(MeshoptCompressionFilter filter, std::byte* destination, const std::byte* source,
+		std::size_t count, std::size_t componentCount, std::size_t byteStride, unsigned bits) noexcept {
+	switch (filter) {
+		case MeshoptCompressionFilter::None:
+			return false;
+		case MeshoptCompressionFilter::Octahedral: {
+			if (componentCount != 3 && componentCount != 4)
+				return false;
+			if (byteStride == 4 && bits >= 2 && bits <= 8) {
+				encodeOctahedralFilter<std::int8_t>(destination, source, count, componentCount, bits);
+			} else if (byteStride == 8 && bits >= 2 && bits <= 16) {
+				encodeOctahedralFilter<std::int16_t>(destination, source, count, componentCount, bits);
+			} else {
+				return false;
+			}
+			return true;
+		}
+		case MeshoptCompressionFilter::Quaternion: {
+			if (componentCount != 4 || byteStride != 8 || bits < 4 || bits > 16)
+				return false;
+			encodeQuaternionFilter(destination, source, count, bits);
+			return true;
+		}
+		case MeshoptCompressionFilter::Exponential: {
+			if (componentCount == 0 || byteStride != componentCount * sizeof(float) || bits < 1 || bits > 24)
+				return false;
+			encodeExponentialFilter(destination, source, count * componentCount, bits);
+			return true;
+		}
+	}
+	return false;
+}
+#endif // FASTGLTF_ENABLE_MESHOPT_ENCODER
+
+#endif
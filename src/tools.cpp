@@ -0,0 +1,1893 @@
+/*
+ * Copyright (C) 2022 - 2025 Sean Apeler
+ * This file is part of fastgltf <https://github.com/spnda/fastgltf>.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#if !defined(__cplusplus) || (!defined(_MSVC_LANG) && __cplusplus < 201703L) || (defined(_MSVC_LANG) && _MSVC_LANG < 201703L)
+#error "fastgltf requires C++17"
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <optional>
+
+#include "simdjson.h"
+
+#include <fastgltf/tools.hpp>
+
+#if defined(FASTGLTF_IS_X86)
+#if defined(__clang__) || defined(__GNUC__)
+// See base64.cpp for why we include these headers manually.
+#include <immintrin.h>
+#include <smmintrin.h>
+#include <avxintrin.h>
+#include <avx2intrin.h>
+#else
+#include <intrin.h>
+#endif
+#elif defined(FASTGLTF_IS_A64)
+#include <arm_neon.h> // Includes arm64_neon.h on MSVC
+#endif
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 5030) // attribute 'x' is not recognized
+#pragma warning(disable : 4710) // function not inlined
+#endif
+
+namespace fg = fastgltf;
+
+namespace fastgltf::internal {
+	using ConvertComponentsFunction = bool(*)(const std::byte*, std::size_t, ComponentType,
+			std::byte*, std::size_t, ComponentType, std::size_t, std::size_t, bool) noexcept;
+
+	struct ConvertFunctionGetter {
+		ConvertComponentsFunction func;
+
+		explicit ConvertFunctionGetter() {
+			// Same as for the base64 decoders, we use simdjson to tell us which instructions are available.
+			const auto& impls = simdjson::get_available_implementations();
+#if defined(FASTGLTF_IS_X86)
+			if (const auto* avx2 = impls["haswell"]; avx2 != nullptr && avx2->supported_by_runtime_system()) {
+				func = avx2_convert_components;
+			} else if (const auto* sse4 = impls["westmere"]; sse4 != nullptr && sse4->supported_by_runtime_system()) {
+				func = sse4_convert_components;
+			}
+#elif defined(FASTGLTF_IS_A64)
+			if (const auto* neon = impls["arm64"]; neon && neon->supported_by_runtime_system()) {
+				func = neon_convert_components;
+			}
+#else
+			if (false) {}
+#endif
+			else {
+				func = fallback_convert_components;
+			}
+		}
+
+		static ConvertFunctionGetter* get() {
+			static ConvertFunctionGetter getter;
+			return &getter;
+		}
+	};
+
+	/** Parameters of a single conversion, which are passed through to the kernels. */
+	struct ComponentConversion {
+		const std::byte* src;
+		std::size_t srcStride;
+		std::byte* dst;
+		std::size_t dstStride;
+		std::size_t componentCount;
+		std::size_t count;
+		bool normalized;
+
+		template <typename Src, typename Dst>
+		[[nodiscard]] bool isPacked() const noexcept {
+			return srcStride == componentCount * sizeof(Src) && dstStride == componentCount * sizeof(Dst);
+		}
+
+		/**
+		 * Returns for how many elements we can always load 8 bytes, which is enough for any element
+		 * with up to four 16-bit components, without reading past the end of the last element.
+		 */
+		[[nodiscard]] std::size_t getWideLoadCount(std::size_t elementSize) const noexcept {
+			if (count == 0)
+				return 0;
+			const auto totalSize = (count - 1) * srcStride + elementSize;
+			if (totalSize < 8)
+				return 0;
+			return fastgltf::min((totalSize - 8) / srcStride + 1, count);
+		}
+	};
+
+	/** Loads exactly Size bytes into the lowest bytes of a 64-bit integer. */
+	template <std::size_t Size>
+	FASTGLTF_FORCEINLINE std::uint64_t loadPartial(const std::byte* src) {
+		static_assert(Size <= sizeof(std::uint64_t));
+		std::uint64_t value = 0;
+		std::memcpy(&value, src, Size);
+		return value;
+	}
+
+	/**
+	 * Converts a contiguous range of components one by one. This is used for the fallback
+	 * implementation and for the remainders the SIMD kernels can't process in full vectors.
+	 */
+	template <typename Src, typename Dst>
+	FASTGLTF_FORCEINLINE void convertLinear(const std::byte* src, std::byte* dst, std::size_t components, bool normalized) {
+		for (std::size_t i = 0; i < components; ++i) {
+			const auto value = convertComponent<Dst>(deserializeComponent<Src>(src, i), normalized);
+			std::memcpy(dst + i * sizeof(Dst), &value, sizeof value);
+		}
+	}
+
+	/**
+	 * Selects the kernel for the given component type pair. The supported conversions are
+	 * (normalized) 8-bit and 16-bit integers to floats, and unsigned integers to wider
+	 * unsigned integers. Everything else is left to the scalar code in tools.hpp.
+	 */
+	template <typename Kernel>
+	bool dispatchConversion(ComponentType srcType, ComponentType dstType, const ComponentConversion& conversion) {
+		if (conversion.componentCount == 0 || conversion.componentCount > 4)
+			return false;
+
+		switch (dstType) {
+			case ComponentType::Float: {
+				switch (srcType) {
+					case ComponentType::Byte:
+						Kernel::template convert<std::int8_t, float>(conversion);
+						return true;
+					case ComponentType::UnsignedByte:
+						Kernel::template convert<std::uint8_t, float>(conversion);
+						return true;
+					case ComponentType::Short:
+						Kernel::template convert<std::int16_t, float>(conversion);
+						return true;
+					case ComponentType::UnsignedShort:
+						Kernel::template convert<std::uint16_t, float>(conversion);
+						return true;
+					default:
+						return false;
+				}
+			}
+			case ComponentType::UnsignedInt: {
+				switch (srcType) {
+					case ComponentType::UnsignedByte:
+						Kernel::template convert<std::uint8_t, std::uint32_t>(conversion);
+						return true;
+					case ComponentType::UnsignedShort:
+						Kernel::template convert<std::uint16_t, std::uint32_t>(conversion);
+						return true;
+					default:
+						return false;
+				}
+			}
+			case ComponentType::UnsignedShort: {
+				if (srcType == ComponentType::UnsignedByte) {
+					Kernel::template convert<std::uint8_t, std::uint16_t>(conversion);
+					return true;
+				}
+				return false;
+			}
+			default:
+				return false;
+		}
+	}
+
+	struct FallbackConversionKernel {
+		template <typename Src, typename Dst>
+		static void convert(const ComponentConversion& conv) {
+			if (conv.isPacked<Src, Dst>()) {
+				convertLinear<Src, Dst>(conv.src, conv.dst, conv.count * conv.componentCount, conv.normalized);
+				return;
+			}
+
+			for (std::size_t i = 0; i < conv.count; ++i) {
+				convertLinear<Src, Dst>(conv.src + i * conv.srcStride, conv.dst + i * conv.dstStride,
+						conv.componentCount, conv.normalized);
+			}
+		}
+	};
+} // namespace fastgltf::internal
+
+#if defined(FASTGLTF_IS_X86)
+namespace fastgltf::internal {
+	/** Sign- or zero-extends the lowest four components of the vector to 32-bit integers. */
+	template <typename Src>
+	[[gnu::target("sse4.1")]] FASTGLTF_FORCEINLINE __m128i sse4_widen_epi32(const __m128i input) {
+		if constexpr (std::is_same_v<Src, std::int8_t>) {
+			return _mm_cvtepi8_epi32(input);
+		} else if constexpr (std::is_same_v<Src, std::uint8_t>) {
+			return _mm_cvtepu8_epi32(input);
+		} else if constexpr (std::is_same_v<Src, std::int16_t>) {
+			return _mm_cvtepi16_epi32(input);
+		} else {
+			return _mm_cvtepu16_epi32(input);
+		}
+	}
+
+	/**
+	 * Converts the lowest four components of the vector into four destination components, which
+	 * are returned in the lowest 4 * sizeof(Dst) bytes. The division matches convertComponent
+	 * exactly, which a multiplication with the reciprocal would not.
+	 */
+	template <typename Src, typename Dst>
+	[[gnu::target("sse4.1")]] FASTGLTF_FORCEINLINE __m128i sse4_convert4(const __m128i input, const bool normalized) {
+		if constexpr (std::is_same_v<Dst, float>) {
+			auto floats = _mm_cvtepi32_ps(sse4_widen_epi32<Src>(input));
+			if (normalized) {
+				floats = _mm_div_ps(floats, _mm_set1_ps(static_cast<float>(std::numeric_limits<Src>::max())));
+				if constexpr (std::is_signed_v<Src>) {
+					floats = _mm_max_ps(floats, _mm_set1_ps(-1.0f));
+				}
+			}
+			return _mm_castps_si128(floats);
+		} else if constexpr (std::is_same_v<Dst, std::uint32_t>) {
+			return sse4_widen_epi32<Src>(input);
+		} else {
+			static_assert(std::is_same_v<Src, std::uint8_t> && std::is_same_v<Dst, std::uint16_t>);
+			return _mm_cvtepu8_epi16(input);
+		}
+	}
+
+	template <typename Dst>
+	[[gnu::target("sse4.1")]] FASTGLTF_FORCEINLINE void sse4_store4(std::byte* dst, const __m128i value) {
+		if constexpr (sizeof(Dst) == 4) {
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), value);
+		} else {
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(dst), value);
+		}
+	}
+
+	template <typename Src, typename Dst>
+	[[gnu::target("sse4.1")]] void sse4_convert_linear(const std::byte* src, std::byte* dst, std::size_t components, const bool normalized) {
+		// One 16-byte load holds 16 8-bit or 8 16-bit components, which we convert in groups of four.
+		constexpr std::size_t loadSize = 16 / sizeof(Src);
+		constexpr std::size_t groupSize = 4 * sizeof(Src);
+		std::size_t i = 0;
+		for (; i + loadSize <= components; i += loadSize) {
+			const auto input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * sizeof(Src)));
+			sse4_store4<Dst>(dst + (i + 0) * sizeof(Dst), sse4_convert4<Src, Dst>(input, normalized));
+			sse4_store4<Dst>(dst + (i + 4) * sizeof(Dst), sse4_convert4<Src, Dst>(_mm_srli_si128(input, groupSize), normalized));
+			if constexpr (sizeof(Src) == 1) {
+				sse4_store4<Dst>(dst + (i + 8) * sizeof(Dst), sse4_convert4<Src, Dst>(_mm_srli_si128(input, 2 * groupSize), normalized));
+				sse4_store4<Dst>(dst + (i + 12) * sizeof(Dst), sse4_convert4<Src, Dst>(_mm_srli_si128(input, 3 * groupSize), normalized));
+			}
+		}
+
+		for (; i + 4 <= components; i += 4) {
+			const auto bytes = loadPartial<groupSize>(src + i * sizeof(Src));
+			const auto input = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&bytes));
+			sse4_store4<Dst>(dst + i * sizeof(Dst), sse4_convert4<Src, Dst>(input, normalized));
+		}
+
+		convertLinear<Src, Dst>(src + i * sizeof(Src), dst + i * sizeof(Dst), components - i, normalized);
+	}
+
+	template <std::size_t Size>
+	[[gnu::target("sse4.1")]] FASTGLTF_FORCEINLINE void sse4_store_partial(std::byte* dst, const __m128i value) {
+		if constexpr (Size == 16) {
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), value);
+		} else if constexpr (Size >= 8) {
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(dst), value);
+			if constexpr (Size > 8) {
+				sse4_store_partial<Size - 8>(dst + 8, _mm_srli_si128(value, 8));
+			}
+		} else {
+			const auto low = _mm_cvtsi128_si32(value);
+			std::memcpy(dst, &low, Size < 4 ? Size : 4);
+			if constexpr (Size > 4) {
+				sse4_store_partial<Size - 4>(dst + 4, _mm_srli_si128(value, 4));
+			}
+		}
+	}
+
+	/**
+	 * Converts one element per iteration. Only the componentCount components of each element are written,
+	 * so that padding or other interleaved attributes in the destination are never touched.
+	 */
+	template <typename Src, typename Dst, std::size_t ComponentCount>
+	[[gnu::target("sse4.1")]] void sse4_convert_elements(const ComponentConversion& conv) {
+		constexpr auto srcSize = ComponentCount * sizeof(Src);
+		constexpr auto dstSize = ComponentCount * sizeof(Dst);
+		const auto wideCount = conv.getWideLoadCount(srcSize);
+		std::size_t i = 0;
+		for (; i < wideCount; ++i) {
+			const auto input = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(conv.src + i * conv.srcStride));
+			sse4_store_partial<dstSize>(conv.dst + i * conv.dstStride, sse4_convert4<Src, Dst>(input, conv.normalized));
+		}
+		for (; i < conv.count; ++i) {
+			const auto bytes = loadPartial<srcSize>(conv.src + i * conv.srcStride);
+			const auto input = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&bytes));
+			sse4_store_partial<dstSize>(conv.dst + i * conv.dstStride, sse4_convert4<Src, Dst>(input, conv.normalized));
+		}
+	}
+
+	template <typename Src, typename Dst>
+	[[gnu::target("sse4.1")]] void sse4_convert_strided(const ComponentConversion& conv) {
+		switch (conv.componentCount) {
+			case 1: return sse4_convert_elements<Src, Dst, 1>(conv);
+			case 2: return sse4_convert_elements<Src, Dst, 2>(conv);
+			case 3: return sse4_convert_elements<Src, Dst, 3>(conv);
+			case 4: return sse4_convert_elements<Src, Dst, 4>(conv);
+			default: break;
+		}
+	}
+
+	struct SSE4ConversionKernel {
+		template <typename Src, typename Dst>
+		[[gnu::target("sse4.1")]] static void convert(const ComponentConversion& conv) {
+			if (conv.isPacked<Src, Dst>()) {
+				sse4_convert_linear<Src, Dst>(conv.src, conv.dst, conv.count * conv.componentCount, conv.normalized);
+			} else {
+				sse4_convert_strided<Src, Dst>(conv);
+			}
+		}
+	};
+
+	/** AVX2 variant of sse4_convert4, which converts the lowest eight components of the 128-bit input. */
+	template <typename Src, typename Dst>
+	[[gnu::target("avx2")]] FASTGLTF_FORCEINLINE __m256i avx2_convert8(const __m128i input, const bool normalized) {
+		if constexpr (std::is_same_v<Dst, std::uint16_t>) {
+			return _mm256_cvtepu8_epi16(input); // This converts all sixteen components.
+		}
+
+		__m256i widened;
+		if constexpr (std::is_same_v<Src, std::int8_t>) {
+			widened = _mm256_cvtepi8_epi32(input);
+		} else if constexpr (std::is_same_v<Src, std::uint8_t>) {
+			widened = _mm256_cvtepu8_epi32(input);
+		} else if constexpr (std::is_same_v<Src, std::int16_t>) {
+			widened = _mm256_cvtepi16_epi32(input);
+		} else {
+			widened = _mm256_cvtepu16_epi32(input);
+		}
+
+		if constexpr (std::is_same_v<Dst, float>) {
+			auto floats = _mm256_cvtepi32_ps(widened);
+			if (normalized) {
+				floats = _mm256_div_ps(floats, _mm256_set1_ps(static_cast<float>(std::numeric_limits<Src>::max())));
+				if constexpr (std::is_signed_v<Src>) {
+					floats = _mm256_max_ps(floats, _mm256_set1_ps(-1.0f));
+				}
+			}
+			return _mm256_castps_si256(floats);
+		} else {
+			return widened;
+		}
+	}
+
+	template <typename Src, typename Dst>
+	[[gnu::target("avx2")]] void avx2_convert_linear(const std::byte* src, std::byte* dst, std::size_t components, const bool normalized) {
+		// Each iteration loads 32 bytes and converts them in blocks of 32 output bytes.
+		constexpr std::size_t loadSize = 32 / sizeof(Src);
+		constexpr std::size_t blockSize = 32 / sizeof(Dst);
+		std::size_t i = 0;
+		for (; i + loadSize <= components; i += loadSize) {
+			const auto* input = reinterpret_cast<const __m128i*>(src + i * sizeof(Src));
+			const auto low = _mm_loadu_si128(input);
+			const auto high = _mm_loadu_si128(input + 1);
+
+			auto* output = reinterpret_cast<__m256i*>(dst + i * sizeof(Dst));
+			if constexpr (sizeof(Src) == 1 && sizeof(Dst) == 4) {
+				_mm256_storeu_si256(output + 0, avx2_convert8<Src, Dst>(low, normalized));
+				_mm256_storeu_si256(output + 1, avx2_convert8<Src, Dst>(_mm_srli_si128(low, 8), normalized));
+				_mm256_storeu_si256(output + 2, avx2_convert8<Src, Dst>(high, normalized));
+				_mm256_storeu_si256(output + 3, avx2_convert8<Src, Dst>(_mm_srli_si128(high, 8), normalized));
+			} else {
+				static_assert(blockSize * 2 == loadSize);
+				_mm256_storeu_si256(output + 0, avx2_convert8<Src, Dst>(low, normalized));
+				_mm256_storeu_si256(output + 1, avx2_convert8<Src, Dst>(high, normalized));
+			}
+		}
+
+		sse4_convert_linear<Src, Dst>(src + i * sizeof(Src), dst + i * sizeof(Dst), components - i, normalized);
+	}
+
+	struct AVX2ConversionKernel {
+		template <typename Src, typename Dst>
+		[[gnu::target("avx2")]] static void convert(const ComponentConversion& conv) {
+			// Strided elements hold at most four components, which fit into a 128-bit register.
+			if (conv.isPacked<Src, Dst>()) {
+				avx2_convert_linear<Src, Dst>(conv.src, conv.dst, conv.count * conv.componentCount, conv.normalized);
+			} else {
+				sse4_convert_strided<Src, Dst>(conv);
+			}
+		}
+	};
+} // namespace fastgltf::internal
+
+[[gnu::target("sse4.1")]] bool fg::internal::sse4_convert_components(const std::byte* src, std::size_t srcStride, ComponentType srcType,
+		std::byte* dst, std::size_t dstStride, ComponentType dstType, std::size_t componentCount, std::size_t count, bool normalized) noexcept {
+	return dispatchConversion<SSE4ConversionKernel>(srcType, dstType,
+			ComponentConversion { src, srcStride, dst, dstStride, componentCount, count, normalized });
+}
+
+[[gnu::target("avx2")]] bool fg::internal::avx2_convert_components(const std::byte* src, std::size_t srcStride, ComponentType srcType,
+		std::byte* dst, std::size_t dstStride, ComponentType dstType, std::size_t componentCount, std::size_t count, bool normalized) noexcept {
+	return dispatchConversion<AVX2ConversionKernel>(srcType, dstType,
+			ComponentConversion { src, srcStride, dst, dstStride, componentCount, count, normalized });
+}
+#elif defined(FASTGLTF_IS_A64)
+namespace fastgltf::internal {
+	/**
+	 * Converts the lowest four components of the vector into four destination components, which
+	 * are returned in the lowest 4 * sizeof(Dst) bytes. See sse4_convert4.
+	 */
+	template <typename Src, typename Dst>
+	FASTGLTF_FORCEINLINE uint8x16_t neon_convert4(const uint8x16_t input, const bool normalized) {
+		if constexpr (std::is_same_v<Dst, std::uint16_t>) {
+			return vreinterpretq_u8_u16(vmovl_u8(vget_low_u8(input)));
+		} else {
+			int32x4_t widened;
+			if constexpr (std::is_same_v<Src, std::int8_t>) {
+				widened = vmovl_s16(vget_low_s16(vmovl_s8(vget_low_s8(vreinterpretq_s8_u8(input)))));
+			} else if constexpr (std::is_same_v<Src, std::uint8_t>) {
+				widened = vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(vmovl_u8(vget_low_u8(input)))));
+			} else if constexpr (std::is_same_v<Src, std::int16_t>) {
+				widened = vmovl_s16(vget_low_s16(vreinterpretq_s16_u8(input)));
+			} else {
+				widened = vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(vreinterpretq_u16_u8(input))));
+			}
+
+			if constexpr (std::is_same_v<Dst, float>) {
+				auto floats = vcvtq_f32_s32(widened);
+				if (normalized) {
+					floats = vdivq_f32(floats, vdupq_n_f32(static_cast<float>(std::numeric_limits<Src>::max())));
+					if constexpr (std::is_signed_v<Src>) {
+						floats = vmaxq_f32(floats, vdupq_n_f32(-1.0f));
+					}
+				}
+				return vreinterpretq_u8_f32(floats);
+			} else {
+				return vreinterpretq_u8_s32(widened);
+			}
+		}
+	}
+
+	template <typename Dst>
+	FASTGLTF_FORCEINLINE void neon_store4(std::byte* dst, const uint8x16_t value) {
+		if constexpr (sizeof(Dst) == 4) {
+			vst1q_u8(reinterpret_cast<std::uint8_t*>(dst), value);
+		} else {
+			vst1_u8(reinterpret_cast<std::uint8_t*>(dst), vget_low_u8(value));
+		}
+	}
+
+	template <typename Src, typename Dst>
+	void neon_convert_linear(const std::byte* src, std::byte* dst, std::size_t components, const bool normalized) {
+		constexpr std::size_t loadSize = 16 / sizeof(Src);
+		constexpr int groupSize = 4 * sizeof(Src);
+		std::size_t i = 0;
+		for (; i + loadSize <= components; i += loadSize) {
+			const auto input = vld1q_u8(reinterpret_cast<const std::uint8_t*>(src + i * sizeof(Src)));
+			neon_store4<Dst>(dst + (i + 0) * sizeof(Dst), neon_convert4<Src, Dst>(input, normalized));
+			neon_store4<Dst>(dst + (i + 4) * sizeof(Dst), neon_convert4<Src, Dst>(vextq_u8(input, input, groupSize), normalized));
+			if constexpr (sizeof(Src) == 1) {
+				neon_store4<Dst>(dst + (i + 8) * sizeof(Dst), neon_convert4<Src, Dst>(vextq_u8(input, input, 2 * groupSize), normalized));
+				neon_store4<Dst>(dst + (i + 12) * sizeof(Dst), neon_convert4<Src, Dst>(vextq_u8(input, input, 3 * groupSize), normalized));
+			}
+		}
+
+		for (; i + 4 <= components; i += 4) {
+			const auto input = vcombine_u8(vcreate_u8(loadPartial<groupSize>(src + i * sizeof(Src))), vdup_n_u8(0));
+			neon_store4<Dst>(dst + i * sizeof(Dst), neon_convert4<Src, Dst>(input, normalized));
+		}
+
+		convertLinear<Src, Dst>(src + i * sizeof(Src), dst + i * sizeof(Dst), components - i, normalized);
+	}
+
+	template <std::size_t Size>
+	FASTGLTF_FORCEINLINE void neon_store_partial(std::byte* dst, const uint8x16_t value) {
+		if constexpr (Size == 16) {
+			vst1q_u8(reinterpret_cast<std::uint8_t*>(dst), value);
+		} else {
+			const auto low = vgetq_lane_u64(vreinterpretq_u64_u8(value), 0);
+			std::memcpy(dst, &low, Size < 8 ? Size : 8);
+			if constexpr (Size > 8) {
+				const auto high = vgetq_lane_u64(vreinterpretq_u64_u8(value), 1);
+				std::memcpy(dst + 8, &high, Size - 8);
+			}
+		}
+	}
+
+	/** See sse4_convert_elements. */
+	template <typename Src, typename Dst, std::size_t ComponentCount>
+	void neon_convert_elements(const ComponentConversion& conv) {
+		constexpr auto srcSize = ComponentCount * sizeof(Src);
+		constexpr auto dstSize = ComponentCount * sizeof(Dst);
+		const auto wideCount = conv.getWideLoadCount(srcSize);
+		std::size_t i = 0;
+		for (; i < wideCount; ++i) {
+			const auto input = vcombine_u8(vld1_u8(reinterpret_cast<const std::uint8_t*>(conv.src + i * conv.srcStride)), vdup_n_u8(0));
+			neon_store_partial<dstSize>(conv.dst + i * conv.dstStride, neon_convert4<Src, Dst>(input, conv.normalized));
+		}
+		for (; i < conv.count; ++i) {
+			const auto input = vcombine_u8(vcreate_u8(loadPartial<srcSize>(conv.src + i * conv.srcStride)), vdup_n_u8(0));
+			neon_store_partial<dstSize>(conv.dst + i * conv.dstStride, neon_convert4<Src, Dst>(input, conv.normalized));
+		}
+	}
+
+	struct NeonConversionKernel {
+		template <typename Src, typename Dst>
+		static void convert(const ComponentConversion& conv) {
+			if (conv.isPacked<Src, Dst>()) {
+				neon_convert_linear<Src, Dst>(conv.src, conv.dst, conv.count * conv.componentCount, conv.normalized);
+				return;
+			}
+
+			switch (conv.componentCount) {
+				case 1: return neon_convert_elements<Src, Dst, 1>(conv);
+				case 2: return neon_convert_elements<Src, Dst, 2>(conv);
+				case 3: return neon_convert_elements<Src, Dst, 3>(conv);
+				case 4: return neon_convert_elements<Src, Dst, 4>(conv);
+				default: break;
+			}
+		}
+	};
+} // namespace fastgltf::internal
+
+bool fg::internal::neon_convert_components(const std::byte* src, std::size_t srcStride, ComponentType srcType,
+		std::byte* dst, std::size_t dstStride, ComponentType dstType, std::size_t componentCount, std::size_t count, bool normalized) noexcept {
+	return dispatchConversion<NeonConversionKernel>(srcType, dstType,
+			ComponentConversion { src, srcStride, dst, dstStride, componentCount, count, normalized });
+}
+#endif
+
+bool fg::internal::fallback_convert_components(const std::byte* src, std::size_t srcStride, ComponentType srcType,
+		std::byte* dst, std::size_t dstStride, ComponentType dstType, std::size_t componentCount, std::size_t count, bool normalized) noexcept {
+	return dispatchConversion<FallbackConversionKernel>(srcType, dstType,
+			ComponentConversion { src, srcStride, dst, dstStride, componentCount, count, normalized });
+}
+
+bool fg::internal::convertComponents(const std::byte* src, std::size_t srcStride, ComponentType srcType,
+		std::byte* dst, std::size_t dstStride, ComponentType dstType, std::size_t componentCount, std::size_t count, bool normalized) noexcept {
+	return ConvertFunctionGetter::get()->func(src, srcStride, srcType, dst, dstStride, dstType, componentCount, count, normalized);
+}
+
+namespace fastgltf::internal {
+	static constexpr auto noParentEntry = std::numeric_limits<std::uint32_t>::max();
+
+	static_assert(sizeof(math::fmat4x4) == sizeof(float) * 16, "The SIMD kernels expect tightly packed matrices");
+
+	/**
+	 * Computes world[i] = parentWorld * local[i] for every entry in [begin, end), where parentWorld is
+	 * either the world matrix of the parent entry or root. Parents always come before their children,
+	 * so a single forward pass over a subtree is enough.
+	 */
+	using MultiplyTransformsFunction = void(*)(math::fmat4x4* world, const math::fmat4x4* local,
+			const std::uint32_t* parents, const math::fmat4x4& root, std::size_t begin, std::size_t end) noexcept;
+
+	void fallback_multiply_transforms(math::fmat4x4* world, const math::fmat4x4* local,
+			const std::uint32_t* parents, const math::fmat4x4& root, std::size_t begin, std::size_t end) noexcept {
+		for (auto i = begin; i < end; ++i) {
+			const auto& parent = parents[i] == noParentEntry ? root : world[parents[i]];
+			world[i] = parent * local[i];
+		}
+	}
+
+#if defined(FASTGLTF_IS_X86)
+	// Every column of the result is a linear combination of the parent's columns. The products are
+	// summed in the same order as math::mat::operator* does, so all kernels return identical results.
+	[[gnu::target("sse4.1")]] FASTGLTF_FORCEINLINE __m128 sse4_combine_columns(const __m128* columns, const float* weights) {
+		auto result = _mm_mul_ps(columns[0], _mm_set1_ps(weights[0]));
+		result = _mm_add_ps(result, _mm_mul_ps(columns[1], _mm_set1_ps(weights[1])));
+		result = _mm_add_ps(result, _mm_mul_ps(columns[2], _mm_set1_ps(weights[2])));
+		return _mm_add_ps(result, _mm_mul_ps(columns[3], _mm_set1_ps(weights[3])));
+	}
+
+	[[gnu::target("sse4.1")]] void sse4_multiply_transforms(math::fmat4x4* world, const math::fmat4x4* local,
+			const std::uint32_t* parents, const math::fmat4x4& root, std::size_t begin, std::size_t end) noexcept {
+		for (auto i = begin; i < end; ++i) {
+			const auto* parent = parents[i] == noParentEntry ? root.col(0).data() : world[parents[i]].col(0).data();
+			const __m128 columns[4] = {
+				_mm_loadu_ps(parent), _mm_loadu_ps(parent + 4), _mm_loadu_ps(parent + 8), _mm_loadu_ps(parent + 12),
+			};
+
+			const auto* weights = local[i].col(0).data();
+			auto* dst = world[i].col(0).data();
+			for (std::size_t j = 0; j < 4; ++j) {
+				_mm_storeu_ps(dst + j * 4, sse4_combine_columns(columns, weights + j * 4));
+			}
+		}
+	}
+
+	[[gnu::target("avx2")]] void avx2_multiply_transforms(math::fmat4x4* world, const math::fmat4x4* local,
+			const std::uint32_t* parents, const math::fmat4x4& root, std::size_t begin, std::size_t end) noexcept {
+		for (auto i = begin; i < end; ++i) {
+			// Each parent column is duplicated into both lanes, so that two result columns can be computed at once.
+			const auto* parent = parents[i] == noParentEntry ? root.col(0).data() : world[parents[i]].col(0).data();
+			const auto c0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(parent));
+			const auto c1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(parent + 4));
+			const auto c2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(parent + 8));
+			const auto c3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(parent + 12));
+
+			const auto* weights = local[i].col(0).data();
+			auto* dst = world[i].col(0).data();
+			for (std::size_t j = 0; j < 2; ++j) {
+				const auto w = _mm256_loadu_ps(weights + j * 8);
+				auto result = _mm256_mul_ps(c0, _mm256_permute_ps(w, 0x00));
+				result = _mm256_add_ps(result, _mm256_mul_ps(c1, _mm256_permute_ps(w, 0x55)));
+				result = _mm256_add_ps(result, _mm256_mul_ps(c2, _mm256_permute_ps(w, 0xAA)));
+				result = _mm256_add_ps(result, _mm256_mul_ps(c3, _mm256_permute_ps(w, 0xFF)));
+				_mm256_storeu_ps(dst + j * 8, result);
+			}
+		}
+	}
+#elif defined(FASTGLTF_IS_A64)
+	void neon_multiply_transforms(math::fmat4x4* world, const math::fmat4x4* local,
+			const std::uint32_t* parents, const math::fmat4x4& root, std::size_t begin, std::size_t end) noexcept {
+		for (auto i = begin; i < end; ++i) {
+			const auto* parent = parents[i] == noParentEntry ? root.col(0).data() : world[parents[i]].col(0).data();
+			const auto c0 = vld1q_f32(parent);
+			const auto c1 = vld1q_f32(parent + 4);
+			const auto c2 = vld1q_f32(parent + 8);
+			const auto c3 = vld1q_f32(parent + 12);
+
+			const auto* weights = local[i].col(0).data();
+			auto* dst = world[i].col(0).data();
+			for (std::size_t j = 0; j < 4; ++j) {
+				// Separate multiplies and adds instead of vfmaq, to match the rounding of the other kernels.
+				const auto w = vld1q_f32(weights + j * 4);
+				auto result = vmulq_laneq_f32(c0, w, 0);
+				result = vaddq_f32(result, vmulq_laneq_f32(c1, w, 1));
+				result = vaddq_f32(result, vmulq_laneq_f32(c2, w, 2));
+				result = vaddq_f32(result, vmulq_laneq_f32(c3, w, 3));
+				vst1q_f32(dst + j * 4, result);
+			}
+		}
+	}
+#endif
+
+	struct MultiplyTransformsGetter {
+		MultiplyTransformsFunction func;
+
+		explicit MultiplyTransformsGetter() {
+			const auto& impls = simdjson::get_available_implementations();
+#if defined(FASTGLTF_IS_X86)
+			if (const auto* avx2 = impls["haswell"]; avx2 != nullptr && avx2->supported_by_runtime_system()) {
+				func = avx2_multiply_transforms;
+			} else if (const auto* sse4 = impls["westmere"]; sse4 != nullptr && sse4->supported_by_runtime_system()) {
+				func = sse4_multiply_transforms;
+			}
+#elif defined(FASTGLTF_IS_A64)
+			if (const auto* neon = impls["arm64"]; neon && neon->supported_by_runtime_system()) {
+				func = neon_multiply_transforms;
+			}
+#else
+			if (false) {}
+#endif
+			else {
+				func = fallback_multiply_transforms;
+			}
+		}
+
+		static MultiplyTransformsGetter* get() {
+			static MultiplyTransformsGetter getter;
+			return &getter;
+		}
+	};
+
+	/** Computes T * R * S directly, without going through three matrix multiplications. */
+	math::fmat4x4 composeTransform(const math::fvec3& translation, const math::fquat& rotation, const math::fvec3& scale) noexcept {
+		const auto rot = asMatrix(rotation);
+		return math::fmat4x4(
+			math::fvec4(rot.col(0).x() * scale.x(), rot.col(0).y() * scale.x(), rot.col(0).z() * scale.x(), 0.f),
+			math::fvec4(rot.col(1).x() * scale.y(), rot.col(1).y() * scale.y(), rot.col(1).z() * scale.y(), 0.f),
+			math::fvec4(rot.col(2).x() * scale.z(), rot.col(2).y() * scale.z(), rot.col(2).z() * scale.z(), 0.f),
+			math::fvec4(translation.x(), translation.y(), translation.z(), 1.f));
+	}
+} // namespace fastgltf::internal
+
+fg::SceneTransformCache::SceneTransformCache(const Asset& asset, std::size_t sceneIndex, const math::fmat4x4& initial)
+		: entries(asset.nodes.size(), noEntry), rootMatrix(initial) {
+	assert(sceneIndex < asset.scenes.size());
+	const auto& scene = asset.scenes[sceneIndex];
+
+	// Flatten the hierarchy in depth-first order, using an explicit stack so that deep hierarchies
+	// can't overflow the call stack. Nodes reached a second time are ignored, which also breaks cycles.
+	std::vector<std::pair<std::size_t, std::uint32_t>> stack;
+	for (auto it = scene.nodeIndices.rbegin(); it != scene.nodeIndices.rend(); ++it) {
+		stack.emplace_back(*it, noEntry);
+	}
+
+	while (!stack.empty()) {
+		const auto [nodeIndex, parent] = stack.back();
+		stack.pop_back();
+		assert(nodeIndex < asset.nodes.size());
+		if (entries[nodeIndex] != noEntry)
+			continue;
+
+		entries[nodeIndex] = static_cast<std::uint32_t>(nodeIndices.size());
+		nodeIndices.emplace_back(nodeIndex);
+		parents.emplace_back(parent);
+
+		const auto& node = asset.nodes[nodeIndex];
+		visit_exhaustive(visitor {
+			[&](const math::fmat4x4& matrix) {
+				usesTRS.emplace_back(0);
+				translations.emplace_back();
+				rotations.emplace_back(0.f, 0.f, 0.f, 1.f);
+				scales.emplace_back(1.f);
+				localMatrices.emplace_back(matrix);
+			},
+			[&](const TRS& trs) {
+				usesTRS.emplace_back(1);
+				translations.emplace_back(trs.translation);
+				rotations.emplace_back(trs.rotation);
+				scales.emplace_back(trs.scale);
+				localMatrices.emplace_back(internal::composeTransform(trs.translation, trs.rotation, trs.scale));
+			}
+		}, node.transform);
+
+		const auto entry = entries[nodeIndex];
+		for (auto it = node.children.rbegin(); it != node.children.rend(); ++it) {
+			stack.emplace_back(*it, entry);
+		}
+	}
+
+	// Every subtree is a contiguous range of entries. Walking backwards, each entry has its final
+	// end once we reach it, which we can then propagate to its parent.
+	subtreeEnds.resize(nodeIndices.size());
+	for (std::size_t i = nodeIndices.size(); i-- > 0;) {
+		subtreeEnds[i] = fastgltf::max(subtreeEnds[i], static_cast<std::uint32_t>(i + 1));
+		if (parents[i] != noEntry) {
+			subtreeEnds[parents[i]] = fastgltf::max(subtreeEnds[parents[i]], subtreeEnds[i]);
+		}
+	}
+
+	worldMatrices.resize(nodeIndices.size());
+	internal::MultiplyTransformsGetter::get()->func(worldMatrices.data(), localMatrices.data(), parents.data(),
+			rootMatrix, 0, nodeIndices.size());
+}
+
+void fg::SceneTransformCache::markDirty(std::size_t nodeIndex) {
+	assert(contains(nodeIndex) && "The node is not part of this scene.");
+	dirtyEntries.emplace_back(entries[nodeIndex]);
+}
+
+void fg::SceneTransformCache::setLocalTransform(std::size_t nodeIndex, const TRS& trs) {
+	markDirty(nodeIndex);
+	const auto entry = entries[nodeIndex];
+	usesTRS[entry] = 1;
+	translations[entry] = trs.translation;
+	rotations[entry] = trs.rotation;
+	scales[entry] = trs.scale;
+}
+
+void fg::SceneTransformCache::setLocalTransform(std::size_t nodeIndex, const math::fmat4x4& matrix) {
+	markDirty(nodeIndex);
+	const auto entry = entries[nodeIndex];
+	usesTRS[entry] = 0;
+	localMatrices[entry] = matrix;
+}
+
+void fg::SceneTransformCache::setRootTransform(const math::fmat4x4& matrix) {
+	rootMatrix = matrix;
+	for (std::uint32_t i = 0; i < parents.size(); i = subtreeEnds[i]) {
+		dirtyEntries.emplace_back(i);
+	}
+}
+
+void fg::SceneTransformCache::update() {
+	if (dirtyEntries.empty())
+		return;
+
+	// Sorting puts every subtree root before any of the entries it contains, so that
+	// entries within a subtree we already recompute are skipped.
+	std::sort(dirtyEntries.begin(), dirtyEntries.end());
+
+	for (const auto entry : dirtyEntries) {
+		if (usesTRS[entry]) {
+			localMatrices[entry] = internal::composeTransform(translations[entry], rotations[entry], scales[entry]);
+		}
+	}
+
+	const auto multiply = internal::MultiplyTransformsGetter::get()->func;
+	std::uint32_t rangeEnd = 0;
+	for (const auto entry : dirtyEntries) {
+		if (entry < rangeEnd)
+			continue;
+		rangeEnd = subtreeEnds[entry];
+		multiply(worldMatrices.data(), localMatrices.data(), parents.data(), rootMatrix, entry, rangeEnd);
+	}
+	dirtyEntries.clear();
+}
+
+namespace fastgltf::internal {
+	/**
+	 * The slerp kernels approximate acos on [0, 1] with the polynomial from Abramowitz & Stegun 4.4.46,
+	 * and sin on [0, pi/2] with its Taylor series, both of which are accurate to float precision. This is
+	 * what allows all lanes to be computed without calling into the scalar math library.
+	 */
+	static constexpr std::array<float, 8> acosCoefficients = {
+		1.5707963050f, -0.2145988016f, 0.0889789874f, -0.0501743046f,
+		0.0308918810f, -0.0170881256f, 0.0066700901f, -0.0012624911f,
+	};
+	static constexpr std::array<float, 6> sinCoefficients = {
+		1.f, -1.f / 6.f, 1.f / 120.f, -1.f / 5040.f, 1.f / 362880.f, -1.f / 39916800.f,
+	};
+
+	// Below this angle between both quaternions, we just normalize the linear interpolation.
+	static constexpr float slerpLinearThreshold = 0.9995f;
+
+	float slerpAcos(float x) noexcept {
+		auto result = acosCoefficients[7];
+		for (std::size_t i = 7; i-- > 0;)
+			result = result * x + acosCoefficients[i];
+		return std::sqrt(1.f - x) * result;
+	}
+
+	float slerpSin(float x) noexcept {
+		const auto x2 = x * x;
+		auto result = sinCoefficients[5];
+		for (std::size_t i = 5; i-- > 0;)
+			result = result * x2 + sinCoefficients[i];
+		return result * x;
+	}
+
+	void slerpQuaternion(const float* a, const float* b, float t, float* result) noexcept {
+		auto d = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+
+		// Interpolate along the shorter arc.
+		const auto sign = d < 0.f ? -1.f : 1.f;
+		d = fastgltf::min(d * sign, 1.f);
+
+		float sa, sb;
+		if (d > slerpLinearThreshold) {
+			sa = 1.f - t;
+			sb = t;
+		} else {
+			const auto theta = slerpAcos(d);
+			const auto sinTheta = slerpSin(theta);
+			sa = slerpSin((1.f - t) * theta) / sinTheta;
+			sb = slerpSin(t * theta) / sinTheta;
+		}
+		sb *= sign;
+
+		float length = 0.f;
+		for (std::size_t i = 0; i < 4; ++i) {
+			result[i] = a[i] * sa + b[i] * sb;
+			length += result[i] * result[i];
+		}
+		length = std::sqrt(length);
+		for (std::size_t i = 0; i < 4; ++i)
+			result[i] /= length;
+	}
+
+	using SlerpFunction = void(*)(const float* starts, const float* ends, const float* factors, float* results, std::size_t count) noexcept;
+
+	void fallback_slerp(const float* starts, const float* ends, const float* factors, float* results, std::size_t count) noexcept {
+		for (std::size_t i = 0; i < count; ++i) {
+			slerpQuaternion(starts + i * 4, ends + i * 4, factors[i], results + i * 4);
+		}
+	}
+
+#if defined(FASTGLTF_IS_X86)
+	[[gnu::target("sse4.1")]] FASTGLTF_FORCEINLINE __m128 sse4_slerp_acos(const __m128 x) {
+		auto result = _mm_set1_ps(acosCoefficients[7]);
+		for (std::size_t i = 7; i-- > 0;)
+			result = _mm_add_ps(_mm_mul_ps(result, x), _mm_set1_ps(acosCoefficients[i]));
+		return _mm_mul_ps(_mm_sqrt_ps(_mm_sub_ps(_mm_set1_ps(1.f), x)), result);
+	}
+
+	[[gnu::target("sse4.1")]] FASTGLTF_FORCEINLINE __m128 sse4_slerp_sin(const __m128 x) {
+		const auto x2 = _mm_mul_ps(x, x);
+		auto result = _mm_set1_ps(sinCoefficients[5]);
+		for (std::size_t i = 5; i-- > 0;)
+			result = _mm_add_ps(_mm_mul_ps(result, x2), _mm_set1_ps(sinCoefficients[i]));
+		return _mm_mul_ps(result, x);
+	}
+
+	[[gnu::target("sse4.1")]] void sse4_slerp(const float* starts, const float* ends, const float* factors, float* results, std::size_t count) noexcept {
+		const auto one = _mm_set1_ps(1.f);
+		const auto signMask = _mm_set1_ps(-0.f);
+
+		std::size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			// Transpose four quaternions, so that every register holds one component of each.
+			auto ax = _mm_loadu_ps(starts + i * 4);
+			auto ay = _mm_loadu_ps(starts + i * 4 + 4);
+			auto az = _mm_loadu_ps(starts + i * 4 + 8);
+			auto aw = _mm_loadu_ps(starts + i * 4 + 12);
+			_MM_TRANSPOSE4_PS(ax, ay, az, aw);
+			auto bx = _mm_loadu_ps(ends + i * 4);
+			auto by = _mm_loadu_ps(ends + i * 4 + 4);
+			auto bz = _mm_loadu_ps(ends + i * 4 + 8);
+			auto bw = _mm_loadu_ps(ends + i * 4 + 12);
+			_MM_TRANSPOSE4_PS(bx, by, bz, bw);
+			const auto t = _mm_loadu_ps(factors + i);
+
+			auto d = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz)), _mm_mul_ps(aw, bw));
+			const auto sign = _mm_and_ps(d, signMask);
+			d = _mm_min_ps(_mm_xor_ps(d, sign), one);
+
+			const auto theta = sse4_slerp_acos(d);
+			const auto sinTheta = sse4_slerp_sin(theta);
+			const auto oneMinusT = _mm_sub_ps(one, t);
+			auto sa = _mm_div_ps(sse4_slerp_sin(_mm_mul_ps(oneMinusT, theta)), sinTheta);
+			auto sb = _mm_div_ps(sse4_slerp_sin(_mm_mul_ps(t, theta)), sinTheta);
+
+			const auto linear = _mm_cmpgt_ps(d, _mm_set1_ps(slerpLinearThreshold));
+			sa = _mm_blendv_ps(sa, oneMinusT, linear);
+			sb = _mm_xor_ps(_mm_blendv_ps(sb, t, linear), sign);
+
+			auto rx = _mm_add_ps(_mm_mul_ps(ax, sa), _mm_mul_ps(bx, sb));
+			auto ry = _mm_add_ps(_mm_mul_ps(ay, sa), _mm_mul_ps(by, sb));
+			auto rz = _mm_add_ps(_mm_mul_ps(az, sa), _mm_mul_ps(bz, sb));
+			auto rw = _mm_add_ps(_mm_mul_ps(aw, sa), _mm_mul_ps(bw, sb));
+			const auto length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, rx), _mm_mul_ps(ry, ry)), _mm_mul_ps(rz, rz)), _mm_mul_ps(rw, rw)));
+			rx = _mm_div_ps(rx, length);
+			ry = _mm_div_ps(ry, length);
+			rz = _mm_div_ps(rz, length);
+			rw = _mm_div_ps(rw, length);
+
+			_MM_TRANSPOSE4_PS(rx, ry, rz, rw);
+			_mm_storeu_ps(results + i * 4, rx);
+			_mm_storeu_ps(results + i * 4 + 4, ry);
+			_mm_storeu_ps(results + i * 4 + 8, rz);
+			_mm_storeu_ps(results + i * 4 + 12, rw);
+		}
+
+		fallback_slerp(starts + i * 4, ends + i * 4, factors + i, results + i * 4, count - i);
+	}
+#elif defined(FASTGLTF_IS_A64)
+	FASTGLTF_FORCEINLINE float32x4_t neon_slerp_acos(const float32x4_t x) {
+		auto result = vdupq_n_f32(acosCoefficients[7]);
+		for (std::size_t i = 7; i-- > 0;)
+			result = vaddq_f32(vmulq_f32(result, x), vdupq_n_f32(acosCoefficients[i]));
+		return vmulq_f32(vsqrtq_f32(vsubq_f32(vdupq_n_f32(1.f), x)), result);
+	}
+
+	FASTGLTF_FORCEINLINE float32x4_t neon_slerp_sin(const float32x4_t x) {
+		const auto x2 = vmulq_f32(x, x);
+		auto result = vdupq_n_f32(sinCoefficients[5]);
+		for (std::size_t i = 5; i-- > 0;)
+			result = vaddq_f32(vmulq_f32(result, x2), vdupq_n_f32(sinCoefficients[i]));
+		return vmulq_f32(result, x);
+	}
+
+	void neon_slerp(const float* starts, const float* ends, const float* factors, float* results, std::size_t count) noexcept {
+		const auto one = vdupq_n_f32(1.f);
+
+		std::size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			// vld4q de-interleaves four quaternions, so that every register holds one component of each.
+			const auto a = vld4q_f32(starts + i * 4);
+			const auto b = vld4q_f32(ends + i * 4);
+			const auto t = vld1q_f32(factors + i);
+
+			auto d = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_f32(a.val[0], b.val[0]), vmulq_f32(a.val[1], b.val[1])),
+					vmulq_f32(a.val[2], b.val[2])), vmulq_f32(a.val[3], b.val[3]));
+			const auto negative = vcltq_f32(d, vdupq_n_f32(0.f));
+			d = vminq_f32(vabsq_f32(d), one);
+
+			const auto theta = neon_slerp_acos(d);
+			const auto sinTheta = neon_slerp_sin(theta);
+			const auto oneMinusT = vsubq_f32(one, t);
+			auto sa = vdivq_f32(neon_slerp_sin(vmulq_f32(oneMinusT, theta)), sinTheta);
+			auto sb = vdivq_f32(neon_slerp_sin(vmulq_f32(t, theta)), sinTheta);
+
+			const auto linear = vcgtq_f32(d, vdupq_n_f32(slerpLinearThreshold));
+			sa = vbslq_f32(linear, oneMinusT, sa);
+			sb = vbslq_f32(linear, t, sb);
+			sb = vbslq_f32(negative, vnegq_f32(sb), sb);
+
+			float32x4x4_t r;
+			auto lengthSquared = vdupq_n_f32(0.f);
+			for (std::size_t j = 0; j < 4; ++j) {
+				r.val[j] = vaddq_f32(vmulq_f32(a.val[j], sa), vmulq_f32(b.val[j], sb));
+				lengthSquared = vaddq_f32(lengthSquared, vmulq_f32(r.val[j], r.val[j]));
+			}
+			const auto length = vsqrtq_f32(lengthSquared);
+			for (std::size_t j = 0; j < 4; ++j)
+				r.val[j] = vdivq_f32(r.val[j], length);
+			vst4q_f32(results + i * 4, r);
+		}
+
+		fallback_slerp(starts + i * 4, ends + i * 4, factors + i, results + i * 4, count - i);
+	}
+#endif
+
+	struct SlerpFunctionGetter {
+		SlerpFunction func;
+
+		explicit SlerpFunctionGetter() {
+			const auto& impls = simdjson::get_available_implementations();
+#if defined(FASTGLTF_IS_X86)
+			if (const auto* sse4 = impls["westmere"]; sse4 != nullptr && sse4->supported_by_runtime_system()) {
+				func = sse4_slerp;
+			}
+#elif defined(FASTGLTF_IS_A64)
+			if (const auto* neon = impls["arm64"]; neon && neon->supported_by_runtime_system()) {
+				func = neon_slerp;
+			}
+#else
+			if (false) {}
+#endif
+			else {
+				func = fallback_slerp;
+			}
+		}
+
+		static SlerpFunctionGetter* get() {
+			static SlerpFunctionGetter getter;
+			return &getter;
+		}
+	};
+} // namespace fastgltf::internal
+
+void fg::AnimationEvaluator::initializeChannels(const Animation& animation) {
+	channels.reserve(animation.channels.size());
+	for (const auto& channel : animation.channels) {
+		if (!channel.nodeIndex || channel.samplerIndex >= samplers.size())
+			continue;
+
+		const auto& sampler = samplers[channel.samplerIndex];
+		if (sampler.keyframeCount == 0)
+			continue;
+
+		const auto expectedComponents = channel.path == AnimationPath::Rotation ? 4U : 3U;
+		if (channel.path != AnimationPath::Weights && sampler.componentCount != expectedComponents)
+			continue;
+
+		channels.emplace_back(ChannelData { static_cast<std::uint32_t>(channel.samplerIndex), 0, *channel.nodeIndex, channel.path });
+		if (channel.path != AnimationPath::Weights)
+			animatedNodes.emplace_back(*channel.nodeIndex);
+
+		const auto first = inputs[sampler.inputOffset];
+		const auto last = inputs[sampler.inputOffset + sampler.keyframeCount - 1];
+		if (channels.size() == 1) {
+			startTime = first;
+			endTime = last;
+		} else {
+			startTime = fastgltf::min(startTime, first);
+			endTime = fastgltf::max(endTime, last);
+		}
+	}
+
+	std::sort(animatedNodes.begin(), animatedNodes.end());
+	animatedNodes.erase(std::unique(animatedNodes.begin(), animatedNodes.end()), animatedNodes.end());
+}
+
+float fg::AnimationEvaluator::findKeyframe(ChannelData& channel, float time, std::uint32_t& keyframe) const noexcept {
+	const auto& sampler = samplers[channel.samplerIndex];
+	const auto* times = inputs.data() + sampler.inputOffset;
+	const auto count = sampler.keyframeCount;
+
+	if (count == 1 || !(time > times[0])) {
+		keyframe = channel.cursor = 0;
+		return 0.f;
+	}
+	if (time >= times[count - 1]) {
+		keyframe = channel.cursor = count - 1;
+		return 0.f;
+	}
+
+	// We now know that times[0] < time < times[count - 1]. Animations are usually played forwards
+	// by much less than a keyframe per frame, so we first check the few keyframes after the cursor.
+	auto key = fastgltf::min(channel.cursor, count - 2);
+	if (times[key] <= time) {
+		for (std::size_t i = 0; i < 4 && times[key + 1] <= time; ++i)
+			++key;
+		if (times[key + 1] <= time)
+			key = static_cast<std::uint32_t>(std::upper_bound(times + key + 1, times + count, time) - times - 1);
+	} else {
+		key = static_cast<std::uint32_t>(std::upper_bound(times, times + key, time) - times - 1);
+	}
+
+	keyframe = channel.cursor = key;
+	return (time - times[key]) / (times[key + 1] - times[key]);
+}
+
+void fg::AnimationEvaluator::sampleKeyframes(const ChannelData& channel, std::uint32_t keyframe, float factor, float* output) const noexcept {
+	const auto& sampler = samplers[channel.samplerIndex];
+	const auto* values = outputs.data() + sampler.outputOffset;
+	const std::size_t components = sampler.componentCount;
+	const bool lastKeyframe = keyframe + 1 >= sampler.keyframeCount;
+
+	switch (sampler.interpolation) {
+		case AnimationInterpolation::Step: {
+			std::memcpy(output, values + keyframe * components, components * sizeof(float));
+			break;
+		}
+		case AnimationInterpolation::Linear: {
+			const auto* start = values + keyframe * components;
+			if (lastKeyframe || factor == 0.f) {
+				std::memcpy(output, start, components * sizeof(float));
+			} else if (channel.path == AnimationPath::Rotation) {
+				internal::slerpQuaternion(start, start + components, factor, output);
+			} else {
+				for (std::size_t i = 0; i < components; ++i)
+					output[i] = start[i] + (start[i + components] - start[i]) * factor;
+			}
+			break;
+		}
+		case AnimationInterpolation::CubicSpline: {
+			// Every keyframe has three elements: the in-tangent, the value, and the out-tangent.
+			const auto* start = values + keyframe * components * 3;
+			if (lastKeyframe || factor == 0.f) {
+				std::memcpy(output, start + components, components * sizeof(float));
+				break;
+			}
+
+			const auto* times = inputs.data() + sampler.inputOffset;
+			const auto delta = times[keyframe + 1] - times[keyframe];
+			const auto t2 = factor * factor;
+			const auto t3 = t2 * factor;
+			const auto h00 = 2 * t3 - 3 * t2 + 1;
+			const auto h10 = (t3 - 2 * t2 + factor) * delta;
+			const auto h01 = -2 * t3 + 3 * t2;
+			const auto h11 = (t3 - t2) * delta;
+
+			const auto* end = start + components * 3;
+			for (std::size_t i = 0; i < components; ++i) {
+				output[i] = h00 * start[components + i] + h10 * start[components * 2 + i]
+					+ h01 * end[components + i] + h11 * end[i];
+			}
+
+			if (channel.path == AnimationPath::Rotation) {
+				float length = 0.f;
+				for (std::size_t i = 0; i < 4; ++i)
+					length += output[i] * output[i];
+				length = std::sqrt(length);
+				for (std::size_t i = 0; i < 4; ++i)
+					output[i] /= length;
+			}
+			break;
+		}
+	}
+}
+
+void fg::AnimationEvaluator::sampleChannel(std::size_t channelIndex, float time, float* output) {
+	auto& channel = channels[channelIndex];
+	std::uint32_t keyframe;
+	const auto factor = findKeyframe(channel, time, keyframe);
+	sampleKeyframes(channel, keyframe, factor, output);
+}
+
+void fg::AnimationEvaluator::evaluate(float time, span<TRS> transforms) {
+	rotationStarts.clear();
+	rotationEnds.clear();
+	rotationFactors.clear();
+	rotationTargets.clear();
+
+	for (auto& channel : channels) {
+		if (channel.path == AnimationPath::Weights)
+			continue;
+		assert(channel.nodeIndex < transforms.size());
+		auto& trs = transforms[channel.nodeIndex];
+
+		std::uint32_t keyframe;
+		const auto factor = findKeyframe(channel, time, keyframe);
+
+		switch (channel.path) {
+			case AnimationPath::Translation:
+				sampleKeyframes(channel, keyframe, factor, trs.translation.data());
+				break;
+			case AnimationPath::Scale:
+				sampleKeyframes(channel, keyframe, factor, trs.scale.data());
+				break;
+			case AnimationPath::Rotation: {
+				const auto& sampler = samplers[channel.samplerIndex];
+				if (sampler.interpolation != AnimationInterpolation::Linear || factor == 0.f) {
+					sampleKeyframes(channel, keyframe, factor, trs.rotation.data());
+					break;
+				}
+
+				const auto* start = outputs.data() + sampler.outputOffset + keyframe * 4;
+				rotationStarts.insert(rotationStarts.end(), start, start + 4);
+				rotationEnds.insert(rotationEnds.end(), start + 4, start + 8);
+				rotationFactors.emplace_back(factor);
+				rotationTargets.emplace_back(channel.nodeIndex);
+				break;
+			}
+			case AnimationPath::Weights:
+				break;
+		}
+	}
+
+	if (rotationTargets.empty())
+		return;
+
+	rotationResults.resize(rotationStarts.size());
+	internal::SlerpFunctionGetter::get()->func(rotationStarts.data(), rotationEnds.data(), rotationFactors.data(),
+			rotationResults.data(), rotationTargets.size());
+	for (std::size_t i = 0; i < rotationTargets.size(); ++i) {
+		const auto* result = rotationResults.data() + i * 4;
+		transforms[rotationTargets[i]].rotation = math::fquat(result[0], result[1], result[2], result[3]);
+	}
+}
+
+void fg::AnimationEvaluator::evaluate(float time, span<TRS> transforms, SceneTransformCache& cache) {
+	evaluate(time, transforms);
+	for (const auto nodeIndex : animatedNodes) {
+		if (cache.contains(nodeIndex))
+			cache.setLocalTransform(nodeIndex, transforms[nodeIndex]);
+	}
+}
+
+namespace fastgltf::internal {
+	/**
+	 * Computes worlds[i] * inverseBindMatrices[i] for every joint. With affine set, only the upper three
+	 * rows are written, row by row, with 12 floats per joint. Otherwise, 16 floats are written per joint in
+	 * column-major order.
+	 */
+	using MultiplyJointsFunction = void(*)(const math::fmat4x4* const* worlds, const math::fmat4x4* inverseBindMatrices,
+			float* dst, std::size_t count, bool affine) noexcept;
+
+	void fallback_multiply_joints(const math::fmat4x4* const* worlds, const math::fmat4x4* inverseBindMatrices,
+			float* dst, std::size_t count, bool affine) noexcept {
+		for (std::size_t i = 0; i < count; ++i) {
+			const auto joint = *worlds[i] * inverseBindMatrices[i];
+			if (!affine) {
+				std::memcpy(dst + i * 16, joint.col(0).data(), sizeof joint);
+				continue;
+			}
+
+			for (std::size_t row = 0; row < 3; ++row)
+				for (std::size_t column = 0; column < 4; ++column)
+					dst[i * 12 + row * 4 + column] = joint.col(column)[row];
+		}
+	}
+
+#if defined(FASTGLTF_IS_X86)
+	[[gnu::target("sse4.1")]] void sse4_multiply_joints(const math::fmat4x4* const* worlds, const math::fmat4x4* inverseBindMatrices,
+			float* dst, std::size_t count, bool affine) noexcept {
+		for (std::size_t i = 0; i < count; ++i) {
+			const auto* world = worlds[i]->col(0).data();
+			const __m128 columns[4] = {
+				_mm_loadu_ps(world), _mm_loadu_ps(world + 4), _mm_loadu_ps(world + 8), _mm_loadu_ps(world + 12),
+			};
+
+			const auto* weights = inverseBindMatrices[i].col(0).data();
+			auto r0 = sse4_combine_columns(columns, weights);
+			auto r1 = sse4_combine_columns(columns, weights + 4);
+			auto r2 = sse4_combine_columns(columns, weights + 8);
+			auto r3 = sse4_combine_columns(columns, weights + 12);
+
+			if (!affine) {
+				_mm_storeu_ps(dst + i * 16, r0);
+				_mm_storeu_ps(dst + i * 16 + 4, r1);
+				_mm_storeu_ps(dst + i * 16 + 8, r2);
+				_mm_storeu_ps(dst + i * 16 + 12, r3);
+				continue;
+			}
+
+			// After transposing, the registers hold the rows of the joint matrix.
+			_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+			_mm_storeu_ps(dst + i * 12, r0);
+			_mm_storeu_ps(dst + i * 12 + 4, r1);
+			_mm_storeu_ps(dst + i * 12 + 8, r2);
+		}
+	}
+#elif defined(FASTGLTF_IS_A64)
+	void neon_multiply_joints(const math::fmat4x4* const* worlds, const math::fmat4x4* inverseBindMatrices,
+			float* dst, std::size_t count, bool affine) noexcept {
+		for (std::size_t i = 0; i < count; ++i) {
+			const auto* world = worlds[i]->col(0).data();
+			const auto c0 = vld1q_f32(world);
+			const auto c1 = vld1q_f32(world + 4);
+			const auto c2 = vld1q_f32(world + 8);
+			const auto c3 = vld1q_f32(world + 12);
+
+			const auto* weights = inverseBindMatrices[i].col(0).data();
+			float32x4x4_t result;
+			for (std::size_t j = 0; j < 4; ++j) {
+				const auto w = vld1q_f32(weights + j * 4);
+				auto column = vmulq_laneq_f32(c0, w, 0);
+				column = vaddq_f32(column, vmulq_laneq_f32(c1, w, 1));
+				column = vaddq_f32(column, vmulq_laneq_f32(c2, w, 2));
+				result.val[j] = vaddq_f32(column, vmulq_laneq_f32(c3, w, 3));
+			}
+
+			if (!affine) {
+				for (std::size_t j = 0; j < 4; ++j)
+					vst1q_f32(dst + i * 16 + j * 4, result.val[j]);
+				continue;
+			}
+
+			// vst4q interleaves the columns, which writes the matrix row by row.
+			float rows[16];
+			vst4q_f32(rows, result);
+			std::memcpy(dst + i * 12, rows, sizeof(float) * 12);
+		}
+	}
+#endif
+
+	struct MultiplyJointsGetter {
+		MultiplyJointsFunction func;
+
+		explicit MultiplyJointsGetter() {
+			const auto& impls = simdjson::get_available_implementations();
+#if defined(FASTGLTF_IS_X86)
+			if (const auto* sse4 = impls["westmere"]; sse4 != nullptr && sse4->supported_by_runtime_system()) {
+				func = sse4_multiply_joints;
+			}
+#elif defined(FASTGLTF_IS_A64)
+			if (const auto* neon = impls["arm64"]; neon && neon->supported_by_runtime_system()) {
+				func = neon_multiply_joints;
+			}
+#else
+			if (false) {}
+#endif
+			else {
+				func = fallback_multiply_joints;
+			}
+		}
+
+		static MultiplyJointsGetter* get() {
+			static MultiplyJointsGetter getter;
+			return &getter;
+		}
+	};
+} // namespace fastgltf::internal
+
+void fg::SkinPalette::gatherWorldMatrices(const SceneTransformCache& cache) {
+	static const math::fmat4x4 identity;
+
+	jointWorldMatrices.resize(jointNodes.size());
+	for (std::size_t i = 0; i < jointNodes.size(); ++i) {
+		jointWorldMatrices[i] = cache.contains(jointNodes[i]) ? &cache.getWorldMatrix(jointNodes[i]) : &identity;
+	}
+}
+
+void fg::SkinPalette::computeJointMatrices(const SceneTransformCache& cache, span<math::fmat4x4> palette) {
+	assert(palette.size() >= jointNodes.size());
+	if (jointNodes.empty())
+		return;
+
+	gatherWorldMatrices(cache);
+	internal::MultiplyJointsGetter::get()->func(jointWorldMatrices.data(), inverseBindMatrices.data(),
+			palette.data()->col(0).data(), jointNodes.size(), false);
+}
+
+void fg::SkinPalette::computeJointMatrices(const SceneTransformCache& cache, span<math::fmat<4, 3>> palette) {
+	static_assert(sizeof(math::fmat<4, 3>) == sizeof(float) * 12);
+	assert(palette.size() >= jointNodes.size());
+	if (jointNodes.empty())
+		return;
+
+	gatherWorldMatrices(cache);
+	internal::MultiplyJointsGetter::get()->func(jointWorldMatrices.data(), inverseBindMatrices.data(),
+			palette.data()->col(0).data(), jointNodes.size(), true);
+}
+
+namespace fastgltf::internal {
+	/**
+	 * Merges count elements of three floats into min and max. Both point to four floats, and the
+	 * kernels may write anything into the fourth one.
+	 */
+	using Vec3BoundsFunction = void(*)(const std::byte* src, std::size_t stride, std::size_t count, float* min, float* max) noexcept;
+
+	FASTGLTF_FORCEINLINE void mergeVec3Element(const std::byte* src, float* min, float* max) noexcept {
+		float element[3];
+		std::memcpy(element, src, sizeof element);
+		for (std::size_t j = 0; j < 3; ++j) {
+			// Comparing this way around ignores NaNs, just like the SIMD kernels.
+			min[j] = element[j] < min[j] ? element[j] : min[j];
+			max[j] = element[j] > max[j] ? element[j] : max[j];
+		}
+	}
+
+	/**
+	 * For tightly packed elements, the loads are independent of the element boundaries. The component
+	 * of lane k of the r-th consecutive register is (r * Width + k) % 3, which repeats after three registers.
+	 * Every one of these three registers therefore gets its own accumulator, which are folded back here.
+	 */
+	template <std::size_t Width>
+	void foldPackedAccumulators(const float (&mins)[3][Width], const float (&maxs)[3][Width], float* min, float* max) noexcept {
+		for (std::size_t r = 0; r < 3; ++r) {
+			for (std::size_t k = 0; k < Width; ++k) {
+				const auto component = (r * Width + k) % 3;
+				min[component] = fastgltf::min(min[component], mins[r][k]);
+				max[component] = fastgltf::max(max[component], maxs[r][k]);
+			}
+		}
+	}
+
+	void fallback_vec3_bounds(const std::byte* src, std::size_t stride, std::size_t count, float* min, float* max) noexcept {
+		for (std::size_t i = 0; i < count; ++i) {
+			mergeVec3Element(src + i * stride, min, max);
+		}
+	}
+
+#if defined(FASTGLTF_IS_X86)
+	[[gnu::target("sse4.1")]] void sse4_vec3_bounds(const std::byte* src, std::size_t stride, std::size_t count, float* min, float* max) noexcept {
+		std::size_t i = 0;
+		if (stride == 3 * sizeof(float)) {
+			// Four packed elements are exactly three registers.
+			__m128 mins[3], maxs[3];
+			for (std::size_t r = 0; r < 3; ++r) {
+				mins[r] = _mm_set1_ps(std::numeric_limits<float>::infinity());
+				maxs[r] = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+			}
+			const auto* floats = reinterpret_cast<const float*>(src);
+			for (; i + 4 <= count; i += 4) {
+				for (std::size_t r = 0; r < 3; ++r) {
+					const auto values = _mm_loadu_ps(floats + i * 3 + r * 4);
+					mins[r] = _mm_min_ps(values, mins[r]);
+					maxs[r] = _mm_max_ps(values, maxs[r]);
+				}
+			}
+
+			float foldedMins[3][4], foldedMaxs[3][4];
+			for (std::size_t r = 0; r < 3; ++r) {
+				_mm_storeu_ps(foldedMins[r], mins[r]);
+				_mm_storeu_ps(foldedMaxs[r], maxs[r]);
+			}
+			foldPackedAccumulators(foldedMins, foldedMaxs, min, max);
+		} else if (count > 1) {
+			// Loading 16 bytes also reads the start of the next element, so the last element is merged separately.
+			auto min0 = _mm_loadu_ps(min), min1 = min0;
+			auto max0 = _mm_loadu_ps(max), max1 = max0;
+			for (; i + 2 < count; i += 2) {
+				const auto a = _mm_loadu_ps(reinterpret_cast<const float*>(src + i * stride));
+				const auto b = _mm_loadu_ps(reinterpret_cast<const float*>(src + (i + 1) * stride));
+				min0 = _mm_min_ps(a, min0);
+				max0 = _mm_max_ps(a, max0);
+				min1 = _mm_min_ps(b, min1);
+				max1 = _mm_max_ps(b, max1);
+			}
+			_mm_storeu_ps(min, _mm_min_ps(min0, min1));
+			_mm_storeu_ps(max, _mm_max_ps(max0, max1));
+		}
+
+		for (; i < count; ++i) {
+			mergeVec3Element(src + i * stride, min, max);
+		}
+	}
+
+	/** Loads the elements at index and index + 1 into the lower and upper half of the register. */
+	[[gnu::target("avx2")]] FASTGLTF_FORCEINLINE __m256 avx2_load_two_elements(const std::byte* src, std::size_t stride, std::size_t index) {
+		const auto low = _mm_loadu_ps(reinterpret_cast<const float*>(src + index * stride));
+		const auto high = _mm_loadu_ps(reinterpret_cast<const float*>(src + (index + 1) * stride));
+		return _mm256_insertf128_ps(_mm256_castps128_ps256(low), high, 1);
+	}
+
+	[[gnu::target("avx2")]] void avx2_vec3_bounds(const std::byte* src, std::size_t stride, std::size_t count, float* min, float* max) noexcept {
+		std::size_t i = 0;
+		if (stride == 3 * sizeof(float)) {
+			// Eight packed elements are exactly three registers.
+			__m256 mins[3], maxs[3];
+			for (std::size_t r = 0; r < 3; ++r) {
+				mins[r] = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+				maxs[r] = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+			}
+			const auto* floats = reinterpret_cast<const float*>(src);
+			for (; i + 8 <= count; i += 8) {
+				for (std::size_t r = 0; r < 3; ++r) {
+					const auto values = _mm256_loadu_ps(floats + i * 3 + r * 8);
+					mins[r] = _mm256_min_ps(values, mins[r]);
+					maxs[r] = _mm256_max_ps(values, maxs[r]);
+				}
+			}
+
+			float foldedMins[3][8], foldedMaxs[3][8];
+			for (std::size_t r = 0; r < 3; ++r) {
+				_mm256_storeu_ps(foldedMins[r], mins[r]);
+				_mm256_storeu_ps(foldedMaxs[r], maxs[r]);
+			}
+			foldPackedAccumulators(foldedMins, foldedMaxs, min, max);
+		} else if (count > 1) {
+			// Two strided elements per register, with the same overlapping loads as the SSE4 kernel.
+			auto min0 = _mm256_castps128_ps256(_mm_loadu_ps(min));
+			min0 = _mm256_insertf128_ps(min0, _mm_loadu_ps(min), 1);
+			auto max0 = _mm256_castps128_ps256(_mm_loadu_ps(max));
+			max0 = _mm256_insertf128_ps(max0, _mm_loadu_ps(max), 1);
+			auto min1 = min0, max1 = max0;
+			for (; i + 4 < count; i += 4) {
+				const auto a = avx2_load_two_elements(src, stride, i);
+				const auto b = avx2_load_two_elements(src, stride, i + 2);
+				min0 = _mm256_min_ps(a, min0);
+				max0 = _mm256_max_ps(a, max0);
+				min1 = _mm256_min_ps(b, min1);
+				max1 = _mm256_max_ps(b, max1);
+			}
+			min0 = _mm256_min_ps(min0, min1);
+			max0 = _mm256_max_ps(max0, max1);
+			_mm_storeu_ps(min, _mm_min_ps(_mm256_castps256_ps128(min0), _mm256_extractf128_ps(min0, 1)));
+			_mm_storeu_ps(max, _mm_max_ps(_mm256_castps256_ps128(max0), _mm256_extractf128_ps(max0, 1)));
+		}
+
+		for (; i < count; ++i) {
+			mergeVec3Element(src + i * stride, min, max);
+		}
+	}
+#elif defined(FASTGLTF_IS_A64)
+	void neon_vec3_bounds(const std::byte* src, std::size_t stride, std::size_t count, float* min, float* max) noexcept {
+		std::size_t i = 0;
+		if (stride == 3 * sizeof(float)) {
+			// Four packed elements are exactly three registers.
+			float32x4_t mins[3], maxs[3];
+			for (std::size_t r = 0; r < 3; ++r) {
+				mins[r] = vdupq_n_f32(std::numeric_limits<float>::infinity());
+				maxs[r] = vdupq_n_f32(-std::numeric_limits<float>::infinity());
+			}
+			const auto* floats = reinterpret_cast<const float*>(src);
+			for (; i + 4 <= count; i += 4) {
+				for (std::size_t r = 0; r < 3; ++r) {
+					const auto values = vld1q_f32(floats + i * 3 + r * 4);
+					mins[r] = vminnmq_f32(values, mins[r]);
+					maxs[r] = vmaxnmq_f32(values, maxs[r]);
+				}
+			}
+
+			float foldedMins[3][4], foldedMaxs[3][4];
+			for (std::size_t r = 0; r < 3; ++r) {
+				vst1q_f32(foldedMins[r], mins[r]);
+				vst1q_f32(foldedMaxs[r], maxs[r]);
+			}
+			foldPackedAccumulators(foldedMins, foldedMaxs, min, max);
+		} else if (count > 1) {
+			// Loading 16 bytes also reads the start of the next element, so the last element is merged separately.
+			auto min0 = vld1q_f32(min), min1 = min0;
+			auto max0 = vld1q_f32(max), max1 = max0;
+			for (; i + 2 < count; i += 2) {
+				const auto a = vld1q_f32(reinterpret_cast<const float*>(src + i * stride));
+				const auto b = vld1q_f32(reinterpret_cast<const float*>(src + (i + 1) * stride));
+				min0 = vminnmq_f32(a, min0);
+				max0 = vmaxnmq_f32(a, max0);
+				min1 = vminnmq_f32(b, min1);
+				max1 = vmaxnmq_f32(b, max1);
+			}
+			vst1q_f32(min, vminnmq_f32(min0, min1));
+			vst1q_f32(max, vmaxnmq_f32(max0, max1));
+		}
+
+		for (; i < count; ++i) {
+			mergeVec3Element(src + i * stride, min, max);
+		}
+	}
+#endif
+
+	struct Vec3BoundsGetter {
+		Vec3BoundsFunction func;
+
+		explicit Vec3BoundsGetter() {
+			const auto& impls = simdjson::get_available_implementations();
+#if defined(FASTGLTF_IS_X86)
+			if (const auto* avx2 = impls["haswell"]; avx2 != nullptr && avx2->supported_by_runtime_system()) {
+				func = avx2_vec3_bounds;
+			} else if (const auto* sse4 = impls["westmere"]; sse4 != nullptr && sse4->supported_by_runtime_system()) {
+				func = sse4_vec3_bounds;
+			}
+#elif defined(FASTGLTF_IS_A64)
+			if (const auto* neon = impls["arm64"]; neon && neon->supported_by_runtime_system()) {
+				func = neon_vec3_bounds;
+			}
+#else
+			if (false) {}
+#endif
+			else {
+				func = fallback_vec3_bounds;
+			}
+		}
+
+		static Vec3BoundsGetter* get() {
+			static Vec3BoundsGetter getter;
+			return &getter;
+		}
+	};
+} // namespace fastgltf::internal
+
+void fg::internal::mergeVec3Bounds(const std::byte* src, std::size_t stride, ComponentType componentType, bool normalized,
+		std::size_t count, math::fvec3& min, math::fvec3& max) noexcept {
+	float mins[4] = { min[0], min[1], min[2], 0.f };
+	float maxs[4] = { max[0], max[1], max[2], 0.f };
+
+	const auto merge = Vec3BoundsGetter::get()->func;
+	if (componentType == ComponentType::Float) {
+		merge(src, stride, count, mins, maxs);
+	} else {
+		// Other component types are converted into a small batch of packed floats first.
+		constexpr std::size_t batchSize = 256;
+		std::array<float, batchSize * 3> batch;
+		auto* batchBytes = reinterpret_cast<std::byte*>(batch.data());
+		for (std::size_t first = 0; first < count; first += batchSize) {
+			const auto batchCount = fastgltf::min(batchSize, count - first);
+			const auto* batchSrc = src + first * stride;
+			if (!convertComponents(batchSrc, stride, componentType, batchBytes, 3 * sizeof(float), ComponentType::Float, 3, batchCount, normalized)) {
+				for (std::size_t i = 0; i < batchCount; ++i) {
+					for (std::size_t j = 0; j < 3; ++j) {
+						batch[i * 3 + j] = getAccessorComponentAt<float>(componentType, AccessorType::Vec3, batchSrc + i * stride, j, normalized);
+					}
+				}
+			}
+			merge(batchBytes, 3 * sizeof(float), batchCount, mins, maxs);
+		}
+	}
+
+	for (std::size_t j = 0; j < 3; ++j) {
+		min[j] = mins[j];
+		max[j] = maxs[j];
+	}
+}
+
+fg::BoundingBox fg::transformBounds(const BoundingBox& bounds, const math::fmat4x4& matrix) noexcept {
+	if (bounds.empty())
+		return bounds;
+
+	// Every column of the matrix scales one axis of the box, and the smaller and larger products
+	// of each contribute to the new minimum and maximum respectively.
+	BoundingBox result;
+	for (std::size_t i = 0; i < 3; ++i) {
+		result.min[i] = result.max[i] = matrix.col(3)[i];
+	}
+	for (std::size_t column = 0; column < 3; ++column) {
+		for (std::size_t row = 0; row < 3; ++row) {
+			const auto a = matrix.col(column)[row] * bounds.min[column];
+			const auto b = matrix.col(column)[row] * bounds.max[column];
+			result.min[row] += fastgltf::min(a, b);
+			result.max[row] += fastgltf::max(a, b);
+		}
+	}
+	return result;
+}
+
+namespace fastgltf::internal {
+	/** Half of the surface area of the box, which is all the surface area heuristic needs. */
+	float getHalfArea(const BoundingBox& bounds) noexcept {
+		if (bounds.empty())
+			return 0.f;
+		const auto dx = bounds.max.x() - bounds.min.x();
+		const auto dy = bounds.max.y() - bounds.min.y();
+		const auto dz = bounds.max.z() - bounds.min.z();
+		return dx * dy + dy * dz + dz * dx;
+	}
+} // namespace fastgltf::internal
+
+fg::SceneBVH::SceneBVH(const Asset& asset, const SceneTransformCache& cache, span<const BoundingBox> meshBounds) {
+	const auto sceneNodes = cache.getNodeIndices();
+	const auto worldMatrices = cache.getWorldMatrices();
+
+	std::vector<std::size_t> itemNodes;
+	std::vector<BoundingBox> itemLocalBounds;
+	std::vector<BoundingBox> itemWorldBounds;
+	for (std::size_t i = 0; i < sceneNodes.size(); ++i) {
+		const auto& node = asset.nodes[sceneNodes[i]];
+		if (!node.meshIndex || *node.meshIndex >= meshBounds.size() || meshBounds[*node.meshIndex].empty())
+			continue;
+
+		itemNodes.emplace_back(sceneNodes[i]);
+		itemLocalBounds.emplace_back(meshBounds[*node.meshIndex]);
+		itemWorldBounds.emplace_back(transformBounds(meshBounds[*node.meshIndex], worldMatrices[i]));
+	}
+
+	const auto itemCount = static_cast<std::uint32_t>(itemNodes.size());
+	if (itemCount == 0)
+		return;
+
+	std::vector<math::fvec3> centroids(itemCount);
+	for (std::size_t i = 0; i < itemCount; ++i) {
+		for (std::size_t j = 0; j < 3; ++j)
+			centroids[i][j] = (itemWorldBounds[i].min[j] + itemWorldBounds[i].max[j]) * 0.5f;
+	}
+
+	// Items are partitioned in place, so every subtree references one contiguous range of them.
+	std::vector<std::uint32_t> order(itemCount);
+	for (std::uint32_t i = 0; i < itemCount; ++i)
+		order[i] = i;
+
+	constexpr std::size_t binCount = 16;
+	constexpr std::uint32_t maxLeafSize = 8;
+	struct BuildTask {
+		std::uint32_t node;
+		std::uint32_t begin;
+		std::uint32_t end;
+	};
+	std::vector<BuildTask> tasks;
+	nodes.reserve(2 * itemCount - 1);
+	nodes.push_back({});
+	tasks.push_back({ 0, 0, itemCount });
+
+	while (!tasks.empty()) {
+		const auto task = tasks.back();
+		tasks.pop_back();
+		const auto count = task.end - task.begin;
+
+		BoundingBox bounds, centroidBounds;
+		for (auto i = task.begin; i < task.end; ++i) {
+			bounds.merge(itemWorldBounds[order[i]]);
+			centroidBounds.merge(centroids[order[i]]);
+		}
+		nodes[task.node].min = bounds.min;
+		nodes[task.node].max = bounds.max;
+		nodes[task.node].first = task.begin;
+		nodes[task.node].count = count;
+		if (count <= 2)
+			continue;
+
+		std::size_t axis = 0;
+		for (std::size_t j = 1; j < 3; ++j) {
+			if (centroidBounds.max[j] - centroidBounds.min[j] > centroidBounds.max[axis] - centroidBounds.min[axis])
+				axis = j;
+		}
+		const auto axisMin = centroidBounds.min[axis];
+		const auto extent = centroidBounds.max[axis] - centroidBounds.min[axis];
+
+		auto getBin = [&](std::uint32_t item) {
+			const auto bin = static_cast<std::size_t>((centroids[item][axis] - axisMin) * (binCount / extent));
+			return fastgltf::min(bin, binCount - 1);
+		};
+
+		auto mid = task.begin + count / 2;
+		if (extent > 0.f) {
+			std::array<BoundingBox, binCount> binBounds;
+			std::array<std::uint32_t, binCount> binCounts {};
+			for (auto i = task.begin; i < task.end; ++i) {
+				const auto bin = getBin(order[i]);
+				binBounds[bin].merge(itemWorldBounds[order[i]]);
+				++binCounts[bin];
+			}
+
+			// Sweep from the right to get the cost of every right side, and then from the left to find the cheapest split.
+			std::array<float, binCount> rightCosts {};
+			BoundingBox right;
+			std::uint32_t rightCount = 0;
+			for (auto bin = binCount - 1; bin > 0; --bin) {
+				right.merge(binBounds[bin]);
+				rightCount += binCounts[bin];
+				rightCosts[bin - 1] = static_cast<float>(rightCount) * internal::getHalfArea(right);
+			}
+
+			auto bestCost = std::numeric_limits<float>::infinity();
+			std::size_t bestSplit = 0;
+			BoundingBox left;
+			std::uint32_t leftCount = 0;
+			for (std::size_t bin = 0; bin + 1 < binCount; ++bin) {
+				left.merge(binBounds[bin]);
+				leftCount += binCounts[bin];
+				if (leftCount == 0 || leftCount == count)
+					continue;
+				const auto cost = static_cast<float>(leftCount) * internal::getHalfArea(left) + rightCosts[bin];
+				if (cost < bestCost) {
+					bestCost = cost;
+					bestSplit = bin;
+				}
+			}
+
+			// Keep small sets of items as a leaf if splitting them wouldn't make culling any cheaper.
+			if (count <= maxLeafSize && bestCost >= static_cast<float>(count) * internal::getHalfArea(bounds))
+				continue;
+
+			if (bestCost < std::numeric_limits<float>::infinity()) {
+				auto* split = std::partition(order.data() + task.begin, order.data() + task.end, [&](std::uint32_t item) {
+					return getBin(item) <= bestSplit;
+				});
+				mid = static_cast<std::uint32_t>(split - order.data());
+			}
+		} else if (count <= maxLeafSize) {
+			continue;
+		}
+
+		const auto firstChild = static_cast<std::uint32_t>(nodes.size());
+		nodes[task.node].first = firstChild;
+		nodes[task.node].count = 0;
+		nodes.push_back({});
+		nodes.push_back({});
+		tasks.push_back({ firstChild + 1, mid, task.end });
+		tasks.push_back({ firstChild, task.begin, mid });
+	}
+
+	nodeIndices.resize(itemCount);
+	localBounds.resize(itemCount);
+	worldBounds.resize(itemCount);
+	for (std::size_t i = 0; i < itemCount; ++i) {
+		nodeIndices[i] = itemNodes[order[i]];
+		localBounds[i] = itemLocalBounds[order[i]];
+		worldBounds[i] = itemWorldBounds[order[i]];
+	}
+}
+
+void fg::SceneBVH::refitNodes() {
+	// Children are always stored after their parent, so a single backwards pass is enough.
+	for (auto i = nodes.size(); i-- > 0;) {
+		auto& node = nodes[i];
+		BoundingBox bounds;
+		if (node.count != 0) {
+			for (auto item = node.first; item < node.first + node.count; ++item)
+				bounds.merge(worldBounds[item]);
+		} else {
+			bounds.merge(BoundingBox { nodes[node.first].min, nodes[node.first].max });
+			bounds.merge(BoundingBox { nodes[node.first + 1].min, nodes[node.first + 1].max });
+		}
+		node.min = bounds.min;
+		node.max = bounds.max;
+	}
+}
+
+void fg::SceneBVH::refit(const SceneTransformCache& cache) {
+	for (std::size_t i = 0; i < nodeIndices.size(); ++i) {
+		worldBounds[i] = transformBounds(localBounds[i], cache.getWorldMatrix(nodeIndices[i]));
+	}
+	refitNodes();
+}
+
+void fg::SceneBVH::cull(span<const math::fvec4> planes, std::vector<std::size_t>& visibleNodes) const {
+	assert(planes.size() <= 32 && "Only up to 32 planes are supported.");
+	if (nodes.empty())
+		return;
+
+	// Checks the box against every plane in the mask, and returns the planes the box is not completely inside of,
+	// or std::nullopt if the box is completely outside of any plane.
+	auto testPlanes = [&](const math::fvec3& min, const math::fvec3& max, std::uint32_t mask) -> std::optional<std::uint32_t> {
+		for (std::uint32_t i = 0; i < planes.size(); ++i) {
+			if ((mask & (1U << i)) == 0)
+				continue;
+
+			const auto& plane = planes[i];
+			float farthest = plane.w(), nearest = plane.w();
+			for (std::size_t j = 0; j < 3; ++j) {
+				farthest += plane[j] * (plane[j] >= 0.f ? max[j] : min[j]);
+				nearest += plane[j] * (plane[j] >= 0.f ? min[j] : max[j]);
+			}
+			if (farthest < 0.f)
+				return std::nullopt;
+			if (nearest >= 0.f)
+				mask &= ~(1U << i);
+		}
+		return mask;
+	};
+
+	struct StackEntry {
+		std::uint32_t node;
+		std::uint32_t mask;
+	};
+	std::vector<StackEntry> stack;
+	stack.reserve(64);
+	stack.push_back({ 0, planes.size() == 32 ? ~0U : (1U << planes.size()) - 1 });
+
+	while (!stack.empty()) {
+		const auto entry = stack.back();
+		stack.pop_back();
+
+		const auto& node = nodes[entry.node];
+		auto mask = entry.mask;
+		if (mask != 0) {
+			const auto result = testPlanes(node.min, node.max, mask);
+			if (!result)
+				continue;
+			mask = *result;
+		}
+
+		if (node.count == 0) {
+			stack.push_back({ node.first + 1, mask });
+			stack.push_back({ node.first, mask });
+			continue;
+		}
+
+		for (auto item = node.first; item < node.first + node.count; ++item) {
+			if (mask == 0 || testPlanes(worldBounds[item].min, worldBounds[item].max, mask)) {
+				visibleNodes.emplace_back(nodeIndices[item]);
+			}
+		}
+	}
+}
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
@@ -1,6 +1,8 @@
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include <simdjson.h>
+
 #include <fastgltf/core.hpp>
 #include <fastgltf/tools.hpp>
 #include "gltf_path.hpp"
@@ -149,6 +151,84 @@ TEST_CASE("Test matrix transpose", "[gltf-tools]") {
 	}
 }
 
+template <typename Src, typename Dst, typename Function>
+static void testComponentConversion(Function&& convert, fastgltf::ComponentType srcType, fastgltf::ComponentType dstType) {
+	// Covers packed and strided layouts on both sides, and counts that don't fill an entire vector.
+	std::vector<std::byte> src(1024);
+	for (std::size_t i = 0; i < src.size(); ++i) {
+		src[i] = static_cast<std::byte>(i * 67 + 13);
+	}
+	for (std::size_t componentCount = 1; componentCount <= 4; ++componentCount) {
+		for (auto srcPadding : {0U, 3U}) {
+			for (auto dstPadding : {0U, 4U}) {
+				for (auto normalized : {false, true}) {
+					const auto srcStride = componentCount * sizeof(Src) + srcPadding;
+					const auto dstStride = componentCount * sizeof(Dst) + dstPadding;
+					const auto count = (src.size() - componentCount * sizeof(Src)) / srcStride;
+
+					std::vector<std::byte> dst(count * dstStride, std::byte(0xCD));
+					REQUIRE(convert(src.data(), srcStride, srcType, dst.data(), dstStride, dstType, componentCount, count, normalized));
+					for (std::size_t i = 0; i < count; ++i) {
+						for (std::size_t j = 0; j < componentCount; ++j) {
+							auto expected = fastgltf::internal::convertComponent<Dst>(
+									fastgltf::internal::deserializeComponent<Src>(&src[i * srcStride], j), normalized);
+							Dst value;
+							std::memcpy(&value, &dst[i * dstStride + j * sizeof(Dst)], sizeof value);
+							REQUIRE(value == expected);
+						}
+						for (std::size_t j = componentCount * sizeof(Dst); j < dstStride; ++j) {
+							REQUIRE(dst[i * dstStride + j] == std::byte(0xCD));
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+template <typename Function>
+static void testComponentConversions(Function&& convert) {
+	testComponentConversion<std::int8_t, float>(convert, fastgltf::ComponentType::Byte, fastgltf::ComponentType::Float);
+	testComponentConversion<std::uint8_t, float>(convert, fastgltf::ComponentType::UnsignedByte, fastgltf::ComponentType::Float);
+	testComponentConversion<std::int16_t, float>(convert, fastgltf::ComponentType::Short, fastgltf::ComponentType::Float);
+	testComponentConversion<std::uint16_t, float>(convert, fastgltf::ComponentType::UnsignedShort, fastgltf::ComponentType::Float);
+	testComponentConversion<std::uint8_t, std::uint32_t>(convert, fastgltf::ComponentType::UnsignedByte, fastgltf::ComponentType::UnsignedInt);
+	testComponentConversion<std::uint16_t, std::uint32_t>(convert, fastgltf::ComponentType::UnsignedShort, fastgltf::ComponentType::UnsignedInt);
+	testComponentConversion<std::uint8_t, std::uint16_t>(convert, fastgltf::ComponentType::UnsignedByte, fastgltf::ComponentType::UnsignedShort);
+
+	// Conversions without a kernel have to be rejected without writing anything.
+	std::array<std::byte, 16> bytes {};
+	REQUIRE(!convert(bytes.data(), 4, fastgltf::ComponentType::Float, bytes.data(), 4, fastgltf::ComponentType::Float, 1, 4, false));
+	REQUIRE(!convert(bytes.data(), 16, fastgltf::ComponentType::UnsignedByte, bytes.data(), 16, fastgltf::ComponentType::Float, 16, 1, false));
+}
+
+TEST_CASE("Test SIMD component conversion", "[gltf-tools]") {
+	SECTION("Fallback") {
+		testComponentConversions(fastgltf::internal::fallback_convert_components);
+	}
+
+#if defined(FASTGLTF_IS_X86)
+	const auto& impls = simdjson::get_available_implementations();
+	if (const auto* sse4 = impls["westmere"]; sse4 != nullptr && sse4->supported_by_runtime_system()) {
+		SECTION("SSE4") {
+			testComponentConversions(fastgltf::internal::sse4_convert_components);
+		}
+	}
+	if (const auto* avx2 = impls["haswell"]; avx2 != nullptr && avx2->supported_by_runtime_system()) {
+		SECTION("AVX2") {
+			testComponentConversions(fastgltf::internal::avx2_convert_components);
+		}
+	}
+#elif defined(FASTGLTF_IS_A64)
+	const auto& impls = simdjson::get_available_implementations();
+	if (const auto* neon = impls["arm64"]; neon != nullptr && neon->supported_by_runtime_system()) {
+		SECTION("Neon") {
+			testComponentConversions(fastgltf::internal::neon_convert_components);
+		}
+	}
+#endif
+}
+
 TEST_CASE("Test accessor", "[gltf-tools]") {
     auto lightsLamp = sampleAssets / "Models" / "LightsPunctualLamp" / "glTF";
 
@@ -319,6 +399,20 @@ TEST_CASE("Test sparse accessor", "[gltf-tools]") {
 		REQUIRE(std::memcmp(dstCopy.get(), checkValues.get(), secondAccessor.count * sizeof(fastgltf::math::fvec3)) == 0);
 	}
 
+	SECTION("copyComponentsFromAccessor") {
+		auto dstCopy = std::make_unique<fastgltf::math::fvec3[]>(secondAccessor.count);
+		fastgltf::copyComponentsFromAccessor<float>(asset.get(), secondAccessor, dstCopy.get());
+		REQUIRE(std::memcmp(dstCopy.get(), checkValues.get(), secondAccessor.count * sizeof(fastgltf::math::fvec3)) == 0);
+	}
+
+	SECTION("prepareAccessor") {
+		auto prepared = fastgltf::prepareAccessor<fastgltf::math::fvec3>(asset.get(), secondAccessor);
+		REQUIRE(prepared.size() == secondAccessor.count);
+		for (std::size_t i = secondAccessor.count; i > 0; --i) {
+			REQUIRE(checkValues[i - 1] == prepared[i - 1]);
+		}
+	}
+
 	SECTION("Iterator test") {
 		auto dstCopy = std::make_unique<fastgltf::math::fvec3[]>(secondAccessor.count);
 		auto accessor = fastgltf::iterateAccessor<fastgltf::math::fvec3>(asset.get(), secondAccessor);
@@ -327,4 +421,212 @@ TEST_CASE("Test sparse accessor", "[gltf-tools]") {
 		}
 		REQUIRE(std::memcmp(dstCopy.get(), checkValues.get(), secondAccessor.count * sizeof(fastgltf::math::fvec3)) == 0);
 	}
+
+	SECTION("viewAccessor") {
+		auto view = fastgltf::viewAccessor<fastgltf::math::fvec3>(asset.get(), secondAccessor);
+		REQUIRE(view.size() == secondAccessor.count);
+		for (std::size_t i = secondAccessor.count; i > 0; --i) {
+			REQUIRE(checkValues[i - 1] == view[i - 1]);
+		}
+
+		// Every chunk starts at another position relative to the sparse indices.
+		for (std::size_t chunkSize = 1; chunkSize <= secondAccessor.count; ++chunkSize) {
+			auto dstCopy = std::make_unique<fastgltf::math::fvec3[]>(secondAccessor.count);
+			for (std::size_t begin = 0; begin < secondAccessor.count; begin += chunkSize) {
+				view.forEachChunk(begin, std::min(begin + chunkSize, secondAccessor.count), [&](const fastgltf::math::fvec3& v3, std::size_t i) {
+					dstCopy[i] = v3;
+				});
+			}
+			REQUIRE(std::memcmp(dstCopy.get(), checkValues.get(), secondAccessor.count * sizeof(fastgltf::math::fvec3)) == 0);
+		}
+	}
+}
+
+TEST_CASE("Test accessor view", "[gltf-tools]") {
+	constexpr std::size_t count = 300;
+	fastgltf::Asset asset;
+
+	// Normalized shorts in a strided view, with a few elements substituted through 8-bit sparse indices.
+	std::vector<std::byte> bytes(count * 8);
+	for (std::size_t i = 0; i < count * 4; ++i) {
+		auto value = static_cast<std::int16_t>(i * 211 - 30000);
+		std::memcpy(bytes.data() + i * sizeof(value), &value, sizeof(value));
+	}
+	const std::array<std::uint8_t, 4> sparseIndices {{ 0, 17, 18, 254 }};
+	const auto indicesOffset = bytes.size();
+	bytes.resize(bytes.size() + 4);
+	std::memcpy(bytes.data() + indicesOffset, sparseIndices.data(), sizeof(sparseIndices));
+	const auto valuesOffset = bytes.size();
+	bytes.resize(bytes.size() + sparseIndices.size() * 6);
+	for (std::size_t i = 0; i < sparseIndices.size() * 3; ++i) {
+		auto value = static_cast<std::int16_t>(-32767 + static_cast<int>(i));
+		std::memcpy(bytes.data() + valuesOffset + i * sizeof(value), &value, sizeof(value));
+	}
+
+	fastgltf::Buffer buffer = {};
+	buffer.byteLength = bytes.size();
+	buffer.data = fastgltf::sources::Vector { std::move(bytes), fastgltf::MimeType::GltfBuffer };
+	asset.buffers.emplace_back(std::move(buffer));
+	auto addView = [&](std::size_t byteOffset, std::size_t byteLength, fastgltf::Optional<std::size_t> byteStride) {
+		fastgltf::BufferView view = {};
+		view.bufferIndex = 0;
+		view.byteOffset = byteOffset;
+		view.byteLength = byteLength;
+		view.byteStride = byteStride;
+		asset.bufferViews.emplace_back(std::move(view));
+	};
+	addView(0, count * 8, 8);
+	addView(indicesOffset, sparseIndices.size(), {});
+	addView(valuesOffset, sparseIndices.size() * 6, {});
+
+	fastgltf::Accessor accessor = {};
+	accessor.count = count;
+	accessor.type = fastgltf::AccessorType::Vec3;
+	accessor.componentType = fastgltf::ComponentType::Short;
+	accessor.normalized = true;
+	accessor.bufferViewIndex = 0;
+	accessor.sparse = fastgltf::SparseAccessor { sparseIndices.size(), 1, 0, 2, 0, fastgltf::ComponentType::UnsignedByte };
+	asset.accessors.emplace_back(std::move(accessor));
+
+	// Without a buffer view, every element that is not substituted is zero.
+	fastgltf::Accessor sparseOnly = {};
+	sparseOnly.count = count;
+	sparseOnly.type = fastgltf::AccessorType::Vec3;
+	sparseOnly.componentType = fastgltf::ComponentType::Short;
+	sparseOnly.normalized = true;
+	sparseOnly.sparse = asset.accessors.front().sparse;
+	asset.accessors.emplace_back(std::move(sparseOnly));
+
+	for (const auto& testAccessor : asset.accessors) {
+		std::vector<fastgltf::math::fvec3> expected(count);
+		for (std::size_t i = 0; i < count; ++i) {
+			expected[i] = fastgltf::getAccessorElement<fastgltf::math::fvec3>(asset, testAccessor, i);
+		}
+
+		auto view = fastgltf::viewAccessor<fastgltf::math::fvec3>(asset, testAccessor);
+		REQUIRE(view.size() == count);
+		REQUIRE(view.end() - view.begin() == static_cast<std::ptrdiff_t>(count));
+
+		std::vector<fastgltf::math::fvec3> elements(count);
+		std::copy(view.begin(), view.end(), elements.begin());
+		REQUIRE(elements == expected);
+
+		auto it = view.end();
+		for (std::size_t i = count; i > 0; --i) {
+			--it;
+			REQUIRE(*it == expected[i - 1]);
+			REQUIRE(view.begin()[static_cast<std::ptrdiff_t>(i - 1)] == expected[i - 1]);
+		}
+		REQUIRE(it == view.begin());
+		REQUIRE((view.begin() + 18).index() == 18);
+		REQUIRE(view.begin() < view.end());
+
+		// The chunks can be processed in any order, as they would be by multiple threads.
+		std::fill(elements.begin(), elements.end(), fastgltf::math::fvec3(2.f));
+		constexpr std::size_t chunkSize = 17;
+		for (std::size_t begin = (count / chunkSize) * chunkSize;; begin -= chunkSize) {
+			view.forEachChunk(begin, std::min(begin + chunkSize, count), [&](fastgltf::math::fvec3 element, std::size_t i) {
+				elements[i] = element;
+			});
+			if (begin == 0)
+				break;
+		}
+		REQUIRE(elements == expected);
+
+		std::size_t i = 0;
+		fastgltf::iterateAccessor<fastgltf::math::fvec3>(asset, testAccessor, [&](fastgltf::math::fvec3 element) {
+			REQUIRE(element == expected[i++]);
+		});
+		REQUIRE(i == count);
+	}
+	REQUIRE(fastgltf::getAccessorElement<fastgltf::math::fvec3>(asset, asset.accessors[1], 1) == fastgltf::math::fvec3(0.f));
+}
+
+TEST_CASE("Test interleaved vertex copy", "[gltf-tools]") {
+	constexpr std::size_t vertexCount = 3000;
+	fastgltf::Asset asset;
+
+	// Every attribute uses a different component type, and the positions are stored in a strided view.
+	std::vector<std::byte> bytes;
+	auto addView = [&](std::size_t byteLength, fastgltf::Optional<std::size_t> byteStride) {
+		fastgltf::BufferView view = {};
+		view.bufferIndex = 0;
+		view.byteOffset = bytes.size();
+		view.byteLength = byteLength;
+		view.byteStride = byteStride;
+		bytes.resize(bytes.size() + byteLength);
+		asset.bufferViews.emplace_back(std::move(view));
+		return asset.bufferViews.size() - 1;
+	};
+	auto addAccessor = [&](std::string_view name, fastgltf::AccessorType type, fastgltf::ComponentType componentType, bool normalized, std::size_t stride) {
+		fastgltf::Accessor accessor = {};
+		accessor.count = vertexCount;
+		accessor.type = type;
+		accessor.componentType = componentType;
+		accessor.normalized = normalized;
+		accessor.bufferViewIndex = addView(stride * vertexCount, stride);
+		asset.accessors.emplace_back(std::move(accessor));
+		asset.meshes.front().primitives.front().attributes.emplace_back(fastgltf::Attribute { FASTGLTF_STD_PMR_NS::string(name), asset.accessors.size() - 1 });
+	};
+
+	asset.meshes.emplace_back().primitives.emplace_back();
+	addAccessor("POSITION", fastgltf::AccessorType::Vec3, fastgltf::ComponentType::Float, false, 16);
+	addAccessor("NORMAL", fastgltf::AccessorType::Vec3, fastgltf::ComponentType::Byte, true, 4);
+	addAccessor("TEXCOORD_0", fastgltf::AccessorType::Vec2, fastgltf::ComponentType::UnsignedShort, true, 4);
+	addAccessor("JOINTS_0", fastgltf::AccessorType::Vec4, fastgltf::ComponentType::UnsignedByte, false, 4);
+	for (std::size_t i = 0; i < bytes.size(); ++i) {
+		bytes[i] = static_cast<std::byte>((i * 7) % 251);
+	}
+	for (std::size_t i = 0; i < vertexCount * 3; ++i) {
+		auto value = static_cast<float>(i) * 0.5f;
+		std::memcpy(bytes.data() + (i / 3) * 16 + (i % 3) * sizeof(float), &value, sizeof(float));
+	}
+
+	// Substitute a few positions, which fall into different blocks of vertices.
+	const std::array<std::uint16_t, 3> sparseIndices {{ 1, 1500, 2999 }};
+	auto indicesView = addView(sizeof(sparseIndices), {});
+	std::memcpy(bytes.data() + asset.bufferViews[indicesView].byteOffset, sparseIndices.data(), sizeof(sparseIndices));
+	const std::array<float, 9> sparseValues {{ -1.f, -2.f, -3.f, -4.f, -5.f, -6.f, -7.f, -8.f, -9.f }};
+	auto valuesView = addView(sizeof(sparseValues), {});
+	std::memcpy(bytes.data() + asset.bufferViews[valuesView].byteOffset, sparseValues.data(), sizeof(sparseValues));
+	asset.accessors.front().sparse = fastgltf::SparseAccessor { sparseIndices.size(), indicesView, 0, valuesView, 0, fastgltf::ComponentType::UnsignedShort };
+
+	fastgltf::Buffer buffer = {};
+	buffer.byteLength = bytes.size();
+	buffer.data = fastgltf::sources::Vector { std::move(bytes), fastgltf::MimeType::GltfBuffer };
+	asset.buffers.emplace_back(std::move(buffer));
+
+	// The primitive has no COLOR_0 attribute, which therefore has to be filled with zeros.
+	constexpr std::size_t stride = 44;
+	fastgltf::VertexLayout layout;
+	layout.stride = stride;
+	layout.attributes = {
+		{ "POSITION", 0, fastgltf::AccessorType::Vec3, fastgltf::ComponentType::Float },
+		{ "NORMAL", 12, fastgltf::AccessorType::Vec3, fastgltf::ComponentType::Float },
+		{ "TEXCOORD_0", 24, fastgltf::AccessorType::Vec2, fastgltf::ComponentType::Float },
+		{ "JOINTS_0", 32, fastgltf::AccessorType::Vec4, fastgltf::ComponentType::UnsignedShort },
+		{ "COLOR_0", 40, fastgltf::AccessorType::Vec4, fastgltf::ComponentType::UnsignedByte },
+	};
+
+	const auto& primitive = asset.meshes.front().primitives.front();
+	REQUIRE(fastgltf::getVertexCount(asset, primitive) == vertexCount);
+
+	std::vector<std::byte> expected(vertexCount * stride, std::byte(0xFF));
+	fastgltf::copyFromAccessor<fastgltf::math::fvec3, stride>(asset, asset.accessors[0], expected.data());
+	fastgltf::copyFromAccessor<fastgltf::math::fvec3, stride>(asset, asset.accessors[1], expected.data() + 12);
+	fastgltf::copyFromAccessor<fastgltf::math::fvec2, stride>(asset, asset.accessors[2], expected.data() + 24);
+	fastgltf::copyFromAccessor<fastgltf::math::u16vec4, stride>(asset, asset.accessors[3], expected.data() + 32);
+	for (std::size_t i = 0; i < vertexCount; ++i) {
+		std::memset(expected.data() + i * stride + 40, 0, 4);
+	}
+
+	for (auto destination : { fastgltf::VertexDestination::Cached, fastgltf::VertexDestination::WriteCombined }) {
+		std::vector<std::byte> vertices(vertexCount * stride, std::byte(0xFF));
+		REQUIRE(fastgltf::copyInterleavedVertices(asset, primitive, layout, vertices.data(), destination) == vertexCount);
+		REQUIRE(std::memcmp(vertices.data(), expected.data(), vertices.size()) == 0);
+	}
+
+	fastgltf::math::fvec3 position;
+	std::memcpy(&position, expected.data() + 1500 * stride, sizeof(position));
+	REQUIRE(position == fastgltf::math::fvec3(-4.f, -5.f, -6.f));
 }
@@ -1,9 +1,13 @@
+#include <cstring>
 #include <fstream>
 #include <sstream>
+#include <stdexcept>
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/benchmark/catch_benchmark.hpp>
 
+#include <simdjson.h>
+
 #include <fastgltf/base64.hpp>
 #include <fastgltf/types.hpp>
 #include <fastgltf/core.hpp>
@@ -38,12 +42,85 @@ TEST_CASE("Check all base64 decoders", "[base64]") {
 #if defined(__x86_64__) || defined(_M_AMD64) || defined(_M_IX86)
     REQUIRE(bytes == fastgltf::base64::avx2_decode(testBase64));
     REQUIRE(bytes == fastgltf::base64::sse4_decode(testBase64));
+
+    // The AVX-512 decoder only decodes blocks of 64 chars, so we need a longer string to test it.
+    if (const auto* avx512 = simdjson::get_available_implementations()["icelake"]; avx512 != nullptr && avx512->supported_by_runtime_system()) {
+        std::string longBase64;
+        for (std::size_t i = 0; i < 8; ++i) {
+            longBase64 += testBase64.substr(0, testBase64.size() - 4);
+        }
+        longBase64 += testBase64;
+        REQUIRE(fastgltf::base64::avx512_decode(longBase64) == fastgltf::base64::fallback_decode(longBase64));
+    }
 #endif
 #if defined(__aarch64__)
 	REQUIRE(bytes == fastgltf::base64::neon_decode(testBase64));
 #endif
 }
 
+TEST_CASE("Check all base64 encoders", "[base64]") {
+    constexpr std::string_view testString = "Hello World. Hello World. Hello World.";
+    const fastgltf::span<const std::byte> testData(reinterpret_cast<const std::byte*>(testString.data()), testString.size());
+    REQUIRE(fastgltf::base64::getEncodedSize(testData.size()) == testBase64.size());
+    REQUIRE(fastgltf::base64::encode(testData) == testBase64);
+    REQUIRE(fastgltf::base64::fallback_encode(testData) == testBase64);
+
+    // Check every possible remainder of the SIMD loops, and that the encoders agree with the decoder.
+    std::vector<std::byte> bytes(200);
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<std::byte>((i * 131 + 7) & 0xFF);
+    }
+    for (std::size_t size = 1; size <= bytes.size(); ++size) {
+        const fastgltf::span<const std::byte> data(bytes.data(), size);
+        auto encoded = fastgltf::base64::fallback_encode(data);
+        REQUIRE(encoded.size() == fastgltf::base64::getEncodedSize(size));
+#if defined(__x86_64__) || defined(_M_AMD64) || defined(_M_IX86)
+        REQUIRE(encoded == fastgltf::base64::avx2_encode(data));
+        REQUIRE(encoded == fastgltf::base64::sse4_encode(data));
+#endif
+#if defined(__aarch64__)
+        REQUIRE(encoded == fastgltf::base64::neon_encode(data));
+#endif
+
+        auto decoded = fastgltf::base64::decode(encoded);
+        REQUIRE(decoded.size() == size);
+        REQUIRE(std::memcmp(decoded.data(), bytes.data(), size) == 0);
+    }
+}
+
+TEST_CASE("Check parallel base64 data URI decoding", "[base64]") {
+    // The data URI needs to be large enough to be split into multiple chunks.
+    std::vector<std::byte> bytes(5 * 1024 * 1024 + 1);
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<std::byte>((i * 131 + i / 4096) & 0xFF);
+    }
+
+    std::string json = R"({"asset":{"version":"2.0"},"buffers":[{"byteLength":)" + std::to_string(bytes.size()) +
+        R"(,"uri":"data:application/octet-stream;base64,)" + fastgltf::base64::encode(fastgltf::span<const std::byte>(bytes.data(), bytes.size())) + R"("}]})";
+    auto jsonData = fastgltf::GltfDataBuffer::FromBytes(reinterpret_cast<const std::byte*>(json.data()), json.size());
+    REQUIRE(jsonData.error() == fastgltf::Error::None);
+
+    auto checkDecoded = [&bytes](fastgltf::Parser& parser, fastgltf::GltfDataBuffer& data) {
+        auto asset = parser.loadGltfJson(data, {}, fastgltf::Options::DecodeDataUrisInParallel);
+        REQUIRE(asset.error() == fastgltf::Error::None);
+
+        auto* array = std::get_if<fastgltf::sources::Array>(&asset->buffers.front().data);
+        REQUIRE(array != nullptr);
+        REQUIRE(array->bytes.size() == bytes.size());
+        REQUIRE(std::memcmp(array->bytes.data(), bytes.data(), bytes.size()) == 0);
+    };
+
+    fastgltf::Parser parser;
+    checkDecoded(parser, jsonData.get());
+
+    // An executor that throws halfway through must not terminate the program. The data is then decoded on the calling thread.
+    parser.setTaskExecutorCallback([](std::size_t taskCount, fastgltf::ParserTask* task, void* taskData, void*) {
+        task(taskCount - 1, taskData);
+        throw std::runtime_error("Failed to schedule the remaining tasks");
+    });
+    checkDecoded(parser, jsonData.get());
+}
+
 TEST_CASE("Check big base64 data decoding", "[base64]") {
     std::ifstream file(path / "base64.txt");
     REQUIRE(file.is_open());
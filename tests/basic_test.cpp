@@ -1,5 +1,7 @@
 #include <algorithm>
 #include <cstdlib>
+#include <mutex>
+#include <thread>
 
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
@@ -15,6 +17,7 @@
 #include <fastgltf/core.hpp>
 #include <fastgltf/types.hpp>
 #include <fastgltf/math.hpp>
+#include <fastgltf/tools.hpp>
 #include "gltf_path.hpp"
 #include <simdjson.h>
 
@@ -308,6 +311,503 @@ TEST_CASE("Validate models with re-used parser", "[gltf-loader]") {
 	}
 }
 
+TEST_CASE("Load many files with a batch loader", "[gltf-loader]") {
+	const std::vector<std::filesystem::path> paths {
+		sampleAssets / "Models" / "Sponza" / "glTF" / "Sponza.gltf",
+		sampleAssets / "Models" / "BoomBox" / "glTF-Binary" / "BoomBox.glb",
+		sampleAssets / "Models" / "Cube" / "glTF" / "Cube.gltf",
+		path / "basic_gltf.gltf",
+		path / "does_not_exist.gltf",
+		sampleAssets / "Models" / "BrainStem" / "glTF" / "BrainStem.gltf",
+		path / "empty_json.gltf",
+	};
+
+	// Catch2 assertions are not thread-safe, so the results are only checked after each batch.
+	struct Results {
+		std::mutex mutex;
+		std::vector<fastgltf::Error> errors;
+		std::vector<std::size_t> reportCounts;
+		std::size_t invalidAssets = 0;
+		std::size_t parserCount = 0;
+	} results;
+
+	fastgltf::BatchLoader loader(fastgltf::Extensions::None, 3);
+	REQUIRE(loader.getThreadCount() == 3);
+	loader.setUserPointer(&results);
+	loader.setParserCallback([](fastgltf::Parser&, void* userPointer) {
+		++static_cast<Results*>(userPointer)->parserCount;
+	});
+
+	// Every file is reported exactly once, and the parsers are reused for the second batch.
+	for (std::size_t batch = 0; batch < 2; ++batch) {
+		results.errors.assign(paths.size(), fastgltf::Error::None);
+		results.reportCounts.assign(paths.size(), 0);
+		auto failed = loader.load(fastgltf::span<const std::filesystem::path>(paths.data(), paths.size()),
+			[](std::size_t fileIndex, fastgltf::Expected<fastgltf::Asset>& asset, void* userPointer) {
+				auto& results = *static_cast<Results*>(userPointer);
+				const bool valid = asset.error() != fastgltf::Error::None || fastgltf::validate(asset.get()) == fastgltf::Error::None;
+				std::lock_guard lock(results.mutex);
+				results.errors[fileIndex] = asset.error();
+				++results.reportCounts[fileIndex];
+				results.invalidAssets += valid ? 0 : 1;
+			}, fastgltf::Options::LoadExternalBuffers);
+
+		REQUIRE(failed == 2);
+		REQUIRE(std::all_of(results.reportCounts.begin(), results.reportCounts.end(), [](std::size_t count) { return count == 1; }));
+		REQUIRE(results.invalidAssets == 0);
+		REQUIRE(results.errors[0] == fastgltf::Error::None);
+		REQUIRE(results.errors[1] == fastgltf::Error::None);
+		REQUIRE(results.errors[4] == fastgltf::Error::InvalidPath);
+		REQUIRE(results.errors[6] == fastgltf::Error::InvalidOrMissingAssetField);
+		REQUIRE(results.parserCount == 3);
+	}
+}
+
+TEST_CASE("Share external files through a file cache", "[gltf-loader]") {
+	const auto directory = std::filesystem::temp_directory_path() / "fastgltf_file_cache_test";
+	std::filesystem::create_directories(directory);
+	auto writeFile = [&](const std::filesystem::path& filePath, std::string_view contents) {
+		std::ofstream file(directory / filePath, std::ios::binary | std::ios::trunc);
+		file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+	};
+	writeFile("shared.bin", std::string(64, 'a'));
+	writeFile("texture.png", "not really a png");
+	writeFile("asset.gltf", R"({
+		"asset": { "version": "2.0" },
+		"buffers": [{ "byteLength": 64, "uri": "shared.bin" }],
+		"images": [{ "uri": "texture.png", "mimeType": "image/png" }]
+	})");
+
+	fastgltf::ExternalFileCache cache;
+	auto load = [&](fastgltf::Options options) {
+		fastgltf::GltfFileStream jsonData(directory / "asset.gltf");
+		REQUIRE(jsonData.isOpen());
+		fastgltf::Parser parser;
+		parser.setExternalFileCache(&cache);
+		auto asset = parser.loadGltfJson(jsonData, directory, options | fastgltf::Options::LoadExternalBuffers | fastgltf::Options::LoadExternalImages);
+		REQUIRE(asset.error() == fastgltf::Error::None);
+		return std::move(asset.get());
+	};
+
+	// Both assets reference the same memory, and the second one doesn't read any file.
+	auto first = load(fastgltf::Options::None);
+	auto second = load(fastgltf::Options::LoadExternalFilesInParallel);
+	for (auto* asset : { &first, &second }) {
+		auto* buffer = std::get_if<fastgltf::sources::ByteView>(&asset->buffers[0].data);
+		REQUIRE(buffer != nullptr);
+		REQUIRE(buffer->bytes.size() == 64);
+		REQUIRE(static_cast<char>(buffer->bytes[63]) == 'a');
+		auto* image = std::get_if<fastgltf::sources::ByteView>(&asset->images[0].data);
+		REQUIRE(image != nullptr);
+		REQUIRE(image->mimeType == fastgltf::MimeType::PNG);
+	}
+	REQUIRE(std::get<fastgltf::sources::ByteView>(first.buffers[0].data).bytes.data()
+		== std::get<fastgltf::sources::ByteView>(second.buffers[0].data).bytes.data());
+
+	auto statistics = cache.getStatistics();
+	REQUIRE(statistics.hits == 2);
+	REQUIRE(statistics.misses == 2);
+	REQUIRE(statistics.hitRate() == 0.5);
+	REQUIRE(statistics.residentFiles == 2);
+	REQUIRE(statistics.residentBytes == 64 + 16);
+
+	// A replaced file is read again, while the assets keep the old contents alive.
+	writeFile("shared.bin.tmp", std::string(32, 'b'));
+	std::filesystem::rename(directory / "shared.bin.tmp", directory / "shared.bin");
+	auto changed = cache.load(directory / "shared.bin");
+	REQUIRE(changed.error() == fastgltf::Error::None);
+	REQUIRE(changed->size == 32);
+	REQUIRE(static_cast<char>(std::get<fastgltf::sources::ByteView>(first.buffers[0].data).bytes[0]) == 'a');
+	REQUIRE(cache.getStatistics().residentBytes == 32 + 16);
+	REQUIRE(cache.load(directory / "missing.bin").error() == fastgltf::Error::MissingExternalBuffer);
+
+	// Only files which aren't referenced anymore are released.
+	changed = fastgltf::ExternalFileCache::File {};
+	REQUIRE(cache.trim() == 32);
+	first = fastgltf::Asset {};
+	second = fastgltf::Asset {};
+	REQUIRE(cache.trim() == 16);
+	REQUIRE(cache.getStatistics().residentFiles == 0);
+
+	std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Validate categories and revalidate incrementally", "[gltf-loader]") {
+	auto sponza = sampleAssets / "Models" / "Sponza" / "glTF";
+	fastgltf::GltfFileStream jsonData(sponza / "Sponza.gltf");
+	REQUIRE(jsonData.isOpen());
+
+	fastgltf::Parser parser;
+	auto asset = parser.loadGltfJson(jsonData, sponza);
+	REQUIRE(asset.error() == fastgltf::Error::None);
+
+	// Executes the tasks in reverse, which must not change which error is reported.
+	auto executor = [](std::size_t taskCount, fastgltf::ParserTask* task, void* taskData, void*) {
+		for (auto i = taskCount; i-- > 0;) {
+			task(i, taskData);
+		}
+	};
+
+	SECTION("Category masks") {
+		REQUIRE(fastgltf::validate(asset.get(), fastgltf::Category::All, executor) == fastgltf::Error::None);
+
+		asset->materials.front().normalTexture = fastgltf::NormalTextureInfo {};
+		asset->materials.front().normalTexture->textureIndex = asset->textures.size();
+		REQUIRE(fastgltf::validate(asset.get()) == fastgltf::Error::InvalidGltf);
+		REQUIRE(fastgltf::validate(asset.get(), fastgltf::Category::Materials) == fastgltf::Error::InvalidGltf);
+		REQUIRE(fastgltf::validate(asset.get(), fastgltf::Category::All & ~fastgltf::Category::Materials) == fastgltf::Error::None);
+	}
+
+	SECTION("Incremental revalidation") {
+		fastgltf::AssetValidator validator;
+		validator.setTaskExecutorCallback(executor);
+		REQUIRE(validator.revalidate(asset.get()) == fastgltf::Error::None);
+
+		// Changes which are not marked dirty are not noticed.
+		asset->nodes.front().cameraIndex = asset->cameras.size();
+		REQUIRE(validator.revalidate(asset.get()) == fastgltf::Error::None);
+
+		validator.markDirty(fastgltf::Category::Nodes, 0);
+		REQUIRE(validator.revalidate(asset.get()) == fastgltf::Error::InvalidGltf);
+		asset->nodes.front().cameraIndex.reset();
+		REQUIRE(validator.revalidate(asset.get()) == fastgltf::Error::None);
+
+		// Added objects are validated without being marked, and removing objects revalidates their users.
+		asset->scenes.emplace_back().nodeIndices.emplace_back(asset->nodes.size());
+		REQUIRE(validator.revalidate(asset.get()) == fastgltf::Error::InvalidGltf);
+		asset->scenes.pop_back();
+		REQUIRE(validator.revalidate(asset.get()) == fastgltf::Error::None);
+
+		asset->textures.clear();
+		REQUIRE(validator.revalidate(asset.get()) == fastgltf::Error::InvalidGltf);
+	}
+}
+
+TEST_CASE("Validate large assets in parallel", "[gltf-loader]") {
+	// Enough nodes for the validation to be split into multiple tasks.
+	fastgltf::Asset asset;
+	asset.nodes.resize(3 * 4096 + 1);
+
+	// Executes the tasks in reverse, and records how many tasks there were.
+	auto executor = [](std::size_t taskCount, fastgltf::ParserTask* task, void* taskData, void* userPointer) {
+		*static_cast<std::size_t*>(userPointer) = taskCount;
+		for (auto i = taskCount; i-- > 0;) {
+			task(i, taskData);
+		}
+	};
+
+	std::size_t taskCount = 0;
+	REQUIRE(fastgltf::validate(asset, fastgltf::Category::All, executor, &taskCount) == fastgltf::Error::None);
+	REQUIRE(taskCount > 1);
+
+	SECTION("Invalid objects in the first and last task") {
+		asset.nodes.back().cameraIndex = 0;
+		REQUIRE(fastgltf::validate(asset, fastgltf::Category::All, executor, &taskCount) == fastgltf::Error::InvalidGltf);
+		asset.nodes.front().cameraIndex = 0;
+		REQUIRE(fastgltf::validate(asset, fastgltf::Category::All, executor, &taskCount) == fastgltf::Error::InvalidGltf);
+		asset.nodes.back().cameraIndex.reset();
+		REQUIRE(fastgltf::validate(asset, fastgltf::Category::All, executor, &taskCount) == fastgltf::Error::InvalidGltf);
+	}
+
+	SECTION("Accessors with out of range buffer views") {
+		// Validating a single category must not rely on the accessors having been validated.
+		auto& accessor = asset.accessors.emplace_back();
+		accessor.type = fastgltf::AccessorType::Scalar;
+		accessor.componentType = fastgltf::ComponentType::Float;
+		accessor.count = 1;
+		accessor.bufferViewIndex = 0;
+
+		auto& animation = asset.animations.emplace_back();
+		animation.samplers.push_back({ 0, 0 });
+		animation.channels.push_back({ 0, 0, fastgltf::AnimationPath::Translation });
+		REQUIRE(fastgltf::validate(asset, fastgltf::Category::Animations) == fastgltf::Error::InvalidGltf);
+
+		asset.meshes.emplace_back().primitives.emplace_back().indicesAccessor = 0;
+		REQUIRE(fastgltf::validate(asset, fastgltf::Category::Meshes) == fastgltf::Error::InvalidGltf);
+	}
+}
+
+#if !FASTGLTF_DISABLE_CUSTOM_MEMORY_POOL
+TEST_CASE("Recycle memory arenas between loads", "[gltf-loader]") {
+	struct CountingResource : std::pmr::memory_resource {
+		std::size_t allocations = 0;
+		std::size_t liveBytes = 0;
+
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+			++allocations;
+			liveBytes += bytes;
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+		void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override {
+			liveBytes -= bytes;
+			std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+		}
+		[[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+			return this == &other;
+		}
+	} upstream;
+
+	auto sponza = sampleAssets / "Models" / "Sponza" / "glTF";
+	fastgltf::GltfFileStream jsonData(sponza / "Sponza.gltf");
+	REQUIRE(jsonData.isOpen());
+
+	{
+		fastgltf::Parser parser;
+		parser.setMemoryResource(&upstream, 64 * 1024);
+		parser.setMaxRecycledMemory(16 * 1024 * 1024);
+
+		fastgltf::MemoryStatistics first;
+		{
+			auto asset = parser.loadGltfJson(jsonData, sponza);
+			REQUIRE(asset.error() == fastgltf::Error::None);
+			first = parser.getMemoryStatistics();
+			REQUIRE(first.bytesAllocated > 0);
+			REQUIRE(first.chunksAllocated > 0);
+			REQUIRE(first.chunkBytesAllocated >= first.bytesAllocated);
+			REQUIRE(first.chunksRecycled == 0);
+			REQUIRE(upstream.allocations == first.chunksAllocated);
+		}
+
+		// The first asset has been released, so its chunks can be used for the second one.
+		auto asset = parser.loadGltfJson(jsonData, sponza);
+		REQUIRE(asset.error() == fastgltf::Error::None);
+		REQUIRE(fastgltf::validate(asset.get()) == fastgltf::Error::None);
+		auto& second = parser.getMemoryStatistics();
+		REQUIRE(second.bytesAllocated == first.bytesAllocated);
+		REQUIRE(second.chunksAllocated == first.chunksAllocated);
+		REQUIRE(second.chunksRecycled == second.chunksAllocated);
+		REQUIRE(upstream.allocations == first.chunksAllocated);
+	}
+
+	// Everything is returned to the upstream resource once the parser and all assets are gone.
+	REQUIRE(upstream.liveBytes == 0);
+}
+#endif
+
+TEST_CASE("Load external files in parallel", "[gltf-loader]") {
+	auto sponza = sampleAssets / "Models" / "Sponza" / "glTF";
+	fastgltf::GltfFileStream jsonData(sponza / "Sponza.gltf");
+	REQUIRE(jsonData.isOpen());
+
+	constexpr auto loadOptions = fastgltf::Options::LoadExternalBuffers | fastgltf::Options::LoadExternalImages;
+	fastgltf::Parser parser;
+	auto sequential = parser.loadGltfJson(jsonData, sponza, loadOptions);
+	REQUIRE(sequential.error() == fastgltf::Error::None);
+
+	auto checkAsset = [&](fastgltf::Asset& asset) {
+		REQUIRE(fastgltf::validate(asset) == fastgltf::Error::None);
+		REQUIRE(asset.buffers.size() == sequential->buffers.size());
+		REQUIRE(asset.images.size() == sequential->images.size());
+		for (std::size_t i = 0; i < asset.images.size(); ++i) {
+			auto* array = std::get_if<fastgltf::sources::Array>(&asset.images[i].data);
+			auto* expected = std::get_if<fastgltf::sources::Array>(&sequential->images[i].data);
+			REQUIRE(array != nullptr);
+			REQUIRE(expected != nullptr);
+			REQUIRE(array->bytes.size() == expected->bytes.size());
+			REQUIRE(array->mimeType == expected->mimeType);
+		}
+	};
+
+	SECTION("Internal threads") {
+		auto asset = parser.loadGltfJson(jsonData, sponza, loadOptions | fastgltf::Options::LoadExternalFilesInParallel);
+		REQUIRE(asset.error() == fastgltf::Error::None);
+		checkAsset(asset.get());
+	}
+
+	SECTION("Custom executor") {
+		std::size_t executedTasks = 0;
+		auto executor = [](std::size_t taskCount, fastgltf::ParserTask* task, void* taskData, void* userPointer) {
+			for (std::size_t i = 0; i < taskCount; ++i) {
+				task(i, taskData);
+				++(*static_cast<std::size_t*>(userPointer));
+			}
+		};
+		parser.setUserPointer(&executedTasks);
+		parser.setTaskExecutorCallback(executor);
+
+		auto asset = parser.loadGltfJson(jsonData, sponza, loadOptions | fastgltf::Options::LoadExternalFilesInParallel);
+		REQUIRE(asset.error() == fastgltf::Error::None);
+		checkAsset(asset.get());
+		REQUIRE(executedTasks == asset->buffers.size() + asset->images.size());
+	}
+}
+
+TEST_CASE("Load percent-encoded file names in parallel", "[gltf-loader]") {
+	// The URI is decoded exactly once, so "a%2520b.bin" refers to a file called "a%20b.bin".
+	const auto directory = std::filesystem::temp_directory_path() / "fastgltf_percent_encoding_test";
+	std::filesystem::create_directories(directory);
+	{
+		std::ofstream file(directory / "a%20b.bin", std::ios::binary | std::ios::trunc);
+		file << std::string(16, 'a');
+	}
+
+	constexpr std::string_view json = R"({
+		"asset": { "version": "2.0" },
+		"buffers": [{ "byteLength": 16, "uri": "a%2520b.bin" }]
+	})";
+	auto data = fastgltf::GltfDataBuffer::FromBytes(reinterpret_cast<const std::byte*>(json.data()), json.size());
+	REQUIRE(data.error() == fastgltf::Error::None);
+
+	for (auto options : { fastgltf::Options::None, fastgltf::Options::LoadExternalFilesInParallel }) {
+		fastgltf::Parser parser;
+		auto asset = parser.loadGltfJson(data.get(), directory, options | fastgltf::Options::LoadExternalBuffers);
+		REQUIRE(asset.error() == fastgltf::Error::None);
+		REQUIRE(std::holds_alternative<fastgltf::sources::Array>(asset->buffers[0].data));
+	}
+
+	std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Report load progress and cancel loads", "[gltf-loader]") {
+	auto sponza = sampleAssets / "Models" / "Sponza" / "glTF";
+	fastgltf::GltfFileStream jsonData(sponza / "Sponza.gltf");
+	REQUIRE(jsonData.isOpen());
+
+	struct ProgressState {
+		std::vector<fastgltf::LoadProgress> reports;
+		fastgltf::LoadPhase cancelAt = fastgltf::LoadPhase::Finished;
+		bool cancel = false;
+	} state;
+	auto callback = [](const fastgltf::LoadProgress& progress, void* userPointer) {
+		auto* state = static_cast<ProgressState*>(userPointer);
+		state->reports.emplace_back(progress);
+		return !state->cancel || progress.phase != state->cancelAt;
+	};
+
+	constexpr auto loadOptions = fastgltf::Options::LoadExternalBuffers | fastgltf::Options::LoadExternalFilesInParallel
+		| fastgltf::Options::GenerateMeshIndices;
+	fastgltf::Parser parser;
+	parser.setUserPointer(&state);
+	parser.setLoadProgressCallback(callback);
+
+	SECTION("Progress") {
+		auto asset = parser.loadGltfJson(jsonData, sponza, loadOptions);
+		REQUIRE(asset.error() == fastgltf::Error::None);
+
+		REQUIRE(state.reports.size() == 5);
+		REQUIRE(state.reports[0].phase == fastgltf::LoadPhase::ReadDocument);
+		REQUIRE(state.reports[1].phase == fastgltf::LoadPhase::ParsedCategories);
+		REQUIRE(state.reports[2].phase == fastgltf::LoadPhase::LoadedExternalFiles);
+		REQUIRE(state.reports[3].phase == fastgltf::LoadPhase::GeneratedMeshIndices);
+		REQUIRE(state.reports[4].phase == fastgltf::LoadPhase::Finished);
+		REQUIRE(state.reports[0].bytesRead == jsonData.totalSize());
+		REQUIRE(state.reports[0].totalBytes == jsonData.totalSize());
+		REQUIRE(state.reports[0].parsedCategories == fastgltf::Category::None);
+		REQUIRE(state.reports[4].parsedCategories == asset->availableCategories);
+	}
+
+	SECTION("Cancellation") {
+		state.cancel = true;
+		for (auto phase : { fastgltf::LoadPhase::ReadDocument, fastgltf::LoadPhase::ParsedCategories, fastgltf::LoadPhase::Finished }) {
+			state.reports.clear();
+			state.cancelAt = phase;
+			auto asset = parser.loadGltfJson(jsonData, sponza, loadOptions);
+			REQUIRE(asset.error() == fastgltf::Error::LoadCancelled);
+			REQUIRE(state.reports.back().phase == phase);
+		}
+	}
+
+	SECTION("Asynchronous load") {
+		auto future = parser.loadGltfAsync(jsonData, sponza, loadOptions);
+		auto asset = future.get();
+		REQUIRE(asset.error() == fastgltf::Error::None);
+		REQUIRE(fastgltf::validate(asset.get()) == fastgltf::Error::None);
+		REQUIRE(state.reports.back().phase == fastgltf::LoadPhase::Finished);
+	}
+}
+
+#if FASTGLTF_HAS_COROUTINES
+TEST_CASE("Load assets from coroutines", "[gltf-loader]") {
+	// A coroutine which starts right away and destroys itself once it has finished.
+	struct DetachedCoroutine {
+		struct promise_type {
+			DetachedCoroutine get_return_object() noexcept { return {}; }
+			std::suspend_never initial_suspend() noexcept { return {}; }
+			std::suspend_never final_suspend() noexcept { return {}; }
+			void return_void() noexcept {}
+			void unhandled_exception() { std::terminate(); }
+		};
+	};
+
+	std::string_view json = R"({"asset": {"version": "2.0"}, "nodes": [{ "name": "Node" }]})";
+	auto data = fastgltf::GltfDataBuffer::FromBytes(reinterpret_cast<const std::byte*>(json.data()), json.size());
+	REQUIRE(data.error() == fastgltf::Error::None);
+
+	struct LoadResult {
+		fastgltf::Expected<fastgltf::Asset> asset;
+		std::thread::id thread;
+	};
+	auto load = [](fastgltf::Parser& parser, fastgltf::GltfDataGetter& data, std::promise<LoadResult>& result) -> DetachedCoroutine {
+		auto asset = co_await parser.loadGltfAwaitable(data, {});
+		result.set_value({ std::move(asset), std::this_thread::get_id() });
+	};
+
+	fastgltf::Parser parser;
+	std::promise<LoadResult> promise;
+	auto future = promise.get_future();
+	load(parser, data.get(), promise);
+
+	auto result = future.get();
+	REQUIRE(result.thread != std::this_thread::get_id());
+	REQUIRE(result.asset.error() == fastgltf::Error::None);
+	REQUIRE(result.asset->nodes.size() == 1);
+	REQUIRE(result.asset->nodes[0].name == "Node");
+}
+#endif
+
+#if FASTGLTF_ENABLE_LOAD_STATISTICS
+TEST_CASE("Collect load statistics", "[gltf-loader]") {
+	auto boxPath = sampleAssets / "Models" / "Box" / "glTF-Embedded";
+	fastgltf::GltfFileStream jsonData(boxPath / "Box.gltf");
+	REQUIRE(jsonData.isOpen());
+
+	struct ScopeState {
+		std::vector<fastgltf::LoadScope> openScopes;
+		std::size_t categoryScopes = 0;
+		bool nested = true;
+	} state;
+	auto callback = [](fastgltf::LoadScope scope, fastgltf::Category category, bool begin, void* userPointer) {
+		auto* state = static_cast<ScopeState*>(userPointer);
+		if (begin) {
+			state->openScopes.emplace_back(scope);
+			if (scope == fastgltf::LoadScope::ParseCategory && category != fastgltf::Category::None)
+				++state->categoryScopes;
+		} else {
+			state->nested &= !state->openScopes.empty() && state->openScopes.back() == scope;
+			state->openScopes.pop_back();
+		}
+	};
+
+	fastgltf::Parser parser;
+	parser.setUserPointer(&state);
+	parser.setLoadScopeCallback(callback);
+	auto asset = parser.loadGltfJson(jsonData, boxPath, fastgltf::Options::GenerateMeshIndices);
+	REQUIRE(asset.error() == fastgltf::Error::None);
+
+	REQUIRE(state.nested);
+	REQUIRE(state.openScopes.empty());
+
+	const auto& statistics = parser.getLoadStatistics();
+	REQUIRE(statistics.load.bytes == jsonData.totalSize());
+	REQUIRE(statistics.readDocument.bytes == jsonData.totalSize());
+	REQUIRE(statistics.parseJson.bytes == jsonData.totalSize());
+	REQUIRE(statistics.load.duration >= statistics.parseJson.duration);
+
+	// Box.gltf embeds its only buffer as a base64 data URI.
+	REQUIRE(statistics.decodeDataUris.count == 1);
+	REQUIRE(statistics.decodeDataUris.bytes == asset->buffers[0].byteLength);
+	REQUIRE(statistics.loadExternalFiles.count == 0);
+
+	REQUIRE(statistics.getCategory(fastgltf::Category::Accessors).count == asset->accessors.size());
+	REQUIRE(statistics.getCategory(fastgltf::Category::Nodes).count == asset->nodes.size());
+	REQUIRE(statistics.generateMeshIndices.count == 1);
+	REQUIRE(state.categoryScopes > 0);
+#if !FASTGLTF_DISABLE_CUSTOM_MEMORY_POOL
+	REQUIRE(statistics.arenaBytesAllocated == parser.getMemoryStatistics().bytesAllocated);
+#endif
+}
+#endif
+
 TEST_CASE("Test allocation callbacks for embedded buffers", "[gltf-loader]") {
     auto boxPath = sampleAssets / "Models" / "Box" / "glTF-Embedded";
 	fastgltf::GltfFileStream jsonData(boxPath / "Box.gltf");
@@ -492,6 +992,112 @@ TEST_CASE("Test accessors min/max", "[gltf-loader]") {
 	}
 }
 
+TEST_CASE("Weld vertices when generating indices", "[gltf-loader]") {
+	// A quad made out of two non-indexed triangles, which share two of their vertices.
+	// The colors are three bytes large, and are padded to four bytes by the byteStride.
+	constexpr std::string_view json = R"({
+		"asset": { "version": "2.0" },
+		"buffers": [
+			{ "byteLength": 144, "uri": "data:application/octet-stream;base64,AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAACAPwAAgD8AAAAAAAAAAAAAAAAAAAAAAACAPwAAgD8AAAAAAAAAAAAAgD8AAAAAAAAAAAAAAAAAAIA/AAAAAAAAAAAAAIA/AAAAAAAAAAAAAIA/AAAAAAAAAAAAAIA/AAAAAAAAAAAAAIA/AAAAAAAAAAAAAIA/" },
+			{ "byteLength": 24, "uri": "data:application/octet-stream;base64,/wAAAAD/AAAAAP8A/wAAAAAA/wD///8A" }
+		],
+		"bufferViews": [{ "buffer": 0, "byteLength": 144 }, { "buffer": 1, "byteLength": 24, "byteStride": 4 }],
+		"accessors": [
+			{ "bufferView": 0, "componentType": 5126, "type": "VEC3", "count": 6, "min": [0, 0, 0], "max": [1, 1, 0] },
+			{ "bufferView": 0, "byteOffset": 72, "componentType": 5126, "type": "VEC3", "count": 6 },
+			{ "bufferView": 1, "componentType": 5121, "normalized": true, "type": "VEC3", "count": 6 }
+		],
+		"meshes": [{ "primitives": [{ "attributes": { "POSITION": 0, "NORMAL": 1, "COLOR_0": 2 } }] }]
+	})";
+	const std::array<fastgltf::math::fvec3, 6> positions {{
+		{ 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 },
+	}};
+	const std::array<fastgltf::math::u8vec3, 6> colors {{
+		{ 255, 0, 0 }, { 0, 255, 0 }, { 0, 0, 255 }, { 255, 0, 0 }, { 0, 0, 255 }, { 255, 255, 255 },
+	}};
+
+	auto load = [&](fastgltf::Options options) {
+		auto data = fastgltf::GltfDataBuffer::FromBytes(reinterpret_cast<const std::byte*>(json.data()), json.size());
+		REQUIRE(data.error() == fastgltf::Error::None);
+		fastgltf::Parser parser;
+		auto asset = parser.loadGltfJson(data.get(), {}, options);
+		REQUIRE(asset.error() == fastgltf::Error::None);
+		REQUIRE(fastgltf::validate(asset.get()) == fastgltf::Error::None);
+		return std::move(asset.get());
+	};
+
+	for (auto options : { fastgltf::Options::GenerateMeshIndices, fastgltf::Options::GenerateMeshIndices | fastgltf::Options::WeldMeshVertices }) {
+		auto asset = load(options);
+		auto& primitive = asset.meshes[0].primitives[0];
+		REQUIRE(primitive.indicesAccessor.has_value());
+
+		auto& positionAccessor = asset.accessors[primitive.findAttribute("POSITION")->accessorIndex];
+		auto& normalAccessor = asset.accessors[primitive.findAttribute("NORMAL")->accessorIndex];
+		REQUIRE(positionAccessor.count == (fastgltf::hasBit(options, fastgltf::Options::WeldMeshVertices) ? 4 : 6));
+		REQUIRE(normalAccessor.count == positionAccessor.count);
+		auto& colorAccessor = asset.accessors[primitive.findAttribute("COLOR_0")->accessorIndex];
+		REQUIRE(colorAccessor.count == positionAccessor.count);
+		REQUIRE(asset.bufferViews[*colorAccessor.bufferViewIndex].byteStride == 4U);
+
+		fastgltf::iterateAccessorWithIndex<std::uint32_t>(asset, asset.accessors[*primitive.indicesAccessor], [&](std::uint32_t index, std::size_t i) {
+			REQUIRE(fastgltf::getAccessorElement<fastgltf::math::fvec3>(asset, positionAccessor, index) == positions[i]);
+			REQUIRE(fastgltf::getAccessorElement<fastgltf::math::fvec3>(asset, normalAccessor, index) == fastgltf::math::fvec3(0, 0, 1));
+			REQUIRE(fastgltf::getAccessorElement<fastgltf::math::u8vec3>(asset, colorAccessor, index) == colors[i]);
+		});
+	}
+}
+
+TEST_CASE("Compute missing position bounds", "[gltf-loader]") {
+	// The same quad as above, where only the position accessor without any bounds should get them.
+	constexpr std::string_view json = R"({
+		"asset": { "version": "2.0" },
+		"buffers": [{ "byteLength": 144, "uri": "data:application/octet-stream;base64,AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAACAPwAAgD8AAAAAAAAAAAAAAAAAAAAAAACAPwAAgD8AAAAAAAAAAAAAgD8AAAAAAAAAAAAAAAAAAIA/AAAAAAAAAAAAAIA/AAAAAAAAAAAAAIA/AAAAAAAAAAAAAIA/AAAAAAAAAAAAAIA/AAAAAAAAAAAAAIA/" }],
+		"bufferViews": [{ "buffer": 0, "byteLength": 144 }],
+		"accessors": [
+			{ "bufferView": 0, "componentType": 5126, "type": "VEC3", "count": 6 },
+			{ "bufferView": 0, "byteOffset": 72, "componentType": 5126, "type": "VEC3", "count": 6 }
+		],
+		"meshes": [{ "primitives": [{ "attributes": { "POSITION": 0, "NORMAL": 1 } }] }]
+	})";
+
+	auto data = fastgltf::GltfDataBuffer::FromBytes(reinterpret_cast<const std::byte*>(json.data()), json.size());
+	REQUIRE(data.error() == fastgltf::Error::None);
+	fastgltf::Parser parser;
+	auto asset = parser.loadGltfJson(data.get(), {}, fastgltf::Options::ComputeMissingBounds);
+	REQUIRE(asset.error() == fastgltf::Error::None);
+	REQUIRE(fastgltf::validate(asset.get()) == fastgltf::Error::None);
+
+	auto& positions = asset->accessors[0];
+	REQUIRE(positions.min.has_value());
+	REQUIRE(positions.max.has_value());
+	REQUIRE(positions.min->isType<double>());
+	for (std::size_t i = 0; i < 3; ++i) {
+		REQUIRE(positions.min->get<double>(i) == 0.);
+		REQUIRE(positions.max->get<double>(i) == (i == 2 ? 0. : 1.));
+	}
+	REQUIRE(!asset->accessors[1].min.has_value());
+
+	// Without the option, the accessors are left as they are.
+	auto unchanged = parser.loadGltfJson(data.get(), {});
+	REQUIRE(unchanged.error() == fastgltf::Error::None);
+	REQUIRE(!unchanged->accessors[0].min.has_value());
+
+	// An accessor whose count would make the size of its elements wrap around is not read.
+	constexpr std::string_view overflowingJson = R"({
+		"asset": { "version": "2.0" },
+		"buffers": [{ "byteLength": 12, "uri": "data:application/octet-stream;base64,AAAAAAAAAAAAAAAA" }],
+		"bufferViews": [{ "buffer": 0, "byteLength": 12 }],
+		"accessors": [{ "bufferView": 0, "componentType": 5126, "type": "VEC3", "count": 4611686018427387905 }],
+		"meshes": [{ "primitives": [{ "attributes": { "POSITION": 0 } }] }]
+	})";
+	auto overflowingData = fastgltf::GltfDataBuffer::FromBytes(reinterpret_cast<const std::byte*>(overflowingJson.data()), overflowingJson.size());
+	REQUIRE(overflowingData.error() == fastgltf::Error::None);
+	auto overflowing = parser.loadGltfJson(overflowingData.get(), {}, fastgltf::Options::ComputeMissingBounds);
+	REQUIRE(overflowing.error() == fastgltf::Error::None);
+	REQUIRE(!overflowing->accessors[0].min.has_value());
+	REQUIRE(!overflowing->accessors[0].max.has_value());
+}
+
 TEST_CASE("Test unicode characters", "[gltf-loader]") {
 #if FASTGLTF_CPP_20
 	auto unicodePath = sampleAssets / "Models" / std::filesystem::path(u8"Unicode❤♻Test") / "glTF";
@@ -597,6 +1203,186 @@ TEST_CASE("Test extras callback", "[gltf-loader]") {
 	}
 }
 
+TEST_CASE("Parse categories in parallel", "[gltf-loader]") {
+	auto materialVariants = sampleAssets / "Models" / "MaterialsVariantsShoe" / "glTF";
+	fastgltf::GltfFileStream jsonData(materialVariants / "MaterialsVariantsShoe.gltf");
+	REQUIRE(jsonData.isOpen());
+
+	using ExtrasList = std::vector<std::pair<fastgltf::Category, std::size_t>>;
+	auto extrasCallback = [](simdjson::dom::object* extras, std::size_t objectIndex, fastgltf::Category category, void* userPointer) {
+		static_cast<ExtrasList*>(userPointer)->emplace_back(category, objectIndex);
+	};
+
+	auto parseJson = [&](fastgltf::Options options, ExtrasList& extras) {
+		fastgltf::Parser parser(fastgltf::Extensions::KHR_materials_variants | fastgltf::Extensions::KHR_texture_transform);
+		parser.setExtrasParseCallback(extrasCallback);
+		parser.setUserPointer(&extras);
+		return parser.loadGltfJson(jsonData, materialVariants, options);
+	};
+
+	ExtrasList sequentialExtras;
+	auto sequential = parseJson(fastgltf::Options::None, sequentialExtras);
+	REQUIRE(sequential.error() == fastgltf::Error::None);
+
+	ExtrasList parallelExtras;
+	auto parallel = parseJson(fastgltf::Options::ParseCategoriesInParallel, parallelExtras);
+	REQUIRE(parallel.error() == fastgltf::Error::None);
+	REQUIRE(fastgltf::validate(parallel.get()) == fastgltf::Error::None);
+
+	REQUIRE(parallel->accessors.size() == sequential->accessors.size());
+	REQUIRE(parallel->bufferViews.size() == sequential->bufferViews.size());
+	REQUIRE(parallel->materials.size() == sequential->materials.size());
+	REQUIRE(parallel->meshes.size() == sequential->meshes.size());
+	REQUIRE(parallel->nodes.size() == sequential->nodes.size());
+	REQUIRE(parallel->materialVariants.size() == sequential->materialVariants.size());
+	for (std::size_t i = 0; i < parallel->nodes.size(); ++i) {
+		REQUIRE(parallel->nodes[i].name == sequential->nodes[i].name);
+	}
+
+	// The extras callbacks need to be invoked in the same order for both modes.
+	REQUIRE(!parallelExtras.empty());
+	REQUIRE(parallelExtras == sequentialExtras);
+}
+
+TEST_CASE("Lazily load glTF categories", "[gltf-loader]") {
+	auto sponza = sampleAssets / "Models" / "Sponza" / "glTF";
+	fastgltf::GltfFileStream jsonData(sponza / "Sponza.gltf");
+	REQUIRE(jsonData.isOpen());
+
+	fastgltf::Parser parser;
+	auto lazy = parser.loadGltfLazy(jsonData, sponza);
+	REQUIRE(lazy.error() == fastgltf::Error::None);
+	REQUIRE(lazy->get().assetInfo.has_value());
+	REQUIRE(lazy->get().nodes.empty());
+	REQUIRE(lazy->get().materials.empty());
+
+	// Loading the nodes also has to load all categories they depend on.
+	auto nodes = lazy->nodes();
+	REQUIRE(nodes.error() == fastgltf::Error::None);
+	REQUIRE(!nodes.get().empty());
+	REQUIRE(lazy->isLoaded(fastgltf::Category::Meshes | fastgltf::Category::Accessors | fastgltf::Category::Materials));
+	REQUIRE(!lazy->isLoaded(fastgltf::Category::Animations));
+
+	// Requesting the same category again must not parse anything twice.
+	const auto nodeCount = nodes.get().size();
+	REQUIRE(lazy->nodes().get().size() == nodeCount);
+
+	REQUIRE(lazy->load(fastgltf::Category::All) == fastgltf::Error::None);
+	auto model = parser.loadGltfJson(jsonData, sponza);
+	REQUIRE(model.error() == fastgltf::Error::None);
+	REQUIRE(lazy->get().nodes.size() == model->nodes.size());
+	REQUIRE(lazy->get().accessors.size() == model->accessors.size());
+	REQUIRE(lazy->get().materials.size() == model->materials.size());
+	REQUIRE(fastgltf::validate(lazy->get()) == fastgltf::Error::None);
+}
+
+TEST_CASE("Parse with the On-Demand API", "[gltf-loader]") {
+	auto loadBoth = [](const std::filesystem::path& directory, const std::filesystem::path& file, fastgltf::Extensions extensions) {
+		fastgltf::GltfFileStream jsonData(directory / file);
+		REQUIRE(jsonData.isOpen());
+
+		fastgltf::Parser parser(extensions);
+		auto dom = parser.loadGltf(jsonData, directory);
+		REQUIRE(dom.error() == fastgltf::Error::None);
+		auto onDemand = parser.loadGltf(jsonData, directory, fastgltf::Options::UseOnDemandParser);
+		REQUIRE(onDemand.error() == fastgltf::Error::None);
+		REQUIRE(fastgltf::validate(onDemand.get()) == fastgltf::Error::None);
+
+		REQUIRE(dom->availableCategories == onDemand->availableCategories);
+		REQUIRE(dom->assetInfo->gltfVersion == onDemand->assetInfo->gltfVersion);
+		REQUIRE(dom->accessors.size() == onDemand->accessors.size());
+		REQUIRE(dom->bufferViews.size() == onDemand->bufferViews.size());
+		REQUIRE(dom->buffers.size() == onDemand->buffers.size());
+		REQUIRE(dom->materials.size() == onDemand->materials.size());
+		REQUIRE(dom->meshes.size() == onDemand->meshes.size());
+		REQUIRE(dom->nodes.size() == onDemand->nodes.size());
+		REQUIRE(dom->extensionsUsed.size() == onDemand->extensionsUsed.size());
+		for (std::size_t i = 0; i < dom->accessors.size(); ++i) {
+			auto& a = dom->accessors[i];
+			auto& b = onDemand->accessors[i];
+			REQUIRE(a.count == b.count);
+			REQUIRE(a.type == b.type);
+			REQUIRE(a.componentType == b.componentType);
+			REQUIRE(a.bufferViewIndex == b.bufferViewIndex);
+			REQUIRE(a.byteOffset == b.byteOffset);
+			REQUIRE(a.min.has_value() == b.min.has_value());
+			REQUIRE(a.max.has_value() == b.max.has_value());
+			REQUIRE(a.sparse.has_value() == b.sparse.has_value());
+			if (a.max.has_value()) {
+				REQUIRE(a.max->isType<double>() == b.max->isType<double>());
+				for (std::size_t j = 0; j < a.max->size(); ++j) {
+					REQUIRE(a.max->get<double>(j) == b.max->get<double>(j));
+					REQUIRE(a.min->get<double>(j) == b.min->get<double>(j));
+				}
+			}
+			if (a.sparse.has_value()) {
+				REQUIRE(a.sparse->count == b.sparse->count);
+				REQUIRE(a.sparse->indicesBufferView == b.sparse->indicesBufferView);
+				REQUIRE(a.sparse->valuesBufferView == b.sparse->valuesBufferView);
+				REQUIRE(a.sparse->indexComponentType == b.sparse->indexComponentType);
+			}
+		}
+		for (std::size_t i = 0; i < dom->bufferViews.size(); ++i) {
+			REQUIRE(dom->bufferViews[i].bufferIndex == onDemand->bufferViews[i].bufferIndex);
+			REQUIRE(dom->bufferViews[i].byteOffset == onDemand->bufferViews[i].byteOffset);
+			REQUIRE(dom->bufferViews[i].byteLength == onDemand->bufferViews[i].byteLength);
+			REQUIRE(dom->bufferViews[i].byteStride == onDemand->bufferViews[i].byteStride);
+		}
+		REQUIRE(dom->animations.size() == onDemand->animations.size());
+		for (std::size_t i = 0; i < dom->animations.size(); ++i) {
+			auto& a = dom->animations[i];
+			auto& b = onDemand->animations[i];
+			REQUIRE(a.name == b.name);
+			REQUIRE(a.channels.size() == b.channels.size());
+			REQUIRE(a.samplers.size() == b.samplers.size());
+			for (std::size_t j = 0; j < a.channels.size(); ++j) {
+				REQUIRE(a.channels[j].nodeIndex == b.channels[j].nodeIndex);
+				REQUIRE(a.channels[j].samplerIndex == b.channels[j].samplerIndex);
+				REQUIRE(a.channels[j].path == b.channels[j].path);
+			}
+			for (std::size_t j = 0; j < a.samplers.size(); ++j) {
+				REQUIRE(a.samplers[j].inputAccessor == b.samplers[j].inputAccessor);
+				REQUIRE(a.samplers[j].outputAccessor == b.samplers[j].outputAccessor);
+				REQUIRE(a.samplers[j].interpolation == b.samplers[j].interpolation);
+			}
+		}
+	};
+
+	SECTION("Sponza") {
+		loadBoth(sampleAssets / "Models" / "Sponza" / "glTF", "Sponza.gltf", fastgltf::Extensions::None);
+	}
+	SECTION("Animations") {
+		loadBoth(sampleAssets / "Models" / "AnimatedCube" / "glTF", "AnimatedCube.gltf", fastgltf::Extensions::None);
+	}
+	SECTION("Sparse accessors") {
+		loadBoth(sampleAssets / "Models" / "SimpleSparseAccessor" / "glTF", "SimpleSparseAccessor.gltf", fastgltf::Extensions::None);
+	}
+	SECTION("Extensions and bounds") {
+		loadBoth(sampleAssets / "Models" / "LightsPunctualLamp" / "glTF", "LightsPunctualLamp.gltf", fastgltf::Extensions::KHR_lights_punctual);
+	}
+	SECTION("GLB") {
+		loadBoth(sampleAssets / "Models" / "Box" / "glTF-Binary", "Box.glb", fastgltf::Extensions::None);
+	}
+
+	SECTION("Invalid documents") {
+		auto loadString = [](std::string_view json, fastgltf::Options options) {
+			auto data = fastgltf::GltfDataBuffer::FromBytes(reinterpret_cast<const std::byte*>(json.data()), json.size());
+			REQUIRE(data.error() == fastgltf::Error::None);
+			fastgltf::Parser parser;
+			return parser.loadGltfJson(data.get(), {}, options).error();
+		};
+		for (std::string_view json : {
+				R"({"nodes":[]})",
+				R"({"asset":{"version":"1.0"}})",
+				R"({"asset":{"version":"2.0"},"extensionsRequired":["KHR_texture_basisu"]})",
+				R"({"asset":{"version":"2.0"},"accessors":[{"count":1,"type":"VEC3","componentType":5126,"max":[1,2]}]})",
+				R"({"asset":{"version":"2.0"},"animations":[{"channels":[]}]})",
+				R"({"asset":{"version":"2.0"},"nodes":[)"}) {
+			REQUIRE(loadString(json, fastgltf::Options::UseOnDemandParser) == loadString(json, fastgltf::Options::None));
+		}
+	}
+}
+
 #if defined(FASTGLTF_HAS_MEMORY_MAPPED_FILE)
 TEST_CASE("Test glTF file loading", "[gltf-loader]") {
 	SECTION("Mapped files") {
@@ -8,6 +8,7 @@
 
 #include <fastgltf/core.hpp>
 #include <fastgltf/base64.hpp>
+#include <fastgltf/tools.hpp>
 #include "gltf_path.hpp"
 
 constexpr auto benchmarkOptions = fastgltf::Options::DontRequireValidAssetMember;
@@ -161,6 +162,10 @@ TEST_CASE("Benchmark base64 decoding from glTF file", "[gltf-benchmark]") {
         return parser.loadGltfJson(jsonData.get(), cylinderEngine, benchmarkOptions);
     };
 
+    BENCHMARK("Parse MetalRoughSpheres and decode base64 in parallel") {
+        return parser.loadGltfJson(jsonData.get(), cylinderEngine, benchmarkOptions | fastgltf::Options::DecodeDataUrisInParallel);
+    };
+
 #ifdef HAS_TINYGLTF
     setTinyGLTFCallbacks(tinygltf);
     BENCHMARK("MetalRoughSpheres decode with tinygltf") {
@@ -340,6 +345,70 @@ TEST_CASE("Compare parsing performance with minified documents", "[gltf-benchmar
     };
 }
 
+TEST_CASE("Benchmark JSON writing performance", "[gltf-benchmark]") {
+	auto sponzaPath = sampleAssets / "Models" / "Sponza" / "glTF";
+	auto sponzaData = fastgltf::GltfDataBuffer::FromPath(sponzaPath / "Sponza.gltf");
+	REQUIRE(sponzaData.error() == fastgltf::Error::None);
+
+	fastgltf::Parser parser;
+	auto sponza = parser.loadGltfJson(sponzaData.get(), sponzaPath, benchmarkOptions);
+	REQUIRE(sponza.error() == fastgltf::Error::None);
+
+	fastgltf::Exporter exporter;
+	BENCHMARK("Write Sponza.gltf") {
+		return exporter.writeGltfJson(sponza.get());
+	};
+
+	if (std::filesystem::exists(bistroPath / "bistro.gltf")) {
+		auto bistroData = fastgltf::GltfDataBuffer::FromPath(bistroPath / "bistro.gltf");
+		REQUIRE(bistroData.error() == fastgltf::Error::None);
+
+		fastgltf::Parser bistroParser(fastgltf::Extensions::KHR_mesh_quantization);
+		auto bistro = bistroParser.loadGltfJson(bistroData.get(), bistroPath, benchmarkOptions);
+		REQUIRE(bistro.error() == fastgltf::Error::None);
+
+		BENCHMARK("Write Bistro") {
+			return exporter.writeGltfJson(bistro.get());
+		};
+	}
+}
+
+TEST_CASE("Compare DOM and On-Demand parsing performance", "[gltf-benchmark]") {
+    auto sponzaPath = sampleAssets / "Models" / "Sponza" / "glTF";
+    auto bytes = readFileAsBytes(sponzaPath / "Sponza.gltf");
+	auto jsonData = fastgltf::GltfDataBuffer::FromBytes(
+			reinterpret_cast<const std::byte*>(bytes.data()), bytes.size());
+	REQUIRE(jsonData.error() == fastgltf::Error::None);
+
+    fastgltf::Parser parser;
+    BENCHMARK("Parse Sponza.gltf with the DOM API") {
+        return parser.loadGltfJson(jsonData.get(), sponzaPath, benchmarkOptions);
+    };
+
+    BENCHMARK("Parse Sponza.gltf with the On-Demand API") {
+        return parser.loadGltfJson(jsonData.get(), sponzaPath, benchmarkOptions | fastgltf::Options::UseOnDemandParser);
+    };
+
+    if (!std::filesystem::exists(bistroPath / "bistro.gltf")) {
+        // Bistro is not part of gltf-Sample-Models, and therefore not always available.
+        SKIP("Amazon's Bistro (GLTF) is required for the rest of this benchmark.");
+    }
+
+    fastgltf::Parser bistroParser(fastgltf::Extensions::KHR_mesh_quantization);
+    auto bistroBytes = readFileAsBytes(bistroPath / "bistro.gltf");
+	auto bistroData = fastgltf::GltfDataBuffer::FromBytes(
+			reinterpret_cast<const std::byte*>(bistroBytes.data()), bistroBytes.size());
+	REQUIRE(bistroData.error() == fastgltf::Error::None);
+
+    BENCHMARK("Parse Bistro with the DOM API") {
+        return bistroParser.loadGltfJson(bistroData.get(), bistroPath, benchmarkOptions);
+    };
+
+    BENCHMARK("Parse Bistro with the On-Demand API") {
+        return bistroParser.loadGltfJson(bistroData.get(), bistroPath, benchmarkOptions | fastgltf::Options::UseOnDemandParser);
+    };
+}
+
 TEST_CASE("Small CRC32-C benchmark", "[gltf-benchmark]") {
     static constexpr std::string_view test = "abcdefghijklmnopqrstuvwxyz";
     BENCHMARK("Default 1-byte tabular algorithm") {
@@ -418,6 +487,12 @@ TEST_CASE("Compare base64 decoding performance", "[gltf-benchmark]") {
 			return fastgltf::base64::avx2_decode(generatedData);
 		};
 	}
+
+	if (const auto* avx512 = impls["icelake"]; avx512 != nullptr && avx512->supported_by_runtime_system()) {
+		BENCHMARK("Run fastgltf's AVX-512 base64 decoder") {
+			return fastgltf::base64::avx512_decode(generatedData);
+		};
+	}
 #elif defined(FASTGLTF_IS_A64)
 	const auto& impls = simdjson::get_available_implementations();
 	if (const auto* neon = impls["arm64"]; neon != nullptr && neon->supported_by_runtime_system()) {
@@ -427,3 +502,148 @@ TEST_CASE("Compare base64 decoding performance", "[gltf-benchmark]") {
 	}
 #endif
 }
+
+TEST_CASE("Compare base64 encoding performance", "[gltf-benchmark]") {
+	constexpr std::size_t bufferSize = 2 * 1024 * 1024;
+
+	// We'll generate a random buffer
+	std::random_device device;
+	std::mt19937 gen(device());
+	std::uniform_int_distribution<unsigned> distribution(0, 255);
+	std::vector<std::byte> generatedData(bufferSize);
+	for (auto& byte : generatedData) {
+		byte = static_cast<std::byte>(distribution(gen));
+	}
+	const fastgltf::span<const std::byte> data(generatedData.data(), generatedData.size());
+
+#ifdef HAS_TINYGLTF
+	BENCHMARK("Run tinygltf's base64 encoder") {
+		return tinygltf::base64_encode(reinterpret_cast<const unsigned char*>(generatedData.data()), static_cast<unsigned>(generatedData.size()));
+	};
+#endif
+
+	BENCHMARK("Run fastgltf's fallback base64 encoder") {
+		return fastgltf::base64::fallback_encode(data);
+	};
+
+#if defined(FASTGLTF_IS_X86)
+	const auto& impls = simdjson::get_available_implementations();
+	if (const auto* sse4 = impls["westmere"]; sse4 != nullptr && sse4->supported_by_runtime_system()) {
+		BENCHMARK("Run fastgltf's SSE4 base64 encoder") {
+			return fastgltf::base64::sse4_encode(data);
+		};
+	}
+
+	if (const auto* avx2 = impls["haswell"]; avx2 != nullptr && avx2->supported_by_runtime_system()) {
+		BENCHMARK("Run fastgltf's AVX2 base64 encoder") {
+			return fastgltf::base64::avx2_encode(data);
+		};
+	}
+#elif defined(FASTGLTF_IS_A64)
+	const auto& impls = simdjson::get_available_implementations();
+	if (const auto* neon = impls["arm64"]; neon != nullptr && neon->supported_by_runtime_system()) {
+		BENCHMARK("Run fastgltf's Neon base64 encoder") {
+			return fastgltf::base64::neon_encode(data);
+		};
+	}
+#endif
+}
+
+TEST_CASE("Compare accessor conversion performance", "[gltf-benchmark]") {
+	constexpr std::size_t vertexCount = 1024 * 1024;
+
+	// We build an asset with a single interleaved buffer of 16-byte vertices, holding normalized
+	// u16vec2 UVs, normalized s8vec4 normals, u8vec3 colors, and another view with u16 indices.
+	std::random_device device;
+	std::mt19937 gen(device());
+	fastgltf::sources::Vector vector;
+	vector.bytes.resize(vertexCount * 16 + vertexCount * sizeof(std::uint16_t));
+	for (auto& byte : vector.bytes) {
+		byte = static_cast<std::byte>(gen());
+	}
+
+	fastgltf::Asset asset;
+	auto& buffer = asset.buffers.emplace_back();
+	buffer.byteLength = vector.bytes.size();
+	buffer.data = std::move(vector);
+
+	auto& vertexView = asset.bufferViews.emplace_back();
+	vertexView.byteLength = vertexCount * 16;
+	vertexView.byteStride = 16;
+	auto& indexView = asset.bufferViews.emplace_back();
+	indexView.byteOffset = vertexCount * 16;
+	indexView.byteLength = vertexCount * sizeof(std::uint16_t);
+
+	auto makeAccessor = [&](std::size_t view, std::size_t offset, fastgltf::AccessorType type, fastgltf::ComponentType componentType, bool normalized) {
+		fastgltf::Accessor accessor;
+		accessor.bufferViewIndex = view;
+		accessor.byteOffset = offset;
+		accessor.count = vertexCount;
+		accessor.type = type;
+		accessor.componentType = componentType;
+		accessor.normalized = normalized;
+		return accessor;
+	};
+	auto uvs = makeAccessor(0, 0, fastgltf::AccessorType::Vec2, fastgltf::ComponentType::UnsignedShort, true);
+	auto normals = makeAccessor(0, 4, fastgltf::AccessorType::Vec4, fastgltf::ComponentType::Byte, true);
+	auto colors = makeAccessor(0, 8, fastgltf::AccessorType::Vec3, fastgltf::ComponentType::UnsignedByte, true);
+	auto indices = makeAccessor(1, 0, fastgltf::AccessorType::Scalar, fastgltf::ComponentType::UnsignedShort, false);
+
+	std::vector<fastgltf::math::fvec4> output(vertexCount);
+	auto* outputBytes = reinterpret_cast<std::byte*>(output.data());
+
+	BENCHMARK("Scalar u16vec2 UV conversion") {
+		fastgltf::iterateAccessorWithIndex<fastgltf::math::fvec2>(asset, uvs, [&](fastgltf::math::fvec2 uv, std::size_t i) {
+			reinterpret_cast<fastgltf::math::fvec2*>(output.data())[i] = uv;
+		});
+		return output[0];
+	};
+	BENCHMARK("copyFromAccessor u16vec2 UVs") {
+		fastgltf::copyFromAccessor<fastgltf::math::fvec2>(asset, uvs, output.data());
+		return output[0];
+	};
+	BENCHMARK("copyFromAccessor s8vec4 normals") {
+		fastgltf::copyFromAccessor<fastgltf::math::fvec4>(asset, normals, output.data());
+		return output[0];
+	};
+	BENCHMARK("copyFromAccessor u8vec3 colors into a strided destination") {
+		fastgltf::copyFromAccessor<fastgltf::math::fvec3, sizeof(fastgltf::math::fvec4)>(asset, colors, output.data());
+		return output[0];
+	};
+	BENCHMARK("copyFromAccessor u16 indices to u32") {
+		fastgltf::copyFromAccessor<std::uint32_t>(asset, indices, output.data());
+		return output[0];
+	};
+
+	const auto* indexBytes = std::get<fastgltf::sources::Vector>(asset.buffers.front().data).bytes.data() + indexView.byteOffset;
+	auto runKernel = [&](auto kernel) {
+		return kernel(indexBytes, sizeof(std::uint16_t), fastgltf::ComponentType::UnsignedShort, outputBytes,
+			sizeof(float), fastgltf::ComponentType::Float, 1, vertexCount, true);
+	};
+
+	BENCHMARK("Run fastgltf's fallback u16 to float conversion") {
+		return runKernel(fastgltf::internal::fallback_convert_components);
+	};
+
+#if defined(FASTGLTF_IS_X86)
+	const auto& impls = simdjson::get_available_implementations();
+	if (const auto* sse4 = impls["westmere"]; sse4 != nullptr && sse4->supported_by_runtime_system()) {
+		BENCHMARK("Run fastgltf's SSE4 u16 to float conversion") {
+			return runKernel(fastgltf::internal::sse4_convert_components);
+		};
+	}
+
+	if (const auto* avx2 = impls["haswell"]; avx2 != nullptr && avx2->supported_by_runtime_system()) {
+		BENCHMARK("Run fastgltf's AVX2 u16 to float conversion") {
+			return runKernel(fastgltf::internal::avx2_convert_components);
+		};
+	}
+#elif defined(FASTGLTF_IS_A64)
+	const auto& impls = simdjson::get_available_implementations();
+	if (const auto* neon = impls["arm64"]; neon != nullptr && neon->supported_by_runtime_system()) {
+		BENCHMARK("Run fastgltf's Neon u16 to float conversion") {
+			return runKernel(fastgltf::internal::neon_convert_components);
+		};
+	}
+#endif
+}
@@ -3,6 +3,8 @@
 #include <catch2/benchmark/catch_benchmark.hpp>
 
 #include <fastgltf/core.hpp>
+#include <fastgltf/meshopt.hpp>
+#include <fastgltf/tools.hpp>
 #include "gltf_path.hpp"
 
 // Tests for extension functionality, declared in the same order as the fastgltf::Extensions enum.
@@ -101,6 +103,227 @@ TEST_CASE("Extension EXT_meshopt_compression", "[gltf-loader]") {
 	}
 }
 
+#if FASTGLTF_ENABLE_MESHOPT_DECODER
+TEST_CASE("Decode EXT_meshopt_compression bitstreams", "[gltf-loader]") {
+	auto toBytes = [](std::initializer_list<std::uint8_t> values) {
+		std::vector<std::byte> bytes;
+		for (auto value : values)
+			bytes.emplace_back(static_cast<std::byte>(value));
+		return bytes;
+	};
+
+	SECTION("Vertex buffer") {
+		// Every byte stream uses a single group with zero bits, so all elements are equal to the tail element.
+		auto data = toBytes({ 0xA0, 0, 0, 0, 0 });
+		data.resize(data.size() + 28);
+		for (std::uint8_t i = 1; i <= 4; ++i)
+			data.emplace_back(static_cast<std::byte>(i));
+
+		std::array<std::byte, 16 * 4> vertices {};
+		REQUIRE(fastgltf::meshopt::decodeVertexBuffer(vertices.data(), 16, 4, fastgltf::span<const std::byte>(data.data(), data.size())));
+		for (std::size_t i = 0; i < vertices.size(); ++i) {
+			REQUIRE(static_cast<std::size_t>(vertices[i]) == i % 4 + 1);
+		}
+
+		// A truncated tail and an invalid stride are both rejected.
+		REQUIRE(!fastgltf::meshopt::decodeVertexBuffer(vertices.data(), 16, 4, fastgltf::span<const std::byte>(data.data(), data.size() - 1)));
+		REQUIRE(!fastgltf::meshopt::decodeVertexBuffer(vertices.data(), 16, 3, fastgltf::span<const std::byte>(data.data(), data.size())));
+	}
+
+	SECTION("Index buffer") {
+		// The first triangle only uses new vertices, and the second one reuses the edge (2, 1).
+		auto data = toBytes({ 0xE1, 0xF0, 0x10 });
+		data.resize(data.size() + 16);
+
+		std::array<std::uint16_t, 6> indices {};
+		REQUIRE(fastgltf::meshopt::decodeIndexBuffer(reinterpret_cast<std::byte*>(indices.data()), indices.size(), sizeof(std::uint16_t), fastgltf::span<const std::byte>(data.data(), data.size())));
+		REQUIRE(indices == std::array<std::uint16_t, 6> { 0, 1, 2, 2, 1, 3 });
+
+		// Unknown versions are rejected.
+		data[0] = std::byte(0xE2);
+		REQUIRE(!fastgltf::meshopt::decodeIndexBuffer(reinterpret_cast<std::byte*>(indices.data()), indices.size(), sizeof(std::uint16_t), fastgltf::span<const std::byte>(data.data(), data.size())));
+	}
+
+	SECTION("Index sequence") {
+		auto data = toBytes({ 0xD1, 20, 4, 4, 0, 0, 0, 0 });
+
+		std::array<std::uint32_t, 3> indices {};
+		REQUIRE(fastgltf::meshopt::decodeIndexSequence(reinterpret_cast<std::byte*>(indices.data()), indices.size(), sizeof(std::uint32_t), fastgltf::span<const std::byte>(data.data(), data.size())));
+		REQUIRE(indices == std::array<std::uint32_t, 3> { 5, 6, 7 });
+
+		// Unknown versions are rejected.
+		data[0] = std::byte(0xD2);
+		REQUIRE(!fastgltf::meshopt::decodeIndexSequence(reinterpret_cast<std::byte*>(indices.data()), indices.size(), sizeof(std::uint32_t), fastgltf::span<const std::byte>(data.data(), data.size())));
+	}
+
+	SECTION("Filters") {
+		std::array<std::int8_t, 4> normal { 0, 0, 127, 5 };
+		REQUIRE(fastgltf::meshopt::decodeFilter(fastgltf::MeshoptCompressionFilter::Octahedral, reinterpret_cast<std::byte*>(normal.data()), 1, 4));
+		REQUIRE(normal == std::array<std::int8_t, 4> { 0, 0, 127, 5 });
+
+		// The identity quaternion, with w as the largest component.
+		std::array<std::int16_t, 4> rotation { 0, 0, 0, 32767 };
+		REQUIRE(fastgltf::meshopt::decodeFilter(fastgltf::MeshoptCompressionFilter::Quaternion, reinterpret_cast<std::byte*>(rotation.data()), 1, 8));
+		REQUIRE(rotation == std::array<std::int16_t, 4> { 0, 0, 0, 32767 });
+
+		// 6 * 2^-2
+		std::array<std::uint32_t, 1> value { (static_cast<std::uint32_t>(-2) << 24) | 6 };
+		REQUIRE(fastgltf::meshopt::decodeFilter(fastgltf::MeshoptCompressionFilter::Exponential, reinterpret_cast<std::byte*>(value.data()), 1, 4));
+		REQUIRE(fastgltf::bit_cast<float>(value[0]) == 1.5f);
+	}
+}
+
+TEST_CASE("Decode EXT_meshopt_compression buffer views", "[gltf-loader]") {
+	SECTION("Inline") {
+		// The first buffer contains the two streams from the bitstream test above.
+		constexpr std::string_view json = R"({
+			"asset": { "version": "2.0" },
+			"extensionsUsed": [ "EXT_meshopt_compression" ],
+			"extensionsRequired": [ "EXT_meshopt_compression" ],
+			"buffers": [
+				{ "byteLength": 45, "uri": "data:application/octet-stream;base64,oAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAQIDBNAUBAQAAAAA" },
+				{ "byteLength": 76, "extensions": { "EXT_meshopt_compression": { "fallback": true } } }
+			],
+			"bufferViews": [
+				{ "buffer": 1, "byteOffset": 0, "byteLength": 64, "byteStride": 4, "extensions": { "EXT_meshopt_compression": {
+					"buffer": 0, "byteOffset": 0, "byteLength": 37, "byteStride": 4, "count": 16, "mode": "ATTRIBUTES" } } },
+				{ "buffer": 1, "byteOffset": 64, "byteLength": 12, "extensions": { "EXT_meshopt_compression": {
+					"buffer": 0, "byteOffset": 37, "byteLength": 8, "byteStride": 4, "count": 3, "mode": "INDICES" } } }
+			],
+			"accessors": [
+				{ "bufferView": 0, "componentType": 5121, "type": "VEC4", "count": 16 },
+				{ "bufferView": 1, "componentType": 5125, "type": "SCALAR", "count": 3 }
+			]
+		})";
+		auto data = fastgltf::GltfDataBuffer::FromBytes(reinterpret_cast<const std::byte*>(json.data()), json.size());
+		REQUIRE(data.error() == fastgltf::Error::None);
+
+		fastgltf::Parser parser(fastgltf::Extensions::EXT_meshopt_compression);
+		auto asset = parser.loadGltfJson(data.get(), {}, fastgltf::Options::DecodeMeshoptCompression);
+		REQUIRE(asset.error() == fastgltf::Error::None);
+		REQUIRE(std::holds_alternative<fastgltf::sources::Array>(asset->buffers[1].data));
+
+		std::size_t count = 0;
+		fastgltf::iterateAccessor<fastgltf::math::u8vec4>(asset.get(), asset->accessors[0], [&](fastgltf::math::u8vec4 vertex) {
+			REQUIRE(vertex == fastgltf::math::u8vec4(1, 2, 3, 4));
+			++count;
+		});
+		REQUIRE(count == 16);
+
+		std::array<std::uint32_t, 3> indices {};
+		fastgltf::copyFromAccessor<std::uint32_t>(asset.get(), asset->accessors[1], indices.data());
+		REQUIRE(indices == std::array<std::uint32_t, 3> { 5, 6, 7 });
+	}
+
+	SECTION("Invalid views") {
+		// Two views decoding into the same fallback buffer, with their offsets, strides, counts, and modes replaced.
+		auto makeJson = [](std::string_view secondOffset, std::string_view stride, std::string_view count, std::string_view mode) {
+			return std::string(R"({
+				"asset": { "version": "2.0" },
+				"extensionsUsed": [ "EXT_meshopt_compression" ],
+				"extensionsRequired": [ "EXT_meshopt_compression" ],
+				"buffers": [
+					{ "byteLength": 45, "uri": "data:application/octet-stream;base64,oAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAQIDBNAUBAQAAAAA" },
+					{ "byteLength": 76, "extensions": { "EXT_meshopt_compression": { "fallback": true } } }
+				],
+				"bufferViews": [
+					{ "buffer": 1, "byteOffset": 0, "byteLength": 64, "byteStride": 4, "extensions": { "EXT_meshopt_compression": {
+						"buffer": 0, "byteOffset": 0, "byteLength": 37, "byteStride": )") + std::string(stride) + R"(, "count": )" + std::string(count)
+				+ R"(, "mode": ")" + std::string(mode) + R"(" } } },
+					{ "buffer": 1, "byteOffset": )" + std::string(secondOffset) + R"(, "byteLength": 12, "extensions": { "EXT_meshopt_compression": {
+						"buffer": 0, "byteOffset": 37, "byteLength": 8, "byteStride": 4, "count": 3, "mode": "INDICES" } } }
+				]
+			})";
+		};
+		auto load = [](const std::string& json, fastgltf::Options options) {
+			auto data = fastgltf::GltfDataBuffer::FromBytes(reinterpret_cast<const std::byte*>(json.data()), json.size());
+			REQUIRE(data.error() == fastgltf::Error::None);
+			fastgltf::Parser parser(fastgltf::Extensions::EXT_meshopt_compression);
+			return parser.loadGltfJson(data.get(), {}, options | fastgltf::Options::DecodeMeshoptCompression).error();
+		};
+
+		for (auto options : { fastgltf::Options::None, fastgltf::Options::UseOnDemandParser }) {
+			REQUIRE(load(makeJson("64", "4", "16", "ATTRIBUTES"), options) == fastgltf::Error::None);
+
+			// A count whose product with the stride wraps around to zero.
+			REQUIRE(load(makeJson("64", "4", "4611686018427387904", "ATTRIBUTES"), options) == fastgltf::Error::InvalidGltf);
+			REQUIRE(load(makeJson("64", "3", "16", "ATTRIBUTES"), options) == fastgltf::Error::InvalidGltf);
+			REQUIRE(load(makeJson("64", "260", "16", "ATTRIBUTES"), options) == fastgltf::Error::InvalidGltf);
+			REQUIRE(load(makeJson("64", "8", "2", "INDICES"), options) == fastgltf::Error::InvalidGltf);
+
+			// The second view would be decoded into the last bytes of the first one.
+			REQUIRE(load(makeJson("60", "4", "16", "ATTRIBUTES"), options) == fastgltf::Error::InvalidGltf);
+		}
+	}
+
+	SECTION("BrainStem") {
+		auto brainStem = sampleAssets / "Models" / "BrainStem" / "glTF-Meshopt";
+		fastgltf::GltfFileStream jsonData(brainStem / "BrainStem.gltf");
+		REQUIRE(jsonData.isOpen());
+
+		fastgltf::Parser parser(fastgltf::Extensions::EXT_meshopt_compression | fastgltf::Extensions::KHR_mesh_quantization);
+		auto asset = parser.loadGltfJson(jsonData, brainStem, fastgltf::Options::LoadExternalBuffers | fastgltf::Options::DecodeMeshoptCompression);
+		REQUIRE(asset.error() == fastgltf::Error::None);
+
+		for (auto& buffer : asset->buffers) {
+			REQUIRE(!std::holds_alternative<fastgltf::sources::Fallback>(buffer.data));
+		}
+
+		// Every decoded index has to reference a vertex of its primitive.
+		for (auto& mesh : asset->meshes) {
+			for (auto& primitive : mesh.primitives) {
+				REQUIRE(primitive.indicesAccessor.has_value());
+				auto vertexCount = asset->accessors[primitive.findAttribute("POSITION")->accessorIndex].count;
+				fastgltf::iterateAccessor<std::uint32_t>(asset.get(), asset->accessors[*primitive.indicesAccessor], [&](std::uint32_t index) {
+					REQUIRE(index < vertexCount);
+				});
+			}
+		}
+	}
+}
+#endif
+
+#if FASTGLTF_ENABLE_MESHOPT_ENCODER && FASTGLTF_ENABLE_MESHOPT_DECODER
+TEST_CASE("Encode EXT_meshopt_compression bitstreams", "[gltf-loader]") {
+	// Two strips of triangles over a grid, which are valid inputs for both index codecs.
+	std::vector<std::uint32_t> indices;
+	for (std::uint32_t i = 0; i < 64; ++i) {
+		indices.insert(indices.end(), { i, i + 65, i + 1, i + 1, i + 65, i + 66 });
+	}
+	const auto* source = reinterpret_cast<const std::byte*>(indices.data());
+
+	SECTION("Index buffer") {
+		std::vector<std::byte> encoded(fastgltf::meshopt::encodeIndexBufferBound(indices.size()));
+		auto size = fastgltf::meshopt::encodeIndexBuffer(encoded.data(), source, indices.size(), sizeof(std::uint32_t));
+		REQUIRE(size != 0);
+		REQUIRE(encoded[0] == std::byte(0xE1));
+
+		std::vector<std::uint32_t> decoded(indices.size());
+		REQUIRE(fastgltf::meshopt::decodeIndexBuffer(reinterpret_cast<std::byte*>(decoded.data()), decoded.size(), sizeof(std::uint32_t), fastgltf::span<const std::byte>(encoded.data(), size)));
+		for (std::size_t i = 0; i < indices.size(); i += 3) {
+			// The vertices within a triangle may be rotated.
+			bool matches = false;
+			for (std::size_t r = 0; r < 3; ++r) {
+				matches = matches || (decoded[i] == indices[i + r] && decoded[i + 1] == indices[i + (r + 1) % 3] && decoded[i + 2] == indices[i + (r + 2) % 3]);
+			}
+			REQUIRE(matches);
+		}
+	}
+
+	SECTION("Index sequence") {
+		std::vector<std::byte> encoded(fastgltf::meshopt::encodeIndexSequenceBound(indices.size()));
+		auto size = fastgltf::meshopt::encodeIndexSequence(encoded.data(), source, indices.size(), sizeof(std::uint32_t));
+		REQUIRE(size != 0);
+		// The extension requires version 1 for INDICES streams.
+		REQUIRE(encoded[0] == std::byte(0xD1));
+
+		std::vector<std::uint32_t> decoded(indices.size());
+		REQUIRE(fastgltf::meshopt::decodeIndexSequence(reinterpret_cast<std::byte*>(decoded.data()), decoded.size(), sizeof(std::uint32_t), fastgltf::span<const std::byte>(encoded.data(), size)));
+		REQUIRE(decoded == indices);
+	}
+}
+#endif
+
 TEST_CASE("Extension KHR_draco_mesh_compression", "[gltf-loader]") {
 	auto brainStem = sampleAssets / "Models" / "BrainStem" / "glTF-Draco";
 	fastgltf::GltfFileStream jsonData(brainStem / "BrainStem.gltf");
@@ -53,4 +53,118 @@ TEST_CASE("Load basic GLB file", "[gltf-loader]") {
         auto asset = parser.loadGltfBinary(byteBuffer.get(), folder, fastgltf::Options::None, fastgltf::Category::Buffers);
         REQUIRE(asset.error() == fastgltf::Error::None);
     }
+
+	SECTION("Load Box.glb without copying the BIN chunk") {
+		auto asset = parser.loadGltfBinary(jsonData.get(), folder, fastgltf::Options::ZeroCopyGLBBuffer, fastgltf::Category::Buffers);
+		REQUIRE(asset.error() == fastgltf::Error::None);
+		REQUIRE(fastgltf::validate(asset.get()) == fastgltf::Error::None);
+
+		REQUIRE(asset->buffers.size() == 1);
+
+		auto* byteView = std::get_if<fastgltf::sources::ByteView>(&asset->buffers.front().data);
+		REQUIRE(byteView != nullptr);
+		REQUIRE(byteView->bytes.size() == 1664 - 1016);
+
+		// The view should point directly into the data buffer.
+		auto fileSpan = static_cast<fastgltf::span<std::byte>>(jsonData.get());
+		REQUIRE(byteView->bytes.data() >= fileSpan.data());
+		REQUIRE(byteView->bytes.data() + byteView->bytes.size() <= fileSpan.data() + fileSpan.size());
+	}
+}
+
+TEST_CASE("Load GLB without reading the BIN chunk", "[gltf-loader]") {
+	auto folder = sampleAssets / "Models" / "Box" / "glTF-Binary";
+	fastgltf::GltfFileStream stream(folder / "Box.glb");
+	REQUIRE(stream.isOpen());
+
+	fastgltf::Parser parser;
+	auto asset = parser.loadGltfBinary(stream, folder, fastgltf::Options::DontLoadGLBBuffer, fastgltf::Category::Buffers);
+	REQUIRE(asset.error() == fastgltf::Error::None);
+	REQUIRE(fastgltf::validate(asset.get()) == fastgltf::Error::None);
+
+	REQUIRE(asset->buffers.size() == 1);
+	auto& buffer = asset->buffers.front();
+	auto* uri = std::get_if<fastgltf::sources::URI>(&buffer.data);
+	REQUIRE(uri != nullptr);
+	REQUIRE(uri->uri.path() == "Box.glb");
+	REQUIRE(uri->mimeType == fastgltf::MimeType::GltfBuffer);
+
+	// The BIN chunk data starts after the JSON chunk and the BIN chunk header.
+	REQUIRE(uri->fileByteOffset == 1016);
+	REQUIRE(uri->fileByteOffset + buffer.byteLength <= 1664);
+
+	// Only the headers and the JSON chunk should have been read.
+	REQUIRE(stream.bytesRead() == uri->fileByteOffset);
+}
+
+TEST_CASE("Load GLB without reading the BIN chunk from a path with URI delimiters", "[gltf-loader]") {
+	fastgltf::Asset original;
+	fastgltf::sources::Vector vector;
+	vector.bytes = { std::byte(1), std::byte(2), std::byte(3), std::byte(4) };
+	fastgltf::Buffer buffer;
+	buffer.byteLength = vector.bytes.size();
+	buffer.data = std::move(vector);
+	original.buffers.emplace_back(std::move(buffer));
+
+	fastgltf::Exporter exporter;
+	auto glb = exporter.writeGltfBinary(original);
+	REQUIRE(glb.error() == fastgltf::Error::None);
+
+	// The placeholder URI has to hold the file name as-is, without decoding "%25" or cutting it off at the '#'.
+	const auto directory = std::filesystem::temp_directory_path() / "fastgltf_glb_path_test";
+	const auto fileName = std::string_view("a%25 #b.glb");
+	std::filesystem::create_directories(directory);
+	{
+		std::ofstream file(directory / fileName, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(glb.get().output.data()), static_cast<std::streamsize>(glb.get().output.size()));
+	}
+
+	{
+		fastgltf::GltfFileStream stream(directory / fileName);
+		REQUIRE(stream.isOpen());
+
+		fastgltf::Parser parser;
+		auto asset = parser.loadGltfBinary(stream, directory, fastgltf::Options::DontLoadGLBBuffer, fastgltf::Category::Buffers);
+		REQUIRE(asset.error() == fastgltf::Error::None);
+
+		auto* uri = std::get_if<fastgltf::sources::URI>(&asset->buffers.front().data);
+		REQUIRE(uri != nullptr);
+		REQUIRE(uri->uri.path() == fileName);
+		REQUIRE(uri->uri.fragment().empty());
+		REQUIRE(uri->uri.isLocalPath());
+		REQUIRE(uri->uri.fspath() == std::filesystem::path(fileName));
+
+		// Copying the URI has to keep the path intact as well.
+		auto copy = uri->uri;
+		REQUIRE(copy.path() == fileName);
+		REQUIRE(std::filesystem::exists(directory / copy.fspath()));
+	}
+
+	std::filesystem::remove_all(directory);
+}
+
+#if defined(FASTGLTF_HAS_MEMORY_MAPPED_FILE)
+TEST_CASE("Load GLB without copying from a memory mapped file", "[gltf-loader]") {
+	auto folder = sampleAssets / "Models" / "Box" / "glTF-Binary";
+
+	fastgltf::Parser parser;
+	fastgltf::Expected<fastgltf::Asset> asset = fastgltf::Error::None;
+	{
+		auto mappedFile = fastgltf::MappedGltfFile::FromPath(folder / "Box.glb");
+		REQUIRE(mappedFile.error() == fastgltf::Error::None);
+
+		asset = parser.loadGltfBinary(mappedFile.get(), folder, fastgltf::Options::ZeroCopyGLBBuffer, fastgltf::Category::Buffers);
+		REQUIRE(asset.error() == fastgltf::Error::None);
+	}
+
+	// The mapping has to stay valid even after the MappedGltfFile has been destroyed.
+	REQUIRE(asset->buffers.size() == 1);
+	auto* byteView = std::get_if<fastgltf::sources::ByteView>(&asset->buffers.front().data);
+	REQUIRE(byteView != nullptr);
+	REQUIRE(byteView->bytes.size() == 1664 - 1016);
+	REQUIRE(fastgltf::validate(asset.get()) == fastgltf::Error::None);
+
+	auto asset2 = std::move(asset.get());
+	REQUIRE(std::get_if<fastgltf::sources::ByteView>(&asset2.buffers.front().data) != nullptr);
 }
+#endif
@@ -1,7 +1,9 @@
+#include <cstring>
 #include <random>
 
 #include <fastgltf/math.hpp>
 #include <fastgltf/core.hpp>
+#include <fastgltf/tools.hpp>
 #include "gltf_path.hpp"
 
 #include <glm/glm.hpp>
@@ -196,6 +198,12 @@ TEST_CASE("Vector operations", "[maths]") {
 		fastgltf::math::fvec3 b(3, -1, 2);
 		REQUIRE(cross(a, b) == fastgltf::math::fvec3(3, -7, -8));
 	}
+
+	SECTION("Quaternion normalize") {
+		fastgltf::math::fquat q(0.f, 0.f, 3.f, 4.f);
+		REQUIRE(q / 2.f == fastgltf::math::fquat(0.f, 0.f, 1.5f, 2.f));
+		REQUIRE(normalize(q) == fastgltf::math::fquat(0.f, 0.f, 0.6f, 0.8f));
+	}
 }
 
 TEST_CASE("Matrix operations", "[maths]") {
@@ -294,3 +302,360 @@ TEST_CASE("Test TRS parsing and optional decomposition", "[maths]") {
 		REQUIRE(glm::all(glm::epsilonEqual(glm::make_vec3(scale.data()), glmScale, glm::epsilon<float>())));
 	}
 }
+
+TEST_CASE("Test scene transform cache", "[maths]") {
+	// A small hierarchy with a TRS chain, a matrix node, and a second root.
+	fastgltf::Asset asset;
+	asset.nodes.resize(5);
+	asset.nodes[0].transform = fastgltf::TRS { fastgltf::math::fvec3(1, 2, 3), fastgltf::math::fquat(0.f, 0.7071068f, 0.f, 0.7071068f), fastgltf::math::fvec3(2.f) };
+	asset.nodes[0].children = { 1, 2 };
+	asset.nodes[1].transform = fastgltf::TRS { fastgltf::math::fvec3(0, 1, 0), fastgltf::math::fquat(0.f, 0.f, 0.f, 1.f), fastgltf::math::fvec3(1.f) };
+	asset.nodes[1].children = { 3 };
+	asset.nodes[2].transform = fastgltf::math::scale(fastgltf::math::fmat4x4(), fastgltf::math::fvec3(1, 0.5f, 1));
+	asset.nodes[3].transform = fastgltf::TRS { fastgltf::math::fvec3(-1, 0, 4), fastgltf::math::fquat(0.5f, 0.5f, 0.5f, 0.5f), fastgltf::math::fvec3(1.f) };
+	asset.nodes[4].transform = fastgltf::TRS {};
+	asset.scenes.emplace_back();
+	asset.scenes.back().nodeIndices = { 0, 4 };
+
+	auto checkAgainstIteration = [&](const fastgltf::SceneTransformCache& cache, const fastgltf::math::fmat4x4& initial) {
+		std::size_t visited = 0;
+		fastgltf::iterateSceneNodes(asset, 0, initial, [&](fastgltf::Node& node, const fastgltf::math::fmat4x4& matrix) {
+			const auto& cached = cache.getWorldMatrix(&node - asset.nodes.data());
+			for (std::size_t i = 0; i < 4; ++i)
+				for (std::size_t j = 0; j < 4; ++j)
+					REQUIRE(std::abs(cached.col(i)[j] - matrix.col(i)[j]) < 1e-5f);
+			++visited;
+		});
+		REQUIRE(visited == cache.size());
+	};
+
+	auto initial = fastgltf::math::translate(fastgltf::math::fmat4x4(), fastgltf::math::fvec3(0, -1, 0));
+	fastgltf::SceneTransformCache cache(asset, 0, initial);
+	REQUIRE(cache.size() == 5);
+	REQUIRE(cache.getNodeIndices()[0] == 0);
+	checkAgainstIteration(cache, initial);
+
+	// Changes are only visible after update, and only for the affected subtree.
+	const auto untouched = cache.getWorldMatrix(2);
+	fastgltf::TRS trs { fastgltf::math::fvec3(3, 0, 0), fastgltf::math::fquat(0.f, 0.f, 0.7071068f, 0.7071068f), fastgltf::math::fvec3(1.f) };
+	asset.nodes[1].transform = trs;
+	cache.setLocalTransform(1, trs);
+	cache.update();
+	checkAgainstIteration(cache, initial);
+	REQUIRE(cache.getWorldMatrix(2) == untouched);
+
+	asset.nodes[0].transform = fastgltf::math::fmat4x4();
+	cache.setLocalTransform(0, fastgltf::math::fmat4x4());
+	initial = fastgltf::math::fmat4x4();
+	cache.setRootTransform(initial);
+	cache.update();
+	checkAgainstIteration(cache, initial);
+}
+
+/** Appends an accessor with its own buffer and buffer view holding the given floats. */
+static std::size_t addFloatAccessor(fastgltf::Asset& asset, const std::vector<float>& data, fastgltf::AccessorType type) {
+	fastgltf::sources::Vector vector;
+	vector.bytes.resize(data.size() * sizeof(float));
+	std::memcpy(vector.bytes.data(), data.data(), vector.bytes.size());
+
+	fastgltf::Buffer buffer;
+	buffer.byteLength = vector.bytes.size();
+	buffer.data = std::move(vector);
+	asset.buffers.emplace_back(std::move(buffer));
+
+	fastgltf::BufferView view;
+	view.bufferIndex = asset.buffers.size() - 1;
+	view.byteOffset = 0;
+	view.byteLength = data.size() * sizeof(float);
+	asset.bufferViews.emplace_back(std::move(view));
+
+	fastgltf::Accessor accessor;
+	accessor.bufferViewIndex = asset.bufferViews.size() - 1;
+	accessor.componentType = fastgltf::ComponentType::Float;
+	accessor.type = type;
+	accessor.count = data.size() / fastgltf::getNumComponents(type);
+	asset.accessors.emplace_back(std::move(accessor));
+	return asset.accessors.size() - 1;
+}
+
+TEST_CASE("Test animation evaluator", "[maths]") {
+	fastgltf::Asset asset;
+	asset.nodes.resize(2);
+	fastgltf::Animation animation;
+	const auto times = addFloatAccessor(asset, { 0.f, 1.f, 2.f }, fastgltf::AccessorType::Scalar);
+	const auto rotations = addFloatAccessor(asset, {
+		0.f, 0.f, 0.f, 1.f,
+		0.f, 0.7071068f, 0.f, 0.7071068f,
+		0.f, 1.f, 0.f, 0.f,
+	}, fastgltf::AccessorType::Vec4);
+	const auto translations = addFloatAccessor(asset, { 1.f, 0.f, 0.f, 2.f, 0.f, 0.f, 3.f, 0.f, 0.f }, fastgltf::AccessorType::Vec3);
+	// Cubic spline keyframes with flat tangents: in-tangent, value, out-tangent.
+	const auto scales = addFloatAccessor(asset, {
+		0.f, 0.f, 0.f, 1.f, 1.f, 1.f, 0.f, 0.f, 0.f,
+		0.f, 0.f, 0.f, 3.f, 3.f, 3.f, 0.f, 0.f, 0.f,
+		0.f, 0.f, 0.f, 1.f, 1.f, 1.f, 0.f, 0.f, 0.f,
+	}, fastgltf::AccessorType::Vec3);
+	animation.samplers.push_back({ times, rotations, fastgltf::AnimationInterpolation::Linear });
+	animation.samplers.push_back({ times, translations, fastgltf::AnimationInterpolation::Step });
+	animation.samplers.push_back({ times, scales, fastgltf::AnimationInterpolation::CubicSpline });
+	animation.channels.push_back({ 0, 0U, fastgltf::AnimationPath::Rotation });
+	animation.channels.push_back({ 1, 0U, fastgltf::AnimationPath::Translation });
+	animation.channels.push_back({ 2, 1U, fastgltf::AnimationPath::Scale });
+	// The vec3 sampler can't be used for rotations, so this channel is ignored.
+	animation.channels.push_back({ 1, 1U, fastgltf::AnimationPath::Rotation });
+
+	fastgltf::AnimationEvaluator evaluator(asset, animation);
+	REQUIRE(evaluator.getChannelCount() == 3);
+	REQUIRE(evaluator.getStartTime() == 0.f);
+	REQUIRE(evaluator.getEndTime() == 2.f);
+	REQUIRE(evaluator.getAnimatedNodes().size() == 2);
+
+	std::vector<fastgltf::TRS> transforms(asset.nodes.size());
+	auto evaluate = [&](float time) {
+		evaluator.evaluate(time, fastgltf::span<fastgltf::TRS>(transforms.data(), transforms.size()));
+	};
+	auto requireRotation = [&](float angle) {
+		const auto& rotation = transforms[0].rotation;
+		REQUIRE(std::abs(rotation.x()) < 1e-6f);
+		REQUIRE(std::abs(rotation.y() - std::sin(angle / 2)) < 1e-6f);
+		REQUIRE(std::abs(rotation.z()) < 1e-6f);
+		REQUIRE(std::abs(rotation.w() - std::cos(angle / 2)) < 1e-6f);
+	};
+	constexpr auto pi = 3.14159265358979f;
+
+	evaluate(0.5f);
+	requireRotation(pi / 4);
+	REQUIRE(transforms[0].translation == fastgltf::math::fvec3(1.f, 0.f, 0.f));
+	REQUIRE(transforms[1].scale == fastgltf::math::fvec3(2.f));
+
+	// Jumping backwards and forwards has to give the same results as sampling in order.
+	evaluate(1.75f);
+	requireRotation(pi / 2 + pi * 3 / 8);
+	REQUIRE(transforms[0].translation == fastgltf::math::fvec3(2.f, 0.f, 0.f));
+	evaluate(0.25f);
+	requireRotation(pi / 8);
+	REQUIRE(transforms[0].translation == fastgltf::math::fvec3(1.f, 0.f, 0.f));
+
+	// Times outside of the keyframes are clamped.
+	evaluate(5.f);
+	requireRotation(pi);
+	REQUIRE(transforms[0].translation == fastgltf::math::fvec3(3.f, 0.f, 0.f));
+	REQUIRE(transforms[1].scale == fastgltf::math::fvec3(1.f));
+
+	float scale[3];
+	evaluator.sampleChannel(2, 1.f, scale);
+	REQUIRE(scale[0] == 3.f);
+}
+
+TEST_CASE("Test skin palette", "[maths]") {
+	fastgltf::Asset asset;
+	asset.nodes.resize(3);
+	asset.nodes[0].transform = fastgltf::TRS { fastgltf::math::fvec3(0, 1, 0), fastgltf::math::fquat(0.f, 0.f, 0.7071068f, 0.7071068f), fastgltf::math::fvec3(1.f) };
+	asset.nodes[0].children = { 1 };
+	asset.nodes[1].transform = fastgltf::TRS { fastgltf::math::fvec3(2, 0, 0), fastgltf::math::fquat(0.f, 0.f, 0.f, 1.f), fastgltf::math::fvec3(0.5f) };
+	asset.scenes.emplace_back();
+	asset.scenes.back().nodeIndices = { 0 };
+
+	// The second skin has no inverse bind matrices, and its second joint is not part of the scene.
+	const auto inverseBind = addFloatAccessor(asset, {
+		1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, -1.f, 0.f, 1.f,
+		2.f, 0.f, 0.f, 0.f, 0.f, 2.f, 0.f, 0.f, 0.f, 0.f, 2.f, 0.f, -3.f, 0.f, 0.f, 1.f,
+	}, fastgltf::AccessorType::Mat4);
+	asset.skins.emplace_back();
+	asset.skins[0].inverseBindMatrices = inverseBind;
+	asset.skins[0].joints = { 0, 1 };
+	asset.skins.emplace_back();
+	asset.skins[1].joints = { 1, 2 };
+
+	fastgltf::SkinPalette skins(asset);
+	REQUIRE(skins.size() == 4);
+	REQUIRE(skins.getSkinOffset(1) == 2);
+	REQUIRE(skins.getJointCount(1) == 2);
+
+	fastgltf::SceneTransformCache cache(asset, 0);
+	std::vector<fastgltf::math::fmat4x4> palette(skins.size());
+	skins.computeJointMatrices(cache, fastgltf::span<fastgltf::math::fmat4x4>(palette.data(), palette.size()));
+
+	const auto ibm = skins.getInverseBindMatrices();
+	REQUIRE(palette[0] == cache.getWorldMatrix(0) * ibm[0]);
+	REQUIRE(palette[1] == cache.getWorldMatrix(1) * ibm[1]);
+	REQUIRE(palette[2] == cache.getWorldMatrix(1));
+	REQUIRE(palette[3] == fastgltf::math::fmat4x4());
+
+	std::vector<fastgltf::math::fmat<4, 3>> affinePalette(skins.size());
+	skins.computeJointMatrices(cache, fastgltf::span<fastgltf::math::fmat<4, 3>>(affinePalette.data(), affinePalette.size()));
+	for (std::size_t i = 0; i < palette.size(); ++i) {
+		for (std::size_t row = 0; row < 3; ++row) {
+			REQUIRE(affinePalette[i].col(row) == palette[i].row(row));
+		}
+	}
+}
+
+TEST_CASE("Test position bounds", "[maths]") {
+	std::mt19937 random(1234);
+	std::uniform_real_distribution<float> distribution(-100.f, 100.f);
+
+	// Odd counts and a stride with padding exercise the remainder and strided paths of the kernels.
+	for (std::size_t count : { 1U, 7U, 64U, 1001U }) {
+		std::vector<float> positions(count * 4);
+		for (auto& value : positions)
+			value = distribution(random);
+
+		fastgltf::Asset asset;
+		const auto packed = addFloatAccessor(asset, positions, fastgltf::AccessorType::Vec3);
+		asset.accessors[packed].count = count;
+		const auto strided = addFloatAccessor(asset, positions, fastgltf::AccessorType::Vec4);
+		asset.accessors[strided].type = fastgltf::AccessorType::Vec3;
+		asset.bufferViews[*asset.accessors[strided].bufferViewIndex].byteStride = 4 * sizeof(float);
+
+		fastgltf::BoundingBox expectedPacked, expectedStrided;
+		for (std::size_t i = 0; i < count; ++i) {
+			expectedPacked.merge(fastgltf::math::fvec3(positions[i * 3], positions[i * 3 + 1], positions[i * 3 + 2]));
+			expectedStrided.merge(fastgltf::math::fvec3(positions[i * 4], positions[i * 4 + 1], positions[i * 4 + 2]));
+		}
+
+		auto packedBounds = fastgltf::computePositionBounds(asset, asset.accessors[packed]);
+		REQUIRE(packedBounds.min == expectedPacked.min);
+		REQUIRE(packedBounds.max == expectedPacked.max);
+		auto stridedBounds = fastgltf::computePositionBounds(asset, asset.accessors[strided]);
+		REQUIRE(stridedBounds.min == expectedStrided.min);
+		REQUIRE(stridedBounds.max == expectedStrided.max);
+	}
+
+	// Normalized shorts, where the sparse substitution replaces the smallest x value.
+	fastgltf::Asset asset;
+	const std::array<std::int16_t, 9> shorts {{ -32767, 0, 100, 32767, -200, 0, 16384, 300, -32767 }};
+	const std::array<std::int16_t, 3> sparseValue {{ 0, 32767, 0 }};
+	const std::array<std::uint8_t, 1> sparseIndex {{ 0 }};
+	fastgltf::sources::Vector vector;
+	vector.bytes.resize(sizeof(shorts) + sizeof(sparseValue) + sizeof(sparseIndex));
+	std::memcpy(vector.bytes.data(), shorts.data(), sizeof(shorts));
+	std::memcpy(vector.bytes.data() + sizeof(shorts), sparseValue.data(), sizeof(sparseValue));
+	std::memcpy(vector.bytes.data() + sizeof(shorts) + sizeof(sparseValue), sparseIndex.data(), sizeof(sparseIndex));
+	fastgltf::Buffer buffer;
+	buffer.byteLength = vector.bytes.size();
+	buffer.data = std::move(vector);
+	asset.buffers.emplace_back(std::move(buffer));
+
+	fastgltf::BufferView view;
+	view.bufferIndex = 0;
+	view.byteLength = asset.buffers[0].byteLength;
+	asset.bufferViews.emplace_back(std::move(view));
+
+	fastgltf::Accessor accessor;
+	accessor.bufferViewIndex = 0;
+	accessor.componentType = fastgltf::ComponentType::Short;
+	accessor.type = fastgltf::AccessorType::Vec3;
+	accessor.normalized = true;
+	accessor.count = 3;
+	accessor.sparse = fastgltf::SparseAccessor { 1, 0, sizeof(shorts) + sizeof(sparseValue), 0, sizeof(shorts), fastgltf::ComponentType::UnsignedByte };
+
+	auto bounds = fastgltf::computePositionBounds(asset, accessor);
+	REQUIRE(bounds.min == fastgltf::math::fvec3(0.f, -200.f / 32767.f, -1.f));
+	REQUIRE(bounds.max == fastgltf::math::fvec3(1.f, 1.f, 0.f));
+
+	// The stored bounds take precedence, and are normalized just like the elements.
+	accessor.min = fastgltf::AccessorBoundsArray(3, fastgltf::AccessorBoundsArray::BoundsType::int64);
+	accessor.max = fastgltf::AccessorBoundsArray(3, fastgltf::AccessorBoundsArray::BoundsType::int64);
+	for (std::size_t i = 0; i < 3; ++i) {
+		accessor.min->set<std::int64_t>(i, -32768);
+		accessor.max->set<std::int64_t>(i, 32767);
+	}
+	asset.accessors.emplace_back(std::move(accessor));
+	asset.meshes.emplace_back();
+	asset.meshes[0].primitives.emplace_back();
+	asset.meshes[0].primitives[0].attributes.emplace_back(fastgltf::Attribute { "POSITION", 0 });
+	asset.meshes.emplace_back();
+
+	auto meshBounds = fastgltf::computeMeshBounds(asset);
+	REQUIRE(meshBounds.size() == 2);
+	REQUIRE(meshBounds[0].min == fastgltf::math::fvec3(-1.f));
+	REQUIRE(meshBounds[0].max == fastgltf::math::fvec3(1.f));
+	REQUIRE(meshBounds[1].empty());
+
+	// Transforming a box has to enclose all of its transformed corners.
+	fastgltf::BoundingBox box { fastgltf::math::fvec3(-1.f, 0.f, 2.f), fastgltf::math::fvec3(1.f, 3.f, 4.f) };
+	auto matrix = fastgltf::math::rotate(fastgltf::math::translate(fastgltf::math::fmat4x4(), fastgltf::math::fvec3(1.f, 2.f, 3.f)),
+		fastgltf::math::fquat(0.f, 0.f, 0.7071068f, 0.7071068f));
+	auto transformed = fastgltf::transformBounds(box, matrix);
+	for (std::size_t corner = 0; corner < 8; ++corner) {
+		fastgltf::math::fvec4 point((corner & 1) ? box.max.x() : box.min.x(), (corner & 2) ? box.max.y() : box.min.y(),
+			(corner & 4) ? box.max.z() : box.min.z(), 1.f);
+		auto result = matrix * point;
+		for (std::size_t i = 0; i < 3; ++i) {
+			REQUIRE(result[i] >= transformed.min[i] - 1e-5f);
+			REQUIRE(result[i] <= transformed.max[i] + 1e-5f);
+		}
+	}
+	REQUIRE(std::abs(transformed.min.x() + 2.f) < 1e-5f);
+	REQUIRE(std::abs(transformed.max.y() - 3.f) < 1e-5f);
+}
+
+TEST_CASE("Test scene BVH culling", "[maths]") {
+	std::mt19937 random(42);
+	std::uniform_real_distribution<float> position(-50.f, 50.f);
+
+	// Two meshes, and a flat hierarchy of nodes scattered around the origin.
+	fastgltf::Asset asset;
+	asset.meshes.resize(2);
+	const std::array<fastgltf::BoundingBox, 2> meshBounds {{
+		{ fastgltf::math::fvec3(-1.f), fastgltf::math::fvec3(1.f) },
+		{ fastgltf::math::fvec3(0.f, 0.f, -2.f), fastgltf::math::fvec3(0.5f, 4.f, 2.f) },
+	}};
+	asset.nodes.resize(301);
+	for (std::size_t i = 1; i < asset.nodes.size(); ++i) {
+		asset.nodes[i].transform = fastgltf::TRS { fastgltf::math::fvec3(position(random), position(random), position(random)),
+			fastgltf::math::fquat(0.f, 0.f, 0.f, 1.f), fastgltf::math::fvec3(1.f) };
+		if (i % 7 != 0)
+			asset.nodes[i].meshIndex = i % 2;
+		asset.nodes[0].children.emplace_back(i);
+	}
+	asset.scenes.emplace_back();
+	asset.scenes.back().nodeIndices = { 0 };
+
+	fastgltf::SceneTransformCache cache(asset, 0);
+	fastgltf::SceneBVH bvh(asset, cache, fastgltf::span<const fastgltf::BoundingBox>(meshBounds.data(), meshBounds.size()));
+	REQUIRE(bvh.size() == 300 - 300 / 7);
+
+	auto checkAgainstBruteForce = [&](const std::vector<fastgltf::math::fvec4>& planes) {
+		std::vector<std::size_t> visible;
+		bvh.cull(fastgltf::span<const fastgltf::math::fvec4>(planes.data(), planes.size()), visible);
+		std::sort(visible.begin(), visible.end());
+
+		std::vector<std::size_t> expected;
+		for (std::size_t i = 1; i < asset.nodes.size(); ++i) {
+			if (!asset.nodes[i].meshIndex)
+				continue;
+			auto bounds = fastgltf::transformBounds(meshBounds[*asset.nodes[i].meshIndex], cache.getWorldMatrix(i));
+			bool inside = true;
+			for (const auto& plane : planes) {
+				float farthest = plane.w();
+				for (std::size_t j = 0; j < 3; ++j)
+					farthest += plane[j] * (plane[j] >= 0.f ? bounds.max[j] : bounds.min[j]);
+				inside &= farthest >= 0.f;
+			}
+			if (inside)
+				expected.emplace_back(i);
+		}
+		REQUIRE(visible == expected);
+	};
+
+	// A box around the origin, a single half-space, and no planes at all.
+	checkAgainstBruteForce({
+		{ 1.f, 0.f, 0.f, 20.f }, { -1.f, 0.f, 0.f, 20.f }, { 0.f, 1.f, 0.f, 20.f },
+		{ 0.f, -1.f, 0.f, 20.f }, { 0.f, 0.f, 1.f, 20.f }, { 0.f, 0.f, -1.f, 20.f },
+	});
+	checkAgainstBruteForce({ { 0.7071068f, 0.7071068f, 0.f, -10.f } });
+	checkAgainstBruteForce({});
+
+	// Moving nodes only changes the results after refitting.
+	for (std::size_t i = 1; i < asset.nodes.size(); i += 3) {
+		fastgltf::TRS trs { fastgltf::math::fvec3(position(random), position(random), position(random)),
+			fastgltf::math::fquat(0.f, 0.7071068f, 0.f, 0.7071068f), fastgltf::math::fvec3(2.f) };
+		asset.nodes[i].transform = trs;
+		cache.setLocalTransform(i, trs);
+	}
+	cache.update();
+	bvh.refit(cache);
+	checkAgainstBruteForce({ { 1.f, 0.f, 0.f, 5.f }, { 0.f, -1.f, 0.f, 30.f } });
+}
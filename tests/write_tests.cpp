@@ -1,6 +1,9 @@
 #include <algorithm>
+#include <atomic>
 #include <cinttypes>
+#include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <fstream>
 
 #include <catch2/catch_test_macros.hpp>
@@ -8,6 +11,7 @@
 #include <simdjson.h>
 
 #include <fastgltf/core.hpp>
+#include <fastgltf/tools.hpp>
 #include "gltf_path.hpp"
 
 TEST_CASE("Test simple glTF composition", "[write-tests]") {
@@ -102,6 +106,52 @@ TEST_CASE("Try writing a glTF with all buffers and images", "[write-tests]") {
 	REQUIRE(std::filesystem::exists(exportedFolder / "image1.bin"));
 }
 
+TEST_CASE("Try writing a glTF with buffers and images as data URIs", "[write-tests]") {
+	std::vector<std::byte> bufferData(1000);
+	for (std::size_t i = 0; i < bufferData.size(); ++i) {
+		bufferData[i] = static_cast<std::byte>(i * 7);
+	}
+
+	fastgltf::Asset asset;
+	fastgltf::Buffer buffer;
+	buffer.byteLength = bufferData.size();
+	buffer.data = fastgltf::sources::Vector { bufferData, fastgltf::MimeType::None };
+	asset.buffers.emplace_back(std::move(buffer));
+
+	fastgltf::Image image;
+	fastgltf::StaticVector<std::byte> imageData(50);
+	std::memcpy(imageData.data(), bufferData.data(), imageData.size());
+	image.data = fastgltf::sources::Array { std::move(imageData), fastgltf::MimeType::PNG };
+	asset.images.emplace_back(std::move(image));
+
+	fastgltf::Exporter exporter;
+	auto expected = exporter.writeGltfJson(asset, fastgltf::ExportOptions::WriteDataUris);
+	REQUIRE(expected.error() == fastgltf::Error::None);
+	REQUIRE(!expected.get().bufferPaths.front().has_value());
+	REQUIRE(!expected.get().imagePaths.front().has_value());
+
+	auto& json = expected.get().output;
+	REQUIRE(json.find("data:application/octet-stream;base64,") != std::string::npos);
+	REQUIRE(json.find("data:image/png;base64,") != std::string::npos);
+
+	auto exportedJsonData = fastgltf::GltfDataBuffer::FromBytes(reinterpret_cast<const std::byte*>(json.data()), json.size());
+	REQUIRE(exportedJsonData.error() == fastgltf::Error::None);
+	fastgltf::Parser parser;
+	auto reparsed = parser.loadGltfJson(exportedJsonData.get(), {});
+	REQUIRE(reparsed.error() == fastgltf::Error::None);
+
+	auto* reparsedBuffer = std::get_if<fastgltf::sources::Array>(&reparsed->buffers.front().data);
+	REQUIRE(reparsedBuffer != nullptr);
+	REQUIRE(reparsedBuffer->bytes.size() == bufferData.size());
+	REQUIRE(std::memcmp(reparsedBuffer->bytes.data(), bufferData.data(), bufferData.size()) == 0);
+
+	auto* reparsedImage = std::get_if<fastgltf::sources::Array>(&reparsed->images.front().data);
+	REQUIRE(reparsedImage != nullptr);
+	REQUIRE(reparsedImage->mimeType == fastgltf::MimeType::PNG);
+	REQUIRE(reparsedImage->bytes.size() == 50);
+	REQUIRE(std::memcmp(reparsedImage->bytes.data(), bufferData.data(), 50) == 0);
+}
+
 TEST_CASE("Try writing a GLB with all buffers and images", "[write-tests]") {
     auto cubePath = sampleAssets / "Models" / "Cube" / "glTF";
 
@@ -161,12 +211,43 @@ TEST_CASE("Test string escape", "[write-tests]") {
     REQUIRE(escaped == "\\\"stuff\\\\");
 }
 
+TEST_CASE("Test string escaping of exported names", "[write-tests]") {
+	// Every character which needs escaping has to be escaped, even if they directly follow each other.
+	REQUIRE(fastgltf::escapeString("a\\\"b") == "a\\\\\\\"b");
+
+	fastgltf::Asset asset;
+	fastgltf::Node node;
+	node.name = "\"quoted\" \\\"name\"\\";
+	asset.nodes.emplace_back(std::move(node));
+
+	fastgltf::Exporter exporter;
+	auto expected = exporter.writeGltfJson(asset);
+	REQUIRE(expected.error() == fastgltf::Error::None);
+
+	auto exportedJsonData = fastgltf::GltfDataBuffer::FromBytes(
+			reinterpret_cast<const std::byte*>(expected.get().output.data()), expected.get().output.size());
+	REQUIRE(exportedJsonData.error() == fastgltf::Error::None);
+
+	fastgltf::Parser parser;
+	auto reparsed = parser.loadGltfJson(exportedJsonData.get(), {});
+	REQUIRE(reparsed.error() == fastgltf::Error::None);
+	REQUIRE(reparsed->nodes.size() == 1);
+	REQUIRE(reparsed->nodes.front().name == "\"quoted\" \\\"name\"\\");
+}
+
 TEST_CASE("Test pretty-print", "[write-tests]") {
     std::string json = R"({"value":5,"thing":{}})";
     fastgltf::prettyPrintJson(json);
 	REQUIRE(json == "{\n\t\"value\":5,\n\t\"thing\":{\n\t\t\n\t}\n}");
 }
 
+TEST_CASE("Test pretty-printing strings with escapes", "[write-tests]") {
+	// Brackets and commas within strings are copied as-is, and an escaped backslash doesn't escape the closing quote.
+	std::string json = R"({"a\\":"{[,\"]}","b":[1,2]})";
+	fastgltf::prettyPrintJson(json);
+	REQUIRE(json == "{\n\t\"a\\\\\":\"{[,\\\"]}\",\n\t\"b\":[\n\t\t1,\n\t\t2\n\t]\n}");
+}
+
 TEST_CASE("Test all local models and re-export them", "[write-tests]") {
 	// Enable all extensions
 	static constexpr auto requiredExtensions = static_cast<fastgltf::Extensions>(~0U);
@@ -383,6 +464,128 @@ TEST_CASE("Test floating point round-trip precision", "[write-tests]") {
 	}
 }
 
+TEST_CASE("Test writing GLBs into a GltfDataSink", "[write-tests]") {
+	fastgltf::Asset asset;
+	fastgltf::sources::Vector vector;
+	vector.bytes = { std::byte(1), std::byte(2), std::byte(3), std::byte(4), std::byte(5) };
+	fastgltf::Buffer buffer;
+	buffer.byteLength = vector.bytes.size();
+	buffer.data = std::move(vector);
+	asset.buffers.emplace_back(std::move(buffer));
+
+	class CollectingSink : public fastgltf::GltfDataSink {
+	public:
+		std::vector<std::byte> bytes;
+		std::size_t calls = 0;
+		bool fail = false;
+
+		bool write(fastgltf::span<const fastgltf::span<const std::byte>> chunks) override {
+			++calls;
+			for (const auto& chunk : chunks)
+				bytes.insert(bytes.end(), chunk.begin(), chunk.end());
+			return !fail;
+		}
+	};
+
+	fastgltf::Exporter exporter;
+	auto glb = exporter.writeGltfBinary(asset);
+	REQUIRE(glb.error() == fastgltf::Error::None);
+
+	// The whole GLB is handed to the sink at once, and is identical to the in-memory GLB.
+	CollectingSink sink;
+	auto streamed = exporter.writeGltfBinary(asset, sink);
+	REQUIRE(streamed.error() == fastgltf::Error::None);
+	REQUIRE(sink.calls == 1);
+	REQUIRE(streamed.get().output == glb.get().output.size());
+	REQUIRE(sink.bytes == glb.get().output);
+	REQUIRE(sink.bytes.size() % 4 == 0);
+
+	CollectingSink failingSink;
+	failingSink.fail = true;
+	REQUIRE(exporter.writeGltfBinary(asset, failingSink).error() == fastgltf::Error::FailedWritingFiles);
+
+	auto exportedPath = path / "export_glb" / "sink.glb";
+	std::filesystem::create_directory(exportedPath.parent_path());
+	{
+		fastgltf::GltfFileSink file(exportedPath);
+		REQUIRE(file.isOpen());
+		REQUIRE(exporter.writeGltfBinary(asset, file).error() == fastgltf::Error::None);
+	}
+
+	auto readFile = [](const std::filesystem::path& filePath) {
+		std::ifstream file(filePath, std::ios::binary);
+		return std::vector<char>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	};
+	auto fileBytes = readFile(exportedPath);
+	REQUIRE(fileBytes.size() == sink.bytes.size());
+	REQUIRE(std::memcmp(fileBytes.data(), sink.bytes.data(), fileBytes.size()) == 0);
+
+	// A failed export must not replace or truncate an existing file.
+	auto fileExportPath = path / "export_glb" / "replaced.glb";
+	fastgltf::FileExporter fileExporter;
+	REQUIRE(fileExporter.writeGltfBinary(asset, fileExportPath) == fastgltf::Error::None);
+	REQUIRE(readFile(fileExportPath) == fileBytes);
+
+	asset.buffers.emplace_back().data = fastgltf::sources::CustomBuffer {};
+	REQUIRE(fileExporter.writeGltfBinary(asset, fileExportPath) == fastgltf::Error::InvalidGltf);
+	REQUIRE(readFile(fileExportPath) == fileBytes);
+	REQUIRE(!std::filesystem::exists(fileExportPath.string() + ".tmp"));
+}
+
+TEST_CASE("Test writing and loading asset caches", "[write-tests]") {
+	fastgltf::Asset asset;
+	fastgltf::sources::Vector vector;
+	vector.bytes = { std::byte(1), std::byte(2), std::byte(3), std::byte(4), std::byte(5) };
+	fastgltf::Buffer buffer;
+	buffer.byteLength = vector.bytes.size();
+	buffer.data = std::move(vector);
+	buffer.name = "buffer";
+	asset.buffers.emplace_back(std::move(buffer));
+
+	fastgltf::Node node;
+	node.name = "node";
+	node.children = { 1 };
+	node.transform = fastgltf::TRS { fastgltf::math::fvec3(1.f, 2.f, 3.f) };
+	asset.nodes.emplace_back(std::move(node));
+	asset.nodes.emplace_back();
+
+	constexpr std::uint64_t sourceHash = 0x1234;
+	fastgltf::Exporter exporter;
+	auto cache = exporter.writeAssetCache(asset, sourceHash);
+	REQUIRE(cache.error() == fastgltf::Error::None);
+
+	auto cacheData = fastgltf::GltfDataBuffer::FromBytes(cache.get().data(), cache.get().size());
+	REQUIRE(cacheData.error() == fastgltf::Error::None);
+
+	fastgltf::Parser parser;
+	auto loaded = parser.loadAssetCache(cacheData.get(), sourceHash);
+	REQUIRE(loaded.error() == fastgltf::Error::None);
+
+	REQUIRE(loaded->buffers.size() == 1);
+	REQUIRE(loaded->buffers[0].name == "buffer");
+	REQUIRE(loaded->buffers[0].byteLength == 5);
+
+	// GltfDataBuffer shares its data, so the buffer is not copied out of the cache.
+	const auto* byteView = std::get_if<fastgltf::sources::ByteView>(&loaded->buffers[0].data);
+	REQUIRE(byteView != nullptr);
+	REQUIRE(byteView->bytes.size() == 5);
+	REQUIRE(byteView->bytes[4] == std::byte(5));
+
+	REQUIRE(loaded->nodes.size() == 2);
+	REQUIRE(loaded->nodes[0].name == "node");
+	REQUIRE(loaded->nodes[0].children.size() == 1);
+	REQUIRE(loaded->nodes[0].children[0] == 1);
+	const auto* trs = std::get_if<fastgltf::TRS>(&loaded->nodes[0].transform);
+	REQUIRE(trs != nullptr);
+	REQUIRE(trs->translation == fastgltf::math::fvec3(1.f, 2.f, 3.f));
+
+	REQUIRE(parser.loadAssetCache(cacheData.get(), sourceHash + 1).error() == fastgltf::Error::InvalidAssetCache);
+
+	auto truncated = fastgltf::GltfDataBuffer::FromBytes(cache.get().data(), cache.get().size() - 1);
+	REQUIRE(truncated.error() == fastgltf::Error::None);
+	REQUIRE(parser.loadAssetCache(truncated.get(), sourceHash).error() == fastgltf::Error::InvalidAssetCache);
+}
+
 TEST_CASE("Test Accessor::updateBoundsToInclude", "[write-tests]") {
 	SECTION("Scalar") {
 		fastgltf::Accessor accessor;
@@ -450,3 +653,207 @@ TEST_CASE("Test Accessor::updateBoundsToInclude", "[write-tests]") {
 		REQUIRE(accessor.min->get<std::int64_t>(2) == -4);
 	}
 }
+
+#if FASTGLTF_ENABLE_MESHOPT_ENCODER && FASTGLTF_ENABLE_MESHOPT_DECODER
+TEST_CASE("Test compressing buffer views with EXT_meshopt_compression", "[write-tests]") {
+	// A grid of vertices with normals and texture coordinates, an animated rotation, and an image.
+	constexpr std::size_t gridSize = 32;
+	constexpr std::size_t vertexCount = gridSize * gridSize;
+	std::vector<fastgltf::math::fvec3> positions;
+	std::vector<fastgltf::math::fvec3> normals;
+	std::vector<fastgltf::math::fvec2> texCoords;
+	for (std::size_t y = 0; y < gridSize; ++y) {
+		for (std::size_t x = 0; x < gridSize; ++x) {
+			const auto height = std::sin(static_cast<float>(x) * 0.2f) * std::cos(static_cast<float>(y) * 0.3f);
+			positions.emplace_back(static_cast<float>(x), height, static_cast<float>(y));
+			normals.emplace_back(fastgltf::math::normalize(fastgltf::math::fvec3(-height, 1.f, height * 0.5f)));
+			texCoords.emplace_back(static_cast<float>(x) / gridSize, static_cast<float>(y) / gridSize);
+		}
+	}
+	std::vector<std::uint16_t> indices;
+	for (std::size_t y = 0; y + 1 < gridSize; ++y) {
+		for (std::size_t x = 0; x + 1 < gridSize; ++x) {
+			const auto a = static_cast<std::uint16_t>(y * gridSize + x);
+			const auto c = static_cast<std::uint16_t>(a + gridSize);
+			indices.insert(indices.end(), { a, c, static_cast<std::uint16_t>(a + 1), static_cast<std::uint16_t>(a + 1), c, static_cast<std::uint16_t>(c + 1) });
+		}
+	}
+	std::vector<float> times;
+	std::vector<fastgltf::math::fquat> rotations;
+	for (std::size_t i = 0; i < 64; ++i) {
+		times.emplace_back(static_cast<float>(i) / 30.f);
+		rotations.emplace_back(fastgltf::math::normalize(fastgltf::math::fquat(0.f, std::sin(static_cast<float>(i) * 0.05f), 0.f, 1.f)));
+	}
+	const std::array<std::uint8_t, 7> imageBytes = { 0x89, 'P', 'N', 'G', 1, 2, 3 };
+
+	fastgltf::Asset asset;
+	std::vector<std::byte> bytes;
+	auto addView = [&](const void* data, std::size_t size) {
+		fastgltf::BufferView view = {};
+		view.bufferIndex = 0;
+		view.byteOffset = (bytes.size() + 3) & ~std::size_t(3);
+		view.byteLength = size;
+		bytes.resize(view.byteOffset + size);
+		std::memcpy(bytes.data() + view.byteOffset, data, size);
+		asset.bufferViews.emplace_back(std::move(view));
+		return asset.bufferViews.size() - 1;
+	};
+	auto addAccessor = [&](std::size_t view, std::size_t count, fastgltf::AccessorType type, fastgltf::ComponentType componentType) {
+		fastgltf::Accessor accessor = {};
+		accessor.bufferViewIndex = view;
+		accessor.count = count;
+		accessor.type = type;
+		accessor.componentType = componentType;
+		asset.accessors.emplace_back(std::move(accessor));
+		return asset.accessors.size() - 1;
+	};
+	const auto positionAccessor = addAccessor(addView(positions.data(), positions.size() * sizeof(positions[0])),
+		vertexCount, fastgltf::AccessorType::Vec3, fastgltf::ComponentType::Float);
+	asset.accessors[positionAccessor].updateBoundsToInclude(fastgltf::math::dvec3(0, -1, 0));
+	asset.accessors[positionAccessor].updateBoundsToInclude(fastgltf::math::dvec3(gridSize - 1, 1, gridSize - 1));
+	const auto normalAccessor = addAccessor(addView(normals.data(), normals.size() * sizeof(normals[0])),
+		vertexCount, fastgltf::AccessorType::Vec3, fastgltf::ComponentType::Float);
+	const auto texCoordAccessor = addAccessor(addView(texCoords.data(), texCoords.size() * sizeof(texCoords[0])),
+		vertexCount, fastgltf::AccessorType::Vec2, fastgltf::ComponentType::Float);
+	const auto indexAccessor = addAccessor(addView(indices.data(), indices.size() * sizeof(indices[0])),
+		indices.size(), fastgltf::AccessorType::Scalar, fastgltf::ComponentType::UnsignedShort);
+	const auto timeAccessor = addAccessor(addView(times.data(), times.size() * sizeof(times[0])),
+		times.size(), fastgltf::AccessorType::Scalar, fastgltf::ComponentType::Float);
+	asset.accessors[timeAccessor].updateBoundsToInclude(static_cast<double>(times.front()));
+	asset.accessors[timeAccessor].updateBoundsToInclude(static_cast<double>(times.back()));
+	const auto rotationAccessor = addAccessor(addView(rotations.data(), rotations.size() * sizeof(rotations[0])),
+		rotations.size(), fastgltf::AccessorType::Vec4, fastgltf::ComponentType::Float);
+	const auto imageView = addView(imageBytes.data(), imageBytes.size());
+
+	fastgltf::Buffer buffer = {};
+	buffer.byteLength = bytes.size();
+	buffer.data = fastgltf::sources::Vector { std::move(bytes), fastgltf::MimeType::GltfBuffer };
+	asset.buffers.emplace_back(std::move(buffer));
+
+	fastgltf::Primitive primitive = {};
+	primitive.attributes.emplace_back(fastgltf::Attribute { "POSITION", positionAccessor });
+	primitive.attributes.emplace_back(fastgltf::Attribute { "NORMAL", normalAccessor });
+	primitive.attributes.emplace_back(fastgltf::Attribute { "TEXCOORD_0", texCoordAccessor });
+	primitive.indicesAccessor = indexAccessor;
+	fastgltf::Mesh mesh = {};
+	mesh.primitives.emplace_back(std::move(primitive));
+	asset.meshes.emplace_back(std::move(mesh));
+
+	fastgltf::Node node = {};
+	node.meshIndex = 0;
+	asset.nodes.emplace_back(std::move(node));
+	fastgltf::Animation animation = {};
+	animation.samplers.emplace_back(fastgltf::AnimationSampler { timeAccessor, rotationAccessor });
+	animation.channels.emplace_back(fastgltf::AnimationChannel { 0, 0, fastgltf::AnimationPath::Rotation });
+	asset.animations.emplace_back(std::move(animation));
+
+	fastgltf::Image image = {};
+	image.data = fastgltf::sources::BufferView { imageView, fastgltf::MimeType::PNG };
+	asset.images.emplace_back(std::move(image));
+
+	auto load = [](const std::vector<std::byte>& glb) {
+		auto data = fastgltf::GltfDataBuffer::FromBytes(glb.data(), glb.size());
+		REQUIRE(data.error() == fastgltf::Error::None);
+		fastgltf::Parser parser(fastgltf::Extensions::EXT_meshopt_compression | fastgltf::Extensions::KHR_mesh_quantization);
+		auto loaded = parser.loadGltfBinary(data.get(), {}, fastgltf::Options::DecodeMeshoptCompression);
+		REQUIRE(loaded.error() == fastgltf::Error::None);
+		REQUIRE(fastgltf::validate(loaded.get()) == fastgltf::Error::None);
+		return std::move(loaded.get());
+	};
+	auto checkLossless = [&](const fastgltf::Asset& loaded) {
+		std::size_t i = 0;
+		fastgltf::iterateAccessor<fastgltf::math::fvec3>(loaded, loaded.accessors[positionAccessor], [&](fastgltf::math::fvec3 position) {
+			REQUIRE(position == positions[i++]);
+		});
+		REQUIRE(i == vertexCount);
+
+		// The triangles may be rotated, but keep their order and winding.
+		std::vector<std::uint16_t> decodedIndices(indices.size());
+		fastgltf::copyFromAccessor<std::uint16_t>(loaded, loaded.accessors[indexAccessor], decodedIndices.data());
+		for (std::size_t t = 0; t < indices.size(); t += 3) {
+			bool matches = false;
+			for (std::size_t r = 0; r < 3; ++r) {
+				matches = matches || (decodedIndices[t] == indices[t + r] && decodedIndices[t + 1] == indices[t + (r + 1) % 3]
+					&& decodedIndices[t + 2] == indices[t + (r + 2) % 3]);
+			}
+			REQUIRE(matches);
+		}
+
+		// The image view is not compressed, and is read directly from the first buffer.
+		const auto& view = loaded.bufferViews[imageView];
+		REQUIRE(view.meshoptCompression == nullptr);
+		REQUIRE(view.bufferIndex == 0);
+		const auto* array = std::get_if<fastgltf::sources::Array>(&loaded.buffers[0].data);
+		REQUIRE(array != nullptr);
+		REQUIRE(std::memcmp(array->bytes.data() + view.byteOffset, imageBytes.data(), imageBytes.size()) == 0);
+	};
+
+	fastgltf::Exporter exporter;
+	auto uncompressed = exporter.writeGltfBinary(asset);
+	REQUIRE(uncompressed.error() == fastgltf::Error::None);
+
+	// The views are encoded on the executor, if one is set.
+	static std::atomic<std::size_t> executedTasks = 0;
+	executedTasks = 0;
+	exporter.setTaskExecutorCallback([](std::size_t count, fastgltf::ParserTask* task, void* taskData, void*) {
+		for (std::size_t i = 0; i < count; ++i) {
+			task(i, taskData);
+			++executedTasks;
+		}
+	});
+
+	auto compressed = exporter.writeGltfBinary(asset, fastgltf::ExportOptions::MeshoptCompression);
+	REQUIRE(compressed.error() == fastgltf::Error::None);
+	REQUIRE(executedTasks == 6);
+	REQUIRE(compressed.get().buffers.size() == 2);
+	REQUIRE(std::holds_alternative<fastgltf::sources::Fallback>(compressed.get().buffers[1].data));
+	REQUIRE(compressed.get().output.size() < uncompressed.get().output.size());
+	{
+		auto loaded = load(compressed.get().output);
+		REQUIRE(std::find(loaded.extensionsUsed.begin(), loaded.extensionsUsed.end(), fastgltf::extensions::EXT_meshopt_compression) != loaded.extensionsUsed.end());
+		REQUIRE(std::find(loaded.extensionsRequired.begin(), loaded.extensionsRequired.end(), fastgltf::extensions::EXT_meshopt_compression) != loaded.extensionsRequired.end());
+		REQUIRE(loaded.bufferViews[asset.accessors[indexAccessor].bufferViewIndex.value()].meshoptCompression->mode == fastgltf::MeshoptCompressionMode::Triangles);
+		checkLossless(loaded);
+
+		std::size_t i = 0;
+		fastgltf::iterateAccessor<fastgltf::math::fvec3>(loaded, loaded.accessors[normalAccessor], [&](fastgltf::math::fvec3 normal) {
+			REQUIRE(normal == normals[i++]);
+		});
+	}
+
+	auto filtered = exporter.writeGltfBinary(asset, fastgltf::ExportOptions::MeshoptCompression | fastgltf::ExportOptions::MeshoptFilters);
+	REQUIRE(filtered.error() == fastgltf::Error::None);
+	REQUIRE(filtered.get().output.size() < compressed.get().output.size());
+	{
+		auto loaded = load(filtered.get().output);
+		REQUIRE(std::find(loaded.extensionsRequired.begin(), loaded.extensionsRequired.end(), fastgltf::extensions::KHR_mesh_quantization) != loaded.extensionsRequired.end());
+		checkLossless(loaded);
+
+		// Normals are stored as normalized bytes, and the rotations as normalized shorts.
+		const auto& normalData = loaded.accessors[normalAccessor];
+		REQUIRE(normalData.componentType == fastgltf::ComponentType::Byte);
+		REQUIRE(normalData.normalized);
+		std::size_t i = 0;
+		fastgltf::iterateAccessor<fastgltf::math::fvec3>(loaded, normalData, [&](fastgltf::math::fvec3 normal) {
+			REQUIRE(fastgltf::math::length(normal - normals[i++]) < 0.03f);
+		});
+
+		REQUIRE(loaded.accessors[rotationAccessor].componentType == fastgltf::ComponentType::Short);
+		i = 0;
+		fastgltf::iterateAccessor<fastgltf::math::fvec4>(loaded, loaded.accessors[rotationAccessor], [&](fastgltf::math::fvec4 rotation) {
+			const auto& expected = rotations[i++];
+			REQUIRE(std::abs(rotation.x() - expected.x()) + std::abs(rotation.y() - expected.y()) + std::abs(rotation.z() - expected.z()) + std::abs(rotation.w() - expected.w()) < 1e-3f);
+		});
+
+		// The texture coordinates stay floats with fewer bits of mantissa.
+		REQUIRE(loaded.accessors[texCoordAccessor].componentType == fastgltf::ComponentType::Float);
+		i = 0;
+		fastgltf::iterateAccessor<fastgltf::math::fvec2>(loaded, loaded.accessors[texCoordAccessor], [&](fastgltf::math::fvec2 texCoord) {
+			REQUIRE(fastgltf::math::length(texCoord - texCoords[i++]) < 1e-4f);
+		});
+
+		// The animation input is not quantized, as it needs to keep its bounds.
+		REQUIRE(loaded.accessors[timeAccessor].max.has_value());
+	}
+}
+#endif